@@ -30,6 +30,7 @@
 
 #include "llvm/IR/PassManager.h"
 #include "llvm/Passes/PassBuilder.h"
+#include <functional>
 
 namespace llvm {
 
@@ -94,6 +95,46 @@ extern template class PassManager<ModuleBunch>;
 extern template class AnalysisManager<ModuleBunch>;
 extern template class AllAnalysesOn<ModuleBunch>;
 
+/// The analysis managers that one worker thread of a parallel ModuleBunchToModulePassAdaptor runs its module pass
+/// pipeline against. Analysis managers are not thread-safe, so each worker needs its own set; it is created by the
+/// ModuleBunchParallelismAnalysis result and thrown away when the worker finishes.
+class ModuleBunchWorkerAnalysisManagers {
+public:
+  virtual ~ModuleBunchWorkerAnalysisManagers() = default;
+
+  // Get the module analysis manager, which must have all its inner analysis managers and proxies set up.
+  virtual ModuleAnalysisManager &getModuleAnalysisManager() = 0;
+};
+
+/// ModuleBunch analysis that allows ModuleBunchToModulePassAdaptor to run its module pass pipeline on several threads
+/// at once, one thread per distinct LLVMContext in the ModuleBunch. If this analysis is not registered, or its result
+/// asks for a single thread, the modules are run one after another on the calling thread.
+class ModuleBunchParallelismAnalysis : public AnalysisInfoMixin<ModuleBunchParallelismAnalysis> {
+public:
+  struct Result {
+    // Maximum number of threads to use, including the calling thread. 0 means one per available core.
+    unsigned NumThreads = 1;
+
+    // Create the analysis managers for one worker thread.
+    std::function<std::unique_ptr<ModuleBunchWorkerAnalysisManagers>()> CreateWorkerAnalysisManagers;
+
+    // The configuration does not depend on the IR, so it is never invalidated.
+    bool invalidate(ModuleBunch &, const PreservedAnalyses &, ModuleBunchAnalysisManager::Invalidator &) {
+      return false;
+    }
+  };
+
+  explicit ModuleBunchParallelismAnalysis(Result Config) : Config(std::move(Config)) {}
+
+  Result run(ModuleBunch &, ModuleBunchAnalysisManager &) { return Config; }
+
+private:
+  friend AnalysisInfoMixin<ModuleBunchParallelismAnalysis>;
+  static AnalysisKey Key;
+
+  Result Config;
+};
+
 /// Trivial adaptor that maps from a ModuleBunch to its modules.
 ///
 /// Designed to allow composition of a ModulePass(Manager) and
@@ -113,12 +154,20 @@ extern template class AllAnalysesOn<ModuleBunch>;
 /// Note that although module passes can access ModuleBunch analyses, ModuleBunch
 /// analyses are not invalidated while the module passes are running, so they
 /// may be stale.  Module analyses will not be stale.
+///
+/// If the adaptor was constructed with a PassMaker and ModuleBunchParallelismAnalysis
+/// is registered, modules in distinct LLVMContexts are run concurrently, each
+/// worker thread with its own pass (from PassMaker) and its own analysis managers.
+/// Module analyses computed on a worker are not kept once the worker is done.
+/// Instrumentation callbacks and invalidation of the shared module analysis
+/// manager are serialized on a mutex. The passes must not share a TargetMachine,
+/// which is not thread-safe, so only middle-end pipelines are suitable.
 class ModuleBunchToModulePassAdaptor : public PassInfoMixin<ModuleBunchToModulePassAdaptor> {
 public:
   using PassConceptT = detail::PassConcept<Module, ModuleAnalysisManager>;
 
   /// Construct with a function that returns a pass. It can then parallelize compilation by calling
-  /// the function once for each parallel thread.
+  /// the function once for each parallel thread. PassMaker must outlive the adaptor.
   explicit ModuleBunchToModulePassAdaptor(function_ref<std::unique_ptr<PassConceptT>()> PassMaker,
                                           bool EagerlyInvalidate = false)
       : PassMaker(PassMaker), EagerlyInvalidate(EagerlyInvalidate) {}
@@ -134,6 +183,10 @@ public:
   static bool isRequired() { return true; }
 
 private:
+  PreservedAnalyses runParallel(ArrayRef<SmallVector<Module *, 4>> ContextGroups, unsigned NumThreads,
+                                const ModuleBunchParallelismAnalysis::Result &Parallelism, ModuleAnalysisManager &MAM,
+                                PassInstrumentation &PI);
+
   std::unique_ptr<PassConceptT> Pass;
   function_ref<std::unique_ptr<PassConceptT>()> PassMaker;
   bool EagerlyInvalidate;
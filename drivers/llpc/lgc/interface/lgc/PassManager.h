@@ -33,6 +33,7 @@
 #include "lgc/ModuleBunch.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/PassManager.h"
+#include <functional>
 
 namespace llvm {
 class LLVMContext;
@@ -88,10 +89,17 @@ public:
   static std::unique_ptr<MbPassManager> Create(llvm::TargetMachine *targetMachine);
 
   virtual ~MbPassManager() = default;
+
+  // Register function and module analyses. They are also registered with the analysis managers of each worker
+  // thread when module passes run in parallel, so the pass builder must be copyable.
   template <typename PassBuilderT> bool registerFunctionAnalysis(PassBuilderT &&PassBuilder) {
+    m_workerFunctionAnalyses.push_back(
+        [PassBuilder](llvm::FunctionAnalysisManager &analysisManager) { analysisManager.registerPass(PassBuilder); });
     return m_functionAnalysisManager.registerPass(std::forward<PassBuilderT>(PassBuilder));
   }
   template <typename PassBuilderT> bool registerModuleAnalysis(PassBuilderT &&passBuilder) {
+    m_workerModuleAnalyses.push_back(
+        [passBuilder](llvm::ModuleAnalysisManager &analysisManager) { analysisManager.registerPass(passBuilder); });
     return m_moduleAnalysisManager.registerPass(std::forward<PassBuilderT>(passBuilder));
   }
   template <typename PassBuilderT> bool registerModuleBunchAnalysis(PassBuilderT &&passBuilder) {
@@ -102,12 +110,29 @@ public:
   virtual void run(llvm::ModuleBunch &moduleBunch) = 0;
   virtual bool stopped() const = 0;
 
+  // Set the number of threads that module pass pipelines (added through a ModuleBunchToModulePassAdaptor with a
+  // PassMaker) may use to process the modules of distinct LLVMContexts concurrently. 0 means one per available core;
+  // the default of 1 runs them serially. Must be called before the first run(). The passes must not share
+  // non-thread-safe state other than through their own LLVMContext.
+  //
+  // This is meant for middle-end pipelines only. Each worker's analyses (TargetIRAnalysis in particular) get their
+  // own copy of the TargetMachine passed to Create(), but the passes made by the PassMaker are not given one, so
+  // they must not hold on to a shared TargetMachine themselves; that rules out codegen passes.
+  //
+  // Nothing in the compiler runs an MbPassManager yet, so this is only used by the ModuleBunch unit tests; it is not
+  // exposed as an option until there is a production pipeline to apply it to.
+  virtual void setNumThreads(unsigned numThreads) = 0;
+
   virtual llvm::PassInstrumentationCallbacks &getInstrumentationCallbacks() = 0;
 
 protected:
   llvm::FunctionAnalysisManager m_functionAnalysisManager;
   llvm::ModuleAnalysisManager m_moduleAnalysisManager;
   llvm::ModuleBunchAnalysisManager m_moduleBunchAnalysisManager;
+
+  // Registrations of the custom analyses above, replayed for each worker thread's analysis managers.
+  llvm::SmallVector<std::function<void(llvm::FunctionAnalysisManager &)>, 2> m_workerFunctionAnalyses;
+  llvm::SmallVector<std::function<void(llvm::ModuleAnalysisManager &)>, 2> m_workerModuleAnalyses;
 };
 
 } // namespace lgc
@@ -0,0 +1,149 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2023 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+// Tests and benchmarks running a module pass pipeline over a ModuleBunch, serially and on multiple threads.
+
+#include "lgc/LgcContext.h"
+#include "lgc/ModuleBunch.h"
+#include "lgc/PassManager.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/InstCombine/InstCombine.h"
+#include "llvm/Transforms/Scalar/EarlyCSE.h"
+#include "llvm/Transforms/Scalar/SimplifyCFGPass.h"
+#include "gmock/gmock.h"
+#include <chrono>
+#include <thread>
+
+using namespace lgc;
+using namespace llvm;
+
+namespace {
+
+constexpr unsigned NumContexts = 16;
+constexpr unsigned FuncsPerModule = 64;
+constexpr unsigned StepsPerFunc = 128;
+
+// =====================================================================================================================
+// Create a module of functions that each compute a long chain of arithmetic on their argument. Every step undoes
+// itself, so once optimized each function is just "ret i32 %arg".
+//
+// @param context : LLVMContext to create the module in
+// @param moduleIdx : Index of the module, used for its name
+std::unique_ptr<Module> createTestModule(LLVMContext &context, unsigned moduleIdx) {
+  auto module = std::make_unique<Module>(("module" + Twine(moduleIdx)).str(), context);
+  IRBuilder<> builder(context);
+  FunctionType *funcTy = FunctionType::get(builder.getInt32Ty(), builder.getInt32Ty(), false);
+
+  for (unsigned funcIdx = 0; funcIdx != FuncsPerModule; ++funcIdx) {
+    Function *func = Function::Create(funcTy, GlobalValue::ExternalLinkage, "func" + Twine(funcIdx), *module);
+    builder.SetInsertPoint(BasicBlock::Create(context, "", func));
+    Value *value = func->getArg(0);
+    for (unsigned step = 0; step != StepsPerFunc; ++step) {
+      Value *addend = builder.getInt32(step + funcIdx);
+      Value *mask = builder.getInt32((step * 7919) ^ moduleIdx);
+      value = builder.CreateSub(builder.CreateAdd(value, addend), addend);
+      value = builder.CreateXor(builder.CreateXor(value, mask), mask);
+    }
+    builder.CreateRet(value);
+  }
+  return module;
+}
+
+// =====================================================================================================================
+// Create the module pass pipeline for one thread of the ModuleBunchToModulePassAdaptor.
+std::unique_ptr<ModuleBunchToModulePassAdaptor::PassConceptT> createModulePipeline() {
+  FunctionPassManager functionPassMgr;
+  functionPassMgr.addPass(InstCombinePass());
+  functionPassMgr.addPass(EarlyCSEPass());
+  functionPassMgr.addPass(SimplifyCFGPass());
+  ModulePassManager modulePassMgr;
+  modulePassMgr.addPass(createModuleToFunctionPassAdaptor(std::move(functionPassMgr)));
+  return createForModuleBunchToModulePassAdaptor(std::move(modulePassMgr));
+}
+
+// =====================================================================================================================
+// Optimize a ModuleBunch of NumContexts modules, each in its own LLVMContext, and check the result.
+//
+// @param numThreads : Number of threads to give the pass manager
+// @returns : Wall-clock time of running the passes, in milliseconds
+double runModuleBunch(unsigned numThreads) {
+  // The contexts must outlive the ModuleBunch that owns the modules.
+  SmallVector<std::unique_ptr<LLVMContext>, NumContexts> contexts;
+  ModuleBunch moduleBunch;
+  for (unsigned moduleIdx = 0; moduleIdx != NumContexts; ++moduleIdx) {
+    contexts.push_back(std::make_unique<LLVMContext>());
+    moduleBunch.addModule(createTestModule(*contexts.back(), moduleIdx));
+  }
+
+  auto passMaker = [] { return createModulePipeline(); };
+  std::unique_ptr<MbPassManager> passMgr = MbPassManager::Create(nullptr);
+  passMgr->setNumThreads(numThreads);
+  passMgr->addPass(ModuleBunchToModulePassAdaptor(passMaker));
+
+  auto start = std::chrono::steady_clock::now();
+  passMgr->run(moduleBunch);
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  for (const Module &module : moduleBunch) {
+    for (const Function &func : module) {
+      EXPECT_EQ(func.getInstructionCount(), 1u) << module.getName().str() << ":" << func.getName().str();
+      const auto *ret = dyn_cast<ReturnInst>(func.getEntryBlock().getTerminator());
+      EXPECT_NE(ret, nullptr);
+      if (ret)
+        EXPECT_EQ(ret->getReturnValue(), func.getArg(0));
+    }
+  }
+  return elapsed.count();
+}
+
+} // anonymous namespace
+
+// Running the modules of distinct LLVMContexts on multiple threads must optimize them just as running serially does.
+TEST(LgcInterfaceTests, ModuleBunchParallelMatchesSerial) {
+  LgcContext::initialize();
+  runModuleBunch(1);
+  runModuleBunch(4);
+  runModuleBunch(0);
+}
+
+// Benchmark: report how running the module pass pipeline scales from 1 thread up to the number of available cores.
+// Disabled by default, as its run time grows with the core count and it checks no timing; run it with
+// --gtest_also_run_disabled_tests --gtest_filter=LgcInterfaceTests.DISABLED_ModuleBunchParallelScaling.
+TEST(LgcInterfaceTests, DISABLED_ModuleBunchParallelScaling) {
+  LgcContext::initialize();
+  unsigned maxThreads = std::max(std::thread::hardware_concurrency(), 1U);
+
+  double serialTime = runModuleBunch(1);
+  outs() << "ModuleBunch: " << NumContexts << " contexts, 1 thread: " << format("%.2f", serialTime) << " ms\n";
+  for (unsigned numThreads = 2; numThreads <= maxThreads; numThreads *= 2) {
+    double time = runModuleBunch(numThreads);
+    outs() << "ModuleBunch: " << NumContexts << " contexts, " << numThreads
+           << " threads: " << format("%.2f", time) << " ms (speedup " << format("%.2f", serialTime / time) << "x)\n";
+  }
+}
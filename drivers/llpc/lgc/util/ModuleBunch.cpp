@@ -29,6 +29,9 @@
 #include "lgc/ModuleBunch.h"
 #include "llvm/IR/PassManagerImpl.h"
 #include "llvm/IR/PrintPasses.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 namespace llvm {
 
@@ -40,6 +43,8 @@ template class AllAnalysesOn<ModuleBunch>;
 
 using namespace llvm;
 
+AnalysisKey ModuleBunchParallelismAnalysis::Key;
+
 // Add Module to ModuleBunch, taking ownership.
 void ModuleBunch::addModule(std::unique_ptr<Module> module) {
   Modules.push_back(std::move(module));
@@ -183,18 +188,32 @@ PreservedAnalyses ModuleBunchToModulePassAdaptor::run(ModuleBunch &Bunch, Module
   // instrumenting callbacks for the passes later.
   PassInstrumentation PI = AM.getResult<PassInstrumentationAnalysis>(Bunch);
 
-  PreservedAnalyses PA = PreservedAnalyses::all();
+  // Group the modules by LLVMContext, keeping the order of first appearance. Modules in distinct LLVMContexts
+  // share nothing, so each group can be run on its own thread.
+  SmallVector<SmallVector<Module *, 4>, 16> ContextGroups;
+  SmallDenseMap<LLVMContext *, unsigned, 16> ContextGroupIdx;
+  for (Module &M : Bunch) {
+    auto It = ContextGroupIdx.try_emplace(&M.getContext(), ContextGroups.size()).first;
+    if (It->second == ContextGroups.size())
+      ContextGroups.emplace_back();
+    ContextGroups[It->second].push_back(&M);
+  }
 
-  // TODO: Add real parallelism, with an API to provide threads to run module passes.
-  // For now, run each distinct LLVMContext in a separate copy of the module pass manager,
-  // so we can at least test users adding identical copies of the module pass manager.
-  SmallPtrSet<LLVMContext *, 16> DoneContexts;
-  for (unsigned StartIdx = 0; StartIdx != Bunch.size(); ++StartIdx) {
-    Module &module = Bunch.begin()[StartIdx];
-    LLVMContext *Context = &module.getContext();
-    if (!DoneContexts.insert(Context).second)
-      continue;
+  // A single Pass (rather than a PassMaker) cannot be shared between threads.
+  if (!Pass && ContextGroups.size() > 1 && AM.isPassRegistered<ModuleBunchParallelismAnalysis>()) {
+    const auto &Parallelism = AM.getResult<ModuleBunchParallelismAnalysis>(Bunch);
+    unsigned NumThreads = Parallelism.NumThreads;
+    if (NumThreads == 0)
+      NumThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    NumThreads = std::min<size_t>(NumThreads, ContextGroups.size());
+    if (NumThreads > 1 && Parallelism.CreateWorkerAnalysisManagers)
+      return runParallel(ContextGroups, NumThreads, Parallelism, MAM, PI);
+  }
+
+  PreservedAnalyses PA = PreservedAnalyses::all();
 
+  // Run each distinct LLVMContext in a separate copy of the module pass manager.
+  for (ArrayRef<Module *> Group : ContextGroups) {
     // Use the single Pass if it was set. Otherwise call PassMaker to create a Pass each time
     // round the outer per-LLVMContext loop.
     std::unique_ptr<PassConceptT> AllocatedPass;
@@ -204,25 +223,20 @@ PreservedAnalyses ModuleBunchToModulePassAdaptor::run(ModuleBunch &Bunch, Module
       ThisPass = &*AllocatedPass;
     }
 
-    for (unsigned Idx = StartIdx; Idx != Bunch.size(); ++Idx) {
-      Module &M = Bunch.begin()[Idx];
-      if (&M.getContext() != Context)
-        continue;
-
+    for (Module *M : Group) {
       // Check the PassInstrumentation's BeforePass callbacks before running the
       // pass, skip its execution completely if asked to (callback returns
       // false).
-      if (!PI.runBeforePass<Module>(*ThisPass, M))
+      if (!PI.runBeforePass<Module>(*ThisPass, *M))
         continue;
 
-      PreservedAnalyses PassPA = ThisPass->run(M, MAM);
-      PI.runAfterPass(*ThisPass, M, PassPA);
+      PreservedAnalyses PassPA = ThisPass->run(*M, MAM);
+      PI.runAfterPass(*ThisPass, *M, PassPA);
 
-      // TODO: With real parallelism, the next two statements need to be under a mutex.
       // We know that the module pass couldn't have invalidated any other
       // module's analyses (that's the contract of a module pass), so
       // directly handle the module analysis manager's invalidation here.
-      MAM.invalidate(M, EagerlyInvalidate ? PreservedAnalyses::none() : PassPA);
+      MAM.invalidate(*M, EagerlyInvalidate ? PreservedAnalyses::none() : PassPA);
 
       // Then intersect the preserved set so that invalidation of module
       // analyses will eventually occur when the module pass completes.
@@ -240,6 +254,72 @@ PreservedAnalyses ModuleBunchToModulePassAdaptor::run(ModuleBunch &Bunch, Module
   return PA;
 }
 
+// Run the per-LLVMContext groups of modules on NumThreads threads (the calling thread being one of them).
+//
+// Each worker takes the next unclaimed group, creates a Pass for it with PassMaker, and runs the pass on each module of
+// the group against the worker's own analysis managers. The shared module analysis manager, the instrumentation
+// callbacks and the accumulated PreservedAnalyses are only touched under a mutex.
+PreservedAnalyses
+ModuleBunchToModulePassAdaptor::runParallel(ArrayRef<SmallVector<Module *, 4>> ContextGroups, unsigned NumThreads,
+                                            const ModuleBunchParallelismAnalysis::Result &Parallelism,
+                                            ModuleAnalysisManager &MAM, PassInstrumentation &PI) {
+  PreservedAnalyses PA = PreservedAnalyses::all();
+  std::mutex Lock;
+  std::atomic<size_t> NextGroupIdx(0);
+
+  auto Worker = [&] {
+    std::unique_ptr<ModuleBunchWorkerAnalysisManagers> WorkerAMs;
+    for (size_t GroupIdx = NextGroupIdx++; GroupIdx < ContextGroups.size(); GroupIdx = NextGroupIdx++) {
+      std::unique_ptr<PassConceptT> ThisPass;
+      {
+        std::lock_guard<std::mutex> Guard(Lock);
+        if (!WorkerAMs)
+          WorkerAMs = Parallelism.CreateWorkerAnalysisManagers();
+        ThisPass = PassMaker();
+      }
+      ModuleAnalysisManager &WorkerMAM = WorkerAMs->getModuleAnalysisManager();
+
+      for (Module *M : ContextGroups[GroupIdx]) {
+        {
+          std::lock_guard<std::mutex> Guard(Lock);
+          if (!PI.runBeforePass<Module>(*ThisPass, *M))
+            continue;
+        }
+
+        PreservedAnalyses PassPA = ThisPass->run(*M, WorkerMAM);
+
+        // The worker's own cached results are dropped; nothing else will query them.
+        WorkerMAM.clear(*M, M->getName());
+
+        std::lock_guard<std::mutex> Guard(Lock);
+        PI.runAfterPass(*ThisPass, *M, PassPA);
+
+        // Results cached in the shared analysis manager before this adaptor ran may have been invalidated by the
+        // pass, which only reported that through PassPA.
+        MAM.invalidate(*M, EagerlyInvalidate ? PreservedAnalyses::none() : PassPA);
+        PA.intersect(std::move(PassPA));
+      }
+    }
+
+    // Destroy the worker's analysis managers while still on the worker, after the last use of its LLVMContexts.
+    WorkerAMs.reset();
+  };
+
+  std::vector<std::thread> Threads;
+  Threads.reserve(NumThreads - 1);
+  for (unsigned ThreadIdx = 1; ThreadIdx != NumThreads; ++ThreadIdx)
+    Threads.emplace_back(Worker);
+  Worker();
+  for (std::thread &Thread : Threads)
+    Thread.join();
+
+  // As in the serial path: no modules were added or removed, and the shared module analysis manager has already
+  // been invalidated per module.
+  PA.preserveSet<AllAnalysesOn<Module>>();
+  PA.preserve<ModuleAnalysisManagerModuleBunchProxy>();
+  return PA;
+}
+
 // Copied from lib/Passes/PassBuilder.cpp because it is private there.
 std::optional<std::vector<PassBuilder::PipelineElement>> MbPassBuilder::parsePipelineText(StringRef Text) {
   std::vector<PipelineElement> ResultPipeline;
@@ -35,6 +35,7 @@
 #include "llvm/Analysis/CFGPrinter.h"
 #include "llvm/IR/PrintPasses.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/MC/TargetRegistry.h"
 #if LLVM_MAIN_REVISION && LLVM_MAIN_REVISION < 442438
 // Old version of the code
 #include "llvm/IR/IRPrintingPasses.h"
@@ -44,6 +45,7 @@
 #endif
 #include "llvm/Passes/PassBuilder.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Target/TargetMachine.h"
 
 namespace llvm {
 namespace cl {
@@ -133,11 +135,13 @@ public:
   MbPassManagerImpl(TargetMachine *targetMachine);
   void registerPass(StringRef passName, StringRef className) override;
   void run(ModuleBunch &moduleBunch) override;
+  void setNumThreads(unsigned numThreads) override { m_numThreads = numThreads; }
   PassInstrumentationCallbacks &getInstrumentationCallbacks() override { return m_instrumentationCallbacks; }
   bool stopped() const override { return m_stopped; }
 
 private:
   void registerCallbacks();
+  std::unique_ptr<ModuleBunchWorkerAnalysisManagers> createWorkerAnalysisManagers();
   TargetMachine *m_targetMachine;
 
   // -----------------------------------------------------------------------------------------------------------------
@@ -149,6 +153,34 @@ private:
   bool m_initialized = false;                              // Whether the pass manager is initialized or not
   bool m_stopped = false;
   std::string m_stopAfter;
+  unsigned m_numThreads = 1; // Number of threads for running module passes of distinct LLVMContexts
+};
+
+// =====================================================================================================================
+// The analysis managers for one worker thread of a parallel ModuleBunchToModulePassAdaptor.
+//
+// These are set up like the MbPassManagerImpl's own module and inner analysis managers, but without instrumentation
+// callbacks, which are not thread-safe; the adaptor runs the instrumentation for the whole module pipeline itself.
+//
+// TargetMachine is not thread-safe either (it lazily creates and caches a subtarget per function attribute set, and
+// TargetIRAnalysis goes through that on every function), so the worker's analyses use a private copy of the pass
+// manager's TargetMachine rather than the shared one.
+class MbWorkerAnalysisManagers final : public ModuleBunchWorkerAnalysisManagers {
+public:
+  MbWorkerAnalysisManagers(TargetMachine *targetMachine, ModuleBunchAnalysisManager &moduleBunchAnalysisManager,
+                           ArrayRef<std::function<void(FunctionAnalysisManager &)>> functionAnalyses,
+                           ArrayRef<std::function<void(ModuleAnalysisManager &)>> moduleAnalyses);
+
+  ModuleAnalysisManager &getModuleAnalysisManager() override { return m_moduleAnalysisManager; }
+
+private:
+  // NOTE: The order matters: each analysis manager may hold proxies to the ones declared before it, so they have to
+  // be destroyed in reverse order, and all of them may hold results referring to the TargetMachine.
+  std::unique_ptr<TargetMachine> m_targetMachine;
+  LoopAnalysisManager m_loopAnalysisManager;
+  FunctionAnalysisManager m_functionAnalysisManager;
+  CGSCCAnalysisManager m_cgsccAnalysisManager;
+  ModuleAnalysisManager m_moduleAnalysisManager;
 };
 
 } // namespace
@@ -318,11 +350,60 @@ void MbPassManagerImpl::run(ModuleBunch &moduleBunch) {
     m_loopAnalysisManager.registerPass([&] { return ModuleAnalysisManagerLoopProxy(m_moduleAnalysisManager); });
     m_moduleBunchAnalysisManager.registerPass(
         [&]() { return PassInstrumentationAnalysis(&m_instrumentationCallbacks); });
+    if (m_numThreads != 1) {
+      ModuleBunchParallelismAnalysis::Result parallelism;
+      parallelism.NumThreads = m_numThreads;
+      parallelism.CreateWorkerAnalysisManagers = [this] { return createWorkerAnalysisManagers(); };
+      m_moduleBunchAnalysisManager.registerPass([=] { return ModuleBunchParallelismAnalysis(parallelism); });
+    }
     m_initialized = true;
   }
   ModuleBunchPassManager::run(moduleBunch, m_moduleBunchAnalysisManager);
 }
 
+// =====================================================================================================================
+// Create the analysis managers for one worker thread of a parallel ModuleBunchToModulePassAdaptor
+std::unique_ptr<ModuleBunchWorkerAnalysisManagers> MbPassManagerImpl::createWorkerAnalysisManagers() {
+  return std::make_unique<MbWorkerAnalysisManagers>(m_targetMachine, m_moduleBunchAnalysisManager,
+                                                    m_workerFunctionAnalyses, m_workerModuleAnalyses);
+}
+
+// =====================================================================================================================
+//
+// @param targetMachine : TargetMachine to copy for this worker (may be null)
+// @param moduleBunchAnalysisManager : The ModuleBunch analysis manager, for the outer proxy
+// @param functionAnalyses : Registrations of custom function analyses
+// @param moduleAnalyses : Registrations of custom module analyses
+MbWorkerAnalysisManagers::MbWorkerAnalysisManagers(
+    TargetMachine *targetMachine, ModuleBunchAnalysisManager &moduleBunchAnalysisManager,
+    ArrayRef<std::function<void(FunctionAnalysisManager &)>> functionAnalyses,
+    ArrayRef<std::function<void(ModuleAnalysisManager &)>> moduleAnalyses) {
+  if (targetMachine) {
+    m_targetMachine.reset(targetMachine->getTarget().createTargetMachine(
+        targetMachine->getTargetTriple().getTriple(), targetMachine->getTargetCPU(),
+        targetMachine->getTargetFeatureString(), targetMachine->Options, targetMachine->getRelocationModel(),
+        targetMachine->getCodeModel(), targetMachine->getOptLevel()));
+  }
+
+  // As in MbPassManagerImpl::run, custom analyses are registered before LLVM's default ones.
+  for (const auto &registerAnalysis : functionAnalyses)
+    registerAnalysis(m_functionAnalysisManager);
+  for (const auto &registerAnalysis : moduleAnalyses)
+    registerAnalysis(m_moduleAnalysisManager);
+
+  PassBuilder passBuilder(m_targetMachine.get(), PipelineTuningOptions(), {}, nullptr);
+  passBuilder.registerModuleAnalyses(m_moduleAnalysisManager);
+  passBuilder.registerCGSCCAnalyses(m_cgsccAnalysisManager);
+  passBuilder.registerFunctionAnalyses(m_functionAnalysisManager);
+  passBuilder.registerLoopAnalyses(m_loopAnalysisManager);
+  passBuilder.crossRegisterProxies(m_loopAnalysisManager, m_functionAnalysisManager, m_cgsccAnalysisManager,
+                                   m_moduleAnalysisManager);
+  m_moduleAnalysisManager.registerPass([outerAnalysisManager = &moduleBunchAnalysisManager] {
+    return ModuleBunchAnalysisManagerModuleProxy(*outerAnalysisManager);
+  });
+  m_loopAnalysisManager.registerPass([&] { return ModuleAnalysisManagerLoopProxy(m_moduleAnalysisManager); });
+}
+
 // =====================================================================================================================
 // Register LLPC's custom callbacks
 //
@@ -84,7 +84,9 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/AlwaysInliner.h"
 #include "llvm/Transforms/Utils/Cloning.h"
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <set>
@@ -157,6 +159,11 @@ opt<bool> EnablePerStageCache("enable-per-stage-cache", cl::desc("Enable shader
 opt<int> ContextReuseLimit("context-reuse-limit",
                            cl::desc("The maximum number of times a compiler context can be reused"), init(100));
 
+// -context-pool-stats: Print context pool hit/miss counts and setup cost when the last compiler is destroyed.
+opt<bool> PrintContextPoolStats("context-pool-stats",
+                                cl::desc("Print context pool hit/miss counts and context setup cost on shutdown"),
+                                init(false));
+
 // -fatal-llvm-errors: Make all LLVM errors fatal
 opt<bool> FatalLlvmErrors("fatal-llvm-errors", cl::desc("Make all LLVM errors fatal"), init(false));
 
@@ -205,6 +212,25 @@ namespace Llpc {
 sys::Mutex Compiler::m_contextPoolMutex;
 std::vector<Context *> *Compiler::m_contextPool = nullptr;
 
+// Running totals behind Compiler::getContextPoolStats(). The GPURT library counters are updated outside the context
+// pool lock, so all of them are atomic.
+static struct {
+  std::atomic<uint64_t> contextHits;
+  std::atomic<uint64_t> contextMisses;
+  std::atomic<uint64_t> contextInitNs;
+  std::atomic<uint64_t> gpurtLibraryHits;
+  std::atomic<uint64_t> gpurtLibraryMisses;
+  std::atomic<uint64_t> gpurtLibraryInitNs;
+} ContextPoolCounters;
+
+// =====================================================================================================================
+// Returns the nanoseconds elapsed since the given start time.
+//
+// @param start : Start time
+static uint64_t elapsedNs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 // Enumerates modes used in shader replacement
 enum ShaderReplaceMode {
   ShaderReplaceDisable = 0,            // Disabled
@@ -497,6 +523,14 @@ Compiler::~Compiler() {
   }
 
   if (shutdown) {
+    if (cl::PrintContextPoolStats) {
+      ContextPoolStats stats = getContextPoolStats();
+      outs() << "Context pool: " << stats.contextHits << " hits, " << stats.contextMisses << " misses, "
+             << format("%.3f", stats.contextInitNs / 1e6) << " ms creating contexts\n"
+             << "GPURT library: " << stats.gpurtLibraryHits << " hits, " << stats.gpurtLibraryMisses << " misses, "
+             << format("%.3f", stats.gpurtLibraryInitNs / 1e6) << " ms translating\n";
+    }
+
     remove_fatal_error_handler();
     delete m_contextPool;
     m_contextPool = nullptr;
@@ -1202,7 +1236,8 @@ Result Compiler::buildPipelineInternal(Context *context, ArrayRef<const Pipeline
       timerProfiler.addTimerStartStopPass(*lowerPassMgr, TimerTranslate, true);
 
       // SPIR-V translation, then dump the result.
-      lowerPassMgr->addPass(SpirvLowerTranslator(entryStage, shaderInfoEntry));
+      lowerPassMgr->addPass(
+          SpirvLowerTranslator(entryStage, shaderInfoEntry, timerProfiler.getTimer(TimerSpirvParse)));
       if (EnableOuts()) {
         lowerPassMgr->addPass(
             PrintModulePass(outs(), "\n"
@@ -1235,12 +1270,16 @@ Result Compiler::buildPipelineInternal(Context *context, ArrayRef<const Pipeline
     }
 
     if (numStagesWithRayQuery) {
-      std::unique_ptr<Module> gpurtShaderLibrary = createGpurtShaderLibrary(context);
-      if (!gpurtShaderLibrary)
+      MetroHash::Hash libraryKey = {};
+      if (!prepareGpurtShaderLibrary(context, &libraryKey))
         return Result::ErrorInvalidShader;
 
       LLPC_OUTS("// LLPC link ray query modules");
 
+      // Ray query lowering has already declared the library entry points each stage calls, so only those functions
+      // and what they reference need to be imported. Everything else would be deleted again after inlining.
+      unsigned importedFunctions = 0;
+      uint64_t importedInstructions = 0;
       for (unsigned shaderIndex = 0; shaderIndex < modules.size(); ++shaderIndex) {
         const PipelineShaderInfo *shaderInfoEntry = shaderInfo[shaderIndex];
         if (!shaderInfoEntry)
@@ -1250,18 +1289,13 @@ Result Compiler::buildPipelineInternal(Context *context, ArrayRef<const Pipeline
         if (!moduleData || !moduleData->usage.enableRayQuery)
           continue;
 
-        // Modules are consumed by linking, so clone as needed.
-        std::unique_ptr<Module> localShaderLibrary;
-        if (numStagesWithRayQuery > 1)
-          localShaderLibrary = CloneModule(*gpurtShaderLibrary);
-        else
-          localShaderLibrary = std::move(gpurtShaderLibrary);
-        --numStagesWithRayQuery;
-
-        Linker linker(*modules[shaderIndex]);
-        if (linker.linkInModule(std::move(localShaderLibrary)))
+        if (!context->linkGpurtLibrary(libraryKey, modules[shaderIndex], &importedFunctions, &importedInstructions))
           result = Result::ErrorInvalidShader;
       }
+
+      LLPC_OUTS("// GPURT library import: " << importedFunctions << " functions, " << importedInstructions
+                                            << " instructions from " << context->getGpurtLibraryBitcodeSize()
+                                            << " bytes of library bitcode\n");
     }
 
     SmallVector<Module *, ShaderStageGfxCount> modulesToLink;
@@ -1938,8 +1972,41 @@ Result Compiler::BuildComputePipeline(const ComputePipelineBuildInfo *pipelineIn
 // @param context : the context
 // @return the LLVM module containing the GPURT shader library
 std::unique_ptr<Module> Compiler::createGpurtShaderLibrary(Context *context) {
+  MetroHash::Hash libraryKey = {};
+  if (!prepareGpurtShaderLibrary(context, &libraryKey))
+    return {};
+  return context->cloneGpurtLibrary(libraryKey);
+}
+
+// =====================================================================================================================
+// Make sure the context holds the pre-processed GPURT shader library indicated by the pipeline context.
+//
+// The library is kept in the context, keyed by everything its translation depends on, so that later pipelines
+// compiled in the same pooled context can clone it or import functions from it without translating the SPIR-V again.
+//
+// @param context : the context
+// @param [out] libraryKey : Key of the library in the context
+// @return true on success
+bool Compiler::prepareGpurtShaderLibrary(Context *context, MetroHash::Hash *libraryKey) {
   const RtState *rtState = context->getPipelineContext()->getRayTracingState();
 
+  {
+    MetroHash64 hasher;
+    PipelineDumper::updateHashForRtState(rtState, &hasher, true);
+    PipelineDumper::updateHashForPipelineOptions(context->getPipelineContext()->getPipelineOptions(), &hasher, true,
+                                                 UnlinkedStageCount);
+    hasher.Update(static_cast<unsigned>(context->getOptimizationLevel()));
+    hasher.Finalize(libraryKey->bytes);
+  }
+
+  if (context->hasGpurtLibrary(*libraryKey)) {
+    ContextPoolCounters.gpurtLibraryHits += 1;
+    return true;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  ContextPoolCounters.gpurtLibraryMisses += 1;
+
   ShaderModuleData moduleData = {};
   moduleData.binCode = rtState->gpurtShaderLibrary;
   moduleData.binType = BinaryType::Spirv;
@@ -1966,7 +2033,8 @@ std::unique_ptr<Module> Compiler::createGpurtShaderLibrary(Context *context) {
   timerProfiler.addTimerStartStopPass(*lowerPassMgr, TimerTranslate, true);
 
   // SPIR-V translation, then dump the result.
-  lowerPassMgr->addPass(SpirvLowerTranslator(ShaderStageCompute, &shaderInfo));
+  lowerPassMgr->addPass(
+      SpirvLowerTranslator(ShaderStageCompute, &shaderInfo, timerProfiler.getTimer(TimerSpirvParse)));
   if (EnableOuts()) {
     lowerPassMgr->addPass(
         PrintModulePass(outs(), "\n"
@@ -1983,10 +2051,13 @@ std::unique_ptr<Module> Compiler::createGpurtShaderLibrary(Context *context) {
   bool success = runPasses(&*lowerPassMgr, module.get());
   if (!success) {
     LLPC_ERRS("Failed to translate SPIR-V or run per-shader passes\n");
-    return {};
+    return false;
   }
 
-  return module;
+  context->setGpurtLibrary(*libraryKey, std::move(module));
+  ContextPoolCounters.gpurtLibraryInitNs += elapsedNs(start);
+
+  return true;
 }
 
 // =====================================================================================================================
@@ -2434,7 +2505,8 @@ Result Compiler::buildRayTracingPipelineInternal(RayTracingContext &rtContext,
     SpirvLower::registerPasses(*lowerPassMgr);
 
     // SPIR-V translation, then dump the result.
-    lowerPassMgr->addPass(SpirvLowerTranslator(shaderInfoEntry->entryStage, shaderInfoEntry));
+    lowerPassMgr->addPass(SpirvLowerTranslator(shaderInfoEntry->entryStage, shaderInfoEntry,
+                                               timerProfiler.getTimer(TimerSpirvParse)));
     lowerPassMgr->addPass(SpirvLowerCfgMerges());
     lowerPassMgr->addPass(AlwaysInlinerPass());
     if (moduleData->usage.enableRayQuery)
@@ -2767,6 +2839,10 @@ Result Compiler::validatePipelineShaderInfo(const PipelineShaderInfo *shaderInfo
 
 // =====================================================================================================================
 // Acquires a free context from context pool.
+//
+// Pooled contexts are keyed by graphics IP and compiler option hash, so that an idle context handed out here has been
+// warmed up by earlier compiles with the same configuration: its target machine, LGC context and any pre-processed
+// GPURT library can be reused as they are.
 Context *Compiler::acquireContext() const {
   Context *freeContext = nullptr;
 
@@ -2776,12 +2852,17 @@ Context *Compiler::acquireContext() const {
   for (auto &context : *m_contextPool) {
     GfxIpVersion gfxIpVersion = context->getGfxIpVersion();
 
-    if (!context->isInUse() && gfxIpVersion == m_gfxIp) {
+    if (!context->isInUse() && gfxIpVersion == m_gfxIp && context->getOptionHash() == m_optionHash) {
       // Free up context if it is being used too many times to avoid consuming too much memory.
       int contextReuseLimit = cl::ContextReuseLimit.getValue();
       if (contextReuseLimit > 0 && context->getUseCount() > contextReuseLimit) {
+        auto start = std::chrono::steady_clock::now();
         delete context;
-        context = new Context(m_gfxIp);
+        context = new Context(m_gfxIp, m_optionHash);
+        ContextPoolCounters.contextMisses += 1;
+        ContextPoolCounters.contextInitNs += elapsedNs(start);
+      } else {
+        ContextPoolCounters.contextHits += 1;
       }
       freeContext = context;
       break;
@@ -2790,8 +2871,11 @@ Context *Compiler::acquireContext() const {
 
   if (!freeContext) {
     // Create a new one if we fail to find an available one
-    freeContext = new Context(m_gfxIp);
+    auto start = std::chrono::steady_clock::now();
+    freeContext = new Context(m_gfxIp, m_optionHash);
     m_contextPool->push_back(freeContext);
+    ContextPoolCounters.contextMisses += 1;
+    ContextPoolCounters.contextInitNs += elapsedNs(start);
   }
 
   assert(freeContext);
@@ -2800,6 +2884,19 @@ Context *Compiler::acquireContext() const {
   return freeContext;
 }
 
+// =====================================================================================================================
+// Gets a snapshot of the context pool counters accumulated by all compilers in this process.
+Compiler::ContextPoolStats Compiler::getContextPoolStats() {
+  ContextPoolStats stats = {};
+  stats.contextHits = ContextPoolCounters.contextHits;
+  stats.contextMisses = ContextPoolCounters.contextMisses;
+  stats.contextInitNs = ContextPoolCounters.contextInitNs;
+  stats.gpurtLibraryHits = ContextPoolCounters.gpurtLibraryHits;
+  stats.gpurtLibraryMisses = ContextPoolCounters.gpurtLibraryMisses;
+  stats.gpurtLibraryInitNs = ContextPoolCounters.gpurtLibraryInitNs;
+  return stats;
+}
+
 // =====================================================================================================================
 // Run pass manager's passes on a module, catching any LLVM fatal error and returning a success indication
 //
@@ -165,6 +165,18 @@ public:
   Context *acquireContext() const;
   void releaseContext(Context *context) const;
 
+  // Counters describing how much context setup work the context pool has saved.
+  struct ContextPoolStats {
+    uint64_t contextHits;        // acquireContext() calls satisfied by an idle pooled context
+    uint64_t contextMisses;      // acquireContext() calls that had to create a new context
+    uint64_t contextInitNs;      // Time spent creating contexts, in nanoseconds
+    uint64_t gpurtLibraryHits;   // GPURT library requests satisfied from the context's pre-processed copy
+    uint64_t gpurtLibraryMisses; // GPURT library requests that had to translate the library
+    uint64_t gpurtLibraryInitNs; // Time spent translating the GPURT library, in nanoseconds
+  };
+
+  static ContextPoolStats getContextPoolStats();
+
   Result buildRayTracingPipelineElf(Context *context, std::unique_ptr<llvm::Module> module, ElfPackage &pipelineElf,
                                     std::vector<Vkgc::RayTracingShaderProperty> &shaderProps,
                                     std::vector<bool> &moduleCallsTraceRay, unsigned moduleIndex,
@@ -185,6 +197,7 @@ private:
                                           const GraphicsPipelineBuildInfo *pipelineInfo);
   bool canUseRelocatableComputeShaderElf(const ComputePipelineBuildInfo *pipelineInfo);
   std::unique_ptr<llvm::Module> createGpurtShaderLibrary(Context *context);
+  bool prepareGpurtShaderLibrary(Context *context, MetroHash::Hash *libraryKey);
   Result buildRayTracingPipelineInternal(RayTracingContext &rtContext,
                                          llvm::ArrayRef<const PipelineShaderInfo *> shaderInfo, bool unlinked,
                                          std::vector<ElfPackage> &pipelineElfs,
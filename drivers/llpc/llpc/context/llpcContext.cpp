@@ -40,6 +40,7 @@
 #include "lgc/GpurtDialect.h"
 #include "lgc/LgcContext.h"
 #include "lgc/LgcDialect.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/Bitstream/BitstreamReader.h"
@@ -67,7 +68,9 @@ namespace Llpc {
 // =====================================================================================================================
 //
 // @param gfxIp : Graphics IP version info
-Context::Context(GfxIpVersion gfxIp) : LLVMContext(), m_gfxIp(gfxIp) {
+// @param optionHash : Hash of the compiler options this context is pooled under
+Context::Context(GfxIpVersion gfxIp, const MetroHash::Hash &optionHash)
+    : LLVMContext(), m_gfxIp(gfxIp), m_optionHash(optionHash) {
   m_dialectContext = llvm_dialects::DialectContext::make<LgcDialect, GpurtDialect, LgcRtDialect, LgcCpsDialect>(*this);
   reset();
 }
@@ -192,4 +195,78 @@ void Context::setModuleTargetMachine(Module *module) {
   module->setDataLayout(dataLayoutStr);
 }
 
+// =====================================================================================================================
+// Gets a copy of the cached GPURT shader library.
+//
+// @param key : Hash of the state that the library is built from
+// @returns : A clone of the cached library, or null if no library is cached for the key
+std::unique_ptr<Module> Context::cloneGpurtLibrary(const MetroHash::Hash &key) const {
+  if (!hasGpurtLibrary(key))
+    return nullptr;
+  return CloneModule(*m_gpurtLibrary);
+}
+
+// =====================================================================================================================
+// Links the GPURT shader library functions that the module transitively references into the module.
+//
+// The cached library is written out as bitcode once and then read back lazily for each import, so only the function
+// bodies that the linker pulls in are materialized; the rest of the library is never parsed or cloned.
+//
+// @param key : Hash of the state that the library is built from
+// @param [in/out] module : Module to link the referenced library functions into
+// @param [in/out] importedFunctions : Incremented by the number of library functions imported
+// @param [in/out] importedInstructions : Incremented by the number of instructions in those functions
+// @returns : True on success, false if no library is cached for the key or linking fails
+bool Context::linkGpurtLibrary(const MetroHash::Hash &key, Module *module, unsigned *importedFunctions,
+                               uint64_t *importedInstructions) {
+  if (!hasGpurtLibrary(key))
+    return false;
+
+  if (m_gpurtLibraryBitcode.empty()) {
+    BitcodeWriter bcWriter(m_gpurtLibraryBitcode);
+    bcWriter.writeModule(*m_gpurtLibrary);
+    bcWriter.writeSymtab();
+    bcWriter.writeStrtab();
+  }
+
+  MemoryBufferRef bitcode(StringRef(m_gpurtLibraryBitcode.data(), m_gpurtLibraryBitcode.size()),
+                          m_gpurtLibrary->getName());
+  Expected<std::unique_ptr<Module>> libraryOrErr = getLazyBitcodeModule(bitcode, *this);
+  if (!libraryOrErr) {
+    consumeError(libraryOrErr.takeError());
+    LLPC_ERRS("Fails to load GPURT library bitcode\n");
+    return false;
+  }
+
+  SmallPtrSet<const Function *, 16> definedBefore;
+  for (const Function &func : *module) {
+    if (!func.isDeclaration())
+      definedBefore.insert(&func);
+  }
+
+  Linker linker(*module);
+  if (linker.linkInModule(std::move(*libraryOrErr), Linker::Flags::LinkOnlyNeeded))
+    return false;
+
+  for (const Function &func : *module) {
+    if (!func.isDeclaration() && !definedBefore.count(&func)) {
+      ++*importedFunctions;
+      *importedInstructions += func.getInstructionCount();
+    }
+  }
+  return true;
+}
+
+// =====================================================================================================================
+// Caches a pre-processed GPURT shader library. The module must have been created in this context.
+//
+// @param key : Hash of the state that the library is built from
+// @param library : The library module to keep
+void Context::setGpurtLibrary(const MetroHash::Hash &key, std::unique_ptr<Module> library) {
+  assert(!library || &library->getContext() == this);
+  m_gpurtLibrary = std::move(library);
+  m_gpurtLibraryKey = key;
+  m_gpurtLibraryBitcode.clear();
+}
+
 } // namespace Llpc
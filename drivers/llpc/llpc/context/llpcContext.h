@@ -50,7 +50,7 @@ namespace Llpc {
 // Represents LLPC context for pipeline compilation. Derived from the base class llvm::LLVMContext.
 class Context : public llvm::LLVMContext {
 public:
-  Context(GfxIpVersion gfxIp);
+  Context(GfxIpVersion gfxIp, const MetroHash::Hash &optionHash = {});
   ~Context();
 
   void reset();
@@ -113,6 +113,9 @@ public:
 
   GfxIpVersion getGfxIpVersion() const { return m_gfxIp; }
 
+  // Gets the hash of the compiler options this context was created for.
+  const MetroHash::Hash &getOptionHash() const { return m_optionHash; }
+
   uint64_t getPipelineHashCode() const { return m_pipelineContext->getPipelineHashCode(); }
 
   uint64_t get64BitCacheHashCode() const { return m_pipelineContext->get64BitCacheHashCode(); }
@@ -124,12 +127,29 @@ public:
   // Sets triple and data layout in specified module from the context's target machine.
   void setModuleTargetMachine(llvm::Module *module);
 
+  // Checks whether a pre-processed GPURT shader library is cached in this context for the key.
+  bool hasGpurtLibrary(const MetroHash::Hash &key) const { return m_gpurtLibrary && m_gpurtLibraryKey == key; }
+
+  // Gets a copy of the pre-processed GPURT shader library cached in this context, or null if there is none for the key.
+  std::unique_ptr<llvm::Module> cloneGpurtLibrary(const MetroHash::Hash &key) const;
+
+  // Links only the functions of the cached GPURT shader library that the module transitively references into it.
+  bool linkGpurtLibrary(const MetroHash::Hash &key, llvm::Module *module, unsigned *importedFunctions,
+                        uint64_t *importedInstructions);
+
+  // Gets the size of the bitcode that GPURT library imports are materialized from.
+  size_t getGpurtLibraryBitcodeSize() const { return m_gpurtLibraryBitcode.size(); }
+
+  // Caches a pre-processed GPURT shader library in this context, replacing any library cached under another key.
+  void setGpurtLibrary(const MetroHash::Hash &key, std::unique_ptr<llvm::Module> library);
+
 private:
   Context() = delete;
   Context(const Context &) = delete;
   Context &operator=(const Context &) = delete;
 
   GfxIpVersion m_gfxIp;                                 // Graphics IP version info
+  MetroHash::Hash m_optionHash;                         // Hash of the compiler options this context belongs to
   PipelineContext *m_pipelineContext;                   // Pipeline-specific context
   bool m_isInUse = false;                               // Whether this context is in use
   lgc::Builder *m_builder = nullptr;                    // LLPC builder object
@@ -147,6 +167,12 @@ private:
   std::unique_ptr<llvm_dialects::DialectContext> m_dialectContext;
 
   unsigned m_useCount = 0; // Number of times this context is used.
+
+  // GPURT shader library translated and pre-processed by an earlier pipeline compiled in this context. It survives
+  // reset() so that later pipelines with the same key can clone it instead of translating the SPIR-V again.
+  std::unique_ptr<llvm::Module> m_gpurtLibrary;
+  MetroHash::Hash m_gpurtLibraryKey = {};
+  llvm::SmallVector<char, 0> m_gpurtLibraryBitcode; // m_gpurtLibrary as bitcode, written on first import
 };
 
 } // namespace Llpc
@@ -33,7 +33,7 @@
 #include "llpcCompiler.h"
 #include "llpcContext.h"
 #include "lgc/Builder.h"
-#include <sstream>
+#include <istream>
 #include <string>
 
 #define DEBUG_TYPE "llpc-spirv-lower-translator"
@@ -84,8 +84,9 @@ void SpirvLowerTranslator::translateSpirvToLlvm(const PipelineShaderInfo *shader
   if (ShaderModuleHelper::optimizeSpirv(spirvBin, &optimizedSpirvBin) == Result::Success)
     spirvBin = &optimizedSpirvBin;
 
-  std::string spirvCode(static_cast<const char *>(spirvBin->pCode), spirvBin->codeSize);
-  std::istringstream spirvStream(spirvCode);
+  // Decode straight from the module's code buffer; there is no need to copy it into a string stream.
+  SPIRV::SPIRVInputBuffer spirvBuffer(spirvBin->pCode, spirvBin->codeSize);
+  std::istream spirvStream(&spirvBuffer);
   std::string errMsg;
   SPIRV::SPIRVSpecConstMap specConstMap;
   ShaderStage entryStage = shaderInfo->entryStage;
@@ -117,7 +118,7 @@ void SpirvLowerTranslator::translateSpirvToLlvm(const PipelineShaderInfo *shader
 
   if (!readSpirv(context->getBuilder(), &(moduleData->usage), &(shaderInfo->options), spirvStream,
                  convertToExecModel(entryStage), shaderInfo->pEntryTarget, specConstMap, convertingSamplers, module,
-                 errMsg)) {
+                 errMsg, m_parseTimer)) {
     report_fatal_error(Twine("Failed to translate SPIR-V to LLVM (") +
                            getShaderStageName(static_cast<ShaderStage>(entryStage)) + " shader): " + errMsg,
                        false);
@@ -33,6 +33,10 @@
 #include "llpcSpirvLower.h"
 #include "llvm/IR/PassManager.h"
 
+namespace llvm {
+class Timer;
+} // namespace llvm
+
 namespace Llpc {
 
 // =====================================================================================================================
@@ -44,7 +48,9 @@ public:
   //
   // @param stage : Shader stage
   // @param shaderInfo : Shader info for this shader
-  SpirvLowerTranslator(ShaderStage stage, const PipelineShaderInfo *shaderInfo) : m_shaderInfo(shaderInfo) {}
+  // @param parseTimer : Timer for decoding the SPIR-V binary (optional)
+  SpirvLowerTranslator(ShaderStage stage, const PipelineShaderInfo *shaderInfo, llvm::Timer *parseTimer = nullptr)
+      : m_shaderInfo(shaderInfo), m_parseTimer(parseTimer) {}
 
   llvm::PreservedAnalyses run(llvm::Module &module, llvm::ModuleAnalysisManager &analysisManager);
   bool runImpl(llvm::Module &module);
@@ -56,7 +62,8 @@ private:
 
   // -----------------------------------------------------------------------------------------------------------------
 
-  const PipelineShaderInfo *m_shaderInfo; // Input shader info
+  const PipelineShaderInfo *m_shaderInfo;   // Input shader info
+  llvm::Timer *m_parseTimer = nullptr;      // Timer for decoding the SPIR-V binary
 };
 
 } // namespace Llpc
@@ -34,6 +34,7 @@
 #endif
 
 #include "llpcAutoLayout.h"
+#include "LLVMSPIRVLib.h"
 #include "SPIRVFunction.h"
 #include "SPIRVInstruction.h"
 #include "SPIRVModule.h"
@@ -252,8 +253,8 @@ void doAutoLayoutDesc(ShaderStage shaderStage, BinaryData spirvBin, GraphicsPipe
                       PipelineShaderInfo *shaderInfo, ResourceMappingNodeMap &resNodeSets, unsigned &pushConstSize,
                       bool autoLayoutDesc, bool reverseThreadGroup) {
   // Read the SPIR-V.
-  std::string spirvCode(static_cast<const char *>(spirvBin.pCode), spirvBin.codeSize);
-  std::istringstream spirvStream(spirvCode);
+  SPIRV::SPIRVInputBuffer spirvBuffer(spirvBin.pCode, spirvBin.codeSize);
+  std::istream spirvStream(&spirvBuffer);
   std::unique_ptr<SPIRVModule> module(SPIRVModule::createSPIRVModule());
   spirvStream >> *module;
 
@@ -44,8 +44,11 @@
 #include "spirvExt.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Pass.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <map>
+#include <streambuf>
 #include <string>
 
 namespace SPIRV {
@@ -72,6 +75,40 @@ static const unsigned ConvertingSamplerDwordCount = 10;
 /// \brief Check if a string contains SPIR-V binary.
 bool IsSPIRVBinary(std::string &Img);
 
+/// \brief Read-only stream buffer over a SPIR-V binary that is already in memory.
+///
+/// The decoder reads words straight out of the caller's buffer, so there is no need to first copy the binary into a
+/// std::string and std::istringstream. The buffer must outlive any stream constructed on it.
+class SPIRVInputBuffer : public std::streambuf {
+public:
+  SPIRVInputBuffer(const void *Data, size_t Size) {
+    char *Begin = const_cast<char *>(static_cast<const char *>(Data));
+    setg(Begin, Begin, Begin + Size);
+  }
+
+protected:
+  std::streamsize xsgetn(char *S, std::streamsize N) override {
+    N = std::min<std::streamsize>(N, egptr() - gptr());
+    memcpy(S, gptr(), N);
+    setg(eback(), gptr() + N, egptr());
+    return N;
+  }
+
+  pos_type seekoff(off_type Off, std::ios_base::seekdir Dir, std::ios_base::openmode Which) override {
+    if (!(Which & std::ios_base::in))
+      return pos_type(off_type(-1));
+    char *Base = Dir == std::ios_base::beg ? eback() : Dir == std::ios_base::cur ? gptr() : egptr();
+    if (Off < eback() - Base || Off > egptr() - Base)
+      return pos_type(off_type(-1));
+    setg(eback(), Base + Off, egptr());
+    return pos_type(gptr() - eback());
+  }
+
+  pos_type seekpos(pos_type Pos, std::ios_base::openmode Which) override {
+    return seekoff(off_type(Pos), std::ios_base::beg, Which);
+  }
+};
+
 } // End namespace SPIRV
 
 namespace lgc {
@@ -86,16 +123,19 @@ struct PipelineShaderOptions;
 namespace llvm {
 
 class raw_pwrite_stream;
+class Timer;
 /// \brief Translate LLVM module to SPIRV and write to ostream.
 /// @returns : True if succeeds.
 bool writeSpirv(llvm::Module *M, llvm::raw_ostream &OS, std::string &ErrMsg);
 
-/// \brief Load SPIRV from istream and translate to LLVM module.
+/// \brief Load SPIRV from istream and translate to LLVM module. If ParseTimer is given, it times the decoding of the
+/// SPIR-V binary into the in-memory SPIR-V module, separately from the translation to LLVM IR.
 /// @returns : True if succeeds.
 bool readSpirv(lgc::Builder *Builder, const Vkgc::ShaderModuleUsage *ModuleData,
                const Vkgc::PipelineShaderOptions *ShaderOptions, std::istream &IS, spv::ExecutionModel EntryExecModel,
                const char *EntryName, const SPIRV::SPIRVSpecConstMap &SpecConstMap,
-               llvm::ArrayRef<SPIRV::ConvertingSampler> ConvertingSamplers, llvm::Module *M, std::string &ErrMsg);
+               llvm::ArrayRef<SPIRV::ConvertingSampler> ConvertingSamplers, llvm::Module *M, std::string &ErrMsg,
+               llvm::Timer *ParseTimer = nullptr);
 
 /// \brief Regularize LLVM module by removing entities not representable by
 /// SPIRV.
@@ -74,6 +74,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include <algorithm>
@@ -9864,12 +9865,15 @@ void SPIRVToLLVM::createXfbMetadata(bool hasXfbOuts) {
 bool llvm::readSpirv(Builder *builder, const ShaderModuleUsage *shaderInfo, const PipelineShaderOptions *shaderOptions,
                      std::istream &is, spv::ExecutionModel entryExecModel, const char *entryName,
                      const SPIRVSpecConstMap &specConstMap, ArrayRef<ConvertingSampler> convertingSamplers, Module *m,
-                     std::string &errMsg) {
+                     std::string &errMsg, Timer *parseTimer) {
   assert(entryExecModel != ExecutionModelKernel && "Not support ExecutionModelKernel");
 
   std::unique_ptr<SPIRVModule> bm(SPIRVModule::createSPIRVModule());
 
-  is >> *bm;
+  {
+    TimeRegion parseTimeRegion(parseTimer);
+    is >> *bm;
+  }
 
   SPIRVToLLVM btl(m, bm.get(), specConstMap, convertingSamplers, builder, shaderInfo, shaderOptions);
   bool succeed = true;
@@ -292,7 +292,7 @@ private:
   SPIRVAddressingModelKind AddrModel;
   SPIRVMemoryModelKind MemoryModel;
 
-  typedef std::map<SPIRVId, SPIRVEntry *> SPIRVIdToEntryMap;
+  typedef std::vector<SPIRVEntry *> SPIRVIdToEntryTable;
   typedef std::vector<SPIRVEntry *> SPIRVEntryVector;
   typedef std::set<SPIRVId> SPIRVIdSet;
   typedef std::vector<SPIRVId> SPIRVIdVec;
@@ -313,7 +313,7 @@ private:
   SPIRVEntryVector ExecModeIdVec;
   SPIRVForwardPointerVec ForwardPointerVec;
   SPIRVTypeVec TypeVec;
-  SPIRVIdToEntryMap IdEntryMap;
+  SPIRVIdToEntryTable IdEntryTable; // Indexed directly by id, sized to the module's id bound
   SPIRVFunctionVector FuncVec;
   SPIRVConstantVector ConstVec;
   SPIRVVariableVec VariableVec;
@@ -335,11 +335,12 @@ private:
   std::vector<SPIRVExtInst *> DebugInstVec;
 
   void layoutEntry(SPIRVEntry *Entry);
+  void setIdEntry(SPIRVId Id, SPIRVEntry *Entry);
 };
 
 SPIRVModuleImpl::~SPIRVModuleImpl() {
-  for (auto I : IdEntryMap)
-    delete I.second;
+  for (auto I : IdEntryTable)
+    delete I;
 
   for (auto I : EntryNoId) {
     delete I;
@@ -498,7 +499,7 @@ SPIRVEntry *SPIRVModuleImpl::addEntry(SPIRVEntry *Entry) {
         assert(Mapped == Entry && "Id used twice");
       }
     } else
-      IdEntryMap[Id] = Entry;
+      setIdEntry(Id, Entry);
   } else {
     if (EntryNoId.empty() || Entry != EntryNoId.back())
       EntryNoId.push_back(Entry);
@@ -527,14 +528,25 @@ bool SPIRVModuleImpl::exist(SPIRVId Id) const {
 
 bool SPIRVModuleImpl::exist(SPIRVId Id, SPIRVEntry **Entry) const {
   assert(Id != SPIRVID_INVALID && "Invalid Id");
-  SPIRVIdToEntryMap::const_iterator Loc = IdEntryMap.find(Id);
-  if (Loc == IdEntryMap.end())
+  if (Id >= IdEntryTable.size() || !IdEntryTable[Id])
     return false;
   if (Entry)
-    *Entry = Loc->second;
+    *Entry = IdEntryTable[Id];
   return true;
 }
 
+// Map an id to an entry (or unmap it if Entry is null), growing the id table if the id is beyond the bound that
+// was declared in the module header.
+void SPIRVModuleImpl::setIdEntry(SPIRVId Id, SPIRVEntry *Entry) {
+  assert(Id != SPIRVID_INVALID && "Invalid Id");
+  if (Id >= IdEntryTable.size()) {
+    if (!Entry)
+      return;
+    IdEntryTable.resize(std::max(size_t(Id) + 1, IdEntryTable.size() * 2), nullptr);
+  }
+  IdEntryTable[Id] = Entry;
+}
+
 // If Id is invalid, returns the next available id.
 // Otherwise returns the given id and adjust the next available id by increment.
 SPIRVId SPIRVModuleImpl::getId(SPIRVId Id, unsigned Increment) {
@@ -548,9 +560,8 @@ SPIRVId SPIRVModuleImpl::getId(SPIRVId Id, unsigned Increment) {
 
 SPIRVEntry *SPIRVModuleImpl::getEntry(SPIRVId Id) const {
   assert(Id != SPIRVID_INVALID && "Invalid Id");
-  SPIRVIdToEntryMap::const_iterator Loc = IdEntryMap.find(Id);
-  assert(Loc != IdEntryMap.end() && "Id is not in map");
-  return Loc->second;
+  assert(Id < IdEntryTable.size() && IdEntryTable[Id] && "Id is not in map");
+  return IdEntryTable[Id];
 }
 
 SPIRVExtInstSetKind SPIRVModuleImpl::getBuiltinSet(SPIRVId SetId) const {
@@ -770,13 +781,12 @@ SPIRVEntry *SPIRVModuleImpl::replaceForward(SPIRVForward *Forward, SPIRVEntry *E
   SPIRVId Id = Entry->getId();
   SPIRVId ForwardId = Forward->getId();
   if (ForwardId == Id)
-    IdEntryMap[Id] = Entry;
+    setIdEntry(Id, Entry);
   else {
-    auto Loc = IdEntryMap.find(Id);
-    assert(Loc != IdEntryMap.end());
-    IdEntryMap.erase(Loc);
+    assert(exist(Id));
+    setIdEntry(Id, nullptr);
     Entry->setId(ForwardId);
-    IdEntryMap[ForwardId] = Entry;
+    setIdEntry(ForwardId, Entry);
   }
   // Annotations include name, decorations, execution modes
   Entry->takeAnnotations(Forward);
@@ -793,9 +803,8 @@ SPIRVEntry *SPIRVModuleImpl::replaceForwardPointer(SPIRVTypeForwardPointer *Forw
 void SPIRVModuleImpl::eraseInstruction(SPIRVInstruction *I, SPIRVBasicBlock *BB) {
   SPIRVId Id = I->getId();
   BB->eraseInstruction(I);
-  auto Loc = IdEntryMap.find(Id);
-  assert(Loc != IdEntryMap.end());
-  IdEntryMap.erase(Loc);
+  assert(exist(Id));
+  setIdEntry(Id, nullptr);
   delete I;
 }
 
@@ -1099,6 +1108,18 @@ void SPIRVModuleImpl::addUnknownStructField(SPIRVTypeStruct *Struct, unsigned I,
   UnknownStructFieldMap[Struct].push_back(std::make_pair(I, ID));
 }
 
+// Returns the number of whole words between the current read position and the end of the stream, or 0 if the
+// stream can't be seeked.
+static size_t getRemainingWordCount(std::istream &I) {
+  const std::istream::pos_type Pos = I.tellg();
+  if (Pos == std::istream::pos_type(-1))
+    return 0;
+  I.seekg(0, std::ios_base::end);
+  const std::istream::pos_type End = I.tellg();
+  I.seekg(Pos);
+  return End > Pos ? size_t(End - Pos) / sizeof(SPIRVWord) : 0;
+}
+
 std::istream &operator>>(std::istream &I, SPIRVModule &M) {
   SPIRVDecoder Decoder(I, M);
   SPIRVModuleImpl &MI = *static_cast<SPIRVModuleImpl *>(&M);
@@ -1117,8 +1138,11 @@ std::istream &operator>>(std::istream &I, SPIRVModule &M) {
   MI.GeneratorId = Generator >> 16;
   MI.GeneratorVer = Generator & 0xFFFF;
 
-  // Bound for Id
+  // Bound for Id. All ids in the module are below it, so the id table can be sized up front and indexed directly.
+  // The bound is taken from the header unchecked, so cap the up-front size by the words left in the stream: each id
+  // needs an instruction of at least one word to define it. Ids past the cap still grow the table on demand.
   Decoder >> MI.NextId;
+  MI.IdEntryTable.resize(std::min(size_t(MI.NextId), getRemainingWordCount(I) + 1), nullptr);
 
   Decoder >> MI.InstSchema;
   assert(MI.InstSchema == SPIRVISCH_Default && "Unsupported instruction schema");
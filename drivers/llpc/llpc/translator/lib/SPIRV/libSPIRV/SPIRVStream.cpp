@@ -74,17 +74,25 @@ SPIRV_DEF_ENCDEC(LinkageType)
 // Read a string with padded 0's at the end so that they form a stream of
 // words.
 const SPIRVDecoder &operator>>(const SPIRVDecoder &I, std::string &Str) {
+  std::streambuf *Buf = I.IS.rdbuf();
   uint64_t Count = 0;
-  char Ch;
-  while (I.IS.get(Ch) && Ch != '\0') {
-    Str += Ch;
+  for (;;) {
+    int Ch = Buf->sbumpc();
+    if (Ch == std::char_traits<char>::eof()) {
+      I.IS.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+      return I;
+    }
+    if (Ch == '\0')
+      break;
+    Str += static_cast<char>(Ch);
     ++Count;
   }
   Count = (Count + 1) % 4;
   Count = Count ? 4 - Count : 0;
   for (; Count; --Count) {
-    I.IS >> Ch;
+    int Ch = Buf->sbumpc();
     assert(Ch == '\0' && "Invalid string in SPIRV");
+    (void)Ch;
   }
   return I;
 }
@@ -74,9 +74,12 @@ public:
   SPIRVEntry *Scope; // A function or basic block
 };
 
+// Reads one word. This goes straight to the stream buffer rather than through std::istream::read, which saves
+// constructing a sentry for every word of the module.
 template <typename T> const SPIRVDecoder &decodeBinary(const SPIRVDecoder &I, T &V) {
-  uint32_t W;
-  I.IS.read(reinterpret_cast<char *>(&W), sizeof(W));
+  uint32_t W = 0;
+  if (I.IS.rdbuf()->sgetn(reinterpret_cast<char *>(&W), sizeof(W)) != sizeof(W))
+    I.IS.setstate(std::ios_base::eofbit | std::ios_base::failbit);
   V = static_cast<T>(W);
   return I;
 }
@@ -0,0 +1,128 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2023 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "llpcContext.h"
+#include "vkgcMetroHash.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Module.h"
+#include "gmock/gmock.h"
+
+using namespace llvm;
+
+namespace Llpc {
+namespace {
+
+constexpr GfxIpVersion GfxIp = {9, 0, 0};
+
+// cppcheck-suppress syntaxError
+TEST(LlpcContextTests, GpurtLibraryCacheMatchesKey) {
+  MetroHash::Hash optionHash = {};
+  optionHash.qwords[0] = 0x1234;
+  Context context(GfxIp, optionHash);
+  EXPECT_EQ(context.getOptionHash(), optionHash);
+
+  MetroHash::Hash keyA = {};
+  keyA.qwords[0] = 1;
+  MetroHash::Hash keyB = {};
+  keyB.qwords[0] = 2;
+
+  // Nothing is cached in a fresh context.
+  EXPECT_FALSE(context.cloneGpurtLibrary(keyA));
+
+  context.setGpurtLibrary(keyA, std::make_unique<Module>("gpurt", context));
+
+  std::unique_ptr<Module> first = context.cloneGpurtLibrary(keyA);
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first->getModuleIdentifier(), "gpurt");
+
+  // Each lookup returns an independent copy that callers are free to consume.
+  std::unique_ptr<Module> second = context.cloneGpurtLibrary(keyA);
+  ASSERT_TRUE(second);
+  EXPECT_NE(first.get(), second.get());
+
+  EXPECT_FALSE(context.cloneGpurtLibrary(keyB));
+
+  // The cached library survives resetting the context between pipelines.
+  context.reset();
+  EXPECT_TRUE(context.cloneGpurtLibrary(keyA));
+
+  // Caching under a new key replaces the old library.
+  context.setGpurtLibrary(keyB, std::make_unique<Module>("gpurt2", context));
+  EXPECT_FALSE(context.cloneGpurtLibrary(keyA));
+  EXPECT_TRUE(context.cloneGpurtLibrary(keyB));
+}
+
+// Adds a function that returns void and calls each of the callees.
+static Function *addFunction(Module &module, StringRef name, ArrayRef<Function *> callees) {
+  auto *funcTy = FunctionType::get(Type::getVoidTy(module.getContext()), false);
+  Function *func = Function::Create(funcTy, GlobalValue::ExternalLinkage, name, module);
+  IRBuilder<> builder(BasicBlock::Create(module.getContext(), "", func));
+  for (Function *callee : callees)
+    builder.CreateCall(module.getOrInsertFunction(callee->getName(), funcTy));
+  builder.CreateRetVoid();
+  return func;
+}
+
+TEST(LlpcContextTests, GpurtLibraryLinkImportsOnlyReferencedFunctions) {
+  Context context(GfxIp);
+
+  // Library: entry -> helper, plus an unrelated function.
+  auto library = std::make_unique<Module>("gpurt", context);
+  Function *helper = addFunction(*library, "helper", {});
+  addFunction(*library, "entry", {helper});
+  addFunction(*library, "unused", {});
+
+  MetroHash::Hash key = {};
+  key.qwords[0] = 1;
+  context.setGpurtLibrary(key, std::move(library));
+
+  // Shader module that only declares the library entry point it calls.
+  Module shader("shader", context);
+  auto *funcTy = FunctionType::get(Type::getVoidTy(context), false);
+  Function *entryDecl = Function::Create(funcTy, GlobalValue::ExternalLinkage, "entry", shader);
+  addFunction(shader, "main", {entryDecl});
+
+  unsigned importedFunctions = 0;
+  uint64_t importedInstructions = 0;
+  ASSERT_TRUE(context.linkGpurtLibrary(key, &shader, &importedFunctions, &importedInstructions));
+
+  EXPECT_EQ(importedFunctions, 2u);
+  EXPECT_EQ(importedInstructions, 3u); // call + ret in entry, ret in helper
+  EXPECT_GT(context.getGpurtLibraryBitcodeSize(), 0u);
+  ASSERT_NE(shader.getFunction("entry"), nullptr);
+  EXPECT_FALSE(shader.getFunction("entry")->isDeclaration());
+  ASSERT_NE(shader.getFunction("helper"), nullptr);
+  EXPECT_FALSE(shader.getFunction("helper")->isDeclaration());
+  EXPECT_EQ(shader.getFunction("unused"), nullptr);
+
+  // A mismatched key imports nothing.
+  MetroHash::Hash otherKey = {};
+  otherKey.qwords[0] = 2;
+  Module other("other", context);
+  EXPECT_FALSE(context.linkGpurtLibrary(otherKey, &other, &importedFunctions, &importedInstructions));
+}
+
+} // namespace
+} // namespace Llpc
@@ -78,6 +78,11 @@ TimerProfiler::TimerProfiler(uint64_t hash64, const char *descriptionPrefix, uns
           "llpc-translate", (Twine(descriptionPrefix) + Twine(" Translate ") + hashString).str(), m_phases);
     }
 
+    if (enableMask & (1 << TimerSpirvParse)) {
+      m_phaseTimers[TimerSpirvParse].init(
+          "llpc-spirv-parse", (Twine(descriptionPrefix) + Twine(" SPIR-V Parse ") + hashString).str(), m_phases);
+    }
+
     if (enableMask & (1 << TimerLower)) {
       m_phaseTimers[TimerLower].init("llpc-lower", (Twine(descriptionPrefix) + Twine(" Lower ") + hashString).str(),
                                      m_phases);
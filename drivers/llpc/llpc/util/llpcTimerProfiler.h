@@ -46,12 +46,13 @@ namespace Llpc {
 // =====================================================================================================================
 // Enumerates the kinds of timer used to do profiling for LLPC compilation phases.
 enum TimerKind : unsigned {
-  TimerTranslate, // Timer for translator
-  TimerLower,     // Timer for SPIR-V lowering
-  TimerLoadBc,    // Timer for loading LLVM bitcode
-  TimerPatch,     // Timer for LLVM patching
-  TimerOpt,       // Timer for LLVM optimization
-  TimerCodeGen,   // Timer for backend code generation
+  TimerTranslate,  // Timer for translator
+  TimerSpirvParse, // Timer for decoding the SPIR-V binary (a sub-phase of translate)
+  TimerLower,      // Timer for SPIR-V lowering
+  TimerLoadBc,     // Timer for loading LLVM bitcode
+  TimerPatch,      // Timer for LLVM patching
+  TimerOpt,        // Timer for LLVM optimization
+  TimerCodeGen,    // Timer for backend code generation
 
   TimerCount
 };
@@ -73,7 +74,8 @@ public:
   static const llvm::StringMap<llvm::TimeRecord> &getDummyTimeRecords();
 
   static const unsigned PipelineTimerEnableMask = ((1 << TimerCount) - 1);
-  static const unsigned ShaderModuleTimerEnableMask = ((1 << TimerTranslate) | (1 << TimerLower));
+  static const unsigned ShaderModuleTimerEnableMask =
+      ((1 << TimerTranslate) | (1 << TimerSpirvParse) | (1 << TimerLower));
 
 private:
   TimerProfiler(const TimerProfiler &) = delete;
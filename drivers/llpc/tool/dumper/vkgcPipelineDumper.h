@@ -104,6 +104,8 @@ public:
   static void updateHashForPipelineOptions(const PipelineOptions *options, MetroHash64 *hasher, bool isCacheHash,
                                            UnlinkedShaderStage stage);
 
+  static void updateHashForRtState(const RtState *rtState, MetroHash64 *hasher, bool isCacheHash);
+
   // Get name of register, or "" if not known
   static const char *getRegisterNameString(unsigned regNumber);
 
@@ -121,7 +123,6 @@ private:
                                          const RayTracingPipelineBuildInfo *pipelineInfo);
   static void dumpRayTracingStateInfo(const RayTracingPipelineBuildInfo *pipelineInfo, const char *dumpDir,
                                       std::ostream &dumpFile);
-  static void updateHashForRtState(const RtState *rtState, MetroHash64 *hasher, bool isCacheHash);
 
   static void dumpVersionInfo(std::ostream &dumpFile);
   static void dumpPipelineShaderInfo(const PipelineShaderInfo *shaderInfo, std::ostream &dumpFile);
@@ -77,6 +77,18 @@ pal_bp(PAL_DISPLAY_DCC ON DEPENDS_ON PAL_AMDGPU_BUILD)
 # Build null device backend for offline compilation
 pal_bp(PAL_BUILD_NULL_DEVICE ON)
 
+# Build the CPU-only command recording benchmark (tools/cmdRecordBench), which runs on the null device
+pal_bp(PAL_BUILD_CMD_RECORD_BENCH OFF DEPENDS_ON PAL_BUILD_NULL_DEVICE)
+
+# Build the CPU-only pipeline cache layer benchmark (tools/cacheLayerBench)
+pal_bp(PAL_BUILD_CACHE_LAYER_BENCH OFF)
+
+# Build the host image copy validation and benchmark tool (tools/hostCopyBench), which runs on the null device
+pal_bp(PAL_BUILD_HOST_COPY_BENCH OFF DEPENDS_ON PAL_BUILD_NULL_DEVICE)
+
+# Build the amdgpu BO list validation and benchmark tool (tools/boListBench), which runs against stand-in DRM libraries
+pal_bp(PAL_BUILD_BO_LIST_BENCH OFF DEPENDS_ON PAL_AMDGPU_BUILD)
+
 # Build PAL with Graphics support?
 pal_bp(PAL_BUILD_GFX ON)
 
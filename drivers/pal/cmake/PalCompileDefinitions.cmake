@@ -225,6 +225,24 @@ function(pal_compile_definitions TARGET)
 
     target_compile_definitions(${TARGET} PUBLIC PAL_64BIT_ARCHIVE_FILE_FMT=$<BOOL:${PAL_64BIT_ARCHIVE_FILE_FMT}>)
 
+    # Identifies the layout of CodeObjectMetadata, which the pre-digested metadata note copies verbatim.  Needs to be
+    # public since the note is written by clients through palPipelineAbiProcessor.h and read by PAL.
+    set(PAL_ABI_METADATA_LAYOUT_FILES
+        ${PAL_SOURCE_DIR}/inc/core/g_palPipelineAbiMetadata.h
+        ${PAL_SOURCE_DIR}/inc/core/palPipelineAbi.h
+    )
+    set(PAL_ABI_METADATA_LAYOUT "")
+    foreach(LAYOUT_FILE ${PAL_ABI_METADATA_LAYOUT_FILES})
+        file(SHA256 ${LAYOUT_FILE} LAYOUT_FILE_HASH)
+        string(APPEND PAL_ABI_METADATA_LAYOUT ${LAYOUT_FILE_HASH})
+    endforeach()
+    string(SHA256 PAL_ABI_METADATA_LAYOUT_HASH "${PAL_ABI_METADATA_LAYOUT}")
+    string(SUBSTRING ${PAL_ABI_METADATA_LAYOUT_HASH} 0 16 PAL_ABI_METADATA_LAYOUT_HASH)
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${PAL_ABI_METADATA_LAYOUT_FILES})
+    target_compile_definitions(${TARGET} PUBLIC
+        PAL_PIPELINE_ABI_METADATA_LAYOUT_HASH=0x${PAL_ABI_METADATA_LAYOUT_HASH}ULL
+    )
+
     pal_compile_definitions_gpu(${TARGET})
 
 endfunction()
@@ -361,6 +361,29 @@ struct CacheLayerBaseCreateInfo
                                 ///  storage. Allocation callbacks must be valid for the life of the cache layer
 };
 
+/// Changes to the contents of an in-memory cache layer reported through @ref MemoryCacheNotifyFunc.
+enum class MemoryCacheEvent : uint32
+{
+    EntryAdded,    ///< An entry's data became available: it was stored, promoted or merged, or a reserved entry was
+                   ///  filled in.
+    EntryRemoved,  ///< An entry with data was evicted.
+    EntryReplaced, ///< An entry's data was swapped by a store with StoreFlags::replaceExisting. Ids name their
+                   ///  contents, so the new data is another encoding of the same contents.
+};
+
+/// Reports a change to the contents of an in-memory cache layer.  The layer is destroyed without reporting its
+/// entries as removed.
+///
+/// @param [in] pClientData  The pNotifyClientData value from MemoryCacheCreateInfo.
+/// @param [in] event        What happened to the entry.
+/// @param [in] pHashId      Id of the entry.
+///
+/// @note The callback is made while the cache holds a lock, so it must not call back into the cache layer.
+typedef void (PAL_STDCALL *MemoryCacheNotifyFunc)(
+    void*            pClientData,
+    MemoryCacheEvent event,
+    const Hash128*   pHashId);
+
 /**
 ***********************************************************************************************************************
 * @brief Information needed to create an in-memory key-value store
@@ -368,13 +391,19 @@ struct CacheLayerBaseCreateInfo
 */
 struct MemoryCacheCreateInfo
 {
-    CacheLayerBaseCreateInfo baseInfo;        ///< Base cache layer creation info
-    size_t                   maxObjectCount;  ///< Maximum number of entries in cache
-    size_t                   maxMemorySize;   ///< Maximum total size of entries in cache
-    uint32                   expectedEntries; ///< Expected number of entries in cache
-    bool                     evictOnFull;     ///< Whether or not the cache should evict entries based on LRU to
-                                              ///  make room for new ones
-    bool                     evictDuplicates; ///< Whether or not the cache should evict entries with a duplicate hash
+    CacheLayerBaseCreateInfo baseInfo;           ///< Base cache layer creation info
+    size_t                   maxObjectCount;     ///< Maximum number of entries in cache
+    size_t                   maxMemorySize;      ///< Maximum total size of entries in cache
+    uint32                   expectedEntries;    ///< Expected number of entries in cache
+    uint32                   numShards;          ///< Number of independently locked partitions of the cache. Rounded
+                                                 ///  up to a power of two; 0 selects the default of 16. Use 1 to
+                                                 ///  choose eviction candidates from all entries at once.
+    bool                     evictOnFull;        ///< Whether or not the cache should evict entries based on LRU to
+                                                 ///  make room for new ones
+    bool                     evictDuplicates;    ///< Whether or not the cache should evict entries with a duplicate
+                                                 ///  hash
+    MemoryCacheNotifyFunc    pfnNotify;          ///< Optional callback told about every change to the entries
+    void*                    pNotifyClientData;  ///< Passed back to every pfnNotify call
 };
 
 /// Get the memory size for a in-memory cache layer
@@ -423,6 +452,30 @@ Result GetMemoryCacheLayerHashIds(
     size_t          curCount,
     Hash128*        pHashIds);
 
+/// Copy the entries of in-memory cache layers into another in-memory cache layer
+///
+/// Entries are copied as stored, so data compressed by a CompressingCacheLayer above the source layers stays
+/// compressed; the destination must be read through an equivalent layer chain. Entries already present in the
+/// destination or in an earlier source are skipped before any data is copied, and the new entries of each destination
+/// shard are inserted under a single lock acquisition. The destination shards are split into partCount disjoint
+/// partitions so that the partitions can be merged concurrently from different threads.
+///
+/// @param [in]         pDstLayer      memory cache layer to merge into.
+/// @param [in]         ppSrcLayers    memory cache layers to merge from.
+/// @param [in]         srcLayerCount  number of entries in ppSrcLayers.
+/// @param [in]         partIndex      partition of the destination shards handled by this call.
+/// @param [in]         partCount      total number of partitions, must be non-zero.
+///
+/// @return Success if all entries of the partition were merged. Otherwise, one of the following errors may be returned:
+///         + ErrorShaderCacheFull if the destination cannot make room for the new entries.
+///         + ErrorOutOfMemory if copying the entries failed.
+Result MergeMemoryCacheLayers(
+    ICacheLayer*        pDstLayer,
+    ICacheLayer* const* ppSrcLayers,
+    uint32              srcLayerCount,
+    uint32              partIndex,
+    uint32              partCount);
+
 /**
 ***********************************************************************************************************************
 * @brief Information needed to create an archive file backed key-value store
@@ -519,6 +572,10 @@ struct CompressingCacheLayerCreateInfo
                                 ///  which takes a bit more time to compress but decompresses just as fast.
     bool decompressOnly;        ///< True if we want to use the layer as a pass-through to support reading of any
                                 ///  existing compressed data.
+    bool asyncCompression;      ///< True if stores should pass the uncompressed data to the next layer immediately
+                                ///  and have a background thread replace it with the compressed data later.
+                                ///  The next layer must support StoreFlags::replaceExisting (the memory cache
+                                ///  layer does) for the replacement to happen.
 };
 
 /// Get the memory size for a compressing cache layer
@@ -1274,8 +1274,11 @@ struct DeviceProperties
                 uint32 supportsCornerSampling       :  1;
                 /// Placeholder, do not use.
                 uint32 placeholder0                 :  1;
+                /// Set if IImage::CopyMemoryToImage() and IImage::CopyImageToMemory() can address every swizzle mode
+                /// an image created with needSwizzleEqs set may be given.
+                uint32 supportsHostImageCopy        :  1;
                 /// Reserved for future use.
-                uint32 reserved                     : 29;
+                uint32 reserved                     : 28;
             };
             uint32 u32All;              ///< Flags packed as 32-bit uint.
         } flags;                        ///< GPU memory property flags.
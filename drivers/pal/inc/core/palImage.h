@@ -568,6 +568,20 @@ struct SubresRange
     uint32   numSlices;    ///< Number of slices in the range.
 };
 
+/// Specifies parameters for a CPU copy between an image and host memory.  The same structure is used regardless of
+/// direction, an input for both IImage::CopyMemoryToImage() and IImage::CopyImageToMemory().
+struct HostImageCopyRegion
+{
+    SubresId imageSubres;    ///< Selects the image subresource.
+    Offset3d imageOffset;    ///< Pixel offset to the start of the chosen subresource region.
+    Extent3d imageExtent;    ///< Size of the image region in pixels.
+    uint32   numSlices;      ///< Number of slices the copy will span.
+    void*    pHostMemory;    ///< CPU address of the first pixel of the region in host memory.  It is only read from
+                             ///  by CopyMemoryToImage() and only written to by CopyImageToMemory().
+    gpusize  hostRowPitch;   ///< Offset in bytes between the same X position on two consecutive lines.
+    gpusize  hostDepthPitch; ///< Offset in bytes between the same X,Y position of two consecutive slices.
+};
+
 /**
  ***********************************************************************************************************************
  * @interface IImage
@@ -622,6 +636,46 @@ public:
         SubresLayout* pLayout) const = 0;
 #endif
 
+    /// Copies texel data from host memory into this image using the CPU.
+    ///
+    /// The image must be bound to CPU-visible GPU memory and must have been created with needSwizzleEqs set and with
+    /// metadata disabled, so its raw memory holds nothing but swizzled texels.  PAL maps the bound memory for the
+    /// duration of the call.  The client is responsible for making sure the GPU is not accessing the affected
+    /// subresources while the copy is in progress.
+    ///
+    /// @param [in] regionCount Number of regions in pRegions.
+    /// @param [in] pRegions    Regions to copy; see @ref HostImageCopyRegion.
+    /// @param [in] maxThreads  Upper bound on the number of CPU threads (including the calling thread) PAL may use to
+    ///                         split the copy across subresources and slices.  Zero and one both mean single-threaded.
+    ///
+    /// @returns Success if the copy completed.  Otherwise, one of the following error codes may be returned:
+    ///          + ErrorInvalidPointer if pRegions is null.
+    ///          + ErrorGpuMemoryNotBound if the image is not bound to GPU memory.
+    ///          + ErrorNotMappable if the bound GPU memory is not CPU-visible.
+    ///          + ErrorUnavailable if a subresource's layout cannot be addressed on the CPU.  This doesn't happen on a
+    ///            device which reports supportsHostImageCopy, as long as the format's elements are a power of two
+    ///            bytes and map one-to-one onto texels or compressed blocks.
+    ///          + ErrorUnknown, in builds with PAL_ENABLE_PRINTS_ASSERTS, if the copied data disagrees with AddrLib's
+    ///            per-element addressing.
+    virtual Result CopyMemoryToImage(
+        uint32                     regionCount,
+        const HostImageCopyRegion* pRegions,
+        uint32                     maxThreads) = 0;
+
+    /// Copies texel data from this image into host memory using the CPU.
+    ///
+    /// The requirements on the image and the reported errors are the same as for CopyMemoryToImage().
+    ///
+    /// @param [in] regionCount Number of regions in pRegions.
+    /// @param [in] pRegions    Regions to copy; see @ref HostImageCopyRegion.
+    /// @param [in] maxThreads  Upper bound on the number of CPU threads (including the calling thread) PAL may use.
+    ///
+    /// @returns Success if the copy completed, or an error code as described for CopyMemoryToImage().
+    virtual Result CopyImageToMemory(
+        uint32                     regionCount,
+        const HostImageCopyRegion* pRegions,
+        uint32                     maxThreads) = 0;
+
     /// Reports the create info of image.
     ///
     /// @returns the reference to ImageCreateInfo
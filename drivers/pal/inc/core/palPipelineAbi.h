@@ -48,6 +48,8 @@ constexpr uint8  ElfAbiVersionAmdgpuHsaV4 = 2;  ///< ELFABIVERSION_AMDGPU_HSA_V4
 constexpr uint8  ElfAbiVersionAmdgpuPal   = 0;  ///< ELFABIVERSION_AMDGPU_PAL
 
 constexpr uint32 MetadataNoteType                = 32;   ///< NT_AMDGPU_METADATA
+constexpr uint32 MetadataDigestNoteType          = 0x80000020; ///< PAL specific: pre-digested PAL metadata, see
+                                                               ///  PalAbi::MetadataDigestHeader.
 constexpr uint64 PipelineShaderBaseAddrAlignment = 256;  ///< Base address alignment for shader stage entry points on
                                                          ///  AMD GPUs.
 constexpr uint64 DataMinBaseAddrAlignment        = 32;   ///< Minimum base address alignment for Data section.
@@ -247,6 +247,14 @@ public:
         MsgPackReader*              pReader,
         PalAbi::CodeObjectMetadata* pMetadata) const;
 
+    /// Adds a pre-digested copy of the decoded PAL metadata to the notes (see PalAbi::MetadataDigestHeader), which
+    /// lets PAL builds with the same metadata layout skip decoding the MessagePack metadata when loading this ELF. Does
+    /// nothing if the ELF has no PAL metadata, if the metadata cannot be decoded, if it already has a digest, or if
+    /// the build did not define the metadata layout hash.
+    ///
+    /// @returns Success if successful, otherwise ErrorOutOfMemory if memory allocation failed.
+    Result AddMetadataDigest();
+
     /// Get the Pipeline Metadata as a binary blob.
     ///
     /// @param [out] ppMetadata     Pointer to the pipeline metadata.
@@ -363,6 +363,87 @@ Result PipelineAbiProcessor<Allocator>::GetMetadata(
     return result;
 }
 
+// =====================================================================================================================
+template <typename Allocator>
+Result PipelineAbiProcessor<Allocator>::AddMetadataDigest()
+{
+    Result result = Result::Success;
+
+    if ((m_pMetadata != nullptr) && (m_pNoteSection != nullptr) && (PalAbi::MetadataDigestLayoutHash != 0))
+    {
+        Elf::NoteProcessor<Allocator> noteProcessor(m_pNoteSection, m_pAllocator);
+
+        result = noteProcessor.Init();
+
+        bool hasDigest = false;
+
+        for (uint32 i = 0; ((result == Result::Success) && (i < noteProcessor.GetNumNotes())); ++i)
+        {
+            uint32      type;
+            const char* pName;
+            const void* pDesc;
+            size_t      descSize;
+
+            noteProcessor.Get(i, &type, &pName, &pDesc, &descSize);
+
+            hasDigest |= (type == MetadataDigestNoteType);
+        }
+
+        if ((result == Result::Success) && (hasDigest == false))
+        {
+            auto*const pMetadata = static_cast<PalAbi::CodeObjectMetadata*>(
+                PAL_MALLOC(sizeof(PalAbi::CodeObjectMetadata), m_pAllocator, AllocInternalTemp));
+            auto*const pDigest   = static_cast<PalAbi::MetadataDigest*>(
+                PAL_MALLOC(sizeof(PalAbi::MetadataDigest), m_pAllocator, AllocInternalTemp));
+
+            if ((pMetadata == nullptr) || (pDigest == nullptr))
+            {
+                result = Result::ErrorOutOfMemory;
+            }
+            else
+            {
+                MsgPackReader reader;
+
+                // The digest is optional, so metadata which cannot be digested is left without one.
+                if ((GetMetadata(&reader, pMetadata) == Result::Success) &&
+                    (PalAbi::BuildMetadataDigest(*pMetadata,
+                                                 m_pMetadata,
+                                                 static_cast<uint32>(m_metadataSize),
+                                                 pDigest) == Result::Success))
+                {
+                    if (noteProcessor.Add(MetadataDigestNoteType, AmdGpuArchName, pDigest, sizeof(*pDigest)) ==
+                        UINT_MAX)
+                    {
+                        result = Result::ErrorOutOfMemory;
+                    }
+                }
+            }
+
+            PAL_FREE(pMetadata, m_pAllocator);
+            PAL_FREE(pDigest, m_pAllocator);
+
+            // Adding the note may have moved the note section, so find the metadata blob again.
+            for (uint32 i = 0; ((result == Result::Success) && (i < noteProcessor.GetNumNotes())); ++i)
+            {
+                uint32      type;
+                const char* pName;
+                const void* pDesc;
+                size_t      descSize;
+
+                noteProcessor.Get(i, &type, &pName, &pDesc, &descSize);
+
+                if (type == MetadataNoteType)
+                {
+                    m_pMetadata    = pDesc;
+                    m_metadataSize = descSize;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 template <typename Allocator>
 void PipelineAbiProcessor<Allocator>::GetMetadata(
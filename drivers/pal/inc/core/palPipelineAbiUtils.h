@@ -33,8 +33,12 @@
 
 #include "palPipelineAbi.h"
 #include "palInlineFuncs.h"
+#include "palMetroHash.h"
+#include "g_palPipelineAbiMetadata.h"
 
 #include <climits>
+#include <cstddef>
+#include <type_traits>
 
 namespace Util
 {
@@ -538,5 +542,223 @@ inline Result DeserializeCodeObjectMetadata(
     return result;
 }
 
+/// Identifies a pre-digested metadata note ("PALD").
+constexpr uint32 MetadataDigestMagic      = 0x444C4150;
+/// Version of the pre-digested metadata format.  Must be incremented whenever MetadataDigestHeader changes.
+constexpr uint32 MetadataDigestVersion    = 2;
+
+#if defined(PAL_PIPELINE_ABI_METADATA_LAYOUT_HASH)
+/// Hash of the headers which define CodeObjectMetadata, computed by the build.  It catches layout changes which keep
+/// both sizeof(CodeObjectMetadata) and the metadata version, such as reordered or retyped members.
+constexpr uint64 MetadataDigestLayoutHash = PAL_PIPELINE_ABI_METADATA_LAYOUT_HASH;
+#else
+/// Builds which don't compute the layout hash can neither write nor read a pre-digested metadata note.
+constexpr uint64 MetadataDigestLayoutHash = 0;
+#endif
+/// Offset stored for a pointer member of CodeObjectMetadata which is null.
+constexpr uint32 MetadataDigestNullOffset = UINT32_MAX;
+
+/// Header of the pre-digested metadata note (MetadataDigestNoteType).
+///
+/// The note holds a copy of the CodeObjectMetadata decoded from the MessagePack metadata note of the same ELF, so that
+/// a loader can copy it instead of decoding the MessagePack.  The copy is only meaningful to PAL builds with the same
+/// CodeObjectMetadata layout, which the header identifies; any other reader must ignore the note and decode the
+/// MessagePack metadata, which remains the authoritative copy.  The header also records a hash of the MessagePack
+/// metadata, so a digest left behind by a tool which rewrote the metadata is ignored too.  Pointer members of the
+/// copy, which point into the MessagePack metadata, are stored as offsets into it.
+struct MetadataDigestHeader
+{
+    uint32 magic;                ///< MetadataDigestMagic.
+    uint32 digestVersion;        ///< MetadataDigestVersion of the writer.
+    uint32 metadataVersion[2];   ///< PipelineMetadataMajorVersion and PipelineMetadataMinorVersion of the writer.
+    uint32 metadataStructSize;   ///< sizeof(CodeObjectMetadata) of the writer.
+    uint32 rawMetadataSize;      ///< Size of the MessagePack metadata in bytes.
+    uint64 layoutHash;           ///< MetadataDigestLayoutHash of the writer.
+    uint64 rawMetadataHash;      ///< MetroHash64 of the MessagePack metadata.
+    uint32 nameOffset;           ///< Offset of pipeline.name in the MessagePack metadata.
+    uint32 nameLength;           ///< Length of pipeline.name.
+    uint32 apiCreateInfoOffset;  ///< Offset of pipeline.apiCreateInfo in the MessagePack metadata.
+    uint32 reserved;             ///< Reserved for future use.
+};
+
+/// Contents of the pre-digested metadata note.
+struct MetadataDigest
+{
+    MetadataDigestHeader header;
+    CodeObjectMetadata   metadata;   ///< Decoded metadata with its pointer members cleared.
+};
+
+static_assert(std::is_trivially_copyable<CodeObjectMetadata>::value,
+              "The pre-digested metadata note requires CodeObjectMetadata to be copyable with memcpy.");
+
+/// Helper function to get the offset of a range referenced by decoded metadata within the MessagePack metadata.
+///
+/// @param [in]  pData           Start of the range, or null.
+/// @param [in]  size            Size of the range in bytes.
+/// @param [in]  pRawMetadata    The content of the metadata note section.
+/// @param [in]  rawMetadataSize The length of the note section.
+/// @param [out] pOffset         Offset of the range, or MetadataDigestNullOffset if pData is null.
+///
+/// @returns True if the range is null or within the MessagePack metadata.
+inline bool GetMetadataDigestOffset(
+    const void* pData,
+    uint32      size,
+    const void* pRawMetadata,
+    uint32      rawMetadataSize,
+    uint32*     pOffset)
+{
+    const uintptr_t start = reinterpret_cast<uintptr_t>(pRawMetadata);
+    const uintptr_t data  = reinterpret_cast<uintptr_t>(pData);
+
+    bool valid = true;
+
+    if (pData == nullptr)
+    {
+        *pOffset = MetadataDigestNullOffset;
+    }
+    else if ((data >= start) && (size <= rawMetadataSize) && ((data - start) <= (rawMetadataSize - size)))
+    {
+        *pOffset = static_cast<uint32>(data - start);
+    }
+    else
+    {
+        valid = false;
+    }
+
+    return valid;
+}
+
+/// Helper function to build the pre-digested metadata note of a pipeline ELF.
+///
+/// @param [in]  metadata        The metadata decoded from pRawMetadata.
+/// @param [in]  pRawMetadata    The content of the metadata note section.
+/// @param [in]  rawMetadataSize The length of the note section.
+/// @param [out] pDigest         The contents of the pre-digested metadata note.
+///
+/// @returns Success if successful, or ErrorInvalidValue if the metadata refers to memory outside of pRawMetadata.
+inline Result BuildMetadataDigest(
+    const CodeObjectMetadata& metadata,
+    const void*               pRawMetadata,
+    uint32                    rawMetadataSize,
+    MetadataDigest*           pDigest)
+{
+    // Clear everything, including padding, so that identical metadata always results in an identical note.
+    memset(pDigest, 0, sizeof(*pDigest));
+
+    MetadataDigestHeader*const pHeader = &pDigest->header;
+
+    pHeader->magic              = MetadataDigestMagic;
+    pHeader->digestVersion      = MetadataDigestVersion;
+    pHeader->metadataVersion[0] = PipelineMetadataMajorVersion;
+    pHeader->metadataVersion[1] = PipelineMetadataMinorVersion;
+    pHeader->metadataStructSize = sizeof(CodeObjectMetadata);
+    pHeader->rawMetadataSize    = rawMetadataSize;
+    pHeader->layoutHash         = MetadataDigestLayoutHash;
+
+    MetroHash64::Hash(static_cast<const uint8*>(pRawMetadata),
+                      rawMetadataSize,
+                      reinterpret_cast<uint8*>(&pHeader->rawMetadataHash));
+
+    const bool valid = GetMetadataDigestOffset(metadata.pipeline.name.Data(),
+                                               metadata.pipeline.name.Length(),
+                                               pRawMetadata,
+                                               rawMetadataSize,
+                                               &pHeader->nameOffset) &&
+                       GetMetadataDigestOffset(metadata.pipeline.apiCreateInfo.pBuffer,
+                                               metadata.pipeline.apiCreateInfo.sizeInBytes,
+                                               pRawMetadata,
+                                               rawMetadataSize,
+                                               &pHeader->apiCreateInfoOffset);
+
+    pHeader->nameLength = metadata.pipeline.name.Length();
+
+    memcpy(&pDigest->metadata, &metadata, sizeof(metadata));
+
+    pDigest->metadata.pipeline.name                  = StringViewType();
+    pDigest->metadata.pipeline.apiCreateInfo.pBuffer = nullptr;
+
+    return valid ? Result::Success : Result::ErrorInvalidValue;
+}
+
+/// Helper function to read the pre-digested metadata note of a pipeline ELF.
+///
+/// @param [in]  pDigest         The content of the pre-digested metadata note section.
+/// @param [in]  digestSize      The length of the pre-digested metadata note section.
+/// @param [in]  pRawMetadata    The content of the metadata note section.
+/// @param [in]  rawMetadataSize The length of the metadata note section.
+/// @param [out] pMetadata       The metadata.
+///
+/// @returns True if successful.  False if the digest was written by a PAL build with a different metadata layout or
+///          for different metadata; pMetadata is then undefined and the MessagePack metadata must be decoded instead.
+inline bool ReadMetadataDigest(
+    const void*         pDigest,
+    uint32              digestSize,
+    const void*         pRawMetadata,
+    uint32              rawMetadataSize,
+    CodeObjectMetadata* pMetadata)
+{
+    MetadataDigestHeader header = {};
+
+    bool valid = (digestSize == sizeof(MetadataDigest)) && (pRawMetadata != nullptr);
+
+    if (valid)
+    {
+        memcpy(&header, pDigest, sizeof(header));
+
+        valid = (header.magic              == MetadataDigestMagic)          &&
+                (header.digestVersion      == MetadataDigestVersion)        &&
+                (header.metadataVersion[0] == PipelineMetadataMajorVersion) &&
+                (header.metadataVersion[1] == PipelineMetadataMinorVersion) &&
+                (header.metadataStructSize == sizeof(CodeObjectMetadata))   &&
+                (header.rawMetadataSize    == rawMetadataSize)              &&
+                (header.layoutHash         == MetadataDigestLayoutHash)     &&
+                (MetadataDigestLayoutHash  != 0);
+    }
+
+    if (valid)
+    {
+        uint64 rawMetadataHash = 0;
+        MetroHash64::Hash(static_cast<const uint8*>(pRawMetadata),
+                          rawMetadataSize,
+                          reinterpret_cast<uint8*>(&rawMetadataHash));
+
+        valid = (rawMetadataHash == header.rawMetadataHash);
+    }
+
+    if (valid)
+    {
+        memcpy(pMetadata, VoidPtrInc(pDigest, offsetof(MetadataDigest, metadata)), sizeof(CodeObjectMetadata));
+
+        PipelineMetadata*const pPipeline = &pMetadata->pipeline;
+
+        if (header.nameOffset != MetadataDigestNullOffset)
+        {
+            valid = (header.nameLength <= rawMetadataSize) &&
+                    (header.nameOffset <= (rawMetadataSize - header.nameLength));
+
+            if (valid)
+            {
+                pPipeline->name = StringViewType(static_cast<const char*>(VoidPtrInc(pRawMetadata, header.nameOffset)),
+                                                 header.nameLength);
+            }
+        }
+
+        if (valid && (header.apiCreateInfoOffset != MetadataDigestNullOffset))
+        {
+            const uint32 apiCreateInfoSize = pPipeline->apiCreateInfo.sizeInBytes;
+
+            valid = (apiCreateInfoSize <= rawMetadataSize) &&
+                    (header.apiCreateInfoOffset <= (rawMetadataSize - apiCreateInfoSize));
+
+            if (valid)
+            {
+                pPipeline->apiCreateInfo.pBuffer = VoidPtrInc(pRawMetadata, header.apiCreateInfoOffset);
+            }
+        }
+    }
+
+    return valid;
+}
+
 } //Abi
 } //Pal
@@ -79,6 +79,12 @@ struct ArchiveFileOpenInfo
     bool                allowWriteAccess;         ///< Open file with write access
     bool                allowAsyncFileIo;         ///< Allow use of OS specific asynchronous file routines
     bool                useBufferedReadMemory;    ///< Allow preloading/read-ahead of file into memory
+    bool                useMemoryMappedRead;      ///< Map the file read-only and serve reads from the mapping. Takes
+                                                  ///  precedence over useBufferedReadMemory if the mapping succeeds.
+    bool                prefetchRecentEntries;    ///< Record the order entries are read in and, when the file is next
+                                                  ///  opened, warm those entries on a background thread in the same
+                                                  ///  order. Requires useMemoryMappedRead. The order is only recorded
+                                                  ///  if allowWriteAccess is set.
     size_t              maxReadBufferMem;         ///< Maximum size allowed for read buffer
     void*               pSecurity;                ///< Pointer to an os-specific security attribute to use for file ops.
 };
@@ -212,6 +218,24 @@ public:
         const ArchiveEntryHeader*   pHeader,
         void*                       pDataBuffer) = 0;
 
+    /// Get a pointer to the data for an entry located by its header, without copying it
+    ///
+    /// The data is validated against pHeader->dataCrc64 before it is returned. The pointer remains valid until the
+    /// archive file is destroyed.
+    ///
+    /// @param [in]  pHeader    Header of data entry desired
+    /// @param [out] ppData     Pointer to pHeader->dataSize bytes of entry data
+    ///
+    /// @return Success if the data is available. Otherwise, one of the following may be returned:
+    ///         + Unsupported if the file is not memory mapped or the entry lies outside of the mapped range. The data
+    ///           can still be retrieved through Read().
+    ///         + ErrorInvalidPointer if pHeader or ppData is nullptr
+    ///         + ErrorInvalidValue if pHeader->dataPosition is past the end of the file
+    ///         + ErrorIncompatibleLibrary if the data fails pHeader->dataCrc64 check
+    virtual Result GetEntryData(
+        const ArchiveEntryHeader*   pHeader,
+        const void**                ppData) { return Result::Unsupported; }
+
     /// Write header and data out to archive file
     ///
     /// If async file writes are allowed, this function will return before the write is fully complete.
@@ -525,7 +525,10 @@ struct StoreFlags
         {
             uint32 enableFileCache      : 1;    ///< If we should skip the file cache layer when we get to it.
             uint32 enableCompression    : 1;    ///< If we should skip the compression layer when we get to it.
-            uint32 reserved             : 30;
+            uint32 replaceExisting      : 1;    ///< If an entry with the same id already exists, swap the new data
+                                                ///  in for it instead of failing with AlreadyExists. Layers that
+                                                ///  can't replace in place ignore this and keep the existing entry.
+            uint32 reserved             : 29;
         };
         uint32 all;
     };
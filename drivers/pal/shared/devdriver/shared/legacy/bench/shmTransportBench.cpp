@@ -0,0 +1,429 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+// Loopback throughput benchmark for local developer driver transports.
+//
+// Streams maximum size messages between two threads of this process through the shared memory transport and through
+// an AF_UNIX datagram socket pair (the same kind of socket the socket transport uses for local connections), then
+// compares copying a bulk block out of a mapped shared memory object with streaming it as transfer data chunks.
+
+#include "shmMsgTransport.h"
+#include "protocols/ddTransferProtocol.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace DevDriver;
+
+namespace
+{
+
+// Port used for the benchmark listener. Anything that doesn't collide with a real developer service will do.
+constexpr uint16 BenchPort = 27399;
+
+constexpr uint32 TimeoutInMs = 5000;
+
+struct Options
+{
+    uint32 messageCount;
+    uint32 bulkSizeInMb;
+};
+
+// =====================================================================================================================
+double SecondsSince(
+    uint64 startTimestamp)
+{
+    return double(Platform::QueryTimestamp() - startTimestamp) / double(Platform::QueryTimestampFrequency());
+}
+
+// =====================================================================================================================
+void PrintResult(
+    const char* pName,
+    uint64      messageCount,
+    uint64      totalBytes,
+    double      seconds)
+{
+    const double mibPerSecond = double(totalBytes) / (1024.0 * 1024.0) / seconds;
+
+    if (messageCount > 0)
+    {
+        printf("%-28s %12.0f msg/s %10.1f MiB/s\n", pName, double(messageCount) / seconds, mibPerSecond);
+    }
+    else
+    {
+        printf("%-28s %18s %10.1f MiB/s\n", pName, "", mibPerSecond);
+    }
+}
+
+// =====================================================================================================================
+// Host side of the shared memory loopback: accepts one connection and drains messageCount messages from it.
+struct ShmHostContext
+{
+    ShmMsgListener* pListener;
+    uint32          messageCount;
+    Result          result;
+};
+
+// =====================================================================================================================
+void ShmHostThread(
+    void* pParameter)
+{
+    ShmHostContext* pContext    = static_cast<ShmHostContext*>(pParameter);
+    ShmConnection*  pConnection = nullptr;
+
+    pContext->result = pContext->pListener->Accept(Platform::GenericAllocCb, &pConnection, TimeoutInMs);
+
+    MessageBuffer message;
+
+    for (uint32 i = 0; (pContext->result == Result::Success) && (i < pContext->messageCount); ++i)
+    {
+        size_t bytesRead = 0;
+        pContext->result = pConnection->Read(&message, sizeof(message), &bytesRead, TimeoutInMs);
+    }
+
+    if (pConnection != nullptr)
+    {
+        DD_DELETE(pConnection, Platform::GenericAllocCb);
+    }
+}
+
+// =====================================================================================================================
+Result RunShmMessages(
+    const Options& options)
+{
+    ShmMsgListener listener;
+    Result         result = listener.Create(BenchPort);
+
+    if (result == Result::Success)
+    {
+        ShmHostContext   context = { &listener, options.messageCount, Result::Success };
+        Platform::Thread thread;
+
+        result = thread.Start(&ShmHostThread, &context);
+
+        const HostInfo  hostInfo = { TransportType::Local, BenchPort, nullptr };
+        ShmMsgTransport transport(hostInfo);
+
+        if (result == Result::Success)
+        {
+            result = transport.Connect(nullptr, TimeoutInMs);
+        }
+
+        MessageBuffer message = {};
+        message.header.payloadSize = kMaxPayloadSizeInBytes;
+
+        const uint64 start = Platform::QueryTimestamp();
+
+        for (uint32 i = 0; (result == Result::Success) && (i < options.messageCount); ++i)
+        {
+            message.header.sequence = i;
+            result = transport.WriteMessage(message);
+        }
+
+        if (thread.IsJoinable())
+        {
+            thread.Join(TimeoutInMs);
+        }
+
+        if ((result == Result::Success) && (context.result == Result::Success))
+        {
+            PrintResult("Shared memory messages",
+                        options.messageCount,
+                        uint64(options.messageCount) * sizeof(MessageBuffer),
+                        SecondsSince(start));
+        }
+        else if (result == Result::Success)
+        {
+            result = context.result;
+        }
+
+        transport.Disconnect();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+struct SocketReaderContext
+{
+    int    socket;
+    uint32 messageCount;
+    Result result;
+};
+
+// =====================================================================================================================
+void SocketReaderThread(
+    void* pParameter)
+{
+    SocketReaderContext* pContext = static_cast<SocketReaderContext*>(pParameter);
+
+    MessageBuffer message;
+
+    for (uint32 i = 0; (pContext->result == Result::Success) && (i < pContext->messageCount); ++i)
+    {
+        if (recv(pContext->socket, &message, sizeof(message), 0) <= 0)
+        {
+            pContext->result = Result::Error;
+        }
+    }
+}
+
+// =====================================================================================================================
+Result RunSocketMessages(
+    const Options& options)
+{
+    Result result = Result::Error;
+    int    sockets[2];
+
+    if (socketpair(AF_UNIX, SOCK_DGRAM, 0, sockets) == 0)
+    {
+        SocketReaderContext context = { sockets[1], options.messageCount, Result::Success };
+        Platform::Thread    thread;
+
+        result = thread.Start(&SocketReaderThread, &context);
+
+        MessageBuffer message = {};
+        message.header.payloadSize = kMaxPayloadSizeInBytes;
+
+        const uint64 start = Platform::QueryTimestamp();
+
+        for (uint32 i = 0; (result == Result::Success) && (i < options.messageCount); ++i)
+        {
+            message.header.sequence = i;
+            if (send(sockets[0], &message, sizeof(message), 0) != sizeof(message))
+            {
+                result = Result::Error;
+            }
+        }
+
+        if (thread.IsJoinable())
+        {
+            thread.Join(TimeoutInMs);
+        }
+
+        if ((result == Result::Success) && (context.result == Result::Success))
+        {
+            PrintResult("AF_UNIX socket messages",
+                        options.messageCount,
+                        uint64(options.messageCount) * sizeof(MessageBuffer),
+                        SecondsSince(start));
+        }
+        else if (result == Result::Success)
+        {
+            result = context.result;
+        }
+
+        close(sockets[0]);
+        close(sockets[1]);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Reads a bulk block the way a shared pull transfer does: map the server's object and copy straight out of it.
+Result RunSharedBulkRead(
+    const Options& options)
+{
+    const size_t bulkSize = size_t(options.bulkSizeInMb) * 1024 * 1024;
+
+    char name[kShmNameSize];
+    GetUniqueShmName("bench", name);
+
+    ShmRegion serverBlock;
+    Result    result = serverBlock.Create(name, bulkSize);
+
+    uint8* pDst = static_cast<uint8*>(malloc(bulkSize));
+
+    if ((result == Result::Success) && (pDst != nullptr))
+    {
+        memset(serverBlock.Data(), 0xA5, bulkSize);
+
+        // Fault in the destination so only the transfer itself is measured.
+        memset(pDst, 0, bulkSize);
+
+        const uint64 start = Platform::QueryTimestamp();
+
+        ShmRegion clientView;
+        result = clientView.Open(name, true);
+
+        if (result == Result::Success)
+        {
+            memcpy(pDst, clientView.Data(), bulkSize);
+            clientView.Close();
+
+            PrintResult("Shared bulk block read", 0, bulkSize, SecondsSince(start));
+        }
+    }
+    else if (result == Result::Success)
+    {
+        result = Result::InsufficientMemory;
+    }
+
+    serverBlock.Unlink();
+    free(pDst);
+
+    return result;
+}
+
+// =====================================================================================================================
+// Streams a bulk block as transfer data chunks over the shared memory transport, which is what a regular pull does.
+Result RunChunkedBulkRead(
+    const Options& options)
+{
+    const uint32 bulkSize   = options.bulkSizeInMb * 1024 * 1024;
+    const uint32 chunkCount =
+        uint32((bulkSize + TransferProtocol::kMaxTransferDataChunkSize - 1) / TransferProtocol::kMaxTransferDataChunkSize);
+
+    ShmMsgListener listener;
+    Result         result = listener.Create(BenchPort);
+
+    if (result == Result::Success)
+    {
+        ShmHostContext   context = { &listener, chunkCount, Result::Success };
+        Platform::Thread thread;
+
+        result = thread.Start(&ShmHostThread, &context);
+
+        const HostInfo  hostInfo = { TransportType::Local, BenchPort, nullptr };
+        ShmMsgTransport transport(hostInfo);
+
+        if (result == Result::Success)
+        {
+            result = transport.Connect(nullptr, TimeoutInMs);
+        }
+
+        MessageBuffer message = {};
+        message.header.payloadSize = kMaxPayloadSizeInBytes;
+
+        const uint64 start = Platform::QueryTimestamp();
+
+        for (uint32 i = 0; (result == Result::Success) && (i < chunkCount); ++i)
+        {
+            result = transport.WriteMessage(message);
+        }
+
+        if (thread.IsJoinable())
+        {
+            thread.Join(TimeoutInMs);
+        }
+
+        if ((result == Result::Success) && (context.result == Result::Success))
+        {
+            PrintResult("Chunked bulk block read", 0, bulkSize, SecondsSince(start));
+        }
+        else if (result == Result::Success)
+        {
+            result = context.result;
+        }
+
+        transport.Disconnect();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void PrintUsage()
+{
+    printf("Usage: ddShmTransportBench [--messages N] [--bulk-mb N]\n"
+           "  --messages N  Number of maximum size messages to stream per transport (default: 200000)\n"
+           "  --bulk-mb N   Size of the bulk block in MiB (default: 256)\n");
+}
+
+// =====================================================================================================================
+bool ParseOptions(
+    int      argc,
+    char**   argv,
+    Options* pOptions)
+{
+    bool success = true;
+
+    pOptions->messageCount = 200000;
+    pOptions->bulkSizeInMb = 256;
+
+    for (int i = 1; success && (i < argc); ++i)
+    {
+        if ((strcmp(argv[i], "--messages") == 0) && ((i + 1) < argc))
+        {
+            pOptions->messageCount = uint32(strtoul(argv[++i], nullptr, 0));
+        }
+        else if ((strcmp(argv[i], "--bulk-mb") == 0) && ((i + 1) < argc))
+        {
+            pOptions->bulkSizeInMb = uint32(strtoul(argv[++i], nullptr, 0));
+        }
+        else
+        {
+            success = false;
+        }
+    }
+
+    return success && (pOptions->messageCount > 0) && (pOptions->bulkSizeInMb > 0) && (pOptions->bulkSizeInMb < 4096);
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int    argc,
+    char** argv)
+{
+    Options options = {};
+    Result  result  = Result::InvalidParameter;
+
+    if (ParseOptions(argc, argv, &options))
+    {
+        result = RunShmMessages(options);
+
+        if (result == Result::Success)
+        {
+            result = RunSocketMessages(options);
+        }
+
+        if (result == Result::Success)
+        {
+            result = RunChunkedBulkRead(options);
+        }
+
+        if (result == Result::Success)
+        {
+            result = RunSharedBulkRead(options);
+        }
+
+        if (result != Result::Success)
+        {
+            fprintf(stderr, "Benchmark failed: %s\n", ResultToString(result));
+        }
+    }
+    else
+    {
+        PrintUsage();
+    }
+
+    return (result == Result::Success) ? 0 : 1;
+}
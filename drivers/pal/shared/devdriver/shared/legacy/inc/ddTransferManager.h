@@ -37,6 +37,7 @@ namespace DevDriver
 {
     class IMsgChannel;
     class SessionManager;
+    class ShmRegion;
 
     namespace TransferProtocol
     {
@@ -81,15 +82,19 @@ namespace DevDriver
         class ServerBlock final : public TransferBlock
         {
             friend class TransferServer;
+            friend class TransferManager;
         public:
             explicit ServerBlock(const AllocCb& allocCb, BlockId blockId)
                 : TransferBlock(blockId)
+                , m_allocCb(allocCb)
                 , m_isClosed(false)
                 , m_chunks(allocCb)
+                , m_pSharedStorage(nullptr)
                 , m_numPendingTransfers(0)
                 , m_transfersCompletedEvent(true)
                 , m_crc32(0)
                 {}
+            ~ServerBlock();
 
             // Writes numBytes bytes from pSrcBuffer into the block.
             void Write(const void* pSrcBuffer, size_t numBytes);
@@ -105,9 +110,11 @@ namespace DevDriver
 
             // Returns a const pointer to the underlying data contained within the block, or null if it contains
             // no data.
-            const uint8* GetBlockData() const {
-                return (m_blockDataSize > 0) ? reinterpret_cast<const uint8*>(m_chunks.Data()) : nullptr;
-            }
+            const uint8* GetBlockData() const;
+
+            // Returns the name of the shared memory object holding the block data, or null if the block isn't
+            // stored in shared memory.
+            const char* GetSharedName() const;
 
             // Returns a boolean indicating whether the block has any transfers in progress.
             bool HasPendingTransfers();
@@ -131,8 +138,17 @@ namespace DevDriver
             // Notifies the block that an existing transfer has ended.
             void EndTransfer();
 
+            // Moves the block data into a shared memory object that local clients can map directly.
+            void InitSharedStorage();
+
+            // Grows the shared memory object to hold at least the given number of bytes. Moves the block data back to
+            // regular chunks if that fails.
+            void ReserveSharedStorage(size_t bytes);
+
+            AllocCb               m_allocCb;                 // Allocator used for the shared storage
             bool                  m_isClosed;                // A bool that indicates if the block is closed
             Vector<TransferChunk> m_chunks;                  // A list of transfer chunks used to store data
+            ShmRegion*            m_pSharedStorage;          // Replaces m_chunks when the block is shared with local clients
             Platform::Mutex       m_pendingTransfersMutex;   // A mutex used to control access to the pending transfers counter
             uint32                m_numPendingTransfers;     // A counter used to track the number of pending transfers
             Platform::Event       m_transfersCompletedEvent; // An event that is signaled when all pendings transfers are completed
@@ -229,6 +245,7 @@ namespace DevDriver
             AllocCb          m_allocCb;
             Platform::Random m_rng;
             Platform::Mutex  m_mutex;
+            bool             m_useSharedBlocks; // Store server blocks in shared memory for local clients
 
             // A list of all the server blocks that are currently available to the TransferManager.
             HashMap<BlockId, SharedPointer<ServerBlock>, 16> m_registeredServerBlocks;
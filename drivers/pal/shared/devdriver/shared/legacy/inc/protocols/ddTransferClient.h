@@ -31,6 +31,7 @@
 namespace DevDriver
 {
     class IMsgChannel;
+    class ShmRegion;
 
     namespace TransferProtocol
     {
@@ -75,6 +76,18 @@ namespace DevDriver
         private:
             void ResetState() override;
 
+            // Maps the shared memory block described by a shared data header and starts reading from it.
+            Result BeginSharedPullTransfer(const TransferSharedDataHeader& header);
+
+            // Copies data out of the mapped shared memory block.
+            Result ReadSharedPullTransferData(uint8* pDstBuffer, size_t bufferSize, size_t* pBytesRead);
+
+            // Tells the server we're done with the shared memory block and unmaps it.
+            Result EndSharedPullTransfer(Result status);
+
+            // Unmaps the shared memory block if there is one.
+            void CloseSharedBlock();
+
             // Helper method to send a payload, handling backwards compatibility and retrying.
             Result SendTransferPayload(const SizedPayloadContainer& container,
                                        uint32                       timeoutInMs = kDefaultCommunicationTimeoutInMs,
@@ -108,6 +121,7 @@ namespace DevDriver
             };
 
             ClientTransferContext m_transferContext;
+            ShmRegion*            m_pSharedBlock; // Block mapped by a shared pull transfer
 
             DD_STATIC_CONST uint32 kTransferChunkTimeoutInMs = 3000;
         };
@@ -34,7 +34,7 @@
 ***********************************************************************************************************************
 */
 
-#define TRANSFER_PROTOCOL_VERSION 2
+#define TRANSFER_PROTOCOL_VERSION 3
 
 #define TRANSFER_PROTOCOL_MINIMUM_VERSION 1
 
@@ -42,11 +42,13 @@
 ***********************************************************************************************************************
 *| Version | Change Description                                                                                       |
 *| ------- | ---------------------------------------------------------------------------------------------------------|
+*|  3.0    | Shared memory pull transfers for clients connected through the shared memory transport             |
 *|  2.0    | Refactor for variably sized messages + push transfers                                                    |
 *|  1.0    | Initial version                                                                                          |
 ***********************************************************************************************************************
 */
 
+#define TRANSFER_SHARED_MEMORY_VERSION 3
 #define TRANSFER_REFACTOR_VERSION 2
 #define TRANSFER_INITIAL_VERSION 1
 
@@ -64,6 +66,7 @@ namespace DevDriver
             TransferDataChunk,
             TransferDataSentinel,
             TransferStatus,
+            TransferSharedDataHeader,
             Count,
         };
 
@@ -71,6 +74,7 @@ namespace DevDriver
         {
             Pull = 0,
             Push,
+            PullShared,
             Count,
         };
 
@@ -164,6 +168,27 @@ namespace DevDriver
 
         DD_CHECK_SIZE(TransferDataChunk, kMaxPayloadSizeInBytes);
 
+        // Maximum length of the name of a shared memory block, including the null terminator.
+        DD_STATIC_CONST size_t kMaxSharedBlockNameSize = 64;
+
+        // Sent instead of TransferDataHeaderV2 in response to a PullShared request. The block data can be read directly
+        // from the named shared memory object, the client sends a TransferStatus once it's done with it.
+        DD_NETWORK_STRUCT(TransferSharedDataHeader, 4)
+        {
+            TransferMessage command;
+            uint32          sizeInBytes;
+            char            name[kMaxSharedBlockNameSize];
+
+            TransferSharedDataHeader(uint32 size, const char* pName)
+                : command(TransferMessage::TransferSharedDataHeader)
+                , sizeInBytes(size)
+            {
+                Platform::Strncpy(name, pName);
+            }
+        };
+
+        DD_CHECK_SIZE(TransferSharedDataHeader, 72);
+
         DD_NETWORK_STRUCT(TransferDataSentinel, 4)
         {
             TransferMessage command;
@@ -27,10 +27,20 @@
 #include "protocols/ddTransferServer.h"
 #include "messageChannel.h"
 
+#if DD_SUPPORT_SHM_TRANSPORT
+#include "shmMsgTransport.h"
+
+static_assert(DevDriver::kShmNameSize <= DevDriver::TransferProtocol::kMaxSharedBlockNameSize,
+              "Shared block names must fit in TransferSharedDataHeader");
+#endif
+
 namespace DevDriver
 {
     namespace TransferProtocol
     {
+        // Initial size of the shared memory object backing a server block.
+        DD_STATIC_CONST size_t kMinSharedBlockSizeInBytes = (64 * 1024);
+
         // ============================================================================================================
         TransferManager::TransferManager(const AllocCb& allocCb)
             : m_pMessageChannel(nullptr)
@@ -39,6 +49,7 @@ namespace DevDriver
             , m_allocCb(allocCb)
             , m_rng()
             , m_mutex()
+            , m_useSharedBlocks(false)
             , m_registeredServerBlocks(allocCb)
             , m_idleBlocks(allocCb)
         {}
@@ -58,6 +69,11 @@ namespace DevDriver
             m_pMessageChannel = pMsgChannel;
             m_pSessionManager = pSessionManager;
 
+#if DD_SUPPORT_SHM_TRANSPORT
+            // Clients connected through shared memory are on this machine, so they can map server blocks directly.
+            m_useSharedBlocks = (strcmp(m_pMessageChannel->GetTransportName(), kShmTransportName) == 0);
+#endif
+
             m_pTransferServer = DD_NEW(TransferServer, m_allocCb)(m_pMessageChannel, this);
             if (m_pTransferServer != nullptr)
             {
@@ -95,6 +111,11 @@ namespace DevDriver
                                                                                    newBlockId);
             if (!pBlock.IsNull())
             {
+                if (m_useSharedBlocks)
+                {
+                    pBlock->InitSharedStorage();
+                }
+
                 m_registeredServerBlocks.Create(newBlockId, pBlock);
             }
 
@@ -213,6 +234,108 @@ namespace DevDriver
             *ppBlock = nullptr;
         }
 
+        // ============================================================================================================
+        ServerBlock::~ServerBlock()
+        {
+#if DD_SUPPORT_SHM_TRANSPORT
+            if (m_pSharedStorage != nullptr)
+            {
+                DD_DELETE(m_pSharedStorage, m_allocCb);
+            }
+#endif
+        }
+
+        // ============================================================================================================
+        void ServerBlock::InitSharedStorage()
+        {
+#if DD_SUPPORT_SHM_TRANSPORT
+            DD_ASSERT((m_pSharedStorage == nullptr) && (m_blockDataSize == 0));
+
+            ShmRegion* pRegion = DD_NEW(ShmRegion, m_allocCb)();
+            if (pRegion != nullptr)
+            {
+                char name[kShmNameSize];
+                GetUniqueShmName("block", name);
+
+                // Pages of a shared memory object are only allocated once they're touched, so start reasonably big.
+                if (pRegion->Create(name, kMinSharedBlockSizeInBytes) == Result::Success)
+                {
+                    m_pSharedStorage = pRegion;
+                }
+                else
+                {
+                    // Keep using regular chunks.
+                    DD_DELETE(pRegion, m_allocCb);
+                }
+            }
+#endif
+        }
+
+        // ============================================================================================================
+        void ServerBlock::ReserveSharedStorage(size_t bytes)
+        {
+#if DD_SUPPORT_SHM_TRANSPORT
+            DD_ASSERT(m_pSharedStorage != nullptr);
+
+            if (m_pSharedStorage->Size() < bytes)
+            {
+                size_t newSize = m_pSharedStorage->Size();
+                while (newSize < bytes)
+                {
+                    newSize *= 2;
+                }
+
+                if (m_pSharedStorage->Resize(newSize) != Result::Success)
+                {
+                    m_chunks.Resize(Platform::Pow2Align(bytes, kTransferChunkSizeInBytes) / kTransferChunkSizeInBytes);
+                    memcpy(m_chunks.Data(), m_pSharedStorage->Data(), m_blockDataSize);
+
+                    DD_DELETE(m_pSharedStorage, m_allocCb);
+                    m_pSharedStorage = nullptr;
+                }
+            }
+#else
+            DD_UNUSED(bytes);
+#endif
+        }
+
+        // ============================================================================================================
+        const uint8* ServerBlock::GetBlockData() const
+        {
+            const uint8* pData = nullptr;
+
+            if (m_blockDataSize > 0)
+            {
+#if DD_SUPPORT_SHM_TRANSPORT
+                if (m_pSharedStorage != nullptr)
+                {
+                    pData = static_cast<const uint8*>(m_pSharedStorage->Data());
+                }
+                else
+#endif
+                {
+                    pData = reinterpret_cast<const uint8*>(m_chunks.Data());
+                }
+            }
+
+            return pData;
+        }
+
+        // ============================================================================================================
+        const char* ServerBlock::GetSharedName() const
+        {
+            const char* pName = nullptr;
+
+#if DD_SUPPORT_SHM_TRANSPORT
+            if (m_pSharedStorage != nullptr)
+            {
+                pName = m_pSharedStorage->Name();
+            }
+#endif
+
+            return pName;
+        }
+
         // ============================================================================================================
         void ServerBlock::Write(const void* pSrcBuffer, size_t numBytes)
         {
@@ -221,21 +344,39 @@ namespace DevDriver
 
             if (numBytes > 0)
             {
-                // Calculate how many bytes we have available.
-                const size_t blockCapacityInBytes = (m_chunks.Size() * kTransferChunkSizeInBytes);
-                const size_t bytesAvailable = (blockCapacityInBytes - m_blockDataSize);
+                uint8* pBlockData = nullptr;
+
+#if DD_SUPPORT_SHM_TRANSPORT
+                if (m_pSharedStorage != nullptr)
+                {
+                    ReserveSharedStorage(m_blockDataSize + numBytes);
+                }
 
-                // Allocate more chunks if necessary.
-                if (bytesAvailable < numBytes)
+                if (m_pSharedStorage != nullptr)
+                {
+                    pBlockData = static_cast<uint8*>(m_pSharedStorage->Data());
+                }
+                else
+#endif
                 {
-                    const size_t additionalBytesRequired = (numBytes - bytesAvailable);
-                    const size_t numChunksRequired =
-                        (Platform::Pow2Align(additionalBytesRequired, kTransferChunkSizeInBytes) / kTransferChunkSizeInBytes);
-                    m_chunks.Resize(m_chunks.Size() + numChunksRequired);
+                    // Calculate how many bytes we have available.
+                    const size_t blockCapacityInBytes = (m_chunks.Size() * kTransferChunkSizeInBytes);
+                    const size_t bytesAvailable = (blockCapacityInBytes - m_blockDataSize);
+
+                    // Allocate more chunks if necessary.
+                    if (bytesAvailable < numBytes)
+                    {
+                        const size_t additionalBytesRequired = (numBytes - bytesAvailable);
+                        const size_t numChunksRequired =
+                            (Platform::Pow2Align(additionalBytesRequired, kTransferChunkSizeInBytes) / kTransferChunkSizeInBytes);
+                        m_chunks.Resize(m_chunks.Size() + numChunksRequired);
+                    }
+
+                    pBlockData = reinterpret_cast<uint8*>(m_chunks.Data());
                 }
 
                 // Copy the new data into the block
-                uint8* pData = (reinterpret_cast<uint8*>(m_chunks.Data()) + m_blockDataSize);
+                uint8* pData = (pBlockData + m_blockDataSize);
                 memcpy(pData, pSrcBuffer, numBytes);
                 m_crc32 = CRC32(pData, numBytes, m_crc32);
                 m_blockDataSize += numBytes;
@@ -263,7 +404,14 @@ namespace DevDriver
         {
             if (!m_isClosed)
             {
-                m_chunks.Reserve(Platform::Pow2Align(bytes, kTransferChunkSizeInBytes) / kTransferChunkSizeInBytes);
+                if (m_pSharedStorage != nullptr)
+                {
+                    ReserveSharedStorage(bytes);
+                }
+                else
+                {
+                    m_chunks.Reserve(Platform::Pow2Align(bytes, kTransferChunkSizeInBytes) / kTransferChunkSizeInBytes);
+                }
             }
         }
 
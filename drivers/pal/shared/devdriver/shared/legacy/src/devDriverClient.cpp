@@ -27,6 +27,9 @@
 #include "messageChannel.h"
 #include "protocolClient.h"
 #include "socketMsgTransport.h"
+#if DD_SUPPORT_SHM_TRANSPORT
+#include "shmMsgTransport.h"
+#endif
 #include "protocols/driverControlClient.h"
 #include "protocols/rgpClient.h"
 #include "protocols/etwClient.h"
@@ -53,10 +56,24 @@ namespace DevDriver
         if ((m_createInfo.connectionInfo.type == TransportType::Remote) |
             (m_createInfo.connectionInfo.type == TransportType::Local))
         {
-            using MsgChannelSocket = MessageChannel<SocketMsgTransport>;
-            m_pMsgChannel = DD_NEW(MsgChannelSocket, m_allocCb)(m_allocCb,
-                                                                m_createInfo,
-                                                                m_createInfo.connectionInfo);
+#if DD_SUPPORT_SHM_TRANSPORT
+            // Local hosts that offer shared memory get it, everything else goes through sockets.
+            if ((m_createInfo.connectionInfo.type == TransportType::Local) &&
+                (ShmMsgTransport::TestConnection(m_createInfo.connectionInfo, kShmProbeTimeoutInMs) == Result::Success))
+            {
+                using MsgChannelShm = MessageChannel<ShmMsgTransport>;
+                m_pMsgChannel = DD_NEW(MsgChannelShm, m_allocCb)(m_allocCb,
+                                                                 m_createInfo,
+                                                                 m_createInfo.connectionInfo);
+            }
+#endif
+            if (m_pMsgChannel == nullptr)
+            {
+                using MsgChannelSocket = MessageChannel<SocketMsgTransport>;
+                m_pMsgChannel = DD_NEW(MsgChannelSocket, m_allocCb)(m_allocCb,
+                                                                    m_createInfo,
+                                                                    m_createInfo.connectionInfo);
+            }
         }
         else
         {
@@ -35,6 +35,9 @@
 #include "protocols/typemap.h"
 
     #include "socketMsgTransport.h"
+#if DD_SUPPORT_SHM_TRANSPORT
+    #include "shmMsgTransport.h"
+#endif
 
 namespace DevDriver
 {
@@ -58,10 +61,23 @@ namespace DevDriver
 
         if (m_createInfo.connectionInfo.type == TransportType::Local)
         {
-            using MsgChannelSocket = MessageChannel<SocketMsgTransport>;
-            m_pMsgChannel = DD_NEW(MsgChannelSocket, m_allocCb)(m_allocCb,
-                                                                m_createInfo,
-                                                                m_createInfo.connectionInfo);
+#if DD_SUPPORT_SHM_TRANSPORT
+            // Use shared memory if the host offers it, otherwise fall back to the AF_UNIX socket.
+            if (ShmMsgTransport::TestConnection(m_createInfo.connectionInfo, kShmProbeTimeoutInMs) == Result::Success)
+            {
+                using MsgChannelShm = MessageChannel<ShmMsgTransport>;
+                m_pMsgChannel = DD_NEW(MsgChannelShm, m_allocCb)(m_allocCb,
+                                                                 m_createInfo,
+                                                                 m_createInfo.connectionInfo);
+            }
+#endif
+            if (m_pMsgChannel == nullptr)
+            {
+                using MsgChannelSocket = MessageChannel<SocketMsgTransport>;
+                m_pMsgChannel = DD_NEW(MsgChannelSocket, m_allocCb)(m_allocCb,
+                                                                    m_createInfo,
+                                                                    m_createInfo.connectionInfo);
+            }
         }
         else
         {
@@ -281,8 +297,15 @@ namespace DevDriver
         switch (hostInfo.type)
         {
             case TransportType::Local:
-                // On non windows platforms we try to use an AF_UNIX socket for communication
-                result = SocketMsgTransport::TestConnection(hostInfo, timeout);
+#if DD_SUPPORT_SHM_TRANSPORT
+                // Shared memory is preferred where the host offers it
+                result = ShmMsgTransport::TestConnection(hostInfo, Platform::Min(timeout, kShmProbeTimeoutInMs));
+                if (result != Result::Success)
+#endif
+                {
+                    // On non windows platforms we try to use an AF_UNIX socket for communication
+                    result = SocketMsgTransport::TestConnection(hostInfo, timeout);
+                }
                 break;
             default:
                 // Invalid value passed to the function
@@ -31,6 +31,10 @@
 #include "socketMsgTransport.h"
 #endif
 
+#if DD_SUPPORT_SHM_TRANSPORT
+#include "shmMsgTransport.h"
+#endif
+
 namespace DevDriver
 {
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -64,11 +68,25 @@ namespace DevDriver
             if ((createInfo.hostInfo.type == TransportType::Remote) |
                 (createInfo.hostInfo.type == TransportType::Local))
             {
+#if DD_SUPPORT_SHM_TRANSPORT
+                // Prefer shared memory for local hosts that offer it, sockets remain the fallback.
+                if ((createInfo.hostInfo.type == TransportType::Local) &&
+                    (ShmMsgTransport::TestConnection(createInfo.hostInfo, kShmProbeTimeoutInMs) == Result::Success))
+                {
+                    using MsgChannelShm = MessageChannel<ShmMsgTransport>;
+                    pMsgChannel = DD_NEW(MsgChannelShm, createInfo.allocCb)(createInfo.allocCb,
+                        createInfo.channelInfo,
+                        createInfo.hostInfo);
+                }
+#endif
 #if DD_SUPPORT_SOCKET_TRANSPORT
-                using MsgChannelSocket = MessageChannel<SocketMsgTransport>;
-                pMsgChannel = DD_NEW(MsgChannelSocket, createInfo.allocCb)(createInfo.allocCb,
-                    createInfo.channelInfo,
-                    createInfo.hostInfo);
+                if (pMsgChannel == nullptr)
+                {
+                    using MsgChannelSocket = MessageChannel<SocketMsgTransport>;
+                    pMsgChannel = DD_NEW(MsgChannelSocket, createInfo.allocCb)(createInfo.allocCb,
+                        createInfo.channelInfo,
+                        createInfo.hostInfo);
+                }
 #endif
             }
 #endif
@@ -0,0 +1,1008 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "shmMsgTransport.h"
+#include "protocols/systemProtocols.h"
+#include "ddPlatform.h"
+
+#include <atomic>
+#include <new>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace DevDriver::ClientManagementProtocol;
+
+namespace DevDriver
+{
+    // Identify listener and connection objects and the layout they were created with.
+    DD_STATIC_CONST uint32 kShmListenerMagic   = 0x4c4d4853; // 'SHML'
+    DD_STATIC_CONST uint32 kShmConnectionMagic = 0x434d4853; // 'SHMC'
+    DD_STATIC_CONST uint32 kShmLayoutVersion   = 1;
+
+    // Size of the ring in each direction. Must be a power of two.
+    DD_STATIC_CONST uint64 kShmRingSize = (1 << 20);
+
+    // Number of connection requests that can be pending on a listener at once.
+    DD_STATIC_CONST uint32 kShmListenerSlots = 16;
+
+    // Sleeps are cut into slices of this length so that a peer which died without closing its end is noticed.
+    DD_STATIC_CONST uint32 kShmPollIntervalInMs = 100;
+
+    // Number of times a reader or writer polls the ring before going to sleep.
+    DD_STATIC_CONST uint32 kShmSpinCount = 256;
+
+    // Ring records are a header followed by the message, padded to this alignment.
+    DD_STATIC_CONST uint64 kShmRecordAlignment = 8;
+
+    // Record size used to skip the unused space at the end of the ring when the next record doesn't fit there.
+    DD_STATIC_CONST uint32 kShmWrapMarker = 0xFFFFFFFF;
+
+    enum class ShmConnectionState : uint32
+    {
+        Connecting = 0,
+        Open,
+        Closed,
+    };
+
+    enum class ShmSlotState : uint32
+    {
+        Free = 0, // Available to clients
+        Claimed,  // A client is filling it in
+        Posted,   // Waiting for the host
+        Accepted, // The host opened the connection, the client must free the slot
+        Rejected, // The host could not open the connection, the client must free the slot
+    };
+
+    struct ShmRecordHeader
+    {
+        uint32 sizeInBytes;
+        uint32 reserved;
+    };
+
+    // Control block of a single-producer single-consumer ring. The producer and consumer halves live on separate
+    // cache lines. The sequence counters are also used as futex words.
+    struct ShmRingHeader
+    {
+        alignas(64) std::atomic<uint64> writePos;      // Total bytes written, only advanced by the producer
+        std::atomic<uint32>             writeSeq;      // Bumped after every write
+        std::atomic<uint32>             readerWaiting; // Set while the consumer sleeps on writeSeq
+        alignas(64) std::atomic<uint64> readPos;       // Total bytes consumed, only advanced by the consumer
+        std::atomic<uint32>             readSeq;       // Bumped after every read
+        std::atomic<uint32>             writerWaiting; // Set while the producer sleeps on readSeq
+    };
+
+    struct ShmConnectionHeader
+    {
+        uint32              magic;
+        uint32              version;
+        uint32              clientPid;
+        uint32              hostPid;
+        std::atomic<uint32> state;    // ShmConnectionState
+        ShmRingHeader       rings[2]; // [0]: client to host, [1]: host to client
+    };
+
+    struct ShmListenerSlot
+    {
+        std::atomic<uint32> state;    // ShmSlotState
+        uint32              clientPid;
+        char                name[kShmNameSize];
+    };
+
+    struct ShmListenerHeader
+    {
+        uint32              magic;
+        uint32              version;
+        uint32              hostPid;
+        std::atomic<uint32> postSeq;     // Bumped whenever a client posts a slot
+        std::atomic<uint32> hostWaiting; // Set while the host sleeps on postSeq
+        ShmListenerSlot     slots[kShmListenerSlots];
+    };
+
+    static_assert(std::atomic<uint32>::is_always_lock_free && std::atomic<uint64>::is_always_lock_free,
+                  "Shared memory rings require address-free atomics");
+
+    // The ring data follows the connection header.
+    DD_STATIC_CONST size_t kShmRingDataOffset = Platform::Pow2Align<size_t>(sizeof(ShmConnectionHeader), 64);
+    DD_STATIC_CONST size_t kShmConnectionSize = kShmRingDataOffset + (2 * kShmRingSize);
+
+    // Largest message that fits in a ring.
+    DD_STATIC_CONST size_t kShmMaxRecordSize = (kShmRingSize / 4);
+
+    // ================================================================================================================
+    static void FutexWait(std::atomic<uint32>* pWord, uint32 expected, uint32 timeoutInMs)
+    {
+        const timespec timeout = { static_cast<time_t>(timeoutInMs / 1000), static_cast<long>(timeoutInMs % 1000) * 1000000 };
+
+        // The objects are shared between processes, so this can't use the private futex operations.
+        syscall(SYS_futex, reinterpret_cast<uint32*>(pWord), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+    }
+
+    // ================================================================================================================
+    static void FutexWakeAll(std::atomic<uint32>* pWord)
+    {
+        syscall(SYS_futex, reinterpret_cast<uint32*>(pWord), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    // ================================================================================================================
+    static bool IsProcessAlive(uint32 pid)
+    {
+        return (pid != 0) && ((kill(static_cast<pid_t>(pid), 0) == 0) || (errno == EPERM));
+    }
+
+    // ================================================================================================================
+    // Returns how long to sleep before the deadline passes, in slices of at most kShmPollIntervalInMs.
+    static uint32 GetSleepTime(uint64 deadline)
+    {
+        const uint64 now = Platform::GetCurrentTimeInMs();
+        return (now < deadline) ? static_cast<uint32>(Platform::Min<uint64>(deadline - now, kShmPollIntervalInMs)) : 0;
+    }
+
+    // ================================================================================================================
+    // Copies one record into the ring if there is space for it. Never blocks.
+    static bool TryRingWrite(ShmRingHeader* pRing, uint8* pRingData, const void* pSrc, size_t sizeInBytes)
+    {
+        const uint64 recordSize = Platform::Pow2Align<uint64>(sizeof(ShmRecordHeader) + sizeInBytes, kShmRecordAlignment);
+        const uint64 writePos   = pRing->writePos.load(std::memory_order_relaxed);
+        const uint64 tailSpace  = kShmRingSize - (writePos & (kShmRingSize - 1));
+        const uint64 padding    = (tailSpace < recordSize) ? tailSpace : 0;
+        const uint64 freeSpace  = kShmRingSize - (writePos - pRing->readPos.load(std::memory_order_acquire));
+
+        bool written = false;
+
+        if (freeSpace >= (padding + recordSize))
+        {
+            uint64 pos = writePos;
+
+            if (padding > 0)
+            {
+                // Records never wrap, so skip the rest of the ring. Records are aligned so a header always fits.
+                reinterpret_cast<ShmRecordHeader*>(pRingData + (pos & (kShmRingSize - 1)))->sizeInBytes = kShmWrapMarker;
+                pos += padding;
+            }
+
+            ShmRecordHeader* pHeader = reinterpret_cast<ShmRecordHeader*>(pRingData + (pos & (kShmRingSize - 1)));
+            pHeader->sizeInBytes = static_cast<uint32>(sizeInBytes);
+            memcpy(pHeader + 1, pSrc, sizeInBytes);
+
+            pRing->writePos.store(pos + recordSize);
+            pRing->writeSeq.fetch_add(1);
+
+            // The waiting flag is checked after publishing so that either we see it, or the reader sees our data.
+            if (pRing->readerWaiting.load() != 0)
+            {
+                FutexWakeAll(&pRing->writeSeq);
+            }
+
+            written = true;
+        }
+
+        return written;
+    }
+
+    // ================================================================================================================
+    // Copies the next record out of the ring. Returns NotReady if it is empty. Never blocks.
+    static Result TryRingRead(
+        ShmRingHeader* pRing,
+        const uint8*   pRingData,
+        void*          pDst,
+        size_t         bufferSize,
+        size_t*        pBytesRead)
+    {
+        Result       result   = Result::NotReady;
+        uint64       readPos  = pRing->readPos.load(std::memory_order_relaxed);
+        const uint64 writePos = pRing->writePos.load(std::memory_order_acquire);
+
+        while ((result == Result::NotReady) && (readPos != writePos))
+        {
+            const uint64 offset = (readPos & (kShmRingSize - 1));
+            const auto*  pHeader = reinterpret_cast<const ShmRecordHeader*>(pRingData + offset);
+            const uint32 sizeInBytes = pHeader->sizeInBytes;
+
+            if (sizeInBytes == kShmWrapMarker)
+            {
+                readPos += (kShmRingSize - offset);
+            }
+            else if ((sizeInBytes > kShmMaxRecordSize) || (sizeInBytes > bufferSize))
+            {
+                // Either the peer wrote garbage or the message is too big for the caller. Neither is recoverable.
+                DD_WARN_REASON("Invalid shared memory ring record");
+                result = Result::Error;
+            }
+            else
+            {
+                memcpy(pDst, pHeader + 1, sizeInBytes);
+                *pBytesRead = sizeInBytes;
+
+                readPos += Platform::Pow2Align<uint64>(sizeof(ShmRecordHeader) + sizeInBytes, kShmRecordAlignment);
+                result   = Result::Success;
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            pRing->readPos.store(readPos);
+            pRing->readSeq.fetch_add(1);
+
+            if (pRing->writerWaiting.load() != 0)
+            {
+                FutexWakeAll(&pRing->readSeq);
+            }
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    void GetShmListenerName(uint16 port, char (&name)[kShmNameSize])
+    {
+        Platform::Snprintf(name, "/AMD-Developer-Service.%u", static_cast<uint32>(port));
+    }
+
+    // ================================================================================================================
+    void GetUniqueShmName(const char* pKind, char (&name)[kShmNameSize])
+    {
+        static std::atomic<uint32> s_nextId(0);
+
+        Platform::Snprintf(name,
+                           "/AMD-Developer-Service.%s.%u.%u",
+                           pKind,
+                           static_cast<uint32>(getpid()),
+                           s_nextId.fetch_add(1));
+    }
+
+    // ================================================================================================================
+    ShmRegion::ShmRegion()
+        : m_fd(-1)
+        , m_pData(nullptr)
+        , m_size(0)
+        , m_isOwner(false)
+        , m_isLinked(false)
+    {
+        m_name[0] = '\0';
+    }
+
+    // ================================================================================================================
+    ShmRegion::~ShmRegion()
+    {
+        Close();
+    }
+
+    // ================================================================================================================
+    Result ShmRegion::Create(const char* pName, size_t sizeInBytes)
+    {
+        DD_ASSERT(IsOpen() == false);
+
+        Result result = Result::Success;
+
+        m_fd = shm_open(pName, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+
+        if (m_fd < 0)
+        {
+            result = (errno == EEXIST) ? Result::EntryExists : Result::Error;
+        }
+        else
+        {
+            Platform::Strncpy(m_name, pName);
+            m_isOwner  = true;
+            m_isLinked = true;
+
+            if (ftruncate(m_fd, static_cast<off_t>(sizeInBytes)) == 0)
+            {
+                void* pData = mmap(nullptr, sizeInBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+
+                if (pData != MAP_FAILED)
+                {
+                    m_pData = pData;
+                    m_size  = sizeInBytes;
+                }
+                else
+                {
+                    result = Result::InsufficientMemory;
+                }
+            }
+            else
+            {
+                result = Result::InsufficientMemory;
+            }
+
+            if (result != Result::Success)
+            {
+                Unlink();
+                Close();
+            }
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    Result ShmRegion::Open(const char* pName, bool readOnly)
+    {
+        DD_ASSERT(IsOpen() == false);
+
+        Result result = Result::Unavailable;
+
+        m_fd = shm_open(pName, readOnly ? O_RDONLY : O_RDWR, 0);
+
+        if (m_fd >= 0)
+        {
+            struct stat info = {};
+
+            if ((fstat(m_fd, &info) == 0) && (info.st_size > 0))
+            {
+                // Read only mappings are used for bulk reads of whole blocks, so fault them in up front.
+                const size_t sizeInBytes = static_cast<size_t>(info.st_size);
+                void*        pData       = mmap(nullptr,
+                                                sizeInBytes,
+                                                readOnly ? PROT_READ : (PROT_READ | PROT_WRITE),
+                                                readOnly ? (MAP_SHARED | MAP_POPULATE) : MAP_SHARED,
+                                                m_fd,
+                                                0);
+
+                if (pData != MAP_FAILED)
+                {
+                    Platform::Strncpy(m_name, pName);
+                    m_pData    = pData;
+                    m_size     = sizeInBytes;
+                    m_isLinked = true;
+                    result     = Result::Success;
+                }
+            }
+
+            if (result != Result::Success)
+            {
+                Close();
+            }
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    Result ShmRegion::Resize(size_t sizeInBytes)
+    {
+        DD_ASSERT(m_isOwner && IsOpen());
+
+        Result result = Result::InsufficientMemory;
+
+        if (ftruncate(m_fd, static_cast<off_t>(sizeInBytes)) == 0)
+        {
+            void* pData = mremap(m_pData, m_size, sizeInBytes, MREMAP_MAYMOVE);
+
+            if (pData != MAP_FAILED)
+            {
+                m_pData = pData;
+                m_size  = sizeInBytes;
+                result  = Result::Success;
+            }
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    void ShmRegion::Unlink()
+    {
+        if (m_isLinked)
+        {
+            shm_unlink(m_name);
+            m_isLinked = false;
+        }
+    }
+
+    // ================================================================================================================
+    void ShmRegion::Close()
+    {
+        if (m_pData != nullptr)
+        {
+            munmap(m_pData, m_size);
+            m_pData = nullptr;
+            m_size  = 0;
+        }
+
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+            m_fd = -1;
+        }
+
+        m_isOwner  = false;
+        m_isLinked = false;
+    }
+
+    // ================================================================================================================
+    ShmConnection::ShmConnection(bool isHost)
+        : m_pHeader(nullptr)
+        , m_isHost(isHost)
+    {
+    }
+
+    // ================================================================================================================
+    ShmConnection::~ShmConnection()
+    {
+        Close();
+    }
+
+    // ================================================================================================================
+    Result ShmConnection::Create(const char* pName)
+    {
+        DD_ASSERT(m_isHost == false);
+
+        Result result = m_region.Create(pName, kShmConnectionSize);
+
+        if (result == Result::Success)
+        {
+            m_pHeader = new(m_region.Data()) ShmConnectionHeader();
+
+            m_pHeader->magic     = kShmConnectionMagic;
+            m_pHeader->version   = kShmLayoutVersion;
+            m_pHeader->clientPid = static_cast<uint32>(getpid());
+            m_pHeader->state.store(static_cast<uint32>(ShmConnectionState::Connecting));
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    Result ShmConnection::Accept(const char* pName)
+    {
+        DD_ASSERT(m_isHost);
+
+        Result result = m_region.Open(pName, false);
+
+        if (result == Result::Success)
+        {
+            // The client is done with the name once we've mapped the object.
+            m_region.Unlink();
+
+            auto*const pHeader = static_cast<ShmConnectionHeader*>(m_region.Data());
+
+            if ((m_region.Size() >= kShmConnectionSize)      &&
+                (pHeader->magic == kShmConnectionMagic)      &&
+                (pHeader->version == kShmLayoutVersion)      &&
+                IsProcessAlive(pHeader->clientPid))
+            {
+                m_pHeader          = pHeader;
+                m_pHeader->hostPid = static_cast<uint32>(getpid());
+                m_pHeader->state.store(static_cast<uint32>(ShmConnectionState::Open));
+            }
+            else
+            {
+                result = Result::VersionMismatch;
+                m_region.Close();
+            }
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    void ShmConnection::Close()
+    {
+        if (m_pHeader != nullptr)
+        {
+            m_pHeader->state.store(static_cast<uint32>(ShmConnectionState::Closed));
+
+            // Wake the peer up in case it's sleeping on either ring so it notices the connection is gone.
+            for (ShmRingHeader& ring : m_pHeader->rings)
+            {
+                ring.writeSeq.fetch_add(1);
+                ring.readSeq.fetch_add(1);
+                FutexWakeAll(&ring.writeSeq);
+                FutexWakeAll(&ring.readSeq);
+            }
+
+            m_pHeader = nullptr;
+        }
+
+        // The host unlinks the name on accept, but a client that never got accepted must clean it up itself.
+        m_region.Unlink();
+        m_region.Close();
+    }
+
+    // ================================================================================================================
+    bool ShmConnection::IsConnected() const
+    {
+        return (m_pHeader != nullptr) &&
+               (m_pHeader->state.load() == static_cast<uint32>(ShmConnectionState::Open));
+    }
+
+    // ================================================================================================================
+    bool ShmConnection::IsPeerAlive() const
+    {
+        return IsProcessAlive(m_isHost ? m_pHeader->clientPid : m_pHeader->hostPid);
+    }
+
+    // ================================================================================================================
+    Result ShmConnection::Write(const void* pData, size_t sizeInBytes)
+    {
+        Result result = Result::Unavailable;
+
+        if (sizeInBytes > kShmMaxRecordSize)
+        {
+            result = Result::InvalidParameter;
+        }
+        else if (IsConnected())
+        {
+            const uint32   ringIdx   = m_isHost ? 1 : 0;
+            ShmRingHeader* pRing     = &m_pHeader->rings[ringIdx];
+            uint8*         pRingData = static_cast<uint8*>(m_region.Data()) + kShmRingDataOffset + (ringIdx * kShmRingSize);
+            uint32         spinCount = 0;
+
+            result = Result::NotReady;
+
+            // Like a blocking socket send, wait for the reader to make room. Only a dead peer ends the wait.
+            while (result == Result::NotReady)
+            {
+                if (TryRingWrite(pRing, pRingData, pData, sizeInBytes))
+                {
+                    result = Result::Success;
+                }
+                else if (IsConnected() == false)
+                {
+                    result = Result::Unavailable;
+                }
+                else if (++spinCount >= kShmSpinCount)
+                {
+                    const uint32 readSeq = pRing->readSeq.load();
+                    pRing->writerWaiting.store(1);
+
+                    // Check again now that the reader can see that we're about to sleep.
+                    if (TryRingWrite(pRing, pRingData, pData, sizeInBytes))
+                    {
+                        result = Result::Success;
+                    }
+                    else
+                    {
+                        FutexWait(&pRing->readSeq, readSeq, kShmPollIntervalInMs);
+
+                        if ((pRing->readSeq.load() == readSeq) && (IsPeerAlive() == false))
+                        {
+                            m_pHeader->state.store(static_cast<uint32>(ShmConnectionState::Closed));
+                        }
+                    }
+
+                    pRing->writerWaiting.store(0);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    Result ShmConnection::Read(void* pData, size_t bufferSize, size_t* pBytesRead, uint32 timeoutInMs)
+    {
+        Result result = Result::Unavailable;
+
+        if (m_pHeader != nullptr)
+        {
+            const uint32   ringIdx   = m_isHost ? 0 : 1;
+            ShmRingHeader* pRing     = &m_pHeader->rings[ringIdx];
+            const uint8*   pRingData = static_cast<uint8*>(m_region.Data()) + kShmRingDataOffset + (ringIdx * kShmRingSize);
+            const uint64   deadline  = Platform::GetCurrentTimeInMs() + timeoutInMs;
+            uint32         spinCount = 0;
+
+            result = TryRingRead(pRing, pRingData, pData, bufferSize, pBytesRead);
+
+            while (result == Result::NotReady)
+            {
+                if (IsConnected() == false)
+                {
+                    // Messages written before the peer closed the connection have been read, so it's gone for good.
+                    result = Result::Unavailable;
+                }
+                else if ((timeoutInMs == 0) || (GetSleepTime(deadline) == 0))
+                {
+                    break;
+                }
+                else if (++spinCount < kShmSpinCount)
+                {
+                    result = TryRingRead(pRing, pRingData, pData, bufferSize, pBytesRead);
+                }
+                else
+                {
+                    const uint32 writeSeq = pRing->writeSeq.load();
+                    pRing->readerWaiting.store(1);
+
+                    result = TryRingRead(pRing, pRingData, pData, bufferSize, pBytesRead);
+
+                    if (result == Result::NotReady)
+                    {
+                        FutexWait(&pRing->writeSeq, writeSeq, GetSleepTime(deadline));
+
+                        if ((pRing->writeSeq.load() == writeSeq) && (IsPeerAlive() == false))
+                        {
+                            m_pHeader->state.store(static_cast<uint32>(ShmConnectionState::Closed));
+                        }
+
+                        result = TryRingRead(pRing, pRingData, pData, bufferSize, pBytesRead);
+                    }
+
+                    pRing->readerWaiting.store(0);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    ShmMsgTransport::ShmMsgTransport(const HostInfo& hostInfo)
+        : m_connection(false)
+        , m_connected(false)
+        , m_port(hostInfo.port)
+    {
+        DD_ASSERT(hostInfo.type == TransportType::Local);
+    }
+
+    // ================================================================================================================
+    ShmMsgTransport::~ShmMsgTransport()
+    {
+        Disconnect();
+    }
+
+    // ================================================================================================================
+    Result ShmMsgTransport::Connect(ClientId* pClientId, uint32 timeoutInMs)
+    {
+        DD_UNUSED(pClientId);
+
+        Result result = Result::Error;
+
+        if (m_connected == false)
+        {
+            char listenerName[kShmNameSize];
+            GetShmListenerName(m_port, listenerName);
+
+            ShmRegion listener;
+            result = listener.Open(listenerName, false);
+
+            auto*const pListener = static_cast<ShmListenerHeader*>(listener.Data());
+
+            if ((result == Result::Success) &&
+                ((listener.Size() < sizeof(ShmListenerHeader)) ||
+                 (pListener->magic != kShmListenerMagic)       ||
+                 (pListener->version != kShmLayoutVersion)     ||
+                 (IsProcessAlive(pListener->hostPid) == false)))
+            {
+                // Either a host we don't understand or a stale object left behind by a host that died.
+                result = Result::Unavailable;
+            }
+
+            if (result == Result::Success)
+            {
+                char connectionName[kShmNameSize];
+                GetUniqueShmName("conn", connectionName);
+
+                result = m_connection.Create(connectionName);
+            }
+
+            ShmListenerSlot* pSlot = nullptr;
+
+            for (uint32 i = 0; (result == Result::Success) && (pSlot == nullptr) && (i < kShmListenerSlots); ++i)
+            {
+                uint32 expected = static_cast<uint32>(ShmSlotState::Free);
+
+                if (pListener->slots[i].state.compare_exchange_strong(expected,
+                                                                      static_cast<uint32>(ShmSlotState::Claimed)))
+                {
+                    pSlot = &pListener->slots[i];
+                }
+            }
+
+            if ((result == Result::Success) && (pSlot == nullptr))
+            {
+                // Too many clients are connecting at once.
+                result = Result::NotReady;
+            }
+
+            if (result == Result::Success)
+            {
+                Platform::Strncpy(pSlot->name, m_connection.Name());
+                pSlot->clientPid = static_cast<uint32>(getpid());
+                pSlot->state.store(static_cast<uint32>(ShmSlotState::Posted));
+
+                pListener->postSeq.fetch_add(1);
+
+                if (pListener->hostWaiting.load() != 0)
+                {
+                    FutexWakeAll(&pListener->postSeq);
+                }
+
+                const uint64 deadline = Platform::GetCurrentTimeInMs() + timeoutInMs;
+                uint32       state    = pSlot->state.load();
+
+                while ((state == static_cast<uint32>(ShmSlotState::Posted)) &&
+                       (GetSleepTime(deadline) > 0)                        &&
+                       IsProcessAlive(pListener->hostPid))
+                {
+                    FutexWait(&pSlot->state, state, GetSleepTime(deadline));
+                    state = pSlot->state.load();
+                }
+
+                // Take the request back if the host didn't get to it. If it accepted it in the meantime, the exchange
+                // fails and we go ahead with the connection.
+                uint32 posted = static_cast<uint32>(ShmSlotState::Posted);
+
+                if (pSlot->state.compare_exchange_strong(posted, static_cast<uint32>(ShmSlotState::Free)))
+                {
+                    result = Result::NotReady;
+                }
+                else
+                {
+                    result = (pSlot->state.load() == static_cast<uint32>(ShmSlotState::Accepted)) ? Result::Success
+                                                                                                  : Result::Rejected;
+                    pSlot->state.store(static_cast<uint32>(ShmSlotState::Free));
+                }
+            }
+
+            if (result != Result::Success)
+            {
+                m_connection.Close();
+            }
+
+            m_connected = (result == Result::Success);
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    Result ShmMsgTransport::Disconnect()
+    {
+        Result result = Result::Error;
+
+        if (m_connected)
+        {
+            m_connected = false;
+            m_connection.Close();
+            result = Result::Success;
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    Result ShmMsgTransport::ReadMessage(MessageBuffer& messageBuffer, uint32 timeoutInMs)
+    {
+        Result result = Result::Error;
+
+        if (m_connected)
+        {
+            size_t bytesReceived = 0;
+            result = m_connection.Read(&messageBuffer, sizeof(MessageBuffer), &bytesReceived, timeoutInMs);
+
+            if (result == Result::Success)
+            {
+                result = ValidateMessageBuffer(&messageBuffer, bytesReceived);
+            }
+            else if (result != Result::NotReady)
+            {
+                // Report a lost connection the same way the socket transport does.
+                result = Result::Error;
+            }
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    Result ShmMsgTransport::WriteMessage(const MessageBuffer& messageBuffer)
+    {
+        Result result = Result::Error;
+
+        if (m_connected && (messageBuffer.header.payloadSize <= kMaxPayloadSizeInBytes))
+        {
+            const size_t totalMsgSize = (sizeof(MessageHeader) + messageBuffer.header.payloadSize);
+
+            result = (m_connection.Write(&messageBuffer, totalMsgSize) == Result::Success) ? Result::Success
+                                                                                           : Result::Error;
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    // Tests to see if the client can connect to a host through this transport. This mirrors
+    // SocketMsgTransport::TestConnection: connect, then make sure the host answers a KeepAlive.
+    Result ShmMsgTransport::TestConnection(const HostInfo& hostInfo, uint32 timeoutInMs)
+    {
+        ShmMsgTransport transport(hostInfo);
+
+        Result result = transport.Connect(nullptr, timeoutInMs);
+
+        if (result == Result::Success)
+        {
+            MessageBuffer message = kOutOfBandMessage;
+            message.header.messageId = static_cast<MessageCode>(ManagementMessage::KeepAlive);
+
+            result = transport.WriteMessage(message);
+
+            if (result == Result::Success)
+            {
+                MessageBuffer responseMessage = {};
+                result = transport.ReadMessage(responseMessage, timeoutInMs);
+
+                if (result == Result::Success)
+                {
+                    // As on sockets, a host that answers with anything else is treated as a version mismatch.
+                    const bool isKeepAlive =
+                        IsOutOfBandMessage(responseMessage) &&
+                        IsValidOutOfBandMessage(responseMessage) &&
+                        (responseMessage.header.messageId == static_cast<MessageCode>(ManagementMessage::KeepAlive));
+
+                    result = isKeepAlive ? Result::Success : Result::VersionMismatch;
+                }
+            }
+
+            transport.Disconnect();
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    ShmMsgListener::ShmMsgListener()
+        : m_pHeader(nullptr)
+    {
+    }
+
+    // ================================================================================================================
+    ShmMsgListener::~ShmMsgListener()
+    {
+        Destroy();
+    }
+
+    // ================================================================================================================
+    Result ShmMsgListener::Create(uint16 port)
+    {
+        char name[kShmNameSize];
+        GetShmListenerName(port, name);
+
+        Result result = m_region.Create(name, sizeof(ShmListenerHeader));
+
+        if (result == Result::EntryExists)
+        {
+            // Replace the object if the host that created it is gone, otherwise there already is a host on this port.
+            ShmRegion existing;
+
+            if (existing.Open(name, false) == Result::Success)
+            {
+                const auto*const pExisting = static_cast<const ShmListenerHeader*>(existing.Data());
+
+                if ((existing.Size() >= sizeof(ShmListenerHeader)) && IsProcessAlive(pExisting->hostPid))
+                {
+                    result = Result::ConnectionExists;
+                }
+                else
+                {
+                    existing.Unlink();
+                }
+            }
+
+            if (result == Result::EntryExists)
+            {
+                result = m_region.Create(name, sizeof(ShmListenerHeader));
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            m_pHeader = new(m_region.Data()) ShmListenerHeader();
+
+            m_pHeader->magic   = kShmListenerMagic;
+            m_pHeader->version = kShmLayoutVersion;
+            m_pHeader->hostPid = static_cast<uint32>(getpid());
+        }
+
+        return result;
+    }
+
+    // ================================================================================================================
+    void ShmMsgListener::Destroy()
+    {
+        m_pHeader = nullptr;
+
+        m_region.Unlink();
+        m_region.Close();
+    }
+
+    // ================================================================================================================
+    Result ShmMsgListener::Accept(const AllocCb& allocCb, ShmConnection** ppConnection, uint32 timeoutInMs)
+    {
+        Result result = Result::Error;
+
+        if ((m_pHeader != nullptr) && (ppConnection != nullptr))
+        {
+            const uint64 deadline = Platform::GetCurrentTimeInMs() + timeoutInMs;
+
+            result = Result::NotReady;
+
+            while (result == Result::NotReady)
+            {
+                const uint32 postSeq = m_pHeader->postSeq.load();
+
+                for (ShmListenerSlot& slot : m_pHeader->slots)
+                {
+                    if ((result == Result::NotReady) &&
+                        (slot.state.load() == static_cast<uint32>(ShmSlotState::Posted)))
+                    {
+                        ShmConnection* pConnection = DD_NEW(ShmConnection, allocCb)(true);
+                        Result         acceptResult = Result::InsufficientMemory;
+
+                        if (pConnection != nullptr)
+                        {
+                            char name[kShmNameSize];
+                            Platform::Strncpy(name, slot.name);
+
+                            acceptResult = pConnection->Accept(name);
+                        }
+
+                        slot.state.store(static_cast<uint32>((acceptResult == Result::Success) ? ShmSlotState::Accepted
+                                                                                               : ShmSlotState::Rejected));
+                        FutexWakeAll(&slot.state);
+
+                        if (acceptResult == Result::Success)
+                        {
+                            *ppConnection = pConnection;
+                            result        = Result::Success;
+                        }
+                        else if (pConnection != nullptr)
+                        {
+                            DD_DELETE(pConnection, allocCb);
+                        }
+                    }
+                }
+
+                if (result == Result::NotReady)
+                {
+                    const uint32 sleepTime = GetSleepTime(deadline);
+
+                    if (sleepTime == 0)
+                    {
+                        break;
+                    }
+
+                    m_pHeader->hostWaiting.store(1);
+                    FutexWait(&m_pHeader->postSeq, postSeq, sleepTime);
+                    m_pHeader->hostWaiting.store(0);
+                }
+            }
+        }
+
+        return result;
+    }
+
+} // DevDriver
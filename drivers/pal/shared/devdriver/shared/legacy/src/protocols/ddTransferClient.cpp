@@ -24,9 +24,14 @@
  **********************************************************************************************************************/
 
 #include "protocols/ddTransferClient.h"
+#include "msgChannel.h"
+
+#if DD_SUPPORT_SHM_TRANSPORT
+#include "shmMsgTransport.h"
+#endif
 
 #define TRANSFER_CLIENT_MIN_VERSION 1
-#define TRANSFER_CLIENT_MAX_VERSION 2
+#define TRANSFER_CLIENT_MAX_VERSION 3
 
 namespace DevDriver
 {
@@ -38,6 +43,7 @@ namespace DevDriver
                                  Protocol::Transfer,
                                  TRANSFER_CLIENT_MIN_VERSION,
                                  TRANSFER_CLIENT_MAX_VERSION)
+            , m_pSharedBlock(nullptr)
         {
             memset(&m_transferContext, 0, sizeof(m_transferContext));
         }
@@ -45,6 +51,7 @@ namespace DevDriver
         // ============================================================================================================
         TransferClient::~TransferClient()
         {
+            CloseSharedBlock();
         }
 
         // ============================================================================================================
@@ -55,13 +62,49 @@ namespace DevDriver
             if ((m_transferContext.state == TransferState::Idle) &&
                 (pTransferSizeInBytes != nullptr))
             {
+#if DD_SUPPORT_SHM_TRANSPORT
+                // Clients on the shared memory transport run on the same machine as the server, so they can map the
+                // block directly instead of streaming it through the message bus.
+                const bool requestShared = (GetSessionVersion() >= TRANSFER_SHARED_MEMORY_VERSION) &&
+                                           (strcmp(m_pMsgChannel->GetTransportName(), kShmTransportName) == 0);
+#else
+                const bool requestShared = false;
+#endif
+
+                m_transferContext.type = TransferType::Pull;
+
                 SizedPayloadContainer container = {};
-                container.CreatePayload<TransferRequest>(blockId, TransferType::Pull, 0);
+                container.CreatePayload<TransferRequest>(blockId,
+                                                         requestShared ? TransferType::PullShared : TransferType::Pull,
+                                                         0);
 
                 result = TransactTransferPayload(&container);
 
                 if ((result == Result::Success) &&
-                    (container.GetPayload<TransferHeader>().command == TransferMessage::TransferDataHeader))
+                    (container.GetPayload<TransferHeader>().command == TransferMessage::TransferSharedDataHeader))
+                {
+                    result = BeginSharedPullTransfer(container.GetPayload<TransferSharedDataHeader>());
+
+                    if (result != Result::Success)
+                    {
+                        // Release the server's block and ask for a regular transfer instead.
+                        container.CreatePayload<TransferStatus>(Result::Aborted);
+                        result = SendTransferPayload(container);
+
+                        if (result == Result::Success)
+                        {
+                            container.CreatePayload<TransferRequest>(blockId, TransferType::Pull, 0);
+                            result = TransactTransferPayload(&container);
+                        }
+                    }
+                }
+
+                if ((result == Result::Success) && (m_transferContext.type == TransferType::PullShared))
+                {
+                    *pTransferSizeInBytes = m_transferContext.totalBytes;
+                }
+                else if ((result == Result::Success) &&
+                         (container.GetPayload<TransferHeader>().command == TransferMessage::TransferDataHeader))
                 {
                     // We've successfully received the transfer data header. Check if the transfer request was successful.
                     if (GetSessionVersion() >= TRANSFER_REFACTOR_VERSION)
@@ -114,7 +157,13 @@ namespace DevDriver
         {
             Result result = Result::Error;
 
-            if ((m_transferContext.state == TransferState::TransferInProgress) && (pBytesRead != nullptr))
+            if ((m_transferContext.state == TransferState::TransferInProgress) &&
+                (m_transferContext.type == TransferType::PullShared) &&
+                (pBytesRead != nullptr))
+            {
+                result = ReadSharedPullTransferData(pDstBuffer, bufferSize, pBytesRead);
+            }
+            else if ((m_transferContext.state == TransferState::TransferInProgress) && (pBytesRead != nullptr))
             {
                 result = Result::Success;
 
@@ -342,6 +391,12 @@ namespace DevDriver
             Result result = Result::Error;
 
             if ((m_transferContext.state == TransferState::TransferInProgress) &&
+                (m_transferContext.type == TransferType::PullShared))
+            {
+                // The server doesn't answer aborts of shared transfers, there is no data in flight to discard.
+                result = EndSharedPullTransfer(Result::Aborted);
+            }
+            else if ((m_transferContext.state == TransferState::TransferInProgress) &&
                 (m_transferContext.type == TransferType::Pull))
             {
                 SizedPayloadContainer container = {};
@@ -385,9 +440,120 @@ namespace DevDriver
         // ============================================================================================================
         void TransferClient::ResetState()
         {
+            CloseSharedBlock();
             memset(&m_transferContext, 0, sizeof(m_transferContext));
         }
 
+        // ============================================================================================================
+        Result TransferClient::BeginSharedPullTransfer(const TransferSharedDataHeader& header)
+        {
+            Result result = Result::Unavailable;
+
+#if DD_SUPPORT_SHM_TRANSPORT
+            DD_ASSERT(m_pSharedBlock == nullptr);
+
+            // The name comes off the wire, so make sure it's terminated before using it.
+            char name[kMaxSharedBlockNameSize];
+            Platform::Strncpy(name, header.name);
+
+            m_pSharedBlock = DD_NEW(ShmRegion, m_pMsgChannel->GetAllocCb())();
+            if (m_pSharedBlock != nullptr)
+            {
+                result = m_pSharedBlock->Open(name, true);
+
+                if ((result == Result::Success) && (m_pSharedBlock->Size() < header.sizeInBytes))
+                {
+                    result = Result::Error;
+                }
+            }
+            else
+            {
+                result = Result::InsufficientMemory;
+            }
+
+            if (result == Result::Success)
+            {
+                m_transferContext.state = TransferState::TransferInProgress;
+                m_transferContext.type = TransferType::PullShared;
+                m_transferContext.totalBytes = header.sizeInBytes;
+                m_transferContext.crc32 = 0;
+                m_transferContext.dataChunkSizeInBytes = header.sizeInBytes;
+                m_transferContext.dataChunkBytesTransfered = 0;
+            }
+            else
+            {
+                CloseSharedBlock();
+            }
+#else
+            DD_UNUSED(header);
+#endif
+
+            return result;
+        }
+
+        // ============================================================================================================
+        Result TransferClient::ReadSharedPullTransferData(uint8* pDstBuffer, size_t bufferSize, size_t* pBytesRead)
+        {
+            Result result = Result::Error;
+
+#if DD_SUPPORT_SHM_TRANSPORT
+            DD_ASSERT(m_pSharedBlock != nullptr);
+
+            // The server doesn't compute a CRC for this data, the copy never leaves this machine.
+            const size_t bytesRemaining =
+                (m_transferContext.dataChunkSizeInBytes - m_transferContext.dataChunkBytesTransfered);
+            const size_t bytesToRead = Platform::Min(bufferSize, bytesRemaining);
+            const uint8* pData = static_cast<const uint8*>(m_pSharedBlock->Data());
+
+            memcpy(pDstBuffer, pData + m_transferContext.dataChunkBytesTransfered, bytesToRead);
+            m_transferContext.dataChunkBytesTransfered += bytesToRead;
+            *pBytesRead = bytesToRead;
+
+            result = Result::Success;
+
+            // If this is the last of the data for the transfer, return end of stream and release the block.
+            if (m_transferContext.dataChunkBytesTransfered == m_transferContext.dataChunkSizeInBytes)
+            {
+                m_transferContext.totalBytes = 0;
+                result = (EndSharedPullTransfer(Result::Success) == Result::Success) ? Result::EndOfStream
+                                                                                      : Result::Error;
+            }
+#else
+            DD_UNUSED(pDstBuffer);
+            DD_UNUSED(bufferSize);
+            DD_UNUSED(pBytesRead);
+#endif
+
+            return result;
+        }
+
+        // ============================================================================================================
+        Result TransferClient::EndSharedPullTransfer(Result status)
+        {
+            CloseSharedBlock();
+
+            SizedPayloadContainer container = {};
+            container.CreatePayload<TransferStatus>(status);
+
+            const Result result = SendTransferPayload(container);
+
+            m_transferContext.state = (result == Result::Success) ? TransferState::Idle : TransferState::Error;
+
+            return result;
+        }
+
+        // ============================================================================================================
+        void TransferClient::CloseSharedBlock()
+        {
+#if DD_SUPPORT_SHM_TRANSPORT
+            if (m_pSharedBlock != nullptr)
+            {
+                DD_DELETE(m_pSharedBlock, m_pMsgChannel->GetAllocCb());
+                m_pSharedBlock = nullptr;
+            }
+#endif
+        }
+
         // ============================================================================================================
         // Helper method to send a payload, handling backwards compatibility and retrying.
         Result TransferClient::SendTransferPayload(
@@ -28,7 +28,7 @@
 #include "msgChannel.h"
 
 #define TRANSFER_SERVER_MIN_VERSION 1
-#define TRANSFER_SERVER_MAX_VERSION 2
+#define TRANSFER_SERVER_MAX_VERSION 3
 
 namespace DevDriver
 {
@@ -42,6 +42,8 @@ namespace DevDriver
             ProcessPullTransfer,
             StartPushTransfer,
             ReceivePushTransferData,
+            StartSharedPullTransfer,
+            SharedPullTransfer,
         };
 
         class TransferServer::TransferSession
@@ -107,6 +109,7 @@ namespace DevDriver
                         // It is invalid for sessions of version less than TRANSFER_REFACTOR_VERSION to set a non-zero
                         // value for request.type
                     case TransferType::Pull:
+                    case TransferType::PullShared:
                     {
                         // Determine if the requested block is available. Available, in this context, means that
                         // the block exists and has been closed.
@@ -125,19 +128,29 @@ namespace DevDriver
                             m_totalBytes = pBlock->GetBlockDataSize();
                             m_bytesTransferred = 0;
                             m_crc32 = pBlock->GetCrc32();
-                            m_state = SessionState::StartPullTransfer;
 
                             const uint32 blockSizeInBytes = static_cast<uint32>(m_pBlock->GetBlockDataSize());
-                            if (m_pSession->GetVersion() >= TRANSFER_REFACTOR_VERSION)
+                            if ((request.type == TransferType::PullShared) && (m_pBlock->GetSharedName() != nullptr))
                             {
+                                // The client maps the block directly, so only the header needs to be sent.
+                                // Blocks without shared storage fall through to a regular transfer.
+                                m_state = SessionState::StartSharedPullTransfer;
+                                m_scratchPayload.CreatePayload<TransferSharedDataHeader>(blockSizeInBytes,
+                                                                                         m_pBlock->GetSharedName());
+                                SendSharedPullTransferHeader();
+                            }
+                            else if (m_pSession->GetVersion() >= TRANSFER_REFACTOR_VERSION)
+                            {
+                                m_state = SessionState::StartPullTransfer;
                                 m_scratchPayload.CreatePayload<TransferDataHeaderV2>(blockSizeInBytes);
+                                SendPullTransferHeader();
                             }
                             else
                             {
+                                m_state = SessionState::StartPullTransfer;
                                 m_scratchPayload.CreatePayload<TransferDataHeader>(Result::Success, blockSizeInBytes);
+                                SendPullTransferHeader();
                             }
-
-                            SendPullTransferHeader();
                         }
                         else
                         {
@@ -314,6 +327,37 @@ namespace DevDriver
                 }
             }
 
+            // ========================================================================================================
+            void SendSharedPullTransferHeader()
+            {
+                DD_ASSERT(m_state == SessionState::StartSharedPullTransfer);
+                if (SendPayload(m_scratchPayload, kNoWait) == Result::Success)
+                {
+                    m_state = SessionState::SharedPullTransfer;
+                }
+            }
+
+            // ========================================================================================================
+            void ProcessSharedPullSession()
+            {
+                DD_ASSERT(m_state == SessionState::SharedPullTransfer);
+
+                // The block has to stay alive until the client tells us it's done reading it.
+                const Result result = ReceivePayload(&m_scratchPayload, kNoWait);
+                if (result == Result::Success)
+                {
+                    if (m_scratchPayload.GetPayload<TransferHeader>().command != TransferMessage::TransferStatus)
+                    {
+                        DD_WARN_REASON("Shared pull transfer received unexpected packet from client");
+                    }
+
+                    // The client doesn't expect a response, whether it finished or aborted.
+                    m_pBlock->EndTransfer();
+                    m_pBlock.Clear();
+                    m_state = SessionState::Idle;
+                }
+            }
+
             // ========================================================================================================
             void StartPushTransferSession()
             {
@@ -433,6 +477,18 @@ namespace DevDriver
                     break;
                 }
 
+                case SessionState::StartSharedPullTransfer:
+                {
+                    SendSharedPullTransferHeader();
+                    break;
+                }
+
+                case SessionState::SharedPullTransfer:
+                {
+                    ProcessSharedPullSession();
+                    break;
+                }
+
                 case SessionState::ReceivePushTransferData:
                 {
                     ReceivePushTransferData();
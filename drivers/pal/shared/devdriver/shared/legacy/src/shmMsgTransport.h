@@ -0,0 +1,186 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include <msgTransport.h>
+#include <ddPlatform.h>
+
+namespace DevDriver
+{
+    struct ShmConnectionHeader;
+    struct ShmListenerHeader;
+
+    // Name reported by GetTransportName() for shared memory transports.
+    DD_STATIC_CONST char kShmTransportName[] = "Shared Memory";
+
+    // Maximum length of a shared memory object name, including the null terminator.
+    DD_STATIC_CONST size_t kShmNameSize = 64;
+
+    // How long a client waits for a shared memory host before falling back to the socket transport.
+    DD_STATIC_CONST uint32 kShmProbeTimeoutInMs = 250;
+
+    // A named POSIX shared memory object mapped into this process.
+    // Objects are created with owner-only permissions, so they can only be shared with processes of the same user.
+    class ShmRegion
+    {
+    public:
+        ShmRegion();
+        ~ShmRegion();
+
+        // Creates and maps a new object. Fails if an object with this name already exists.
+        Result Create(const char* pName, size_t sizeInBytes);
+
+        // Maps an existing object in its entirety.
+        Result Open(const char* pName, bool readOnly);
+
+        // Grows or shrinks an object created by this process. The mapping may move.
+        Result Resize(size_t sizeInBytes);
+
+        // Removes the name so no new process can open the object. Existing mappings stay valid.
+        void Unlink();
+
+        // Unmaps the object. The name is kept unless Unlink() was called.
+        void Close();
+
+        void*       Data() const { return m_pData; }
+        size_t      Size() const { return m_size; }
+        const char* Name() const { return m_name; }
+        bool        IsOpen() const { return (m_pData != nullptr); }
+
+    private:
+        int    m_fd;
+        void*  m_pData;
+        size_t m_size;
+        bool   m_isOwner;
+        bool   m_isLinked;
+        char   m_name[kShmNameSize];
+    };
+
+    // One connection between a client and a host (router or tool) on the same machine, made of two single-producer
+    // single-consumer rings of messages. Either side can use this class; isHost selects which ring it writes.
+    class ShmConnection
+    {
+    public:
+        explicit ShmConnection(bool isHost);
+        ~ShmConnection();
+
+        // Client side: creates the shared object for a new connection. The host picks it up in ShmMsgListener::Accept.
+        Result Create(const char* pName);
+
+        // Host side: maps a connection created by a client and marks it as open.
+        Result Accept(const char* pName);
+
+        // Marks the connection as closed, wakes up the peer and unmaps it.
+        void Close();
+
+        // Copies a message into the outgoing ring. Blocks while the ring is full, unless the peer goes away.
+        Result Write(const void* pData, size_t sizeInBytes);
+
+        // Copies the next incoming message into pData. Waits up to timeoutInMs and returns NotReady if no message
+        // arrived in time. Returns Unavailable once the peer has closed the connection and all its messages are read.
+        Result Read(void* pData, size_t bufferSize, size_t* pBytesRead, uint32 timeoutInMs);
+
+        bool IsConnected() const;
+
+        const char* Name() const { return m_region.Name(); }
+
+    private:
+        bool IsPeerAlive() const;
+
+        ShmRegion            m_region;
+        ShmConnectionHeader* m_pHeader;
+        const bool           m_isHost;
+    };
+
+    // Transport used by clients on the same host as the developer service. Messages are copied through a pair of
+    // shared memory rings instead of going through a socket, which removes a syscall per message. The connection is
+    // negotiated through a listener object published by the host process (see ShmMsgListener). Connect() fails with
+    // Unavailable if there is no such host, in which case callers fall back to SocketMsgTransport.
+    class ShmMsgTransport : public IMsgTransport
+    {
+    public:
+        explicit ShmMsgTransport(const HostInfo& hostInfo);
+        ~ShmMsgTransport();
+
+        Result Connect(ClientId* pClientId, uint32 timeoutInMs) override;
+        Result Disconnect() override;
+
+        Result ReadMessage(MessageBuffer& messageBuffer, uint32 timeoutInMs) override;
+        Result WriteMessage(const MessageBuffer& messageBuffer) override;
+
+        const char* GetTransportName() const override
+        {
+            return kShmTransportName;
+        }
+
+        // Tests whether a host is listening for shared memory connections and answers messages.
+        static Result TestConnection(const HostInfo& hostInfo, uint32 timeoutInMs);
+
+        // Messages still go through the host's client registration, exactly as on the socket transport.
+        DD_STATIC_CONST bool RequiresKeepAlive()
+        {
+            return true;
+        }
+
+        DD_STATIC_CONST bool RequiresClientRegistration()
+        {
+            return true;
+        }
+
+    private:
+        ShmConnection m_connection;
+        bool          m_connected;
+        uint16        m_port;
+    };
+
+    // Host side of ShmMsgTransport. A host process (router or tool) creates one listener per port and accepts
+    // connections from it. Each accepted connection is then serviced like a socket connection.
+    class ShmMsgListener
+    {
+    public:
+        ShmMsgListener();
+        ~ShmMsgListener();
+
+        // Publishes the listener object for the given port. A stale object left behind by a dead host is replaced.
+        Result Create(uint16 port);
+        void Destroy();
+
+        // Waits up to timeoutInMs for a client to connect. On success *ppConnection is a new connection which the
+        // caller must close and delete with DD_DELETE.
+        Result Accept(const AllocCb& allocCb, ShmConnection** ppConnection, uint32 timeoutInMs);
+
+    private:
+        ShmRegion          m_region;
+        ShmListenerHeader* m_pHeader;
+    };
+
+    // Builds the name of the listener object for a port.
+    void GetShmListenerName(uint16 port, char (&name)[kShmNameSize]);
+
+    // Builds a process-unique name for a new shared memory object with the given kind (e.g. "conn" or "block").
+    void GetUniqueShmName(const char* pKind, char (&name)[kShmNameSize]);
+
+} // DevDriver
@@ -52,6 +52,7 @@ AddrMgr::AddrMgr(
     m_hAddrLib(nullptr),
     m_pSwizzleEquations(nullptr),
     m_numSwizzleEquations(0),
+    m_pAddrLibEquations(nullptr),
     m_tileInfoBytes(tileInfoBytes)
 {
 }
@@ -116,6 +117,7 @@ Result AddrMgr::Init()
     {
         m_numSwizzleEquations = createOutput.numEquations;
         m_pSwizzleEquations   = nullptr;
+        m_pAddrLibEquations   = createOutput.pEquationTable;
 
         if (m_numSwizzleEquations > 0)
         {
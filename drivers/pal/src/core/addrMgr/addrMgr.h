@@ -68,9 +68,27 @@ public:
     const SwizzleEquation* SwizzleEquations() const { return m_pSwizzleEquations; }
     uint32 NumSwizzleEquations() const { return m_numSwizzleEquations; }
 
+    // Returns AddrLib's own swizzle equation table. Unlike SwizzleEquations() this keeps every XOR component, and it
+    // stays valid for as long as the AddrLib handle does.
+    const ADDR_EQUATION* AddrLibEquations() const { return m_pAddrLibEquations; }
+
     // Returns the size, in bytes, of the amount of per-subresource tiling information needed.
     size_t TileInfoBytes() const { return m_tileInfoBytes; }
 
+    // Copies texels between host memory and a CPU mapping of an Image's memory. pImageData points at the start of the
+    // Image's data. Address managers which can't address their tiling modes on the CPU report ErrorUnavailable.
+    virtual Result CopyHostImage(
+        const Image&               image,
+        void*                      pImageData,
+        uint32                     regionCount,
+        const HostImageCopyRegion* pRegions,
+        uint32                     maxThreads,
+        bool                       toImage) const
+        { return Result::ErrorUnavailable; }
+
+    // Returns true if CopyHostImage() can address every swizzle mode an Image created with needSwizzleEqs may get.
+    virtual bool SupportsHostImageCopy() const { return false; }
+
     // Returns the tile swizzle value for a particular subresource of an Image.
     virtual uint32 GetTileSwizzle(const Image* pImage, SubresId subresource) const = 0;
 
@@ -106,6 +124,7 @@ private:
     ADDR_HANDLE         m_hAddrLib;
     SwizzleEquation*    m_pSwizzleEquations;        // List of swizzle equations supported by the Device
     uint32              m_numSwizzleEquations;      // Number of supporter swizzle equations
+    const ADDR_EQUATION* m_pAddrLibEquations;       // AddrLib-owned equation table, m_numSwizzleEquations long
 
     const size_t        m_tileInfoBytes;            // Per-subresource stride used for tiling information
 
@@ -44,10 +44,32 @@ AddrMgr2::AddrMgr2(
     // Note: Each subresource for AddrMgr2 hardware needs the following tiling information: the actual tiling
     // information for itself as computed by the AddrLib.
     AddrMgr(pDevice, sizeof(TileInfo)),
-    m_varBlockSize(pDevice->GetGfxDevice()->GetVarBlockSize())
+    m_varBlockSize(pDevice->GetGfxDevice()->GetVarBlockSize()),
+    m_pHostCopyEqs(nullptr),
+    m_hostCopyIsa(HostCopyIsa::Generic),
+    m_supportsHostCopy(false)
 {
 }
 
+// =====================================================================================================================
+AddrMgr2::~AddrMgr2()
+{
+    PAL_SAFE_DELETE_ARRAY(m_pHostCopyEqs, m_pDevice->GetPlatform());
+}
+
+// =====================================================================================================================
+Result AddrMgr2::Init()
+{
+    Result result = AddrMgr::Init();
+
+    if (result == Result::Success)
+    {
+        result = InitHostCopyEquations();
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 Result Create(
     const Device*  pDevice,
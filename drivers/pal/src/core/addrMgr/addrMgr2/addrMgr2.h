@@ -27,6 +27,7 @@
 
 #include "core/image.h"
 #include "core/addrMgr/addrMgr.h"
+#include "core/addrMgr/addrMgr2/addrMgr2HostCopy.h"
 
 // Need the HW version of the tiling definitions
 #include "core/hw/gfxip/gfx9/chip/gfx9_plus_merged_enum.h"
@@ -386,7 +387,9 @@ class AddrMgr2 final : public AddrMgr
 {
 public:
     explicit AddrMgr2(const Device*  pDevice);
-    virtual ~AddrMgr2() {}
+    virtual ~AddrMgr2();
+
+    virtual Result Init() override;
 
     Pal::Gfx9::SWIZZLE_MODE_ENUM GetHwSwizzleMode(AddrSwizzleMode  swizzleMode) const;
 
@@ -421,6 +424,16 @@ public:
     // to a 3D image.
     virtual bool IsThin(uint32  swizzleMode) const override;
 
+    virtual Result CopyHostImage(
+        const Image&               image,
+        void*                      pImageData,
+        uint32                     regionCount,
+        const HostImageCopyRegion* pRegions,
+        uint32                     maxThreads,
+        bool                       toImage) const override;
+
+    virtual bool SupportsHostImageCopy() const override { return m_supportsHostCopy; }
+
 protected:
     virtual void ComputeTilesInMipTail(
         const Image&       image,
@@ -498,10 +511,24 @@ private:
 
     uint32 GetNoXorStatus(const Image* pImage) const;
 
+    Result InitHostCopyEquations();
+
+#if PAL_ENABLE_PRINTS_ASSERTS
+    bool ValidateHostCopyJob(
+        const Image&       image,
+        const void*        pImageData,
+        const HostCopyJob& job) const;
+#endif
+
     PAL_DISALLOW_DEFAULT_CTOR(AddrMgr2);
     PAL_DISALLOW_COPY_AND_ASSIGN(AddrMgr2);
 
     uint32 m_varBlockSize;
+
+    // CPU forms of the AddrLib swizzle equations, indexed like the equation table. Null if host copies aren't supported.
+    HostCopyEquation* m_pHostCopyEqs;
+    HostCopyIsa       m_hostCopyIsa;      // Copy loops picked for this CPU.
+    bool              m_supportsHostCopy; // Every swizzle equation can be addressed on the CPU.
 };
 
 } // AddrMgr2
@@ -0,0 +1,772 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/addrMgr/addrMgr2/addrMgr2.h"
+#include "core/addrMgr/addrMgr2/addrMgr2HostCopy.h"
+#include "core/device.h"
+#include "core/image.h"
+#include "core/hw/gfxip/gfxImage.h"
+#include "palAutoBuffer.h"
+#include "palFormatInfo.h"
+#include "palInlineFuncs.h"
+#include "palSysUtil.h"
+#include "palThread.h"
+
+#include <atomic>
+#include <cstring>
+
+// The copy loops are compiled for each instruction set with target attributes and chosen at runtime, so they don't
+// depend on the ISA the rest of PAL is built for.
+#if PAL_HAS_CPUID
+#include <immintrin.h>
+#define PAL_HOST_COPY_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+using namespace Util;
+
+namespace Pal
+{
+namespace AddrMgr2
+{
+
+// Copies smaller than this many bytes per thread aren't worth waking up another thread for.
+constexpr gpusize MinHostCopyBytesPerThread = 1024 * 1024;
+
+// =====================================================================================================================
+// Returns the XOR of the masks selected by the set bits of a coordinate.
+static PAL_FORCE_INLINE uint32 XorMasks(
+    const uint32* pMasks,
+    uint32        coord)
+{
+    uint32 result = 0;
+    uint32 bit    = 0;
+
+    while (BitMaskScanForward(&bit, coord))
+    {
+        result ^= pMasks[bit];
+        coord  &= (coord - 1);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Converts an AddrLib swizzle equation into per-coordinate-bit masks and finds how many low bytes of x it leaves alone.
+void BuildHostCopyEquation(
+    const ADDR_EQUATION& addrEq,
+    HostCopyEquation*    pEq)
+{
+    memset(pEq, 0, sizeof(*pEq));
+
+    const uint32 numComps = Min(addrEq.numBitComponents, ADDR_MAX_EQUATION_COMP);
+
+    for (uint32 bit = 0; bit < addrEq.numBits; ++bit)
+    {
+        for (uint32 comp = 0; comp < numComps; ++comp)
+        {
+            const ADDR_CHANNEL_SETTING& setting = addrEq.comps[comp][bit];
+
+            // Channel 3 is the sample index, which is always zero since only single-sampled images are copied.
+            if ((setting.valid != 0) && (setting.channel < 3))
+            {
+                uint32*const pMasks = (setting.channel == 0) ? pEq->xMasks :
+                                      (setting.channel == 1) ? pEq->yMasks : pEq->zMasks;
+
+                pMasks[setting.index] ^= (1u << bit);
+            }
+        }
+    }
+
+    // Equations which stack depth slices vertically can't be expressed as per-coordinate masks. GFX10+ AddrLib never
+    // builds them, but they are marked unusable rather than copied incorrectly.
+    pEq->valid = (addrEq.stackedDepthSlices == FALSE);
+
+    // Offset bit N belongs to the contiguous run if it is exactly x bit N and nothing else feeds into it.
+    for (pEq->runLog2 = 0; pEq->valid && (pEq->runLog2 < addrEq.numBits); pEq->runLog2++)
+    {
+        const uint32 offsetBit = (1u << pEq->runLog2);
+        bool         isLinear  = (pEq->xMasks[pEq->runLog2] == offsetBit);
+
+        for (uint32 coordBit = 0; isLinear && (coordBit < HostCopyCoordBits); ++coordBit)
+        {
+            isLinear = (((coordBit != pEq->runLog2) && ((pEq->xMasks[coordBit] & offsetBit) != 0)) ||
+                        ((pEq->yMasks[coordBit] & offsetBit) != 0) ||
+                        ((pEq->zMasks[coordBit] & offsetBit) != 0)) == false;
+        }
+
+        if (isLinear == false)
+        {
+            break;
+        }
+    }
+}
+
+// =====================================================================================================================
+// Evaluates a swizzle equation for one element.  This matches AddrLib's ComputeOffsetFromEquation().
+uint32 ComputeHostCopyBlockOffset(
+    const HostCopyEquation& eq,
+    uint32                  xInBytes,
+    uint32                  y,
+    uint32                  z)
+{
+    return XorMasks(eq.xMasks, xInBytes) ^ XorMasks(eq.yMasks, y) ^ XorMasks(eq.zMasks, z);
+}
+
+// =====================================================================================================================
+// Returns the offset of element (x, y) of a tiled job relative to the job's pImage.
+gpusize ComputeHostCopyElementOffset(
+    const HostCopyJob& job,
+    uint32             x,
+    uint32             y)
+{
+    const uint32  blockOffset = ComputeHostCopyBlockOffset(*job.pEq,
+                                                           ((x + job.tailX) << job.elemLog2),
+                                                           (y + job.tailY),
+                                                           job.z) ^ job.pipeBankXor;
+    const gpusize blockIndex  = (gpusize(y >> job.blockHeightLog2) * job.pitchInBlocks) + (x >> job.blockWidthLog2);
+
+    return job.sliceOffset + (blockIndex << job.blockLog2) + blockOffset;
+}
+
+// Copies one contiguous run of bytes between host memory and a CPU mapping of an image.
+typedef void (*HostCopyRunFunc)(uint8* pDst, const uint8* pSrc, uint32 bytes);
+
+// =====================================================================================================================
+static void CopyRunGeneric(
+    uint8*       pDst,
+    const uint8* pSrc,
+    uint32       bytes)
+{
+    memcpy(pDst, pSrc, bytes);
+}
+
+#if PAL_HAS_CPUID
+// =====================================================================================================================
+static PAL_HOST_COPY_TARGET("sse2") void CopyRunSse2(
+    uint8*       pDst,
+    const uint8* pSrc,
+    uint32       bytes)
+{
+    for (; bytes >= 16; bytes -= 16, pDst += 16, pSrc += 16)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)));
+    }
+
+    if (bytes > 0)
+    {
+        memcpy(pDst, pSrc, bytes);
+    }
+}
+
+// =====================================================================================================================
+// CPU-visible video memory is write-combined, where ordinary loads are uncached and very slow; SSE4.1 streaming loads
+// read a whole line into a fill buffer instead. This is only used for reads out of the image.
+static PAL_HOST_COPY_TARGET("sse4.1") void CopyRunFromImageSse41(
+    uint8*       pDst,
+    const uint8* pSrc,
+    uint32       bytes)
+{
+    if (VoidPtrIsPow2Aligned(pSrc, 16))
+    {
+        for (; bytes >= 16; bytes -= 16, pDst += 16, pSrc += 16)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst),
+                             _mm_stream_load_si128(reinterpret_cast<__m128i*>(const_cast<uint8*>(pSrc))));
+        }
+    }
+
+    CopyRunSse2(pDst, pSrc, bytes);
+}
+
+// =====================================================================================================================
+static PAL_HOST_COPY_TARGET("avx2") void CopyRunAvx2(
+    uint8*       pDst,
+    const uint8* pSrc,
+    uint32       bytes)
+{
+    for (; bytes >= 32; bytes -= 32, pDst += 32, pSrc += 32)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc)));
+    }
+
+    if (bytes >= 16)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)));
+        bytes -= 16;
+        pDst  += 16;
+        pSrc  += 16;
+    }
+
+    if (bytes > 0)
+    {
+        memcpy(pDst, pSrc, bytes);
+    }
+}
+
+// =====================================================================================================================
+static PAL_HOST_COPY_TARGET("avx2") void CopyRunFromImageAvx2(
+    uint8*       pDst,
+    const uint8* pSrc,
+    uint32       bytes)
+{
+    if (VoidPtrIsPow2Aligned(pSrc, 16))
+    {
+        for (; bytes >= 16; bytes -= 16, pDst += 16, pSrc += 16)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst),
+                             _mm_stream_load_si128(reinterpret_cast<__m128i*>(const_cast<uint8*>(pSrc))));
+        }
+    }
+
+    CopyRunAvx2(pDst, pSrc, bytes);
+}
+#endif
+
+// =====================================================================================================================
+// Picks the best copy loops the CPU running this process supports.
+HostCopyIsa DetectHostCopyIsa()
+{
+    HostCopyIsa isa = HostCopyIsa::Generic;
+
+#if PAL_HAS_CPUID
+    constexpr uint32 Leaf1EdxSse2    = (1u << 26);
+    constexpr uint32 Leaf1EcxSse41   = (1u << 19);
+    constexpr uint32 Leaf1EcxOsxsave = (1u << 27);
+    constexpr uint32 Leaf1EcxAvx     = (1u << 28);
+    constexpr uint32 Leaf7EbxAvx2    = (1u << 5);
+    constexpr uint32 XcrSseAvxState  = 0x6;
+
+    uint32 leaf0[4] = {};
+    uint32 leaf1[4] = {};
+    uint32 leaf7[4] = {};
+
+    CpuId(leaf0, 0);
+
+    if (leaf0[0] >= 1)
+    {
+        CpuId(leaf1, 1);
+    }
+
+    if (leaf0[0] >= 7)
+    {
+        CpuId(leaf7, 7, 0);
+    }
+
+    // AVX state must also be enabled by the OS, which XGETBV reports once OSXSAVE is set.
+    bool osSavesAvx = false;
+
+    if (TestAllFlagsSet(leaf1[2], Leaf1EcxOsxsave | Leaf1EcxAvx))
+    {
+        uint32 xcr0Lo = 0;
+        uint32 xcr0Hi = 0;
+
+        __asm__ volatile ("xgetbv" : "=a" (xcr0Lo), "=d" (xcr0Hi) : "c" (0));
+
+        osSavesAvx = TestAllFlagsSet(xcr0Lo, XcrSseAvxState);
+    }
+
+    if (osSavesAvx && TestAnyFlagSet(leaf7[1], Leaf7EbxAvx2))
+    {
+        isa = HostCopyIsa::Avx2;
+    }
+    else if (TestAnyFlagSet(leaf1[2], Leaf1EcxSse41))
+    {
+        isa = HostCopyIsa::Sse41;
+    }
+    else if (TestAnyFlagSet(leaf1[3], Leaf1EdxSse2))
+    {
+        isa = HostCopyIsa::Sse2;
+    }
+#endif
+
+    return isa;
+}
+
+// =====================================================================================================================
+// Copies one slice of a linear subresource, a row at a time.
+static void ExecuteLinearJob(
+    const HostCopyJob& job,
+    bool               toImage,
+    HostCopyRunFunc    pfnCopyRun)
+{
+    const uint32 rowBytes  = (job.width << job.elemLog2);
+    uint8*       pImageRow = job.pImage + job.sliceOffset + (job.y * job.imageRowPitch) + (job.x << job.elemLog2);
+    uint8*       pHostRow  = job.pHost;
+
+    for (uint32 row = 0; row < job.height; ++row)
+    {
+        if (toImage)
+        {
+            pfnCopyRun(pImageRow, pHostRow, rowBytes);
+        }
+        else
+        {
+            pfnCopyRun(pHostRow, pImageRow, rowBytes);
+        }
+
+        pImageRow += job.imageRowPitch;
+        pHostRow  += job.hostRowPitch;
+    }
+}
+
+// =====================================================================================================================
+// Copies one slice of a swizzled subresource.  Each row is walked in runs of (1 << runLog2) bytes which are contiguous
+// in both layouts; since the equation is linear over XOR, moving from one run to the next only needs the masks of the x
+// bits that changed, so no element is ever addressed on its own.
+static void ExecuteTiledJob(
+    const HostCopyJob& job,
+    bool               toImage,
+    HostCopyRunFunc    pfnCopyRun)
+{
+    const HostCopyEquation& eq = *job.pEq;
+
+    const uint32 runBytes    = (1u << eq.runLog2);
+    const uint32 runMask     = (runBytes - 1);
+    const uint32 xStartBytes = ((job.x + job.tailX) << job.elemLog2);
+    const uint32 xEndBytes   = ((job.x + job.tailX + job.width) << job.elemLog2);
+    const uint32 xStartEq    = XorMasks(eq.xMasks, xStartBytes);
+    const uint32 sliceEq     = XorMasks(eq.zMasks, job.z) ^ job.pipeBankXor;
+
+    uint8*const pSlice   = job.pImage + job.sliceOffset;
+    uint8*      pHostRow = job.pHost;
+
+    for (uint32 y = job.y; y < (job.y + job.height); ++y)
+    {
+        const uint32 rowEq    = XorMasks(eq.yMasks, y + job.tailY) ^ sliceEq;
+        uint8*const  pRowBase = pSlice + ((gpusize(y >> job.blockHeightLog2) * job.pitchInBlocks) << job.blockLog2);
+
+        uint8* pHost  = pHostRow;
+        uint32 xBytes = xStartBytes;
+        uint32 xEq    = xStartEq;
+
+        while (xBytes < xEndBytes)
+        {
+            const uint32 bytes      = Min(runBytes - (xBytes & runMask), xEndBytes - xBytes);
+            const uint32 x          = (xBytes >> job.elemLog2) - job.tailX;
+            uint8*const  pImage     = pRowBase + (gpusize(x >> job.blockWidthLog2) << job.blockLog2) + (xEq ^ rowEq);
+            const uint32 nextXBytes = xBytes + bytes;
+
+            if (toImage)
+            {
+                pfnCopyRun(pImage, pHost, bytes);
+            }
+            else
+            {
+                pfnCopyRun(pHost, pImage, bytes);
+            }
+
+            xEq   ^= XorMasks(eq.xMasks, xBytes ^ nextXBytes);
+            xBytes = nextXBytes;
+            pHost += bytes;
+        }
+
+        pHostRow += job.hostRowPitch;
+    }
+}
+
+// Shared state for the threads working through a list of jobs.
+struct HostCopyQueue
+{
+    const HostCopyJob*  pJobs;
+    uint32              jobCount;
+    bool                toImage;
+    HostCopyRunFunc     pfnCopyRun;
+    std::atomic<uint32> nextJob;
+};
+
+// =====================================================================================================================
+// Thread entry point: claims and executes jobs until none are left.
+static void DrainHostCopyQueue(
+    void* pParam)
+{
+    HostCopyQueue*const pQueue = static_cast<HostCopyQueue*>(pParam);
+
+    for (uint32 idx = pQueue->nextJob.fetch_add(1, std::memory_order_relaxed);
+         idx < pQueue->jobCount;
+         idx = pQueue->nextJob.fetch_add(1, std::memory_order_relaxed))
+    {
+        const HostCopyJob& job = pQueue->pJobs[idx];
+
+        if (job.pEq != nullptr)
+        {
+            ExecuteTiledJob(job, pQueue->toImage, pQueue->pfnCopyRun);
+        }
+        else
+        {
+            ExecuteLinearJob(job, pQueue->toImage, pQueue->pfnCopyRun);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Executes a list of jobs using up to numThreads threads, one of which is the calling thread.
+void ExecuteHostCopyJobs(
+    const HostCopyJob* pJobs,
+    uint32             jobCount,
+    uint32             numThreads,
+    HostCopyIsa        isa,
+    bool               toImage)
+{
+    HostCopyQueue queue;
+    queue.pJobs      = pJobs;
+    queue.jobCount   = jobCount;
+    queue.toImage    = toImage;
+    queue.pfnCopyRun = &CopyRunGeneric;
+    queue.nextJob.store(0, std::memory_order_relaxed);
+
+#if PAL_HAS_CPUID
+    switch (isa)
+    {
+    case HostCopyIsa::Avx2:
+        queue.pfnCopyRun = toImage ? &CopyRunAvx2 : &CopyRunFromImageAvx2;
+        break;
+    case HostCopyIsa::Sse41:
+        queue.pfnCopyRun = toImage ? &CopyRunSse2 : &CopyRunFromImageSse41;
+        break;
+    case HostCopyIsa::Sse2:
+        queue.pfnCopyRun = &CopyRunSse2;
+        break;
+    default:
+        break;
+    }
+#endif
+
+    Thread       helpers[MaxHostCopyThreads - 1];
+    const uint32 numHelpers = (Min(Max(numThreads, 1u), jobCount, MaxHostCopyThreads) - 1);
+
+    for (uint32 idx = 0; idx < numHelpers; ++idx)
+    {
+        // If a helper can't be started the remaining jobs simply land on the threads which did start.
+        if (helpers[idx].Begin(&DrainHostCopyQueue, &queue) != Result::Success)
+        {
+            break;
+        }
+    }
+
+    DrainHostCopyQueue(&queue);
+
+    for (uint32 idx = 0; idx < numHelpers; ++idx)
+    {
+        helpers[idx].Join();
+    }
+}
+
+// =====================================================================================================================
+// Precomputes the CPU form of every AddrLib swizzle equation used by host image copies.
+Result AddrMgr2::InitHostCopyEquations()
+{
+    Result result = Result::Success;
+
+    // Only the GFX10+ addressing scheme (a single pipe/bank XOR applied within each block) is modeled here.
+    if (IsGfx10Plus(m_gfxLevel) && (NumSwizzleEquations() > 0) && (AddrLibEquations() != nullptr))
+    {
+        m_pHostCopyEqs = PAL_NEW_ARRAY(HostCopyEquation,
+                                       NumSwizzleEquations(),
+                                       m_pDevice->GetPlatform(),
+                                       SystemAllocType::AllocInternal);
+
+        if (m_pHostCopyEqs != nullptr)
+        {
+            m_supportsHostCopy = true;
+
+            for (uint32 idx = 0; idx < NumSwizzleEquations(); ++idx)
+            {
+                BuildHostCopyEquation(AddrLibEquations()[idx], &m_pHostCopyEqs[idx]);
+
+                m_supportsHostCopy &= m_pHostCopyEqs[idx].valid;
+            }
+
+            m_hostCopyIsa = DetectHostCopyIsa();
+        }
+        else
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+    }
+
+    return result;
+}
+
+#if PAL_ENABLE_PRINTS_ASSERTS
+// =====================================================================================================================
+// Cross-checks a finished tiled job against AddrLib's per-element addressing. Every element's offset relative to the
+// job's first element must match what Addr2ComputeSurfaceAddrFromCoord() reports, and the image memory at that offset
+// must hold the same bytes as the element in host memory. Returns false on the first mismatch.
+bool AddrMgr2::ValidateHostCopyJob(
+    const Image&       image,
+    const void*        pImageData,
+    const HostCopyJob& job
+    ) const
+{
+    // Jobs larger than this are checked on a sparse grid of rows and columns instead, which keeps debug builds usable
+    // for large uploads. The stride is prime so it doesn't line up with any swizzle pattern.
+    constexpr uint32 MaxFullyCheckedElements = (1u << 20);
+    constexpr uint32 SparseStride            = 61;
+
+    const ImageCreateInfo&      createInfo  = image.GetImageCreateInfo();
+    const SubresId              baseSubres  = { job.subres.plane, 0, 0 };
+    const SubResourceInfo*const pSubRes     = image.SubresourceInfo(job.subres);
+    const SubResourceInfo*const pBaseSubRes = image.SubresourceInfo(baseSubres);
+
+    ADDR2_COMPUTE_SURFACE_ADDRFROMCOORD_INPUT input = {};
+    input.size            = sizeof(input);
+    input.slice           = job.slice;
+    input.mipId           = job.subres.mipLevel;
+    input.swizzleMode     = static_cast<AddrSwizzleMode>(image.GetGfxImage()->GetSwTileMode(pSubRes));
+    input.flags           = DetermineSurfaceFlags(image, job.subres.plane, false);
+    input.resourceType    = GetAddrResourceType(&image);
+    input.bpp             = pSubRes->bitsPerTexel;
+    input.unalignedWidth  = pBaseSubRes->extentElements.width;
+    input.unalignedHeight = pBaseSubRes->extentElements.height;
+    input.numSlices       = (createInfo.imageType == ImageType::Tex3d) ? pBaseSubRes->extentElements.depth
+                                                                       : createInfo.arraySize;
+    input.numMipLevels    = createInfo.mipLevels;
+    input.numSamples      = 1;
+    input.numFrags        = 1;
+    input.pipeBankXor     = GetTileInfo(&image, job.subres)->pipeBankXor;
+
+    ADDR2_COMPUTE_SURFACE_ADDRFROMCOORD_OUTPUT output = {};
+    output.size = sizeof(output);
+
+    input.x = job.x;
+    input.y = job.y;
+
+    bool matches = (Addr2ComputeSurfaceAddrFromCoord(AddrLibHandle(), &input, &output) == ADDR_OK);
+
+    const uint64   firstAddr   = output.addr;
+    const gpusize  firstOffset = ComputeHostCopyElementOffset(job, job.x, job.y);
+    const uint32   elemBytes   = (1u << job.elemLog2);
+    const bool     sparse      = ((uint64(job.width) * job.height) > MaxFullyCheckedElements);
+    const uint8*   pImage      = static_cast<const uint8*>(pImageData);
+
+    for (uint32 y = 0; matches && (y < job.height); ++y)
+    {
+        const bool denseRow = ((sparse == false) || ((y % SparseStride) == 0) || (y == (job.height - 1)));
+
+        for (uint32 x = 0; matches && (x < job.width); x += (denseRow ? 1 : SparseStride))
+        {
+            input.x = job.x + x;
+            input.y = job.y + y;
+
+            matches = (Addr2ComputeSurfaceAddrFromCoord(AddrLibHandle(), &input, &output) == ADDR_OK);
+
+            if (matches)
+            {
+                const gpusize offset      = ComputeHostCopyElementOffset(job, input.x, input.y);
+                const gpusize addrLibDiff = (output.addr - firstAddr);
+                const uint8*  pHostElem   = job.pHost + (y * job.hostRowPitch) + (x << job.elemLog2);
+                const uint8*  pImageElem  = job.pImage + firstOffset + addrLibDiff;
+
+                matches = ((offset - firstOffset) == addrLibDiff) &&
+                          (VoidPtrDiff(pImageElem, pImage) + elemBytes <= image.GetGpuMemSize()) &&
+                          (memcmp(pImageElem, pHostElem, elemBytes) == 0);
+
+                PAL_ALERT_MSG(matches == false,
+                              "Host copy of mip %u slice %u disagrees with AddrLib at (%u, %u)",
+                              job.subres.mipLevel, job.slice, input.x, input.y);
+            }
+        }
+    }
+
+    return matches;
+}
+#endif
+
+// =====================================================================================================================
+// Copies texels between host memory and a CPU mapping of an Image.  Each region is broken into per-slice jobs which are
+// then spread across threads; mips and slices never share blocks, so the jobs can run in any order.
+Result AddrMgr2::CopyHostImage(
+    const Image&               image,
+    void*                      pImageData,
+    uint32                     regionCount,
+    const HostImageCopyRegion* pRegions,
+    uint32                     maxThreads,
+    bool                       toImage
+    ) const
+{
+    const ImageCreateInfo& createInfo = image.GetImageCreateInfo();
+    const bool             is3d       = (createInfo.imageType == ImageType::Tex3d);
+
+    Result result = (m_pHostCopyEqs != nullptr) ? Result::Success : Result::ErrorUnavailable;
+
+    uint32 jobCount = 0;
+    for (uint32 idx = 0; idx < regionCount; ++idx)
+    {
+        jobCount += is3d ? pRegions[idx].imageExtent.depth : pRegions[idx].numSlices;
+    }
+
+    AutoBuffer<HostCopyJob, 16, Platform> jobs(jobCount, m_pDevice->GetPlatform());
+
+    if (jobs.Capacity() < jobCount)
+    {
+        result = Result::ErrorOutOfMemory;
+    }
+
+    uint32  jobIdx     = 0;
+    gpusize totalBytes = 0;
+
+    for (uint32 regionIdx = 0; (regionIdx < regionCount) && (result == Result::Success); ++regionIdx)
+    {
+        const HostImageCopyRegion& region = pRegions[regionIdx];
+        const SubresId&            subres = region.imageSubres;
+
+        if ((subres.plane >= image.GetImageInfo().numPlanes) ||
+            (subres.mipLevel >= createInfo.mipLevels)        ||
+            (is3d ? (subres.arraySlice != 0)
+                  : ((subres.arraySlice + region.numSlices) > createInfo.arraySize)))
+        {
+            result = Result::ErrorInvalidValue;
+            break;
+        }
+
+        const SubResourceInfo*const pBaseSubRes = image.SubresourceInfo(subres);
+        const ChNumFormat           format      = pBaseSubRes->format.format;
+        const uint32                elemBytes   = (pBaseSubRes->bitsPerTexel >> 3);
+
+        Offset3d offset = region.imageOffset;
+        Extent3d extent = region.imageExtent;
+
+        if (Formats::IsBlockCompressed(format))
+        {
+            const Extent3d blockDim = Formats::CompressedBlockDim(format);
+
+            offset.x      /= blockDim.width;
+            offset.y      /= blockDim.height;
+            extent.width   = RoundUpQuotient(extent.width,  blockDim.width);
+            extent.height  = RoundUpQuotient(extent.height, blockDim.height);
+        }
+        else if ((pBaseSubRes->extentElements.width  != pBaseSubRes->extentTexels.width) ||
+                 (pBaseSubRes->extentElements.height != pBaseSubRes->extentTexels.height))
+        {
+            // Expanded and macro-pixel-packed formats don't map texels onto elements one to one.
+            result = Result::ErrorUnavailable;
+            break;
+        }
+
+        if ((IsPowerOfTwo(elemBytes) == false) ||
+            (offset.x < 0) || (offset.y < 0) || (offset.z < 0) ||
+            ((offset.x + extent.width)  > pBaseSubRes->extentElements.width)  ||
+            ((offset.y + extent.height) > pBaseSubRes->extentElements.height) ||
+            (is3d && ((offset.z + extent.depth) > pBaseSubRes->extentElements.depth)))
+        {
+            result = (IsPowerOfTwo(elemBytes) == false) ? Result::ErrorUnavailable : Result::ErrorInvalidValue;
+            break;
+        }
+
+        const uint32 numLayers = is3d ? extent.depth : region.numSlices;
+
+        for (uint32 layer = 0; layer < numLayers; ++layer)
+        {
+            SubresId sliceSubres = subres;
+            sliceSubres.arraySlice += is3d ? 0 : layer;
+
+            const SubResourceInfo*const pSubRes = image.SubresourceInfo(sliceSubres);
+            const uint32                z       = is3d ? (offset.z + layer) : 0;
+            const uint32                eqIdx   = pSubRes->swizzleEqIndex;
+
+            HostCopyJob*const pJob = &jobs[jobIdx++];
+            memset(pJob, 0, sizeof(*pJob));
+
+            pJob->pHost        = static_cast<uint8*>(VoidPtrInc(region.pHostMemory,
+                                                                static_cast<size_t>(layer * region.hostDepthPitch)));
+            pJob->hostRowPitch = region.hostRowPitch;
+            pJob->x            = offset.x;
+            pJob->y            = offset.y;
+            pJob->width        = extent.width;
+            pJob->height       = extent.height;
+            pJob->elemLog2     = Log2(elemBytes);
+
+            if (eqIdx == LinearSwizzleEqIndex)
+            {
+                pJob->pImage        = static_cast<uint8*>(VoidPtrInc(pImageData, static_cast<size_t>(pSubRes->offset)));
+                pJob->imageRowPitch = pSubRes->rowPitch;
+                pJob->sliceOffset   = z * pSubRes->depthPitch;
+            }
+            else if ((eqIdx < NumSwizzleEquations()) && m_pHostCopyEqs[eqIdx].valid)
+            {
+                // AddrLib always maps the low offset bits of an element straight onto its bytes, so every run covers
+                // at least one whole element.  SupportsHostImageCopy() relies on this.
+                PAL_ASSERT(m_pHostCopyEqs[eqIdx].runLog2 >= pJob->elemLog2);
+
+                const Extent3d& blockSize  = pSubRes->blockSize;
+                const uint32    blockBytes = (blockSize.width * blockSize.height * blockSize.depth) << pJob->elemLog2;
+                const gpusize   blockBase  = Pow2AlignDown(pSubRes->offset, gpusize(blockBytes));
+                const uint32    depthLog2  = Log2(blockSize.depth);
+
+                pJob->pEq             = &m_pHostCopyEqs[eqIdx];
+                pJob->pImage          = static_cast<uint8*>(VoidPtrInc(pImageData, static_cast<size_t>(blockBase)));
+                pJob->sliceOffset     = (gpusize(z >> depthLog2) << depthLog2) * pSubRes->depthPitch;
+                pJob->z               = (is3d ? z : sliceSubres.arraySlice) + pSubRes->mipTailCoord.z;
+                pJob->tailX           = pSubRes->mipTailCoord.x;
+                pJob->tailY           = pSubRes->mipTailCoord.y;
+                pJob->blockLog2       = Log2(blockBytes);
+                pJob->blockWidthLog2  = Log2(blockSize.width);
+                pJob->blockHeightLog2 = Log2(blockSize.height);
+                pJob->pitchInBlocks   = (pSubRes->actualExtentElements.width >> pJob->blockWidthLog2);
+
+                // The pipe/bank XOR is programmed in units of 256 bytes and only ever touches bits within a block.
+                pJob->pipeBankXor = (GetTileInfo(&image, sliceSubres)->pipeBankXor << 8) & (blockBytes - 1);
+
+#if PAL_ENABLE_PRINTS_ASSERTS
+                pJob->subres = sliceSubres;
+                pJob->slice  = (is3d ? z : sliceSubres.arraySlice);
+#endif
+            }
+            else
+            {
+                result = Result::ErrorUnavailable;
+                break;
+            }
+
+            totalBytes += (gpusize(extent.width * extent.height) << pJob->elemLog2);
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        const gpusize threadsForSize = Max<gpusize>(totalBytes / MinHostCopyBytesPerThread, 1);
+        const uint32  numThreads     = static_cast<uint32>(Min<gpusize>(Max(maxThreads, 1u), threadsForSize));
+
+        ExecuteHostCopyJobs(jobs.Data(), jobCount, numThreads, m_hostCopyIsa, toImage);
+
+#if PAL_ENABLE_PRINTS_ASSERTS
+        // A mismatch is also reported through the result, so that tests exercising the engine see it even when alerts
+        // don't break into a debugger.
+        for (uint32 idx = 0; (idx < jobCount) && (result == Result::Success); ++idx)
+        {
+            if ((jobs[idx].pEq != nullptr) && (ValidateHostCopyJob(image, pImageData, jobs[idx]) == false))
+            {
+                result = Result::ErrorUnknown;
+            }
+        }
+#endif
+    }
+
+    return result;
+}
+
+} // AddrMgr2
+} // Pal
@@ -0,0 +1,119 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "addrinterface.h"
+#include "palImage.h"
+
+namespace Pal
+{
+namespace AddrMgr2
+{
+
+// AddrLib channel settings index coordinate bits with a 5-bit field.
+constexpr uint32 HostCopyCoordBits = 32;
+
+// Upper bound on the number of CPU threads a single host image copy will use.
+constexpr uint32 MaxHostCopyThreads = 8;
+
+// Instruction set extensions the copy loops can use. These are picked once from CPUID, since PAL itself is built for the
+// baseline ISA.
+enum class HostCopyIsa : uint32
+{
+    Generic = 0, // Plain memcpy.
+    Sse2,        // 16-byte loads and stores.
+    Sse41,       // SSE2, plus streaming loads out of write-combined memory.
+    Avx2,        // 32-byte loads and stores, plus SSE4.1 streaming loads.
+};
+
+// An AddrLib swizzle equation reshaped for CPU addressing. Every bit of a swizzle equation is an XOR of coordinate
+// bits, so the offset of an element within its block is the XOR of one mask per set coordinate bit. AddrMgr2 builds one
+// of these for each AddrLib equation, i.e., once per (resource type, swizzle mode, element size).
+struct HostCopyEquation
+{
+    uint32 xMasks[HostCopyCoordBits]; // Block offset bits toggled by each bit of the x coordinate (in bytes).
+    uint32 yMasks[HostCopyCoordBits]; // Block offset bits toggled by each bit of the y coordinate.
+    uint32 zMasks[HostCopyCoordBits]; // Block offset bits toggled by each bit of the z coordinate.
+    uint32 runLog2;                   // Log2 of the number of bytes, starting at an aligned x, which are contiguous in
+                                      // both the swizzled and the linear layout.
+    bool   valid;                     // False if the masks can't describe the equation (it stacks depth slices).
+};
+
+// One slice of a host image copy region. Regions are split into one job per array or depth slice so that the work can
+// be spread across threads; jobs never overlap in image memory.
+struct HostCopyJob
+{
+    const HostCopyEquation* pEq;            // Swizzle equation, or null if the subresource is linear.
+    uint8*                  pImage;         // Tiled: the subresource's first block.  Linear: the subresource itself.
+    uint8*                  pHost;          // First texel of this slice in host memory.
+    gpusize                 hostRowPitch;   // Bytes between consecutive rows in host memory.
+    gpusize                 imageRowPitch;  // Bytes between consecutive rows of a linear subresource.
+    gpusize                 sliceOffset;    // Offset from pImage to this slice (tiled: to its slab of blocks).
+    uint32                  x;              // Region origin, in elements.
+    uint32                  y;
+    uint32                  z;              // Slice coordinate fed to the swizzle equation.
+    uint32                  width;          // Region size, in elements.
+    uint32                  height;
+    uint32                  tailX;          // Mip tail coordinates of the subresource, in elements.
+    uint32                  tailY;
+    uint32                  elemLog2;       // Log2 of the bytes per element.
+    uint32                  blockLog2;      // Log2 of the bytes per swizzle block.
+    uint32                  blockWidthLog2; // Log2 of the swizzle block dimensions, in elements.
+    uint32                  blockHeightLog2;
+    uint32                  pitchInBlocks;  // Padded subresource width, in swizzle blocks.
+    uint32                  pipeBankXor;    // Pipe/bank XOR already shifted into block offset bits.
+#if PAL_ENABLE_PRINTS_ASSERTS
+    SubresId                subres;         // Subresource and AddrLib slice of this job, for validation.
+    uint32                  slice;
+#endif
+};
+
+extern HostCopyIsa DetectHostCopyIsa();
+
+extern void BuildHostCopyEquation(
+    const ADDR_EQUATION& addrEq,
+    HostCopyEquation*    pEq);
+
+extern uint32 ComputeHostCopyBlockOffset(
+    const HostCopyEquation& eq,
+    uint32                  xInBytes,
+    uint32                  y,
+    uint32                  z);
+
+extern gpusize ComputeHostCopyElementOffset(
+    const HostCopyJob& job,
+    uint32             x,
+    uint32             y);
+
+extern void ExecuteHostCopyJobs(
+    const HostCopyJob* pJobs,
+    uint32             jobCount,
+    uint32             numThreads,
+    HostCopyIsa        isa,
+    bool               toImage);
+
+} // AddrMgr2
+} // Pal
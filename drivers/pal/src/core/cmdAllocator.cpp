@@ -35,6 +35,7 @@
 #include "palLiterals.h"
 #include "eventDefs.h"
 
+#include <atomic>
 #include <limits.h>
 
 using namespace Util;
@@ -43,13 +44,47 @@ using namespace Util::Literals;
 namespace Pal
 {
 
+// Thread-safe allocators keep this many per-thread magazines. Threads are spread over them round-robin, so more threads
+// than this will share magazines, which is still correct but may contend on the magazine locks.
+constexpr uint32 NumMagazines = 16;
+
+// Each magazine holds at most this many chunks per allocation type and this many linear allocators. When a magazine
+// runs dry it takes up to half of its capacity from the shared lists in one trip.
+constexpr uint32 MagazineChunkCapacity       = 8;
+constexpr uint32 MagazineLinearAllocCapacity = 4;
+
+constexpr size_t MagazineAlignment = 64;
+
+// =====================================================================================================================
+// A per-thread cache of idle chunks and linear allocators. Every chunk and allocator in here is still on the matching
+// busy list. The lock is only contended when Reset() or Trim() reclaims the magazine contents, or when more than
+// NumMagazines threads record at once.
+struct alignas(MagazineAlignment) CmdAllocator::Magazine
+{
+    Mutex                            lock;
+    uint32                           chunkCount[CmdAllocatorTypeCount];
+    CmdStreamChunk*                  pChunks[CmdAllocatorTypeCount][MagazineChunkCapacity];
+    uint32                           linearAllocCount;
+    VirtualLinearAllocatorWithNode*  pLinearAllocs[MagazineLinearAllocCapacity];
+};
+
 // =====================================================================================================================
-// Determines how much space is required to hold a CmdAllocator and its optional Mutex.
+// Returns a small index for the calling thread which is assigned the first time the thread asks for it.
+static uint32 CurrentThreadIndex()
+{
+    static std::atomic<uint32> s_nextThreadIndex(0);
+    thread_local const uint32  t_threadIndex = s_nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+
+    return t_threadIndex;
+}
+
+// =====================================================================================================================
+// Determines how much space is required to hold a CmdAllocator and its optional thread-safety state.
 size_t CmdAllocator::GetSize(
     const CmdAllocatorCreateInfo& createInfo,
     Result*                       pResult)    // [optional] The additional validation result is stored here.
 {
-    // We need extra space for two Mutex objects if the allocator is thread safe.
+    // We need extra placement space for the Mutex objects and magazines if the allocator is thread safe.
     size_t size = sizeof(CmdAllocator) + GetPlacementSize(createInfo);
 
     // Validate the createInfo if requested.
@@ -86,8 +121,10 @@ size_t CmdAllocator::GetSize(
 size_t CmdAllocator::GetPlacementSize(
     const CmdAllocatorCreateInfo& createInfo)
 {
-    // We need extra space for two Mutex objects if the allocator is thread safe.
-    return createInfo.flags.threadSafe ? (2 * sizeof(Mutex)) : 0;
+    // We need extra space for two Mutex objects and the per-thread magazines if the allocator is thread safe.
+    return createInfo.flags.threadSafe
+           ? ((2 * sizeof(Mutex)) + (NumMagazines * sizeof(Magazine)) + MagazineAlignment - 1)
+           : 0;
 }
 
 // =====================================================================================================================
@@ -99,6 +136,7 @@ CmdAllocator::CmdAllocator(
     m_pChunkLock(nullptr),
     m_lastPagingFence(0),
     m_pLinearAllocLock(nullptr),
+    m_pMagazines(nullptr),
     m_pDummyChunkAllocation(nullptr),
     m_pPlatform(pDevice->GetPlatform())
 {
@@ -273,6 +311,16 @@ CmdAllocator::~CmdAllocator()
         m_pLinearAllocLock = nullptr;
     }
 
+    if (m_pMagazines != nullptr)
+    {
+        for (uint32 idx = 0; idx < NumMagazines; ++idx)
+        {
+            m_pMagazines[idx].~Magazine();
+        }
+
+        m_pMagazines = nullptr;
+    }
+
     FreeAllChunks(m_pPlatform->IsSubAllocTrackingEnabled());
     FreeAllLinearAllocators();
 
@@ -420,6 +468,20 @@ Result CmdAllocator::Init(
     {
         m_pChunkLock = PAL_PLACEMENT_NEW(pPlacementAddr) Mutex();
         m_pLinearAllocLock = PAL_PLACEMENT_NEW(m_pChunkLock + 1) Mutex();
+
+        // The magazines skip the suballocation callbacks, so they're only used if nobody is tracking suballocations.
+        if (m_pPlatform->IsSubAllocTrackingEnabled() == false)
+        {
+            m_pMagazines = static_cast<Magazine*>(VoidPtrAlign(m_pLinearAllocLock + 1, MagazineAlignment));
+
+            for (uint32 idx = 0; idx < NumMagazines; ++idx)
+            {
+                Magazine*const pMagazine = PAL_PLACEMENT_NEW(m_pMagazines + idx) Magazine();
+
+                memset(pMagazine->chunkCount, 0, sizeof(pMagazine->chunkCount));
+                pMagazine->linearAllocCount = 0;
+            }
+        }
     }
 
 #if PAL_ENABLE_PRINTS_ASSERTS
@@ -474,6 +536,19 @@ Result CmdAllocator::Reset(
 {
     const bool trackSuballocations = m_pPlatform->IsSubAllocTrackingEnabled();
 
+    // Everything in the magazines is also on a busy list, so we reclaim it below by simply forgetting about it. The
+    // magazine locks must be taken before the shared locks.
+    LockMagazines();
+
+    if (m_pMagazines != nullptr)
+    {
+        for (uint32 idx = 0; idx < NumMagazines; ++idx)
+        {
+            memset(m_pMagazines[idx].chunkCount, 0, sizeof(m_pMagazines[idx].chunkCount));
+            m_pMagazines[idx].linearAllocCount = 0;
+        }
+    }
+
     if (m_pChunkLock != nullptr)
     {
         m_pChunkLock->Lock();
@@ -529,6 +604,8 @@ Result CmdAllocator::Reset(
         m_pLinearAllocLock->Unlock();
     }
 
+    UnlockMagazines();
+
     return Result::Success;
 }
 
@@ -540,6 +617,8 @@ Result CmdAllocator::Trim(
 {
     Result result = Result::Success;
 
+    LockMagazines();
+
     if (m_pChunkLock != nullptr)
     {
         m_pChunkLock->Lock();
@@ -551,6 +630,9 @@ Result CmdAllocator::Trim(
         {
             CmdAllocInfo* const pAllocInfo = &m_gpuAllocInfo[type];
 
+            // Chunks hoarded by the magazines are idle, give them back so that they can be trimmed.
+            ReturnMagazineChunks(static_cast<CmdAllocType>(type));
+
             if (pAllocInfo->freeList.NumElements() > dynamicThreshold * pAllocInfo->allocCreateInfo.numChunks)
             {
                 result = TrimMemory(pAllocInfo, dynamicThreshold);
@@ -568,6 +650,8 @@ Result CmdAllocator::Trim(
         m_pChunkLock->Unlock();
     }
 
+    UnlockMagazines();
+
     return result;
 }
 
@@ -713,7 +797,16 @@ void CmdAllocator::ReuseChunks(
     // System memory allocations are only allowed for command data!
     PAL_ASSERT((systemMemory == false) || (allocType == CommandDataAlloc));
 
-    if (AutomaticMemoryReuse())
+    // If the root chunk is idle, we can push all the chunks to the free list.
+    const bool rootIsIdle = AutomaticMemoryReuse() && iter.Get()->IsIdleOnGpu();
+
+    // Idle chunks go to this thread's magazine first; anything that doesn't fit falls back to the shared lists.
+    if (rootIsIdle && UseMagazines(systemMemory))
+    {
+        StashChunks(allocType, &iter);
+    }
+
+    if (AutomaticMemoryReuse() && iter.IsValid())
     {
         // If necessary, engage the chunk lock.
         if (m_pChunkLock != nullptr)
@@ -724,8 +817,7 @@ void CmdAllocator::ReuseChunks(
         auto*const pAllocInfo = (systemMemory ? &m_sysAllocInfo : &m_gpuAllocInfo[allocType]);
         const bool trackSuballocations = (systemMemory == false) && m_pPlatform->IsSubAllocTrackingEnabled();
 
-        // If the root chunk is idle, we can push all the chunks to the free list.
-        if (iter.Get()->IsIdleOnGpu())
+        if (rootIsIdle)
         {
             while (iter.IsValid())
             {
@@ -793,17 +885,65 @@ Result CmdAllocator::GetNewChunk(
     // System memory allocations are only allowed for command data!
     PAL_ASSERT((systemMemory == false) || (allocType == CommandDataAlloc));
 
-    // If necessary, engage the chunk lock while we search for a free chunk.
-    if (m_pChunkLock != nullptr)
+    Result result = Result::Success;
+
+    if (UseMagazines(systemMemory))
     {
-        m_pChunkLock->Lock();
-    }
+        Magazine*const pMagazine = CurrentMagazine();
+        uint32*const   pCount    = &pMagazine->chunkCount[allocType];
 
-    Result result = FindFreeChunk(systemMemory, systemMemory ? &m_sysAllocInfo : &m_gpuAllocInfo[allocType], ppChunk);
+        pMagazine->lock.Lock();
 
-    if (m_pChunkLock != nullptr)
+        if (*pCount > 0)
+        {
+            CmdStreamChunk*const pChunk = pMagazine->pChunks[allocType][--(*pCount)];
+            PAL_ASSERT(pChunk->IsIdleOnGpu());
+
+            pChunk->Reset();
+            *ppChunk = pChunk;
+        }
+        else
+        {
+            CmdAllocInfo*const pAllocInfo = &m_gpuAllocInfo[allocType];
+
+            m_pChunkLock->Lock();
+
+            result = FindFreeChunk(false, pAllocInfo, ppChunk);
+
+            // While we hold the chunk lock, refill the magazine with up to half of its capacity so that the next few
+            // calls on this thread don't need the lock. This includes the rest of a newly created allocation.
+            while ((result == Result::Success)                  &&
+                   (*pCount < (MagazineChunkCapacity / 2))      &&
+                   (pAllocInfo->freeList.IsEmpty() == false))
+            {
+                CmdStreamChunk*const pChunk = pAllocInfo->freeList.Back();
+                auto*const           pNode  = pChunk->ListNode();
+
+                pAllocInfo->freeList.Erase(pNode);
+                pAllocInfo->busyList.PushFront(pNode);
+
+                pMagazine->pChunks[allocType][(*pCount)++] = pChunk;
+            }
+
+            m_pChunkLock->Unlock();
+        }
+
+        pMagazine->lock.Unlock();
+    }
+    else
     {
-        m_pChunkLock->Unlock();
+        // If necessary, engage the chunk lock while we search for a free chunk.
+        if (m_pChunkLock != nullptr)
+        {
+            m_pChunkLock->Lock();
+        }
+
+        result = FindFreeChunk(systemMemory, systemMemory ? &m_sysAllocInfo : &m_gpuAllocInfo[allocType], ppChunk);
+
+        if (m_pChunkLock != nullptr)
+        {
+            m_pChunkLock->Unlock();
+        }
     }
 
     return result;
@@ -1021,11 +1161,66 @@ VirtualLinearAllocator* CmdAllocator::GetNewLinearAllocator()
 {
     VirtualLinearAllocatorWithNode* pAllocator = nullptr;
 
-    // If necessary, engage the linear allocator lock.
-    if (m_pLinearAllocLock != nullptr)
+    if (m_pMagazines != nullptr)
     {
-        m_pLinearAllocLock->Lock();
+        Magazine*const pMagazine = CurrentMagazine();
+
+        pMagazine->lock.Lock();
+
+        if (pMagazine->linearAllocCount > 0)
+        {
+            pAllocator = pMagazine->pLinearAllocs[--pMagazine->linearAllocCount];
+        }
+        else
+        {
+            m_pLinearAllocLock->Lock();
+
+            pAllocator = FindFreeLinearAllocator();
+
+            // Refill the magazine with up to half of its capacity while we hold the lock.
+            while ((pAllocator != nullptr)                                             &&
+                   (pMagazine->linearAllocCount < (MagazineLinearAllocCapacity / 2)) &&
+                   (m_linearAllocFreeList.IsEmpty() == false))
+            {
+                VirtualLinearAllocatorWithNode*const pFree = m_linearAllocFreeList.Back();
+                auto*const                           pNode = pFree->GetNode();
+
+                m_linearAllocFreeList.Erase(pNode);
+                m_linearAllocBusyList.PushFront(pNode);
+
+                pMagazine->pLinearAllocs[pMagazine->linearAllocCount++] = pFree;
+            }
+
+            m_pLinearAllocLock->Unlock();
+        }
+
+        pMagazine->lock.Unlock();
     }
+    else
+    {
+        // If necessary, engage the linear allocator lock.
+        if (m_pLinearAllocLock != nullptr)
+        {
+            m_pLinearAllocLock->Lock();
+        }
+
+        pAllocator = FindFreeLinearAllocator();
+
+        if (m_pLinearAllocLock != nullptr)
+        {
+            m_pLinearAllocLock->Unlock();
+        }
+    }
+
+    return pAllocator;
+}
+
+// =====================================================================================================================
+// Pops an allocator off of the free list or creates a new one and moves it to the busy list. The caller must hold the
+// linear allocator lock, if there is one.
+VirtualLinearAllocatorWithNode* CmdAllocator::FindFreeLinearAllocator()
+{
+    VirtualLinearAllocatorWithNode* pAllocator = nullptr;
 
     if (m_linearAllocFreeList.IsEmpty() == false)
     {
@@ -1058,11 +1253,6 @@ VirtualLinearAllocator* CmdAllocator::GetNewLinearAllocator()
         }
     }
 
-    if (m_pLinearAllocLock != nullptr)
-    {
-        m_pLinearAllocLock->Unlock();
-    }
-
     return pAllocator;
 }
 
@@ -1074,20 +1264,122 @@ void CmdAllocator::ReuseLinearAllocator(
     {
         auto*const pAllocator = static_cast<VirtualLinearAllocatorWithNode*>(pReuseAllocator);
         auto*const pNode      = pAllocator->GetNode();
+        bool       stashed    = false;
 
-        // If necessary, engage the linear allocator lock.
-        if (m_pLinearAllocLock != nullptr)
+        // Keep the allocator in this thread's magazine if there's room. It stays on the busy list.
+        if (m_pMagazines != nullptr)
         {
-            m_pLinearAllocLock->Lock();
+            Magazine*const pMagazine = CurrentMagazine();
+
+            pMagazine->lock.Lock();
+
+            if (pMagazine->linearAllocCount < MagazineLinearAllocCapacity)
+            {
+                pMagazine->pLinearAllocs[pMagazine->linearAllocCount++] = pAllocator;
+                stashed = true;
+            }
+
+            pMagazine->lock.Unlock();
         }
 
-        // Remove our allocator from the busy list and add it to the front of the free list.
-        m_linearAllocBusyList.Erase(pNode);
-        m_linearAllocFreeList.PushFront(pNode);
+        if (stashed == false)
+        {
+            // If necessary, engage the linear allocator lock.
+            if (m_pLinearAllocLock != nullptr)
+            {
+                m_pLinearAllocLock->Lock();
+            }
 
-        if (m_pLinearAllocLock != nullptr)
+            // Remove our allocator from the busy list and add it to the front of the free list.
+            m_linearAllocBusyList.Erase(pNode);
+            m_linearAllocFreeList.PushFront(pNode);
+
+            if (m_pLinearAllocLock != nullptr)
+            {
+                m_pLinearAllocLock->Unlock();
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Returns the magazine which belongs to the calling thread.
+CmdAllocator::Magazine* CmdAllocator::CurrentMagazine() const
+{
+    PAL_ASSERT(m_pMagazines != nullptr);
+
+    return &m_pMagazines[CurrentThreadIndex() % NumMagazines];
+}
+
+// =====================================================================================================================
+// Locks every magazine in index order. This must be done before taking the shared chunk or linear allocator locks.
+void CmdAllocator::LockMagazines()
+{
+    if (m_pMagazines != nullptr)
+    {
+        for (uint32 idx = 0; idx < NumMagazines; ++idx)
         {
-            m_pLinearAllocLock->Unlock();
+            m_pMagazines[idx].lock.Lock();
+        }
+    }
+}
+
+// =====================================================================================================================
+void CmdAllocator::UnlockMagazines()
+{
+    if (m_pMagazines != nullptr)
+    {
+        for (uint32 idx = NumMagazines; idx > 0; --idx)
+        {
+            m_pMagazines[idx - 1].lock.Unlock();
+        }
+    }
+}
+
+// =====================================================================================================================
+// Moves idle chunks from the iterator into the calling thread's magazine until it is full. The iterator is left on the
+// first chunk that didn't fit, if any.
+void CmdAllocator::StashChunks(
+    CmdAllocType allocType,
+    VectorIter*  pIter)
+{
+    Magazine*const pMagazine = CurrentMagazine();
+    uint32*const   pCount    = &pMagazine->chunkCount[allocType];
+
+    pMagazine->lock.Lock();
+
+    while (pIter->IsValid() && (*pCount < MagazineChunkCapacity))
+    {
+        pMagazine->pChunks[allocType][(*pCount)++] = pIter->Get();
+        pIter->Next();
+    }
+
+    pMagazine->lock.Unlock();
+}
+
+// =====================================================================================================================
+// Empties the given chunk type out of every magazine and moves those chunks from the busy list to the free list. The
+// caller must hold all magazine locks and the chunk lock.
+void CmdAllocator::ReturnMagazineChunks(
+    CmdAllocType allocType)
+{
+    if (m_pMagazines != nullptr)
+    {
+        CmdAllocInfo*const pAllocInfo = &m_gpuAllocInfo[allocType];
+
+        for (uint32 idx = 0; idx < NumMagazines; ++idx)
+        {
+            Magazine*const pMagazine = &m_pMagazines[idx];
+
+            for (uint32 chunkIdx = 0; chunkIdx < pMagazine->chunkCount[allocType]; ++chunkIdx)
+            {
+                auto*const pNode = pMagazine->pChunks[allocType][chunkIdx]->ListNode();
+
+                pAllocInfo->busyList.Erase(pNode);
+                pAllocInfo->freeList.PushFront(pNode);
+            }
+
+            pMagazine->chunkCount[allocType] = 0;
         }
     }
 }
@@ -133,6 +133,18 @@ private:
 
     void ReportSuballocationEvent(const Developer::CallbackType type, CmdStreamChunk* const pChunk) const;
 
+    // Per-thread caches of idle chunks and linear allocators, only used by thread-safe allocators.
+    struct Magazine;
+
+    Magazine* CurrentMagazine() const;
+    bool UseMagazines(bool systemMemory) const { return (m_pMagazines != nullptr) && (systemMemory == false); }
+    void LockMagazines();
+    void UnlockMagazines();
+    void StashChunks(CmdAllocType allocType, VectorIter* pIter);
+    void ReturnMagazineChunks(CmdAllocType allocType);
+
+    Util::VirtualLinearAllocatorWithNode* FindFreeLinearAllocator();
+
 #if PAL_ENABLE_PRINTS_ASSERTS
     void PrintCommitLog() const;
 #endif
@@ -163,6 +175,10 @@ private:
     LinearAllocList m_linearAllocFreeList; // Unordered list of allocators that are reset and not in use.
     LinearAllocList m_linearAllocBusyList; // Unordered list of allocators that are being used by command buffers.
 
+    // If non-null, an array of NumMagazines per-thread caches. Chunks and linear allocators held by a magazine are
+    // idle but stay on their busy lists; only the owning magazine knows that they can be handed out again.
+    Magazine*       m_pMagazines;
+
 #if PAL_ENABLE_PRINTS_ASSERTS
     // To help us make informed decisions about command stream use, the allocator can build histograms of commit sizes
     // and log them to a csv file on destruction. If we exclude the timer queue (no packets) and include the Constant
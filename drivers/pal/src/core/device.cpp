@@ -2172,6 +2172,7 @@ Result Device::GetProperties(
                 m_chipProperties.imageProperties.flags.supportsAqbsStereoMode;
         pInfo->imageProperties.flags.supportsCornerSampling       =
                 m_chipProperties.imageProperties.flags.supportsCornerSampling;
+        pInfo->imageProperties.flags.supportsHostImageCopy        = m_pAddrMgr->SupportsHostImageCopy();
 
         pInfo->imageProperties.numSwizzleEqs   = m_chipProperties.imageProperties.numSwizzleEqs;
 
@@ -3962,6 +3962,9 @@ void PAL_STDCALL Device::Gfx9CreateUntypedBufferViewSrds(
 
 // =====================================================================================================================
 // Gfx10 specific function for creating untyped buffer view SRDs.
+//
+// Untyped views all share a format and swizzle, so the constant part of the last SRD dword is built once per call and
+// only the OOB select and LLC no-alloc fields are merged in per view.
 void PAL_STDCALL Device::Gfx10CreateUntypedBufferViewSrds(
     const IDevice*        pDevice,
     uint32                count,
@@ -3972,54 +3975,41 @@ void PAL_STDCALL Device::Gfx10CreateUntypedBufferViewSrds(
     const auto*const pPalDevice = static_cast<const Pal::Device*>(pDevice);
     const auto*const pGfxDevice = static_cast<const Device*>(pPalDevice->GetGfxDevice());
 
+    const bool supportsMall = (pPalDevice->MemoryProperties().flags.supportsMall != 0);
+
+    // Everything in the last dword except the OOB select and LLC no-alloc fields.
+    const uint32 word3Base = ((SQ_SEL_X                             << SqBufRsrcTWord3DstSelXShift)                |
+                              (SQ_SEL_Y                             << SqBufRsrcTWord3DstSelYShift)                |
+                              (SQ_SEL_Z                             << SqBufRsrcTWord3DstSelZShift)                |
+                              (SQ_SEL_W                             << SqBufRsrcTWord3DstSelWShift)                |
+                              (BUF_FMT_32_UINT                      << Gfx10CoreSqBufRsrcTWord3FormatShift)        |
+                              (pGfxDevice->BufferSrdResourceLevel() << Gfx10CoreSqBufRsrcTWord3ResourceLevelShift) |
+                              (SQ_RSRC_BUF                          << SqBufRsrcTWord3TypeShift));
+
     sq_buf_rsrc_t* pOutSrd = static_cast<sq_buf_rsrc_t*>(pOut);
 
     for (uint32 idx = 0; idx < count; ++idx)
     {
         PAL_ASSERT((pBufferViewInfo->gpuAddr != 0) || (pBufferViewInfo->range == 0));
-
-        pOutSrd->u32All[0] = LowPart(pBufferViewInfo->gpuAddr);
-
-        pOutSrd->u32All[1] =
-            (HighPart(pBufferViewInfo->gpuAddr) |
-             (static_cast<uint32>(pBufferViewInfo->stride) << SqBufRsrcTWord1StrideShift));
-
-        pOutSrd->u32All[2] = pGfxDevice->CalcNumRecords(static_cast<size_t>(pBufferViewInfo->range),
-                                                        static_cast<uint32>(pBufferViewInfo->stride));
-
         PAL_ASSERT(Formats::IsUndefined(pBufferViewInfo->swizzledFormat.format));
 
-        uint32 llcNoalloc = 0;
+        const uint32 stride    = static_cast<uint32>(pBufferViewInfo->stride);
+        const uint32 oobSelect = ((stride == 1) || (stride == 0)) ? SQ_OOB_COMPLETE : SQ_OOB_INDEX_ONLY;
 
-        if (pPalDevice->MemoryProperties().flags.supportsMall != 0)
-        {
-            // The SRD has a two-bit field where the high-bit is the control for "read" operations
-            // and the low bit is the control for bypassing the MALL on write operations.
-            llcNoalloc = CalcLlcNoalloc(pBufferViewInfo->flags.bypassMallRead,
-                                        pBufferViewInfo->flags.bypassMallWrite);
-        }
-
-        if (pBufferViewInfo->gpuAddr != 0)
-        {
-            const uint32 oobSelect = ((pBufferViewInfo->stride == 1) ||
-                                      (pBufferViewInfo->stride == 0)) ? SQ_OOB_COMPLETE : SQ_OOB_INDEX_ONLY;
+        // The SRD has a two-bit field where the high-bit is the control for "read" operations
+        // and the low bit is the control for bypassing the MALL on write operations.
+        const uint32 llcNoalloc = supportsMall ? CalcLlcNoalloc(pBufferViewInfo->flags.bypassMallRead,
+                                                                pBufferViewInfo->flags.bypassMallWrite) : 0;
 
-            PAL_ASSERT((llcNoalloc == 0) || (IsGfx103PlusExclusive(*pPalDevice)));
+        PAL_ASSERT((llcNoalloc == 0) || (IsGfx103PlusExclusive(*pPalDevice)));
 
-            pOutSrd->u32All[3] = ((SQ_SEL_X                       << SqBufRsrcTWord3DstSelXShift)                       |
-                                  (SQ_SEL_Y                       << SqBufRsrcTWord3DstSelYShift)                       |
-                                  (SQ_SEL_Z                       << SqBufRsrcTWord3DstSelZShift)                       |
-                                  (SQ_SEL_W                       << SqBufRsrcTWord3DstSelWShift)                       |
-                                  (BUF_FMT_32_UINT                << Gfx10CoreSqBufRsrcTWord3FormatShift)               |
-                                  (pGfxDevice->BufferSrdResourceLevel() << Gfx10CoreSqBufRsrcTWord3ResourceLevelShift)  |
-                                  (oobSelect                      << SqBufRsrcTWord3OobSelectShift)                     |
-                                  (llcNoalloc                     << Gfx103PlusExclusiveSqBufRsrcTWord3LlcNoallocShift) |
-                                  (SQ_RSRC_BUF                    << SqBufRsrcTWord3TypeShift));
-        }
-        else
-        {
-            pOutSrd->u32All[3] = 0;
-        }
+        pOutSrd->u32All[0] = LowPart(pBufferViewInfo->gpuAddr);
+        pOutSrd->u32All[1] = (HighPart(pBufferViewInfo->gpuAddr) | (stride << SqBufRsrcTWord1StrideShift));
+        pOutSrd->u32All[2] = CalcNumRecords(static_cast<size_t>(pBufferViewInfo->range), stride);
+        pOutSrd->u32All[3] = (pBufferViewInfo->gpuAddr != 0) ?
+                             (word3Base                                                        |
+                              (oobSelect  << SqBufRsrcTWord3OobSelectShift)                    |
+                              (llcNoalloc << Gfx103PlusExclusiveSqBufRsrcTWord3LlcNoallocShift)) : 0;
 
         pOutSrd++;
         pBufferViewInfo++;
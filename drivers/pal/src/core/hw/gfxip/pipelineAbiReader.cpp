@@ -162,6 +162,8 @@ Result PipelineAbiReader::GetMetadata(
 
         const void* pRawMetadata = nullptr;
         uint32      metadataSize = 0;
+        const void* pDigest      = nullptr;
+        uint32      digestSize   = 0;
 
         ElfReader::Notes notes(m_elfReader, sectionIndex);
         ElfReader::NoteIterator notesEnd = notes.End();
@@ -176,9 +178,12 @@ Result PipelineAbiReader::GetMetadata(
             {
                 pRawMetadata = pDesc;
                 metadataSize = descSize;
-
-                result = PalAbi::GetPalMetadataVersion(pReader, pDesc, descSize, &metadataMajorVer, &metadataMinorVer);
-
+                break;
+            }
+            case MetadataDigestNoteType:
+            {
+                pDigest    = pDesc;
+                digestSize = descSize;
                 break;
             }
             default:
@@ -187,12 +192,30 @@ Result PipelineAbiReader::GetMetadata(
             }
         }
 
-        if (result != Result::Success)
+        // The pre-digested metadata is a copy of what decoding the MessagePack metadata below would produce. The reader
+        // is still initialized, as the callers seek to the register and shader function maps with it.
+        if ((pDigest != nullptr) &&
+            PalAbi::ReadMetadataDigest(pDigest, digestSize, pRawMetadata, metadataSize, pMetadata))
+        {
+            result = pReader->InitFromBuffer(pRawMetadata, metadataSize);
+        }
+        else
         {
-            break;
+            memset(pMetadata, 0, sizeof(PalAbi::CodeObjectMetadata));
+
+            if (pRawMetadata != nullptr)
+            {
+                result = PalAbi::GetPalMetadataVersion(pReader, pRawMetadata, metadataSize,
+                                                       &metadataMajorVer, &metadataMinorVer);
+            }
+
+            if (result == Result::Success)
+            {
+                result = PalAbi::DeserializeCodeObjectMetadata(pReader, pMetadata, pRawMetadata, metadataSize,
+                    metadataMajorVer, metadataMinorVer);
+            }
         }
-        result = PalAbi::DeserializeCodeObjectMetadata(pReader, pMetadata, pRawMetadata, metadataSize,
-            metadataMajorVer, metadataMinorVer);
+
         foundMetadata = true;
 
         // Quit after the first .note section
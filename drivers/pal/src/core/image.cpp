@@ -1024,6 +1024,49 @@ Result Image::GetSubresourceLayout(
     return ret;
 }
 
+// =====================================================================================================================
+// Copies texels between host memory and this image on the CPU by mapping the bound GPU memory and handing the regions
+// to the address manager, which knows how to walk the image's swizzle layout.
+Result Image::HostCopy(
+    uint32                     regionCount,
+    const HostImageCopyRegion* pRegions,
+    uint32                     maxThreads,
+    bool                       toImage)
+{
+    Result result = Result::Success;
+
+    if ((regionCount > 0) && (pRegions == nullptr))
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else if (m_vidMem.IsBound() == false)
+    {
+        result = Result::ErrorGpuMemoryNotBound;
+    }
+    else if ((IsMetadataDisabledByClient() == false) || (m_createInfo.samples > 1))
+    {
+        // Compressed or multisampled data can't be interpreted with swizzle equations alone.
+        result = Result::ErrorUnavailable;
+    }
+
+    void* pData = nullptr;
+
+    if ((result == Result::Success) && (regionCount > 0))
+    {
+        result = m_vidMem.Map(&pData);
+
+        if (result == Result::Success)
+        {
+            result = m_pDevice->GetAddrMgr()->CopyHostImage(*this, pData, regionCount, pRegions, maxThreads, toImage);
+
+            const Result unmapResult = m_vidMem.Unmap();
+            PAL_ASSERT(unmapResult == Result::Success);
+        }
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 Result Image::BindGpuMemory(
     IGpuMemory* pGpuMemory,
@@ -325,6 +325,18 @@ public:
 
     virtual Result BindGpuMemory(IGpuMemory* pGpuMemory, gpusize offset) override;
 
+    virtual Result CopyMemoryToImage(
+        uint32                     regionCount,
+        const HostImageCopyRegion* pRegions,
+        uint32                     maxThreads) override
+        { return HostCopy(regionCount, pRegions, maxThreads, true); }
+
+    virtual Result CopyImageToMemory(
+        uint32                     regionCount,
+        const HostImageCopyRegion* pRegions,
+        uint32                     maxThreads) override
+        { return HostCopy(regionCount, pRegions, maxThreads, false); }
+
     Device* GetDevice() const { return m_pDevice; }
 
     virtual void GetGpuMemoryRequirements(GpuMemoryRequirements* pGpuMemReqs) const override;
@@ -589,6 +601,12 @@ protected:
 private:
     uint32 DegradeMipDimension(uint32  mipDimension) const;
 
+    Result HostCopy(
+        uint32                     regionCount,
+        const HostImageCopyRegion* pRegions,
+        uint32                     maxThreads,
+        bool                       toImage);
+
     static Result CreatePrivateScreenImageMemoryObject(
         Device*      pDevice,
         IImage*      pImage,
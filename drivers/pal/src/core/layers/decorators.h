@@ -2733,6 +2733,18 @@ public:
     virtual MetadataSharingLevel GetOptimalSharingLevel() const override
         { return m_pNextLayer->GetOptimalSharingLevel(); }
 
+    virtual Result CopyMemoryToImage(
+        uint32                     regionCount,
+        const HostImageCopyRegion* pRegions,
+        uint32                     maxThreads) override
+        { return m_pNextLayer->CopyMemoryToImage(regionCount, pRegions, maxThreads); }
+
+    virtual Result CopyImageToMemory(
+        uint32                     regionCount,
+        const HostImageCopyRegion* pRegions,
+        uint32                     maxThreads) override
+        { return m_pNextLayer->CopyImageToMemory(regionCount, pRegions, maxThreads); }
+
     // Part of the IDestroyable public interface.
     virtual void Destroy() override
     {
@@ -0,0 +1,429 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#if PAL_DEVELOPER_BUILD
+
+#include "core/layers/interfaceLogger/interfaceLoggerBinaryLog.h"
+#include "core/layers/interfaceLogger/interfaceLoggerPlatform.h"
+#include "palHashMapImpl.h"
+#include "palInlineFuncs.h"
+
+using namespace Util;
+
+namespace Pal
+{
+namespace InterfaceLogger
+{
+
+// =====================================================================================================================
+LogFlusher::LogFlusher()
+    :
+    m_pQueueHead(nullptr),
+    m_pQueueTail(nullptr),
+    m_exitThread(false)
+{
+}
+
+// =====================================================================================================================
+LogFlusher::~LogFlusher()
+{
+    if (m_thread.IsCreated())
+    {
+        // The thread drains its queue before it exits so nothing that was submitted gets lost.
+        m_mutex.Lock();
+        m_exitThread = true;
+        m_submitCond.WakeOne();
+        m_mutex.Unlock();
+
+        m_thread.Join();
+    }
+
+    PAL_ASSERT(m_pQueueHead == nullptr);
+}
+
+// =====================================================================================================================
+Result LogFlusher::Init()
+{
+    return m_thread.Begin(&FlushThreadFunc, this);
+}
+
+// =====================================================================================================================
+void LogFlusher::Submit(
+    LogChunk* pChunk)
+{
+    MutexAuto lock(&m_mutex);
+
+    PAL_ASSERT(pChunk->busy == false);
+
+    pChunk->busy  = true;
+    pChunk->pNext = nullptr;
+
+    if (m_pQueueTail != nullptr)
+    {
+        m_pQueueTail->pNext = pChunk;
+    }
+    else
+    {
+        m_pQueueHead = pChunk;
+    }
+
+    m_pQueueTail = pChunk;
+    m_submitCond.WakeOne();
+}
+
+// =====================================================================================================================
+void LogFlusher::WaitForChunk(
+    LogChunk* pChunk)
+{
+    MutexAuto lock(&m_mutex);
+
+    while (pChunk->busy)
+    {
+        m_retireCond.Wait(&m_mutex, UINT32_MAX);
+    }
+}
+
+// =====================================================================================================================
+void LogFlusher::FlushThreadFunc(
+    void* pFlusher)
+{
+    static_cast<LogFlusher*>(pFlusher)->FlushThread();
+}
+
+// =====================================================================================================================
+// Writes out queued chunks until asked to exit, at which point it finishes off anything still in the queue.
+void LogFlusher::FlushThread()
+{
+    m_mutex.Lock();
+
+    while ((m_exitThread == false) || (m_pQueueHead != nullptr))
+    {
+        if (m_pQueueHead == nullptr)
+        {
+            m_submitCond.Wait(&m_mutex, UINT32_MAX);
+        }
+        else
+        {
+            LogChunk*const pChunk = m_pQueueHead;
+
+            m_pQueueHead = pChunk->pNext;
+
+            if (m_pQueueHead == nullptr)
+            {
+                m_pQueueTail = nullptr;
+            }
+
+            // The chunk is ours until we clear its busy flag so we can drop the lock while we do file I/O.
+            m_mutex.Unlock();
+
+            Result result = pChunk->pFile->Write(pChunk->data, pChunk->used);
+
+            if (result == Result::Success)
+            {
+                // Flush to disk to make the logs more useful if the application crashes.
+                result = pChunk->pFile->Flush();
+            }
+
+            PAL_ALERT(result != Result::Success);
+
+            m_mutex.Lock();
+
+            pChunk->used = 0;
+            pChunk->busy = false;
+            m_retireCond.WakeAll();
+        }
+    }
+
+    m_mutex.Unlock();
+}
+
+// =====================================================================================================================
+BinaryLogStream::BinaryLogStream(
+    Platform* pPlatform)
+    :
+    m_pPlatform(pPlatform),
+    m_pFlusher(nullptr),
+    m_ringIdx(0),
+    m_pCurChunk(nullptr),
+    m_pStaging(nullptr),
+    m_stagingSize(0),
+    m_stagingUsed(0),
+    m_stringIds(64, pPlatform),
+    m_stringIdsReady(false),
+    m_nextStringId(0)
+{
+    memset(m_pRing, 0, sizeof(m_pRing));
+
+    // If this fails we can still log, we just have to write every key out in full.
+    m_stringIdsReady = (m_stringIds.Init() == Result::Success);
+}
+
+// =====================================================================================================================
+BinaryLogStream::~BinaryLogStream()
+{
+    if (m_pFlusher != nullptr)
+    {
+        // Hand off whatever is left and wait for the flusher to retire the whole ring before we close the file.
+        SubmitCurChunk();
+
+        for (uint32 idx = 0; idx < RingSize; ++idx)
+        {
+            m_pFlusher->WaitForChunk(m_pRing[idx]);
+        }
+    }
+
+    for (uint32 idx = 0; idx < RingSize; ++idx)
+    {
+        PAL_SAFE_FREE(m_pRing[idx], m_pPlatform);
+    }
+
+    Discard();
+}
+
+// =====================================================================================================================
+Result BinaryLogStream::OpenFile(
+    const char* pFilePath,
+    LogFlusher* pFlusher)
+{
+    PAL_ASSERT((m_pFlusher == nullptr) && (pFlusher != nullptr));
+
+    Result result = Result::Success;
+
+    for (uint32 idx = 0; (idx < RingSize) && (result == Result::Success); ++idx)
+    {
+        m_pRing[idx] = static_cast<LogChunk*>(PAL_MALLOC(sizeof(LogChunk), m_pPlatform, AllocInternal));
+
+        if (m_pRing[idx] == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+        else
+        {
+            m_pRing[idx]->pFile = &m_file;
+            m_pRing[idx]->pNext = nullptr;
+            m_pRing[idx]->used  = 0;
+            m_pRing[idx]->busy  = false;
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_file.Open(pFilePath, FileAccessWrite | FileAccessBinary);
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_file.Write(BinaryLogMagic, sizeof(BinaryLogMagic));
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_file.Write(&BinaryLogVersion, sizeof(BinaryLogVersion));
+    }
+
+    if ((result == Result::Success) && (m_stagingUsed > 0))
+    {
+        // Write out anything that was logged before now. From here on the flusher owns all writes to the file.
+        result = m_file.Write(m_pStaging, m_stagingUsed);
+    }
+
+    if (result == Result::Success)
+    {
+        Discard();
+
+        m_pFlusher  = pFlusher;
+        m_ringIdx   = 0;
+        m_pCurChunk = m_pRing[0];
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void BinaryLogStream::Discard()
+{
+    PAL_SAFE_FREE(m_pStaging, m_pPlatform);
+
+    m_stagingSize = 0;
+    m_stagingUsed = 0;
+}
+
+// =====================================================================================================================
+void BinaryLogStream::Value(
+    float value)
+{
+    static_assert(sizeof(value) == sizeof(uint32), "The binary log format assumes 32-bit floats.");
+
+    uint8 bytes[1 + sizeof(value)];
+    bytes[0] = static_cast<uint8>(BinaryLogToken::Float);
+    memcpy(bytes + 1, &value, sizeof(value));
+
+    WriteBytes(bytes, sizeof(bytes));
+}
+
+// =====================================================================================================================
+// Writes a token followed by an LEB128 encoded value.
+void BinaryLogStream::WriteVarint(
+    BinaryLogToken token,
+    uint64         value)
+{
+    // One tag byte plus at most ten bytes of 7-bit groups.
+    uint8  bytes[11];
+    uint32 size = 0;
+
+    bytes[size++] = static_cast<uint8>(token);
+
+    while (value >= 0x80)
+    {
+        bytes[size++] = static_cast<uint8>(value | 0x80);
+        value >>= 7;
+    }
+
+    bytes[size++] = static_cast<uint8>(value);
+
+    WriteBytes(bytes, size);
+}
+
+// =====================================================================================================================
+void BinaryLogStream::WriteString(
+    BinaryLogToken token,
+    const char*    pString,
+    uint32         length)
+{
+    WriteVarint(token, length);
+    WriteBytes(pString, length);
+}
+
+// =====================================================================================================================
+// Writes a string which lives at a fixed address for the life of the process. The first use defines it, later uses
+// only need its ID.
+void BinaryLogStream::WriteInterned(
+    BinaryLogToken defineToken,
+    BinaryLogToken refToken,
+    const char*    pString)
+{
+    bool    existed = false;
+    uint32* pId     = nullptr;
+
+    if (m_stringIdsReady && (m_stringIds.FindAllocate(pString, &existed, &pId) == Result::Success))
+    {
+        if (existed)
+        {
+            WriteVarint(refToken, *pId);
+        }
+        else
+        {
+            *pId = m_nextStringId++;
+            WriteString(defineToken, pString, static_cast<uint32>(strlen(pString)));
+        }
+    }
+    else
+    {
+        // Fall back to the non-interned tokens.
+        const BinaryLogToken token = (defineToken == BinaryLogToken::KeyDefine) ? BinaryLogToken::Key
+                                                                                : BinaryLogToken::String;
+        WriteString(token, pString, static_cast<uint32>(strlen(pString)));
+    }
+}
+
+// =====================================================================================================================
+// Handles writes that don't fit in the current chunk (or that happen before the file is open).
+void BinaryLogStream::WriteBytesSlow(
+    const uint8* pData,
+    uint32       size)
+{
+    if (m_pCurChunk == nullptr)
+    {
+        // Stage the data until the file is opened, growing the staging buffer in 4K steps.
+        if (m_stagingSize - m_stagingUsed < size)
+        {
+            const uint32 newSize  = Pow2Align(m_stagingUsed + size, 4096);
+            uint8*const  pStaging = static_cast<uint8*>(PAL_MALLOC(newSize, m_pPlatform, AllocInternal));
+
+            if (pStaging != nullptr)
+            {
+                if (m_stagingUsed > 0)
+                {
+                    memcpy(pStaging, m_pStaging, m_stagingUsed);
+                }
+
+                PAL_SAFE_FREE(m_pStaging, m_pPlatform);
+
+                m_pStaging    = pStaging;
+                m_stagingSize = newSize;
+            }
+        }
+
+        if (m_stagingSize - m_stagingUsed >= size)
+        {
+            memcpy(m_pStaging + m_stagingUsed, pData, size);
+            m_stagingUsed += size;
+        }
+        else
+        {
+            PAL_ALERT_ALWAYS();
+        }
+    }
+    else
+    {
+        // Tokens are allowed to straddle chunks; the file is just the concatenation of every chunk.
+        while (size > 0)
+        {
+            const uint32 copySize = Min(size, LogChunk::Size - m_pCurChunk->used);
+
+            memcpy(m_pCurChunk->data + m_pCurChunk->used, pData, copySize);
+            m_pCurChunk->used += copySize;
+
+            pData += copySize;
+            size  -= copySize;
+
+            if (m_pCurChunk->used == LogChunk::Size)
+            {
+                SubmitCurChunk();
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Passes the current chunk to the flusher and moves on to the next chunk in the ring, waiting for the flusher to
+// retire it if it's still in flight.
+void BinaryLogStream::SubmitCurChunk()
+{
+    if (m_pCurChunk->used > 0)
+    {
+        m_pFlusher->Submit(m_pCurChunk);
+
+        m_ringIdx   = (m_ringIdx + 1) % RingSize;
+        m_pCurChunk = m_pRing[m_ringIdx];
+
+        m_pFlusher->WaitForChunk(m_pCurChunk);
+    }
+}
+
+} // InterfaceLogger
+} // Pal
+
+#endif
@@ -0,0 +1,225 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#if PAL_DEVELOPER_BUILD
+
+#include "pal.h"
+#include "palConditionVariable.h"
+#include "palFile.h"
+#include "palHashMap.h"
+#include "palMutex.h"
+#include "palStringView.h"
+#include "palThread.h"
+
+namespace Pal
+{
+namespace InterfaceLogger
+{
+
+class Platform;
+
+// Every binary log starts with this magic value followed by a uint32 BinaryLogVersion, both little-endian.
+constexpr char   BinaryLogMagic[8] = { 'P', 'A', 'L', 'I', 'L', 'O', 'G', '\0' };
+constexpr uint32 BinaryLogVersion  = 1;
+
+// The binary log is a flat stream of tokens which map one-to-one onto Util::JsonWriter calls, so it can be converted
+// back into the exact JSON text the text backend would have written (see tools/interfaceLoggerTools). Each token is a
+// single tag byte followed by its payload. Unsigned integers are stored as LEB128 varints, signed integers are
+// zig-zag encoded before being stored as varints, and strings are a varint length followed by that many bytes.
+//
+// Keys and other strings with static storage duration are interned: the first use emits a "Define" token which
+// assigns the string the next zero-based ID and later uses only emit a "Ref" token with that ID. IDs are scoped to the
+// file that defines them.
+enum class BinaryLogToken : uint8
+{
+    BeginList       = 0x00, // No payload.
+    BeginInlineList = 0x01, // No payload.
+    EndList         = 0x02, // No payload.
+    BeginMap        = 0x03, // No payload.
+    BeginInlineMap  = 0x04, // No payload.
+    EndMap          = 0x05, // No payload.
+    Key             = 0x06, // String.
+    KeyDefine       = 0x07, // String, assigned the next string ID.
+    KeyRef          = 0x08, // Varint string ID.
+    String          = 0x09, // String.
+    StringDefine    = 0x0A, // String, assigned the next string ID.
+    StringRef       = 0x0B, // Varint string ID.
+    Uint            = 0x0C, // Varint.
+    Int             = 0x0D, // Zig-zag varint.
+    Float           = 0x0E, // 4 bytes, IEEE-754 single precision.
+    False           = 0x0F, // No payload.
+    True            = 0x10, // No payload.
+    Null            = 0x11, // No payload.
+    Hex8            = 0x12, // Varint, written as a zero-padded 2-digit hex string.
+    Hex16           = 0x13, // Varint, written as a zero-padded 4-digit hex string.
+    Hex32           = 0x14, // Varint, written as a zero-padded 8-digit hex string.
+    Hex64           = 0x15, // Varint, written as a zero-padded 16-digit hex string.
+};
+
+// A fixed-size piece of a binary log. Each BinaryLogStream owns a small ring of these which it fills on the logging
+// thread and hands off to the LogFlusher once full.
+struct LogChunk
+{
+    static constexpr uint32 Size = 64 * 1024;
+
+    Util::File* pFile; // The file this chunk's contents belong in.
+    LogChunk*   pNext; // The next chunk in the flusher's queue.
+    uint32      used;  // How many bytes of data are in use.
+    bool        busy;  // True while the chunk is owned by the flusher. Protected by the flusher's mutex.
+    uint8       data[Size];
+};
+
+// =====================================================================================================================
+// Owns a background thread which writes filled LogChunks to their log files in submission order. This takes all file
+// I/O off of the logging threads; they only block if they manage to fill their whole ring before the flusher catches
+// up.
+class LogFlusher
+{
+public:
+    LogFlusher();
+    ~LogFlusher();
+
+    Result Init();
+
+    // Queues a filled chunk to be written out. The chunk belongs to the flusher until WaitForChunk says otherwise.
+    void Submit(LogChunk* pChunk);
+
+    // Blocks until the given chunk has been written out (if it was submitted) and can be refilled.
+    void WaitForChunk(LogChunk* pChunk);
+
+private:
+    static void FlushThreadFunc(void* pFlusher);
+    void FlushThread();
+
+    Util::Thread            m_thread;
+    Util::Mutex             m_mutex;       // Protects everything below as well as each LogChunk's busy flag.
+    Util::ConditionVariable m_submitCond;  // Signaled when a chunk is queued or the thread should exit.
+    Util::ConditionVariable m_retireCond;  // Signaled when a chunk has been written out.
+    LogChunk*               m_pQueueHead;  // Chunks waiting to be written, oldest first.
+    LogChunk*               m_pQueueTail;
+    bool                    m_exitThread;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(LogFlusher);
+};
+
+// =====================================================================================================================
+// Encodes a log context's JsonWriter calls into the compact binary token stream described above. Like LogStream, this
+// stream can be written before its file has been opened; that data is staged in a growable buffer and written out by
+// OpenFile. Once open, the stream fills a ring of LogChunks and passes them to a LogFlusher to be written.
+class BinaryLogStream
+{
+public:
+    explicit BinaryLogStream(Platform* pPlatform);
+    ~BinaryLogStream();
+
+    Result OpenFile(const char* pFilePath, LogFlusher* pFlusher);
+
+    // Frees anything buffered for a file which will never be opened because the context picked the text format.
+    void Discard();
+
+    void BeginList(bool isInline)
+        { WriteToken(isInline ? BinaryLogToken::BeginInlineList : BinaryLogToken::BeginList); }
+    void EndList() { WriteToken(BinaryLogToken::EndList); }
+
+    void BeginMap(bool isInline)
+        { WriteToken(isInline ? BinaryLogToken::BeginInlineMap : BinaryLogToken::BeginMap); }
+    void EndMap() { WriteToken(BinaryLogToken::EndMap); }
+
+    // The caller guarantees that pKey has static storage duration so that it can be interned by address.
+    void Key(const char* pKey) { WriteInterned(BinaryLogToken::KeyDefine, BinaryLogToken::KeyRef, pKey); }
+
+    void Value(const char* pValue)
+        { WriteString(BinaryLogToken::String, pValue, static_cast<uint32>(strlen(pValue))); }
+    void Value(Util::StringView<char> value)
+        { WriteString(BinaryLogToken::String, value.Data(), value.Length()); }
+
+    // Like Key, this requires that pValue has static storage duration.
+    void StaticValue(const char* pValue)
+        { WriteInterned(BinaryLogToken::StringDefine, BinaryLogToken::StringRef, pValue); }
+
+    void Value(uint64 value) { WriteVarint(BinaryLogToken::Uint, value); }
+    void Value(int64 value)
+        { WriteVarint(BinaryLogToken::Int, (static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63)); }
+    void Value(float value);
+    void Value(bool value)   { WriteToken(value ? BinaryLogToken::True : BinaryLogToken::False); }
+
+    void HexValue(uint64 value) { WriteVarint(BinaryLogToken::Hex64, value); }
+    void HexValue(uint32 value) { WriteVarint(BinaryLogToken::Hex32, value); }
+    void HexValue(uint16 value) { WriteVarint(BinaryLogToken::Hex16, value); }
+    void HexValue(uint8 value)  { WriteVarint(BinaryLogToken::Hex8,  value); }
+
+    void NullValue() { WriteToken(BinaryLogToken::Null); }
+
+private:
+    static constexpr uint32 RingSize = 4;
+
+    void WriteToken(BinaryLogToken token) { const uint8 tag = static_cast<uint8>(token); WriteBytes(&tag, 1); }
+    void WriteVarint(BinaryLogToken token, uint64 value);
+    void WriteString(BinaryLogToken token, const char* pString, uint32 length);
+    void WriteInterned(BinaryLogToken defineToken, BinaryLogToken refToken, const char* pString);
+
+    void WriteBytes(const void* pData, uint32 size)
+    {
+        LogChunk*const pChunk = m_pCurChunk;
+
+        if ((pChunk != nullptr) && (LogChunk::Size - pChunk->used >= size))
+        {
+            memcpy(pChunk->data + pChunk->used, pData, size);
+            pChunk->used += size;
+        }
+        else
+        {
+            WriteBytesSlow(static_cast<const uint8*>(pData), size);
+        }
+    }
+
+    void WriteBytesSlow(const uint8* pData, uint32 size);
+    void SubmitCurChunk();
+
+    Platform*const m_pPlatform;
+    LogFlusher*    m_pFlusher;              // Non-null once the file is open.
+    Util::File     m_file;
+    LogChunk*      m_pRing[RingSize];       // Chunks are filled in order and reused once the flusher retires them.
+    uint32         m_ringIdx;               // The ring index of m_pCurChunk.
+    LogChunk*      m_pCurChunk;             // The chunk currently being filled, null until the file is open.
+    uint8*         m_pStaging;              // Data written before the file was opened.
+    uint32         m_stagingSize;
+    uint32         m_stagingUsed;
+
+    // Maps interned strings (by address) to their string IDs.
+    Util::HashMap<const char*, uint32, Platform> m_stringIds;
+    bool                                         m_stringIdsReady;
+    uint32                                       m_nextStringId;
+
+    PAL_DISALLOW_DEFAULT_CTOR(BinaryLogStream);
+    PAL_DISALLOW_COPY_AND_ASSIGN(BinaryLogStream);
+};
+
+} // InterfaceLogger
+} // Pal
+
+#endif
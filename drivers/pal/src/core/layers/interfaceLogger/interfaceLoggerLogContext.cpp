@@ -470,8 +470,10 @@ void LogStream::VerifyUnusedSpace(
 LogContext::LogContext(
     Platform* pPlatform)
     :
-    JsonWriter(&m_stream),
-    m_stream(pPlatform)
+    m_format(LogFormat::Pending),
+    m_stream(pPlatform),
+    m_jsonWriter(&m_stream),
+    m_binaryStream(pPlatform)
 {
 #if PAL_ENABLE_PRINTS_ASSERTS
     for (uint32 idx = 0; idx < static_cast<uint32>(InterfaceFunc::Count); ++idx)
@@ -491,6 +493,164 @@ LogContext::~LogContext()
     EndList();
 }
 
+// =====================================================================================================================
+Result LogContext::OpenFile(
+    const char* pFilePath,
+    LogFlusher* pFlusher)
+{
+    PAL_ASSERT(m_format == LogFormat::Pending);
+
+    Result result = Result::Success;
+
+    if (pFlusher != nullptr)
+    {
+        result   = m_binaryStream.OpenFile(pFilePath, pFlusher);
+        m_format = LogFormat::Binary;
+    }
+    else
+    {
+        result   = m_stream.OpenFile(pFilePath);
+        m_format = LogFormat::Json;
+
+        m_binaryStream.Discard();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void LogContext::BeginList(
+    bool isInline)
+{
+    if (m_format != LogFormat::Binary)
+    {
+        m_jsonWriter.BeginList(isInline);
+    }
+
+    if (m_format != LogFormat::Json)
+    {
+        m_binaryStream.BeginList(isInline);
+    }
+}
+
+// =====================================================================================================================
+void LogContext::EndList()
+{
+    if (m_format != LogFormat::Binary)
+    {
+        m_jsonWriter.EndList();
+    }
+
+    if (m_format != LogFormat::Json)
+    {
+        m_binaryStream.EndList();
+    }
+}
+
+// =====================================================================================================================
+void LogContext::BeginMap(
+    bool isInline)
+{
+    if (m_format != LogFormat::Binary)
+    {
+        m_jsonWriter.BeginMap(isInline);
+    }
+
+    if (m_format != LogFormat::Json)
+    {
+        m_binaryStream.BeginMap(isInline);
+    }
+}
+
+// =====================================================================================================================
+void LogContext::EndMap()
+{
+    if (m_format != LogFormat::Binary)
+    {
+        m_jsonWriter.EndMap();
+    }
+
+    if (m_format != LogFormat::Json)
+    {
+        m_binaryStream.EndMap();
+    }
+}
+
+// =====================================================================================================================
+// All keys are string literals or come from static string tables so the binary stream can always intern them.
+void LogContext::Key(
+    const char* pKey)
+{
+    if (m_format != LogFormat::Binary)
+    {
+        m_jsonWriter.Key(pKey);
+    }
+
+    if (m_format != LogFormat::Json)
+    {
+        m_binaryStream.Key(pKey);
+    }
+}
+
+// =====================================================================================================================
+void LogContext::Value(
+    const char* pValue)
+{
+    if (m_format != LogFormat::Binary)
+    {
+        m_jsonWriter.Value(pValue);
+    }
+
+    if (m_format != LogFormat::Json)
+    {
+        m_binaryStream.Value(pValue);
+    }
+}
+
+// =====================================================================================================================
+void LogContext::Value(
+    StringView<char> value)
+{
+    if (m_format != LogFormat::Binary)
+    {
+        m_jsonWriter.Value(value);
+    }
+
+    if (m_format != LogFormat::Json)
+    {
+        m_binaryStream.Value(value);
+    }
+}
+
+// =====================================================================================================================
+void LogContext::StaticValue(
+    const char* pValue)
+{
+    if (m_format != LogFormat::Binary)
+    {
+        m_jsonWriter.Value(pValue);
+    }
+
+    if (m_format != LogFormat::Json)
+    {
+        m_binaryStream.StaticValue(pValue);
+    }
+}
+
+// =====================================================================================================================
+void LogContext::NullValue()
+{
+    if (m_format != LogFormat::Binary)
+    {
+        m_jsonWriter.NullValue();
+    }
+
+    if (m_format != LogFormat::Json)
+    {
+        m_binaryStream.NullValue();
+    }
+}
+
 // =====================================================================================================================
 void LogContext::BeginFunc(
     const BeginFuncInfo& info,
@@ -499,10 +659,10 @@ void LogContext::BeginFunc(
     auto const& funcData = FuncFormattingTable[static_cast<uint32>(info.funcId)];
 
     BeginMap(false);
-    KeyAndValue("_type", "InterfaceFunc");
+    KeyAndStaticValue("_type", "InterfaceFunc");
     Key("this");
     Object(funcData.objectType, info.objectId);
-    KeyAndValue("name", funcData.pFuncName);
+    KeyAndStaticValue("name", funcData.pFuncName);
     KeyAndValue("thread", threadId);
     KeyAndValue("preCallTime", info.preCallTime);
     KeyAndValue("postCallTime", info.postCallTime);
@@ -835,7 +995,7 @@ void LogContext::Object(
     uint32          objectId)
 {
     BeginMap(true);
-    KeyAndValue("class", ObjectNames[static_cast<uint32>(objectType)]);
+    KeyAndStaticValue("class", ObjectNames[static_cast<uint32>(objectType)]);
     KeyAndValue("id", objectId);
     EndMap();
 }
@@ -875,7 +1035,7 @@ void LogContext::CacheCoherencyUsageFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
@@ -930,7 +1090,7 @@ void LogContext::PipelineStageFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
@@ -958,7 +1118,7 @@ void LogContext::ComputeStateFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
@@ -987,7 +1147,7 @@ void LogContext::CopyControlFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
@@ -1015,7 +1175,7 @@ void LogContext::GpuMemoryRefFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
@@ -1047,7 +1207,7 @@ void LogContext::ImageLayoutEngineFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
@@ -1087,7 +1247,7 @@ void LogContext::ImageLayoutUsageFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
@@ -1131,7 +1291,7 @@ void LogContext::QueryPipelineStatsFlags(
         {
             if ((flags & (1 << idx)) != 0)
             {
-                Value(StringTable[idx]);
+                StaticValue(StringTable[idx]);
             }
         }
 
@@ -1163,7 +1323,7 @@ void LogContext::QueryResultFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
@@ -1192,7 +1352,7 @@ void LogContext::ClearColorImageFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
@@ -1219,7 +1379,7 @@ void LogContext::ClearDepthStencilFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
@@ -1246,7 +1406,7 @@ void LogContext::ResolveImageFlags(
     {
         if ((flags & (1 << idx)) != 0)
         {
-            Value(StringTable[idx]);
+            StaticValue(StringTable[idx]);
         }
     }
 
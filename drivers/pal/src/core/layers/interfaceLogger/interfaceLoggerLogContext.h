@@ -28,6 +28,7 @@
 #if PAL_DEVELOPER_BUILD
 
 #include "core/layers/decorators.h"
+#include "core/layers/interfaceLogger/interfaceLoggerBinaryLog.h"
 #include "palFile.h"
 #include "palJsonWriter.h"
 
@@ -381,6 +382,10 @@ private:
 // A logging context contains all state needed to write a single log file. It also wraps a JSON writer with PAL-specific
 // helper functions. This keeps the JSON output consistent, making it easier to parse written logs in external tools.
 //
+// The context can instead write the compact binary encoding described in interfaceLoggerBinaryLog.h, which converts
+// back into exactly the same JSON text offline. Because the format isn't known until the log file is opened, the
+// context records both encodings until then.
+//
 // At the highest level, the JSON stream contains a list of maps, where each map is an entry in the log. Each entry
 // contains a "_type" key whose value is a string indicating what type of entry is being parsed. This key exists solely
 // as a hint to external tools. This layer will use the following types with the given keys (order not guaranteed).
@@ -416,14 +421,59 @@ private:
 // Note that the LogContext also defines a common format for logging instances of PAL interface objects. Each object is
 // represented by a map containing a "class" key identifying the PAL interface class (e.g., IDevice) and an "id" key
 // identifying the particular instance of the class. All IDs are unique and zero-based.
-class LogContext : public Util::JsonWriter
+class LogContext
 {
 public:
     explicit LogContext(Platform* pPlatform);
     virtual ~LogContext();
 
-    // Must be called once to associate a context with a log file. Logging can occur before the log is opened.
-    Result OpenFile(const char* pFilePath) { return m_stream.OpenFile(pFilePath); }
+    // Must be called once to associate a context with a log file. Logging can occur before the log is opened. The log
+    // is written in the binary format through pFlusher if it's non-null, otherwise it is written as JSON text.
+    Result OpenFile(const char* pFilePath, LogFlusher* pFlusher);
+
+    // These functions mirror the Util::JsonWriter interface.
+    void BeginList(bool isInline);
+    void EndList();
+    void BeginMap(bool isInline);
+    void EndMap();
+
+    void Key(const char* pKey);
+
+    void Value(const char* pValue);
+    void Value(Util::StringView<char> value);
+    void Value(uint64 value) { WriteValue(value, value); }
+    void Value(uint32 value) { WriteValue(value, static_cast<uint64>(value)); }
+    void Value(uint16 value) { WriteValue(value, static_cast<uint64>(value)); }
+    void Value(uint8 value)  { WriteValue(value, static_cast<uint64>(value)); }
+    void Value(int64 value)  { WriteValue(value, value); }
+    void Value(int32 value)  { WriteValue(value, static_cast<int64>(value)); }
+    void Value(int16 value)  { WriteValue(value, static_cast<int64>(value)); }
+    void Value(int8 value)   { WriteValue(value, static_cast<int64>(value)); }
+    void Value(float value)  { WriteValue(value, value); }
+    void Value(bool value)   { WriteValue(value, value); }
+
+    void HexValue(uint64 value) { WriteHexValue(value); }
+    void HexValue(uint32 value) { WriteHexValue(value); }
+    void HexValue(uint16 value) { WriteHexValue(value); }
+    void HexValue(uint8 value)  { WriteHexValue(value); }
+
+    void NullValue();
+
+    // Writes a string value which has static storage duration (e.g., from a string table). The binary format only
+    // needs to write each of these strings once.
+    void StaticValue(const char* pValue);
+
+    void KeyAndBeginList(const char* pKey, bool isInline) { Key(pKey); BeginList(isInline); }
+    void KeyAndBeginMap(const char* pKey, bool isInline)  { Key(pKey); BeginMap(isInline); }
+
+    template <typename T>
+    void KeyAndValue(const char* pKey, T value) { Key(pKey); Value(value); }
+
+    template <typename T>
+    void KeyAndHexValue(const char* pKey, T value) { Key(pKey); HexValue(value); }
+
+    void KeyAndStaticValue(const char* pKey, const char* pValue) { Key(pKey); StaticValue(pValue); }
+    void KeyAndNullValue(const char* pKey) { Key(pKey); NullValue(); }
 
     // These functions begin and end a specially formatted map which represents a PAL interface function.
     void BeginFunc(const BeginFuncInfo& info, uint32 threadId);
@@ -748,9 +798,48 @@ public:
     static const char* GetVrsCombinerStageName(VrsCombinerStage value);
 
 private:
+    // Which encodings are currently being recorded.
+    enum class LogFormat : uint32
+    {
+        Pending, // The file hasn't been opened yet so both encodings are recorded.
+        Json,
+        Binary
+    };
+
     void Object(InterfaceObject objectType, uint32 objectId);
 
-    LogStream m_stream;
+    template <typename T, typename B>
+    void WriteValue(T value, B binaryValue)
+    {
+        if (m_format != LogFormat::Binary)
+        {
+            m_jsonWriter.Value(value);
+        }
+
+        if (m_format != LogFormat::Json)
+        {
+            m_binaryStream.Value(binaryValue);
+        }
+    }
+
+    template <typename T>
+    void WriteHexValue(T value)
+    {
+        if (m_format != LogFormat::Binary)
+        {
+            m_jsonWriter.HexValue(value);
+        }
+
+        if (m_format != LogFormat::Json)
+        {
+            m_binaryStream.HexValue(value);
+        }
+    }
+
+    LogFormat        m_format;
+    LogStream        m_stream;
+    Util::JsonWriter m_jsonWriter;
+    BinaryLogStream  m_binaryStream;
 
     PAL_DISALLOW_DEFAULT_CTOR(LogContext);
     PAL_DISALLOW_COPY_AND_ASSIGN(LogContext);
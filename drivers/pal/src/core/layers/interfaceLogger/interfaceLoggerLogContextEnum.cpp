@@ -70,7 +70,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(AtomicOp::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -119,7 +119,7 @@ void LogContext::Enum(
 
     if (pStr != nullptr)
     {
-        Value(pStr);
+        StaticValue(pStr);
     }
     else
     {
@@ -148,7 +148,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(DispatchInterleaveSize::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 #endif
 
@@ -169,7 +169,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(BinningOverride::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -205,7 +205,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(Blend::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -229,7 +229,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(BlendFunc::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -250,7 +250,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(BorderColorType::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -273,7 +273,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ChannelSwizzle::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -480,7 +480,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ChNumFormat::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -497,7 +497,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -522,7 +522,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(CompareFunc::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -540,7 +540,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -556,7 +556,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -573,7 +573,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -598,14 +598,14 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
 void LogContext::Enum(
     EngineType value)
 {
-    Value(GetEngineName(value));
+    StaticValue(GetEngineName(value));
 }
 
 // =====================================================================================================================
@@ -621,7 +621,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -638,7 +638,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -658,7 +658,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(FlglSupport::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -679,7 +679,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < GpuHeapCount);
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -702,7 +702,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < GpuHeapAccessCount);
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -725,7 +725,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(GpuMemPriority::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -750,7 +750,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(GpuMemPriorityOffset::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -772,7 +772,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -793,7 +793,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ImageRotation::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -814,7 +814,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ImageTexOptLevel::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -834,7 +834,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ImageTiling::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -856,7 +856,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ImageTilingPattern::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -876,7 +876,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ImageType::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -897,7 +897,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ImageViewType::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -917,7 +917,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(IndexType::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -938,7 +938,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -968,7 +968,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -986,7 +986,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1004,7 +1004,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1024,7 +1024,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < MipFilterCount);
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1098,7 +1098,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT((idx <= static_cast<uint32>(NullGpuId::All)) && (StringTable[idx] != nullptr));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1117,7 +1117,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(PipelineBindPoint::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1133,7 +1133,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1151,7 +1151,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1169,7 +1169,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1189,7 +1189,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(PresentMode::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1209,7 +1209,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1240,7 +1240,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1257,7 +1257,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1274,7 +1274,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1291,7 +1291,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1308,7 +1308,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1324,7 +1324,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1344,7 +1344,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(QueryPoolType::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1365,7 +1365,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1382,7 +1382,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1403,7 +1403,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < QueueTypeCount);
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1423,7 +1423,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ReclaimResult::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1444,7 +1444,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ResolveMode::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1551,7 +1551,7 @@ void LogContext::Enum(
         const uint32 idx = static_cast<uint32>(-(1 + static_cast<int32>(value)));
         PAL_ASSERT(idx < ArrayLen(StringTable));
 
-        Value(StringTable[idx]);
+        StaticValue(StringTable[idx]);
     }
     else
     {
@@ -1575,7 +1575,7 @@ void LogContext::Enum(
         const uint32 idx = static_cast<uint32>(value);
         PAL_ASSERT(idx < ArrayLen(StringTable));
 
-        Value(StringTable[idx]);
+        StaticValue(StringTable[idx]);
     }
 }
 
@@ -1592,7 +1592,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1617,7 +1617,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(StencilOp::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1638,7 +1638,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(SubmitOptMode::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1664,7 +1664,7 @@ void LogContext::Enum(
     const uint32 idx = Log2(static_cast<uint32>(value));
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1685,7 +1685,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(SwapChainMode::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1710,7 +1710,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(TexAddressMode::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1727,7 +1727,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1747,7 +1747,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(TilingOptMode::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1767,7 +1767,7 @@ void LogContext::Enum(
     const uint8 idx = static_cast<uint8>(value);
     PAL_ASSERT(idx < static_cast<uint8>(TriState::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1789,7 +1789,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(VaRange::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1808,7 +1808,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1830,7 +1830,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1850,7 +1850,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1872,7 +1872,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1891,7 +1891,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1908,7 +1908,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1930,7 +1930,7 @@ void LogContext::Enum(
     const uint32 idx = Log2(static_cast<uint32>(value));
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1951,7 +1951,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < XyFilterCount);
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1971,7 +1971,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ZFilterCount);
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -1991,7 +1991,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(VirtualDisplayVSyncMode::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -2010,7 +2010,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(ImmediateDataWidth::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -2031,7 +2031,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < static_cast<uint32>(TurboSyncControlMode::Count));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 // =====================================================================================================================
@@ -2052,7 +2052,7 @@ void LogContext::Enum(
     const uint32 idx = static_cast<uint32>(value);
     PAL_ASSERT(idx < ArrayLen(StringTable));
 
-    Value(StringTable[idx]);
+    StaticValue(StringTable[idx]);
 }
 
 } // InterfaceLogger
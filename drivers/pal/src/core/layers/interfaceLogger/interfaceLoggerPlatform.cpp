@@ -334,6 +334,7 @@ Platform::Platform(
     PlatformDecorator(createInfo, allocCb, InterfaceLoggerCb, enabled, enabled, pNextPlatform),
     m_createInfo(createInfo),
     m_pMainLog(nullptr),
+    m_pFlusher(nullptr),
     m_nextThreadId(0),
     m_objectId(0),
     m_activePreset(0),
@@ -388,6 +389,9 @@ Platform::~Platform()
 
     PAL_SAFE_DELETE(m_pMainLog, this);
 
+    // The logs hand their remaining data to the flusher as they're destroyed so it must go last.
+    PAL_SAFE_DELETE(m_pFlusher, this);
+
     // If someone manages to call a logging function after destruction this might protect us a bit.
     m_flags.threadKeyCreated  = 0;
     m_flags.multithreaded     = 0;
@@ -500,13 +504,33 @@ Result Platform::CommitLoggingSettings()
         // Try to create the root log directory.
         result = CreateLogDir(settings.interfaceLoggerConfig.logDirectory);
 
+        if ((result == Result::Success) && settings.interfaceLoggerConfig.binaryFormat)
+        {
+            // All binary logs are written to disk by a single background thread.
+            m_pFlusher = PAL_NEW(LogFlusher, this, AllocInternal);
+
+            if (m_pFlusher == nullptr)
+            {
+                result = Result::ErrorOutOfMemory;
+            }
+            else
+            {
+                result = m_pFlusher->Init();
+
+                if (result != Result::Success)
+                {
+                    PAL_SAFE_DELETE(m_pFlusher, this);
+                }
+            }
+        }
+
         if (result == Result::Success)
         {
             // We can finally open the main log's file; this will flush out any data it already buffered.
             char logFilePath[512];
-            Snprintf(logFilePath, sizeof(logFilePath), "%s/pal_calls.json", LogDirPath());
+            Snprintf(logFilePath, sizeof(logFilePath), "%s/pal_calls.%s", LogDirPath(), LogFileExtension());
 
-            result = m_pMainLog->OpenFile(logFilePath);
+            result = m_pMainLog->OpenFile(logFilePath, m_pFlusher);
         }
 
         // If multithreaded logging is enabled, we need to go back over our previously allocated ThreadData and give
@@ -960,12 +984,12 @@ LogContext* Platform::CreateThreadLogContext(
     {
         // Create a file name and path for this log.
         char logFileName[64];
-        Snprintf(logFileName, sizeof(logFileName), "pal_calls_thread_%u.json", threadId);
+        Snprintf(logFileName, sizeof(logFileName), "pal_calls_thread_%u.%s", threadId, LogFileExtension());
 
         char logFilePath[512];
         Snprintf(logFilePath, sizeof(logFilePath), "%s/%s", LogDirPath(), logFileName);
 
-        const Result result = pContext->OpenFile(logFilePath);
+        const Result result = pContext->OpenFile(logFilePath, m_pFlusher);
 
         if (result == Result::Success)
         {
@@ -138,6 +138,8 @@ private:
     ThreadData* CreateThreadData();
     LogContext* CreateThreadLogContext(uint32 threadId);
 
+    const char* LogFileExtension() const { return (m_pFlusher != nullptr) ? "bin" : "json"; }
+
     union
     {
         struct
@@ -156,6 +158,8 @@ private:
     LogContext*              m_pMainLog;          // Holds all logged data if multithreaded logging is disabled.
                                                   // Otherwise it holds some initial logged data and identifies all
                                                   // thread log files.
+    LogFlusher*              m_pFlusher;          // Writes out every log in the background if the binary format is
+                                                  // enabled, otherwise null.
     uint32                   m_nextThreadId;      // Each thread file gets a unique ID (not the OS thread ID).
     uint32                   m_objectId;          // This object's unique ID.
     volatile uint32          m_activePreset;      // The index of the active preset in m_loggingPresets.
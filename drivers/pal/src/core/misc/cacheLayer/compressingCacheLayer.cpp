@@ -25,6 +25,7 @@
 
 #include "compressingCacheLayer.h"
 
+#include "palDequeImpl.h"
 #include "palSysMemory.h"
 
 #include "core/platform.h"
@@ -37,13 +38,27 @@ namespace Util
 // =====================================================================================================================
 CompressingCacheLayer::CompressingCacheLayer(
     const AllocCallbacks& callbacks,
-    bool useHighCompression,
-    bool decompressOnly)
+    bool                  useHighCompression,
+    bool                  decompressOnly,
+    bool                  asyncCompression)
     : m_compressor(callbacks, useHighCompression)
     , m_allocator(callbacks)
-    , m_compressMutex()
+    , m_callbacks(callbacks)
     , m_pNextLayer(nullptr)
+    , m_useHighCompression(useHighCompression)
     , m_decompressOnly(decompressOnly)
+    , m_asyncCompression(asyncCompression && (decompressOnly == false))
+    , m_compressorMutex()
+    , m_compressorReleased()
+    , m_pCompressors{}
+    , m_pFreeCompressors{}
+    , m_compressorCount(0)
+    , m_freeCompressorCount(0)
+    , m_pendingMutex()
+    , m_pendingCondition()
+    , m_pendingEntries(&m_allocator)
+    , m_compressThread()
+    , m_stopCompressThread(false)
 {
     // Alloc and Free MUST NOT be nullptr
     PAL_ASSERT(callbacks.pfnAlloc != nullptr);
@@ -53,12 +68,258 @@ CompressingCacheLayer::CompressingCacheLayer(
 // =====================================================================================================================
 CompressingCacheLayer::~CompressingCacheLayer()
 {
+    if (m_compressThread.IsCreated())
+    {
+        {
+            MutexAuto lock(&m_pendingMutex);
+            m_stopCompressThread = true;
+            m_pendingCondition.WakeAll();
+        }
+
+        PAL_ASSERT(m_compressThread.IsNotCurrentThread());
+        m_compressThread.Join();
+    }
+
+    // Anything still pending was already stored uncompressed, so it is safe to drop.
+    PendingCompression pending = {};
+    while (m_pendingEntries.PopFront(&pending) == Result::Success)
+    {
+        PAL_SAFE_FREE(pending.pData, &m_allocator);
+    }
+
+    // The first compressor is m_compressor, which is not heap allocated.
+    for (uint32 i = 1; i < m_compressorCount; ++i)
+    {
+        PAL_DELETE(m_pCompressors[i], &m_allocator);
+    }
 }
 
 // =====================================================================================================================
 Result CompressingCacheLayer::Init()
 {
-    return m_compressor.Init();
+    Result result = m_compressor.Init();
+
+    if (result == Result::Success)
+    {
+        m_pCompressors[0]     = &m_compressor;
+        m_pFreeCompressors[0] = &m_compressor;
+        m_compressorCount     = 1;
+        m_freeCompressorCount = 1;
+    }
+
+    if ((result == Result::Success) && m_asyncCompression)
+    {
+        result = m_compressThread.Begin(&CompressThreadFunc, this);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Checks out a compressor for the exclusive use of the calling thread, creating a new one if all existing ones are in
+// use. Only blocks once MaxCompressors stores are compressing concurrently.
+Lz4Compressor* CompressingCacheLayer::AcquireCompressor()
+{
+    Lz4Compressor* pCompressor = nullptr;
+
+    MutexAuto lock(&m_compressorMutex);
+
+    while (pCompressor == nullptr)
+    {
+        if (m_freeCompressorCount > 0)
+        {
+            pCompressor = m_pFreeCompressors[--m_freeCompressorCount];
+        }
+        else if (m_compressorCount < MaxCompressors)
+        {
+            pCompressor = PAL_NEW(Lz4Compressor, &m_allocator, AllocInternal)(
+                m_callbacks, m_useHighCompression);
+
+            if ((pCompressor != nullptr) && (pCompressor->Init() != Result::Success))
+            {
+                PAL_DELETE(pCompressor, &m_allocator);
+                pCompressor = nullptr;
+            }
+
+            if (pCompressor != nullptr)
+            {
+                m_pCompressors[m_compressorCount++] = pCompressor;
+            }
+            else if (m_compressorCount == 0)
+            {
+                // Nothing to wait for.
+                break;
+            }
+            else
+            {
+                m_compressorReleased.Wait(&m_compressorMutex, UINT32_MAX);
+            }
+        }
+        else
+        {
+            m_compressorReleased.Wait(&m_compressorMutex, UINT32_MAX);
+        }
+    }
+
+    return pCompressor;
+}
+
+// =====================================================================================================================
+// Returns a compressor checked out by AcquireCompressor() to the pool.
+void CompressingCacheLayer::ReleaseCompressor(
+    Lz4Compressor* pCompressor)
+{
+    MutexAuto lock(&m_compressorMutex);
+
+    PAL_ASSERT(m_freeCompressorCount < m_compressorCount);
+    m_pFreeCompressors[m_freeCompressorCount++] = pCompressor;
+    m_compressorReleased.WakeOne();
+}
+
+// =====================================================================================================================
+// Compresses pData into a newly allocated buffer, which the caller must free with m_allocator. Returns
+// Result::Unsupported if the data did not compress to a smaller size.
+Result CompressingCacheLayer::Compress(
+    const void* pData,
+    size_t      dataSize,
+    void**      ppCompressed,
+    size_t*     pCompressedSize)
+{
+    Result result = Result::Success;
+
+    PAL_ASSERT(dataSize <= INT_MAX);
+    const int neededSize       = m_compressor.GetCompressBound(int(dataSize));
+    void*     pCompressedBuffer = PAL_MALLOC(neededSize, &m_allocator, AllocInternalTemp);
+
+    if (pCompressedBuffer == nullptr)
+    {
+        result = Result::ErrorOutOfMemory;
+    }
+    else
+    {
+        int            bytesWritten = 0;
+        Lz4Compressor* pCompressor  = AcquireCompressor();
+
+        if (pCompressor == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+        else
+        {
+            result = pCompressor->Compress(static_cast<const char*>(pData),
+                                           static_cast<char*>(pCompressedBuffer),
+                                           int(dataSize),
+                                           neededSize,
+                                           &bytesWritten);
+            ReleaseCompressor(pCompressor);
+        }
+
+        if ((result == Result::Success) && ((bytesWritten <= 0) || (size_t(bytesWritten) >= dataSize)))
+        {
+            result = Result::Unsupported;
+        }
+
+        if (result == Result::Success)
+        {
+            *ppCompressed    = pCompressedBuffer;
+            *pCompressedSize = size_t(bytesWritten);
+        }
+        else
+        {
+            PAL_SAFE_FREE(pCompressedBuffer, &m_allocator);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Copies an entry that was just stored uncompressed and hands it to the background thread for compression.
+Result CompressingCacheLayer::QueueCompression(
+    StoreFlags     storeFlags,
+    const Hash128* pHashId,
+    const void*    pData,
+    size_t         dataSize)
+{
+    Result result = Result::ErrorOutOfMemory;
+
+    PendingCompression pending = {};
+    pending.hashId     = *pHashId;
+    pending.storeFlags = storeFlags;
+    pending.dataSize   = dataSize;
+    pending.pData      = PAL_MALLOC(dataSize, &m_allocator, AllocInternalTemp);
+
+    if (pending.pData != nullptr)
+    {
+        memcpy(pending.pData, pData, dataSize);
+
+        MutexAuto lock(&m_pendingMutex);
+        result = m_pendingEntries.PushBack(pending);
+
+        if (result == Result::Success)
+        {
+            m_pendingCondition.WakeOne();
+        }
+        else
+        {
+            PAL_SAFE_FREE(pending.pData, &m_allocator);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void CompressingCacheLayer::CompressThreadFunc(
+    void* pParam)
+{
+    static_cast<CompressingCacheLayer*>(pParam)->CompressPendingEntries();
+}
+
+// =====================================================================================================================
+// Background thread loop: compresses queued entries and swaps them in for their uncompressed versions.
+void CompressingCacheLayer::CompressPendingEntries()
+{
+    bool stop = false;
+
+    while (stop == false)
+    {
+        PendingCompression pending = {};
+        {
+            MutexAuto lock(&m_pendingMutex);
+            while ((m_stopCompressThread == false) && (m_pendingEntries.NumElements() == 0))
+            {
+                m_pendingCondition.Wait(&m_pendingMutex, UINT32_MAX);
+            }
+
+            stop = m_stopCompressThread || (m_pendingEntries.PopFront(&pending) != Result::Success);
+        }
+
+        if (stop == false)
+        {
+            void*  pCompressed    = nullptr;
+            size_t compressedSize = 0;
+
+            if (Compress(pending.pData, pending.dataSize, &pCompressed, &compressedSize) == Result::Success)
+            {
+                // Have the next layer swap the compressed version in for the uncompressed one. The uncompressed
+                // entry stays in place until the compressed one is stored, so a concurrent lookup always finds one
+                // of the two; if the next layer can't replace entries the uncompressed one is simply kept.
+                StoreFlags storeFlags      = pending.storeFlags;
+                storeFlags.replaceExisting = 1;
+
+                m_pNextLayer->Store(storeFlags,
+                                    &pending.hashId,
+                                    pCompressed,
+                                    pending.dataSize,
+                                    compressedSize);
+
+                PAL_SAFE_FREE(pCompressed, &m_allocator);
+            }
+
+            PAL_SAFE_FREE(pending.pData, &m_allocator);
+        }
+    }
 }
 
 // =====================================================================================================================
@@ -133,46 +394,46 @@ Result CompressingCacheLayer::Store(
         }
         else
         {
-            PAL_ASSERT(storeSize <= INT_MAX);
-            int neededSize = m_compressor.GetCompressBound(int(storeSize));
-            void* compressedBuffer = PAL_MALLOC(neededSize, &m_allocator, AllocInternalTemp);
-            if (compressedBuffer == nullptr)
+            void*  pCompressed    = nullptr;
+            size_t compressedSize = 0;
+
+            if (m_asyncCompression)
             {
-                result = Result::ErrorOutOfMemory;
+                // Store the uncompressed version now and have the background thread swap in the compressed one.
+                result = m_pNextLayer->Store(
+                    storeFlags,
+                    pHashId,
+                    pData,
+                    dataSize,
+                    storeSize);
+
+                if (result == Result::Success)
+                {
+                    // Failing to queue only costs us the compression.
+                    QueueCompression(storeFlags, pHashId, pData, dataSize);
+                }
+            }
+            else if (Compress(pData, dataSize, &pCompressed, &compressedSize) == Result::Success)
+            {
+                // Store the compressed version.
+                result = m_pNextLayer->Store(
+                    storeFlags,
+                    pHashId,
+                    pCompressed,
+                    storeSize,
+                    compressedSize);
+
+                PAL_SAFE_FREE(pCompressed, &m_allocator);
             }
             else
             {
-                int bytesWritten = 0;
-                m_compressMutex.Lock();
-                result = m_compressor.Compress(static_cast<const char*>(pData),
-                                               static_cast<char*>(compressedBuffer),
-                                               int(storeSize),
-                                               neededSize,
-                                               &bytesWritten);
-                m_compressMutex.Unlock();
-
-                if((result == Result::Success) && (bytesWritten > 0) && (size_t(bytesWritten) < dataSize))
-                {
-                    // Store the compressed version.
-                    result = m_pNextLayer->Store(
-                        storeFlags,
-                        pHashId,
-                        compressedBuffer,
-                        storeSize,
-                        bytesWritten);
-                }
-                else
-                {
-                    // There was some sort of problem during compression... just store the uncompressed version.
-                    result = m_pNextLayer->Store(
-                        storeFlags,
-                        pHashId,
-                        pData,
-                        dataSize,
-                        storeSize);
-                }
-
-                PAL_SAFE_FREE(compressedBuffer, &m_allocator);
+                // There was some sort of problem during compression... just store the uncompressed version.
+                result = m_pNextLayer->Store(
+                    storeFlags,
+                    pHashId,
+                    pData,
+                    dataSize,
+                    storeSize);
             }
         }
     }
@@ -196,43 +457,68 @@ Result CompressingCacheLayer::Load(
     }
     else
     {
-        void* compressedBuffer = PAL_MALLOC(pQuery->storeSize, &m_allocator, AllocInternalTemp);
-        if (compressedBuffer == nullptr)
+        result = LoadFromNextLayer(pQuery, pBuffer);
+
+        // The background thread may have swapped the entry for its compressed copy since it was queried, which the
+        // next layer reports like an eviction. The data is the same, so query the replacement and load that instead.
+        QueryResult query = {};
+
+        if (m_asyncCompression                                                      &&
+            (result == Result::ErrorInvalidPointer)                                 &&
+            (m_pNextLayer->Query(&pQuery->hashId, 0, 0, &query) == Result::Success) &&
+            (query.dataSize == pQuery->dataSize))
         {
-            result = Result::ErrorOutOfMemory;
+            result = LoadFromNextLayer(&query, pBuffer);
         }
-        else
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Loads an entry from the next layer and decompresses it into the caller's buffer.
+Result CompressingCacheLayer::LoadFromNextLayer(
+    const QueryResult* pQuery,
+    void*              pBuffer)
+{
+    Result result = Result::ErrorUnknown;
+
+    void* compressedBuffer = PAL_MALLOC(pQuery->storeSize, &m_allocator, AllocInternalTemp);
+    if (compressedBuffer == nullptr)
+    {
+        result = Result::ErrorOutOfMemory;
+    }
+    else
+    {
+        result = m_pNextLayer->Load(pQuery, compressedBuffer);
+
+        if (result == Result::Success)
         {
-            result = m_pNextLayer->Load(pQuery, compressedBuffer);
+            PAL_ASSERT(pQuery->storeSize <= INT_MAX);
+            PAL_ASSERT(pQuery->dataSize  <= INT_MAX);
+            int neededSize = m_compressor.GetDecompressedSize(static_cast<const char*>(compressedBuffer),
+                                                              static_cast<int>(pQuery->storeSize));
+            if (neededSize > 0)
+            {
+                // Decompress the data
+                PAL_ASSERT(static_cast<size_t>(neededSize) == pQuery->dataSize);
 
-            if (result == Result::Success)
+                int bytesWritten = 0;
+                result = m_compressor.Decompress(static_cast<const char*>(compressedBuffer),
+                                                 static_cast<char*>(pBuffer),
+                                                 static_cast<int>(pQuery->storeSize),
+                                                 static_cast<int>(pQuery->dataSize),
+                                                 &bytesWritten);
+                PAL_ASSERT(bytesWritten == neededSize);
+            }
+            else
             {
-                PAL_ASSERT(pQuery->storeSize <= INT_MAX);
-                PAL_ASSERT(pQuery->dataSize  <= INT_MAX);
-                int neededSize = m_compressor.GetDecompressedSize(static_cast<const char*>(compressedBuffer),
-                                                                  static_cast<int>(pQuery->storeSize));
-                if (neededSize > 0)
-                {
-                    // Decompress the data
-                    PAL_ASSERT(static_cast<size_t>(neededSize) == pQuery->dataSize);
-
-                    int bytesWritten = 0;
-                    result = m_compressor.Decompress(static_cast<const char*>(compressedBuffer),
-                                                     static_cast<char*>(pBuffer),
-                                                     static_cast<int>(pQuery->storeSize),
-                                                     static_cast<int>(pQuery->dataSize),
-                                                     &bytesWritten);
-                    PAL_ASSERT(bytesWritten == neededSize);
-                }
-                else
-                {
-                    // The data doesn't seem to be compressed- just try to memcpy it from our buffer.
-                    memcpy(pBuffer, compressedBuffer, pQuery->dataSize);
-                }
+                // The data doesn't seem to be compressed- just try to memcpy it from our buffer.
+                memcpy(pBuffer, compressedBuffer, pQuery->dataSize);
             }
-
-            PAL_SAFE_FREE(compressedBuffer, &m_allocator);
         }
+
+        PAL_SAFE_FREE(compressedBuffer, &m_allocator);
     }
 
     return result;
@@ -288,7 +574,8 @@ Result CreateCompressingCacheLayer(
         pLayer = PAL_PLACEMENT_NEW(pPlacementAddr) CompressingCacheLayer(
             (pCreateInfo->pCallbacks == nullptr) ? callbacks : *pCreateInfo->pCallbacks,
              pCreateInfo->useHighCompression,
-             pCreateInfo->decompressOnly);
+             pCreateInfo->decompressOnly,
+             pCreateInfo->asyncCompression);
 
         result = pLayer->Init();
 
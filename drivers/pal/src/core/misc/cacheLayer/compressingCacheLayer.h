@@ -28,7 +28,10 @@
 #include "palCacheLayer.h"
 
 #include "util/lz4Compressor.h"
+#include "palConditionVariable.h"
+#include "palDeque.h"
 #include "palMutex.h"
+#include "palThread.h"
 
 namespace Util
 {
@@ -38,7 +41,11 @@ namespace Util
 class CompressingCacheLayer : public ICacheLayer
 {
 public:
-    CompressingCacheLayer(const AllocCallbacks& callbacks, bool useHighCompression, bool decompressOnly);
+    CompressingCacheLayer(
+        const AllocCallbacks& callbacks,
+        bool                  useHighCompression,
+        bool                  decompressOnly,
+        bool                  asyncCompression);
 
     virtual ~CompressingCacheLayer();
 
@@ -96,11 +103,52 @@ private:
     PAL_DISALLOW_DEFAULT_CTOR(CompressingCacheLayer);
     PAL_DISALLOW_COPY_AND_ASSIGN(CompressingCacheLayer);
 
-    Lz4Compressor    m_compressor;
+    // Upper bound on the number of compressors, and so on the number of stores compressing concurrently.
+    static constexpr uint32 MaxCompressors = 16;
+
+    // An uncompressed entry waiting to be replaced by its compressed form on the background thread.
+    struct PendingCompression
+    {
+        Hash128    hashId;
+        StoreFlags storeFlags;
+        void*      pData;
+        size_t     dataSize;
+    };
+
+    Lz4Compressor* AcquireCompressor();
+    void ReleaseCompressor(Lz4Compressor* pCompressor);
+
+    Result Compress(const void* pData, size_t dataSize, void** ppCompressed, size_t* pCompressedSize);
+
+    Result LoadFromNextLayer(const QueryResult* pQuery, void* pBuffer);
+
+    Result QueueCompression(StoreFlags storeFlags, const Hash128* pHashId, const void* pData, size_t dataSize);
+
+    static void CompressThreadFunc(void* pParam);
+    void CompressPendingEntries();
+
+    Lz4Compressor    m_compressor;        // Used for decompression and as the first pooled compressor
     ForwardAllocator m_allocator;
-    Mutex            m_compressMutex;
+    AllocCallbacks   m_callbacks;         // Used to create additional compressors
     ICacheLayer*     m_pNextLayer;
+    const bool       m_useHighCompression;
     bool             m_decompressOnly;
+    const bool       m_asyncCompression;
+
+    // Compress() relies on per-compressor state, so each concurrent store checks out its own compressor.
+    Mutex             m_compressorMutex;
+    ConditionVariable m_compressorReleased;
+    Lz4Compressor*    m_pCompressors[MaxCompressors];      // All compressors created so far
+    Lz4Compressor*    m_pFreeCompressors[MaxCompressors];  // Compressors not currently in use
+    uint32            m_compressorCount;
+    uint32            m_freeCompressorCount;
+
+    // State of the background compression thread, only used if m_asyncCompression is set.
+    Mutex                                        m_pendingMutex;
+    ConditionVariable                            m_pendingCondition;
+    Deque<PendingCompression, ForwardAllocator>  m_pendingEntries;
+    Thread                                       m_compressThread;
+    bool                                         m_stopCompressThread;
 };
 
 } //namespace Util
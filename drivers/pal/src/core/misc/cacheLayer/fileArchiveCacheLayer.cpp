@@ -329,26 +329,25 @@ Result FileArchiveCacheLayer::LoadInternal(
         PAL_ALERT(header.ordinalId != pQuery->context.entryId);
         PAL_ALERT(header.metaValue > pQuery->dataSize);
 
-        const size_t readSize      = header.dataSize;
-        const size_t dataSize      = header.metaValue;
-
-        const size_t storeSize     = readSize;
+        const size_t storeSize = header.dataSize;
 
         PAL_ASSERT(storeSize == pQuery->storeSize);
 
-        void* const pReadMem = PAL_MALLOC(readSize, Allocator(), AllocInternalTemp);
-        void* const pDataMem = pReadMem;
-
-        if (pReadMem == nullptr)
-        {
-            result = Result::ErrorOutOfMemory;
-        }
+        // Prefer a pointer into the file mapping: the copy into pBuffer is then the only one, and it can be done
+        // without holding the archive lock.
+        const void* pMappedData = nullptr;
 
-        if (result == Result::Success)
         {
             MutexAuto archiveFileLock { &m_archiveFileMutex };
 
-            result = m_pArchivefile->Read(&header, pReadMem);
+            result = m_pArchivefile->GetEntryData(&header, &pMappedData);
+
+            // Either the archive isn't mapped or this entry was appended after it was; read the data instead
+            if (result == Result::Unsupported)
+            {
+                result = m_pArchivefile->Read(&header, pBuffer);
+                pMappedData = nullptr;
+            }
 
             // In the case that AsyncIO is not ready, signal Result::NotFound
             if (result == Result::NotReady)
@@ -359,14 +358,9 @@ Result FileArchiveCacheLayer::LoadInternal(
             PAL_ALERT(IsErrorResult(result));
         }
 
-        if (result == Result::Success)
-        {
-            memcpy(pBuffer, pDataMem, storeSize);
-        }
-
-        if (pReadMem != nullptr)
+        if ((result == Result::Success) && (pMappedData != nullptr))
         {
-            PAL_FREE(pReadMem, Allocator());
+            memcpy(pBuffer, pMappedData, storeSize);
         }
     }
 
@@ -22,10 +22,11 @@
  *  SOFTWARE.
  *
  **********************************************************************************************************************/
-
 #include "memoryCacheLayer.h"
 #include "palHashMapImpl.h"
+#include "palHashSetImpl.h"
 #include "palIntrusiveListImpl.h"
+#include "palVectorImpl.h"
 #include "palAssert.h"
 #include "core/platform.h"
 
@@ -38,44 +39,81 @@ MemoryCacheLayer::MemoryCacheLayer(
     size_t                maxMemorySize,
     size_t                maxObjectCount,
     uint32                expectedEntries,
+    uint32                numShards,
     bool                  evictOnFull,
-    bool                  evictDuplicates)
+    bool                  evictDuplicates,
+    MemoryCacheNotifyFunc pfnNotify,
+    void*                 pNotifyClientData,
+    void*                 pShardMem)
     :
-    CacheLayerBase    { callbacks },
-    m_maxSize         { maxMemorySize },
-    m_maxCount        { maxObjectCount },
-    m_evictOnFull     { evictOnFull },
-    m_evictDuplicates { evictDuplicates },
-    m_lock            {},
-    m_curSize         { 0 },
-    m_curCount        { 0 },
-    m_recentEntryList {},
-    m_entryLookup     { ((expectedEntries == 0) ? 0x4000 : expectedEntries), Allocator() }
+    CacheLayerBase      { callbacks },
+    m_maxSize           { maxMemorySize },
+    m_maxCount          { maxObjectCount },
+    m_evictOnFull       { evictOnFull },
+    m_evictDuplicates   { evictDuplicates },
+    m_pfnNotify         { pfnNotify },
+    m_pNotifyClientData { pNotifyClientData },
+    m_numShards         { ClampShardCount(numShards) },
+    m_pShards           { static_cast<Shard*>(pShardMem) },
+    m_curSize           { 0 },
+    m_curCount          { 0 }
 {
+    const uint32 totalEntries    = (expectedEntries == 0) ? 0x4000 : expectedEntries;
+    const uint32 entriesPerShard = Max(totalEntries / m_numShards, 1u);
+
+    for (uint32 i = 0; i < m_numShards; i++)
+    {
+        PAL_PLACEMENT_NEW(&m_pShards[i]) Shard(entriesPerShard, Allocator());
+    }
 }
 
 // =====================================================================================================================
 MemoryCacheLayer::~MemoryCacheLayer()
 {
-    RWLockAuto<RWLock::ReadWrite> lock { &m_lock };
-    while (m_recentEntryList.IsEmpty() == false)
+    for (uint32 i = 0; i < m_numShards; i++)
     {
-        Entry* pEntry = m_recentEntryList.Front();
-        m_entryLookup.Erase(*pEntry->HashId());
-        m_recentEntryList.Erase(pEntry->ListNode());
-        pEntry->Destroy();
+        Shard* const pShard = &m_pShards[i];
+
+        {
+            RWLockAuto<RWLock::ReadWrite> lock { &pShard->lock };
+            while (pShard->recentEntryList.IsEmpty() == false)
+            {
+                Entry* pEntry = pShard->recentEntryList.Front();
+                pShard->entryLookup.Erase(*pEntry->HashId());
+                pShard->recentEntryList.Erase(pEntry->ListNode());
+                pEntry->Destroy();
+            }
+        }
+
+        pShard->~Shard();
     }
 }
 
+// =====================================================================================================================
+// Rounds a requested shard count to the power of two actually used
+uint32 MemoryCacheLayer::ClampShardCount(
+    uint32 numShards)
+{
+    return (numShards == 0) ? DefaultShardCount : Pow2Pad(Min(numShards, MaxShardCount));
+}
+
+// =====================================================================================================================
+// The shards are placed directly after the layer object
+size_t MemoryCacheLayer::GetPlacementSize(
+    uint32 numShards)
+{
+    return sizeof(MemoryCacheLayer) + (ClampShardCount(numShards) * sizeof(Shard));
+}
+
 // =====================================================================================================================
 // Initialize the cache layer
 Result MemoryCacheLayer::Init()
 {
     Result result = CacheLayerBase::Init();
 
-    if (result == Result::Success)
+    for (uint32 i = 0; (i < m_numShards) && (result == Result::Success); i++)
     {
-        result = m_entryLookup.Init();
+        result = m_pShards[i].entryLookup.Init();
     }
 
     return result;
@@ -90,10 +128,12 @@ Result MemoryCacheLayer::QueryInternal(
     Result result = Result::Success;
 
     Entry** ppFound = nullptr;
+    Shard*  pShard  = GetShard(pHashId);
 
-    RWLockAuto<RWLock::ReadWrite> lock { &m_lock };
+    // A hit only marks the entry as referenced, so lookups can share the shard
+    RWLockAuto<RWLock::ReadOnly> lock { &pShard->lock };
 
-    ppFound = m_entryLookup.FindKey(*pHashId);
+    ppFound = pShard->entryLookup.FindKey(*pHashId);
 
     if (ppFound == nullptr)
     {
@@ -101,9 +141,7 @@ Result MemoryCacheLayer::QueryInternal(
     }
     else if (*ppFound != nullptr)
     {
-        Entry::Node* pNode = (*ppFound)->ListNode();
-        m_recentEntryList.Erase(pNode);
-        m_recentEntryList.PushBack(pNode);
+        (*ppFound)->MarkReferenced();
 
         pQuery->hashId             = *pHashId;
         pQuery->pLayer             = this;
@@ -146,84 +184,79 @@ Result MemoryCacheLayer::StoreInternal(
         result = Result::ErrorInvalidValue;
     }
 
-    bool setData = false;
+    Shard* const pShard    = (result == Result::Success) ? GetShard(pHashId) : nullptr;
+    bool         reserved  = false;
+    bool         replacing = false;
+    size_t       spaceSize = storeSize;
+
     if (result == Result::Success)
     {
-        RWLockAuto<RWLock::ReadWrite> lock { &m_lock };
-
-        bool keepGoing;
-        do
-        {
-            keepGoing = false;
+        RWLockAuto<RWLock::ReadWrite> lock { &pShard->lock };
 
-            // Check if this hash is already in the cahce.
-            // If so then we'll delete the existing entry and write a new one.
-            Entry** ppFound = m_entryLookup.FindKey(*pHashId);
+        // Check if this hash is already in the cahce.
+        // If so then we'll delete the existing entry and write a new one.
+        Entry** ppFound = pShard->entryLookup.FindKey(*pHashId);
 
-            // See if there's a hash collision.
-            if (ppFound != nullptr)
+        // See if there's a hash collision.
+        if (ppFound != nullptr)
+        {
+            // See if the entry at that collision is valid. If not then something has gone wrong.
+            if (*ppFound != nullptr)
             {
-                // See if the entry at that collision is valid. If not then something has gone wrong.
-                if (*ppFound != nullptr)
+                // See if that entry is empty. If so then that means it was created in Reserve().
+                if ((*ppFound)->Data() == nullptr)
                 {
-                    // See if that entry is empty. If so then that means it was created in PromoteData().
-                    if ((*ppFound)->Data() == nullptr)
-                    {
-                        const size_t prevSize = m_curSize;
-
-                        // The entry already exists, but when it was created in PromoteData() we didn't reserve
-                        // space for it because we didn't know how big it would be until now.
-                        result = EnsureAvailableSpace(storeSize, 1);
-
-                        // If we're full and we can't evict then get outta here.
-                        if (result == Result::ErrorShaderCacheFull)
-                        {
-                            PAL_ASSERT(m_curSize == prevSize);
-                            PAL_ASSERT(m_evictOnFull == false);
-                            break;
-                        }
-
-                        // If we deleted any entries, we need to start over. We could've just deleted this entry.
-                        if (m_curSize != prevSize)
-                        {
-                            keepGoing = true;
-                            continue;
-                        }
-
-                        if (result == Result::Success)
-                        {
-                            result = SetDataToEntry(*ppFound, pData, dataSize, storeSize);
-                        }
-                        if (result == Result::Success)
-                        {
-                            setData = true;
-                            m_conditionVariable.WakeAll();
-                        }
-                    }
-                    else if (m_evictDuplicates)
-                    {
-                        result = EvictEntryFromCache(*ppFound);
-                        m_conditionVariable.WakeAll();
-                    }
-                    else
-                    {
-                        result = Result::AlreadyExists;
-                    }
+                    reserved = true;
+                }
+                else if (storeFlags.replaceExisting)
+                {
+                    // Keep the existing entry until the new one is ready to take its place, so the id never goes
+                    // missing in between. Only the growth (if any) needs to be made room for.
+                    replacing = true;
+                    spaceSize = (storeSize > (*ppFound)->StoreSize()) ? (storeSize - (*ppFound)->StoreSize()) : 0;
+                }
+                else if (m_evictDuplicates)
+                {
+                    result = EvictEntryFromCache(pShard, *ppFound);
+                    m_conditionVariable.WakeAll();
                 }
                 else
                 {
-                    result = Result::ErrorUnknown;
+                    result = Result::AlreadyExists;
                 }
             }
+            else
+            {
+                result = Result::ErrorUnknown;
+            }
         }
-        while (keepGoing);
     }
 
-    if ((result == Result::Success) && (setData == false))
+    // A reserved entry is already counted, but it didn't reserve space because we didn't know how big it would be
+    // until now.
+    if (result == Result::Success)
     {
-        RWLockAuto<RWLock::ReadWrite> lock { &m_lock };
+        result = EnsureAvailableSpace(pShard, spaceSize, (reserved || replacing) ? 0 : 1);
+    }
+
+    bool setData = false;
+
+    if ((result == Result::Success) && reserved)
+    {
+        RWLockAuto<RWLock::ReadWrite> lock { &pShard->lock };
+
+        // Making space may have evicted the reserved entry, in which case we store a new one below.
+        Entry** ppFound = pShard->entryLookup.FindKey(*pHashId);
 
-        result = EnsureAvailableSpace(storeSize, 1);
+        if ((ppFound != nullptr) && ((*ppFound)->Data() == nullptr))
+        {
+            result = SetDataToEntry(*ppFound, pData, dataSize, storeSize);
+            if (result == Result::Success)
+            {
+                setData = true;
+                m_conditionVariable.WakeAll();
+            }
+        }
     }
 
     if ((result == Result::Success) && (setData == false))
@@ -232,9 +265,21 @@ Result MemoryCacheLayer::StoreInternal(
 
         if (pEntry != nullptr)
         {
-            RWLockAuto<RWLock::ReadWrite> lock { &m_lock };
+            RWLockAuto<RWLock::ReadWrite> lock { &pShard->lock };
 
-            result = AddEntryToCache(pEntry);
+            // Another thread may have stored the same id while no lock was held
+            Entry** ppFound = pShard->entryLookup.FindKey(*pHashId);
+
+            if ((ppFound != nullptr) && replacing && ((*ppFound)->Data() != nullptr))
+            {
+                // Swap the new entry in under the same lock the old one is removed under. An entry that is pinned
+                // by a zero-copy reference can't be replaced; the caller keeps the existing data in that case.
+                result = ReplaceEntryInCache(pShard, ppFound, pEntry);
+            }
+            else
+            {
+                result = (ppFound == nullptr) ? AddEntryToCache(pShard, pEntry) : Result::AlreadyExists;
+            }
 
             if (result != Result::Success)
             {
@@ -267,19 +312,26 @@ Result MemoryCacheLayer::LoadInternal(
     else
     {
         Entry** ppFound = nullptr;
+        Shard*  pShard  = GetShard(&pQuery->hashId);
 
-        RWLockAuto<RWLock::ReadOnly> lock { &m_lock };
+        RWLockAuto<RWLock::ReadOnly> lock { &pShard->lock };
 
-        ppFound = m_entryLookup.FindKey(pQuery->hashId);
+        ppFound = pShard->entryLookup.FindKey(pQuery->hashId);
         if (ppFound != nullptr)
         {
-            if ((*ppFound)->Data())
+            if ((*ppFound)->Data() == nullptr)
             {
-                memcpy(pBuffer, (*ppFound)->Data(), (*ppFound)->StoreSize());
+                result = Result::NotReady;
+            }
+            else if ((*ppFound)->StoreSize() != pQuery->storeSize)
+            {
+                // The entry was replaced (e.g. by its compressed copy) after it was queried, so the caller's buffer
+                // was sized for the old one. Treat it like an evicted entry.
+                result = Result::ErrorInvalidPointer;
             }
             else
             {
-                result = Result::NotReady;
+                memcpy(pBuffer, (*ppFound)->Data(), (*ppFound)->StoreSize());
             }
         }
         else
@@ -305,10 +357,11 @@ Result MemoryCacheLayer::AcquireCacheRef(
     else
     {
         Entry** ppFound = nullptr;
+        Shard*  pShard  = GetShard(&pQuery->hashId);
 
-        RWLockAuto<RWLock::ReadOnly> lock { &m_lock };
+        RWLockAuto<RWLock::ReadOnly> lock { &pShard->lock };
 
-        ppFound = m_entryLookup.FindKey(pQuery->hashId);
+        ppFound = pShard->entryLookup.FindKey(pQuery->hashId);
         if (ppFound != nullptr)
         {
             (*ppFound)->IncreaseRef();
@@ -335,15 +388,16 @@ Result MemoryCacheLayer::ReleaseCacheRef(
     else
     {
         Entry** ppFound = nullptr;
+        Shard*  pShard  = GetShard(&pQuery->hashId);
 
-        RWLockAuto<RWLock::ReadWrite> writeLock { &m_lock };
-        ppFound = m_entryLookup.FindKey(pQuery->hashId);
+        RWLockAuto<RWLock::ReadWrite> writeLock { &pShard->lock };
+        ppFound = pShard->entryLookup.FindKey(pQuery->hashId);
         if (ppFound != nullptr)
         {
             (*ppFound)->DecreaseRef();
             if ((*ppFound)->IsBad())
             {
-                result = EvictEntryFromCache(*ppFound);
+                result = EvictEntryFromCache(pShard, *ppFound);
                 m_conditionVariable.WakeAll();
             }
         }
@@ -372,10 +426,11 @@ Result MemoryCacheLayer::GetCacheData(
     else
     {
         Entry** ppFound = nullptr;
+        Shard*  pShard  = GetShard(&pQuery->hashId);
 
-        RWLockAuto<RWLock::ReadOnly> lock { &m_lock };
+        RWLockAuto<RWLock::ReadOnly> lock { &pShard->lock };
 
-        ppFound = m_entryLookup.FindKey(pQuery->hashId);
+        ppFound = pShard->entryLookup.FindKey(pQuery->hashId);
         if (ppFound != nullptr)
         {
             if ((*ppFound)->Data())
@@ -412,13 +467,14 @@ Result MemoryCacheLayer::WaitForEntry(
     else
     {
         Entry** ppFound = nullptr;
+        Shard*  pShard  = GetShard(pHashId);
 
         m_conditionMutex.Lock();
         for (;;)
         {
             {
-                RWLockAuto<RWLock::ReadOnly> lock{ &m_lock };
-                ppFound = m_entryLookup.FindKey(*pHashId);
+                RWLockAuto<RWLock::ReadOnly> lock{ &pShard->lock };
+                ppFound = pShard->entryLookup.FindKey(*pHashId);
                 if (ppFound == nullptr)
                 {
                     result = Result::NotFound;
@@ -457,12 +513,13 @@ Result MemoryCacheLayer::Evict(
     else
     {
         Entry** ppFound = nullptr;
+        Shard*  pShard  = GetShard(pHashId);
 
-        RWLockAuto<RWLock::ReadWrite> writeLock{ &m_lock };
-        ppFound = m_entryLookup.FindKey(*pHashId);
+        RWLockAuto<RWLock::ReadWrite> writeLock{ &pShard->lock };
+        ppFound = pShard->entryLookup.FindKey(*pHashId);
         if (ppFound != nullptr)
         {
-            result = EvictEntryFromCache(*ppFound);
+            result = EvictEntryFromCache(pShard, *ppFound);
             m_conditionVariable.WakeAll();
         }
         else
@@ -488,9 +545,10 @@ Result MemoryCacheLayer::MarkEntryBad(
     else
     {
         Entry** ppFound = nullptr;
+        Shard*  pShard  = GetShard(pHashId);
 
-        RWLockAuto<RWLock::ReadWrite> writeLock{ &m_lock };
-        ppFound = m_entryLookup.FindKey(*pHashId);
+        RWLockAuto<RWLock::ReadWrite> writeLock{ &pShard->lock };
+        ppFound = pShard->entryLookup.FindKey(*pHashId);
         if (ppFound != nullptr)
         {
             (*ppFound)->SetIsBad(true);
@@ -507,100 +565,88 @@ Result MemoryCacheLayer::MarkEntryBad(
 }
 
 // =====================================================================================================================
-// Evict entries until a specified count is reached
-Result MemoryCacheLayer::EvictEntryByCount(
-    size_t numToEvict)
+// Evict one entry from a shard using the CLOCK policy: walk the entry list from the front, rotating referenced entries
+// to the back with their flag cleared, until an unreferenced entry is found. Entries pinned by a cache reference are
+// rotated as well. Returns false if every entry in the shard is pinned or the shard is empty.
+bool MemoryCacheLayer::EvictNextEntry(
+    Shard* pShard)
 {
-    Result result = Result::Success;
+    bool evicted = false;
 
-    size_t numEvicted = 0;
+    // Two passes are enough: the first clears every referenced flag
+    const uint32 maxSteps = pShard->entryLookup.GetNumEntries() * 2;
 
-    while ((result == Result::Success) &&
-           (numEvicted < numToEvict))
+    for (uint32 step = 0; (step < maxSteps) && (evicted == false); step++)
     {
-        Entry* const pEntry = m_recentEntryList.Front();
+        Entry* const pEntry = pShard->recentEntryList.Front();
 
-        if (pEntry != nullptr)
+        if ((pEntry->TestAndClearReferenced() == false) &&
+            (EvictEntryFromCache(pShard, pEntry) == Result::Success))
         {
-            result = EvictEntryFromCache(pEntry);
-
-            if (result == Result::Success)
-            {
-                ++numEvicted;
-            }
+            evicted = true;
         }
         else
         {
-            result = Result::ErrorShaderCacheFull;
+            pShard->recentEntryList.Erase(pEntry->ListNode());
+            pShard->recentEntryList.PushBack(pEntry->ListNode());
         }
     }
 
-    if (numEvicted > 0)
-    {
-        m_conditionVariable.WakeAll();
-    }
-
-    return result;
+    return evicted;
 }
 
 // =====================================================================================================================
-// Evict entries until a specified size is reached
-Result MemoryCacheLayer::EvictEntryBySize(
-    size_t minSizeToEvict)
+// Remove an entry from the cache table, list, and metrics.
+Result MemoryCacheLayer::EvictEntryFromCache(
+    Shard* pShard,
+    Entry* pEntry)
 {
-    Result result = Result::Success;
+    PAL_ASSERT(pEntry != nullptr);
 
-    size_t evictedSize = 0;
+    Result result = Result::ErrorUnknown;
 
-    while ((result == Result::Success) &&
-           (evictedSize < minSizeToEvict))
+    if (pEntry->CanEvict())
     {
-        Entry* const pEntry = m_recentEntryList.Front();
-
-        if (pEntry != nullptr)
+        if (pShard->entryLookup.Erase(*pEntry->HashId()))
         {
-            const size_t storeSize = pEntry->StoreSize();
+            result = Result::Success;
 
-            result = EvictEntryFromCache(pEntry);
+            pShard->recentEntryList.Erase(pEntry->ListNode());
+            AtomicAdd64(&m_curSize, uint64(0) - pEntry->StoreSize());
+            AtomicDecrement64(&m_curCount);
 
-            if (result == Result::Success)
+            // Reserved entries were never reported as added
+            if (pEntry->Data() != nullptr)
             {
-                evictedSize += storeSize;
+                Notify(MemoryCacheEvent::EntryRemoved, pEntry->HashId());
             }
-        }
-        else
-        {
-            result = Result::ErrorShaderCacheFull;
-        }
-    }
 
-    if (evictedSize > 0)
-    {
-        m_conditionVariable.WakeAll();
+            pEntry->Destroy();
+        }
     }
 
     return result;
 }
 
 // =====================================================================================================================
-// Remove an entry from the cache table, list, and metrics.
-Result MemoryCacheLayer::EvictEntryFromCache(
+// Insert the entry into our cache lookup table and CLOCK list
+Result MemoryCacheLayer::AddEntryToCache(
+    Shard* pShard,
     Entry* pEntry)
 {
     PAL_ASSERT(pEntry != nullptr);
 
-    Result result = Result::ErrorUnknown;
+    Result result = pShard->entryLookup.Insert(*pEntry->HashId(), pEntry);
 
-    if (pEntry->CanEvict())
+    if (result == Result::Success)
     {
-        if (m_entryLookup.Erase(*pEntry->HashId()))
-        {
-            result = Result::Success;
+        pShard->recentEntryList.PushBack(pEntry->ListNode());
+        AtomicAdd64(&m_curSize, pEntry->StoreSize());
+        AtomicIncrement64(&m_curCount);
 
-            m_recentEntryList.Erase(pEntry->ListNode());
-            m_curSize -= pEntry->StoreSize();
-            m_curCount -= 1;
-            pEntry->Destroy();
+        if (pEntry->Data() != nullptr)
+        {
+            Notify(MemoryCacheEvent::EntryAdded, pEntry->HashId());
         }
     }
 
@@ -608,19 +654,28 @@ Result MemoryCacheLayer::EvictEntryFromCache(
 }
 
 // =====================================================================================================================
-// Insert the entry into our cache lookup table and LRU list
-Result MemoryCacheLayer::AddEntryToCache(
-    Entry* pEntry)
+// Swap a new entry in for the existing entry with the same id, which keeps its place in the lookup table
+Result MemoryCacheLayer::ReplaceEntryInCache(
+    Shard*  pShard,
+    Entry** ppExisting,
+    Entry*  pEntry)
 {
-    PAL_ASSERT(pEntry != nullptr);
+    PAL_ASSERT((*ppExisting != nullptr) && (pEntry != nullptr));
 
-    Result result = m_entryLookup.Insert(*pEntry->HashId(), pEntry);
+    Result result = Result::AlreadyExists;
+    Entry* pOld   = *ppExisting;
 
-    if (result == Result::Success)
+    if (pOld->CanEvict())
     {
-        m_recentEntryList.PushBack(pEntry->ListNode());
-        m_curSize += pEntry->StoreSize();
-        m_curCount++;
+        result      = Result::Success;
+        *ppExisting = pEntry;
+
+        pShard->recentEntryList.Erase(pOld->ListNode());
+        pShard->recentEntryList.PushBack(pEntry->ListNode());
+        AtomicAdd64(&m_curSize, uint64(pEntry->StoreSize()) - pOld->StoreSize());
+        pOld->Destroy();
+
+        Notify(MemoryCacheEvent::EntryReplaced, pEntry->HashId());
     }
 
     return result;
@@ -643,7 +698,8 @@ Result MemoryCacheLayer::SetDataToEntry(
 
         if (result == Result::Success)
         {
-            m_curSize += storeSize;
+            AtomicAdd64(&m_curSize, storeSize);
+            Notify(MemoryCacheEvent::EntryAdded, pEntry->HashId());
         }
     }
 
@@ -651,42 +707,43 @@ Result MemoryCacheLayer::SetDataToEntry(
 }
 
 // =====================================================================================================================
-// Ensure size requested is available within the cache, may evict data
+// Ensure size requested is available within the cache, may evict data. Evicts from the shard the new entry will go to
+// first, then moves on to the other shards. Only one shard lock is held at a time, so concurrent stores may overshoot
+// the limits by the entries they add in the meantime.
 Result MemoryCacheLayer::EnsureAvailableSpace(
-    size_t entrySize,
-    size_t entryCount)
+    const Shard* pHomeShard,
+    size_t       entrySize,
+    size_t       entryCount)
 {
     PAL_ASSERT(entrySize <= m_maxSize);
     PAL_ASSERT(entryCount <= m_maxCount);
 
-    Result result = Result::Success;
-
-    const size_t availableCount = m_maxCount - m_curCount;
+    const uint32 homeIndex = uint32(pHomeShard - m_pShards);
+    bool         evicted   = false;
+    bool         hasSpace  = (NeedsSpace(entrySize, entryCount) == false);
 
-    if (entryCount > availableCount)
+    for (uint32 i = 0; (i < m_numShards) && m_evictOnFull && (hasSpace == false); i++)
     {
-        result = Result::ErrorShaderCacheFull;
+        Shard* const pShard = &m_pShards[(homeIndex + i) & (m_numShards - 1)];
+
+        RWLockAuto<RWLock::ReadWrite> lock { &pShard->lock };
 
-        if (m_evictOnFull)
+        while (NeedsSpace(entrySize, entryCount) && EvictNextEntry(pShard))
         {
-            result = EvictEntryByCount(entryCount - availableCount);
+            evicted = true;
         }
-    }
 
-    const size_t availableSize = m_maxSize - m_curSize;
+        // Decide while the lock is held: once it is dropped, another store may take the space made here before this
+        // entry is added. That is the overshoot described above, not a reason to fail.
+        hasSpace = (NeedsSpace(entrySize, entryCount) == false);
+    }
 
-    if ((result == Result::Success) &&
-        (entrySize > availableSize))
+    if (evicted)
     {
-        result = Result::ErrorShaderCacheFull;
-
-        if (m_evictOnFull)
-        {
-            result = EvictEntryBySize(entrySize - availableSize);
-        }
+        m_conditionVariable.WakeAll();
     }
 
-    return result;
+    return hasSpace ? Result::Success : Result::ErrorShaderCacheFull;
 }
 
 // =====================================================================================================================
@@ -713,11 +770,12 @@ Result MemoryCacheLayer::PromoteData(
     }
 
     Entry** ppFound = nullptr;
+    Shard*  pShard  = GetShard(&pQuery->hashId);
 
     {
-        RWLockAuto<RWLock::ReadOnly> lock { &m_lock };
+        RWLockAuto<RWLock::ReadOnly> lock { &pShard->lock };
 
-        ppFound = m_entryLookup.FindKey(pQuery->hashId);
+        ppFound = pShard->entryLookup.FindKey(pQuery->hashId);
     }
 
     if (ppFound != nullptr)
@@ -727,9 +785,7 @@ Result MemoryCacheLayer::PromoteData(
 
     if (result == Result::Success)
     {
-        RWLockAuto<RWLock::ReadWrite> lock { &m_lock };
-
-        result = EnsureAvailableSpace(pQuery->promotionSize, 1);
+        result = EnsureAvailableSpace(pShard, pQuery->promotionSize, 1);
     }
 
     if (result == Result::Success)
@@ -745,10 +801,11 @@ Result MemoryCacheLayer::PromoteData(
 
             if (result == Result::Success)
             {
-                RWLockAuto<RWLock::ReadWrite> lock { &m_lock };
+                RWLockAuto<RWLock::ReadWrite> lock { &pShard->lock };
 
-                result = AddEntryToCache(pEntry);
-                m_entryLookup.Insert(pQuery->hashId, pEntry);
+                // Another thread may have promoted or stored the same id while no lock was held
+                result = (pShard->entryLookup.FindKey(pQuery->hashId) == nullptr) ? AddEntryToCache(pShard, pEntry) :
+                                                                                    Result::AlreadyExists;
             }
 
             if (result == Result::Success)
@@ -788,10 +845,11 @@ Result MemoryCacheLayer::Reserve(
     if (result == Result::Success)
     {
         Entry** ppFound = nullptr;
+        Shard*  pShard  = GetShard(pHashId);
 
-        RWLockAuto<RWLock::ReadWrite> lock { &m_lock };
+        RWLockAuto<RWLock::ReadWrite> lock { &pShard->lock };
 
-        ppFound = m_entryLookup.FindKey(*pHashId);
+        ppFound = pShard->entryLookup.FindKey(*pHashId);
         if (ppFound != nullptr)
         {
             if (*ppFound != nullptr)
@@ -808,7 +866,7 @@ Result MemoryCacheLayer::Reserve(
             Entry* pEntry = Entry::Create(Allocator(), pHashId, nullptr, 0, 0);
             if (pEntry != nullptr)
             {
-                result = AddEntryToCache(pEntry);
+                result = AddEntryToCache(pShard, pEntry);
                 if (result != Result::Success)
                 {
                     pEntry->Destroy();
@@ -830,7 +888,7 @@ Result MemoryCacheLayer::Reserve(
 size_t GetMemoryCacheLayerSize(
     const MemoryCacheCreateInfo* pCreateInfo)
 {
-    return sizeof(MemoryCacheLayer);
+    return MemoryCacheLayer::GetPlacementSize(pCreateInfo->numShards);
 }
 
 // =====================================================================================================================
@@ -867,8 +925,12 @@ Result CreateMemoryCacheLayer(
             pCreateInfo->maxMemorySize,
             pCreateInfo->maxObjectCount,
             pCreateInfo->expectedEntries,
+            pCreateInfo->numShards,
             pCreateInfo->evictOnFull,
-            pCreateInfo->evictDuplicates);
+            pCreateInfo->evictDuplicates,
+            pCreateInfo->pfnNotify,
+            pCreateInfo->pNotifyClientData,
+            VoidPtrInc(pPlacementAddr, sizeof(MemoryCacheLayer)));
 
         result = pLayer->Init();
 
@@ -903,17 +965,25 @@ Result MemoryCacheLayer::GetMemoryCacheHashIds(
 {
     Result result = Result::Success;
 
-    RWLockAuto<RWLock::ReadOnly> lock { &m_lock };
+    // Lock every shard, always in the same order, so the count can't change while we copy
+    for (uint32 i = 0; i < m_numShards; i++)
+    {
+        m_pShards[i].lock.LockForRead();
+    }
+
     // Iterate through all Entries and copy their hash ID to pHashIds array.
     if (curCount == m_curCount)
     {
         uint32 i = 0;
 
-        for (auto iter = m_recentEntryList.Begin(); iter.IsValid(); iter.Next())
+        for (uint32 shard = 0; shard < m_numShards; shard++)
         {
-            Entry* pEntry = iter.Get();
+            for (auto iter = m_pShards[shard].recentEntryList.Begin(); iter.IsValid(); iter.Next())
+            {
+                Entry* pEntry = iter.Get();
 
-            pHashIds[i++] = *pEntry->HashId();
+                pHashIds[i++] = *pEntry->HashId();
+            }
         }
     }
     else
@@ -921,6 +991,11 @@ Result MemoryCacheLayer::GetMemoryCacheHashIds(
         result = Result::ErrorInvalidMemorySize;
     }
 
+    for (uint32 i = 0; i < m_numShards; i++)
+    {
+        m_pShards[i].lock.UnlockForRead();
+    }
+
     return result;
 }
 
@@ -935,6 +1010,188 @@ Result GetMemoryCacheLayerHashIds(
     return pMemoryCache->GetMemoryCacheHashIds(curCount, pHashIds);
 }
 
+// =====================================================================================================================
+// Merge the source layers into every shard of the given partition
+Result MemoryCacheLayer::Merge(
+    ICacheLayer* const* ppSrcLayers,
+    uint32              srcLayerCount,
+    uint32              partIndex,
+    uint32              partCount)
+{
+    PAL_ASSERT(partCount > 0);
+
+    Result result = (partCount > 0) ? Result::Success : Result::ErrorInvalidValue;
+
+    for (uint32 shardIndex = partIndex;
+         (shardIndex < m_numShards) && (result == Result::Success);
+         shardIndex += partCount)
+    {
+        result = MergeShard(shardIndex, ppSrcLayers, srcLayerCount);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Copy the entries of the source layers that belong to one of our shards. The ids already in the shard are collected
+// first so that only new entries are copied, and only one shard lock is held at a time.
+Result MemoryCacheLayer::MergeShard(
+    uint32              shardIndex,
+    ICacheLayer* const* ppSrcLayers,
+    uint32              srcLayerCount)
+{
+    using IdSet = HashSet<Hash128, ForwardAllocator, MetroHash::HashFunc, DefaultEqualFunc,
+                          HashAllocator<ForwardAllocator>, 256>;
+
+    Shard* const pShard = &m_pShards[shardIndex];
+
+    // Size the id set for our shard's share of all entries
+    size_t expectedIds = pShard->entryLookup.GetNumEntries();
+
+    for (uint32 i = 0; i < srcLayerCount; i++)
+    {
+        expectedIds += size_t(static_cast<const MemoryCacheLayer*>(ppSrcLayers[i])->m_curCount) / m_numShards;
+    }
+
+    IdSet                                knownIds(uint32(Max<size_t>(expectedIds, 64)), Allocator());
+    Vector<Entry*, 64, ForwardAllocator> newEntries(Allocator());
+    size_t                               newSize = 0;
+
+    Result result = knownIds.Init();
+
+    if (result == Result::Success)
+    {
+        RWLockAuto<RWLock::ReadOnly> lock { &pShard->lock };
+
+        for (auto iter = pShard->recentEntryList.Begin(); iter.IsValid() && (result == Result::Success); iter.Next())
+        {
+            result = knownIds.Insert(*iter.Get()->HashId());
+        }
+    }
+
+    for (uint32 i = 0; (i < srcLayerCount) && (result == Result::Success); i++)
+    {
+        const auto* pSrcLayer = static_cast<const MemoryCacheLayer*>(ppSrcLayers[i]);
+
+        // With the same number of shards, our entries can only be in the source shard with the same index
+        const bool   sameShards = (pSrcLayer->m_numShards == m_numShards);
+        const uint32 firstShard = sameShards ? shardIndex : 0;
+        const uint32 endShard   = sameShards ? (shardIndex + 1) : pSrcLayer->m_numShards;
+
+        for (uint32 srcShard = firstShard; (srcShard < endShard) && (result == Result::Success); srcShard++)
+        {
+            Shard* const pSrcShard = &pSrcLayer->m_pShards[srcShard];
+
+            RWLockAuto<RWLock::ReadOnly> lock { &pSrcShard->lock };
+
+            for (auto iter = pSrcShard->recentEntryList.Begin();
+                 iter.IsValid() && (result == Result::Success);
+                 iter.Next())
+            {
+                Entry* const pSrcEntry = iter.Get();
+
+                // Reserved entries have no data yet and bad entries must not spread to other caches
+                if ((pSrcEntry->Data() != nullptr)                  &&
+                    (pSrcEntry->IsBad() == false)                   &&
+                    (GetShard(pSrcEntry->HashId()) == pShard)       &&
+                    (knownIds.Contains(*pSrcEntry->HashId()) == false))
+                {
+                    Entry* pEntry = Entry::Create(Allocator(),
+                                                  pSrcEntry->HashId(),
+                                                  pSrcEntry->Data(),
+                                                  pSrcEntry->DataSize(),
+                                                  pSrcEntry->StoreSize());
+
+                    result = (pEntry != nullptr) ? newEntries.PushBack(pEntry) : Result::ErrorOutOfMemory;
+
+                    if (result == Result::Success)
+                    {
+                        newSize += pEntry->StoreSize();
+                        result   = knownIds.Insert(*pEntry->HashId());
+                    }
+                    else if (pEntry != nullptr)
+                    {
+                        pEntry->Destroy();
+                    }
+                }
+            }
+        }
+    }
+
+    if ((result == Result::Success) && (newEntries.NumElements() > 0))
+    {
+        if ((newSize <= m_maxSize) && (newEntries.NumElements() <= m_maxCount))
+        {
+            result = InsertMergedEntries(pShard, &newEntries[0], newEntries.NumElements(), newSize);
+        }
+        else
+        {
+            // The batch can never fit at once; let each entry make room for itself like a regular store would.
+            for (uint32 i = 0; (i < newEntries.NumElements()) && (result == Result::Success); i++)
+            {
+                result = InsertMergedEntries(pShard, &newEntries[i], 1, newEntries[i]->StoreSize());
+            }
+        }
+    }
+
+    // Entries that were not inserted still belong to us
+    for (uint32 i = 0; i < newEntries.NumElements(); i++)
+    {
+        if (newEntries[i] != nullptr)
+        {
+            newEntries[i]->Destroy();
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Make room for merged entries and insert them into a shard under one lock acquisition. Inserted entries are replaced
+// with nullptr in ppEntries.
+Result MemoryCacheLayer::InsertMergedEntries(
+    Shard*  pShard,
+    Entry** ppEntries,
+    uint32  entryCount,
+    size_t  entrySize)
+{
+    Result result = EnsureAvailableSpace(pShard, entrySize, entryCount);
+
+    if (result == Result::Success)
+    {
+        RWLockAuto<RWLock::ReadWrite> lock { &pShard->lock };
+
+        for (uint32 i = 0; (i < entryCount) && (result == Result::Success); i++)
+        {
+            // Another thread may have stored the same id since we collected the shard's ids
+            if (pShard->entryLookup.FindKey(*ppEntries[i]->HashId()) == nullptr)
+            {
+                result = AddEntryToCache(pShard, ppEntries[i]);
+
+                if (result == Result::Success)
+                {
+                    ppEntries[i] = nullptr;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result MergeMemoryCacheLayers(
+    ICacheLayer*        pDstLayer,
+    ICacheLayer* const* ppSrcLayers,
+    uint32              srcLayerCount,
+    uint32              partIndex,
+    uint32              partCount)
+{
+    auto pMemoryCache = static_cast<MemoryCacheLayer*>(pDstLayer);
+
+    return pMemoryCache->Merge(ppSrcLayers, srcLayerCount, partIndex, partCount);
+}
+
 // =====================================================================================================================
 MemoryCacheLayer::Entry* MemoryCacheLayer::Entry::Create(
     ForwardAllocator* pAllocator,
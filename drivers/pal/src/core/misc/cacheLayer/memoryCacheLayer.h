@@ -30,11 +30,18 @@
 #include "palIntrusiveList.h"
 #include "palVector.h"
 
+#include <atomic>
+
 namespace Util
 {
 
 // =====================================================================================================================
 // An ICacheLayer implementation that operates on fixed memory limits but not a fixed memory space
+//
+// Entries are spread over a power-of-two number of shards by hash id, each with its own lock, lookup table and entry
+// list, so concurrent operations on different ids rarely contend. Eviction uses the CLOCK approximation of LRU: a hit
+// only sets the entry's referenced flag under the shard's read lock, and eviction gives referenced entries a second
+// chance instead of evicting them. The size and count limits apply to the whole layer.
 class MemoryCacheLayer : public CacheLayerBase
 {
 public:
@@ -43,22 +50,32 @@ public:
         size_t                maxMemorySize,
         size_t                maxObjectCount,
         uint32                expectedEntries,
+        uint32                numShards,
         bool                  evictOnFull,
-        bool                  evictDuplicates);
+        bool                  evictDuplicates,
+        MemoryCacheNotifyFunc pfnNotify,
+        void*                 pNotifyClientData,
+        void*                 pShardMem);
     virtual ~MemoryCacheLayer();
 
     virtual Result Init() override;
 
+    // Memory needed to place a layer with the requested number of shards
+    static size_t GetPlacementSize(uint32 numShards);
+
     Result GetMemoryCacheSize(size_t* pCurCount, size_t* pCurSize) const
     {
-        *pCurCount = m_curCount;
-        *pCurSize  = m_curSize;
+        *pCurCount = size_t(m_curCount);
+        *pCurSize  = size_t(m_curSize);
 
         return Result::Success;
     }
 
     Result GetMemoryCacheHashIds(size_t curCount, Hash128* pHashIds);
 
+    // Copy the entries of other memory cache layers into the shards of the given partition
+    Result Merge(ICacheLayer* const* ppSrcLayers, uint32 srcLayerCount, uint32 partIndex, uint32 partCount);
+
     virtual Result AcquireCacheRef(const QueryResult* pQuery) override;
     virtual Result ReleaseCacheRef(const QueryResult* pQuery) override;
     virtual Result GetCacheData(const QueryResult* pQuery, const void** ppData) override;
@@ -93,14 +110,31 @@ private:
     PAL_DISALLOW_COPY_AND_ASSIGN(MemoryCacheLayer);
     PAL_DISALLOW_DEFAULT_CTOR(MemoryCacheLayer);
     class Entry;
+    struct Shard;
 
-    Result SetDataToEntry(Entry* pEntry, const void* pData, size_t dataSize, size_t storeSize);
-    Result AddEntryToCache(Entry* pEntry);
-    Result EvictEntryFromCache(Entry* pEntry);
+    static constexpr uint32 DefaultShardCount = 16;
+    static constexpr uint32 MaxShardCount     = 256;
 
-    Result EnsureAvailableSpace(size_t entrySize, size_t entryCount);
-    Result EvictEntryByCount(size_t numToEvict = 1);
-    Result EvictEntryBySize(size_t minSizeToEvict);
+    static uint32 ClampShardCount(uint32 numShards);
+
+    Shard* GetShard(const Hash128* pHashId) const
+        { return &m_pShards[(MetroHash::Compact32(pHashId) >> 24) & (m_numShards - 1)]; }
+
+    // These must be called with the shard's write lock held
+    Result SetDataToEntry(Entry* pEntry, const void* pData, size_t dataSize, size_t storeSize);
+    Result AddEntryToCache(Shard* pShard, Entry* pEntry);
+    Result ReplaceEntryInCache(Shard* pShard, Entry** ppExisting, Entry* pEntry);
+    Result EvictEntryFromCache(Shard* pShard, Entry* pEntry);
+    bool   EvictNextEntry(Shard* pShard);
+    void   Notify(MemoryCacheEvent event, const Hash128* pHashId) const
+        { if (m_pfnNotify != nullptr) { m_pfnNotify(m_pNotifyClientData, event, pHashId); } }
+
+    // Must be called without holding any shard lock
+    Result MergeShard(uint32 shardIndex, ICacheLayer* const* ppSrcLayers, uint32 srcLayerCount);
+    Result InsertMergedEntries(Shard* pShard, Entry** ppEntries, uint32 entryCount, size_t entrySize);
+    Result EnsureAvailableSpace(const Shard* pHomeShard, size_t entrySize, size_t entryCount);
+    bool   NeedsSpace(size_t entrySize, size_t entryCount) const
+        { return ((m_curCount + entryCount) > m_maxCount) || ((m_curSize + entrySize) > m_maxSize); }
 
     // IntrusiveList capable cache entry data structure
     class Entry
@@ -139,6 +173,16 @@ private:
         void SetIsBad(bool isBad) { m_isBad = isBad; }
         bool IsBad() { return m_isBad; }
 
+        // The referenced flag is set by readers holding only the shard's read lock, so it is atomic. Relaxed order is
+        // enough, as it guards no other data; a set racing with a clear only costs a second chance.
+        void MarkReferenced() { m_referenced.store(true, std::memory_order_relaxed); }
+        bool TestAndClearReferenced()
+        {
+            const bool referenced = m_referenced.load(std::memory_order_relaxed);
+            m_referenced.store(false, std::memory_order_relaxed);
+            return referenced;
+        }
+
         Node* ListNode() { return &m_node; }
 
         void Destroy();
@@ -154,6 +198,7 @@ private:
             m_hashId     {},
             m_pData      { nullptr },
             m_dataSize   { 0 },
+            m_referenced { false },
             m_isBad      { false }
         {
             PAL_ASSERT(m_pAllocator != nullptr);
@@ -168,21 +213,38 @@ private:
         size_t                  m_dataSize;
         size_t                  m_storeSize;
         volatile uint32         m_zeroCopyCount;
+        std::atomic<bool>       m_referenced;
         bool                    m_isBad;
     };
 
+    // An independently locked partition of the cache
+    struct Shard
+    {
+        Shard(uint32 expectedEntries, ForwardAllocator* pAllocator)
+            :
+            lock            {},
+            recentEntryList {},
+            entryLookup     { expectedEntries, pAllocator }
+        {}
+
+        RWLock      lock;
+        Entry::List recentEntryList;  // Insertion order, rotated by the CLOCK sweep in EvictNextEntry()
+        Entry::Map  entryLookup;
+    };
+
     const size_t m_maxSize;
     const size_t m_maxCount;
     const bool   m_evictOnFull;
     const bool   m_evictDuplicates;
 
-    RWLock       m_lock;
+    const MemoryCacheNotifyFunc m_pfnNotify;
+    void* const                 m_pNotifyClientData;
 
-    size_t       m_curSize;
-    size_t       m_curCount;
+    const uint32 m_numShards;
+    Shard* const m_pShards;
 
-    Entry::List  m_recentEntryList;
-    Entry::Map   m_entryLookup;
+    volatile uint64 m_curSize;
+    volatile uint64 m_curCount;
 
     Mutex              m_conditionMutex;      // Mutex that will be used with the condition variable
     ConditionVariable  m_conditionVariable;   // used for waiting on Entry::ready
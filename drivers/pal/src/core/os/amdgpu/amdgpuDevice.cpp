@@ -2137,8 +2137,13 @@ size_t Device::QueueObjectSize(
     case QueueTypeCompute:
     case QueueTypeUniversal:
     case QueueTypeDma:
-        // Add the size of Amdgpu::Queue::m_pResourceList or m_pResourceObjectList
-        size = sizeof(Amdgpu::Queue) + CmdBufMemReferenceLimit * sizeof(this);
+        // Add the size of Amdgpu::Queue::m_pResourceObjectList and, without raw2 submit, Amdgpu::Queue::m_pResourceList
+        size = sizeof(Amdgpu::Queue) + CmdBufMemReferenceLimit * sizeof(GpuMemory*);
+
+        if (IsRaw2SubmitSupported() == false)
+        {
+            size += CmdBufMemReferenceLimit * sizeof(amdgpu_bo_handle);
+        }
 
         if (createInfo.enableGpuMemoryPriorities)
         {
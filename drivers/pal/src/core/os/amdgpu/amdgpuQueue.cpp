@@ -203,6 +203,12 @@ Queue::Queue(
     m_globalRefMap(static_cast<Device*>(m_pDevice)->IsVmAlwaysValidSupported() ? MemoryRefMapElementsPerVmBo :
                    MemoryRefMapElements, m_pDevice->GetPlatform()),
     m_globalRefDirty(true),
+    m_globalRefAdds(pDevice->GetPlatform()),
+    m_globalRefHoles(pDevice->GetPlatform()),
+    m_presentableGlobalRefs(pDevice->GetPlatform()),
+    m_globalRefRebuild(false),
+    m_resourceEntryList(pDevice->GetPlatform()),
+    m_validResourceEntries(0),
     m_appMemRefCount(0),
     m_pendingWait(false),
     m_pCmdUploadRing(nullptr),
@@ -213,22 +219,24 @@ Queue::Queue(
     m_waitSemList(pDevice->GetPlatform()),
     m_requiresGangedInterface(false)
 {
-    // The space allocated will be used to save either the handle of each command or the pointer of the command
-    // itself. When raw2 submit is supported, we save the pointer.
+    // The space allocated holds the object of every resource in the list, followed by its handle when raw2 submit is
+    // not supported and by its priority when GPU memory priorities are enabled. The objects are needed either way to
+    // maintain the global references incrementally.
+    m_pResourceObjectList = reinterpret_cast<GpuMemory**>(this + 1);
+
+    void* pNextList = (m_pResourceObjectList + Pal::Device::CmdBufMemReferenceLimit);
+
     if (pDevice->IsRaw2SubmitSupported())
     {
         m_pResourceList = nullptr;
-        m_pResourceObjectList = reinterpret_cast<GpuMemory**>(this + 1);
-        m_pResourcePriorityList = pCreateInfo[0].enableGpuMemoryPriorities ?
-            reinterpret_cast<uint8*>(m_pResourceObjectList + Pal::Device::CmdBufMemReferenceLimit) : nullptr;
     }
     else
     {
-        m_pResourceList = reinterpret_cast<amdgpu_bo_handle*>(this + 1);
-        m_pResourceObjectList = nullptr;
-        m_pResourcePriorityList = pCreateInfo[0].enableGpuMemoryPriorities ?
-            reinterpret_cast<uint8*>(m_pResourceList + Pal::Device::CmdBufMemReferenceLimit) : nullptr;
+        m_pResourceList = static_cast<amdgpu_bo_handle*>(pNextList);
+        pNextList       = (m_pResourceList + Pal::Device::CmdBufMemReferenceLimit);
     }
+
+    m_pResourcePriorityList = pCreateInfo[0].enableGpuMemoryPriorities ? static_cast<uint8*>(pNextList) : nullptr;
     memset(m_ibs, 0, sizeof(m_ibs));
 }
 
@@ -386,7 +394,7 @@ Result Queue::AddGpuMemoryReferences(
 
     for (uint32 idx = 0; (idx < gpuMemRefCount) && (result == Result::Success); ++idx)
     {
-        uint32*    pRefCount     = nullptr;
+        GlobalRef* pRef          = nullptr;
         bool       alreadyExists = false;
         GpuMemory* pGpuMemory    = reinterpret_cast<GpuMemory*>(pGpuMemoryRefs[idx].pGpuMemory);
 
@@ -395,20 +403,26 @@ Result Queue::AddGpuMemoryReferences(
             continue;
         }
 
-        result = m_globalRefMap.FindAllocate(pGpuMemory, &alreadyExists, &pRefCount);
+        result = m_globalRefMap.FindAllocate(pGpuMemory, &alreadyExists, &pRef);
 
         if (result == Result::Success)
         {
             if (alreadyExists)
             {
                 // The reference is already in the map, increment the ref count.
-                (*pRefCount)++;
+                pRef->refCount++;
             }
             else
             {
-                // Initialize the new value with one reference.
-                *pRefCount       = 1;
+                // Initialize the new value with one reference. It joins the resource list on the next submit.
+                pRef->refCount   = 1;
+                pRef->listIndex  = GlobalRefPending;
                 m_globalRefDirty = true;
+
+                if (m_globalRefAdds.PushBack(pGpuMemory) != Result::Success)
+                {
+                    m_globalRefRebuild = true;
+                }
             }
         }
     }
@@ -427,15 +441,38 @@ void Queue::RemoveGpuMemoryReferences(
 
     for (uint32 idx = 0; idx < gpuMemoryCount; ++idx)
     {
-        uint32* pRefCount = m_globalRefMap.FindKey(ppGpuMemory[idx]);
+        GlobalRef* pRef = m_globalRefMap.FindKey(ppGpuMemory[idx]);
 
-        if (pRefCount != nullptr)
+        if (pRef != nullptr)
         {
-            PAL_ASSERT(*pRefCount > 0);
-            (*pRefCount)--;
+            PAL_ASSERT(pRef->refCount > 0);
+            pRef->refCount--;
 
-            if ((*pRefCount == 0) || forceRemove)
+            if ((pRef->refCount == 0) || forceRemove)
             {
+                if (pRef->listIndex == GlobalRefPresentable)
+                {
+                    for (auto iter = m_presentableGlobalRefs.begin(); iter != m_presentableGlobalRefs.end(); ++iter)
+                    {
+                        if (*iter == ppGpuMemory[idx])
+                        {
+                            m_presentableGlobalRefs.Erase(iter);
+                            break;
+                        }
+                    }
+                }
+                else if (pRef->listIndex != GlobalRefPending)
+                {
+                    // Leave a hole in the list, the next submit fills it. A pending addition needs no such care: it
+                    // is skipped once it is no longer found in the map.
+                    m_pResourceObjectList[pRef->listIndex] = nullptr;
+
+                    if (m_globalRefHoles.PushBack(pRef->listIndex) != Result::Success)
+                    {
+                        m_globalRefRebuild = true;
+                    }
+                }
+
                 m_globalRefMap.Erase(ppGpuMemory[idx]);
                 m_globalRefDirty = true;
             }
@@ -1534,43 +1571,34 @@ Result Queue::UpdateResourceList(
         PAL_ASSERT(m_globalRefLock.TryLockForWrite() == false);
 
         // Reset the list
-        m_numResourcesInList = 0;
         if (m_hResourceList != nullptr)
         {
             result = static_cast<Device*>(m_pDevice)->DestroyResourceList(m_hResourceList);
             m_hResourceList = nullptr;
         }
 
-        // First add all of the global memory references.
-        if (result == Result::Success)
+        // First bring the global memory references up to date. Only the changes journalled since the last submit are
+        // applied, the rest of the global part of our UMD-side list (m_pResourceList) is reused as it is.
+        if ((result == Result::Success) && m_globalRefDirty)
         {
-            // If the global memory references haven't been modified since the last submit,
-            // the resources in our UMD-side list (m_pResourceList) should be up to date.
-            // So, there is no need to re-walk through m_memList.
-            if (m_globalRefDirty == false)
+            m_globalRefDirty = false;
+
+            result = UpdateGlobalResourceList();
+
+            if (result != Result::_Success)
             {
-                m_numResourcesInList += m_memListResourcesInList;
+                // We didn't bring the whole list up to date so keep it marked as dirty.
+                m_globalRefDirty = true;
             }
-            else
-            {
-                m_globalRefDirty = false;
-
-                for (auto iter = m_globalRefMap.Begin(); iter.Get() != nullptr; iter.Next())
-                {
-                    auto*const pGpuMemory = static_cast<GpuMemory*>(iter.Get()->key);
+        }
 
-                    result = AppendGlobalResourceToList(pGpuMemory);
+        m_numResourcesInList = m_memListResourcesInList;
 
-                    if (result != Result::_Success)
-                    {
-                        // We didn't rebuild the whole list so keep it marked as dirty.
-                        m_globalRefDirty = true;
-                        break;
-                    }
-                }
-
-                m_memListResourcesInList = m_numResourcesInList;
-            }
+        // Presentable images may only be referenced while the window system doesn't own them, which changes with every
+        // present, so they are re-checked every time the list is built.
+        for (uint32 idx = 0; ((idx < m_presentableGlobalRefs.NumElements()) && (result == Result::_Success)); ++idx)
+        {
+            result = AppendGlobalResourceToList(m_presentableGlobalRefs.At(idx));
         }
 
         // Finally, add all of the application's submission memory references.
@@ -1599,6 +1627,172 @@ Result Queue::UpdateResourceList(
     return result;
 }
 
+// =====================================================================================================================
+// Applies the global memory reference changes journalled since the last submit to the global part of the resource
+// list. The cost scales with the number of changes rather than with the number of global references.
+Result Queue::UpdateGlobalResourceList()
+{
+    Result result = Result::Success;
+
+    if (m_globalRefRebuild)
+    {
+        result = RebuildGlobalResourceList();
+    }
+    else
+    {
+        // Fill the holes left by removed references with the last global references in the list.
+        for (uint32 idx = 0; idx < m_globalRefHoles.NumElements(); ++idx)
+        {
+            while ((m_memListResourcesInList > 0) && (m_pResourceObjectList[m_memListResourcesInList - 1] == nullptr))
+            {
+                m_memListResourcesInList--;
+            }
+
+            const uint32 hole = m_globalRefHoles.At(idx);
+
+            if (hole < m_memListResourcesInList)
+            {
+                MoveGlobalResource(m_memListResourcesInList - 1, hole);
+                m_memListResourcesInList--;
+            }
+        }
+
+        m_globalRefHoles.Clear();
+
+        // Then append the references added since the last submit. A reference which was removed again in the meantime
+        // is no longer in the map, and one which was re-added is only pending once.
+        m_numResourcesInList = m_memListResourcesInList;
+
+        for (uint32 idx = 0; ((idx < m_globalRefAdds.NumElements()) && (result == Result::_Success)); ++idx)
+        {
+            IGpuMemory*const pGpuMemory = m_globalRefAdds.At(idx);
+            GlobalRef*const  pRef       = m_globalRefMap.FindKey(pGpuMemory);
+
+            if ((pRef != nullptr) && (pRef->listIndex == GlobalRefPending))
+            {
+                result = TrackGlobalResource(static_cast<GpuMemory*>(pGpuMemory), pRef);
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            m_globalRefAdds.Clear();
+        }
+        else
+        {
+            // Some of the journal has been applied, start over from the map once the list has room again.
+            m_globalRefRebuild = true;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Rebuilds the global part of the resource list by walking all of m_globalRefMap. Only needed when the journal could
+// not be kept, because it ran out of memory or the resource list was full.
+Result Queue::RebuildGlobalResourceList()
+{
+    Result result = Result::Success;
+
+    m_memListResourcesInList = 0;
+    m_numResourcesInList     = 0;
+    m_validResourceEntries   = 0;
+
+    m_globalRefAdds.Clear();
+    m_globalRefHoles.Clear();
+    m_presentableGlobalRefs.Clear();
+
+    for (auto iter = m_globalRefMap.Begin(); iter.Get() != nullptr; iter.Next())
+    {
+        iter.Get()->value.listIndex = GlobalRefPending;
+    }
+
+    for (auto iter = m_globalRefMap.Begin(); ((iter.Get() != nullptr) && (result == Result::_Success)); iter.Next())
+    {
+        result = TrackGlobalResource(static_cast<GpuMemory*>(iter.Get()->key), &iter.Get()->value);
+    }
+
+    m_globalRefRebuild = (result != Result::Success);
+
+    return result;
+}
+
+// =====================================================================================================================
+// Places a newly added global reference. Presentable images are kept aside and checked on every submit, everything
+// else is appended to the global part of the resource list.
+Result Queue::TrackGlobalResource(
+    GpuMemory* pGpuMemory,
+    GlobalRef* pRef)
+{
+    PAL_ASSERT((pGpuMemory != nullptr) && (pGpuMemory->IsVmAlwaysValid() == false));
+    PAL_ASSERT(m_numResourcesInList == m_memListResourcesInList);
+
+    Result result = Result::Success;
+
+    const Image* pImage = static_cast<Image*>(pGpuMemory->GetImage());
+
+    if ((pImage != nullptr) && pImage->IsPresentable())
+    {
+        result = m_presentableGlobalRefs.PushBack(pGpuMemory);
+
+        if (result == Result::Success)
+        {
+            pRef->listIndex = GlobalRefPresentable;
+        }
+    }
+    else
+    {
+        result = AppendResourceToList(pGpuMemory);
+
+        if (result == Result::Success)
+        {
+            pRef->listIndex          = static_cast<uint32>(m_memListResourcesInList);
+            m_memListResourcesInList = m_numResourcesInList;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Moves a global reference to another slot in the global part of the resource list and updates its map entry.
+void Queue::MoveGlobalResource(
+    size_t srcIndex,
+    size_t dstIndex)
+{
+    GpuMemory*const pGpuMemory = m_pResourceObjectList[srcIndex];
+    GlobalRef*const pRef       = m_globalRefMap.FindKey(pGpuMemory);
+
+    PAL_ASSERT((pRef != nullptr) && (pRef->listIndex == srcIndex));
+
+    m_pResourceObjectList[dstIndex] = pGpuMemory;
+    m_pResourceObjectList[srcIndex] = nullptr;
+
+    if (m_pResourceList != nullptr)
+    {
+        m_pResourceList[dstIndex] = m_pResourceList[srcIndex];
+    }
+
+    if (m_pResourcePriorityList != nullptr)
+    {
+        m_pResourcePriorityList[dstIndex] = m_pResourcePriorityList[srcIndex];
+    }
+
+    pRef->listIndex = static_cast<uint32>(dstIndex);
+
+    // Carry a valid raw2 submission entry along with the reference, otherwise every entry from the hole onwards would
+    // have to be rewritten on the next submit.
+    if (srcIndex < m_validResourceEntries)
+    {
+        m_resourceEntryList[dstIndex] = m_resourceEntryList[srcIndex];
+    }
+    else
+    {
+        m_validResourceEntries = Min(m_validResourceEntries, dstIndex);
+    }
+}
+
 // =====================================================================================================================
 // Appends a global resident bo to the list of buffer objects which get submitted with a set of command buffers.
 Result Queue::AppendGlobalResourceToList(
@@ -1656,13 +1850,15 @@ Result Queue::AppendResourceToList(
                         pGpuMemory->SetSurfaceKmsHandle(kmsHandle);
                     }
                 }
-                m_pResourceObjectList[m_numResourcesInList] = pGpuMemory;
             }
             else
             {
                 m_pResourceList[m_numResourcesInList] = pGpuMemory->SurfaceHandle();
             }
 
+            m_pResourceObjectList[m_numResourcesInList] = pGpuMemory;
+            m_validResourceEntries = Min(m_validResourceEntries, m_numResourcesInList);
+
             if (m_pResourcePriorityList != nullptr)
             {
                 // Max priority that Os accepts is 32, see AMDGPU_BO_LIST_MAX_PRIORITY.
@@ -1990,25 +2186,23 @@ Result Queue::SubmitIbsRaw(
 	// Serialize access to internalMgr and queue memory list
 	RWLockAuto<RWLock::ReadWrite> lockMgr(m_pDevice->MemMgr()->GetRefListLock());
 
-        // Prepare the resourceListEntry for non-dummy submission.
-        Vector<drm_amdgpu_bo_list_entry, 1, Platform> resourceEntryList(pDevice->GetPlatform());
+        // Prepare the resource entries for non-dummy submission. The entries of global references which haven't moved
+        // since the last submit are still valid, so only the rest of the list needs to be written.
         if (!internalSubmitInfo.flags.isDummySubmission)
         {
-            result = resourceEntryList.Reserve(m_numResourcesInList);
+            result = m_resourceEntryList.Resize(static_cast<uint32>(m_numResourcesInList));
             if (result == Result::Success)
             {
-                for (uint32 index = 0; index < m_numResourcesInList; ++index)
+                for (size_t index = Min(m_validResourceEntries, m_memListResourcesInList);
+                     index < m_numResourcesInList;
+                     ++index)
                 {
-                    if (m_pResourcePriorityList != nullptr)
-                    {
-                        resourceEntryList.PushBack({(*(m_pResourceObjectList + index))->SurfaceKmsHandle(),
-                                                    *(m_pResourcePriorityList + index)});
-                    }
-                    else
-                    {
-                        resourceEntryList.PushBack({(*(m_pResourceObjectList + index))->SurfaceKmsHandle(), 0});
-                    }
+                    m_resourceEntryList[index].bo_handle   = m_pResourceObjectList[index]->SurfaceKmsHandle();
+                    m_resourceEntryList[index].bo_priority = (m_pResourcePriorityList != nullptr) ?
+                                                             m_pResourcePriorityList[index] : 0;
                 }
+
+                m_validResourceEntries = m_memListResourcesInList;
             }
         }
 
@@ -2024,7 +2218,7 @@ Result Queue::SubmitIbsRaw(
             else
             {
                 result = pDevice->CreateResourceListRaw(m_numResourcesInList,
-                                                        resourceEntryList.Data(),
+                                                        m_resourceEntryList.Data(),
                                                         &boList);
             }
         }
@@ -2041,7 +2235,7 @@ Result Queue::SubmitIbsRaw(
             boListIn.bo_info_ptr = static_cast<uint64>(reinterpret_cast<uintptr_t>(
                                             internalSubmitInfo.flags.isDummySubmission ?
                                             m_dummyResourceEntryList.Data() :
-                                            resourceEntryList.Data()));
+                                            m_resourceEntryList.Data()));
 
             chunkArray[currentChunk].chunk_id = AMDGPU_CHUNK_ID_BO_HANDLES;
             chunkArray[currentChunk].length_dw = sizeof(struct drm_amdgpu_bo_list_in) / 4;
@@ -187,7 +187,7 @@ protected:
         bool                                      doNotWait) override { return Result::ErrorUnavailable; }
 
     Device&                m_device;
-    amdgpu_bo_handle*      m_pResourceList;
+    amdgpu_bo_handle*      m_pResourceList;          // Only used when raw2 submit is not supported
     GpuMemory**            m_pResourceObjectList;
     uint8*                 m_pResourcePriorityList;
     const size_t           m_resourceListSize;
@@ -197,6 +197,19 @@ protected:
     size_t                 m_memMgrResourcesInList;  // The number of resources added from internal memory manager
 
 private:
+    // Tracks global memory references for this queue. Each key is a GPU memory object and each value holds its
+    // refcount and where the allocation lives in the resource list.
+    struct GlobalRef
+    {
+        uint32 refCount;
+        uint32 listIndex; // Index into the global part of the resource list, or one of the values below.
+    };
+
+    static constexpr uint32 GlobalRefPending     = UINT32_MAX;     // Waiting in m_globalRefAdds.
+    static constexpr uint32 GlobalRefPresentable = UINT32_MAX - 1; // Tracked in m_presentableGlobalRefs.
+
+    typedef Util::HashMap<IGpuMemory*, GlobalRef, Pal::Platform> MemoryRefMap;
+
     // Note: user MUST lock the mutex m_globalRefLock before calling this function and ensure the lock remains until all
     // functions have finished accessing m_globalRefMap and the memory pointed to by that map. This includes Submit*()
     Result UpdateResourceList(
@@ -209,6 +222,17 @@ private:
     Result AppendGlobalResourceToList(
         GpuMemory* pGpuMemory);
 
+    Result UpdateGlobalResourceList();
+    Result RebuildGlobalResourceList();
+
+    Result TrackGlobalResource(
+        GpuMemory* pGpuMemory,
+        GlobalRef* pRef);
+
+    void MoveGlobalResource(
+        size_t srcIndex,
+        size_t dstIndex);
+
     Result AddCmdStream(
         const CmdStream& cmdStream,
         uint32           engineId,
@@ -276,9 +300,6 @@ private:
         memset(m_ibs, 0, sizeof(m_ibs));
     }
 
-    // Tracks global memory references for this queue. Each key is a GPU memory object and each value is a refcount.
-    typedef Util::HashMap<IGpuMemory*, uint32, Pal::Platform> MemoryRefMap;
-
     // Kernel object representing a list of GPU memory allocations referenced by a submit.
     // Stored as a member variable to prevent re-creating the kernel object on every submit
     // in the common case where the set of resident allocations doesn't change.
@@ -290,6 +311,19 @@ private:
     Pal::CmdStream*    m_pDummyCmdStream;          // The dummy command stream used by dummy submission.
     MemoryRefMap       m_globalRefMap;             // A hashmap acting as a refcounted list of memory references.
     bool               m_globalRefDirty;           // Indicates m_globalRefMap has changed since the last submit.
+
+    // The first m_memListResourcesInList entries of the resource list hold the global references. Rather than walking
+    // m_globalRefMap on every change, additions and removals are journalled here and applied on the next submit.
+    // Removed references leave a null hole in m_pResourceObjectList which is filled from the end of the global part.
+    Util::Vector<IGpuMemory*, 16, Platform> m_globalRefAdds;
+    Util::Vector<uint32, 16, Platform>      m_globalRefHoles;
+    Util::Vector<GpuMemory*, 4, Platform>   m_presentableGlobalRefs; // Only in the list while not owned by the WS.
+    bool                                    m_globalRefRebuild;      // The journal is incomplete, re-walk the map.
+
+    // Submission entries for raw2 submits. The first m_validResourceEntries still match the resource list, so only
+    // the newly added global references and the per-submit references need to be rewritten.
+    Util::Vector<drm_amdgpu_bo_list_entry, 1, Platform> m_resourceEntryList;
+    size_t                                              m_validResourceEntries;
     Util::RWLock       m_globalRefLock;            // Protect m_globalRefMap from muli-thread access.
     uint32             m_appMemRefCount;           // Store count of application's submission memory references.
     bool               m_pendingWait;              // Queue needs a dummy submission between wait and signal.
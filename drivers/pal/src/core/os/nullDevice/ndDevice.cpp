@@ -29,6 +29,7 @@
 #include "core/os/nullDevice/ndDevice.h"
 #include "core/os/nullDevice/ndFence.h"
 #include "core/os/nullDevice/ndGpuMemory.h"
+#include "core/os/nullDevice/ndImage.h"
 #include "core/os/nullDevice/ndPlatform.h"
 #include "core/os/nullDevice/ndQueue.h"
 #include "palFormatInfo.h"
@@ -279,7 +280,17 @@ Result Device::CreateImage(
     void*                  pPlacementAddr,
     IImage**               ppImage)
 {
-    return Result::Unsupported;
+    constexpr ImageInternalCreateInfo NullInternalInfo = {};
+
+    Pal::Image* pImage = nullptr;
+    Result      result = CreateInternalImage(createInfo, NullInternalInfo, pPlacementAddr, &pImage);
+
+    if (result == Result::Success)
+    {
+        (*ppImage) = pImage;
+    }
+
+    return result;
 }
 
 // =====================================================================================================================
@@ -290,10 +301,16 @@ Result Device::CreateInternalImage(
     void*                          pPlacementAddr,
     Pal::Image**                   ppImage)
 {
-    // The GetImageSize() function should prevent us from getting here
-    PAL_NEVER_CALLED();
+    (*ppImage) = PAL_PLACEMENT_NEW(pPlacementAddr) NdImage(this, createInfo, internalCreateInfo);
 
-    return Result::Unsupported;
+    Result result = (*ppImage)->Init();
+    if (result != Result::Success)
+    {
+        (*ppImage)->Destroy();
+        *ppImage = nullptr;
+    }
+
+    return result;
 }
 
 // =====================================================================================================================
@@ -1504,10 +1521,16 @@ size_t Device::GetImageSize(
     Result*                pResult
     ) const
 {
-    // There's no need for an image object on a device designed only to support off-line shader compilations
-    *pResult = Result::Unsupported;
+    // Images only exist so that their layout and CPU access can be exercised; they can never be used by a queue.
+    constexpr ImageInternalCreateInfo NullInternalInfo = {};
 
-    return 0;
+    if (pResult != nullptr)
+    {
+        *pResult = Image::ValidateCreateInfo(this, createInfo, NullInternalInfo);
+    }
+
+    return (sizeof(NdImage) + Pal::Image::GetTotalSubresourceSize(*this, createInfo) +
+            GetGfxDevice()->GetImageSize(createInfo));
 }
 
 // =====================================================================================================================
@@ -0,0 +1,57 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#if PAL_BUILD_NULL_DEVICE
+
+#include "core/hw/gfxip/gfxDevice.h"
+#include "core/os/nullDevice/ndDevice.h"
+#include "core/os/nullDevice/ndImage.h"
+#include "palInlineFuncs.h"
+
+using namespace Util;
+
+namespace Pal
+{
+namespace NullDevice
+{
+
+// =====================================================================================================================
+NdImage::NdImage(
+    Device*                        pDevice,
+    const ImageCreateInfo&         createInfo,
+    const ImageInternalCreateInfo& internalCreateInfo)
+    :
+    Pal::Image(pDevice,
+               (this + 1),
+               VoidPtrInc((this + 1), pDevice->GetGfxDevice()->GetImageSize(createInfo)),
+               createInfo,
+               internalCreateInfo)
+{
+}
+
+} // NullDevice
+} // Pal
+
+#endif
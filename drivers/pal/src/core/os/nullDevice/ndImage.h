@@ -0,0 +1,63 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#if PAL_BUILD_NULL_DEVICE
+
+#pragma once
+
+#include "core/image.h"
+
+namespace Pal
+{
+namespace NullDevice
+{
+
+class Device;
+
+// =====================================================================================================================
+// Represents a null device image.  The layout is computed exactly as on hardware, so images can be created, bound to
+// (system memory backed) GPU memory and accessed from the CPU; nothing can be presented or shared.
+class NdImage final : public Pal::Image
+{
+public:
+    NdImage(
+        Device*                        pDevice,
+        const ImageCreateInfo&         createInfo,
+        const ImageInternalCreateInfo& internalCreateInfo);
+
+    virtual ~NdImage() { }
+
+    virtual void SetOptimalSharingLevel(MetadataSharingLevel level) override { }
+    virtual MetadataSharingLevel GetOptimalSharingLevel() const override { return MetadataSharingLevel::FullExpand; }
+
+private:
+    PAL_DISALLOW_DEFAULT_CTOR(NdImage);
+    PAL_DISALLOW_COPY_AND_ASSIGN(NdImage);
+}; // NdImage
+
+} // NullDevice
+} // Pal
+
+#endif
@@ -28,6 +28,7 @@
 #include "palInlineFuncs.h"
 #include "palIntrusiveListImpl.h"
 #include "palMetroHash.h"
+#include "palMutex.h"
 #include "palPlatformKey.h"
 #include "palSysMemory.h"
 #include "palSysUtil.h"
@@ -39,6 +40,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -47,6 +49,17 @@
 namespace Util
 {
 
+// Header of the side file which records the order archive entries were first read in, followed by entryCount ordinal
+// ids. It is written next to the archive as "<archive name>.order".
+struct AccessOrderHeader
+{
+    uint8  marker[4];
+    uint32 entryCount;
+};
+
+static constexpr uint8 AccessOrderMarker[4] = { 'P', 'A', 'O', 'R' };
+static constexpr char  AccessOrderSuffix[]  = ".order";
+
 // =====================================================================================================================
 // Generate a full path from ArchiveFileOpenInfo
 static char* GenerateFullPath(
@@ -471,13 +484,39 @@ ArchiveFile::ArchiveFile(
     m_recentList        (),
     m_pages             (),
     m_pageCount         (0),
-    m_pageSize          (MinPageSize)
+    m_pageSize          (MinPageSize),
+    // Memory mapped reads
+    m_pMappedBase       (nullptr),
+    m_mappedSize        (0),
+    m_recordAccessOrder (false),
+    m_accessOrder       (Allocator()),
+    m_accessed          (Allocator()),
+    m_accessOrderPath   (),
+    m_prefetchThread    (),
+    m_prefetchRanges    (Allocator()),
+    m_stopPrefetch      (0)
 {
 }
 
 // =====================================================================================================================
 ArchiveFile::~ArchiveFile()
 {
+    if (m_prefetchThread.IsCreated())
+    {
+        AtomicExchange(&m_stopPrefetch, 1);
+        m_prefetchThread.Join();
+    }
+
+    if (m_recordAccessOrder)
+    {
+        SaveAccessOrder();
+    }
+
+    if (m_pMappedBase != nullptr)
+    {
+        munmap(const_cast<void*>(m_pMappedBase), m_mappedSize);
+    }
+
     close(m_hFile);
 }
 
@@ -488,9 +527,17 @@ Result ArchiveFile::Init(
 {
     Result result = Result::Success;
 
+    // A file mapping makes the read buffer redundant, so only fall back to buffered reads if mapping fails
+    if (pInfo->useMemoryMappedRead)
+    {
+        const Result mapResult = InitMapping();
+        PAL_ALERT(IsErrorResult(mapResult));
+    }
+
     // Init internal memory buffers
     if ((result == Result::Success) &&
-        (pInfo->useBufferedReadMemory))
+        (pInfo->useBufferedReadMemory) &&
+        (m_pMappedBase == nullptr))
     {
         m_useBufferedMemory = true;
         result              = InitPages();
@@ -507,6 +554,16 @@ Result ArchiveFile::Init(
         }
     }
 
+    // Prefetching is best effort and never fails initialization. It is set up even if there is nothing to map yet, so
+    // that the order of a newly created archive is still recorded.
+    if ((result == Result::Success) &&
+        (pInfo->prefetchRecentEntries) &&
+        (pInfo->useMemoryMappedRead))
+    {
+        const Result prefetchResult = InitPrefetch(pInfo);
+        PAL_ALERT(IsErrorResult(prefetchResult));
+    }
+
     return result;
 }
 
@@ -525,7 +582,24 @@ Result ArchiveFile::Preload(
 {
     Result result = Result::ErrorUnknown;
 
-    if (m_useBufferedMemory)
+    if (m_pMappedBase != nullptr)
+    {
+        if (startLocation < m_mappedSize)
+        {
+            // Ask the kernel to start reading the range in; the pages are filled asynchronously
+            const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            const size_t begin    = startLocation & ~(pageSize - 1);
+            const size_t end      = Min(startLocation + maxReadSize, m_mappedSize);
+
+            result = (madvise(const_cast<void*>(VoidPtrInc(m_pMappedBase, begin)), end - begin, MADV_WILLNEED) == 0) ?
+                     Result::Success : Result::ErrorUnknown;
+        }
+        else
+        {
+            result = Result::ErrorInvalidValue;
+        }
+    }
+    else if (m_useBufferedMemory)
     {
         if (startLocation < m_fileSize)
         {
@@ -648,6 +722,72 @@ Result ArchiveFile::Read(
         }
     }
 
+    if (result == Result::Success)
+    {
+        RecordAccess(pHeader);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Return a pointer to an entry's data inside the file mapping. Lets callers copy the data straight to its destination
+// instead of reading it into an intermediate buffer first.
+Result ArchiveFile::GetEntryData(
+    const ArchiveEntryHeader* pHeader,
+    const void**              ppData)
+{
+    PAL_ASSERT(pHeader != nullptr);
+    PAL_ASSERT(ppData != nullptr);
+
+    Result result = Result::ErrorUnknown;
+
+    if ((pHeader == nullptr) ||
+        (ppData == nullptr))
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else if (m_pMappedBase == nullptr)
+    {
+        result = Result::Unsupported;
+    }
+    else
+    {
+        Result refreshResult = RefreshFile(false);
+
+        // We can still attempt to read from the file using our cached header
+        PAL_ALERT(IsErrorResult(refreshResult));
+
+        if ((pHeader->ordinalId > GetEntryCount()) ||
+            ((pHeader->dataPosition + pHeader->dataSize) > m_curFooterOffset))
+        {
+            result = Result::ErrorInvalidValue;
+        }
+        else if (IsMapped(pHeader->dataPosition, pHeader->dataSize) == false)
+        {
+            // Entries appended after the file was mapped must go through Read()
+            result = Result::Unsupported;
+        }
+        else
+        {
+            const void* const pData = VoidPtrInc(m_pMappedBase, pHeader->dataPosition);
+
+            if (Crc64(pData, pHeader->dataSize) == pHeader->dataCrc64)
+            {
+                *ppData = pData;
+                result  = Result::Success;
+
+                RecordAccess(pHeader);
+            }
+            else
+            {
+                PAL_ALERT_ALWAYS();
+
+                result = Result::ErrorIncompatibleLibrary;
+            }
+        }
+    }
+
     return result;
 }
 
@@ -940,7 +1080,13 @@ Result ArchiveFile::ReadInternal(
 
     Result result = Result::ErrorUnknown;
 
-    if (m_useBufferedMemory)
+    // The mapping shares the page cache with our own writes, so it never needs a reload
+    if (IsMapped(fileOffset, readSize))
+    {
+        memcpy(pBuffer, VoidPtrInc(m_pMappedBase, fileOffset), readSize);
+        result = Result::Success;
+    }
+    else if (m_useBufferedMemory)
     {
         result = ReadCached(fileOffset, pBuffer, readSize, forceCacheReload, wait);
     }
@@ -1084,6 +1230,193 @@ Result ArchiveFile::WriteCached(
     return result;
 }
 
+// =====================================================================================================================
+// Map the current contents of the file read-only. The mapping is not grown as entries are appended; reads past its end
+// go through the file descriptor instead. An empty file (e.g. a newly created archive) is left unmapped.
+Result ArchiveFile::InitMapping()
+{
+    Result      result = Result::ErrorUnknown;
+    struct stat statBuf;
+
+    if (fstat(m_hFile, &statBuf) == 0)
+    {
+        const size_t fileSize = static_cast<size_t>(statBuf.st_size);
+
+        if (fileSize == 0)
+        {
+            result = Result::Success;
+        }
+        else
+        {
+            void* const pMapped = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, m_hFile, 0);
+
+            if (pMapped != MAP_FAILED)
+            {
+                m_pMappedBase = pMapped;
+                m_mappedSize  = fileSize;
+                result        = Result::Success;
+            }
+            else
+            {
+                result = ConvertErrno(errno);
+            }
+        }
+    }
+    else
+    {
+        result = ConvertErrno(errno);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Load the access order recorded by the previous run and start a thread that warms those entries in that order. Also
+// enables recording of this run's order if the archive is writable; a read-only archive never writes its side file.
+Result ArchiveFile::InitPrefetch(
+    const ArchiveFileOpenInfo* pInfo)
+{
+    Strncpy(m_accessOrderPath, pInfo->pFilePath, sizeof(m_accessOrderPath));
+    Strncat(m_accessOrderPath, sizeof(m_accessOrderPath), "/");
+    Strncat(m_accessOrderPath, sizeof(m_accessOrderPath), pInfo->pFileName);
+    Strncat(m_accessOrderPath, sizeof(m_accessOrderPath), AccessOrderSuffix);
+
+    Result result = m_haveWriteAccess ? m_accessed.Resize(m_entries.NumElements(), false) : Result::Success;
+
+    if (result == Result::Success)
+    {
+        m_recordAccessOrder = m_haveWriteAccess;
+
+        const int32 fd = open(m_accessOrderPath, O_RDONLY);
+
+        if (fd != InvalidFd)
+        {
+            AccessOrderHeader header = {};
+
+            if ((read(fd, &header, sizeof(header)) == sizeof(header)) &&
+                (memcmp(header.marker, AccessOrderMarker, sizeof(AccessOrderMarker)) == 0))
+            {
+                const uint32 numEntries = m_entries.NumElements();
+                uint32       ordinals[256];
+                uint32       remaining  = header.entryCount;
+
+                while ((remaining > 0) && (result == Result::Success))
+                {
+                    const uint32  batch     = Min<uint32>(remaining, static_cast<uint32>(ArrayLen(ordinals)));
+                    const ssize_t bytesRead = read(fd, ordinals, batch * sizeof(uint32));
+
+                    if (bytesRead != static_cast<ssize_t>(batch * sizeof(uint32)))
+                    {
+                        break;
+                    }
+
+                    for (uint32 i = 0; (i < batch) && (result == Result::Success); i++)
+                    {
+                        // The archive is append-only, so an ordinal recorded earlier still names the same entry
+                        if (ordinals[i] < numEntries)
+                        {
+                            const ArchiveEntryHeader& entry = m_entries.At(ordinals[i]);
+
+                            if (IsMapped(entry.dataPosition, entry.dataSize))
+                            {
+                                result = m_prefetchRanges.PushBack({ entry.dataPosition, entry.dataSize });
+                            }
+                        }
+                    }
+
+                    remaining -= batch;
+                }
+            }
+
+            close(fd);
+        }
+    }
+
+    if ((result == Result::Success) && (m_prefetchRanges.IsEmpty() == false))
+    {
+        result = m_prefetchThread.Begin(&PrefetchThreadFunc, this);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Prefetch thread entry point. Hints the kernel to read in each recorded entry, in the order the previous run first
+// touched them, so the reads the application is about to make find their pages resident.
+void ArchiveFile::PrefetchThreadFunc(
+    void* pParam)
+{
+    ArchiveFile* const pThis    = static_cast<ArchiveFile*>(pParam);
+    const size_t       pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    for (auto iter = pThis->m_prefetchRanges.Begin(); iter.IsValid() && (pThis->m_stopPrefetch == 0); iter.Next())
+    {
+        const PrefetchRange& range = iter.Get();
+        const size_t         begin = range.offset & ~(pageSize - 1);
+
+        madvise(const_cast<void*>(VoidPtrInc(pThis->m_pMappedBase, begin)),
+                (range.offset + range.size) - begin,
+                MADV_WILLNEED);
+    }
+}
+
+// =====================================================================================================================
+// Note the first read of an entry so the next run can prefetch it
+void ArchiveFile::RecordAccess(
+    const ArchiveEntryHeader* pHeader)
+{
+    if (m_recordAccessOrder)
+    {
+        const uint32 ordinal = pHeader->ordinalId;
+
+        if (ordinal >= m_accessed.NumElements())
+        {
+            const Result result = m_accessed.Resize(ordinal + 1, false);
+            PAL_ALERT(IsErrorResult(result));
+        }
+
+        if ((ordinal < m_accessed.NumElements()) && (m_accessed[ordinal] == false))
+        {
+            m_accessed[ordinal] = true;
+
+            const Result result = m_accessOrder.PushBack(ordinal);
+            PAL_ALERT(IsErrorResult(result));
+        }
+    }
+}
+
+// =====================================================================================================================
+// Write this run's access order next to the archive. Written to a temporary file first so that another process reading
+// the order at the same time never sees a partial file.
+void ArchiveFile::SaveAccessOrder() const
+{
+    if (m_accessOrder.IsEmpty() == false)
+    {
+        char tempPath[PathBufferLen];
+        Snprintf(tempPath, sizeof(tempPath), "%s.%d", m_accessOrderPath, getpid());
+
+        const int32 fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+
+        if (fd != InvalidFd)
+        {
+            AccessOrderHeader header = {};
+            memcpy(header.marker, AccessOrderMarker, sizeof(header.marker));
+            header.entryCount = m_accessOrder.NumElements();
+
+            const size_t dataSize = header.entryCount * sizeof(uint32);
+            bool         success  = (write(fd, &header, sizeof(header)) == sizeof(header)) &&
+                                    (write(fd, m_accessOrder.Data(), dataSize) == static_cast<ssize_t>(dataSize));
+
+            close(fd);
+
+            if ((success == false) || (rename(tempPath, m_accessOrderPath) != 0))
+            {
+                remove(tempPath);
+            }
+        }
+    }
+}
+
 // =====================================================================================================================
 // Initial cache pages to an empty state
 Result ArchiveFile::InitPages()
@@ -26,6 +26,7 @@
 #include "palArchiveFileFmt.h"
 #include "palIntrusiveList.h"
 #include "palLinearAllocator.h"
+#include "palThread.h"
 #include "palVector.h"
 
 namespace Util
@@ -67,6 +68,10 @@ public:
         const ArchiveEntryHeader*   pHeader,
         void*                       pDataBuffer) override;
 
+    virtual Result GetEntryData(
+        const ArchiveEntryHeader*   pHeader,
+        const void**                ppData) override;
+
     virtual Result Write(
         ArchiveEntryHeader* pHeader,
         const void*         pData) override;
@@ -129,6 +134,17 @@ private:
     Result ReadCached(size_t fileOffset, void* pBuffer, size_t readSize, bool forceReload, bool wait);
     Result WriteCached(size_t fileOffset, const void* pData, size_t writeSize);
 
+    // Memory mapped I/O
+    Result InitMapping();
+    bool   IsMapped(size_t fileOffset, size_t size) const
+        { return (m_pMappedBase != nullptr) && (fileOffset <= m_mappedSize) && (size <= (m_mappedSize - fileOffset)); }
+
+    // Access order recording and background prefetch
+    Result InitPrefetch(const ArchiveFileOpenInfo* pInfo);
+    void   RecordAccess(const ArchiveEntryHeader* pHeader);
+    void   SaveAccessOrder() const;
+    static void PrefetchThreadFunc(void* pParam);
+
     // Page management
     Result    InitPages();
     PageInfo* FindPage(size_t fileOffset, bool loadOnMiss, bool forceReload);
@@ -142,6 +158,16 @@ private:
 
     using EntryVector = Vector<ArchiveEntryHeader, 16, ForwardAllocator>;
 
+    // Describes a region of the mapped file to warm by the prefetch thread
+    struct PrefetchRange
+    {
+        size_t offset;
+        size_t size;
+    };
+    using PrefetchVector = Vector<PrefetchRange, 16, ForwardAllocator>;
+    using OrdinalVector  = Vector<uint32, 16, ForwardAllocator>;
+    using FlagVector     = Vector<bool, 16, ForwardAllocator>;
+
     // Allocator
     ForwardAllocator*       Allocator() { return &m_allocator; }
     ForwardAllocator        m_allocator;
@@ -165,6 +191,21 @@ private:
     PageInfo                m_pages[MaxPageCount];
     size_t                  m_pageCount;
     size_t                  m_pageSize;
+
+    // Read-only file mapping: MAY NOT BE INITIALIZED IF WE AREN'T USING MEMORY MAPPED READS
+    const void*             m_pMappedBase;
+    size_t                  m_mappedSize;
+
+    // Access order of this run, saved for the next one: EMPTY IF WE AREN'T RECORDING
+    bool                    m_recordAccessOrder;
+    OrdinalVector           m_accessOrder;
+    FlagVector              m_accessed;
+    char                    m_accessOrderPath[PathBufferLen];
+
+    // Background prefetch of entries read by the previous run
+    Thread                  m_prefetchThread;
+    PrefetchVector          m_prefetchRanges;
+    volatile uint32         m_stopPrefetch;
 };
 
 } //namespace Util
@@ -0,0 +1,1136 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  amdgpuShim.cpp
+ * @brief Stand-in libdrm_amdgpu.so.1 for palBoListBench.
+ *
+ * Reports a Navi21 with a GFX, four compute and two SDMA rings.  BOs are bookkeeping only: they get system memory when
+ * CPU-mapped and remember the VA they are mapped at.  Submissions don't execute anything and complete immediately; if
+ * recording is enabled, the BO list of each submission is translated to GPU VAs for DrmShimGetLastSubmit().
+ ***********************************************************************************************************************
+ */
+
+#include "drmShim.h"
+
+#include <amdgpu.h>
+#include <amdgpu_drm.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <unistd.h>
+#include <vector>
+
+struct amdgpu_device
+{
+    int fd;
+};
+
+struct amdgpu_context
+{
+    uint64_t seqNo;
+};
+
+struct amdgpu_bo
+{
+    uint32_t handle;
+    bool     alive;      // BOs are never deleted, so that stale handles in a BO list can be detected.
+    bool     userMemory;
+    uint32_t heap;
+    uint64_t flags;
+    uint64_t size;
+    uint64_t gpuVa;
+    void*    pCpuAddr;
+};
+
+struct amdgpu_bo_list
+{
+    std::vector<amdgpu_bo_handle> bos;
+};
+
+struct amdgpu_va
+{
+    uint64_t address;
+    uint64_t size;
+};
+
+// Legacy semaphores, used instead of syncobjs when the kernel doesn't report DRM_CAP_SYNCOBJ.
+struct amdgpu_semaphore
+{
+    bool signaled;
+};
+
+namespace
+{
+
+constexpr uint64_t VaStart     = 0x0000000000800000ull;
+constexpr uint64_t VaEnd       = 0x0000800000000000ull;
+constexpr uint64_t HighVaStart = 0xFFFF800000000000ull;
+constexpr uint64_t HighVaEnd   = 0xFFFFFFFFFFE00000ull;
+
+DrmShimConfig                      g_config    = { 42, true, false };
+std::mutex                         g_lock;
+amdgpu_device                      g_device    = { -1 };
+std::vector<amdgpu_bo*>            g_bos(1, nullptr);      // Indexed by KMS handle; handle zero is invalid.
+std::vector<std::vector<uint32_t>> g_rawBoLists(1);        // Indexed by raw BO list handle.
+uint32_t                           g_nextSyncobj = 1;
+uint64_t                           g_nextVa      = 4ull << 30;
+uint64_t                           g_nextHighVa  = HighVaStart;
+uint64_t                           g_timestamp   = 0;
+uint64_t                           g_submitCount = 0;
+uint32_t                           g_unknownHandles = 0;
+std::vector<uint64_t>              g_submitVas;
+
+// =====================================================================================================================
+uint64_t AlignUp(
+    uint64_t value,
+    uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// =====================================================================================================================
+// Records the VA of one entry of a submission's BO list.  Must be called with g_lock held.
+void RecordSubmitBo(
+    const amdgpu_bo* pBo)
+{
+    if ((pBo != nullptr) && pBo->alive)
+    {
+        g_submitVas.push_back(pBo->gpuVa);
+    }
+    else
+    {
+        g_submitVas.push_back(0);
+        g_unknownHandles++;
+    }
+}
+
+// =====================================================================================================================
+// Records the BO list of a raw submission.  Must be called with g_lock held.
+void RecordRawSubmit(
+    const drm_amdgpu_bo_list_entry* pEntries,
+    uint32_t                        entryCount,
+    uint32_t                        entrySize)
+{
+    const char* pEntry = reinterpret_cast<const char*>(pEntries);
+
+    for (uint32_t i = 0; i < entryCount; ++i, pEntry += entrySize)
+    {
+        const uint32_t handle = reinterpret_cast<const drm_amdgpu_bo_list_entry*>(pEntry)->bo_handle;
+
+        RecordSubmitBo((handle < g_bos.size()) ? g_bos[handle] : nullptr);
+    }
+}
+
+} // anonymous namespace
+
+extern "C"
+{
+
+// =====================================================================================================================
+void DrmShimSetConfig(
+    const DrmShimConfig* pConfig)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+    g_config = *pConfig;
+}
+
+// =====================================================================================================================
+void DrmShimGetLastSubmit(
+    DrmShimSubmit* pSubmit)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+    pSubmit->submitCount    = g_submitCount;
+    pSubmit->boCount        = static_cast<uint32_t>(g_submitVas.size());
+    pSubmit->unknownHandles = g_unknownHandles;
+    pSubmit->pGpuVas        = g_submitVas.data();
+}
+
+// =====================================================================================================================
+int amdgpu_device_initialize(
+    int                   fd,
+    uint32_t*             major_version,
+    uint32_t*             minor_version,
+    amdgpu_device_handle* device_handle)
+{
+    g_device.fd    = fd;
+    *major_version = 3;
+    *minor_version = g_config.drmMinorVersion;
+    *device_handle = &g_device;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_device_deinitialize(
+    amdgpu_device_handle device_handle)
+{
+    return 0;
+}
+
+// =====================================================================================================================
+const char* amdgpu_get_marketing_name(
+    amdgpu_device_handle dev)
+{
+    return "AMD Radeon RX 6900 XT (palBoListBench stand-in)";
+}
+
+// =====================================================================================================================
+int amdgpu_query_gpu_info(
+    amdgpu_device_handle    dev,
+    struct amdgpu_gpu_info* info)
+{
+    memset(info, 0, sizeof(*info));
+
+    info->asic_id                      = 0x73BF;
+    info->chip_external_rev            = 40;    // NV_NAVI21_P_A0
+    info->family_id                    = 0x8F;  // FAMILY_NV
+    info->ids_flags                    = AMDGPU_IDS_FLAGS_PREEMPTION;
+    info->max_engine_clk               = 2250000;
+    info->max_memory_clk               = 1000000;
+    info->num_shader_engines           = 4;
+    info->num_shader_arrays_per_engine = 2;
+    info->num_hw_gfx_contexts          = 8;
+    info->rb_pipes                     = 16;
+    info->enabled_rb_pipes_mask        = 0xFFFF;
+    info->gpu_counter_freq             = 100000;
+    info->gb_addr_cfg                  = 0x345;
+    info->cu_active_number             = 80;
+    info->vram_type                    = AMDGPU_VRAM_TYPE_GDDR6;
+    info->vram_bit_width               = 256;
+    info->pci_rev_id                   = 0xC1;
+
+    for (uint32_t se = 0; se < info->num_shader_engines; ++se)
+    {
+        for (uint32_t sh = 0; sh < info->num_shader_arrays_per_engine; ++sh)
+        {
+            info->cu_bitmap[se][sh] = 0x3FF;
+        }
+    }
+
+    // Two always-on CUs per shader array, in the packed 8-bit-per-SH layout the kernel reports for the first two SEs.
+    info->cu_ao_mask = 0x03030303;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_query_info(
+    amdgpu_device_handle dev,
+    unsigned             info_id,
+    unsigned             size,
+    void*                value)
+{
+    int ret = 0;
+
+    memset(value, 0, size);
+
+    if ((info_id == AMDGPU_INFO_DEV_INFO) && (size >= sizeof(drm_amdgpu_info_device)))
+    {
+        drm_amdgpu_info_device*const pInfo = static_cast<drm_amdgpu_info_device*>(value);
+        amdgpu_gpu_info              gpuInfo;
+
+        amdgpu_query_gpu_info(dev, &gpuInfo);
+
+        pInfo->device_id                    = gpuInfo.asic_id;
+        pInfo->external_rev                 = gpuInfo.chip_external_rev;
+        pInfo->pci_rev                      = gpuInfo.pci_rev_id;
+        pInfo->family                       = gpuInfo.family_id;
+        pInfo->num_shader_engines           = gpuInfo.num_shader_engines;
+        pInfo->num_shader_arrays_per_engine = gpuInfo.num_shader_arrays_per_engine;
+        pInfo->gpu_counter_freq             = gpuInfo.gpu_counter_freq;
+        pInfo->max_engine_clock             = gpuInfo.max_engine_clk;
+        pInfo->max_memory_clock             = gpuInfo.max_memory_clk;
+        pInfo->cu_active_number             = gpuInfo.cu_active_number;
+        pInfo->enabled_rb_pipes_mask        = gpuInfo.enabled_rb_pipes_mask;
+        pInfo->num_rb_pipes                 = gpuInfo.rb_pipes;
+        pInfo->num_hw_gfx_contexts          = gpuInfo.num_hw_gfx_contexts;
+        pInfo->ids_flags                    = gpuInfo.ids_flags;
+        pInfo->virtual_address_offset       = VaStart;
+        pInfo->virtual_address_max          = VaEnd;
+        pInfo->virtual_address_alignment    = 4096;
+        pInfo->pte_fragment_size            = 2u << 20;
+        pInfo->gart_page_size               = 4096;
+        pInfo->vram_type                    = gpuInfo.vram_type;
+        pInfo->vram_bit_width               = gpuInfo.vram_bit_width;
+        pInfo->gc_double_offchip_lds_buf    = 1;
+        pInfo->wave_front_size              = 32;
+        pInfo->num_shader_visible_vgprs     = 1024;
+        pInfo->num_cu_per_sh                = 10;
+        pInfo->num_tcc_blocks               = 20;
+        pInfo->gs_vgt_table_depth           = 32;
+        pInfo->gs_prim_buffer_depth         = 1792;
+        pInfo->max_gs_waves_per_vgt         = 32;
+        pInfo->high_va_offset               = HighVaStart;
+        pInfo->high_va_max                  = HighVaEnd;
+        pInfo->gl2c_cache_size              = 4u << 20;
+        pInfo->mall_size                    = 128ull << 20;
+
+        memcpy(pInfo->cu_bitmap, gpuInfo.cu_bitmap, sizeof(pInfo->cu_bitmap));
+
+        for (uint32_t se = 0; se < gpuInfo.num_shader_engines; ++se)
+        {
+            for (uint32_t sh = 0; sh < gpuInfo.num_shader_arrays_per_engine; ++sh)
+            {
+                pInfo->cu_ao_bitmap[se][sh] = 0x3;
+            }
+        }
+    }
+    else if ((info_id == AMDGPU_INFO_MEMORY) && (size >= sizeof(drm_amdgpu_memory_info)))
+    {
+        drm_amdgpu_memory_info*const pInfo = static_cast<drm_amdgpu_memory_info*>(value);
+
+        pInfo->vram.total_heap_size                = 16ull << 30;
+        pInfo->vram.usable_heap_size               = 16ull << 30;
+        pInfo->cpu_accessible_vram.total_heap_size = 256ull << 20;
+        pInfo->cpu_accessible_vram.usable_heap_size = 256ull << 20;
+        pInfo->gtt.total_heap_size                 = 8ull << 30;
+        pInfo->gtt.usable_heap_size                = 8ull << 30;
+    }
+    else if ((info_id == AMDGPU_INFO_TIMESTAMP) && (size >= sizeof(uint64_t)))
+    {
+        std::lock_guard<std::mutex> lock(g_lock);
+        *static_cast<uint64_t*>(value) = ++g_timestamp;
+    }
+    else
+    {
+        ret = -EINVAL;
+    }
+
+    return ret;
+}
+
+// =====================================================================================================================
+int amdgpu_query_hw_ip_info(
+    amdgpu_device_handle          dev,
+    unsigned                      type,
+    unsigned                      ip_instance,
+    struct drm_amdgpu_info_hw_ip* info)
+{
+    memset(info, 0, sizeof(*info));
+
+    info->hw_ip_version_major = (type == AMDGPU_HW_IP_DMA) ? 5 : 10;
+    info->ib_start_alignment  = 32;
+    info->ib_size_alignment   = 4;
+
+    switch (type)
+    {
+    case AMDGPU_HW_IP_GFX:
+        info->available_rings = 0x1;
+        break;
+    case AMDGPU_HW_IP_COMPUTE:
+        info->available_rings = 0xF;
+        break;
+    case AMDGPU_HW_IP_DMA:
+        info->available_rings = 0x3;
+        break;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_query_hw_ip_count(
+    amdgpu_device_handle dev,
+    unsigned             type,
+    uint32_t*            count)
+{
+    *count = ((type == AMDGPU_HW_IP_GFX) || (type == AMDGPU_HW_IP_COMPUTE) || (type == AMDGPU_HW_IP_DMA)) ? 1 : 0;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_query_firmware_version(
+    amdgpu_device_handle dev,
+    unsigned             fw_type,
+    unsigned             ip_instance,
+    unsigned             index,
+    uint32_t*            version,
+    uint32_t*            feature)
+{
+    *version = 100;
+    *feature = 38;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_query_heap_info(
+    amdgpu_device_handle     dev,
+    uint32_t                 heap,
+    uint32_t                 flags,
+    struct amdgpu_heap_info* info)
+{
+    memset(info, 0, sizeof(*info));
+
+    if (heap == AMDGPU_GEM_DOMAIN_VRAM)
+    {
+        info->heap_size = (flags & AMDGPU_GEM_CREATE_CPU_ACCESS_REQUIRED) ? (256ull << 20) : (16ull << 30);
+    }
+    else
+    {
+        info->heap_size = 8ull << 30;
+    }
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_query_buffer_size_alignment(
+    amdgpu_device_handle                  dev,
+    struct amdgpu_buffer_size_alignments* info)
+{
+    info->size_local  = 2u << 20;
+    info->size_remote = 4096;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_query_sensor_info(
+    amdgpu_device_handle dev,
+    unsigned             sensor_type,
+    unsigned             size,
+    void*                value)
+{
+    return -EINVAL;
+}
+
+// =====================================================================================================================
+int amdgpu_query_video_caps_info(
+    amdgpu_device_handle dev,
+    unsigned             cap_type,
+    unsigned             size,
+    void*                value)
+{
+    return -EINVAL;
+}
+
+// =====================================================================================================================
+int amdgpu_read_mm_registers(
+    amdgpu_device_handle dev,
+    unsigned             dword_offset,
+    unsigned             count,
+    uint32_t             instance,
+    uint32_t             flags,
+    uint32_t*            values)
+{
+    return -EINVAL;
+}
+
+// =====================================================================================================================
+int amdgpu_va_range_query(
+    amdgpu_device_handle      dev,
+    enum amdgpu_gpu_va_range  type,
+    uint64_t*                 start,
+    uint64_t*                 end)
+{
+    *start = VaStart;
+    *end   = VaEnd;
+
+    return 0;
+}
+
+// =====================================================================================================================
+// A bump allocator: VA ranges are reserved by PAL's VAM in large blocks and rarely freed.
+int amdgpu_va_range_alloc(
+    amdgpu_device_handle     dev,
+    enum amdgpu_gpu_va_range va_range_type,
+    uint64_t                 size,
+    uint64_t                 va_base_alignment,
+    uint64_t                 va_base_required,
+    uint64_t*                va_base_allocated,
+    amdgpu_va_handle*        va_range_handle,
+    uint64_t                 flags)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+
+    const uint64_t alignment = (va_base_alignment > 4096) ? va_base_alignment : 4096;
+    uint64_t       address   = va_base_required;
+
+    if (address == 0)
+    {
+        uint64_t*const pNext = (flags & AMDGPU_VA_RANGE_HIGH) ? &g_nextHighVa : &g_nextVa;
+
+        address = AlignUp(*pNext, alignment);
+        *pNext  = address + AlignUp(size, 4096);
+    }
+
+    amdgpu_va*const pVa = new amdgpu_va{ address, size };
+
+    *va_base_allocated = address;
+    *va_range_handle   = pVa;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_va_range_free(
+    amdgpu_va_handle va_range_handle)
+{
+    delete va_range_handle;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_alloc(
+    amdgpu_device_handle            dev,
+    struct amdgpu_bo_alloc_request* alloc_buffer,
+    amdgpu_bo_handle*               buf_handle)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+
+    amdgpu_bo*const pBo = new amdgpu_bo{};
+
+    pBo->handle = static_cast<uint32_t>(g_bos.size());
+    pBo->alive  = true;
+    pBo->heap   = alloc_buffer->preferred_heap;
+    pBo->flags  = alloc_buffer->flags;
+    pBo->size   = alloc_buffer->alloc_size;
+
+    g_bos.push_back(pBo);
+    *buf_handle = pBo;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_create_bo_from_user_mem(
+    amdgpu_device_handle dev,
+    void*                cpu,
+    uint64_t             size,
+    amdgpu_bo_handle*    buf_handle)
+{
+    amdgpu_bo_alloc_request request = {};
+    request.alloc_size     = size;
+    request.preferred_heap = AMDGPU_GEM_DOMAIN_GTT;
+
+    const int ret = amdgpu_bo_alloc(dev, &request, buf_handle);
+
+    (*buf_handle)->userMemory = true;
+    (*buf_handle)->pCpuAddr   = cpu;
+
+    return ret;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_free(
+    amdgpu_bo_handle buf_handle)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+
+    if (buf_handle->userMemory == false)
+    {
+        free(buf_handle->pCpuAddr);
+    }
+
+    buf_handle->pCpuAddr = nullptr;
+    buf_handle->alive    = false;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_query_info(
+    amdgpu_bo_handle      buf_handle,
+    struct amdgpu_bo_info* info)
+{
+    memset(info, 0, sizeof(*info));
+
+    info->alloc_size     = buf_handle->size;
+    info->phys_alignment = 4096;
+    info->preferred_heap = buf_handle->heap;
+    info->alloc_flags    = buf_handle->flags;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_set_metadata(
+    amdgpu_bo_handle            buf_handle,
+    struct amdgpu_bo_metadata*  info)
+{
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_export(
+    amdgpu_bo_handle          buf_handle,
+    enum amdgpu_bo_handle_type type,
+    uint32_t*                 shared_handle)
+{
+    int ret = 0;
+
+    if (type == amdgpu_bo_handle_type_dma_buf_fd)
+    {
+        *shared_handle = static_cast<uint32_t>(open("/dev/null", O_RDONLY | O_CLOEXEC));
+    }
+    else
+    {
+        *shared_handle = buf_handle->handle;
+    }
+
+    return ret;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_cpu_map(
+    amdgpu_bo_handle buf_handle,
+    void**           cpu)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+
+    int ret = 0;
+
+    if (buf_handle->pCpuAddr == nullptr)
+    {
+        const size_t size = static_cast<size_t>(AlignUp(buf_handle->size, 4096));
+
+        buf_handle->pCpuAddr = aligned_alloc(4096, size);
+
+        if (buf_handle->pCpuAddr != nullptr)
+        {
+            memset(buf_handle->pCpuAddr, 0, size);
+        }
+        else
+        {
+            ret = -ENOMEM;
+        }
+    }
+
+    *cpu = buf_handle->pCpuAddr;
+
+    return ret;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_cpu_unmap(
+    amdgpu_bo_handle buf_handle)
+{
+    // The memory stays allocated until the BO is freed, so its contents survive being mapped again.
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_wait_for_idle(
+    amdgpu_bo_handle buf_handle,
+    uint64_t         timeout_ns,
+    bool*            buffer_busy)
+{
+    *buffer_busy = false;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_va_op_raw(
+    amdgpu_device_handle dev,
+    amdgpu_bo_handle     bo,
+    uint64_t             offset,
+    uint64_t             size,
+    uint64_t             addr,
+    uint64_t             flags,
+    uint32_t             ops)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+
+    if (bo != nullptr)
+    {
+        if (((ops == AMDGPU_VA_OP_MAP) || (ops == AMDGPU_VA_OP_REPLACE)) && (offset == 0))
+        {
+            bo->gpuVa = addr;
+        }
+        else if ((ops == AMDGPU_VA_OP_UNMAP) && (bo->gpuVa == addr))
+        {
+            bo->gpuVa = 0;
+        }
+    }
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_va_op(
+    amdgpu_bo_handle bo,
+    uint64_t         offset,
+    uint64_t         size,
+    uint64_t         addr,
+    uint64_t         flags,
+    uint32_t         ops)
+{
+    return amdgpu_bo_va_op_raw(&g_device, bo, offset, size, addr, flags, ops);
+}
+
+// =====================================================================================================================
+int amdgpu_bo_list_create_raw(
+    amdgpu_device_handle              dev,
+    uint32_t                          number_of_buffers,
+    struct drm_amdgpu_bo_list_entry*  buffers,
+    uint32_t*                         result)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+
+    std::vector<uint32_t> handles(number_of_buffers);
+
+    for (uint32_t i = 0; i < number_of_buffers; ++i)
+    {
+        handles[i] = buffers[i].bo_handle;
+    }
+
+    *result = static_cast<uint32_t>(g_rawBoLists.size());
+    g_rawBoLists.push_back(std::move(handles));
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_list_destroy_raw(
+    amdgpu_device_handle dev,
+    uint32_t             bo_list)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+
+    if (bo_list < g_rawBoLists.size())
+    {
+        g_rawBoLists[bo_list].clear();
+        g_rawBoLists[bo_list].shrink_to_fit();
+    }
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_list_create(
+    amdgpu_device_handle   dev,
+    uint32_t               number_of_resources,
+    amdgpu_bo_handle*      resources,
+    uint8_t*               resource_prios,
+    amdgpu_bo_list_handle* result)
+{
+    *result = new amdgpu_bo_list{ std::vector<amdgpu_bo_handle>(resources, resources + number_of_resources) };
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_bo_list_destroy(
+    amdgpu_bo_list_handle handle)
+{
+    delete handle;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_ctx_create3(
+    amdgpu_device_handle   dev,
+    uint32_t               priority,
+    uint32_t               flags,
+    amdgpu_context_handle* context)
+{
+    *context = new amdgpu_context{};
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_ctx_create2(
+    amdgpu_device_handle   dev,
+    uint32_t               priority,
+    amdgpu_context_handle* context)
+{
+    return amdgpu_cs_ctx_create3(dev, priority, 0, context);
+}
+
+// =====================================================================================================================
+int amdgpu_cs_ctx_create(
+    amdgpu_device_handle   dev,
+    amdgpu_context_handle* context)
+{
+    return amdgpu_cs_ctx_create3(dev, 0, 0, context);
+}
+
+// =====================================================================================================================
+int amdgpu_cs_ctx_free(
+    amdgpu_context_handle context)
+{
+    delete context;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_ctx_stable_pstate(
+    amdgpu_context_handle context,
+    uint32_t              op,
+    uint32_t              flags,
+    uint32_t*             out_flags)
+{
+    if (out_flags != nullptr)
+    {
+        *out_flags = 0;
+    }
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_query_reset_state(
+    amdgpu_context_handle context,
+    uint32_t*             state,
+    uint32_t*             hangs)
+{
+    *state = AMDGPU_CTX_NO_RESET;
+    *hangs = 0;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_query_reset_state2(
+    amdgpu_context_handle context,
+    uint64_t*             flags)
+{
+    *flags = 0;
+
+    return 0;
+}
+
+// =====================================================================================================================
+// The kernel only validates the BO list here; the cost of that is left out of the measurement on purpose.
+int amdgpu_cs_submit_raw2(
+    amdgpu_device_handle        dev,
+    amdgpu_context_handle       context,
+    uint32_t                    bo_list_handle,
+    int                         num_chunks,
+    struct drm_amdgpu_cs_chunk* chunks,
+    uint64_t*                   seq_no)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+
+    g_submitCount++;
+
+    if (g_config.recordSubmits)
+    {
+        g_submitVas.clear();
+        g_unknownHandles = 0;
+
+        if ((bo_list_handle != 0) && (bo_list_handle < g_rawBoLists.size()))
+        {
+            for (uint32_t handle : g_rawBoLists[bo_list_handle])
+            {
+                RecordSubmitBo((handle < g_bos.size()) ? g_bos[handle] : nullptr);
+            }
+        }
+
+        for (int i = 0; i < num_chunks; ++i)
+        {
+            if (chunks[i].chunk_id == AMDGPU_CHUNK_ID_BO_HANDLES)
+            {
+                const drm_amdgpu_bo_list_in*const pListIn =
+                    reinterpret_cast<const drm_amdgpu_bo_list_in*>(static_cast<uintptr_t>(chunks[i].chunk_data));
+
+                RecordRawSubmit(reinterpret_cast<const drm_amdgpu_bo_list_entry*>(
+                                    static_cast<uintptr_t>(pListIn->bo_info_ptr)),
+                                pListIn->bo_number,
+                                pListIn->bo_info_size);
+            }
+        }
+    }
+
+    *seq_no = ++context->seqNo;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_submit(
+    amdgpu_context_handle     context,
+    uint64_t                  flags,
+    struct amdgpu_cs_request* ibs_request,
+    uint32_t                  number_of_requests)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+
+    for (uint32_t request = 0; request < number_of_requests; ++request)
+    {
+        g_submitCount++;
+
+        if (g_config.recordSubmits)
+        {
+            g_submitVas.clear();
+            g_unknownHandles = 0;
+
+            if (ibs_request[request].resources != nullptr)
+            {
+                for (amdgpu_bo_handle bo : ibs_request[request].resources->bos)
+                {
+                    RecordSubmitBo(bo);
+                }
+            }
+        }
+
+        ibs_request[request].seq_no = ++context->seqNo;
+    }
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_query_fence_status(
+    struct amdgpu_cs_fence* fence,
+    uint64_t                timeout_ns,
+    uint64_t                flags,
+    uint32_t*               expired)
+{
+    *expired = 1;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_wait_fences(
+    struct amdgpu_cs_fence* fences,
+    uint32_t                fence_count,
+    bool                    wait_all,
+    uint64_t                timeout_ns,
+    uint32_t*               status,
+    uint32_t*               first)
+{
+    *status = 1;
+
+    if (first != nullptr)
+    {
+        *first = 0;
+    }
+
+    return 0;
+}
+
+// =====================================================================================================================
+void amdgpu_cs_chunk_fence_to_dep(
+    struct amdgpu_cs_fence*          fence,
+    struct drm_amdgpu_cs_chunk_dep*  dep)
+{
+    dep->ip_type     = fence->ip_type;
+    dep->ip_instance = fence->ip_instance;
+    dep->ring        = fence->ring;
+    dep->ctx_id      = 0;
+    dep->handle      = fence->fence;
+}
+
+// =====================================================================================================================
+void amdgpu_cs_chunk_fence_info_to_data(
+    struct amdgpu_cs_fence_info*     fence_info,
+    struct drm_amdgpu_cs_chunk_data* data)
+{
+    data->fence_data.handle = fence_info->handle->handle;
+    data->fence_data.offset = static_cast<uint32_t>(fence_info->offset * sizeof(uint64_t));
+}
+
+// =====================================================================================================================
+int amdgpu_cs_create_semaphore(
+    amdgpu_semaphore_handle* sem)
+{
+    *sem = new amdgpu_semaphore{ false };
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_signal_semaphore(
+    amdgpu_context_handle   ctx,
+    uint32_t                ip_type,
+    uint32_t                ip_instance,
+    uint32_t                ring,
+    amdgpu_semaphore_handle sem)
+{
+    sem->signaled = true;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_wait_semaphore(
+    amdgpu_context_handle   ctx,
+    uint32_t                ip_type,
+    uint32_t                ip_instance,
+    uint32_t                ring,
+    amdgpu_semaphore_handle sem)
+{
+    sem->signaled = false;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_destroy_semaphore(
+    amdgpu_semaphore_handle sem)
+{
+    delete sem;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_create_syncobj2(
+    amdgpu_device_handle dev,
+    uint32_t             flags,
+    uint32_t*            syncobj)
+{
+    std::lock_guard<std::mutex> lock(g_lock);
+    *syncobj = g_nextSyncobj++;
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_create_syncobj(
+    amdgpu_device_handle dev,
+    uint32_t*            syncobj)
+{
+    return amdgpu_cs_create_syncobj2(dev, 0, syncobj);
+}
+
+// =====================================================================================================================
+int amdgpu_cs_destroy_syncobj(
+    amdgpu_device_handle dev,
+    uint32_t             syncobj)
+{
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_syncobj_reset(
+    amdgpu_device_handle dev,
+    const uint32_t*      syncobjs,
+    uint32_t             syncobj_count)
+{
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_syncobj_signal(
+    amdgpu_device_handle dev,
+    const uint32_t*      syncobjs,
+    uint32_t             syncobj_count)
+{
+    return 0;
+}
+
+// =====================================================================================================================
+// Nothing ever runs, so every syncobj is signaled.
+int amdgpu_cs_syncobj_wait(
+    amdgpu_device_handle dev,
+    uint32_t*            handles,
+    unsigned             num_handles,
+    int64_t              timeout_nsec,
+    unsigned             flags,
+    uint32_t*            first_signaled)
+{
+    if (first_signaled != nullptr)
+    {
+        *first_signaled = 0;
+    }
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_export_syncobj(
+    amdgpu_device_handle dev,
+    uint32_t             syncobj,
+    int*                 shared_fd)
+{
+    *shared_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_import_syncobj(
+    amdgpu_device_handle dev,
+    int                  shared_fd,
+    uint32_t*            syncobj)
+{
+    return amdgpu_cs_create_syncobj2(dev, 0, syncobj);
+}
+
+// =====================================================================================================================
+int amdgpu_cs_syncobj_export_sync_file(
+    amdgpu_device_handle dev,
+    uint32_t             syncobj,
+    int*                 sync_file_fd)
+{
+    *sync_file_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_syncobj_import_sync_file(
+    amdgpu_device_handle dev,
+    uint32_t             syncobj,
+    int                  sync_file_fd)
+{
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_cs_syncobj_transfer(
+    amdgpu_device_handle dev,
+    uint32_t             dst_handle,
+    uint64_t             dst_point,
+    uint32_t             src_handle,
+    uint64_t             src_point,
+    uint32_t             flags)
+{
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_vm_reserve_vmid(
+    amdgpu_device_handle dev,
+    uint32_t             flags)
+{
+    return 0;
+}
+
+// =====================================================================================================================
+int amdgpu_vm_unreserve_vmid(
+    amdgpu_device_handle dev,
+    uint32_t             flags)
+{
+    return 0;
+}
+
+} // extern "C"
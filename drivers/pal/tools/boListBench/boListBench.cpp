@@ -0,0 +1,1387 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  boListBench.cpp
+ * @brief Validation and benchmark of the BO list the amdgpu queue builds for each submission, without a GPU.
+ *
+ * PAL runs against stand-in libdrm.so.2 and libdrm_amdgpu.so.1 libraries (drmShim.cpp, amdgpuShim.cpp) which are built
+ * next to this executable and found through its RUNPATH when PAL's DRM loader opens them.  The real Amdgpu::Device and
+ * Amdgpu::Queue code runs; the stand-in only reads the BO list of each submission and executes nothing.
+ *
+ * Validation drives random global reference churn through IDevice::AddGpuMemoryReferences() and
+ * RemoveGpuMemoryReferences(), per-submit references, allocations destroyed while still referenced (their placement
+ * memory is reused, so the next allocation gets the same address), and a submission which exceeds the reference limit.
+ * After every submission, the BO list the stand-in received is compared with a list rebuilt from scratch from the
+ * bench's own record of the references: every allocation must appear once if it has global references plus once per
+ * per-submit reference, and PAL's internal allocations must appear exactly as they did on the first submission.
+ *
+ * The benchmark keeps a window of --resident allocations with global references.  Before every submission it slides
+ * the window by --churn allocations, removing the oldest references and adding as many new ones, and it passes
+ * --submit-refs more allocations as per-submit references.  The reference updates and IQueue::Submit() are timed
+ * separately; the reported numbers are the median over the repeats of the mean per submission.
+ *
+ * Three submission paths are covered: the BO_HANDLES chunk of amdgpu_cs_submit_raw2() (amdgpu DRM 3.27 and newer),
+ * a BO list created per submission with amdgpu_bo_list_create_raw() (older kernels), and amdgpu_cs_submit() with an
+ * amdgpu_bo_list_create() list (kernels without syncobj support).
+ *
+ * Usage: palBoListBench [--path <chunk|bo-list|legacy|all>] [--mode <verify|bench|all>] [--resident <count>]
+ *                       [--churn <count>] [--submit-refs <count>] [--submits <count>] [--repeats <count>]
+ *
+ * Without --resident, --churn or --submit-refs, the benchmark sweeps a few values of each.
+ *
+ * Nothing retires the busy trackers of PAL's internal command chunks, so builds with asserts report them as still busy
+ * when the device is destroyed.  Numbers should be taken from a release build.
+ ***********************************************************************************************************************
+ */
+
+#include "drmShim.h"
+
+#include "pal.h"
+#include "palCmdAllocator.h"
+#include "palCmdBuffer.h"
+#include "palDevice.h"
+#include "palGpuMemory.h"
+#include "palInlineFuncs.h"
+#include "palLib.h"
+#include "palLibrary.h"
+#include "palPlatform.h"
+#include "palQueue.h"
+#include "palSysUtil.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Pal;
+using namespace Util;
+
+namespace
+{
+
+constexpr uint32 Sweep              = UINT32_MAX;
+constexpr uint32 DefaultSubmits     = 100;
+constexpr uint32 DefaultRepeats     = 5;
+constexpr uint32 WarmupSubmits      = 16;
+constexpr uint32 VerifySubmits      = 3000;
+constexpr uint32 VerifyPoolSize     = 1024;
+constexpr uint32 MaxRepeats         = 64;
+
+constexpr uint32 ResidentSweep[]    = { 1000, 4000, 16000 };
+constexpr uint32 ChurnSweep[]       = { 0, 16, 256 };
+constexpr uint32 SubmitRefsSweep[]  = { 0, 64 };
+
+// How the queue hands its BO list to the kernel, which follows from what the stand-in DRM device reports.
+enum class SubmitPath : uint32
+{
+    Chunk,   // amdgpu_cs_submit_raw2() with an AMDGPU_CHUNK_ID_BO_HANDLES chunk.
+    BoList,  // amdgpu_cs_submit_raw2() with a list from amdgpu_bo_list_create_raw().
+    Legacy,  // amdgpu_cs_submit() with a list from amdgpu_bo_list_create().
+    Count
+};
+
+constexpr const char* SubmitPathNames[] = { "chunk", "bo-list", "legacy" };
+
+// Command line options.
+struct Options
+{
+    bool   paths[static_cast<uint32>(SubmitPath::Count)];
+    bool   verify;
+    bool   bench;
+    uint32 resident;    // Sweep means sweep ResidentSweep.
+    uint32 churn;       // Sweep means sweep ChurnSweep.
+    uint32 submitRefs;  // Sweep means sweep SubmitRefsSweep.
+    uint32 submits;
+    uint32 repeats;
+};
+
+// Entry points of the stand-in DRM libraries.
+struct DrmShim
+{
+    Library                  libDrm;
+    Library                  libDrmAmdgpu;
+    DrmShimSetConfigFunc     pfnDrmSetConfig;
+    DrmShimSetConfigFunc     pfnAmdgpuSetConfig;
+    DrmShimGetLastSubmitFunc pfnGetLastSubmit;
+};
+
+// One client allocation and the references the bench holds on it.  The placement memory outlives the allocation so
+// that a replacement allocation lands at the same address.
+struct Allocation
+{
+    IGpuMemory* pGpuMemory;
+    void*       pPlacement;
+    gpusize     gpuVa;
+    uint32      globalRefs;
+    uint32      submitRefs;
+};
+
+// Maps a GPU VA back to an allocation.
+struct VaEntry
+{
+    gpusize gpuVa;
+    uint32  index;
+};
+
+// A device with one universal queue and a command buffer which is recorded once and submitted over and over.
+struct BenchContext
+{
+    void*          pPlatformMemory;
+    IPlatform*     pPlatform;
+    IDevice*       pDevice;
+    IQueue*        pQueue;
+    ICmdAllocator* pCmdAllocator;
+    ICmdBuffer*    pCmdBuffer;
+    uint32         maxRefs;
+    gpusize        allocationSize;
+    Allocation*    pAllocations;
+    uint32         allocationCount;
+    VaEntry*       pVaMap;
+};
+
+// Checks the BO lists of a sequence of submissions.
+struct Verifier
+{
+    const DrmShim* pShim;
+    uint64         lastSubmitCount;
+    uint32*        pSeen;           // Per allocation: entries found in the last BO list.
+    gpusize*       pInternalVas;    // PAL's own allocations in the first checked BO list, sorted.
+    uint32         internalCount;
+    gpusize*       pScratchVas;
+    uint32         scratchCapacity;
+    bool           haveInternal;
+    uint32         checkedSubmits;
+};
+
+// =====================================================================================================================
+uint32 NextRandom(
+    uint32* pState)
+{
+    // xorshift32
+    uint32 x = *pState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *pState = x;
+
+    return x;
+}
+
+// =====================================================================================================================
+int CompareVaEntries(
+    const void* pLhs,
+    const void* pRhs)
+{
+    const gpusize lhs = static_cast<const VaEntry*>(pLhs)->gpuVa;
+    const gpusize rhs = static_cast<const VaEntry*>(pRhs)->gpuVa;
+
+    return (lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0);
+}
+
+// =====================================================================================================================
+int CompareVas(
+    const void* pLhs,
+    const void* pRhs)
+{
+    const gpusize lhs = *static_cast<const gpusize*>(pLhs);
+    const gpusize rhs = *static_cast<const gpusize*>(pRhs);
+
+    return (lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0);
+}
+
+// =====================================================================================================================
+template <typename Object>
+void DestroyObject(
+    Object** ppObject)
+{
+    if (*ppObject != nullptr)
+    {
+        // All objects are created in placement memory which starts at the object itself.
+        (*ppObject)->Destroy();
+        free(*ppObject);
+        *ppObject = nullptr;
+    }
+}
+
+// =====================================================================================================================
+// Allocates placement memory for and creates a device object through its pair of GetXxxSize()/CreateXxx() methods.
+template <typename CreateInfo, typename CreateFunc, typename Object>
+Result CreateObject(
+    IDevice*          pDevice,
+    size_t            (IDevice::*pfnGetSize)(const CreateInfo&, Result*) const,
+    CreateFunc        pfnCreate,
+    const CreateInfo& createInfo,
+    Object**          ppObject)
+{
+    Result       result = Result::Success;
+    const size_t size   = (pDevice->*pfnGetSize)(createInfo, &result);
+
+    if (result == Result::Success)
+    {
+        void* pMemory = malloc(size);
+
+        if (pMemory == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+        else
+        {
+            result = (pDevice->*pfnCreate)(createInfo, pMemory, ppObject);
+
+            if (result != Result::Success)
+            {
+                free(pMemory);
+                *ppObject = nullptr;
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Loads the stand-in DRM libraries the same way PAL does.  Refuses to go on if they turn out to be the real ones, so
+// that the bench never submits to an actual GPU.
+bool LoadDrmShim(
+    DrmShim* pShim)
+{
+    const bool loaded =
+        (pShim->libDrm.Load("libdrm.so.2") == Result::Success)                                   &&
+        (pShim->libDrmAmdgpu.Load("libdrm_amdgpu.so.1") == Result::Success)                      &&
+        pShim->libDrm.GetFunction("DrmShimSetConfig", &pShim->pfnDrmSetConfig)                  &&
+        pShim->libDrmAmdgpu.GetFunction("DrmShimSetConfig", &pShim->pfnAmdgpuSetConfig)         &&
+        pShim->libDrmAmdgpu.GetFunction("DrmShimGetLastSubmit", &pShim->pfnGetLastSubmit);
+
+    if (loaded == false)
+    {
+        fprintf(stderr, "palBoListBench must load its stand-in libdrm.so.2 and libdrm_amdgpu.so.1, which are built "
+                        "next to the executable.\n");
+    }
+
+    return loaded;
+}
+
+// =====================================================================================================================
+void ConfigureDrmShim(
+    const DrmShim& shim,
+    SubmitPath     path,
+    bool           recordSubmits)
+{
+    DrmShimConfig config = {};
+    config.drmMinorVersion = (path == SubmitPath::BoList) ? 26 : 42;
+    config.syncobjSupport  = (path != SubmitPath::Legacy);
+    config.recordSubmits   = recordSubmits;
+
+    shim.pfnDrmSetConfig(&config);
+    shim.pfnAmdgpuSetConfig(&config);
+}
+
+// =====================================================================================================================
+// Sorts the VA lookup table; needed whenever an allocation is created.
+void SortVaMap(
+    BenchContext* pContext)
+{
+    for (uint32 i = 0; i < pContext->allocationCount; ++i)
+    {
+        pContext->pVaMap[i].gpuVa = pContext->pAllocations[i].gpuVa;
+        pContext->pVaMap[i].index = i;
+    }
+
+    qsort(pContext->pVaMap, pContext->allocationCount, sizeof(VaEntry), CompareVaEntries);
+}
+
+// =====================================================================================================================
+// Returns the index of the allocation at the given VA, or UINT32_MAX if it isn't one of the bench's allocations.
+uint32 FindAllocation(
+    const BenchContext& context,
+    gpusize             gpuVa)
+{
+    const VaEntry  key    = { gpuVa, 0 };
+    const VaEntry* pEntry = static_cast<const VaEntry*>(
+        bsearch(&key, context.pVaMap, context.allocationCount, sizeof(VaEntry), CompareVaEntries));
+
+    return (pEntry != nullptr) ? pEntry->index : UINT32_MAX;
+}
+
+// =====================================================================================================================
+// Creates the allocation in the given slot, in the slot's placement memory.
+Result CreateAllocation(
+    BenchContext* pContext,
+    uint32        index)
+{
+    Allocation*const pAllocation = &pContext->pAllocations[index];
+
+    GpuMemoryCreateInfo memInfo = {};
+    memInfo.size      = pContext->allocationSize;
+    memInfo.alignment = 4096;
+    memInfo.vaRange   = VaRange::Default;
+    memInfo.priority  = GpuMemPriority::Normal;
+    memInfo.heapCount = 1;
+    memInfo.heaps[0]  = GpuHeapGartUswc;
+
+    Result result = pContext->pDevice->CreateGpuMemory(memInfo, pAllocation->pPlacement, &pAllocation->pGpuMemory);
+
+    if (result == Result::Success)
+    {
+        pAllocation->gpuVa      = pAllocation->pGpuMemory->Desc().gpuVirtAddr;
+        pAllocation->globalRefs = 0;
+        pAllocation->submitRefs = 0;
+    }
+    else
+    {
+        pAllocation->pGpuMemory = nullptr;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void DestroyBenchContext(
+    BenchContext* pContext)
+{
+    if (pContext->pAllocations != nullptr)
+    {
+        for (uint32 i = 0; i < pContext->allocationCount; ++i)
+        {
+            if (pContext->pAllocations[i].pGpuMemory != nullptr)
+            {
+                pContext->pAllocations[i].pGpuMemory->Destroy();
+            }
+
+            free(pContext->pAllocations[i].pPlacement);
+        }
+    }
+
+    free(pContext->pAllocations);
+    free(pContext->pVaMap);
+
+    DestroyObject(&pContext->pCmdBuffer);
+    DestroyObject(&pContext->pCmdAllocator);
+    DestroyObject(&pContext->pQueue);
+
+    if (pContext->pPlatform != nullptr)
+    {
+        pContext->pPlatform->Destroy();
+    }
+
+    free(pContext->pPlatformMemory);
+
+    memset(pContext, 0, sizeof(*pContext));
+}
+
+// =====================================================================================================================
+// Brings up the stand-in device and creates the queue, the command buffer and allocationCount allocations.
+Result CreateBenchContext(
+    uint32        allocationCount,
+    BenchContext* pContext)
+{
+    memset(pContext, 0, sizeof(*pContext));
+
+    PlatformCreateInfo platformInfo = {};
+    platformInfo.pSettingsPath             = "/etc/amd";
+    platformInfo.flags.disableDevDriver    = 1;
+    platformInfo.flags.dontOpenPrimaryNode = 1;
+    platformInfo.clientApiId               = ClientApi::Pal;
+
+    pContext->pPlatformMemory = malloc(GetPlatformSize());
+
+    Result result = (pContext->pPlatformMemory != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+
+    if (result == Result::Success)
+    {
+        result = CreatePlatform(platformInfo, pContext->pPlatformMemory, &pContext->pPlatform);
+    }
+
+    IDevice* pDevices[MaxDevices] = {};
+    uint32   deviceCount          = 0;
+
+    if (result == Result::Success)
+    {
+        result = pContext->pPlatform->EnumerateDevices(&deviceCount, pDevices);
+
+        if ((result == Result::Success) && (deviceCount == 0))
+        {
+            result = Result::ErrorUnavailable;
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        pContext->pDevice = pDevices[0];
+
+        PalPublicSettings*const pSettings = pContext->pDevice->GetPublicSettings();
+
+        // Allocations which are always valid in the VM never enter the BO list.
+        pSettings->enableVmAlwaysValid              = VmAlwaysValidForceDisable;
+        pSettings->disableResourceProcessingManager = true;
+
+        result = pContext->pDevice->CommitSettingsAndInit();
+    }
+
+    DeviceProperties props = {};
+
+    if (result == Result::Success)
+    {
+        result = pContext->pDevice->GetProperties(&props);
+    }
+
+    if (result == Result::Success)
+    {
+        pContext->maxRefs = props.maxGpuMemoryRefsResident;
+
+        DeviceFinalizeInfo finalizeInfo = {};
+        finalizeInfo.requestedEngineCounts[EngineTypeUniversal].engines = 1;
+
+        result = pContext->pDevice->Finalize(finalizeInfo);
+    }
+
+    if (result == Result::Success)
+    {
+        QueueCreateInfo queueInfo = {};
+        queueInfo.queueType  = QueueTypeUniversal;
+        queueInfo.engineType = EngineTypeUniversal;
+
+        result = CreateObject(pContext->pDevice,
+                              &IDevice::GetQueueSize,
+                              &IDevice::CreateQueue,
+                              queueInfo,
+                              &pContext->pQueue);
+    }
+
+    if (result == Result::Success)
+    {
+        CmdAllocatorCreateInfo allocInfo = {};
+        allocInfo.flags.autoMemoryReuse          = 1;
+        allocInfo.flags.disableBusyChunkTracking = 1;
+
+        for (uint32 type = 0; type < CmdAllocatorTypeCount; ++type)
+        {
+            allocInfo.allocInfo[type].allocHeap    = (type == GpuScratchMemAlloc) ? GpuHeapInvisible : GpuHeapGartUswc;
+            allocInfo.allocInfo[type].allocSize    = 2 * 1024 * 1024;
+            allocInfo.allocInfo[type].suballocSize = 64 * 1024;
+        }
+
+        result = CreateObject(pContext->pDevice,
+                              &IDevice::GetCmdAllocatorSize,
+                              &IDevice::CreateCmdAllocator,
+                              allocInfo,
+                              &pContext->pCmdAllocator);
+    }
+
+    if (result == Result::Success)
+    {
+        CmdBufferCreateInfo cmdBufInfo = {};
+        cmdBufInfo.pCmdAllocator = pContext->pCmdAllocator;
+        cmdBufInfo.queueType     = QueueTypeUniversal;
+        cmdBufInfo.engineType    = EngineTypeUniversal;
+
+        result = CreateObject(pContext->pDevice,
+                              &IDevice::GetCmdBufferSize,
+                              &IDevice::CreateCmdBuffer,
+                              cmdBufInfo,
+                              &pContext->pCmdBuffer);
+    }
+
+    if (result == Result::Success)
+    {
+        // An empty command buffer: the submission cost outside of the BO list doesn't depend on its contents.
+        CmdBufferBuildInfo buildInfo = {};
+        result = pContext->pCmdBuffer->Begin(buildInfo);
+
+        if (result == Result::Success)
+        {
+            result = pContext->pCmdBuffer->End();
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        GpuMemoryCreateInfo memInfo = {};
+        memInfo.size      = 4096;
+        memInfo.alignment = 4096;
+        memInfo.vaRange   = VaRange::Default;
+        memInfo.priority  = GpuMemPriority::Normal;
+        memInfo.heapCount = 1;
+        memInfo.heaps[0]  = GpuHeapGartUswc;
+
+        const size_t placementSize = pContext->pDevice->GetGpuMemorySize(memInfo, &result);
+
+        pContext->allocationSize  = memInfo.size;
+        pContext->allocationCount = allocationCount;
+        pContext->pAllocations    = static_cast<Allocation*>(calloc(allocationCount, sizeof(Allocation)));
+        pContext->pVaMap          = static_cast<VaEntry*>(calloc(allocationCount, sizeof(VaEntry)));
+
+        if ((result == Result::Success) && ((pContext->pAllocations == nullptr) || (pContext->pVaMap == nullptr)))
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+
+        for (uint32 i = 0; (result == Result::Success) && (i < allocationCount); ++i)
+        {
+            pContext->pAllocations[i].pPlacement = malloc(placementSize);
+
+            result = (pContext->pAllocations[i].pPlacement != nullptr) ? CreateAllocation(pContext, i)
+                                                                       : Result::ErrorOutOfMemory;
+        }
+
+        if (result == Result::Success)
+        {
+            SortVaMap(pContext);
+        }
+    }
+
+    if (result != Result::Success)
+    {
+        fprintf(stderr, "Failed to set up the stand-in device (Result %d)\n", static_cast<int32>(result));
+        DestroyBenchContext(pContext);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result AddGlobalRefs(
+    BenchContext* pContext,
+    const uint32* pIndices,
+    uint32        count)
+{
+    GpuMemoryRef refs[256] = {};
+    Result       result    = Result::Success;
+
+    for (uint32 first = 0; (result == Result::Success) && (first < count); first += ArrayLen32(refs))
+    {
+        const uint32 batch = Min(count - first, ArrayLen32(refs));
+
+        for (uint32 i = 0; i < batch; ++i)
+        {
+            Allocation*const pAllocation = &pContext->pAllocations[pIndices[first + i]];
+
+            refs[i].pGpuMemory = pAllocation->pGpuMemory;
+            pAllocation->globalRefs++;
+        }
+
+        result = pContext->pDevice->AddGpuMemoryReferences(batch, refs, nullptr, 0);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result RemoveGlobalRefs(
+    BenchContext* pContext,
+    const uint32* pIndices,
+    uint32        count)
+{
+    IGpuMemory* gpuMemory[256] = {};
+    Result      result         = Result::Success;
+
+    for (uint32 first = 0; (result == Result::Success) && (first < count); first += ArrayLen32(gpuMemory))
+    {
+        const uint32 batch = Min(count - first, ArrayLen32(gpuMemory));
+
+        for (uint32 i = 0; i < batch; ++i)
+        {
+            Allocation*const pAllocation = &pContext->pAllocations[pIndices[first + i]];
+
+            gpuMemory[i] = pAllocation->pGpuMemory;
+            pAllocation->globalRefs--;
+        }
+
+        result = pContext->pDevice->RemoveGpuMemoryReferences(batch, gpuMemory, nullptr);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Submits the command buffer with the given per-submit references.
+Result Submit(
+    BenchContext*       pContext,
+    const GpuMemoryRef* pSubmitRefs,
+    uint32              submitRefCount)
+{
+    PerSubQueueSubmitInfo perSubQueueInfo = {};
+    perSubQueueInfo.cmdBufferCount = 1;
+    perSubQueueInfo.ppCmdBuffers   = &pContext->pCmdBuffer;
+
+    MultiSubmitInfo submitInfo = {};
+    submitInfo.pPerSubQueueInfo     = &perSubQueueInfo;
+    submitInfo.perSubQueueInfoCount = 1;
+    submitInfo.gpuMemRefCount       = submitRefCount;
+    submitInfo.pGpuMemoryRefs       = pSubmitRefs;
+
+    return pContext->pQueue->Submit(submitInfo);
+}
+
+// =====================================================================================================================
+void DestroyVerifier(
+    Verifier* pVerifier)
+{
+    free(pVerifier->pSeen);
+    free(pVerifier->pInternalVas);
+    free(pVerifier->pScratchVas);
+    memset(pVerifier, 0, sizeof(*pVerifier));
+}
+
+// =====================================================================================================================
+// Compares the BO list of the last submission with the references the bench holds.  Returns false on any mismatch.
+bool CheckLastSubmit(
+    const BenchContext& context,
+    Verifier*           pVerifier,
+    const char*         pStep)
+{
+    DrmShimSubmit submit = {};
+    pVerifier->pShim->pfnGetLastSubmit(&submit);
+
+    bool ok = true;
+
+    if (submit.submitCount != (pVerifier->lastSubmitCount + 1))
+    {
+        fprintf(stderr, "  %s: expected one submission, the kernel saw %llu\n", pStep,
+                static_cast<unsigned long long>(submit.submitCount - pVerifier->lastSubmitCount));
+        ok = false;
+    }
+
+    pVerifier->lastSubmitCount = submit.submitCount;
+
+    if (submit.unknownHandles != 0)
+    {
+        fprintf(stderr, "  %s: %u BO list entries name BOs which don't exist\n", pStep, submit.unknownHandles);
+        ok = false;
+    }
+
+    if (submit.boCount > pVerifier->scratchCapacity)
+    {
+        free(pVerifier->pScratchVas);
+        pVerifier->scratchCapacity = submit.boCount;
+        pVerifier->pScratchVas     = static_cast<gpusize*>(malloc(submit.boCount * sizeof(gpusize)));
+    }
+
+    memset(pVerifier->pSeen, 0, context.allocationCount * sizeof(uint32));
+
+    uint32 internalCount = 0;
+
+    for (uint32 i = 0; i < submit.boCount; ++i)
+    {
+        const uint32 index = FindAllocation(context, submit.pGpuVas[i]);
+
+        if (index != UINT32_MAX)
+        {
+            pVerifier->pSeen[index]++;
+        }
+        else
+        {
+            pVerifier->pScratchVas[internalCount++] = submit.pGpuVas[i];
+        }
+    }
+
+    uint32 mismatches = 0;
+
+    for (uint32 i = 0; i < context.allocationCount; ++i)
+    {
+        const Allocation& allocation = context.pAllocations[i];
+        const uint32      expected   = ((allocation.globalRefs > 0) ? 1 : 0) + allocation.submitRefs;
+
+        if (pVerifier->pSeen[i] != expected)
+        {
+            if (mismatches < 8)
+            {
+                fprintf(stderr, "  %s: allocation %u (VA 0x%llx, %u global refs, %u per-submit refs) is in the BO "
+                                "list %u times, expected %u\n",
+                        pStep, i, static_cast<unsigned long long>(allocation.gpuVa), allocation.globalRefs,
+                        allocation.submitRefs, pVerifier->pSeen[i], expected);
+            }
+
+            mismatches++;
+        }
+    }
+
+    if (mismatches > 0)
+    {
+        fprintf(stderr, "  %s: %u allocations mismatched\n", pStep, mismatches);
+        ok = false;
+    }
+
+    qsort(pVerifier->pScratchVas, internalCount, sizeof(gpusize), CompareVas);
+
+    if (pVerifier->haveInternal == false)
+    {
+        pVerifier->pInternalVas  = static_cast<gpusize*>(malloc(Max(internalCount, 1u) * sizeof(gpusize)));
+        pVerifier->internalCount = internalCount;
+        pVerifier->haveInternal  = true;
+
+        memcpy(pVerifier->pInternalVas, pVerifier->pScratchVas, internalCount * sizeof(gpusize));
+    }
+    else if ((internalCount != pVerifier->internalCount) ||
+             (memcmp(pVerifier->pInternalVas, pVerifier->pScratchVas, internalCount * sizeof(gpusize)) != 0))
+    {
+        fprintf(stderr, "  %s: PAL's internal allocations changed (%u entries, first submission had %u)\n",
+                pStep, internalCount, pVerifier->internalCount);
+        ok = false;
+    }
+
+    pVerifier->checkedSubmits++;
+
+    return ok;
+}
+
+// =====================================================================================================================
+// Submits with the per-submit references the bench currently holds and checks the BO list.
+bool SubmitAndCheck(
+    BenchContext* pContext,
+    Verifier*     pVerifier,
+    const char*   pStep)
+{
+    GpuMemoryRef submitRefs[64] = {};
+    uint32       submitRefCount = 0;
+
+    for (uint32 i = 0; i < pContext->allocationCount; ++i)
+    {
+        for (uint32 ref = 0; (ref < pContext->pAllocations[i].submitRefs) && (submitRefCount < 64); ++ref)
+        {
+            submitRefs[submitRefCount++].pGpuMemory = pContext->pAllocations[i].pGpuMemory;
+        }
+    }
+
+    const Result result = Submit(pContext, submitRefs, submitRefCount);
+
+    bool ok = (result == Result::Success);
+
+    if (ok)
+    {
+        ok = CheckLastSubmit(*pContext, pVerifier, pStep);
+    }
+    else
+    {
+        fprintf(stderr, "  %s: Submit() failed (Result %d)\n", pStep, static_cast<int32>(result));
+    }
+
+    return ok;
+}
+
+// =====================================================================================================================
+// Randomly churns the references on a small pool of allocations and checks the BO list of every submission.
+bool VerifyRandomChurn(
+    BenchContext* pContext,
+    Verifier*     pVerifier)
+{
+    // The allocations past the pool are kept for the overflow check, referencing them here could overflow the list.
+    const uint32 poolSize = Min(VerifyPoolSize, pContext->allocationCount);
+
+    uint32 seed   = 0x2545F491;
+    bool   ok     = true;
+    Result result = Result::Success;
+
+    for (uint32 submit = 0; ok && (result == Result::Success) && (submit < VerifySubmits); ++submit)
+    {
+        const uint32 action = NextRandom(&seed) % 16;
+        uint32       indices[64];
+        uint32       count  = 0;
+
+        // Per-submit references from the previous submission are dropped.
+        for (uint32 i = 0; i < pContext->allocationCount; ++i)
+        {
+            pContext->pAllocations[i].submitRefs = 0;
+        }
+
+        if (action < 6)
+        {
+            // A few new references, which may hit allocations that are already referenced.
+            count = 1 + NextRandom(&seed) % 8;
+
+            for (uint32 i = 0; i < count; ++i)
+            {
+                indices[i] = NextRandom(&seed) % poolSize;
+            }
+
+            result = AddGlobalRefs(pContext, indices, count);
+        }
+        else if (action < 11)
+        {
+            // Drop a few references.
+            for (uint32 tries = 0; (tries < 64) && (count < 8); ++tries)
+            {
+                const uint32 index = NextRandom(&seed) % poolSize;
+
+                if (pContext->pAllocations[index].globalRefs > 0)
+                {
+                    indices[count++] = index;
+                    result = RemoveGlobalRefs(pContext, &index, 1);
+                }
+            }
+        }
+        else if (action < 12)
+        {
+            // Add and remove the same allocations before submitting, in both orders.
+            count = 1 + NextRandom(&seed) % 8;
+
+            for (uint32 i = 0; i < count; ++i)
+            {
+                indices[i] = NextRandom(&seed) % poolSize;
+            }
+
+            if (NextRandom(&seed) & 1)
+            {
+                result = AddGlobalRefs(pContext, indices, count);
+
+                if (result == Result::Success)
+                {
+                    result = RemoveGlobalRefs(pContext, indices, count);
+                }
+            }
+            else
+            {
+                uint32 removable = 0;
+
+                for (uint32 i = 0; i < count; ++i)
+                {
+                    if (pContext->pAllocations[indices[i]].globalRefs > 0)
+                    {
+                        indices[removable++] = indices[i];
+                    }
+                }
+
+                result = RemoveGlobalRefs(pContext, indices, removable);
+
+                if (result == Result::Success)
+                {
+                    result = AddGlobalRefs(pContext, indices, removable);
+                }
+            }
+        }
+        else if (action < 13)
+        {
+            // Destroy an allocation while it may still be referenced and create its replacement at the same address.
+            // Sometimes the replacement is referenced straight away and sometimes the old one had a reference added
+            // just before it was destroyed.
+            const uint32     index       = NextRandom(&seed) % poolSize;
+            Allocation*const pAllocation = &pContext->pAllocations[index];
+
+            if (NextRandom(&seed) & 1)
+            {
+                result = AddGlobalRefs(pContext, &index, 1);
+            }
+
+            if (result == Result::Success)
+            {
+                pAllocation->pGpuMemory->Destroy();
+                pAllocation->pGpuMemory = nullptr;
+
+                result = CreateAllocation(pContext, index);
+            }
+
+            if (result == Result::Success)
+            {
+                SortVaMap(pContext);
+
+                if (NextRandom(&seed) & 1)
+                {
+                    result = AddGlobalRefs(pContext, &index, 1);
+                }
+            }
+        }
+        else if (action < 14)
+        {
+            // A large batch in either direction.
+            const bool add = (NextRandom(&seed) & 1);
+
+            for (uint32 i = 0; (result == Result::Success) && (i < poolSize); ++i)
+            {
+                if ((NextRandom(&seed) % 4) == 0)
+                {
+                    if (add)
+                    {
+                        result = AddGlobalRefs(pContext, &i, 1);
+                    }
+                    else if (pContext->pAllocations[i].globalRefs > 0)
+                    {
+                        result = RemoveGlobalRefs(pContext, &i, 1);
+                    }
+                }
+            }
+        }
+
+        // Per-submit references, which may duplicate global ones.
+        if ((result == Result::Success) && ((NextRandom(&seed) % 4) == 0))
+        {
+            const uint32 submitRefs = 1 + NextRandom(&seed) % 16;
+
+            for (uint32 i = 0; i < submitRefs; ++i)
+            {
+                pContext->pAllocations[NextRandom(&seed) % poolSize].submitRefs++;
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            ok = SubmitAndCheck(pContext, pVerifier, "random churn");
+        }
+    }
+
+    if (result != Result::Success)
+    {
+        fprintf(stderr, "  random churn: updating references failed (Result %d)\n", static_cast<int32>(result));
+        ok = false;
+    }
+
+    // Drop everything again so the next check starts clean.
+    for (uint32 i = 0; ok && (i < poolSize); ++i)
+    {
+        pContext->pAllocations[i].submitRefs = 0;
+
+        while (ok && (pContext->pAllocations[i].globalRefs > 0))
+        {
+            ok = (RemoveGlobalRefs(pContext, &i, 1) == Result::Success);
+        }
+    }
+
+    return ok && SubmitAndCheck(pContext, pVerifier, "after random churn");
+}
+
+// =====================================================================================================================
+// References more allocations than a submission can take, which must fail, then drops back below the limit; the next
+// submission must carry the right list again.
+bool VerifyOverflow(
+    BenchContext* pContext,
+    Verifier*     pVerifier)
+{
+    const uint32 first = VerifyPoolSize;
+    const uint32 count = pContext->allocationCount - first;
+    uint32*      pIdx  = static_cast<uint32*>(malloc(count * sizeof(uint32)));
+    bool         ok    = (pIdx != nullptr);
+
+    for (uint32 i = 0; ok && (i < count); ++i)
+    {
+        pIdx[i] = first + i;
+    }
+
+    // Some references which stay throughout, so that the list isn't simply rebuilt from empty.
+    uint32 steady[32];
+
+    for (uint32 i = 0; i < ArrayLen32(steady); ++i)
+    {
+        steady[i] = i * 7;
+    }
+
+    ok = ok && (AddGlobalRefs(pContext, steady, ArrayLen32(steady)) == Result::Success);
+    ok = ok && SubmitAndCheck(pContext, pVerifier, "before overflow");
+    ok = ok && (AddGlobalRefs(pContext, pIdx, count) == Result::Success);
+
+    if (ok)
+    {
+        const Result result = Submit(pContext, nullptr, 0);
+
+        // The stand-in saw nothing, so don't expect a submission on the next check.
+        if (result != Result::ErrorTooManyMemoryReferences)
+        {
+            fprintf(stderr, "  overflow: Submit() with %u global references returned %d, expected "
+                            "ErrorTooManyMemoryReferences\n",
+                    count + ArrayLen32(steady), static_cast<int32>(result));
+            ok = false;
+        }
+    }
+
+    // Back below the limit, minus a few of the steady references and plus a new one.
+    ok = ok && (RemoveGlobalRefs(pContext, pIdx, count - 8) == Result::Success);
+    ok = ok && (RemoveGlobalRefs(pContext, steady, 4) == Result::Success);
+    ok = ok && (AddGlobalRefs(pContext, &pIdx[0], 1) == Result::Success);
+    ok = ok && SubmitAndCheck(pContext, pVerifier, "after overflow");
+
+    // And the journal must be back in use afterwards.
+    ok = ok && (RemoveGlobalRefs(pContext, &steady[4], 4) == Result::Success);
+    ok = ok && (AddGlobalRefs(pContext, &pIdx[count - 1], 1) == Result::Success);
+    ok = ok && SubmitAndCheck(pContext, pVerifier, "after overflow, churn");
+
+    for (uint32 i = 0; ok && (i < pContext->allocationCount); ++i)
+    {
+        while (ok && (pContext->pAllocations[i].globalRefs > 0))
+        {
+            ok = (RemoveGlobalRefs(pContext, &i, 1) == Result::Success);
+        }
+    }
+
+    ok = ok && SubmitAndCheck(pContext, pVerifier, "after overflow, cleared");
+
+    free(pIdx);
+
+    return ok;
+}
+
+// =====================================================================================================================
+// Runs the validation on one submission path.  Returns false on any mismatch.
+bool RunVerify(
+    const DrmShim& shim,
+    SubmitPath     path)
+{
+    ConfigureDrmShim(shim, path, true);
+
+    BenchContext context = {};
+    Result       result  = Result::ErrorUnavailable;
+
+    // The overflow check needs enough allocations to exceed the reference limit on its own.
+    result = CreateBenchContext(VerifyPoolSize, &context);
+
+    const uint32 maxRefs = context.maxRefs;
+
+    if (result == Result::Success)
+    {
+        DestroyBenchContext(&context);
+        result = CreateBenchContext(VerifyPoolSize + maxRefs + 64, &context);
+    }
+
+    bool ok = (result == Result::Success);
+
+    if (ok)
+    {
+        Verifier verifier = {};
+        verifier.pShim = &shim;
+        verifier.pSeen = static_cast<uint32*>(calloc(context.allocationCount, sizeof(uint32)));
+
+        DrmShimSubmit submit = {};
+        shim.pfnGetLastSubmit(&submit);
+        verifier.lastSubmitCount = submit.submitCount;
+
+        ok = (verifier.pSeen != nullptr)                      &&
+             SubmitAndCheck(&context, &verifier, "first submission") &&
+             VerifyRandomChurn(&context, &verifier)           &&
+             VerifyOverflow(&context, &verifier);
+
+        printf("verify %-8s %s: %u BO lists checked, %u internal allocations\n",
+               SubmitPathNames[static_cast<uint32>(path)], ok ? "passed" : "FAILED",
+               verifier.checkedSubmits, verifier.internalCount);
+
+        DestroyVerifier(&verifier);
+        DestroyBenchContext(&context);
+    }
+
+    return ok;
+}
+
+// =====================================================================================================================
+int CompareDoubles(
+    const void* pLhs,
+    const void* pRhs)
+{
+    const double lhs = *static_cast<const double*>(pLhs);
+    const double rhs = *static_cast<const double*>(pRhs);
+
+    return (lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0);
+}
+
+// =====================================================================================================================
+// Times one configuration.  The allocations in [window, window + resident) of a ring of resident + churn + submitRefs
+// allocations hold global references; each submission slides the window by churn and passes the submitRefs allocations
+// past its end as per-submit references.
+bool BenchConfig(
+    BenchContext*  pContext,
+    const Options& options,
+    SubmitPath     path,
+    uint32         resident,
+    uint32         churn,
+    uint32         submitRefCount)
+{
+    const uint32  ringSize    = resident + churn + submitRefCount;
+    const double  nsPerTick   = 1.0e9 / static_cast<double>(GetPerfFrequency());
+    uint32*       pIndices    = static_cast<uint32*>(malloc(Max(resident, churn) * sizeof(uint32)));
+    GpuMemoryRef* pSubmitRefs = static_cast<GpuMemoryRef*>(calloc(Max(submitRefCount, 1u), sizeof(GpuMemoryRef)));
+    double        refNs[MaxRepeats]    = {};
+    double        submitNs[MaxRepeats] = {};
+    uint32        window      = 0;
+    Result        result      = ((pIndices != nullptr) && (pSubmitRefs != nullptr)) ? Result::Success
+                                                                                     : Result::ErrorOutOfMemory;
+
+    for (uint32 i = 0; i < resident; ++i)
+    {
+        pIndices[i] = i;
+    }
+
+    if (result == Result::Success)
+    {
+        result = AddGlobalRefs(pContext, pIndices, resident);
+    }
+
+    const uint32 totalSubmits = WarmupSubmits + options.repeats * options.submits;
+
+    for (uint32 submit = 0; (result == Result::Success) && (submit < totalSubmits); ++submit)
+    {
+        const int64 start = GetPerfCpuTime();
+
+        for (uint32 i = 0; i < churn; ++i)
+        {
+            pIndices[i] = (window + i) % ringSize;
+        }
+
+        result = RemoveGlobalRefs(pContext, pIndices, churn);
+
+        for (uint32 i = 0; i < churn; ++i)
+        {
+            pIndices[i] = (window + resident + i) % ringSize;
+        }
+
+        if (result == Result::Success)
+        {
+            result = AddGlobalRefs(pContext, pIndices, churn);
+        }
+
+        window = (window + churn) % ringSize;
+
+        for (uint32 i = 0; i < submitRefCount; ++i)
+        {
+            pSubmitRefs[i].pGpuMemory = pContext->pAllocations[(window + resident + i) % ringSize].pGpuMemory;
+        }
+
+        const int64 submitStart = GetPerfCpuTime();
+
+        if (result == Result::Success)
+        {
+            result = Submit(pContext, pSubmitRefs, submitRefCount);
+        }
+
+        const int64 end = GetPerfCpuTime();
+
+        if (submit >= WarmupSubmits)
+        {
+            const uint32 repeat = (submit - WarmupSubmits) / options.submits;
+
+            refNs[repeat]    += static_cast<double>(submitStart - start) * nsPerTick / options.submits;
+            submitNs[repeat] += static_cast<double>(end - submitStart) * nsPerTick / options.submits;
+        }
+    }
+
+    // Leave no references behind for the next configuration.
+    for (uint32 i = 0; (result == Result::Success) && (i < resident); ++i)
+    {
+        pIndices[i] = (window + i) % ringSize;
+    }
+
+    if (result == Result::Success)
+    {
+        result = RemoveGlobalRefs(pContext, pIndices, resident);
+    }
+
+    if (result == Result::Success)
+    {
+        qsort(refNs, options.repeats, sizeof(double), CompareDoubles);
+        qsort(submitNs, options.repeats, sizeof(double), CompareDoubles);
+
+        printf("  %-8s %9u %6u %12u %14.0f %12.0f %12.0f\n",
+               SubmitPathNames[static_cast<uint32>(path)], resident, churn, submitRefCount,
+               refNs[options.repeats / 2], submitNs[options.repeats / 2], submitNs[0]);
+    }
+    else
+    {
+        fprintf(stderr, "  %-8s %9u %6u %12u failed (Result %d)\n",
+                SubmitPathNames[static_cast<uint32>(path)], resident, churn, submitRefCount,
+                static_cast<int32>(result));
+    }
+
+    free(pIndices);
+    free(pSubmitRefs);
+
+    return (result == Result::Success);
+}
+
+// =====================================================================================================================
+// Runs the benchmark sweep on one submission path.
+bool RunBench(
+    const DrmShim& shim,
+    const Options& options,
+    SubmitPath     path)
+{
+    ConfigureDrmShim(shim, path, false);
+
+    const uint32* pResident      = (options.resident   == Sweep) ? ResidentSweep   : &options.resident;
+    const uint32* pChurn         = (options.churn      == Sweep) ? ChurnSweep      : &options.churn;
+    const uint32* pSubmitRefs    = (options.submitRefs == Sweep) ? SubmitRefsSweep : &options.submitRefs;
+    const uint32  residentCount  = (options.resident   == Sweep) ? ArrayLen32(ResidentSweep)   : 1;
+    const uint32  churnCount     = (options.churn      == Sweep) ? ArrayLen32(ChurnSweep)      : 1;
+    const uint32  submitRefCount = (options.submitRefs == Sweep) ? ArrayLen32(SubmitRefsSweep) : 1;
+
+    uint32 allocationCount = 0;
+
+    for (uint32 r = 0; r < residentCount; ++r)
+    {
+        for (uint32 c = 0; c < churnCount; ++c)
+        {
+            for (uint32 s = 0; s < submitRefCount; ++s)
+            {
+                allocationCount = Max(allocationCount, pResident[r] + pChurn[c] + pSubmitRefs[s]);
+            }
+        }
+    }
+
+    BenchContext context = {};
+    bool         ok      = (CreateBenchContext(allocationCount, &context) == Result::Success);
+
+    for (uint32 r = 0; ok && (r < residentCount); ++r)
+    {
+        for (uint32 c = 0; ok && (c < churnCount); ++c)
+        {
+            for (uint32 s = 0; ok && (s < submitRefCount); ++s)
+            {
+                ok = BenchConfig(&context, options, path, pResident[r], pChurn[c], pSubmitRefs[s]);
+            }
+        }
+    }
+
+    if (context.pDevice != nullptr)
+    {
+        DestroyBenchContext(&context);
+    }
+
+    return ok;
+}
+
+// =====================================================================================================================
+// Parses the command line.  Returns false on a malformed command line.
+bool ParseOptions(
+    int      argc,
+    char**   argv,
+    Options* pOptions)
+{
+    bool valid = true;
+
+    memset(pOptions, 0, sizeof(*pOptions));
+
+    for (uint32 path = 0; path < static_cast<uint32>(SubmitPath::Count); ++path)
+    {
+        pOptions->paths[path] = true;
+    }
+
+    pOptions->verify     = true;
+    pOptions->bench      = true;
+    pOptions->resident   = Sweep;
+    pOptions->churn      = Sweep;
+    pOptions->submitRefs = Sweep;
+    pOptions->submits    = DefaultSubmits;
+    pOptions->repeats    = DefaultRepeats;
+
+    for (int i = 1; valid && (i < argc); ++i)
+    {
+        const char* pArg   = argv[i];
+        const char* pValue = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        // Every option takes a value.
+        if (pValue == nullptr)
+        {
+            valid = false;
+        }
+        else if (strcmp(pArg, "--path") == 0)
+        {
+            bool any = false;
+
+            for (uint32 path = 0; path < static_cast<uint32>(SubmitPath::Count); ++path)
+            {
+                pOptions->paths[path] = (strcmp(pValue, SubmitPathNames[path]) == 0) || (strcmp(pValue, "all") == 0);
+                any                  |= pOptions->paths[path];
+            }
+
+            valid = any;
+        }
+        else if (strcmp(pArg, "--mode") == 0)
+        {
+            pOptions->verify = (strcmp(pValue, "verify") == 0) || (strcmp(pValue, "all") == 0);
+            pOptions->bench  = (strcmp(pValue, "bench") == 0)  || (strcmp(pValue, "all") == 0);
+            valid            = pOptions->verify || pOptions->bench;
+        }
+        else if (strcmp(pArg, "--resident") == 0)
+        {
+            pOptions->resident = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid              = (pOptions->resident <= 16000);
+        }
+        else if (strcmp(pArg, "--churn") == 0)
+        {
+            pOptions->churn = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid           = (pOptions->churn <= 4096);
+        }
+        else if (strcmp(pArg, "--submit-refs") == 0)
+        {
+            pOptions->submitRefs = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid                = (pOptions->submitRefs <= 256);
+        }
+        else if (strcmp(pArg, "--submits") == 0)
+        {
+            pOptions->submits = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid             = (pOptions->submits > 0);
+        }
+        else if (strcmp(pArg, "--repeats") == 0)
+        {
+            pOptions->repeats = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid             = (pOptions->repeats > 0) && (pOptions->repeats <= MaxRepeats);
+        }
+        else
+        {
+            valid = false;
+        }
+
+        ++i;
+    }
+
+    if (valid == false)
+    {
+        fprintf(stderr,
+                "Usage: %s [--path <chunk|bo-list|legacy|all>] [--mode <verify|bench|all>] [--resident <count>]\n"
+                "          [--churn <count>] [--submit-refs <count>] [--submits <count>] [--repeats <count>]\n",
+                argv[0]);
+    }
+
+    return valid;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int    argc,
+    char** argv)
+{
+    Options options = {};
+    DrmShim shim    = {};
+    bool    success = ParseOptions(argc, argv, &options) && LoadDrmShim(&shim);
+
+    for (uint32 path = 0; success && options.verify && (path < static_cast<uint32>(SubmitPath::Count)); ++path)
+    {
+        if (options.paths[path])
+        {
+            success = RunVerify(shim, static_cast<SubmitPath>(path));
+        }
+    }
+
+    if (success && options.bench)
+    {
+        printf("\n  %-8s %9s %6s %12s %14s %12s %12s\n",
+               "path", "resident", "churn", "submit refs", "ref ns/submit", "submit ns", "submit min");
+
+        for (uint32 path = 0; success && (path < static_cast<uint32>(SubmitPath::Count)); ++path)
+        {
+            if (options.paths[path])
+            {
+                success = RunBench(shim, options, static_cast<SubmitPath>(path));
+            }
+        }
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
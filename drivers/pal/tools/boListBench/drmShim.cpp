@@ -0,0 +1,177 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  drmShim.cpp
+ * @brief Stand-in libdrm.so.2 for palBoListBench: a single Navi21 behind "/dev/null".
+ ***********************************************************************************************************************
+ */
+
+#include "drmShim.h"
+
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+
+DrmShimConfig g_config = { 42, true, false };
+
+char             g_primaryNode[]       = "/dev/dri/card0";
+char             g_renderNode[]        = "/dev/null";
+char*            g_nodes[DRM_NODE_MAX] = { g_primaryNode, nullptr, g_renderNode };
+drmPciBusInfo    g_busInfo             = { 0, 3, 0, 0 };
+drmPciDeviceInfo g_deviceInfo          = { 0x1002, 0x73BF, 0x1002, 0x0E3A, 0xC1 };
+drmDevice        g_device              =
+{
+    g_nodes, (1 << DRM_NODE_PRIMARY) | (1 << DRM_NODE_RENDER), DRM_BUS_PCI, { &g_busInfo }, { &g_deviceInfo }
+};
+
+} // anonymous namespace
+
+extern "C"
+{
+
+// =====================================================================================================================
+void DrmShimSetConfig(
+    const DrmShimConfig* pConfig)
+{
+    g_config = *pConfig;
+}
+
+// =====================================================================================================================
+// Reports the one device, whose render node is "/dev/null" so that PAL's open() succeeds.  The primary node is never
+// opened (the benchmark sets dontOpenPrimaryNode) but PAL parses the card index from its name.
+int drmGetDevices(
+    drmDevicePtr devices[],
+    int          max_devices)
+{
+    if ((devices != nullptr) && (max_devices > 0))
+    {
+        devices[0] = &g_device;
+    }
+
+    return 1;
+}
+
+// =====================================================================================================================
+void drmFreeDevices(
+    drmDevicePtr devices[],
+    int          count)
+{
+    // drmGetDevices() hands out static storage.
+}
+
+// =====================================================================================================================
+drmVersionPtr drmGetVersion(
+    int fd)
+{
+    static char Name[] = "amdgpu";
+    static char Date[] = "20150101";
+    static char Desc[] = "palBoListBench stand-in";
+
+    drmVersionPtr pVersion = static_cast<drmVersionPtr>(calloc(1, sizeof(drmVersion)));
+
+    if (pVersion != nullptr)
+    {
+        pVersion->version_major = 3;
+        pVersion->version_minor = static_cast<int>(g_config.drmMinorVersion);
+        pVersion->name_len      = static_cast<int>(strlen(Name));
+        pVersion->name          = Name;
+        pVersion->date_len      = static_cast<int>(strlen(Date));
+        pVersion->date          = Date;
+        pVersion->desc_len      = static_cast<int>(strlen(Desc));
+        pVersion->desc          = Desc;
+    }
+
+    return pVersion;
+}
+
+// =====================================================================================================================
+void drmFreeVersion(
+    drmVersionPtr pVersion)
+{
+    free(pVersion);
+}
+
+// =====================================================================================================================
+int drmGetCap(
+    int       fd,
+    uint64_t  capability,
+    uint64_t* value)
+{
+    int ret = 0;
+
+    if (capability == DRM_CAP_SYNCOBJ)
+    {
+        *value = g_config.syncobjSupport ? 1 : 0;
+    }
+    else
+    {
+        *value = 0;
+        ret    = -EINVAL;
+    }
+
+    return ret;
+}
+
+// =====================================================================================================================
+int drmSetClientCap(
+    int      fd,
+    uint64_t capability,
+    uint64_t value)
+{
+    return -EINVAL;
+}
+
+// =====================================================================================================================
+// There are no displays.
+drmModeResPtr drmModeGetResources(
+    int fd)
+{
+    return nullptr;
+}
+
+// =====================================================================================================================
+void drmModeFreeResources(
+    drmModeResPtr ptr)
+{
+}
+
+// =====================================================================================================================
+int drmIoctl(
+    int           fd,
+    unsigned long request,
+    void*         arg)
+{
+    errno = EINVAL;
+    return -1;
+}
+
+} // extern "C"
@@ -0,0 +1,69 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  drmShim.h
+ * @brief Control interface of the stand-in libdrm.so.2 and libdrm_amdgpu.so.1 which palBoListBench runs PAL against.
+ *
+ * The stand-in libraries implement just enough of libdrm and libdrm_amdgpu for PAL to bring up a Navi21 device and
+ * submit to it without a GPU or a kernel driver.  Nothing is executed; submissions complete as soon as they are made.
+ * Both libraries export DrmShimSetConfig() and must be configured identically before PAL enumerates devices.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Behaviour of the stand-in DRM device.
+struct DrmShimConfig
+{
+    uint32_t drmMinorVersion;  // amdgpu DRM minor version to report.  Below 27, PAL creates a BO list per submit.
+    bool     syncobjSupport;   // Report DRM_CAP_SYNCOBJ.  Without it PAL falls back to amdgpu_cs_submit().
+    bool     recordSubmits;    // Record the GPU VAs of the BOs referenced by every submission.
+};
+
+// The BO list of the most recent submission, as recorded by the stand-in libdrm_amdgpu.so.1.
+struct DrmShimSubmit
+{
+    uint64_t        submitCount;     // Number of submissions so far.
+    uint32_t        boCount;         // Number of entries in the BO list.
+    uint32_t        unknownHandles;  // Entries naming a BO which doesn't exist (never allocated or already freed).
+    const uint64_t* pGpuVas;         // GPU VA each entry's BO is mapped at, in list order; zero if it isn't mapped.
+};
+
+extern "C"
+{
+
+// Exported by both stand-in libraries.
+void DrmShimSetConfig(const DrmShimConfig* pConfig);
+
+// Exported by the stand-in libdrm_amdgpu.so.1 only.  The returned data stays valid until the next submission.
+void DrmShimGetLastSubmit(DrmShimSubmit* pSubmit);
+
+}
+
+typedef void (*DrmShimSetConfigFunc)(const DrmShimConfig* pConfig);
+typedef void (*DrmShimGetLastSubmitFunc)(DrmShimSubmit* pSubmit);
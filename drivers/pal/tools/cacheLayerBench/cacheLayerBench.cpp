@@ -0,0 +1,739 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+/**
+ ***********************************************************************************************************************
+ * @file  cacheLayerBench.cpp
+ * @brief CPU-only benchmark of PAL's pipeline cache layers.
+ *
+ * Each configuration builds a fresh layer chain, stores "entries" synthetic pipeline binaries into it from "threads"
+ * threads at once, then loads every entry back from the same number of threads and checks its contents.  The best of
+ * "repeats" runs is reported as ns per store and ns per load (aggregate wall-clock time over all threads), along with
+ * how much memory the entries occupy in the memory layer afterwards.
+ *
+ * The configurations are a memory cache layer on its own and a compressing cache layer in front of one, compressing
+ * on the storing thread and on its background thread (asyncCompression).  For the latter the time until the last
+ * entry has been swapped for its compressed copy is also reported; loads run while that is still in progress, so they
+ * also check that an entry never goes missing while it is being replaced.
+ *
+ * A second table measures lock contention in the memory cache layer.  The layer only has room for half of the entries,
+ * so after it has been filled every thread runs a random mix of loads ("load-percent" of the operations) and stores
+ * over all entries, and stores keep evicting entries.  This is run with a single shard, where every store and eviction
+ * serializes on one lock, and with the default number of shards.  The time per operation and the load hit rate are
+ * reported.
+ *
+ * Usage: palCacheLayerBench [--threads <count>] [--entries <count>] [--size <bytes>] [--repeats <count>]
+ *                           [--load-percent <percent>]
+ ***********************************************************************************************************************
+ */
+
+#include "palCacheLayer.h"
+#include "palMetroHash.h"
+#include "palSysMemory.h"
+#include "palSysUtil.h"
+#include "palThread.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Util;
+
+namespace
+{
+
+constexpr uint32 DefaultThreads = 4;
+constexpr uint32 DefaultEntries = 4096;
+constexpr uint32 DefaultSize    = 16 * 1024;
+constexpr uint32 DefaultRepeats = 4;
+constexpr uint32 DefaultLoads   = 90;
+constexpr uint32 MaxThreads     = 64;
+
+// How long the background thread may go without compressing anything before we stop waiting for it.
+constexpr uint32 SettleTimeoutMs = 1000;
+
+// Command line options.
+struct Options
+{
+    uint32 threads;
+    uint32 entries;
+    uint32 size;
+    uint32 repeats;
+    uint32 loadPercent;
+};
+
+// The layer chain under test.
+enum class Config : uint32
+{
+    Memory,           // Memory cache layer only
+    CompressSync,     // Compressing cache layer compressing on the storing thread, then a memory cache layer
+    CompressAsync,    // Compressing cache layer compressing on its background thread, then a memory cache layer
+    Count
+};
+
+constexpr const char* ConfigNames[] =
+{
+    "memory",
+    "compressing (sync) -> memory",
+    "compressing (async) -> memory",
+};
+
+static_assert(sizeof(ConfigNames) / sizeof(ConfigNames[0]) == uint32(Config::Count), "Missing config name");
+
+// A layer chain: pTop is where stores and loads go, pMemory is the memory cache layer at the bottom.
+struct LayerChain
+{
+    ICacheLayer* pTop;
+    ICacheLayer* pMemory;
+    ICacheLayer* pCompressing;
+    void*        pMemoryPlacement;
+    void*        pCompressingPlacement;
+};
+
+// The synthetic pipeline binaries: entry i is pData[i * size] and has id pIds[i].
+struct EntrySet
+{
+    uint8*   pData;
+    Hash128* pIds;
+    uint32   count;
+    uint32   size;
+};
+
+// Which phase a worker thread runs.
+enum class Phase : uint32
+{
+    Store,
+    Load,
+    Mixed,  // Loads and stores of random entries, which may have been evicted.
+};
+
+// Shard counts the contention table is run with.  0 selects the memory layer's default.
+constexpr uint32 ContentionShards[] = { 1, 0 };
+
+// State for one thread of a store or load phase.
+struct WorkerThread
+{
+    Thread                   thread;
+    ICacheLayer*             pLayer;
+    const EntrySet*          pEntries;
+    Phase                    phase;
+    uint32                   first;        // This thread handles entries first, first + stride, ...
+    uint32                   stride;
+    uint32                   loadPercent;  // Share of loads in the Mixed phase.
+    const std::atomic<bool>* pStart;       // Spun on so that all threads start together.
+    int64                    startTime;
+    int64                    endTime;
+    uint32                   loads;        // Loads attempted in the Mixed phase.
+    uint32                   hits;         // Loads in the Mixed phase which found their entry.
+    uint32                   failures;     // Stores that failed, or loads that failed or returned the wrong data.
+};
+
+// =====================================================================================================================
+// Fills the entries with data that compresses about as well as shader code: runs of a few repeated dwords mixed with
+// pseudo-random ones.  Every entry is different.
+bool CreateEntries(
+    const Options& options,
+    EntrySet*      pEntries)
+{
+    pEntries->count = options.entries;
+    pEntries->size  = options.size;
+    pEntries->pData = static_cast<uint8*>(malloc(size_t(options.entries) * options.size));
+    pEntries->pIds  = static_cast<Hash128*>(malloc(sizeof(Hash128) * options.entries));
+
+    uint64 state = 0x9E3779B97F4A7C15ull;
+
+    for (uint32 i = 0; (pEntries->pData != nullptr) && (pEntries->pIds != nullptr) && (i < options.entries); ++i)
+    {
+        uint8*const pEntry = pEntries->pData + (size_t(i) * options.size);
+
+        for (uint32 offset = 0; offset < options.size; offset += sizeof(uint32))
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+
+            const uint32 word  = ((state & 0x3) == 0) ? uint32(state >> 32) : (0xBF8C0000u | ((offset >> 4) & 0xFF));
+            const uint32 bytes = Min(uint32(sizeof(word)), options.size - offset);
+
+            memcpy(pEntry + offset, &word, bytes);
+        }
+
+        memcpy(pEntry, &i, Min(uint32(sizeof(i)), options.size));
+        MetroHash128::Hash(pEntry, options.size, pEntries->pIds[i].bytes);
+    }
+
+    return (pEntries->pData != nullptr) && (pEntries->pIds != nullptr);
+}
+
+// =====================================================================================================================
+// Creates the layer chain for a configuration, with a memory layer that has room for "capacity" entries.
+Result CreateChain(
+    Config          config,
+    const EntrySet& entries,
+    uint32          capacity,
+    uint32          numShards,
+    LayerChain*     pChain)
+{
+    memset(pChain, 0, sizeof(*pChain));
+
+    MemoryCacheCreateInfo memoryInfo = {};
+    memoryInfo.maxObjectCount  = capacity;
+    memoryInfo.maxMemorySize   = size_t(capacity) * entries.size;
+    memoryInfo.expectedEntries = capacity;
+    memoryInfo.numShards       = numShards;
+    memoryInfo.evictOnFull     = true;
+    memoryInfo.evictDuplicates = false;
+
+    Result result = Result::ErrorOutOfMemory;
+
+    pChain->pMemoryPlacement = malloc(GetMemoryCacheLayerSize(&memoryInfo));
+
+    if (pChain->pMemoryPlacement != nullptr)
+    {
+        result = CreateMemoryCacheLayer(&memoryInfo, pChain->pMemoryPlacement, &pChain->pMemory);
+    }
+
+    pChain->pTop = pChain->pMemory;
+
+    if ((result == Result::Success) && (config != Config::Memory))
+    {
+        CompressingCacheLayerCreateInfo compressingInfo = {};
+        compressingInfo.asyncCompression = (config == Config::CompressAsync);
+
+        result = Result::ErrorOutOfMemory;
+
+        pChain->pCompressingPlacement = malloc(GetCompressingCacheLayerSize());
+
+        if (pChain->pCompressingPlacement != nullptr)
+        {
+            result = CreateCompressingCacheLayer(&compressingInfo,
+                                                 pChain->pCompressingPlacement,
+                                                 &pChain->pCompressing);
+        }
+
+        if (result == Result::Success)
+        {
+            result       = pChain->pCompressing->Link(pChain->pMemory);
+            pChain->pTop = pChain->pCompressing;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Destroys a layer chain created by CreateChain().  The compressing layer goes first so its background thread is gone
+// before the layer it stores to.
+void DestroyChain(
+    LayerChain* pChain)
+{
+    if (pChain->pCompressing != nullptr)
+    {
+        pChain->pCompressing->Destroy();
+    }
+
+    if (pChain->pMemory != nullptr)
+    {
+        pChain->pMemory->Destroy();
+    }
+
+    free(pChain->pCompressingPlacement);
+    free(pChain->pMemoryPlacement);
+    memset(pChain, 0, sizeof(*pChain));
+}
+
+// =====================================================================================================================
+// xorshift64 step, used to pick entries and operations in the Mixed phase.
+uint64 NextRandom(
+    uint64* pState)
+{
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 7;
+    *pState ^= *pState << 17;
+
+    return *pState;
+}
+
+// =====================================================================================================================
+// Thread entry point: stores or loads (and checks) this thread's share of the entries.  In the Mixed phase it makes as
+// many random loads and stores instead.
+void WorkerThreadMain(
+    void* pParameter)
+{
+    WorkerThread*const    pState   = static_cast<WorkerThread*>(pParameter);
+    const EntrySet&       entries  = *pState->pEntries;
+    ICacheLayer*const     pLayer   = pState->pLayer;
+    void*const            pBuffer  = (pState->phase != Phase::Store) ? malloc(entries.size) : nullptr;
+    uint64                random   = 0x2545F4914F6CDD1Dull * (pState->first + 1);
+    uint32                loads    = 0;
+    uint32                hits     = 0;
+    uint32                failures = 0;
+
+    StoreFlags storeFlags = {};
+    storeFlags.enableCompression = 1;
+
+    while (pState->pStart->load(std::memory_order_acquire) == false)
+    {
+    }
+
+    pState->startTime = GetPerfCpuTime();
+
+    for (uint32 i = pState->first; i < entries.count; i += pState->stride)
+    {
+        const uint8*const pEntry = entries.pData + (size_t(i) * entries.size);
+
+        if (pState->phase == Phase::Mixed)
+        {
+            const uint64      choice  = NextRandom(&random);
+            const uint32      index   = uint32((choice >> 8) % entries.count);
+            const uint8*const pRandom = entries.pData + (size_t(index) * entries.size);
+
+            if ((choice & 0xFF) < ((pState->loadPercent * 256) / 100))
+            {
+                // The entry may be missing, or be evicted between the query and the load; both are misses.
+                QueryResult query  = {};
+                Result      result = pLayer->Query(&entries.pIds[index], 0, 0, &query);
+
+                if ((result == Result::Success) && (pBuffer != nullptr))
+                {
+                    result = pLayer->Load(&query, pBuffer);
+                }
+
+                loads++;
+
+                if (result == Result::Success)
+                {
+                    hits++;
+                    failures += (memcmp(pBuffer, pRandom, entries.size) != 0);
+                }
+            }
+            else
+            {
+                const Result result = pLayer->Store(storeFlags, &entries.pIds[index], pRandom, entries.size);
+
+                failures += ((result != Result::Success) && (result != Result::AlreadyExists));
+            }
+        }
+        else if (pState->phase == Phase::Store)
+        {
+            failures += (pLayer->Store(storeFlags, &entries.pIds[i], pEntry, entries.size) != Result::Success);
+        }
+        else
+        {
+            QueryResult query  = {};
+            Result      result = pLayer->Query(&entries.pIds[i], 0, 0, &query);
+
+            if ((result == Result::Success) && (pBuffer != nullptr) && (query.dataSize == entries.size))
+            {
+                result = pLayer->Load(&query, pBuffer);
+            }
+            else
+            {
+                result = Result::ErrorUnknown;
+            }
+
+            failures += ((result != Result::Success) || (memcmp(pBuffer, pEntry, entries.size) != 0));
+        }
+    }
+
+    pState->endTime  = GetPerfCpuTime();
+    pState->loads    = loads;
+    pState->hits     = hits;
+    pState->failures = failures;
+
+    free(pBuffer);
+}
+
+// =====================================================================================================================
+// Runs one phase on options.threads threads and returns the aggregate wall-clock time in ticks, or -1 if a thread
+// could not be started.  Adds the failed operations to *pFailures, and the Mixed phase's loads and hits to *pLoads and
+// *pHits if those are given.
+int64 RunPhase(
+    ICacheLayer*    pLayer,
+    const EntrySet& entries,
+    Phase           phase,
+    const Options&  options,
+    uint32*         pFailures,
+    uint32*         pLoads,
+    uint32*         pHits)
+{
+    std::atomic<bool> start(false);
+    WorkerThread      threads[MaxThreads];
+    uint32            threadCount = 0;
+    Result            result      = Result::Success;
+
+    for (; (result == Result::Success) && (threadCount < options.threads); ++threadCount)
+    {
+        WorkerThread*const pState = &threads[threadCount];
+
+        pState->pLayer      = pLayer;
+        pState->pEntries    = &entries;
+        pState->phase       = phase;
+        pState->first       = threadCount;
+        pState->stride      = options.threads;
+        pState->loadPercent = options.loadPercent;
+        pState->pStart      = &start;
+        pState->startTime   = 0;
+        pState->endTime     = 0;
+        pState->loads       = 0;
+        pState->hits        = 0;
+        pState->failures    = 0;
+
+        result = pState->thread.Begin(&WorkerThreadMain, pState);
+    }
+
+    // Threads which did start must be released even if a later one failed to, so that they can be joined.
+    start.store(true, std::memory_order_release);
+
+    int64 firstStart = 0;
+    int64 lastEnd    = 0;
+
+    for (uint32 i = 0; i < threadCount; ++i)
+    {
+        if (threads[i].thread.IsCreated())
+        {
+            threads[i].thread.Join();
+
+            firstStart  = ((i == 0) || (threads[i].startTime < firstStart)) ? threads[i].startTime : firstStart;
+            lastEnd     = Max(lastEnd, threads[i].endTime);
+            *pFailures += threads[i].failures;
+
+            if ((pLoads != nullptr) && (pHits != nullptr))
+            {
+                *pLoads += threads[i].loads;
+                *pHits  += threads[i].hits;
+            }
+        }
+    }
+
+    return (result == Result::Success) ? (lastEnd - firstStart) : -1;
+}
+
+// =====================================================================================================================
+// Sums the size the entries take up in the memory layer, and counts those that are stored uncompressed.
+void MeasureStoredSize(
+    ICacheLayer*    pMemory,
+    const EntrySet& entries,
+    uint64*         pStoredBytes,
+    uint32*         pUncompressed)
+{
+    *pStoredBytes  = 0;
+    *pUncompressed = 0;
+
+    for (uint32 i = 0; i < entries.count; ++i)
+    {
+        QueryResult query = {};
+
+        if (pMemory->Query(&entries.pIds[i], 0, 0, &query) == Result::Success)
+        {
+            *pStoredBytes  += query.storeSize;
+            *pUncompressed += (query.storeSize == query.dataSize);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Waits until the compressing layer's background thread has replaced every entry with its compressed copy, or until
+// no progress has been made for SettleTimeoutMs (an entry that doesn't compress is left as it is).  Returns the time
+// waited in ticks.
+int64 WaitForCompression(
+    ICacheLayer*    pMemory,
+    const EntrySet& entries)
+{
+    const int64 start        = GetPerfCpuTime();
+    const int64 timeoutTicks = (GetPerfFrequency() / 1000) * SettleTimeoutMs;
+    int64       lastProgress = start;
+    int64       now          = start;
+    uint32      lastCount    = UINT32_MAX;
+    uint64      storedBytes  = 0;
+    uint32      uncompressed = 0;
+
+    do
+    {
+        MeasureStoredSize(pMemory, entries, &storedBytes, &uncompressed);
+        now = GetPerfCpuTime();
+
+        if (uncompressed != lastCount)
+        {
+            lastCount    = uncompressed;
+            lastProgress = now;
+        }
+        else
+        {
+            SleepMs(1);
+        }
+    }
+    while ((uncompressed > 0) && ((now - lastProgress) < timeoutTicks));
+
+    return now - start;
+}
+
+// =====================================================================================================================
+// Runs one configuration "repeats" times and prints the best results.  Returns false if anything failed.
+bool RunConfig(
+    Config          config,
+    const EntrySet& entries,
+    const Options&  options)
+{
+    const double nsPerTick   = 1.0e9 / static_cast<double>(GetPerfFrequency());
+    int64        bestStore   = INT64_MAX;
+    int64        bestLoad    = INT64_MAX;
+    int64        bestSettle  = INT64_MAX;
+    uint64       storedBytes = 0;
+    uint32       failures    = 0;
+    Result       result      = Result::Success;
+
+    for (uint32 repeat = 0; (result == Result::Success) && (repeat < options.repeats); ++repeat)
+    {
+        LayerChain chain = {};
+        result = CreateChain(config, entries, entries.count, 0, &chain);
+
+        if (result == Result::Success)
+        {
+            const int64 storeTicks = RunPhase(chain.pTop, entries, Phase::Store, options, &failures, nullptr, nullptr);
+            const int64 loadTicks  = RunPhase(chain.pTop, entries, Phase::Load, options, &failures, nullptr, nullptr);
+
+            if ((storeTicks < 0) || (loadTicks < 0))
+            {
+                result = Result::ErrorUnknown;
+            }
+            else
+            {
+                bestStore = Min(bestStore, storeTicks);
+                bestLoad  = Min(bestLoad, loadTicks);
+            }
+
+            if (config == Config::CompressAsync)
+            {
+                bestSettle = Min(bestSettle, WaitForCompression(chain.pMemory, entries));
+
+                // Everything must still load correctly once it has all been replaced.
+                RunPhase(chain.pTop, entries, Phase::Load, options, &failures, nullptr, nullptr);
+            }
+
+            uint32 uncompressed = 0;
+            MeasureStoredSize(chain.pMemory, entries, &storedBytes, &uncompressed);
+        }
+
+        DestroyChain(&chain);
+    }
+
+    if ((result == Result::Success) && (failures == 0))
+    {
+        char settle[32] = "-";
+
+        if (bestSettle != INT64_MAX)
+        {
+            snprintf(settle, sizeof(settle), "%.1f", static_cast<double>(bestSettle) * nsPerTick * 1.0e-6);
+        }
+
+        printf("  %-32s %12.1f %12.1f %12s %12.2f\n",
+               ConfigNames[uint32(config)],
+               static_cast<double>(bestStore) * nsPerTick / entries.count,
+               static_cast<double>(bestLoad) * nsPerTick / entries.count,
+               settle,
+               static_cast<double>(storedBytes) / (1024.0 * 1024.0));
+    }
+    else
+    {
+        printf("  %-32s failed (Result %d, %u failed operations)\n",
+               ConfigNames[uint32(config)],
+               static_cast<int32>(result),
+               failures);
+    }
+
+    return (result == Result::Success) && (failures == 0);
+}
+
+// =====================================================================================================================
+// Runs the Mixed phase "repeats" times against a memory layer with room for half of the entries, split into numShards
+// shards, and prints the best time per operation.  Returns false if anything failed.
+bool RunContention(
+    uint32          numShards,
+    const EntrySet& entries,
+    const Options&  options)
+{
+    const double nsPerTick = 1.0e9 / static_cast<double>(GetPerfFrequency());
+    int64        bestMixed = INT64_MAX;
+    uint32       loads     = 0;
+    uint32       hits      = 0;
+    uint32       failures  = 0;
+    Result       result    = Result::Success;
+
+    for (uint32 repeat = 0; (result == Result::Success) && (repeat < options.repeats); ++repeat)
+    {
+        LayerChain chain = {};
+        result = CreateChain(Config::Memory, entries, Max(entries.count / 2, 1u), numShards, &chain);
+
+        if (result == Result::Success)
+        {
+            // Storing every entry fills the layer and leaves the later half of the entries resident.
+            const int64 fillTicks  = RunPhase(chain.pTop, entries, Phase::Store, options, &failures, nullptr, nullptr);
+            const int64 mixedTicks = RunPhase(chain.pTop, entries, Phase::Mixed, options, &failures, &loads, &hits);
+
+            if ((fillTicks < 0) || (mixedTicks < 0))
+            {
+                result = Result::ErrorUnknown;
+            }
+            else
+            {
+                bestMixed = Min(bestMixed, mixedTicks);
+            }
+        }
+
+        DestroyChain(&chain);
+    }
+
+    char shards[32] = "default";
+
+    if (numShards != 0)
+    {
+        snprintf(shards, sizeof(shards), "%u", numShards);
+    }
+
+    if ((result == Result::Success) && (failures == 0))
+    {
+        printf("  %-32s %12.1f %11.1f%%\n",
+               shards,
+               static_cast<double>(bestMixed) * nsPerTick / entries.count,
+               (loads > 0) ? (100.0 * hits / loads) : 0.0);
+    }
+    else
+    {
+        printf("  %-32s failed (Result %d, %u failed operations)\n", shards, static_cast<int32>(result), failures);
+    }
+
+    return (result == Result::Success) && (failures == 0);
+}
+
+// =====================================================================================================================
+// Parses the command line.  Returns false on a malformed command line.
+bool ParseOptions(
+    int      argc,
+    char**   argv,
+    Options* pOptions)
+{
+    bool valid = true;
+
+    pOptions->threads = DefaultThreads;
+    pOptions->entries = DefaultEntries;
+    pOptions->size    = DefaultSize;
+    pOptions->repeats     = DefaultRepeats;
+    pOptions->loadPercent = DefaultLoads;
+
+    for (int i = 1; valid && (i < argc); ++i)
+    {
+        const char* pArg   = argv[i];
+        const char* pValue = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        // Every option takes a value.
+        if (pValue == nullptr)
+        {
+            valid = false;
+        }
+        else if (strcmp(pArg, "--threads") == 0)
+        {
+            pOptions->threads = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid             = (pOptions->threads > 0) && (pOptions->threads <= MaxThreads);
+        }
+        else if (strcmp(pArg, "--entries") == 0)
+        {
+            pOptions->entries = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid             = (pOptions->entries > 0);
+        }
+        else if (strcmp(pArg, "--size") == 0)
+        {
+            pOptions->size = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid          = (pOptions->size > 0);
+        }
+        else if (strcmp(pArg, "--repeats") == 0)
+        {
+            pOptions->repeats = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid             = (pOptions->repeats > 0);
+        }
+        else if (strcmp(pArg, "--load-percent") == 0)
+        {
+            pOptions->loadPercent = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid                 = (pOptions->loadPercent <= 100);
+        }
+        else
+        {
+            valid = false;
+        }
+
+        ++i;
+    }
+
+    if (valid == false)
+    {
+        fprintf(stderr,
+                "Usage: %s [--threads <count>] [--entries <count>] [--size <bytes>] [--repeats <count>]\n"
+                "          [--load-percent <percent>]\n",
+                argv[0]);
+    }
+
+    return valid;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int    argc,
+    char** argv)
+{
+    Options  options = {};
+    EntrySet entries = {};
+    bool     success = ParseOptions(argc, argv, &options) && CreateEntries(options, &entries);
+
+    if (success)
+    {
+        printf("%u threads, %u entries of %u bytes, best of %u\n",
+               options.threads,
+               options.entries,
+               options.size,
+               options.repeats);
+        printf("  %-32s %12s %12s %12s %12s\n", "Layers", "ns/store", "ns/load", "settle ms", "stored MiB");
+
+        for (uint32 config = 0; config < uint32(Config::Count); ++config)
+        {
+            success &= RunConfig(Config(config), entries, options);
+        }
+
+        printf("\nMemory layer with room for half of the entries, random mix of %u%% loads and %u%% stores\n",
+               options.loadPercent,
+               100 - options.loadPercent);
+        printf("  %-32s %12s %12s\n", "Shards", "ns/op", "hit rate");
+
+        for (uint32 i = 0; i < (sizeof(ContentionShards) / sizeof(ContentionShards[0])); ++i)
+        {
+            success &= RunContention(ContentionShards[i], entries, options);
+        }
+    }
+
+    free(entries.pData);
+    free(entries.pIds);
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
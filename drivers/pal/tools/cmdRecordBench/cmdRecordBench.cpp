@@ -0,0 +1,1364 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  cmdRecordBench.cpp
+ * @brief CPU-only benchmark of command buffer recording on PAL's null device.
+ *
+ * The null device backs GPU memory with system memory and never submits anything, so everything measured here is the
+ * CPU cost of building PM4 in the hardware-layer command buffers.  Each workload records the same call many times into
+ * a universal command buffer and reports the best-of-N time per call and the PM4 bytes written per call.
+ *
+ * With --threads N (N > 1) every workload is instead recorded on N threads at once, each thread into its own command
+ * buffer from one shared thread-safe command allocator.  Each thread resets, begins, records and ends its command
+ * buffer "repeats" times, and the aggregate wall-clock time per call is reported.  Small iteration counts make this
+ * dominated by command chunk and linear allocator traffic in the shared allocator.
+ *
+ * Single-threaded runs also time buffer SRD creation through IDevice::CreateUntypedBufferViewSrds, one view per call
+ * and in batches, which is the per-descriptor CPU cost of writing uniform and storage buffer descriptors.
+ *
+ * Usage: palCmdRecordBench [--gpu <null GPU name>] [--iterations <count>] [--repeats <count>]
+ *                          [--compute-elf <file>] [--graphics-elf <file>] [--threads <count>] [--no-rpm]
+ *
+ * Without --gpu, one GFX10 and one GFX11 null device are benchmarked.  The pipeline workloads (CmdBindPipeline and the
+ * draw/dispatch validation paths) need a PAL ABI pipeline binary for the selected GPU, e.g. one written by amdllpc, and
+ * are skipped when none is given.  --no-rpm disables PAL's resource processing manager, for PAL builds without its
+ * internal shader binaries; CmdCopyImage is skipped then.
+ ***********************************************************************************************************************
+ */
+
+#include "pal.h"
+#include "palCmdAllocator.h"
+#include "palCmdBuffer.h"
+#include "palColorBlendState.h"
+#include "palColorTargetView.h"
+#include "palDepthStencilState.h"
+#include "palDevice.h"
+#include "palFile.h"
+#include "palFormatInfo.h"
+#include "palGpuMemory.h"
+#include "palImage.h"
+#include "palLib.h"
+#include "palMsaaState.h"
+#include "palPipeline.h"
+#include "palPlatform.h"
+#include "palSysUtil.h"
+#include "palThread.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Pal;
+using namespace Util;
+
+namespace
+{
+
+constexpr uint32 DefaultIterations  = 4096;
+constexpr uint32 DefaultRepeats     = 8;
+constexpr uint32 NumUserDataEntries = 8;
+constexpr uint32 ImageSize          = 256;
+constexpr uint32 IndexCount         = 3;
+constexpr uint32 MaxThreads         = 64;
+
+constexpr SwizzledFormat TargetFormat =
+{
+    ChNumFormat::X8Y8Z8W8_Unorm,
+    { { { ChannelSwizzle::X, ChannelSwizzle::Y, ChannelSwizzle::Z, ChannelSwizzle::W } } },
+};
+
+// Command line options.
+struct Options
+{
+    uint32      iterations;
+    uint32      repeats;
+    const char* pGpuName;
+    const char* pComputeElf;
+    const char* pGraphicsElf;
+    uint32      threads;
+    bool        noRpm;
+};
+
+// A pipeline binary loaded from disk.  PAL does not take ownership of the binary, so it is kept alive as long as the
+// pipelines created from it.
+struct PipelineBinary
+{
+    void*  pData;
+    size_t size;
+};
+
+// Everything the workloads record against on one null device.  The "pipeline" objects come in pairs so workloads can
+// alternate between two distinct pipelines and defeat redundant-bind filtering.
+struct BenchContext
+{
+    IDevice*            pDevice;
+    ICmdAllocator*      pCmdAllocator;
+    ICmdBuffer*         pCmdBuffer;
+    ICmdBuffer*         pThreadCmdBuffers[MaxThreads]; // Only created for multi-threaded runs.
+    IGpuMemory*         pImageMemory[2];
+    IImage*             pImages[2];
+    IGpuMemory*         pIndexMemory;
+    IColorTargetView*   pColorTargetView;
+    IMsaaState*         pMsaaState;
+    IColorBlendState*   pColorBlendState;
+    IDepthStencilState* pDepthStencilState;
+    IPipeline*          pComputePipelines[2];
+    IPipeline*          pGraphicsPipelines[2];
+    uint32              userData[NumUserDataEntries];
+};
+
+// Records one call (or one small group of calls) of a workload.
+typedef void (*RecordFunc)(BenchContext* pContext, uint32 iteration);
+
+// Describes one workload.
+struct Workload
+{
+    const char* pName;
+    bool        needsComputePipeline;
+    bool        needsGraphicsPipeline;
+    bool        needsRpm;      // Records through the resource processing manager's internal pipelines.
+    RecordFunc  pfnPrologue;   // Optional; recorded once per repeat before the timed loop.
+    RecordFunc  pfnRecord;     // Recorded once per iteration inside the timed loop.
+};
+
+// =====================================================================================================================
+template <typename Object>
+void DestroyObject(
+    Object** ppObject)
+{
+    if (*ppObject != nullptr)
+    {
+        // All objects are created in placement memory which starts at the object itself.
+        (*ppObject)->Destroy();
+        free(*ppObject);
+        *ppObject = nullptr;
+    }
+}
+
+// =====================================================================================================================
+// Allocates placement memory for and creates a device object through its pair of GetXxxSize()/CreateXxx() methods.
+template <typename CreateInfo, typename CreateFunc, typename Object>
+Result CreateObject(
+    IDevice*          pDevice,
+    size_t            (IDevice::*pfnGetSize)(const CreateInfo&, Result*) const,
+    CreateFunc        pfnCreate,
+    const CreateInfo& createInfo,
+    Object**          ppObject)
+{
+    Result       result = Result::Success;
+    const size_t size   = (pDevice->*pfnGetSize)(createInfo, &result);
+
+    if (result == Result::Success)
+    {
+        void* pMemory = malloc(size);
+
+        if (pMemory == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+        else
+        {
+            result = (pDevice->*pfnCreate)(createInfo, pMemory, ppObject);
+
+            if (result != Result::Success)
+            {
+                free(pMemory);
+                *ppObject = nullptr;
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Creates a 2D color image with its own bound GPU memory.
+Result CreateImage(
+    IDevice*     pDevice,
+    IImage**     ppImage,
+    IGpuMemory** ppGpuMemory)
+{
+    ImageCreateInfo imageInfo = {};
+    imageInfo.imageType              = ImageType::Tex2d;
+    imageInfo.swizzledFormat         = TargetFormat;
+    imageInfo.extent                 = { ImageSize, ImageSize, 1 };
+    imageInfo.mipLevels              = 1;
+    imageInfo.arraySize              = 1;
+    imageInfo.samples                = 1;
+    imageInfo.fragments              = 1;
+    imageInfo.tiling                 = ImageTiling::Optimal;
+    imageInfo.usageFlags.colorTarget = 1;
+    imageInfo.usageFlags.shaderRead  = 1;
+
+    Result result = CreateObject(pDevice, &IDevice::GetImageSize, &IDevice::CreateImage, imageInfo, ppImage);
+
+    if (result == Result::Success)
+    {
+        GpuMemoryRequirements memReqs = {};
+        (*ppImage)->GetGpuMemoryRequirements(&memReqs);
+
+        GpuMemoryCreateInfo memInfo = {};
+        memInfo.size      = memReqs.size;
+        memInfo.alignment = memReqs.alignment;
+        memInfo.vaRange   = VaRange::Default;
+        memInfo.priority  = GpuMemPriority::Normal;
+        memInfo.heapCount = memReqs.heapCount;
+        memInfo.pImage    = *ppImage;
+
+        for (uint32 i = 0; i < memReqs.heapCount; ++i)
+        {
+            memInfo.heaps[i] = memReqs.heaps[i];
+        }
+
+        result = CreateObject(pDevice, &IDevice::GetGpuMemorySize, &IDevice::CreateGpuMemory, memInfo, ppGpuMemory);
+    }
+
+    if (result == Result::Success)
+    {
+        result = (*ppImage)->BindGpuMemory(*ppGpuMemory, 0);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Creates two pipelines from the same binary.  Returns Success without creating anything if no binary was given.
+Result CreatePipelines(
+    IDevice*              pDevice,
+    const PipelineBinary& binary,
+    bool                  isGraphics,
+    IPipeline*            ppPipelines[2])
+{
+    Result result = Result::Success;
+
+    for (uint32 i = 0; (binary.pData != nullptr) && (result == Result::Success) && (i < 2); ++i)
+    {
+        if (isGraphics)
+        {
+            GraphicsPipelineCreateInfo createInfo = {};
+            createInfo.pPipelineBinary                           = binary.pData;
+            createInfo.pipelineBinarySize                        = binary.size;
+            createInfo.iaState.topologyInfo.primitiveType        = PrimitiveType::Triangle;
+            createInfo.cbState.logicOp                           = LogicOp::Copy;
+            createInfo.cbState.target[0].swizzledFormat          = TargetFormat;
+            createInfo.cbState.target[0].channelWriteMask        = 0xF;
+            createInfo.viewportInfo.depthClipNearEnable          = true;
+            createInfo.viewportInfo.depthClipFarEnable           = true;
+            createInfo.viewportInfo.depthRange                   = DepthRange::ZeroToOne;
+
+            result = CreateObject(pDevice,
+                                  &IDevice::GetGraphicsPipelineSize,
+                                  &IDevice::CreateGraphicsPipeline,
+                                  createInfo,
+                                  &ppPipelines[i]);
+        }
+        else
+        {
+            ComputePipelineCreateInfo createInfo = {};
+            createInfo.pPipelineBinary    = binary.pData;
+            createInfo.pipelineBinarySize = binary.size;
+
+            result = CreateObject(pDevice,
+                                  &IDevice::GetComputePipelineSize,
+                                  &IDevice::CreateComputePipeline,
+                                  createInfo,
+                                  &ppPipelines[i]);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Creates the command buffer and every object the workloads need on an already finalized device.
+Result InitContext(
+    IDevice*              pDevice,
+    const PipelineBinary& computeBinary,
+    const PipelineBinary& graphicsBinary,
+    uint32                threadCount,
+    BenchContext*         pContext)
+{
+    memset(pContext, 0, sizeof(*pContext));
+    pContext->pDevice = pDevice;
+
+    CmdAllocatorCreateInfo allocInfo = {};
+    allocInfo.flags.autoMemoryReuse          = 1;
+    allocInfo.flags.disableBusyChunkTracking = 1;
+    allocInfo.flags.threadSafe               = (threadCount > 1);
+
+    for (uint32 type = 0; type < CmdAllocatorTypeCount; ++type)
+    {
+        allocInfo.allocInfo[type].allocHeap    = (type == GpuScratchMemAlloc) ? GpuHeapInvisible : GpuHeapGartUswc;
+        allocInfo.allocInfo[type].allocSize    = 2 * 1024 * 1024;
+        allocInfo.allocInfo[type].suballocSize = 64 * 1024;
+    }
+
+    Result result = CreateObject(pDevice,
+                                 &IDevice::GetCmdAllocatorSize,
+                                 &IDevice::CreateCmdAllocator,
+                                 allocInfo,
+                                 &pContext->pCmdAllocator);
+
+    if (result == Result::Success)
+    {
+        CmdBufferCreateInfo cmdBufInfo = {};
+        cmdBufInfo.pCmdAllocator = pContext->pCmdAllocator;
+        cmdBufInfo.queueType     = QueueTypeUniversal;
+        cmdBufInfo.engineType    = EngineTypeUniversal;
+
+        result = CreateObject(pDevice,
+                              &IDevice::GetCmdBufferSize,
+                              &IDevice::CreateCmdBuffer,
+                              cmdBufInfo,
+                              &pContext->pCmdBuffer);
+
+        for (uint32 i = 0; (result == Result::Success) && (threadCount > 1) && (i < threadCount); ++i)
+        {
+            result = CreateObject(pDevice,
+                                  &IDevice::GetCmdBufferSize,
+                                  &IDevice::CreateCmdBuffer,
+                                  cmdBufInfo,
+                                  &pContext->pThreadCmdBuffers[i]);
+        }
+    }
+
+    for (uint32 i = 0; (result == Result::Success) && (i < 2); ++i)
+    {
+        result = CreateImage(pDevice, &pContext->pImages[i], &pContext->pImageMemory[i]);
+    }
+
+    if (result == Result::Success)
+    {
+        GpuMemoryCreateInfo memInfo = {};
+        memInfo.size      = 4096;
+        memInfo.alignment = 256;
+        memInfo.vaRange   = VaRange::Default;
+        memInfo.priority  = GpuMemPriority::Normal;
+        memInfo.heapCount = 1;
+        memInfo.heaps[0]  = GpuHeapGartUswc;
+
+        result = CreateObject(pDevice,
+                              &IDevice::GetGpuMemorySize,
+                              &IDevice::CreateGpuMemory,
+                              memInfo,
+                              &pContext->pIndexMemory);
+    }
+
+    if (result == Result::Success)
+    {
+        ColorTargetViewCreateInfo viewInfo = {};
+        viewInfo.swizzledFormat       = TargetFormat;
+        viewInfo.imageInfo.pImage     = pContext->pImages[0];
+        viewInfo.imageInfo.arraySize  = 1;
+
+        const size_t size    = pDevice->GetColorTargetViewSize(&result);
+        void*        pMemory = (result == Result::Success) ? malloc(size) : nullptr;
+
+        if (pMemory == nullptr)
+        {
+            result = (result == Result::Success) ? Result::ErrorOutOfMemory : result;
+        }
+        else
+        {
+            result = pDevice->CreateColorTargetView(viewInfo, pMemory, &pContext->pColorTargetView);
+
+            if (result != Result::Success)
+            {
+                free(pMemory);
+                pContext->pColorTargetView = nullptr;
+            }
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        MsaaStateCreateInfo msaaInfo = {};
+        msaaInfo.coverageSamples         = 1;
+        msaaInfo.exposedSamples          = 1;
+        msaaInfo.pixelShaderSamples      = 1;
+        msaaInfo.depthStencilSamples     = 1;
+        msaaInfo.shaderExportMaskSamples = 1;
+        msaaInfo.sampleMask              = 1;
+        msaaInfo.sampleClusters          = 1;
+        msaaInfo.alphaToCoverageSamples  = 1;
+        msaaInfo.occlusionQuerySamples   = 1;
+
+        result = CreateObject(pDevice,
+                              &IDevice::GetMsaaStateSize,
+                              &IDevice::CreateMsaaState,
+                              msaaInfo,
+                              &pContext->pMsaaState);
+    }
+
+    if (result == Result::Success)
+    {
+        const ColorBlendStateCreateInfo blendInfo = {};
+
+        result = CreateObject(pDevice,
+                              &IDevice::GetColorBlendStateSize,
+                              &IDevice::CreateColorBlendState,
+                              blendInfo,
+                              &pContext->pColorBlendState);
+    }
+
+    if (result == Result::Success)
+    {
+        DepthStencilStateCreateInfo depthInfo = {};
+        depthInfo.depthFunc = CompareFunc::Always;
+
+        result = CreateObject(pDevice,
+                              &IDevice::GetDepthStencilStateSize,
+                              &IDevice::CreateDepthStencilState,
+                              depthInfo,
+                              &pContext->pDepthStencilState);
+    }
+
+    if (result == Result::Success)
+    {
+        result = CreatePipelines(pDevice, computeBinary, false, pContext->pComputePipelines);
+    }
+
+    if (result == Result::Success)
+    {
+        result = CreatePipelines(pDevice, graphicsBinary, true, pContext->pGraphicsPipelines);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void DestroyContext(
+    BenchContext* pContext)
+{
+    // The command buffers must go before their allocator and everything they may reference.
+    DestroyObject(&pContext->pCmdBuffer);
+
+    for (uint32 i = 0; i < MaxThreads; ++i)
+    {
+        DestroyObject(&pContext->pThreadCmdBuffers[i]);
+    }
+
+    for (uint32 i = 0; i < 2; ++i)
+    {
+        DestroyObject(&pContext->pGraphicsPipelines[i]);
+        DestroyObject(&pContext->pComputePipelines[i]);
+    }
+
+    DestroyObject(&pContext->pDepthStencilState);
+    DestroyObject(&pContext->pColorBlendState);
+    DestroyObject(&pContext->pMsaaState);
+
+    // Color target views have no Destroy(); their placement memory is all there is to free.
+    free(pContext->pColorTargetView);
+    pContext->pColorTargetView = nullptr;
+
+    DestroyObject(&pContext->pIndexMemory);
+
+    for (uint32 i = 0; i < 2; ++i)
+    {
+        DestroyObject(&pContext->pImages[i]);
+        DestroyObject(&pContext->pImageMemory[i]);
+    }
+
+    DestroyObject(&pContext->pCmdAllocator);
+}
+
+// =====================================================================================================================
+// Workloads.  Anything the hardware layer would filter as redundant (same user data, same pipeline) is varied per
+// iteration so every call takes its full path.
+
+// =====================================================================================================================
+void SetUserData(
+    BenchContext*     pContext,
+    PipelineBindPoint bindPoint,
+    uint32            entryCount,
+    uint32            iteration)
+{
+    pContext->userData[0] = iteration;
+    pContext->pCmdBuffer->CmdSetUserData(bindPoint, 0, entryCount, pContext->userData);
+}
+
+// =====================================================================================================================
+void RecordSetUserDataCompute(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    SetUserData(pContext, PipelineBindPoint::Compute, NumUserDataEntries, iteration);
+}
+
+// =====================================================================================================================
+void RecordSetUserDataGraphics(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    SetUserData(pContext, PipelineBindPoint::Graphics, NumUserDataEntries, iteration);
+}
+
+// =====================================================================================================================
+// Transitions the first image back and forth between color target and shader read.
+void RecordImageBarrier(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    const ImageLayout colorTarget = { LayoutColorTarget, LayoutUniversalEngine };
+    const ImageLayout shaderRead  = { LayoutShaderRead,  LayoutUniversalEngine };
+    const bool        toRead      = ((iteration & 1) == 0);
+    const HwPipePoint pipePoint   = HwPipePostPs;
+
+    BarrierTransition transition = {};
+    transition.srcCacheMask                     = toRead ? CoherColorTarget : CoherShaderRead;
+    transition.dstCacheMask                     = toRead ? CoherShaderRead  : CoherColorTarget;
+    transition.imageInfo.pImage                 = pContext->pImages[0];
+    transition.imageInfo.subresRange.numPlanes  = 1;
+    transition.imageInfo.subresRange.numMips    = 1;
+    transition.imageInfo.subresRange.numSlices  = 1;
+    transition.imageInfo.oldLayout              = toRead ? colorTarget : shaderRead;
+    transition.imageInfo.newLayout              = toRead ? shaderRead  : colorTarget;
+
+    BarrierInfo barrier = {};
+    barrier.waitPoint          = HwPipePreRasterization;
+    barrier.pipePointWaitCount = 1;
+    barrier.pPipePoints        = &pipePoint;
+    barrier.transitionCount    = 1;
+    barrier.pTransitions       = &transition;
+
+    pContext->pCmdBuffer->CmdBarrier(barrier);
+}
+
+// =====================================================================================================================
+// A memory-only barrier: wait for all prior work and make shader writes visible.
+void RecordGlobalBarrier(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    const HwPipePoint pipePoint = HwPipeBottom;
+
+    BarrierInfo barrier = {};
+    barrier.waitPoint          = HwPipeTop;
+    barrier.pipePointWaitCount = 1;
+    barrier.pPipePoints        = &pipePoint;
+    barrier.globalSrcCacheMask = CoherShaderWrite;
+    barrier.globalDstCacheMask = CoherShaderRead;
+
+    pContext->pCmdBuffer->CmdBarrier(barrier);
+}
+
+// =====================================================================================================================
+void RecordCopyImage(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    const ImageLayout srcLayout = { LayoutCopySrc, LayoutUniversalEngine };
+    const ImageLayout dstLayout = { LayoutCopyDst, LayoutUniversalEngine };
+
+    ImageCopyRegion region = {};
+    region.extent    = { ImageSize, ImageSize, 1 };
+    region.numSlices = 1;
+
+    pContext->pCmdBuffer->CmdCopyImage(*pContext->pImages[0],
+                                       srcLayout,
+                                       *pContext->pImages[1],
+                                       dstLayout,
+                                       1,
+                                       &region,
+                                       nullptr,
+                                       0);
+}
+
+// =====================================================================================================================
+void BindPipeline(
+    BenchContext*     pContext,
+    PipelineBindPoint bindPoint,
+    const IPipeline*  pPipeline)
+{
+    PipelineBindParams params = {};
+    params.pipelineBindPoint = bindPoint;
+    params.pPipeline         = pPipeline;
+
+    pContext->pCmdBuffer->CmdBindPipeline(params);
+}
+
+// =====================================================================================================================
+void RecordBindComputePipeline(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    BindPipeline(pContext, PipelineBindPoint::Compute, pContext->pComputePipelines[iteration & 1]);
+}
+
+// =====================================================================================================================
+void RecordBindGraphicsPipeline(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    BindPipeline(pContext, PipelineBindPoint::Graphics, pContext->pGraphicsPipelines[iteration & 1]);
+}
+
+// =====================================================================================================================
+void PrologueCompute(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    RecordBindComputePipeline(pContext, 0);
+}
+
+// =====================================================================================================================
+// Each dispatch follows a user data change, so ValidateDispatch() has to rewrite the user data every time.
+void RecordDispatch(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    SetUserData(pContext, PipelineBindPoint::Compute, 1, iteration);
+    pContext->pCmdBuffer->CmdDispatch({ 1, 1, 1 });
+}
+
+// =====================================================================================================================
+// Binds all of the state a draw needs, including the first graphics pipeline and the index buffer.
+void PrologueGraphics(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    ICmdBuffer* pCmdBuffer = pContext->pCmdBuffer;
+
+    RecordBindGraphicsPipeline(pContext, 0);
+
+    pCmdBuffer->CmdBindMsaaState(pContext->pMsaaState);
+    pCmdBuffer->CmdBindColorBlendState(pContext->pColorBlendState);
+    pCmdBuffer->CmdBindDepthStencilState(pContext->pDepthStencilState);
+
+    ViewportParams viewports = {};
+    viewports.count                  = 1;
+    viewports.viewports[0].width     = static_cast<float>(ImageSize);
+    viewports.viewports[0].height    = static_cast<float>(ImageSize);
+    viewports.viewports[0].maxDepth  = 1.0f;
+    viewports.viewports[0].origin    = PointOrigin::UpperLeft;
+    viewports.horzDiscardRatio       = 1.0f;
+    viewports.vertDiscardRatio       = 1.0f;
+    viewports.horzClipRatio          = 1.0f;
+    viewports.vertClipRatio          = 1.0f;
+    viewports.depthRange             = DepthRange::ZeroToOne;
+    pCmdBuffer->CmdSetViewports(viewports);
+
+    ScissorRectParams scissors = {};
+    scissors.count              = 1;
+    scissors.scissors[0].extent = { ImageSize, ImageSize };
+    pCmdBuffer->CmdSetScissorRects(scissors);
+
+    BindTargetParams targets = {};
+    targets.colorTargetCount                 = 1;
+    targets.colorTargets[0].pColorTargetView = pContext->pColorTargetView;
+    targets.colorTargets[0].imageLayout      = { LayoutColorTarget, LayoutUniversalEngine };
+    pCmdBuffer->CmdBindTargets(targets);
+
+    pCmdBuffer->CmdBindIndexData(pContext->pIndexMemory->Desc().gpuVirtAddr, IndexCount, IndexType::Idx32);
+}
+
+// =====================================================================================================================
+// Draw after a user data change: the common case of per-draw constants.
+void RecordDrawUserDataDirty(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    SetUserData(pContext, PipelineBindPoint::Graphics, 1, iteration);
+    pContext->pCmdBuffer->CmdDraw(0, 3, 0, 1, 0);
+}
+
+// =====================================================================================================================
+// Draw after a pipeline change, which dirties most of the state ValidateDraw() tracks.
+void RecordDrawPipelineDirty(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    RecordBindGraphicsPipeline(pContext, iteration + 1);
+    pContext->pCmdBuffer->CmdDraw(0, 3, 0, 1, 0);
+}
+
+// =====================================================================================================================
+void RecordDrawIndexed(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    SetUserData(pContext, PipelineBindPoint::Graphics, 1, iteration);
+    pContext->pCmdBuffer->CmdDrawIndexed(0, IndexCount, 0, 0, 1, 0);
+}
+
+// =====================================================================================================================
+// Back-to-back draws with no state change between them: the floor of ValidateDraw().
+void RecordDrawClean(
+    BenchContext* pContext,
+    uint32        iteration)
+{
+    pContext->pCmdBuffer->CmdDraw(0, 3, 0, 1, 0);
+}
+
+constexpr Workload Workloads[] =
+{
+    { "CmdSetUserData (compute, 8 dwords)",    false, false, false, nullptr,           &RecordSetUserDataCompute   },
+    { "CmdSetUserData (graphics, 8 dwords)",   false, false, false, nullptr,           &RecordSetUserDataGraphics  },
+    { "CmdBarrier (image layout transition)",  false, false, false, nullptr,           &RecordImageBarrier         },
+    { "CmdBarrier (global cache flush)",       false, false, false, nullptr,           &RecordGlobalBarrier        },
+    { "CmdCopyImage (256x256 RGBA8)",          false, false, true,  nullptr,           &RecordCopyImage            },
+    { "CmdBindPipeline (compute)",             true,  false, false, nullptr,           &RecordBindComputePipeline  },
+    { "CmdDispatch (user data dirty)",         true,  false, false, &PrologueCompute,  &RecordDispatch             },
+    { "CmdBindPipeline (graphics)",            false, true,  false, nullptr,           &RecordBindGraphicsPipeline },
+    { "CmdDraw (no state change)",             false, true,  false, &PrologueGraphics, &RecordDrawClean            },
+    { "CmdDraw (user data dirty)",             false, true,  false, &PrologueGraphics, &RecordDrawUserDataDirty    },
+    { "CmdDraw (pipeline dirty)",              false, true,  false, &PrologueGraphics, &RecordDrawPipelineDirty    },
+    { "CmdDrawIndexed (user data dirty)",      false, true,  false, &PrologueGraphics, &RecordDrawIndexed          },
+};
+
+// =====================================================================================================================
+// Records a workload "repeats" times and reports the fastest run.  Returns false if command recording failed.
+bool RunWorkload(
+    BenchContext*   pContext,
+    const Workload& workload,
+    const Options&  options)
+{
+    ICmdBuffer*  pCmdBuffer = pContext->pCmdBuffer;
+    const double nsPerTick  = 1.0e9 / static_cast<double>(GetPerfFrequency());
+    double       bestNs     = 0.0;
+    uint32       pm4Bytes   = 0;
+    Result       result     = Result::Success;
+
+    for (uint32 repeat = 0; (result == Result::Success) && (repeat < options.repeats); ++repeat)
+    {
+        result = pCmdBuffer->Reset(pContext->pCmdAllocator, true);
+
+        if (result == Result::Success)
+        {
+            CmdBufferBuildInfo buildInfo = {};
+            buildInfo.flags.optimizeOneTimeSubmit = 1;
+
+            result = pCmdBuffer->Begin(buildInfo);
+        }
+
+        if (result == Result::Success)
+        {
+            if (workload.pfnPrologue != nullptr)
+            {
+                workload.pfnPrologue(pContext, 0);
+            }
+
+            const uint32 startBytes = pCmdBuffer->GetUsedSize(CommandDataAlloc);
+            const int64  startTime  = GetPerfCpuTime();
+
+            for (uint32 iteration = 0; iteration < options.iterations; ++iteration)
+            {
+                workload.pfnRecord(pContext, iteration);
+            }
+
+            const int64  endTime  = GetPerfCpuTime();
+            const uint32 endBytes = pCmdBuffer->GetUsedSize(CommandDataAlloc);
+
+            result = pCmdBuffer->End();
+
+            const double elapsedNs = static_cast<double>(endTime - startTime) * nsPerTick;
+
+            if ((repeat == 0) || (elapsedNs < bestNs))
+            {
+                bestNs = elapsedNs;
+            }
+
+            // The PM4 stream is deterministic, so every repeat writes the same amount.
+            pm4Bytes = endBytes - startBytes;
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        printf("  %-40s %12.1f %16.1f\n",
+               workload.pName,
+               bestNs / options.iterations,
+               static_cast<double>(pm4Bytes) / options.iterations);
+    }
+    else
+    {
+        printf("  %-40s failed (Result %d)\n", workload.pName, static_cast<int32>(result));
+    }
+
+    return (result == Result::Success);
+}
+
+// =====================================================================================================================
+// Times IDevice::CreateUntypedBufferViewSrds the way descriptor set updates use it: "iterations" raw buffer views are
+// turned into SRDs, one per call and then in batches, and the fastest of "repeats" runs is reported per descriptor.
+// Returns false if the buffers could not be allocated.
+bool RunBufferSrdBench(
+    IDevice*                pDevice,
+    const DeviceProperties& props,
+    const Options&          options)
+{
+    constexpr uint32 BatchSizes[] = { 1, 16, 64 };
+
+    const uint32 count   = RoundUpToMultiple(options.iterations, BatchSizes[ArrayLen(BatchSizes) - 1]);
+    const size_t srdSize = props.gfxipProperties.srdSizes.bufferView;
+
+    BufferViewInfo* pInfos = static_cast<BufferViewInfo*>(malloc(count * sizeof(BufferViewInfo)));
+    void*           pSrds  = malloc(count * srdSize);
+    const bool      valid  = (pInfos != nullptr) && (pSrds != nullptr);
+
+    if (valid)
+    {
+        // Distinct addresses and ranges so nothing can be reused between descriptors.
+        for (uint32 idx = 0; idx < count; ++idx)
+        {
+            pInfos[idx]                = {};
+            pInfos[idx].gpuAddr        = 0x100000000ull + (idx * 256ull);
+            pInfos[idx].range          = 64 + ((idx % 16) * 4);
+            pInfos[idx].stride         = 0;
+            pInfos[idx].swizzledFormat = UndefinedSwizzledFormat;
+        }
+
+        const double nsPerTick = 1.0e9 / static_cast<double>(GetPerfFrequency());
+
+        for (uint32 batchSize : BatchSizes)
+        {
+            double bestNs = 0.0;
+
+            for (uint32 repeat = 0; repeat < options.repeats; ++repeat)
+            {
+                const int64 startTime = GetPerfCpuTime();
+
+                for (uint32 idx = 0; idx < count; idx += batchSize)
+                {
+                    pDevice->CreateUntypedBufferViewSrds(batchSize, &pInfos[idx], VoidPtrInc(pSrds, idx * srdSize));
+                }
+
+                const int64  endTime   = GetPerfCpuTime();
+                const double elapsedNs = static_cast<double>(endTime - startTime) * nsPerTick;
+
+                if ((repeat == 0) || (elapsedNs < bestNs))
+                {
+                    bestNs = elapsedNs;
+                }
+            }
+
+            char name[64];
+            snprintf(name, sizeof(name), "CreateUntypedBufferViewSrds (batch %u)", batchSize);
+
+            printf("  %-40s %12.1f\n", name, bestNs / count);
+        }
+    }
+    else
+    {
+        printf("  %-40s failed (out of memory)\n", "CreateUntypedBufferViewSrds");
+    }
+
+    free(pInfos);
+    free(pSrds);
+
+    return valid;
+}
+
+// State for one recording thread of a multi-threaded workload run.
+struct RecordThread
+{
+    Thread                   thread;
+    BenchContext             context;   // A copy of the shared context with this thread's own command buffer.
+    const Workload*          pWorkload;
+    const Options*           pOptions;
+    const std::atomic<bool>* pStart;    // Spun on so that all threads start recording together.
+    int64                    startTime;
+    int64                    endTime;
+    Result                   result;
+};
+
+// =====================================================================================================================
+// Thread entry point for multi-threaded runs: builds the workload's command buffer "repeats" times.
+void RecordThreadMain(
+    void* pParameter)
+{
+    RecordThread*const pState     = static_cast<RecordThread*>(pParameter);
+    BenchContext*const pContext   = &pState->context;
+    ICmdBuffer*const   pCmdBuffer = pContext->pCmdBuffer;
+    const Options&     options    = *pState->pOptions;
+    Result             result     = Result::Success;
+
+    while (pState->pStart->load(std::memory_order_acquire) == false)
+    {
+    }
+
+    pState->startTime = GetPerfCpuTime();
+
+    for (uint32 repeat = 0; (result == Result::Success) && (repeat < options.repeats); ++repeat)
+    {
+        result = pCmdBuffer->Reset(pContext->pCmdAllocator, true);
+
+        if (result == Result::Success)
+        {
+            CmdBufferBuildInfo buildInfo = {};
+            buildInfo.flags.optimizeOneTimeSubmit = 1;
+
+            result = pCmdBuffer->Begin(buildInfo);
+        }
+
+        if (result == Result::Success)
+        {
+            if (pState->pWorkload->pfnPrologue != nullptr)
+            {
+                pState->pWorkload->pfnPrologue(pContext, 0);
+            }
+
+            for (uint32 iteration = 0; iteration < options.iterations; ++iteration)
+            {
+                pState->pWorkload->pfnRecord(pContext, iteration);
+            }
+
+            result = pCmdBuffer->End();
+        }
+    }
+
+    pState->endTime = GetPerfCpuTime();
+    pState->result  = result;
+}
+
+// =====================================================================================================================
+// Records a workload on options.threads threads at once, each into its own command buffer from the shared allocator,
+// and reports the aggregate wall-clock time per call.  Returns false if command recording failed.
+bool RunWorkloadParallel(
+    BenchContext*   pContext,
+    const Workload& workload,
+    const Options&  options)
+{
+    const double      nsPerTick = 1.0e9 / static_cast<double>(GetPerfFrequency());
+    std::atomic<bool> start(false);
+    RecordThread      threads[MaxThreads];
+    uint32            threadCount = 0;
+    Result            result      = Result::Success;
+
+    for (; (result == Result::Success) && (threadCount < options.threads); ++threadCount)
+    {
+        RecordThread*const pState = &threads[threadCount];
+
+        pState->context            = *pContext;
+        pState->context.pCmdBuffer = pContext->pThreadCmdBuffers[threadCount];
+        pState->pWorkload          = &workload;
+        pState->pOptions           = &options;
+        pState->pStart             = &start;
+        pState->startTime          = 0;
+        pState->endTime            = 0;
+        pState->result             = Result::Success;
+
+        result = pState->thread.Begin(&RecordThreadMain, pState);
+    }
+
+    // Threads which did start must be released even if a later one failed to, so that they can be joined.
+    start.store(true, std::memory_order_release);
+
+    int64 firstStart = 0;
+    int64 lastEnd    = 0;
+
+    for (uint32 i = 0; i < threadCount; ++i)
+    {
+        if (threads[i].thread.IsCreated())
+        {
+            threads[i].thread.Join();
+
+            firstStart = ((i == 0) || (threads[i].startTime < firstStart)) ? threads[i].startTime : firstStart;
+            lastEnd    = Max(lastEnd, threads[i].endTime);
+
+            result = (result == Result::Success) ? threads[i].result : result;
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        const double calls     = static_cast<double>(options.threads) * options.repeats * options.iterations;
+        const double elapsedNs = static_cast<double>(lastEnd - firstStart) * nsPerTick;
+
+        printf("  %-40s %12.1f %16.1f\n",
+               workload.pName,
+               elapsedNs / calls,
+               (options.threads * options.repeats) / (elapsedNs * 1.0e-9));
+    }
+    else
+    {
+        printf("  %-40s failed (Result %d)\n", workload.pName, static_cast<int32>(result));
+    }
+
+    return (result == Result::Success);
+}
+
+// =====================================================================================================================
+// Loads a pipeline binary from disk.  A null path leaves the binary empty.
+Result LoadPipelineBinary(
+    const char*     pPath,
+    PipelineBinary* pBinary)
+{
+    Result result = Result::Success;
+
+    pBinary->pData = nullptr;
+    pBinary->size  = 0;
+
+    if (pPath != nullptr)
+    {
+        pBinary->size  = File::GetFileSize(pPath);
+        pBinary->pData = (pBinary->size > 0) ? malloc(pBinary->size) : nullptr;
+
+        if (pBinary->pData == nullptr)
+        {
+            result = Result::ErrorInvalidValue;
+            fprintf(stderr, "Unable to read pipeline binary %s\n", pPath);
+        }
+        else
+        {
+            result = File::ReadFile(pPath, pBinary->pData, pBinary->size);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Creates a platform and a finalized null device for the given GPU and runs every workload on it.  Returns false if
+// anything failed.
+bool RunOnNullGpu(
+    NullGpuId             nullGpuId,
+    const Options&        options,
+    const PipelineBinary& computeBinary,
+    const PipelineBinary& graphicsBinary)
+{
+    PlatformCreateInfo platformInfo = {};
+    platformInfo.pSettingsPath          = "/etc/amd";
+    platformInfo.flags.createNullDevice = 1;
+    platformInfo.flags.disableDevDriver = 1;
+    platformInfo.clientApiId            = ClientApi::Pal;
+    platformInfo.nullGpuId              = nullGpuId;
+
+    IPlatform* pPlatform       = nullptr;
+    void*      pPlatformMemory = malloc(GetPlatformSize());
+    Result     result          = (pPlatformMemory != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+
+    if (result == Result::Success)
+    {
+        result = CreatePlatform(platformInfo, pPlatformMemory, &pPlatform);
+    }
+
+    IDevice* pDevices[MaxDevices] = {};
+    uint32   deviceCount          = 0;
+
+    if (result == Result::Success)
+    {
+        result = pPlatform->EnumerateDevices(&deviceCount, pDevices);
+
+        if ((result == Result::Success) && (deviceCount == 0))
+        {
+            result = Result::ErrorUnavailable;
+        }
+    }
+
+    IDevice* pDevice = (result == Result::Success) ? pDevices[0] : nullptr;
+
+    if (result == Result::Success)
+    {
+        // Without the resource processing manager PAL doesn't need its internal shader binaries, which lets the
+        // benchmark run on PAL builds that don't have them.
+        pDevice->GetPublicSettings()->disableResourceProcessingManager = options.noRpm;
+
+        result = pDevice->CommitSettingsAndInit();
+    }
+
+    DeviceProperties props = {};
+
+    if (result == Result::Success)
+    {
+        result = pDevice->GetProperties(&props);
+    }
+
+    if (result == Result::Success)
+    {
+        // Command buffers are only recorded, never submitted, and the null device doesn't expose any engines.
+        const DeviceFinalizeInfo finalizeInfo = {};
+
+        result = pDevice->Finalize(finalizeInfo);
+    }
+
+    BenchContext context = {};
+    bool         success = false;
+
+    if (result == Result::Success)
+    {
+        result = InitContext(pDevice, computeBinary, graphicsBinary, options.threads, &context);
+    }
+
+    if (result == Result::Success)
+    {
+        if (options.threads > 1)
+        {
+            printf("%s (gfxLevel 0x%x), %u threads, %u iterations x %u command buffers per thread\n",
+                   props.gpuName,
+                   static_cast<uint32>(props.gfxLevel),
+                   options.threads,
+                   options.iterations,
+                   options.repeats);
+            printf("  %-40s %12s %16s\n", "Workload", "ns/call", "cmd buffers/s");
+        }
+        else
+        {
+            printf("%s (gfxLevel 0x%x), %u iterations, best of %u\n",
+                   props.gpuName,
+                   static_cast<uint32>(props.gfxLevel),
+                   options.iterations,
+                   options.repeats);
+            printf("  %-40s %12s %16s\n", "Workload", "ns/call", "PM4 bytes/call");
+        }
+
+        success = true;
+
+        for (const Workload& workload : Workloads)
+        {
+            if ((workload.needsComputePipeline  && (context.pComputePipelines[0]  == nullptr)) ||
+                (workload.needsGraphicsPipeline && (context.pGraphicsPipelines[0] == nullptr)))
+            {
+                printf("  %-40s skipped (no %s pipeline binary)\n",
+                       workload.pName,
+                       workload.needsComputePipeline ? "compute" : "graphics");
+            }
+            else if (workload.needsRpm && options.noRpm)
+            {
+                printf("  %-40s skipped (--no-rpm)\n", workload.pName);
+            }
+            else if (options.threads > 1)
+            {
+                success &= RunWorkloadParallel(&context, workload, options);
+            }
+            else
+            {
+                success &= RunWorkload(&context, workload, options);
+            }
+        }
+
+        if (options.threads <= 1)
+        {
+            printf("\n  %-40s %12s\n", "Descriptor", "ns/descriptor");
+
+            success &= RunBufferSrdBench(pDevice, props, options);
+        }
+
+        printf("\n");
+    }
+    else
+    {
+        fprintf(stderr, "Failed to set up null device %u (Result %d)\n",
+                static_cast<uint32>(nullGpuId), static_cast<int32>(result));
+    }
+
+    DestroyContext(&context);
+
+    if (pPlatform != nullptr)
+    {
+        pPlatform->Destroy();
+    }
+
+    free(pPlatformMemory);
+
+    return success;
+}
+
+// =====================================================================================================================
+// Null GPU names look like "NAVI21:gfx1030"; either the whole name or the part before the colon matches.
+bool NullGpuNameMatches(
+    const char* pName,
+    const char* pGpuName)
+{
+    char shortName[32] = {};
+
+    for (uint32 i = 0; (i + 1 < sizeof(shortName)) && (pGpuName[i] != '\0') && (pGpuName[i] != ':'); ++i)
+    {
+        shortName[i] = pGpuName[i];
+    }
+
+    return (Strcasecmp(pName, pGpuName) == 0) || (Strcasecmp(pName, shortName) == 0);
+}
+
+// =====================================================================================================================
+// Looks up a null GPU by name (case-insensitive).  Returns false if there is no such GPU.
+bool FindNullGpu(
+    const char* pName,
+    NullGpuId*  pNullGpuId)
+{
+    NullGpuInfo nullGpus[static_cast<uint32>(NullGpuId::Max)] = {};
+    uint32      nullGpuCount = static_cast<uint32>(NullGpuId::Max);
+    bool        found        = false;
+
+    if (EnumerateNullDevices(&nullGpuCount, nullGpus) == Result::Success)
+    {
+        for (uint32 i = 0; (found == false) && (i < nullGpuCount); ++i)
+        {
+            if ((nullGpus[i].pGpuName != nullptr) && NullGpuNameMatches(pName, nullGpus[i].pGpuName))
+            {
+                *pNullGpuId = nullGpus[i].nullGpuId;
+                found       = true;
+            }
+        }
+
+        if (found == false)
+        {
+            fprintf(stderr, "Unknown null GPU \"%s\". Available:", pName);
+
+            for (uint32 i = 0; i < nullGpuCount; ++i)
+            {
+                fprintf(stderr, " %s", (nullGpus[i].pGpuName != nullptr) ? nullGpus[i].pGpuName : "");
+            }
+
+            fprintf(stderr, "\n");
+        }
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Parses the command line.  Returns false on a malformed command line.
+bool ParseOptions(
+    int      argc,
+    char**   argv,
+    Options* pOptions)
+{
+    bool valid = true;
+
+    pOptions->iterations   = DefaultIterations;
+    pOptions->repeats      = DefaultRepeats;
+    pOptions->pGpuName     = nullptr;
+    pOptions->pComputeElf  = nullptr;
+    pOptions->pGraphicsElf = nullptr;
+    pOptions->threads      = 1;
+    pOptions->noRpm        = false;
+
+    for (int i = 1; valid && (i < argc); ++i)
+    {
+        const char* pArg   = argv[i];
+        const char* pValue = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (strcmp(pArg, "--no-rpm") == 0)
+        {
+            pOptions->noRpm = true;
+            continue;
+        }
+
+        // Every other option takes a value.
+        if (pValue == nullptr)
+        {
+            valid = false;
+        }
+        else if (strcmp(pArg, "--gpu") == 0)
+        {
+            pOptions->pGpuName = pValue;
+        }
+        else if (strcmp(pArg, "--iterations") == 0)
+        {
+            pOptions->iterations = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid                = (pOptions->iterations > 0);
+        }
+        else if (strcmp(pArg, "--repeats") == 0)
+        {
+            pOptions->repeats = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid             = (pOptions->repeats > 0);
+        }
+        else if (strcmp(pArg, "--compute-elf") == 0)
+        {
+            pOptions->pComputeElf = pValue;
+        }
+        else if (strcmp(pArg, "--graphics-elf") == 0)
+        {
+            pOptions->pGraphicsElf = pValue;
+        }
+        else if (strcmp(pArg, "--threads") == 0)
+        {
+            pOptions->threads = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid             = (pOptions->threads > 0) && (pOptions->threads <= MaxThreads);
+        }
+        else
+        {
+            valid = false;
+        }
+
+        ++i;
+    }
+
+    if (valid == false)
+    {
+        fprintf(stderr,
+                "Usage: %s [--gpu <null GPU name>] [--iterations <count>] [--repeats <count>]\n"
+                "          [--compute-elf <file>] [--graphics-elf <file>] [--threads <count>] [--no-rpm]\n",
+                argv[0]);
+    }
+
+    return valid;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int    argc,
+    char** argv)
+{
+    Options options = {};
+    bool    success = ParseOptions(argc, argv, &options);
+
+    PipelineBinary computeBinary  = {};
+    PipelineBinary graphicsBinary = {};
+
+    if (success)
+    {
+        success = (LoadPipelineBinary(options.pComputeElf, &computeBinary) == Result::Success) &&
+                  (LoadPipelineBinary(options.pGraphicsElf, &graphicsBinary) == Result::Success);
+    }
+
+    if (success)
+    {
+        if (options.pGpuName != nullptr)
+        {
+            NullGpuId nullGpuId = NullGpuId::Default;
+
+            success = FindNullGpu(options.pGpuName, &nullGpuId) &&
+                      RunOnNullGpu(nullGpuId, options, computeBinary, graphicsBinary);
+        }
+        else
+        {
+            // Pipeline binaries are GPU-specific, so the default GPU list only makes sense without them.
+            constexpr NullGpuId DefaultGpus[] =
+            {
+                NullGpuId::Navi21,
+#if PAL_BUILD_NAVI31
+                NullGpuId::Navi31,
+#endif
+            };
+
+            for (NullGpuId nullGpuId : DefaultGpus)
+            {
+                success &= RunOnNullGpu(nullGpuId, options, computeBinary, graphicsBinary);
+            }
+        }
+    }
+
+    free(computeBinary.pData);
+    free(graphicsBinary.pData);
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
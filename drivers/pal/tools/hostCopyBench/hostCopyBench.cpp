@@ -0,0 +1,924 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  hostCopyBench.cpp
+ * @brief Validation and benchmark of IImage::CopyMemoryToImage() and IImage::CopyImageToMemory() on PAL's null device.
+ *
+ * The null device backs GPU memory with system memory, so host image copies run exactly as they would on hardware
+ * apart from the memory type: mapped video memory is write-combined, while here it is ordinary cached memory.
+ *
+ * Validation creates images the way XGL does for VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT (needSwizzleEqs set, metadata
+ * disabled) across image types, tilings, element sizes, depth targets, block-compressed formats, mip chains and
+ * array/depth slices.  Every subresource is written from host memory, partially overwritten with a sub-rectangle, and
+ * read back; the data read back must match a host-side model of the image.  In builds with PAL_ENABLE_PRINTS_ASSERTS,
+ * PAL additionally checks every copied element against Addr2ComputeSurfaceAddrFromCoord() and fails the copy on any
+ * mismatch, which makes this a per-element cross-check of the CPU swizzling against AddrLib.
+ *
+ * The benchmark times full-image uploads and readbacks of a large 2D image, best of N, and reports the throughput
+ * next to a plain memcpy of the same number of bytes.
+ *
+ * Usage: palHostCopyBench [--gpu <null GPU name>] [--mode <validate|bench|all>] [--size <texels>]
+ *                         [--repeats <count>] [--threads <count>]
+ *
+ * Without --gpu, every GFX10+ null device that PAL was built with is validated and the first one is benchmarked.
+ ***********************************************************************************************************************
+ */
+
+#include "pal.h"
+#include "palDevice.h"
+#include "palFormatInfo.h"
+#include "palGpuMemory.h"
+#include "palImage.h"
+#include "palInlineFuncs.h"
+#include "palLib.h"
+#include "palPlatform.h"
+#include "palSysUtil.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Pal;
+using namespace Util;
+
+namespace
+{
+
+constexpr uint32 DefaultSize       = 2048;
+constexpr uint32 DefaultRepeats    = 5;
+constexpr uint32 DefaultThreads    = 4;
+constexpr uint32 ValidationThreads = 4;
+constexpr uint8  FillByte          = 0xA5;
+
+// Command line options.
+struct Options
+{
+    const char* pGpuName;
+    bool        validate;
+    bool        bench;
+    uint32      size;
+    uint32      repeats;
+    uint32      threads;
+};
+
+// One image layout to validate.  The image type follows from the extent: 1D if the height is one, 3D if the depth is
+// more than one, 2D otherwise.
+struct ValidationCase
+{
+    const char* pName;
+    ImageTiling tiling;
+    ChNumFormat format;
+    Extent3d    extent;
+    uint32      mipLevels;  // Zero means a full mip chain.
+    uint32      arraySize;
+    bool        depthTarget;
+};
+
+constexpr ValidationCase ValidationCases[] =
+{
+    { "1D linear R8",            ImageTiling::Linear,  ChNumFormat::X8_Unorm,           { 300,  1,  1 }, 1, 1, false },
+    { "1D linear RGBA32F array", ImageTiling::Linear,  ChNumFormat::X32Y32Z32W32_Float, { 129,  1,  1 }, 1, 3, false },
+    { "1D R8 mips",              ImageTiling::Optimal, ChNumFormat::X8_Unorm,           { 300,  1,  1 }, 0, 1, false },
+    { "1D RGBA32F mips array",   ImageTiling::Optimal, ChNumFormat::X32Y32Z32W32_Float, { 129,  1,  1 }, 0, 3, false },
+    { "2D linear RGBA8 mips",    ImageTiling::Linear,  ChNumFormat::X8Y8Z8W8_Unorm,     {  67, 45,  1 }, 3, 1, false },
+    { "2D R8 mips",              ImageTiling::Optimal, ChNumFormat::X8_Unorm,           {  67, 45,  1 }, 0, 1, false },
+    { "2D RG8 mips array",       ImageTiling::Optimal, ChNumFormat::X8Y8_Unorm,         {  67, 45,  1 }, 0, 3, false },
+    { "2D RGBA8 mips array",     ImageTiling::Optimal, ChNumFormat::X8Y8Z8W8_Unorm,     { 130, 70,  1 }, 0, 4, false },
+    { "2D RGBA16F mips",         ImageTiling::Optimal, ChNumFormat::X16Y16Z16W16_Float, {  67, 45,  1 }, 0, 1, false },
+    { "2D RGBA32F mips array",   ImageTiling::Optimal, ChNumFormat::X32Y32Z32W32_Float, {  67, 45,  1 }, 0, 2, false },
+    { "2D RGBA8 512x512",        ImageTiling::Optimal, ChNumFormat::X8Y8Z8W8_Unorm,     { 512, 512, 1 }, 1, 1, false },
+    { "2D D16 mips",             ImageTiling::Optimal, ChNumFormat::X16_Unorm,          {  67, 45,  1 }, 0, 1, true  },
+    { "2D D32 mips array",       ImageTiling::Optimal, ChNumFormat::X32_Float,          { 130, 70,  1 }, 0, 2, true  },
+    { "2D BC1 mips",             ImageTiling::Optimal, ChNumFormat::Bc1_Unorm,          { 130, 70,  1 }, 0, 2, false },
+    { "2D BC7 mips",             ImageTiling::Optimal, ChNumFormat::Bc7_Unorm,          { 130, 70,  1 }, 0, 1, false },
+    { "3D R8 mips",              ImageTiling::Optimal, ChNumFormat::X8_Unorm,           {  33, 17,  9 }, 0, 1, false },
+    { "3D RGBA8 mips",           ImageTiling::Optimal, ChNumFormat::X8Y8Z8W8_Unorm,     {  33, 17,  9 }, 0, 1, false },
+    { "3D RGBA16F",              ImageTiling::Optimal, ChNumFormat::X16Y16Z16W16_Float, {  64, 64, 16 }, 1, 1, false },
+    { "3D RGBA32F mips",         ImageTiling::Optimal, ChNumFormat::X32Y32Z32W32_Float, {  40, 24, 20 }, 0, 1, false },
+};
+
+// An image with its own bound GPU memory, and the CPU mapping of that memory.
+struct TestImage
+{
+    IImage*     pImage;
+    IGpuMemory* pGpuMemory;
+    void*       pMappedData;
+    gpusize     size;
+};
+
+// =====================================================================================================================
+template <typename Object>
+void DestroyObject(
+    Object** ppObject)
+{
+    if (*ppObject != nullptr)
+    {
+        // All objects are created in placement memory which starts at the object itself.
+        (*ppObject)->Destroy();
+        free(*ppObject);
+        *ppObject = nullptr;
+    }
+}
+
+// =====================================================================================================================
+void DestroyTestImage(
+    TestImage* pTestImage)
+{
+    if (pTestImage->pMappedData != nullptr)
+    {
+        pTestImage->pGpuMemory->Unmap();
+        pTestImage->pMappedData = nullptr;
+    }
+
+    DestroyObject(&pTestImage->pImage);
+    DestroyObject(&pTestImage->pGpuMemory);
+}
+
+// =====================================================================================================================
+// Creates an image the way XGL creates a VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT image, binds it to its own memory and
+// maps that memory.
+Result CreateTestImage(
+    IDevice*               pDevice,
+    const ImageCreateInfo& imageInfo,
+    TestImage*             pTestImage)
+{
+    memset(pTestImage, 0, sizeof(*pTestImage));
+
+    Result       result    = Result::Success;
+    const size_t imageSize = pDevice->GetImageSize(imageInfo, &result);
+    void*        pMemory   = (result == Result::Success) ? malloc(imageSize) : nullptr;
+
+    if (result == Result::Success)
+    {
+        result = (pMemory != nullptr) ? pDevice->CreateImage(imageInfo, pMemory, &pTestImage->pImage)
+                                      : Result::ErrorOutOfMemory;
+
+        if (result != Result::Success)
+        {
+            free(pMemory);
+            pTestImage->pImage = nullptr;
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        GpuMemoryRequirements memReqs = {};
+        pTestImage->pImage->GetGpuMemoryRequirements(&memReqs);
+
+        GpuMemoryCreateInfo memInfo = {};
+        memInfo.size      = memReqs.size;
+        memInfo.alignment = memReqs.alignment;
+        memInfo.vaRange   = VaRange::Default;
+        memInfo.priority  = GpuMemPriority::Normal;
+        memInfo.pImage    = pTestImage->pImage;
+
+        // Host transfers need CPU-visible memory, like a Vulkan image bound to HOST_VISIBLE | DEVICE_LOCAL memory.
+        memInfo.heapCount = 1;
+        memInfo.heaps[0]  = GpuHeapLocal;
+
+        const size_t memSize = pDevice->GetGpuMemorySize(memInfo, &result);
+        pMemory              = (result == Result::Success) ? malloc(memSize) : nullptr;
+
+        if (result == Result::Success)
+        {
+            result = (pMemory != nullptr) ? pDevice->CreateGpuMemory(memInfo, pMemory, &pTestImage->pGpuMemory)
+                                          : Result::ErrorOutOfMemory;
+
+            if (result != Result::Success)
+            {
+                free(pMemory);
+                pTestImage->pGpuMemory = nullptr;
+            }
+        }
+
+        pTestImage->size = memReqs.size;
+    }
+
+    if (result == Result::Success)
+    {
+        result = pTestImage->pImage->BindGpuMemory(pTestImage->pGpuMemory, 0);
+    }
+
+    if (result == Result::Success)
+    {
+        result = pTestImage->pGpuMemory->Map(&pTestImage->pMappedData);
+    }
+
+    if (result != Result::Success)
+    {
+        DestroyTestImage(pTestImage);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+ImageCreateInfo HostTransferImageInfo(
+    ImageType   imageType,
+    ImageTiling tiling,
+    ChNumFormat format,
+    Extent3d    extent,
+    uint32      mipLevels,
+    uint32      arraySize)
+{
+    ImageCreateInfo imageInfo = {};
+    imageInfo.imageType             = imageType;
+    imageInfo.swizzledFormat.format = format;
+    imageInfo.swizzledFormat.swizzle =
+        { ChannelSwizzle::X, ChannelSwizzle::Y, ChannelSwizzle::Z, ChannelSwizzle::W };
+    imageInfo.extent                = extent;
+    imageInfo.mipLevels             = mipLevels;
+    imageInfo.arraySize             = arraySize;
+    imageInfo.samples               = 1;
+    imageInfo.fragments             = 1;
+    imageInfo.tiling                = tiling;
+    imageInfo.usageFlags.shaderRead = 1;
+    imageInfo.metadataMode          = MetadataMode::Disabled;
+    imageInfo.flags.needSwizzleEqs  = 1;
+
+    return imageInfo;
+}
+
+// =====================================================================================================================
+// Fills one element with bytes derived from a per-element counter and a seed.
+void FillElement(
+    uint8* pElement,
+    uint32 elementBytes,
+    uint32 counter,
+    uint32 seed)
+{
+    for (uint32 byte = 0; byte < elementBytes; ++byte)
+    {
+        uint32 value = (counter * 0x9E3779B1u) ^ (seed * 0x85EBCA77u) ^ ((byte + 1) * 0xC2B2AE3Du);
+        value ^= (value >> 15);
+        value *= 0x2C1B3C6Du;
+        value ^= (value >> 12);
+
+        pElement[byte] = static_cast<uint8>(value >> ((byte & 3) * 8));
+    }
+}
+
+// The host-side model of one subresource range (one mip level across all of its array or depth slices).
+struct MipModel
+{
+    uint8*  pData;
+    uint32  width;     // In elements.
+    uint32  height;
+    uint32  depth;     // Array slices or depth slices.
+    uint32  texelsX;   // Size in texels, as passed to the copy.
+    uint32  texelsY;
+    gpusize rowPitch;  // Padded by a few elements so the host pitch differs from the packed one.
+    gpusize depthPitch;
+};
+
+// =====================================================================================================================
+// Copies a region of a model to or from the image and checks the result.
+Result CopyRegion(
+    IImage*         pImage,
+    const MipModel& model,
+    uint32          mip,
+    bool            is3d,
+    const Offset3d& offset,    // In texels; z is the first slice.
+    const Extent3d& extent,    // In texels; depth is the number of slices.
+    Extent3d        blockDim,
+    uint32          elementBytes,
+    uint8*          pHost,
+    bool            toImage)
+{
+    HostImageCopyRegion region = {};
+    region.imageSubres    = { 0, mip, is3d ? 0 : static_cast<uint32>(offset.z) };
+    region.imageOffset    = { offset.x, offset.y, is3d ? offset.z : 0 };
+    region.imageExtent    = { extent.width, extent.height, is3d ? extent.depth : 1 };
+    region.numSlices      = is3d ? 1 : extent.depth;
+    region.hostRowPitch   = model.rowPitch;
+    region.hostDepthPitch = model.depthPitch;
+    region.pHostMemory    = pHost + (offset.z * model.depthPitch) +
+                            ((offset.y / blockDim.height) * model.rowPitch) +
+                            ((offset.x / blockDim.width) * elementBytes);
+
+    return toImage ? pImage->CopyMemoryToImage(1, &region, ValidationThreads)
+                   : pImage->CopyImageToMemory(1, &region, ValidationThreads);
+}
+
+// =====================================================================================================================
+// Validates one image layout.  Returns false if anything failed.
+bool ValidateCase(
+    IDevice*              pDevice,
+    const ValidationCase& testCase,
+    uint32                caseIndex)
+{
+    const bool      isCompressed = Formats::IsBlockCompressed(testCase.format);
+    const Extent3d  blockDim     = isCompressed ? Formats::CompressedBlockDim(testCase.format) : Extent3d{ 1, 1, 1 };
+    const uint32    elementBytes = Formats::BytesPerPixel(testCase.format);
+    const ImageType imageType    = (testCase.extent.height == 1) ? ImageType::Tex1d :
+                                   (testCase.extent.depth  >  1) ? ImageType::Tex3d : ImageType::Tex2d;
+    const bool      is3d         = (imageType == ImageType::Tex3d);
+    const uint32    maxDim       = Max(testCase.extent.width, testCase.extent.height, testCase.extent.depth);
+    const uint32    mipLevels    = (testCase.mipLevels != 0) ? testCase.mipLevels : (Log2(maxDim) + 1);
+
+    ImageCreateInfo imageInfo = HostTransferImageInfo(imageType,
+                                                      testCase.tiling,
+                                                      testCase.format,
+                                                      testCase.extent,
+                                                      mipLevels,
+                                                      testCase.arraySize);
+
+    // Depth targets get depth swizzle modes, which use their own equations.
+    imageInfo.usageFlags.depthStencil = testCase.depthTarget;
+
+    TestImage image  = {};
+    Result    result = CreateTestImage(pDevice, imageInfo, &image);
+    uint64    checkedElements = 0;
+
+    if (result == Result::Success)
+    {
+        // Anything the copies don't write must keep this pattern; it also makes stale reads easy to spot.
+        memset(image.pMappedData, FillByte, static_cast<size_t>(image.size));
+    }
+
+    for (uint32 mip = 0; (result == Result::Success) && (mip < mipLevels); ++mip)
+    {
+        MipModel model = {};
+        model.texelsX    = Max(testCase.extent.width  >> mip, 1u);
+        model.texelsY    = Max(testCase.extent.height >> mip, 1u);
+        model.width      = RoundUpQuotient(model.texelsX, blockDim.width);
+        model.height     = RoundUpQuotient(model.texelsY, blockDim.height);
+        model.depth      = is3d ? Max(testCase.extent.depth >> mip, 1u) : testCase.arraySize;
+        model.rowPitch   = (model.width + 3) * elementBytes;
+        model.depthPitch = model.rowPitch * model.height;
+
+        const size_t modelBytes = static_cast<size_t>(model.depthPitch * model.depth);
+
+        model.pData        = static_cast<uint8*>(malloc(modelBytes));
+        uint8* pReadBack   = static_cast<uint8*>(malloc(modelBytes));
+        uint8* pUpdate     = static_cast<uint8*>(malloc(modelBytes));
+
+        result = ((model.pData != nullptr) && (pReadBack != nullptr) && (pUpdate != nullptr))
+                 ? Result::Success : Result::ErrorOutOfMemory;
+
+        if (result == Result::Success)
+        {
+            uint32 counter = 0;
+
+            for (uint32 z = 0; z < model.depth; ++z)
+            {
+                for (uint32 y = 0; y < model.height; ++y)
+                {
+                    for (uint32 x = 0; x < model.width; ++x)
+                    {
+                        const size_t offset = static_cast<size_t>((z * model.depthPitch) + (y * model.rowPitch)) +
+                                              (x * elementBytes);
+
+                        FillElement(model.pData + offset, elementBytes, counter, caseIndex * 64 + mip);
+                        FillElement(pUpdate + offset, elementBytes, counter++, caseIndex * 64 + mip + 32);
+                    }
+                }
+            }
+
+            // Write the whole mip level.
+            const Extent3d fullExtent = { model.texelsX, model.texelsY, model.depth };
+            result = CopyRegion(image.pImage, model, mip, is3d, { 0, 0, 0 }, fullExtent, blockDim, elementBytes,
+                                model.pData, true);
+        }
+
+        if (result == Result::Success)
+        {
+            // Overwrite a block-aligned sub-rectangle that doesn't touch the origin, in the middle slices.
+            const uint32 x0 = (model.width  / 3) * blockDim.width;
+            const uint32 y0 = (model.height / 4) * blockDim.height;
+            const uint32 z0 = model.depth / 3;
+
+            const Extent3d subExtent =
+            {
+                Max(model.texelsX - x0 - (model.texelsX - x0) / 3, 1u),
+                Max(model.texelsY - y0 - (model.texelsY - y0) / 5, 1u),
+                Max(model.depth - z0 - ((model.depth - z0) / 2), 1u),
+            };
+
+            const Offset3d subOffset = { static_cast<int32>(x0), static_cast<int32>(y0), static_cast<int32>(z0) };
+
+            result = CopyRegion(image.pImage, model, mip, is3d, subOffset, subExtent, blockDim, elementBytes,
+                                pUpdate, true);
+
+            // Apply the same update to the model.
+            const uint32 subWidth  = RoundUpQuotient(subExtent.width,  blockDim.width);
+            const uint32 subHeight = RoundUpQuotient(subExtent.height, blockDim.height);
+
+            for (uint32 z = z0; z < (z0 + subExtent.depth); ++z)
+            {
+                for (uint32 y = (y0 / blockDim.height); y < ((y0 / blockDim.height) + subHeight); ++y)
+                {
+                    const size_t offset = static_cast<size_t>((z * model.depthPitch) + (y * model.rowPitch)) +
+                                          ((x0 / blockDim.width) * elementBytes);
+
+                    memcpy(model.pData + offset, pUpdate + offset, subWidth * elementBytes);
+                }
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            // Read the whole mip level back and compare the elements, but not the host pitch padding.
+            memset(pReadBack, 0, modelBytes);
+
+            const Extent3d fullExtent = { model.texelsX, model.texelsY, model.depth };
+            result = CopyRegion(image.pImage, model, mip, is3d, { 0, 0, 0 }, fullExtent, blockDim, elementBytes,
+                                pReadBack, false);
+
+            for (uint32 z = 0; (result == Result::Success) && (z < model.depth); ++z)
+            {
+                for (uint32 y = 0; (result == Result::Success) && (y < model.height); ++y)
+                {
+                    const size_t offset = static_cast<size_t>((z * model.depthPitch) + (y * model.rowPitch));
+
+                    if (memcmp(model.pData + offset, pReadBack + offset, model.width * elementBytes) != 0)
+                    {
+                        fprintf(stderr, "    mip %u slice %u row %u read back differently\n", mip, z, y);
+                        result = Result::ErrorUnknown;
+                    }
+                }
+            }
+
+            checkedElements += uint64(model.width) * model.height * model.depth;
+        }
+
+        free(model.pData);
+        free(pReadBack);
+        free(pUpdate);
+    }
+
+    printf("  %-28s %8s %2u mips %10llu elements  %s",
+           testCase.pName,
+           (testCase.tiling == ImageTiling::Linear) ? "linear" : "optimal",
+           mipLevels,
+           static_cast<unsigned long long>(checkedElements),
+           (result == Result::Success) ? "ok\n" : "FAILED");
+
+    if (result != Result::Success)
+    {
+        printf(" (Result %d)\n", static_cast<int32>(result));
+    }
+
+    DestroyTestImage(&image);
+
+    return (result == Result::Success);
+}
+
+// =====================================================================================================================
+// Runs every validation case on one device.  Returns false if anything failed.
+bool RunValidation(
+    IDevice*                pDevice,
+    const DeviceProperties& props)
+{
+#if PAL_ENABLE_PRINTS_ASSERTS
+    const char* pAddrLibCheck = "on";
+#else
+    const char* pAddrLibCheck = "off (needs PAL_ENABLE_PRINTS_ASSERTS)";
+#endif
+
+    printf("%s (gfxLevel 0x%x): validation, AddrLib per-element check %s\n",
+           props.gpuName,
+           static_cast<uint32>(props.gfxLevel),
+           pAddrLibCheck);
+
+    bool success = (props.imageProperties.flags.supportsHostImageCopy != 0);
+
+    if (success == false)
+    {
+        printf("  device doesn't report supportsHostImageCopy\n");
+    }
+
+    for (uint32 i = 0; success && (i < ArrayLen32(ValidationCases)); ++i)
+    {
+        success &= ValidateCase(pDevice, ValidationCases[i], i);
+    }
+
+    printf("\n");
+
+    return success;
+}
+
+// =====================================================================================================================
+// Times full-image copies in one direction at one thread count and prints the best-of-N throughput.
+bool BenchCopy(
+    IImage*        pImage,
+    const Options& options,
+    const char*    pName,
+    uint32         elementBytes,
+    uint8*         pHost,
+    uint32         threads,
+    bool           toImage)
+{
+    const double nsPerTick = 1.0e9 / static_cast<double>(GetPerfFrequency());
+    const double bytes     = static_cast<double>(options.size) * options.size * elementBytes;
+
+    HostImageCopyRegion region = {};
+    region.imageExtent    = { options.size, options.size, 1 };
+    region.numSlices      = 1;
+    region.pHostMemory    = pHost;
+    region.hostRowPitch   = gpusize(options.size) * elementBytes;
+    region.hostDepthPitch = region.hostRowPitch * options.size;
+
+    Result result = Result::Success;
+    double bestNs = 0.0;
+
+    for (uint32 repeat = 0; (result == Result::Success) && (repeat < options.repeats); ++repeat)
+    {
+        const int64 start = GetPerfCpuTime();
+
+        result = toImage ? pImage->CopyMemoryToImage(1, &region, threads)
+                         : pImage->CopyImageToMemory(1, &region, threads);
+
+        const double elapsedNs = static_cast<double>(GetPerfCpuTime() - start) * nsPerTick;
+        bestNs = ((repeat == 0) || (elapsedNs < bestNs)) ? elapsedNs : bestNs;
+    }
+
+    if (result == Result::Success)
+    {
+        printf("  %-28s %-6s %7u %12.2f %12.0f\n",
+               pName, toImage ? "upload" : "read", threads, bestNs * 1.0e-6, bytes / (bestNs * 1.0e-9) / 1.0e6);
+    }
+    else
+    {
+        printf("  %-28s %-6s %7u failed (Result %d)\n", pName, toImage ? "upload" : "read", threads,
+               static_cast<int32>(result));
+    }
+
+    return (result == Result::Success);
+}
+
+// =====================================================================================================================
+// Benchmarks uploads and readbacks of large 2D images on one device.  Returns false if anything failed.
+bool RunBench(
+    IDevice*                pDevice,
+    const DeviceProperties& props,
+    const Options&          options)
+{
+    struct BenchImage
+    {
+        const char* pName;
+        ImageTiling tiling;
+        ChNumFormat format;
+    };
+
+    constexpr BenchImage BenchImages[] =
+    {
+        { "2D RGBA8 optimal",   ImageTiling::Optimal, ChNumFormat::X8Y8Z8W8_Unorm     },
+        { "2D RGBA32F optimal", ImageTiling::Optimal, ChNumFormat::X32Y32Z32W32_Float },
+        { "2D R8 optimal",      ImageTiling::Optimal, ChNumFormat::X8_Unorm           },
+        { "2D RGBA8 linear",    ImageTiling::Linear,  ChNumFormat::X8Y8Z8W8_Unorm     },
+    };
+
+    printf("%s (gfxLevel 0x%x): %ux%u images, best of %u\n",
+           props.gpuName, static_cast<uint32>(props.gfxLevel), options.size, options.size, options.repeats);
+    printf("  %-28s %-6s %7s %12s %12s\n", "Image", "Dir", "Threads", "ms", "MB/s");
+
+    bool success = true;
+
+    for (const BenchImage& benchImage : BenchImages)
+    {
+        const uint32 elementBytes = Formats::BytesPerPixel(benchImage.format);
+        const size_t hostBytes    = size_t(options.size) * options.size * elementBytes;
+
+        TestImage image = {};
+        Result    result = CreateTestImage(pDevice,
+                                           HostTransferImageInfo(ImageType::Tex2d,
+                                                                 benchImage.tiling,
+                                                                 benchImage.format,
+                                                                 { options.size, options.size, 1 },
+                                                                 1,
+                                                                 1),
+                                           &image);
+        uint8*    pHost  = static_cast<uint8*>(malloc(hostBytes));
+
+        if ((result == Result::Success) && (pHost != nullptr))
+        {
+            memset(pHost, 0x3C, hostBytes);
+
+            for (uint32 threads = 1; threads <= options.threads; threads *= 2)
+            {
+                success &= BenchCopy(image.pImage, options, benchImage.pName, elementBytes, pHost, threads, true);
+                success &= BenchCopy(image.pImage, options, benchImage.pName, elementBytes, pHost, threads, false);
+            }
+        }
+        else
+        {
+            printf("  %-28s failed to create (Result %d)\n", benchImage.pName, static_cast<int32>(result));
+            success = false;
+        }
+
+        free(pHost);
+        DestroyTestImage(&image);
+    }
+
+    // Reference: a plain memcpy of the same number of bytes as the RGBA8 image.
+    const size_t bytes = size_t(options.size) * options.size * 4;
+    uint8*       pSrc  = static_cast<uint8*>(malloc(bytes));
+    uint8*       pDst  = static_cast<uint8*>(malloc(bytes));
+
+    if ((pSrc != nullptr) && (pDst != nullptr))
+    {
+        const double nsPerTick = 1.0e9 / static_cast<double>(GetPerfFrequency());
+        double       bestNs    = 0.0;
+
+        memset(pSrc, 0x3C, bytes);
+        memset(pDst, 0, bytes);
+
+        for (uint32 repeat = 0; repeat < options.repeats; ++repeat)
+        {
+            const int64 start = GetPerfCpuTime();
+            memcpy(pDst, pSrc, bytes);
+            const double elapsedNs = static_cast<double>(GetPerfCpuTime() - start) * nsPerTick;
+            bestNs = ((repeat == 0) || (elapsedNs < bestNs)) ? elapsedNs : bestNs;
+        }
+
+        printf("  %-28s %-6s %7u %12.2f %12.0f\n",
+               "memcpy (RGBA8 size)", "-", 1u, bestNs * 1.0e-6, double(bytes) / (bestNs * 1.0e-9) / 1.0e6);
+    }
+
+    free(pSrc);
+    free(pDst);
+
+    printf("\n");
+
+    return success;
+}
+
+// =====================================================================================================================
+// Creates a platform and a finalized null device for the given GPU and runs the requested modes on it.  Returns false
+// if anything failed.
+bool RunOnNullGpu(
+    NullGpuId      nullGpuId,
+    const Options& options,
+    bool           validate,
+    bool           bench)
+{
+    PlatformCreateInfo platformInfo = {};
+    platformInfo.pSettingsPath          = "/etc/amd";
+    platformInfo.flags.createNullDevice = 1;
+    platformInfo.flags.disableDevDriver = 1;
+    platformInfo.clientApiId            = ClientApi::Pal;
+    platformInfo.nullGpuId              = nullGpuId;
+
+    IPlatform* pPlatform       = nullptr;
+    void*      pPlatformMemory = malloc(GetPlatformSize());
+    Result     result          = (pPlatformMemory != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+
+    if (result == Result::Success)
+    {
+        result = CreatePlatform(platformInfo, pPlatformMemory, &pPlatform);
+    }
+
+    IDevice* pDevices[MaxDevices] = {};
+    uint32   deviceCount          = 0;
+
+    if (result == Result::Success)
+    {
+        result = pPlatform->EnumerateDevices(&deviceCount, pDevices);
+
+        if ((result == Result::Success) && (deviceCount == 0))
+        {
+            result = Result::ErrorUnavailable;
+        }
+    }
+
+    IDevice* pDevice = (result == Result::Success) ? pDevices[0] : nullptr;
+
+    if (result == Result::Success)
+    {
+        // Host copies never use the GPU, so skip creating the internal blit pipelines.
+        pDevice->GetPublicSettings()->disableResourceProcessingManager = true;
+
+        result = pDevice->CommitSettingsAndInit();
+    }
+
+    DeviceProperties props = {};
+
+    if (result == Result::Success)
+    {
+        result = pDevice->GetProperties(&props);
+    }
+
+    if (result == Result::Success)
+    {
+        // Host copies don't need a queue, and the null device doesn't expose any engines.
+        DeviceFinalizeInfo finalizeInfo = {};
+        result = pDevice->Finalize(finalizeInfo);
+    }
+
+    bool success = (result == Result::Success);
+
+    if (success)
+    {
+        if (validate)
+        {
+            success &= RunValidation(pDevice, props);
+        }
+
+        if (bench)
+        {
+            success &= RunBench(pDevice, props, options);
+        }
+    }
+    else
+    {
+        fprintf(stderr, "Failed to set up null device %u (Result %d)\n",
+                static_cast<uint32>(nullGpuId), static_cast<int32>(result));
+    }
+
+    if (pPlatform != nullptr)
+    {
+        pPlatform->Destroy();
+    }
+
+    free(pPlatformMemory);
+
+    return success;
+}
+
+// =====================================================================================================================
+// Null GPU names look like "NAVI21:gfx1030"; either the whole name or the part before the colon matches.
+bool NullGpuNameMatches(
+    const char* pName,
+    const char* pGpuName)
+{
+    char shortName[32] = {};
+
+    for (uint32 i = 0; (i + 1 < sizeof(shortName)) && (pGpuName[i] != '\0') && (pGpuName[i] != ':'); ++i)
+    {
+        shortName[i] = pGpuName[i];
+    }
+
+    return (Strcasecmp(pName, pGpuName) == 0) || (Strcasecmp(pName, shortName) == 0);
+}
+
+// =====================================================================================================================
+// Looks up a null GPU by name (case-insensitive).  Returns false if there is no such GPU.
+bool FindNullGpu(
+    const char* pName,
+    NullGpuId*  pNullGpuId)
+{
+    NullGpuInfo nullGpus[static_cast<uint32>(NullGpuId::Max)] = {};
+    uint32      nullGpuCount = static_cast<uint32>(NullGpuId::Max);
+    bool        found        = false;
+
+    if (EnumerateNullDevices(&nullGpuCount, nullGpus) == Result::Success)
+    {
+        for (uint32 i = 0; (found == false) && (i < nullGpuCount); ++i)
+        {
+            if ((nullGpus[i].pGpuName != nullptr) && NullGpuNameMatches(pName, nullGpus[i].pGpuName))
+            {
+                *pNullGpuId = nullGpus[i].nullGpuId;
+                found       = true;
+            }
+        }
+
+        if (found == false)
+        {
+            fprintf(stderr, "Unknown null GPU \"%s\". Available:", pName);
+
+            for (uint32 i = 0; i < nullGpuCount; ++i)
+            {
+                fprintf(stderr, " %s", (nullGpus[i].pGpuName != nullptr) ? nullGpus[i].pGpuName : "");
+            }
+
+            fprintf(stderr, "\n");
+        }
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Parses the command line.  Returns false on a malformed command line.
+bool ParseOptions(
+    int      argc,
+    char**   argv,
+    Options* pOptions)
+{
+    bool valid = true;
+
+    pOptions->pGpuName = nullptr;
+    pOptions->validate = true;
+    pOptions->bench    = true;
+    pOptions->size     = DefaultSize;
+    pOptions->repeats  = DefaultRepeats;
+    pOptions->threads  = DefaultThreads;
+
+    for (int i = 1; valid && (i < argc); ++i)
+    {
+        const char* pArg   = argv[i];
+        const char* pValue = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        // Every option takes a value.
+        if (pValue == nullptr)
+        {
+            valid = false;
+        }
+        else if (strcmp(pArg, "--gpu") == 0)
+        {
+            pOptions->pGpuName = pValue;
+        }
+        else if (strcmp(pArg, "--mode") == 0)
+        {
+            pOptions->validate = (strcmp(pValue, "validate") == 0) || (strcmp(pValue, "all") == 0);
+            pOptions->bench    = (strcmp(pValue, "bench") == 0)    || (strcmp(pValue, "all") == 0);
+            valid              = pOptions->validate || pOptions->bench;
+        }
+        else if (strcmp(pArg, "--size") == 0)
+        {
+            pOptions->size = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid          = (pOptions->size > 0) && (pOptions->size <= 16384);
+        }
+        else if (strcmp(pArg, "--repeats") == 0)
+        {
+            pOptions->repeats = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid             = (pOptions->repeats > 0);
+        }
+        else if (strcmp(pArg, "--threads") == 0)
+        {
+            pOptions->threads = static_cast<uint32>(strtoul(pValue, nullptr, 0));
+            valid             = (pOptions->threads > 0);
+        }
+        else
+        {
+            valid = false;
+        }
+
+        ++i;
+    }
+
+    if (valid == false)
+    {
+        fprintf(stderr,
+                "Usage: %s [--gpu <null GPU name>] [--mode <validate|bench|all>] [--size <texels>]\n"
+                "          [--repeats <count>] [--threads <count>]\n",
+                argv[0]);
+    }
+
+    return valid;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int    argc,
+    char** argv)
+{
+    Options options = {};
+    bool    success = ParseOptions(argc, argv, &options);
+
+    if (success)
+    {
+        if (options.pGpuName != nullptr)
+        {
+            NullGpuId nullGpuId = NullGpuId::Default;
+
+            success = FindNullGpu(options.pGpuName, &nullGpuId) &&
+                      RunOnNullGpu(nullGpuId, options, options.validate, options.bench);
+        }
+        else
+        {
+            // Navi10 and Navi21 cover GFX10 without and with RB+, which select different swizzle patterns.
+            constexpr NullGpuId DefaultGpus[] =
+            {
+                NullGpuId::Navi10,
+                NullGpuId::Navi21,
+#if PAL_BUILD_NAVI31
+                NullGpuId::Navi31,
+#endif
+            };
+
+            for (uint32 i = 0; i < ArrayLen32(DefaultGpus); ++i)
+            {
+                success &= RunOnNullGpu(DefaultGpus[i], options, options.validate, options.bench && (i == 0));
+            }
+        }
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,273 @@
+##
+ #######################################################################################################################
+ #
+ #  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ #
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #
+ #  The above copyright notice and this permission notice shall be included in all
+ #  copies or substantial portions of the Software.
+ #
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ #  SOFTWARE.
+ #
+ #######################################################################################################################
+
+#!/usr/bin/python3
+
+# Converts the binary logs written by the PAL InterfaceLogger's "BinaryFormat" mode back into the JSON text the layer
+# writes by default. The output is byte-for-byte identical to what the JSON backend would have produced, except that
+# "LogFile" entries name the converted .json companion logs.
+#
+# Usage: binaryLogToJson.py <log directory or .bin files...>
+#
+# The token encoding is documented in src/core/layers/interfaceLogger/interfaceLoggerBinaryLog.h.
+
+import glob
+import math
+import os
+import re
+import struct
+import sys
+
+BinaryLogMagic   = b"PALILOG\0"
+BinaryLogVersion = 1
+
+# BinaryLogToken values.
+BeginList       = 0x00
+BeginInlineList = 0x01
+EndList         = 0x02
+BeginMap        = 0x03
+BeginInlineMap  = 0x04
+EndMap          = 0x05
+Key             = 0x06
+KeyDefine       = 0x07
+KeyRef          = 0x08
+String          = 0x09
+StringDefine    = 0x0A
+StringRef       = 0x0B
+Uint            = 0x0C
+Int             = 0x0D
+Float           = 0x0E
+FalseValue      = 0x0F
+TrueValue       = 0x10
+Null            = 0x11
+Hex8            = 0x12
+Hex16           = 0x13
+Hex32           = 0x14
+Hex64           = 0x15
+
+HexDigits = { Hex8: 2, Hex16: 4, Hex32: 8, Hex64: 16 }
+
+ThreadLogName = re.compile(r"^pal_calls_thread_\d+\.bin$")
+
+# A Python copy of Util::JsonWriter (src/util/jsonWriter.cpp) which must produce exactly the same whitespace.
+class JsonWriter:
+    TokenNone, TokenLBrace, TokenRBrace, TokenLBracket, TokenRBracket, TokenComma, TokenKey, TokenValue = range(8)
+
+    ScopeOutside = 0x1
+    ScopeList    = 0x2
+    ScopeMap     = 0x4
+    ScopeInline  = 0x8
+
+    IndentSize = 2
+
+    SpaceOne  = 1
+    SpaceLine = 2
+
+    SpaceTable = [
+        [ 0, 0,         0,         0,         0,         0, 0,         0         ],
+        [ 0, 0,         0,         SpaceLine, 0,         0, SpaceLine, 0         ],
+        [ 0, 0,         SpaceLine, 0,         SpaceLine, 0, 0,         0         ],
+        [ 0, SpaceLine, 0,         SpaceLine, 0,         0, 0,         SpaceLine ],
+        [ 0, 0,         SpaceLine, 0,         SpaceLine, 0, 0,         0         ],
+        [ 0, SpaceLine, 0,         SpaceLine, 0,         0, SpaceLine, SpaceLine ],
+        [ 0, SpaceOne,  0,         SpaceOne,  0,         0, 0,         SpaceOne  ],
+        [ 0, 0,         SpaceLine, 0,         SpaceLine, 0, 0,         0         ],
+    ]
+
+    def __init__(self, out):
+        self.out       = out
+        self.prevToken = self.TokenNone
+        self.scopes    = [ self.ScopeOutside ]
+
+    def BeginList(self, isInline):
+        self.MaybeNextListEntry()
+        self.TransitionToToken(self.TokenLBracket, False)
+        self.out.append("[")
+        self.scopes.append((self.ScopeList | self.ScopeInline) if isInline else self.ScopeList)
+
+    def EndList(self):
+        self.TransitionToToken(self.TokenRBracket, True)
+        self.out.append("]")
+        self.scopes.pop()
+
+    def BeginMap(self, isInline):
+        self.MaybeNextListEntry()
+        self.TransitionToToken(self.TokenLBrace, False)
+        self.out.append("{")
+        self.scopes.append((self.ScopeMap | self.ScopeInline) if isInline else self.ScopeMap)
+
+    def EndMap(self):
+        self.TransitionToToken(self.TokenRBrace, True)
+        self.out.append("}")
+        self.scopes.pop()
+
+    def Key(self, key):
+        if (self.scopes[-1] & self.ScopeMap) and (self.prevToken != self.TokenLBrace):
+            self.TransitionToToken(self.TokenComma, False)
+            self.out.append(",")
+        self.TransitionToToken(self.TokenKey, False)
+        self.out.append('"' + key + '":')
+
+    def RawValue(self, text):
+        self.MaybeNextListEntry()
+        self.TransitionToToken(self.TokenValue, False)
+        self.out.append(text)
+
+    def MaybeNextListEntry(self):
+        if (self.scopes[-1] & self.ScopeList) and (self.prevToken != self.TokenLBracket):
+            self.TransitionToToken(self.TokenComma, False)
+            self.out.append(",")
+
+    def TransitionToToken(self, nextToken, leavingScope):
+        spacing = self.SpaceTable[self.prevToken][nextToken]
+        if (spacing == self.SpaceOne) or ((spacing == self.SpaceLine) and (self.scopes[-1] & self.ScopeInline)):
+            self.out.append(" ")
+        elif spacing == self.SpaceLine:
+            curScope = len(self.scopes) - 1
+            self.out.append("\n" + " " * ((curScope - 1 if leavingScope else curScope) * self.IndentSize))
+        self.prevToken = nextToken
+
+class BinaryLogReader:
+    def __init__(self, data):
+        self.data = data
+        self.pos  = 0
+
+    def Done(self):
+        return self.pos >= len(self.data)
+
+    def Byte(self):
+        value = self.data[self.pos]
+        self.pos += 1
+        return value
+
+    def Varint(self):
+        value = 0
+        shift = 0
+        while True:
+            byte   = self.Byte()
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if byte < 0x80:
+                return value
+
+    def String(self):
+        length = self.Varint()
+        value  = self.data[self.pos:self.pos + length].decode("utf-8", errors="surrogateescape")
+        self.pos += length
+        return value
+
+def ConvertLog(data):
+    if data[:len(BinaryLogMagic)] != BinaryLogMagic:
+        raise ValueError("not a PAL InterfaceLogger binary log")
+    (version,) = struct.unpack_from("<I", data, len(BinaryLogMagic))
+    if version != BinaryLogVersion:
+        raise ValueError("unsupported binary log version %u" % version)
+
+    reader  = BinaryLogReader(data)
+    reader.pos = len(BinaryLogMagic) + 4
+    out     = []
+    writer  = JsonWriter(out)
+    strings = []
+    lastKey = None
+
+    while reader.Done() == False:
+        token = reader.Byte()
+        if token == BeginList or token == BeginInlineList:
+            writer.BeginList(token == BeginInlineList)
+        elif token == EndList:
+            writer.EndList()
+        elif token == BeginMap or token == BeginInlineMap:
+            writer.BeginMap(token == BeginInlineMap)
+        elif token == EndMap:
+            writer.EndMap()
+        elif token in (Key, KeyDefine, KeyRef):
+            if token == KeyRef:
+                lastKey = strings[reader.Varint()]
+            else:
+                lastKey = reader.String()
+                if token == KeyDefine:
+                    strings.append(lastKey)
+            writer.Key(lastKey)
+        elif token in (String, StringDefine, StringRef):
+            if token == StringRef:
+                value = strings[reader.Varint()]
+            else:
+                value = reader.String()
+                if token == StringDefine:
+                    strings.append(value)
+            # The companion logs are converted too so point the main log at the converted versions.
+            if (writer.prevToken == JsonWriter.TokenKey) and (lastKey == "name") and ThreadLogName.match(value):
+                value = value[:-len(".bin")] + ".json"
+            writer.RawValue('"' + value + '"')
+        elif token == Uint:
+            writer.RawValue("%u" % reader.Varint())
+        elif token == Int:
+            value = reader.Varint()
+            writer.RawValue("%d" % ((value >> 1) ^ -(value & 1)))
+        elif token == Float:
+            (value,) = struct.unpack_from("<f", data, reader.pos)
+            reader.pos += 4
+            # printf keeps the sign of a NaN but Python doesn't.
+            if math.isnan(value):
+                writer.RawValue("-nan" if math.copysign(1.0, value) < 0 else "nan")
+            else:
+                writer.RawValue("%g" % value)
+        elif token == FalseValue:
+            writer.RawValue("false")
+        elif token == TrueValue:
+            writer.RawValue("true")
+        elif token == Null:
+            writer.RawValue("null")
+        elif token in HexDigits:
+            writer.RawValue('"0x%0*x"' % (HexDigits[token], reader.Varint()))
+        else:
+            raise ValueError("unknown token 0x%02x at offset %u" % (token, reader.pos - 1))
+
+    return "".join(out)
+
+def main(args):
+    if len(args) < 1:
+        print("Usage: binaryLogToJson.py <log directory or .bin files...>")
+        return 1
+
+    paths = []
+    for arg in args:
+        if os.path.isdir(arg):
+            paths += sorted(glob.glob(os.path.join(arg, "*.bin")))
+        else:
+            paths.append(arg)
+
+    for path in paths:
+        with open(path, "rb") as binFile:
+            text = ConvertLog(binFile.read())
+        jsonPath = os.path.splitext(path)[0] + ".json"
+        with open(jsonPath, "w", newline="\n", encoding="utf-8", errors="surrogateescape") as jsonFile:
+            jsonFile.write(text)
+        print("%s -> %s" % (path, jsonPath))
+
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -40,6 +40,11 @@ macro(xgl_set_compile_definitions)
         target_compile_definitions(xgl PRIVATE ICD_MEMTRACK)
     endif()
 
+    # Serve the default allocation callbacks from the slab allocator if enabled.
+    if(ICD_SLAB_ALLOCATOR)
+        target_compile_definitions(xgl PRIVATE ICD_SLAB_ALLOCATOR)
+    endif()
+
     # Enable relevant GPUOpen preprocessor definitions
     if(ICD_GPUOPEN_DEVMODE_BUILD)
         target_compile_definitions(xgl PRIVATE ICD_GPUOPEN_DEVMODE_BUILD)
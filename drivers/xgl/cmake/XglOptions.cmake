@@ -69,6 +69,10 @@ macro(xgl_options)
 
     option(XGL_BUILD_CACHE_CREATOR "Build cache-creator tools?" OFF)
 
+    option(XGL_BUILD_SLAB_ALLOC_BENCH "Build the slab allocator benchmark?" OFF)
+
+    option(XGL_BUILD_DEFER_COMPILE_BENCH "Build the deferred compile thread pool benchmark?" OFF)
+
 #if VKI_RAY_TRACING
     option(VKI_RAY_TRACING "Build vulkan with RAY_TRACING" ON)
 #endif
@@ -90,6 +94,8 @@ macro(xgl_options)
 
     option(ICD_MEMTRACK "Turn on memory tracking?" ${CMAKE_BUILD_TYPE_DEBUG})
 
+    option(ICD_SLAB_ALLOCATOR "Serve the default allocation callbacks from the slab allocator?" OFF)
+
     if(UNIX AND (NOT ANDROID))
         option(BUILD_WAYLAND_SUPPORT "Build XGL with Wayland support" ON)
 
@@ -38,6 +38,9 @@
 
 #include "palDbgPrint.h"
 #include "palFile.h"
+#include "palVectorImpl.h"
+
+#include <algorithm>
 
 #if ICD_RUNTIME_APP_PROFILE
 #include "utils/json_reader.h"
@@ -46,13 +49,163 @@
 namespace vk
 {
 
+// =====================================================================================================================
+// Orders index entries by stage, then code hash, then entry index.
+static bool HashedEntryLess(
+    const PipelineProfileIndex::HashedEntry& lhs,
+    const PipelineProfileIndex::HashedEntry& rhs)
+{
+    bool less;
+
+    if (lhs.stage != rhs.stage)
+    {
+        less = (lhs.stage < rhs.stage);
+    }
+    else if (lhs.codeHash.upper != rhs.codeHash.upper)
+    {
+        less = (lhs.codeHash.upper < rhs.codeHash.upper);
+    }
+    else if (lhs.codeHash.lower != rhs.codeHash.lower)
+    {
+        less = (lhs.codeHash.lower < rhs.codeHash.lower);
+    }
+    else
+    {
+        less = (lhs.entryIdx < rhs.entryIdx);
+    }
+
+    return less;
+}
+
+// =====================================================================================================================
+// Returns the stages a profile entry is keyed by in a PipelineProfileIndex, or zero if the entry does not require any
+// code hash and must be kept in the fallback list.  A regular entry can only match a pipeline containing every one of
+// its hash-matched stages, so keying it by the first of them is enough.  A shader-only entry can also match through
+// whichever shader is being targeted, so it is additionally keyed by every stage the pattern carries a code hash for.
+static uint32_t GetIndexedStages(
+    const PipelineProfilePattern& pattern)
+{
+    uint32_t hashStages = 0;
+    uint32_t keyStages  = 0;
+
+    for (uint32_t stage = 0; (pattern.match.always == 0) && (stage < ShaderStageCount); ++stage)
+    {
+        if (pattern.shaders[stage].match.codeHash != 0)
+        {
+            hashStages |= (1u << stage);
+        }
+
+        if (Pal::ShaderHashIsNonzero(pattern.shaders[stage].codeHash))
+        {
+            keyStages |= (1u << stage);
+        }
+    }
+
+    // Keep only the lowest hash-matched stage.
+    hashStages &= (~hashStages + 1);
+
+    return ((hashStages != 0) && (pattern.match.shaderOnly != 0)) ? (hashStages | keyStages) : hashStages;
+}
+
+// =====================================================================================================================
+// Walks, in profile order, the entries of a profile which may match the given pipeline.  The candidates are gathered
+// from the profile's index; every entry is visited if the index is unavailable or cannot be trusted for this key (a
+// shader with a zero code hash could match entries which never required a hash).  Visiting a superset of the matching
+// entries is always safe because callers still test each entry with GetFirstMatchingShader().
+class ProfileEntryIterator
+{
+public:
+    ProfileEntryIterator(
+        const PipelineProfile&      profile,
+        const PipelineProfileIndex& index,
+        const PipelineOptimizerKey& pipelineKey,
+        PalAllocator*               pAllocator);
+
+    bool     IsValid() const { return (m_pos < m_count); }
+    uint32_t Get() const     { return m_useCandidates ? m_candidates.At(m_pos) : m_pos; }
+    void     Next()          { ++m_pos; }
+
+private:
+    Util::Vector<uint32_t, 32, PalAllocator> m_candidates;
+    bool                                     m_useCandidates;
+    uint32_t                                 m_pos;
+    uint32_t                                 m_count;
+};
+
+// =====================================================================================================================
+ProfileEntryIterator::ProfileEntryIterator(
+    const PipelineProfile&      profile,
+    const PipelineProfileIndex& index,
+    const PipelineOptimizerKey& pipelineKey,
+    PalAllocator*               pAllocator)
+    :
+    m_candidates(pAllocator),
+    m_useCandidates(index.pMemory != nullptr),
+    m_pos(0),
+    m_count(profile.entryCount)
+{
+    for (uint32_t shaderIdx = 0; m_useCandidates && (shaderIdx < pipelineKey.shaderCount); ++shaderIdx)
+    {
+        m_useCandidates = Pal::ShaderHashIsNonzero(pipelineKey.pShaders[shaderIdx].codeHash);
+    }
+
+    Pal::Result result = Pal::Result::Success;
+
+    for (uint32_t i = 0; m_useCandidates && (result == Pal::Result::Success) && (i < index.fallbackEntryCount); ++i)
+    {
+        result = m_candidates.PushBack(index.pFallbackEntries[i]);
+    }
+
+    const PipelineProfileIndex::HashedEntry* pBegin = index.pHashedEntries;
+    const PipelineProfileIndex::HashedEntry* pEnd   = index.pHashedEntries + index.hashedEntryCount;
+
+    for (uint32_t shaderIdx = 0;
+         m_useCandidates && (result == Pal::Result::Success) && (shaderIdx < pipelineKey.shaderCount);
+         ++shaderIdx)
+    {
+        PipelineProfileIndex::HashedEntry key = {};
+        key.codeHash = pipelineKey.pShaders[shaderIdx].codeHash;
+        key.stage    = static_cast<uint32_t>(pipelineKey.pShaders[shaderIdx].stage);
+
+        for (const PipelineProfileIndex::HashedEntry* pEntry = std::lower_bound(pBegin, pEnd, key, HashedEntryLess);
+             (pEntry != pEnd) && (result == Pal::Result::Success) && (pEntry->stage == key.stage) &&
+             Pal::ShaderHashesEqual(pEntry->codeHash, key.codeHash);
+             ++pEntry)
+        {
+            result = m_candidates.PushBack(pEntry->entryIdx);
+        }
+    }
+
+    if (m_useCandidates && (result == Pal::Result::Success))
+    {
+        // Entries must be visited in profile order (later entries override earlier ones), and an entry keyed by several
+        // stages may have been gathered more than once.
+        uint32_t* pCandidates = m_candidates.Data();
+
+        std::sort(pCandidates, pCandidates + m_candidates.NumElements());
+
+        m_count = static_cast<uint32_t>(
+            std::unique(pCandidates, pCandidates + m_candidates.NumElements()) - pCandidates);
+    }
+    else
+    {
+        m_useCandidates = false;
+        m_count         = profile.entryCount;
+    }
+}
+
 // =====================================================================================================================
 ShaderOptimizer::ShaderOptimizer(
     Device*         pDevice,
     PhysicalDevice* pPhysicalDevice)
     :
     m_pDevice(pDevice),
-    m_settings(pPhysicalDevice->GetRuntimeSettings())
+    m_settings(pPhysicalDevice->GetRuntimeSettings()),
+    m_tuningProfileIndex(),
+    m_appProfileIndex()
+#if ICD_RUNTIME_APP_PROFILE
+    , m_runtimeProfileIndex()
+#endif
 {
 }
 
@@ -71,6 +224,126 @@ void ShaderOptimizer::Init()
 #if ICD_RUNTIME_APP_PROFILE
     BuildRuntimeProfile();
 #endif
+
+    BuildProfileIndex(m_appProfile, &m_appProfileIndex);
+    BuildProfileIndex(m_tuningProfile, &m_tuningProfileIndex);
+#if ICD_RUNTIME_APP_PROFILE
+    BuildProfileIndex(m_runtimeProfile, &m_runtimeProfileIndex);
+#endif
+}
+
+// =====================================================================================================================
+// Builds the lookup index of a profile.  Must be called again if the profile's entries change.
+void ShaderOptimizer::BuildProfileIndex(
+    const PipelineProfile& profile,
+    PipelineProfileIndex*  pIndex)
+{
+    DestroyProfileIndex(pIndex);
+
+    uint32_t hashedEntryCount   = 0;
+    uint32_t fallbackEntryCount = 0;
+
+    for (uint32_t entryIdx = 0; entryIdx < profile.entryCount; ++entryIdx)
+    {
+        const uint32_t stages = GetIndexedStages(profile.pEntries[entryIdx].pattern);
+
+        if (stages != 0)
+        {
+            hashedEntryCount += Util::CountSetBits(stages);
+        }
+        else
+        {
+            fallbackEntryCount++;
+        }
+    }
+
+    const size_t hashedSize = hashedEntryCount * sizeof(PipelineProfileIndex::HashedEntry);
+    const size_t totalSize  = hashedSize + (fallbackEntryCount * sizeof(uint32_t));
+
+    if (totalSize > 0)
+    {
+        const VkAllocationCallbacks* pAllocCB = m_pDevice->VkInstance()->GetAllocCallbacks();
+
+        pIndex->pMemory = pAllocCB->pfnAllocation(pAllocCB->pUserData,
+                                                  totalSize,
+                                                  VK_DEFAULT_MEM_ALIGN,
+                                                  VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+    }
+
+    // If the allocation failed the index stays empty and lookups fall back to testing every entry.
+    if (pIndex->pMemory != nullptr)
+    {
+        pIndex->pHashedEntries   = static_cast<PipelineProfileIndex::HashedEntry*>(pIndex->pMemory);
+        pIndex->pFallbackEntries = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pIndex->pMemory) + hashedSize);
+
+        for (uint32_t entryIdx = 0; entryIdx < profile.entryCount; ++entryIdx)
+        {
+            const PipelineProfilePattern& pattern = profile.pEntries[entryIdx].pattern;
+
+            uint32_t stages = GetIndexedStages(pattern);
+            uint32_t stage  = 0;
+
+            if (stages == 0)
+            {
+                pIndex->pFallbackEntries[pIndex->fallbackEntryCount++] = entryIdx;
+            }
+
+            while (Util::BitMaskScanForward(&stage, stages))
+            {
+                PipelineProfileIndex::HashedEntry* pEntry = &pIndex->pHashedEntries[pIndex->hashedEntryCount++];
+
+                pEntry->codeHash = pattern.shaders[stage].codeHash;
+                pEntry->stage    = stage;
+                pEntry->entryIdx = entryIdx;
+
+                stages &= ~(1u << stage);
+            }
+        }
+
+        PAL_ASSERT(pIndex->hashedEntryCount == hashedEntryCount);
+        PAL_ASSERT(pIndex->fallbackEntryCount == fallbackEntryCount);
+
+        std::sort(pIndex->pHashedEntries, pIndex->pHashedEntries + pIndex->hashedEntryCount, HashedEntryLess);
+    }
+}
+
+// =====================================================================================================================
+void ShaderOptimizer::DestroyProfileIndex(
+    PipelineProfileIndex* pIndex)
+{
+    if (pIndex->pMemory != nullptr)
+    {
+        const VkAllocationCallbacks* pAllocCB = m_pDevice->VkInstance()->GetAllocCallbacks();
+
+        pAllocCB->pfnFree(pAllocCB->pUserData, pIndex->pMemory);
+    }
+
+    memset(pIndex, 0, sizeof(*pIndex));
+}
+
+// =====================================================================================================================
+const PipelineProfileIndex& ShaderOptimizer::GetProfileIndex(
+    const PipelineProfile& profile
+    ) const
+{
+    const PipelineProfileIndex* pIndex = &m_appProfileIndex;
+
+    if (&profile == &m_tuningProfile)
+    {
+        pIndex = &m_tuningProfileIndex;
+    }
+#if ICD_RUNTIME_APP_PROFILE
+    else if (&profile == &m_runtimeProfile)
+    {
+        pIndex = &m_runtimeProfileIndex;
+    }
+#endif
+    else
+    {
+        PAL_ASSERT(&profile == &m_appProfile);
+    }
+
+    return *pIndex;
 }
 
 // =====================================================================================================================
@@ -108,8 +381,12 @@ bool ShaderOptimizer::HasMatchingProfileEntry(
 {
     bool foundMatch = false;
 
-    for (uint32_t entryIdx = 0; entryIdx < profile.entryCount; ++entryIdx)
+    for (ProfileEntryIterator it(profile, GetProfileIndex(profile), pipelineKey, m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entryIdx = it.Get();
+
         const auto& pattern = profile.pEntries[entryIdx].pattern;
 
         if ((GetFirstMatchingShader(pattern, InvalidShaderIndex, pipelineKey) != InvalidShaderIndex))
@@ -151,8 +428,12 @@ void ShaderOptimizer::CalculateMatchingProfileEntriesHash(
     Util::MetroHash128*         pHasher
     ) const
 {
-    for (uint32_t entryIdx = 0; entryIdx < profile.entryCount; ++entryIdx)
+    for (ProfileEntryIterator it(profile, GetProfileIndex(profile), pipelineKey, m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entryIdx = it.Get();
+
         const auto& pattern = profile.pEntries[entryIdx].pattern;
 
         for (uint32_t shaderIdx = 0; shaderIdx < pipelineKey.shaderCount; ++shaderIdx)
@@ -203,8 +484,12 @@ void ShaderOptimizer::ApplyProfileToShaderCreateInfo(
     PipelineShaderOptionsPtr         options
     ) const
 {
-    for (uint32_t entry = 0; entry < profile.entryCount; ++entry)
+    for (ProfileEntryIterator it(profile, GetProfileIndex(profile), pipelineKey, m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entry = it.Get();
+
         const PipelineProfileEntry& profileEntry = profile.pEntries[entry];
 
         if (GetFirstMatchingShader(profileEntry.pattern, shaderIndex, pipelineKey) != InvalidShaderIndex)
@@ -395,8 +680,15 @@ Vkgc::ThreadGroupSwizzleMode ShaderOptimizer::OverrideThreadGroupSwizzleMode(
 {
     Vkgc::ThreadGroupSwizzleMode swizzleMode = Vkgc::ThreadGroupSwizzleMode::Default;
 
-    for (uint32_t entry = 0; entry < m_appProfile.entryCount; ++entry)
+    for (ProfileEntryIterator it(m_appProfile,
+                                 GetProfileIndex(m_appProfile),
+                                 pipelineKey,
+                                 m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entry = it.Get();
+
         const PipelineProfileEntry& profileEntry = m_appProfile.pEntries[entry];
 
         if (GetFirstMatchingShader(profileEntry.pattern, InvalidShaderIndex, pipelineKey) != InvalidShaderIndex)
@@ -410,8 +702,15 @@ Vkgc::ThreadGroupSwizzleMode ShaderOptimizer::OverrideThreadGroupSwizzleMode(
         }
     }
 
-    for (uint32_t entry = 0; entry < m_tuningProfile.entryCount; ++entry)
+    for (ProfileEntryIterator it(m_tuningProfile,
+                                 GetProfileIndex(m_tuningProfile),
+                                 pipelineKey,
+                                 m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entry = it.Get();
+
         const PipelineProfileEntry& profileEntry = m_tuningProfile.pEntries[entry];
 
         if (GetFirstMatchingShader(profileEntry.pattern, InvalidShaderIndex, pipelineKey) != InvalidShaderIndex)
@@ -436,8 +735,15 @@ bool ShaderOptimizer::OverrideThreadIdSwizzleMode(
 {
     bool swizzleMode = false;
 
-    for (uint32_t entry = 0; entry < m_appProfile.entryCount; ++entry)
+    for (ProfileEntryIterator it(m_appProfile,
+                                 GetProfileIndex(m_appProfile),
+                                 pipelineKey,
+                                 m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entry = it.Get();
+
         const PipelineProfileEntry& profileEntry = m_appProfile.pEntries[entry];
 
         if (GetFirstMatchingShader(profileEntry.pattern, InvalidShaderIndex, pipelineKey) != InvalidShaderIndex)
@@ -448,8 +754,15 @@ bool ShaderOptimizer::OverrideThreadIdSwizzleMode(
         }
     }
 
-    for (uint32_t entry = 0; entry < m_tuningProfile.entryCount; ++entry)
+    for (ProfileEntryIterator it(m_tuningProfile,
+                                 GetProfileIndex(m_tuningProfile),
+                                 pipelineKey,
+                                 m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entry = it.Get();
+
         const PipelineProfileEntry& profileEntry = m_tuningProfile.pEntries[entry];
 
         if (GetFirstMatchingShader(profileEntry.pattern, InvalidShaderIndex, pipelineKey) != InvalidShaderIndex)
@@ -475,8 +788,15 @@ void ShaderOptimizer::OverrideShaderThreadGroupSize(
     uint32_t*                   pThreadGroupSizeZ
     ) const
 {
-    for (uint32_t entry = 0; entry < m_appProfile.entryCount; ++entry)
+    for (ProfileEntryIterator it(m_appProfile,
+                                 GetProfileIndex(m_appProfile),
+                                 pipelineKey,
+                                 m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entry = it.Get();
+
         const PipelineProfileEntry& profileEntry = m_appProfile.pEntries[entry];
 
         if (GetFirstMatchingShader(profileEntry.pattern, InvalidShaderIndex, pipelineKey) != InvalidShaderIndex)
@@ -492,8 +812,15 @@ void ShaderOptimizer::OverrideShaderThreadGroupSize(
         }
     }
 
-    for (uint32_t entry = 0; entry < m_tuningProfile.entryCount; ++entry)
+    for (ProfileEntryIterator it(m_tuningProfile,
+                                 GetProfileIndex(m_tuningProfile),
+                                 pipelineKey,
+                                 m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entry = it.Get();
+
         const PipelineProfileEntry& profileEntry = m_tuningProfile.pEntries[entry];
 
         if (GetFirstMatchingShader(profileEntry.pattern, InvalidShaderIndex, pipelineKey) != InvalidShaderIndex)
@@ -546,6 +873,12 @@ void ShaderOptimizer::OverrideComputePipelineCreateInfo(
 // =====================================================================================================================
 ShaderOptimizer::~ShaderOptimizer()
 {
+    DestroyProfileIndex(&m_appProfileIndex);
+    DestroyProfileIndex(&m_tuningProfileIndex);
+#if ICD_RUNTIME_APP_PROFILE
+    DestroyProfileIndex(&m_runtimeProfileIndex);
+#endif
+
     const VkAllocationCallbacks* pAllocCB = m_pDevice->VkInstance()->GetAllocCallbacks();
 
     if (m_appProfile.pEntries != nullptr)
@@ -601,8 +934,12 @@ void ShaderOptimizer::ApplyProfileToGraphicsPipelineCreateInfo(
 {
     uint32_t vkgcStages = VkToVkgcShaderStageMask(shaderStages);
 
-    for (uint32_t entry = 0; entry < profile.entryCount; ++entry)
+    for (ProfileEntryIterator it(profile, GetProfileIndex(profile), pipelineKey, m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entry = it.Get();
+
         const auto& profileEntry     = profile.pEntries[entry];
         uint32_t    firstShaderMatch = GetFirstMatchingShader(profileEntry.pattern, InvalidShaderIndex, pipelineKey);
 
@@ -678,8 +1015,12 @@ void ShaderOptimizer::ApplyProfileToComputePipelineCreateInfo(
     const PipelineOptimizerKey&      pipelineKey,
     Pal::DynamicComputeShaderInfo*   pDynamicComputeShaderInfo) const
 {
-    for (uint32_t entry = 0; entry < profile.entryCount; ++entry)
+    for (ProfileEntryIterator it(profile, GetProfileIndex(profile), pipelineKey, m_pDevice->VkInstance()->Allocator());
+         it.IsValid();
+         it.Next())
     {
+        const uint32_t entry = it.Get();
+
         const auto& profileEntry     = profile.pEntries[entry];
         uint32_t    firstShaderMatch = GetFirstMatchingShader(profileEntry.pattern, InvalidShaderIndex, pipelineKey);
 
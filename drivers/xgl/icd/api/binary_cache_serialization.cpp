@@ -57,8 +57,13 @@
 #include "include/binary_cache_serialization.h"
 
 #include "palAssert.h"
+#include "palAutoBuffer.h"
+#include "palCacheLayer.h"
+#include "palHashSetImpl.h"
 #include "palInlineFuncs.h"
+#include "palMutex.h"
 #include "palPlatformKey.h"
+#include "palVectorImpl.h"
 
 #include <cstdlib>
 #include <cstring>
@@ -230,4 +235,558 @@ Util::Result PipelineBinaryCacheSerializer::Finalize(
                                               pPrivateHeader->hashId);
 }
 
+// =====================================================================================================================
+// The serialized blob and the changes to the memory layer recorded since it was last brought up to date.
+class IncrementalCacheSerializer::State
+{
+public:
+    State(
+        const Util::IndirectAllocator& allocator,
+        const Util::IPlatformKey*      pPlatformKey);
+    ~State();
+
+    Util::Result Init();
+
+    void OnMemoryCacheEvent(
+        Util::MemoryCacheEvent event,
+        const Util::Hash128&   hashId);
+
+    Util::Result Update(
+        Util::ICacheLayer* pMemoryLayer,
+        Util::ICacheLayer* pLoadLayer);
+
+    size_t GetBlobSize() const { return HeaderSize + m_dataSize; }
+
+    Util::Result Write(
+        void*   pBlob,
+        size_t* pSize) const;
+
+    void Reset();
+
+private:
+    PAL_DISALLOW_COPY_AND_ASSIGN(State);
+
+    static constexpr size_t HeaderSize      = sizeof(PipelineBinaryCachePrivateHeader);
+    static constexpr size_t EntryHeaderSize = sizeof(BinaryCacheEntry);
+
+    using IdSet    = Util::HashSet<Util::Hash128, Util::IndirectAllocator, Util::JenkinsHashFunc>;
+    using IdVector = Util::Vector<Util::Hash128, 16, Util::IndirectAllocator>;
+
+    Util::Result Rebuild(
+        Util::ICacheLayer* pMemoryLayer,
+        Util::ICacheLayer* pLoadLayer);
+
+    Util::Result AppendEntry(
+        Util::ICacheLayer*   pLoadLayer,
+        const Util::Hash128& hashId);
+
+    Util::Result ReserveData(
+        size_t dataSize);
+
+    Util::Result FinishHash(
+        const Util::IHashContext* pContext,
+        const void*               pData,
+        size_t                    dataSize,
+        uint8_t*                  pHashId) const;
+
+    mutable Util::IndirectAllocator m_allocator;
+    const Util::IPlatformKey*       m_pPlatformKey;
+
+    Util::Mutex                     m_addedIdsMutex;  // Protects m_addedIds and m_trackAdds
+    IdVector                        m_addedIds;       // Entries added since the last Update()
+    bool                            m_trackAdds;      // Adds only need to be recorded while there is a blob
+    volatile uint32_t               m_generation;     // Bumped whenever an entry is removed from the memory layer
+
+    uint32_t                        m_blobGeneration; // m_generation when the blob was built
+    IdSet                           m_blobIds;        // Entries in the blob
+    void*                           m_pData;          // Entries in the pipeline binary cache format, without the header
+    size_t                          m_dataSize;
+    size_t                          m_dataCapacity;
+    Util::IHashContext*             m_pHash;          // Hash of m_pData so far, nullptr while there is no blob
+};
+
+// =====================================================================================================================
+IncrementalCacheSerializer::State::State(
+    const Util::IndirectAllocator& allocator,
+    const Util::IPlatformKey*      pPlatformKey)
+    :
+    m_allocator      { allocator },
+    m_pPlatformKey   { pPlatformKey },
+    m_addedIds       { &m_allocator },
+    m_trackAdds      { false },
+    m_generation     { 0 },
+    m_blobGeneration { 0 },
+    m_blobIds        { 64, &m_allocator },
+    m_pData          { nullptr },
+    m_dataSize       { 0 },
+    m_dataCapacity   { 0 },
+    m_pHash          { nullptr }
+{
+    PAL_ASSERT(pPlatformKey != nullptr);
+}
+
+// =====================================================================================================================
+IncrementalCacheSerializer::State::~State()
+{
+    Reset();
+}
+
+// =====================================================================================================================
+Util::Result IncrementalCacheSerializer::State::Init()
+{
+    return m_blobIds.Init();
+}
+
+// =====================================================================================================================
+// Called by the memory layer, with one of its locks held, whenever its contents change.
+void IncrementalCacheSerializer::State::OnMemoryCacheEvent(
+    Util::MemoryCacheEvent event,
+    const Util::Hash128&   hashId)
+{
+    if (event == Util::MemoryCacheEvent::EntryAdded)
+    {
+        Util::MutexAuto lock(&m_addedIdsMutex);
+
+        if (m_trackAdds && (m_addedIds.PushBack(hashId) != Util::Result::Success))
+        {
+            // The blob would silently miss the entry; have it rebuilt instead.
+            Util::AtomicIncrement(&m_generation);
+        }
+    }
+    else if (event == Util::MemoryCacheEvent::EntryRemoved)
+    {
+        Util::AtomicIncrement(&m_generation);
+    }
+
+    // A replaced entry keeps its place in the blob. Entries are only replaced by the compressing layer swapping in the
+    // compressed copy of the same binary, and the blob holds the decoded binaries.
+}
+
+// =====================================================================================================================
+// Appends the entries added since the last call, or rebuilds the blob from scratch if there is none yet or entries
+// were removed since it was built.
+Util::Result IncrementalCacheSerializer::State::Update(
+    Util::ICacheLayer* pMemoryLayer,
+    Util::ICacheLayer* pLoadLayer)
+{
+    Util::Result result = Util::Result::Success;
+
+    if ((m_pHash != nullptr) && (m_blobGeneration != m_generation))
+    {
+        Reset();
+    }
+
+    if (m_pHash != nullptr)
+    {
+        IdVector addedIds(&m_allocator);
+
+        {
+            Util::MutexAuto lock(&m_addedIdsMutex);
+
+            result = addedIds.Reserve(m_addedIds.NumElements());
+
+            for (uint32_t i = 0; (result == Util::Result::Success) && (i < m_addedIds.NumElements()); i++)
+            {
+                result = addedIds.PushBack(m_addedIds.At(i));
+            }
+
+            m_addedIds.Clear();
+        }
+
+        for (uint32_t i = 0; (result == Util::Result::Success) && (i < addedIds.NumElements()); i++)
+        {
+            result = AppendEntry(pLoadLayer, addedIds.At(i));
+        }
+
+        if (result != Util::Result::Success)
+        {
+            Reset();
+            result = Util::Result::Success;
+        }
+    }
+
+    if (m_pHash == nullptr)
+    {
+        result = Rebuild(pMemoryLayer, pLoadLayer);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Builds the blob from every entry in the memory layer.
+Util::Result IncrementalCacheSerializer::State::Rebuild(
+    Util::ICacheLayer* pMemoryLayer,
+    Util::ICacheLayer* pLoadLayer)
+{
+    PAL_ASSERT(m_pHash == nullptr);
+
+    // Start recording adds and removals before listing the entries, so that nothing that changes while the blob is
+    // built goes unnoticed. Entries that are both listed and recorded are only appended once.
+    {
+        Util::MutexAuto lock(&m_addedIdsMutex);
+
+        m_trackAdds = true;
+        m_addedIds.Clear();
+    }
+
+    m_blobGeneration = m_generation;
+
+    const Util::IHashContext* pKeyContext = m_pPlatformKey->GetKeyContext();
+    void*                     pContextMem = PAL_MALLOC(pKeyContext->GetDuplicateObjectSize(),
+                                                       &m_allocator,
+                                                       Util::AllocInternal);
+    Util::Result              result      = Util::Result::ErrorOutOfMemory;
+
+    if (pContextMem != nullptr)
+    {
+        result = pKeyContext->Duplicate(pContextMem, &m_pHash);
+
+        if (result != Util::Result::Success)
+        {
+            PAL_FREE(pContextMem, &m_allocator);
+            m_pHash = nullptr;
+        }
+    }
+
+    size_t curCount    = 0;
+    size_t curDataSize = 0;
+
+    if (result == Util::Result::Success)
+    {
+        result = Util::GetMemoryCacheLayerCurSize(pMemoryLayer, &curCount, &curDataSize);
+    }
+
+    if ((result == Util::Result::Success) && (curCount > 0))
+    {
+        Util::AutoBuffer<Util::Hash128, 8, Util::IndirectAllocator> hashIds(curCount, &m_allocator);
+
+        result = (hashIds.Capacity() >= curCount) ? Util::Result::Success : Util::Result::ErrorOutOfMemory;
+
+        if (result == Util::Result::Success)
+        {
+            result = Util::GetMemoryCacheLayerHashIds(pMemoryLayer, curCount, &hashIds[0]);
+        }
+
+        if (result == Util::Result::Success)
+        {
+            // Stored entries may be compressed, so this is only a first guess at the size.
+            result = ReserveData(curDataSize + (curCount * EntryHeaderSize));
+        }
+
+        for (uint32_t i = 0; (result == Util::Result::Success) && (i < curCount); i++)
+        {
+            result = AppendEntry(pLoadLayer, hashIds[i]);
+        }
+    }
+
+    if (result != Util::Result::Success)
+    {
+        Reset();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Loads one entry into the blob and adds it to the running hash. Entries that are already in the blob, have no data
+// yet or are no longer in the cache are skipped; a reserved entry is reported as added once its data is stored.
+Util::Result IncrementalCacheSerializer::State::AppendEntry(
+    Util::ICacheLayer*   pLoadLayer,
+    const Util::Hash128& hashId)
+{
+    Util::Result result = Util::Result::Success;
+
+    if (m_blobIds.Contains(hashId) == false)
+    {
+        Util::QueryResult query = {};
+
+        result = pLoadLayer->Query(&hashId, 0, 0, &query);
+
+        if ((result == Util::Result::Success) && (query.dataSize > 0))
+        {
+            const size_t entrySize = EntryHeaderSize + query.dataSize;
+
+            result = ReserveData(entrySize);
+
+            if (result == Util::Result::Success)
+            {
+                void* pEntryMem = Util::VoidPtrInc(m_pData, m_dataSize);
+
+                if (pLoadLayer->Load(&query, Util::VoidPtrInc(pEntryMem, EntryHeaderSize)) == Util::Result::Success)
+                {
+                    const BinaryCacheEntry entry = { hashId, query.dataSize };
+
+                    memcpy(pEntryMem, &entry, EntryHeaderSize);
+
+                    result = m_pHash->AddData(pEntryMem, entrySize);
+
+                    if (result == Util::Result::Success)
+                    {
+                        m_dataSize += entrySize;
+                        result      = m_blobIds.Insert(hashId);
+                    }
+                }
+                else
+                {
+                    // The entry was evicted, or swapped for its compressed copy, since the query. Only the eviction is
+                    // reported as a removal, so have the blob rebuilt either way.
+                    Util::AtomicIncrement(&m_generation);
+                }
+            }
+        }
+        else if ((result == Util::Result::NotReady) || (result == Util::Result::NotFound))
+        {
+            result = Util::Result::Success;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Makes room for at least dataSize more bytes in the blob.
+Util::Result IncrementalCacheSerializer::State::ReserveData(
+    size_t dataSize)
+{
+    Util::Result result = Util::Result::Success;
+
+    if ((m_dataSize + dataSize) > m_dataCapacity)
+    {
+        const size_t newCapacity = Util::Max(m_dataSize + dataSize, m_dataCapacity * 2);
+        void*        pNewData    = PAL_MALLOC(newCapacity, &m_allocator, Util::AllocInternal);
+
+        if (pNewData != nullptr)
+        {
+            if (m_dataSize > 0)
+            {
+                memcpy(pNewData, m_pData, m_dataSize);
+            }
+
+            PAL_FREE(m_pData, &m_allocator);
+
+            m_pData        = pNewData;
+            m_dataCapacity = newCapacity;
+        }
+        else
+        {
+            result = Util::Result::ErrorOutOfMemory;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Finishes a copy of the given hash context after adding pData to it, leaving the context itself untouched.
+Util::Result IncrementalCacheSerializer::State::FinishHash(
+    const Util::IHashContext* pContext,
+    const void*               pData,
+    size_t                    dataSize,
+    uint8_t*                  pHashId
+    ) const
+{
+    Util::Result        result      = Util::Result::ErrorOutOfMemory;
+    Util::IHashContext* pCopy       = nullptr;
+    void*               pContextMem = PAL_MALLOC(pContext->GetDuplicateObjectSize(),
+                                                 &m_allocator,
+                                                 Util::AllocInternal);
+
+    if (pContextMem != nullptr)
+    {
+        result = pContext->Duplicate(pContextMem, &pCopy);
+    }
+
+    if ((result == Util::Result::Success) && (dataSize > 0))
+    {
+        result = pCopy->AddData(pData, dataSize);
+    }
+
+    if (result == Util::Result::Success)
+    {
+        result = pCopy->Finish(pHashId);
+    }
+
+    if (pCopy != nullptr)
+    {
+        pCopy->Destroy();
+    }
+
+    PAL_FREE(pContextMem, &m_allocator);
+
+    return result;
+}
+
+// =====================================================================================================================
+Util::Result IncrementalCacheSerializer::State::Write(
+    void*   pBlob,
+    size_t* pSize
+    ) const
+{
+    PAL_ASSERT(m_pHash != nullptr);
+
+    Util::Result result = Util::Result::ErrorIncompleteResults;
+
+    if (*pSize >= HeaderSize)
+    {
+        const size_t capacity  = *pSize - HeaderSize;
+        size_t       bytesUsed = 0;
+
+        if (capacity >= m_dataSize)
+        {
+            bytesUsed = m_dataSize;
+            result    = Util::Result::Success;
+        }
+        else
+        {
+            while ((bytesUsed + EntryHeaderSize) <= m_dataSize)
+            {
+                // Entries in the blob are not guaranteed to be 8-byte aligned.
+                BinaryCacheEntry entry;
+                memcpy(&entry, Util::VoidPtrInc(m_pData, bytesUsed), EntryHeaderSize);
+
+                if ((bytesUsed + EntryHeaderSize + entry.dataSize) > capacity)
+                {
+                    break;
+                }
+
+                bytesUsed += EntryHeaderSize + entry.dataSize;
+            }
+        }
+
+        void* pCacheData = Util::VoidPtrInc(pBlob, HeaderSize);
+
+        if (bytesUsed > 0)
+        {
+            memcpy(pCacheData, m_pData, bytesUsed);
+        }
+
+        auto*              pPrivateHeader = static_cast<PipelineBinaryCachePrivateHeader*>(pBlob);
+        const Util::Result hashResult     = (result == Util::Result::Success) ?
+                                            FinishHash(m_pHash, nullptr, 0, pPrivateHeader->hashId) :
+                                            FinishHash(m_pPlatformKey->GetKeyContext(),
+                                                       pCacheData,
+                                                       bytesUsed,
+                                                       pPrivateHeader->hashId);
+
+        if (hashResult == Util::Result::Success)
+        {
+            *pSize = HeaderSize + bytesUsed;
+        }
+        else
+        {
+            result = hashResult;
+        }
+    }
+    else
+    {
+        *pSize = 0;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void IncrementalCacheSerializer::State::Reset()
+{
+    if (m_pHash != nullptr)
+    {
+        void* pContextMem = m_pHash;
+
+        m_pHash->Destroy();
+        PAL_FREE(pContextMem, &m_allocator);
+        m_pHash = nullptr;
+    }
+
+    PAL_SAFE_FREE(m_pData, &m_allocator);
+
+    m_dataSize     = 0;
+    m_dataCapacity = 0;
+    m_blobIds.Reset();
+
+    Util::MutexAuto lock(&m_addedIdsMutex);
+
+    m_trackAdds = false;
+    m_addedIds.Clear();
+}
+
+
+// =====================================================================================================================
+IncrementalCacheSerializer::IncrementalCacheSerializer(
+    const Util::IndirectAllocator& allocator,
+    const Util::IPlatformKey*      pPlatformKey)
+    :
+    m_allocator    { allocator },
+    m_pPlatformKey { pPlatformKey },
+    m_pState       { nullptr }
+{
+    PAL_ASSERT(pPlatformKey != nullptr);
+}
+
+// =====================================================================================================================
+IncrementalCacheSerializer::~IncrementalCacheSerializer()
+{
+    PAL_SAFE_DELETE(m_pState, &m_allocator);
+}
+
+// =====================================================================================================================
+Util::Result IncrementalCacheSerializer::Init()
+{
+    PAL_ASSERT(m_pState == nullptr);
+
+    Util::Result result = Util::Result::ErrorOutOfMemory;
+
+    m_pState = PAL_NEW(State, &m_allocator, Util::AllocInternal)(m_allocator, m_pPlatformKey);
+
+    if (m_pState != nullptr)
+    {
+        result = m_pState->Init();
+
+        if (result != Util::Result::Success)
+        {
+            PAL_SAFE_DELETE(m_pState, &m_allocator);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void PAL_STDCALL IncrementalCacheSerializer::NotifyMemoryCacheEvent(
+    void*                  pClientData,
+    Util::MemoryCacheEvent event,
+    const Util::Hash128*   pHashId)
+{
+    static_cast<IncrementalCacheSerializer*>(pClientData)->m_pState->OnMemoryCacheEvent(event, *pHashId);
+}
+
+// =====================================================================================================================
+Util::Result IncrementalCacheSerializer::Update(
+    Util::ICacheLayer* pMemoryLayer,
+    Util::ICacheLayer* pLoadLayer)
+{
+    return m_pState->Update(pMemoryLayer, pLoadLayer);
+}
+
+// =====================================================================================================================
+size_t IncrementalCacheSerializer::GetBlobSize() const
+{
+    return m_pState->GetBlobSize();
+}
+
+// =====================================================================================================================
+Util::Result IncrementalCacheSerializer::Write(
+    void*   pBlob,
+    size_t* pSize
+    ) const
+{
+    return m_pState->Write(pBlob, pSize);
+}
+
+// =====================================================================================================================
+void IncrementalCacheSerializer::Reset()
+{
+    m_pState->Reset();
+}
+
 }
@@ -800,6 +800,7 @@ VkResult GraphicsPipelineCommon::Create(
     const VkGraphicsPipelineCreateInfo* pCreateInfo,
     PipelineCreateFlags                 flags,
     const VkAllocationCallbacks*        pAllocator,
+    PrefetchedPipelineBinary*           pPrefetched,
     VkPipeline*                         pPipeline)
 {
     VkResult result;
@@ -814,7 +815,7 @@ VkResult GraphicsPipelineCommon::Create(
     else
     {
         result =  GraphicsPipeline::Create(
-            pDevice, pPipelineCache, pCreateInfo, flags, pAllocator, pPipeline);
+            pDevice, pPipelineCache, pCreateInfo, flags, pAllocator, pPrefetched, pPipeline);
     }
 
     return result;
@@ -92,6 +92,26 @@ struct PipelineShaderOptionsPtr
 
 };
 
+// Lookup structure over the entries of a PipelineProfile, built once after the profile is final.  An entry which can
+// only match a pipeline containing a shader with a particular code hash is keyed by that stage and hash, so a pipeline
+// only needs to test the entries keyed by its own shaders.  The remaining entries (e.g. those matching always, by stage
+// activity or by code size) are kept in a fallback list which is tested for every pipeline.
+struct PipelineProfileIndex
+{
+    struct HashedEntry
+    {
+        Pal::ShaderHash codeHash;   // Code hash the entry requires
+        uint32_t        stage;      // Stage of the shader the code hash is required of
+        uint32_t        entryIdx;   // Index of the entry in the profile
+    };
+
+    void*        pMemory;             // Single allocation backing both arrays below
+    HashedEntry* pHashedEntries;      // Sorted by stage, then code hash, then entry index
+    uint32_t     hashedEntryCount;
+    uint32_t*    pFallbackEntries;    // Sorted by entry index
+    uint32_t     fallbackEntryCount;
+};
+
 // =====================================================================================================================
 // This class can tune pre-compile SC parameters based on known shader hashes in order to improve SC code generation
 // output.
@@ -202,6 +222,16 @@ private:
     void BuildTuningProfile();
     void BuildAppProfile();
 
+    void BuildProfileIndex(
+        const PipelineProfile& profile,
+        PipelineProfileIndex*  pIndex);
+
+    void DestroyProfileIndex(
+        PipelineProfileIndex* pIndex);
+
+    const PipelineProfileIndex& GetProfileIndex(
+        const PipelineProfile& profile) const;
+
     void BuildAppProfileLlpc();
 
 #if ICD_RUNTIME_APP_PROFILE
@@ -222,10 +252,14 @@ private:
     PipelineProfile        m_tuningProfile;
     PipelineProfile        m_appProfile;
 
+    PipelineProfileIndex   m_tuningProfileIndex;
+    PipelineProfileIndex   m_appProfileIndex;
+
     ShaderProfile          m_appShaderProfile;
 
 #if ICD_RUNTIME_APP_PROFILE
     PipelineProfile        m_runtimeProfile;
+    PipelineProfileIndex   m_runtimeProfileIndex;
 #endif
 
 #if PAL_ENABLE_PRINTS_ASSERTS
@@ -59,6 +59,7 @@
 #include "include/khronos/vulkan.h"
 #include "include/vk_defines.h"
 #include "palMetroHash.h"
+#include "palSysMemory.h"
 #include "palUtil.h"
 
 #include <cstddef>
@@ -68,7 +69,9 @@ struct VkAllocationCallbacks;
 
 namespace Util
 {
+class ICacheLayer;
 class IPlatformKey;
+enum class MemoryCacheEvent : uint32;
 }
 
 namespace vk
@@ -160,4 +163,54 @@ private:
     size_t m_bytesUsed      = 0;
 };
 
+// =====================================================================================================================
+// Keeps the serialized pipeline binary cache blob of a memory cache layer between serializations, so that each one only
+// has to load and hash the entries added since the previous one. The memory layer must be created with
+// NotifyMemoryCacheEvent() as its notification callback and this object as its client data. Added entries are appended
+// by the next Update(). Entries can't be taken back out of the running hash, so a removed entry bumps a generation
+// counter instead, and Update() rebuilds the blob when the counter has moved on since the blob was built.
+class IncrementalCacheSerializer
+{
+public:
+    IncrementalCacheSerializer(
+        const Util::IndirectAllocator& allocator,
+        const Util::IPlatformKey*      pPlatformKey);
+    ~IncrementalCacheSerializer();
+
+    Util::Result Init();
+
+    static void PAL_STDCALL NotifyMemoryCacheEvent(
+        void*                        pClientData,
+        Util::MemoryCacheEvent       event,
+        const Util::MetroHash::Hash* pHashId);
+
+    // Brings the blob up to date with the memory layer. Entries are loaded through pLoadLayer, which is either the
+    // memory layer or a layer on top of it that decodes its entries.
+    Util::Result Update(
+        Util::ICacheLayer* pMemoryLayer,
+        Util::ICacheLayer* pLoadLayer);
+
+    // Size of the blob including the private header, as of the last Update()
+    size_t GetBlobSize() const;
+
+    // Writes the blob. If *pSize is smaller than GetBlobSize(), as many whole entries as fit are written and
+    // ErrorIncompleteResults is returned. *pSize is set to the number of bytes written.
+    Util::Result Write(
+        void*   pBlob,
+        size_t* pSize) const;
+
+    // Frees the blob. The next Update() rebuilds it.
+    void Reset();
+
+private:
+    PAL_DISALLOW_COPY_AND_ASSIGN(IncrementalCacheSerializer);
+
+    // The blob and the recorded changes, defined in binary_cache_serialization.cpp
+    class State;
+
+    Util::IndirectAllocator   m_allocator;
+    const Util::IPlatformKey* m_pPlatformKey;
+    State*                    m_pState;       // Created by Init()
+};
+
 }
@@ -34,9 +34,11 @@
 #pragma once
 
 #include "include/vk_alloccb.h"
+#include "include/vk_utils.h"
 #include "palThread.h"
 #include "palMutex.h"
-#include "palList.h"
+#include "palConditionVariable.h"
+#include "palDequeImpl.h"
 #include "palEvent.h"
 
 namespace vk
@@ -47,25 +49,41 @@ class PalAllocator;
 
 struct DeferredCompileWorkload
 {
-    void*       pPayloads;
-    void        (*Execute)(void*); // Function pointer to the call used to execute the workload
-    Util::Event* pEvent;
+    void*                pPayloads;
+    void                 (*Execute)(void*); // Function pointer to the call used to execute the workload
+    Util::Event*         pEvent;
+};
+
+// Statistics of the deferred compile thread pool.
+struct DeferCompileStats
+{
+    uint32_t workerCount;     // Number of worker threads
+    uint32_t queueDepth;      // Tasks currently queued
+    uint32_t peakQueueDepth;  // Most tasks ever queued at once
+    uint64_t tasksExecuted;   // Tasks executed by the workers
+    uint64_t tasksStolen;     // Tasks executed by a worker they were not queued on
 };
 
 // =====================================================================================================================
-// Represents the general thread for async shader/pipeline compiler.
+// Represents one worker thread of the deferred shader/pipeline compile thread pool.
+//
+// Each worker owns a task queue. The worker takes tasks from the front of its own queue; when it is empty, it steals
+// from the back of the other workers' queues, so a burst of tasks queued on one worker is still spread over all of
+// them.
 class DeferCompileThread final : public Util::Thread
 {
 public:
-    DeferCompileThread(PalAllocator* pAllocator)
+    typedef Util::Deque<DeferredCompileWorkload, vk::PalAllocator> TaskQueue;
+
+    DeferCompileThread(
+        DeferCompileManager* pManager,
+        uint32_t             workerId,
+        PalAllocator*        pAllocator)
         :
-        m_taskList(pAllocator),
-        m_stop(false)
+        m_pManager(pManager),
+        m_workerId(workerId),
+        m_taskQueue(pAllocator)
     {
-        Util::EventCreateFlags flags = {};
-        flags.manualReset = true;
-        flags.initiallySignaled = false;
-        m_event.Init(flags);
     }
 
     // Starts a new thread which starts by running function TaskThreadFunc.
@@ -74,29 +92,25 @@ public:
         Util::Thread::Begin(ThreadFunc, this);
     }
 
-    // Adds task to list.
-    void AddTask(DeferredCompileWorkload* pTask)
+    // Adds task to the back of this worker's queue. Returns false if out of memory.
+    bool PushTask(const DeferredCompileWorkload& task)
     {
         Util::MutexAuto mutexAuto(&m_lock);
-        m_taskList.PushBack(*pTask);
-        m_event.Set();
+        return (m_taskQueue.PushBack(task) == Util::Result::Success);
     }
 
-    // Set flag stop and trig event.
-    void SetStop()
+    // Takes the oldest task from this worker's queue, return false if it is empty.
+    bool PopTask(DeferredCompileWorkload* pTask)
     {
-        m_event.Set();
-        m_stop = true;
+        Util::MutexAuto mutexAuto(&m_lock);
+        return (m_taskQueue.PopFront(pTask) == Util::Result::Success);
     }
 
-    // Returns until all tasks are executed.
-    void SyncAll()
+    // Steals the newest task from this worker's queue, return false if it is empty.
+    bool StealTask(DeferredCompileWorkload* pTask)
     {
-        m_event.Set();
-        while (m_taskList.Begin() != m_taskList.End())
-        {
-            Util::YieldThread();
-        }
+        Util::MutexAuto mutexAuto(&m_lock);
+        return (m_taskQueue.PopBack(pTask) == Util::Result::Success);
     }
 
 protected:
@@ -109,48 +123,16 @@ protected:
     }
 
     // The implementation of async thread function
-    void TaskThreadFunc()
-    {
-        while (m_stop == false)
-        {
-            // Waits for new signal.
-            m_event.Wait(1.0f);
-            m_event.Reset();
-
-            DeferredCompileWorkload task;
-            while (FetchTask(&task))
-            {
-                task.Execute(task.pPayloads);
-                if (task.pEvent != nullptr)
-                {
-                    task.pEvent->Set();
-                }
-            }
-        }
-    }
+    inline void TaskThreadFunc();
 
-    // Fetches task in list, return false if task list is empty.
-    bool FetchTask(DeferredCompileWorkload* pTask)
-    {
-        Util::MutexAuto mutexAuto(&m_lock);
-        auto beginIt = m_taskList.Begin();
-        if (beginIt != m_taskList.End())
-        {
-            *pTask = *(beginIt.Get());
-            m_taskList.Erase(&beginIt);
-            return true;
-        }
-        return false;
-    }
-
-    Util::List<DeferredCompileWorkload, vk::PalAllocator> m_taskList;      // Deferred compile task list
-    volatile bool                                         m_stop;          // Flag to stop the thread
-    Util::Mutex                                           m_lock;          // Lock for accessing task list
-    Util::Event                                           m_event;         // Event to notify async thread
+    DeferCompileManager* m_pManager;                                   // Owning thread pool
+    uint32_t             m_workerId;                                   // Index of this worker in the pool
+    Util::Mutex          m_lock;                                       // Lock for accessing the task queue
+    TaskQueue            m_taskQueue;                                  // Queued tasks
 };
 
 // =====================================================================================================================
-// Class that manage DeferCompileThread instance.
+// Work-stealing thread pool of DeferCompileThread workers.
 class DeferCompileManager
 {
 public:
@@ -158,7 +140,13 @@ public:
         :
         m_pCompileThreads{},
         m_taskId(0),
-        m_activeThreadCount(0)
+        m_activeThreadCount(0),
+        m_queuedTasks(0),
+        m_pendingTasks(0),
+        m_peakQueuedTasks(0),
+        m_tasksExecuted(0),
+        m_tasksStolen(0),
+        m_stop(false)
     {
     }
 
@@ -182,50 +170,188 @@ public:
         for (uint32_t i = 0; i < m_activeThreadCount; ++i)
         {
             m_pCompileThreads[i] = VK_PLACEMENT_NEW(m_compileThreadBuffer[i])
-                DeferCompileThread(pAllocator);
+                DeferCompileThread(this, i, pAllocator);
+        }
+
+        // Only start the workers once they all exist, as any of them may steal from any other.
+        for (uint32_t i = 0; i < m_activeThreadCount; ++i)
+        {
             m_pCompileThreads[i]->Begin();
         }
     }
 
     ~DeferCompileManager()
     {
+        {
+            Util::MutexAuto mutexAuto(&m_idleLock);
+            m_stop = true;
+            m_workAvailable.WakeAll();
+        }
+
+        // The workers drain any queued tasks before they exit, as their owners may be waiting on them.
         for (uint32_t i = 0; i < m_activeThreadCount; ++i)
         {
-            m_pCompileThreads[i]->SetStop();
             m_pCompileThreads[i]->Join();
+        }
+
+        for (uint32_t i = 0; i < m_activeThreadCount; ++i)
+        {
             Util::Destructor(m_pCompileThreads[i]);
             m_pCompileThreads[i] = nullptr;
         }
         m_activeThreadCount = 0;
     }
 
+    // Queues a task on one of the workers. Returns false if there are no workers or the task could not be queued; the
+    // caller should then execute the task itself.
+    bool AddTask(const DeferredCompileWorkload& task)
+    {
+        bool queued = false;
+
+        if (m_activeThreadCount > 0)
+        {
+            const uint32_t workerId = Util::AtomicIncrement(&m_taskId) % m_activeThreadCount;
+
+            // Count the task before it becomes visible to the workers, so the counters never underflow.
+            Util::AtomicIncrement(&m_pendingTasks);
+            const uint32_t queuedTasks = Util::AtomicIncrement(&m_queuedTasks);
+
+            queued = m_pCompileThreads[workerId]->PushTask(task);
+
+            if (queued)
+            {
+                Util::MutexAuto mutexAuto(&m_idleLock);
+                m_peakQueuedTasks = Util::Max(m_peakQueuedTasks, queuedTasks);
+                m_workAvailable.WakeOne();
+            }
+            else
+            {
+                Util::AtomicDecrement(&m_queuedTasks);
+                TaskDone();
+            }
+        }
+
+        return queued;
+    }
+
+    // Blocks until every task queued so far has been executed.
     void SyncAll()
     {
-        for (uint32_t i = 0; i < m_activeThreadCount; ++i)
+        Util::MutexAuto mutexAuto(&m_idleLock);
+        while (m_pendingTasks > 0)
         {
-            m_pCompileThreads[i]->SyncAll();
+            m_allTasksDone.Wait(&m_idleLock, UINT32_MAX);
         }
     }
 
-    DeferCompileThread* GetCompileThread()
+    // Returns a snapshot of the thread pool statistics.
+    DeferCompileStats GetStats()
     {
-        return (m_activeThreadCount > 0) ?
-            m_pCompileThreads[(m_taskId++) % m_activeThreadCount] :
-            nullptr;
+        DeferCompileStats stats = {};
+        stats.workerCount = m_activeThreadCount;
+        stats.queueDepth  = m_queuedTasks;
+
+        Util::MutexAuto mutexAuto(&m_idleLock);
+        stats.peakQueueDepth = m_peakQueuedTasks;
+        stats.tasksExecuted  = m_tasksExecuted;
+        stats.tasksStolen    = m_tasksStolen;
+        return stats;
     }
 
 protected:
+    friend class DeferCompileThread;
+
+    // Fetches a task for the given worker, preferring its own queue and otherwise stealing from the others. Returns
+    // false if every queue is empty.
+    bool FetchTask(uint32_t workerId, DeferredCompileWorkload* pTask, bool* pStolen)
+    {
+        bool found = m_pCompileThreads[workerId]->PopTask(pTask);
+        *pStolen = false;
+
+        for (uint32_t i = 1; (i < m_activeThreadCount) && (found == false); ++i)
+        {
+            found    = m_pCompileThreads[(workerId + i) % m_activeThreadCount]->StealTask(pTask);
+            *pStolen = found;
+        }
+
+        if (found)
+        {
+            Util::AtomicDecrement(&m_queuedTasks);
+        }
+
+        return found;
+    }
+
+    // Blocks the calling worker until a task may be available. Returns false once the pool is stopping and no task is
+    // left, in which case the worker should exit.
+    bool WaitForWork()
+    {
+        Util::MutexAuto mutexAuto(&m_idleLock);
+        while ((m_queuedTasks == 0) && (m_stop == false))
+        {
+            m_workAvailable.Wait(&m_idleLock, UINT32_MAX);
+        }
+        return (m_queuedTasks > 0);
+    }
+
+    // Records the completion of a task, waking up SyncAll() callers if it was the last one.
+    void TaskDone(bool executed = false, bool stolen = false)
+    {
+        Util::MutexAuto mutexAuto(&m_idleLock);
+        if (executed)
+        {
+            m_tasksExecuted++;
+            m_tasksStolen += stolen ? 1 : 0;
+        }
+        if (Util::AtomicDecrement(&m_pendingTasks) == 0)
+        {
+            m_allTasksDone.WakeAll();
+        }
+    }
+
     static constexpr uint32_t        MaxThreads = 8;  // Max thread count for shader module compile
     DeferCompileThread*              m_pCompileThreads[MaxThreads]; // Async compiler threads
-    uint32_t                         m_taskId;                      // Hint to select compile thread
+    volatile uint32_t                m_taskId;                      // Hint to select compile thread
     uint32_t                         m_activeThreadCount;           // Active thread count
 
+    volatile uint32_t                m_queuedTasks;                 // Tasks queued but not yet picked up
+    volatile uint32_t                m_pendingTasks;                // Tasks queued or being executed
+    uint32_t                         m_peakQueuedTasks;             // Most tasks ever queued at once
+    uint64_t                         m_tasksExecuted;               // Tasks executed by the workers
+    uint64_t                         m_tasksStolen;                 // Tasks executed after being stolen
+    bool                             m_stop;                        // Set when the workers should exit
+
+    Util::Mutex                      m_idleLock;                    // Lock for sleeping/waking workers and waiters
+    Util::ConditionVariable          m_workAvailable;               // Signaled when a task is queued or on stop
+    Util::ConditionVariable          m_allTasksDone;                // Signaled when no task is pending
+
     // Internal buffer for m_pCompileThreads
     uint8_t                          m_compileThreadBuffer[MaxThreads][sizeof(DeferCompileThread)];
 private:
     PAL_DISALLOW_COPY_AND_ASSIGN(DeferCompileManager);
 };
 
+// =====================================================================================================================
+// The implementation of async thread function
+void DeferCompileThread::TaskThreadFunc()
+{
+    do
+    {
+        DeferredCompileWorkload task;
+        bool                    stolen = false;
+        while (m_pManager->FetchTask(m_workerId, &task, &stolen))
+        {
+            task.Execute(task.pPayloads);
+            if (task.pEvent != nullptr)
+            {
+                task.pEvent->Set();
+            }
+            m_pManager->TaskDone(true, stolen);
+        }
+    }
+    while (m_pManager->WaitForWork());
+}
+
 } // namespace vk
 
 #endif
@@ -43,6 +43,7 @@ class RenderPass;
 struct PipelineOptimizerKey;
 struct GraphicsPipelineBinaryCreateInfo;
 struct GraphicsPipelineShaderStageInfo;
+struct PrefetchedPipelineBinary;
 
 // =====================================================================================================================
 // Sample pattern structure containing pal format sample locations and sample counts
@@ -199,6 +200,7 @@ public:
         const VkGraphicsPipelineCreateInfo* pCreateInfo,
         PipelineCreateFlags                 flags,
         const VkAllocationCallbacks*        pAllocator,
+        PrefetchedPipelineBinary*           pPrefetched,
         VkPipeline*                         pPipeline);
 
     // Get the active shader stages through API info
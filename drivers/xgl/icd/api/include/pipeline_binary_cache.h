@@ -50,6 +50,7 @@ namespace vk
 {
 
 class CacheAdapter;
+class IncrementalCacheSerializer;
 
 // Unified pipeline cache interface
 class PipelineBinaryCache
@@ -90,6 +91,13 @@ public:
         uint32_t           flags,
         Util::QueryResult* pQuery);
 
+    void QueryPipelineBinaries(
+        uint32_t           count,
+        const CacheId*     pCacheIds,
+        uint32_t           flags,
+        Util::QueryResult* pQueries,
+        Util::Result*      pResults);
+
     Util::Result WaitPipelineBinary(
         const CacheId* pCacheId);
 
@@ -98,6 +106,13 @@ public:
         size_t*         pPipelineBinarySize,
         const void**    ppPipelineBinary) const;
 
+    void LoadPipelineBinaries(
+        uint32_t        count,
+        const CacheId*  pCacheIds,
+        size_t*         pPipelineBinarySizes,
+        const void**    ppPipelineBinaries,
+        Util::Result*   pResults);
+
     Util::Result StorePipelineBinary(
         const CacheId*  pCacheId,
         size_t          pipelineBinarySize,
@@ -126,7 +141,8 @@ public:
 
     VkResult Merge(
         uint32_t                    srcCacheCount,
-        const PipelineBinaryCache** ppSrcCaches);
+        const PipelineBinaryCache** ppSrcCaches,
+        PipelineCompiler*           pCompiler);
 
 #if ICD_GPUOPEN_DEVMODE_BUILD
     Util::Result LoadReinjectionBinary(
@@ -210,9 +226,24 @@ private:
         const char*            pDefaultCacheFilePath,
         const RuntimeSettings& settings);
 
+    VkResult InitIncrementalSerializer();
+
+    Util::Result MergeMemoryLayers(
+        uint32_t                    srcCacheCount,
+        const PipelineBinaryCache** ppSrcCaches,
+        PipelineCompiler*           pCompiler);
+
     Util::ICacheLayer*  GetMemoryLayer() const { return m_pMemoryLayer; }
-    Util::IArchiveFile* OpenReadOnlyArchive(const char* path, const char* fileName, size_t bufferSize);
-    Util::IArchiveFile* OpenWritableArchive(const char* path, const char* fileName, size_t bufferSize);
+    Util::IArchiveFile* OpenReadOnlyArchive(
+        const char*            path,
+        const char*            fileName,
+        size_t                 bufferSize,
+        const RuntimeSettings& settings);
+    Util::IArchiveFile* OpenWritableArchive(
+        const char*            path,
+        const char*            fileName,
+        size_t                 bufferSize,
+        const RuntimeSettings& settings);
     Util::ICacheLayer*  CreateFileLayer(Util::IArchiveFile* pFile);
 
     // Override the driver's default location
@@ -248,6 +279,7 @@ private:
     Util::ICacheLayer*        m_pMemoryLayer;
 
     Util::ICacheLayer*        m_pCompressingLayer;
+    bool                      m_memoryLayerCompressed;    // Memory layer entries may be stored compressed
 
     uint32_t                  m_expectedEntries;
 
@@ -261,6 +293,9 @@ private:
     CacheAdapter*       m_pCacheAdapter;
 
     Util::Mutex         m_entriesMutex;      // Mutex that will be used to get cache state by Query
+
+    Util::Mutex                 m_serializeMutex;         // Serializes calls to Serialize()
+    IncrementalCacheSerializer* m_pIncrementalSerializer; // Keeps the serialized blob between calls, if enabled
 };
 
 } // namespace vk
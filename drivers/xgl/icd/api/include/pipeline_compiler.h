@@ -98,6 +98,17 @@ struct ComputePipelineShaderStageInfo
     ShaderStageInfo stage;
 };
 
+// =====================================================================================================================
+// A pipeline binary loaded from the application's pipeline cache before the pipeline itself is created, so that a
+// vkCreate*Pipelines call can fetch all of its binaries in one batch.  GetCachedPipelineBinary() takes ownership of
+// pBinary (and clears it) when cacheId matches the id of the pipeline being created; otherwise the caller frees it.
+struct PrefetchedPipelineBinary
+{
+    Util::MetroHash::Hash cacheId;
+    size_t                binarySize;
+    const void*           pBinary;
+};
+
 #if VKI_RAY_TRACING
 // =====================================================================================================================
 struct RayTracingPipelineShaderStageInfo
@@ -363,6 +374,8 @@ public:
     void ExecuteDeferCompile(
         DeferredCompileWorkload* pWorkload);
 
+    DeferCompileStats GetDeferCompileStats() { return m_deferCompileMgr.GetStats(); }
+
     Util::Result GetCachedPipelineBinary(
         const Util::MetroHash::Hash* pCacheId,
         const PipelineBinaryCache*   pPipelineBinaryCache,
@@ -371,7 +384,8 @@ public:
         bool*                        pIsUserCacheHit,
         bool*                        pIsInternalCacheHit,
         FreeCompilerBinary*          pFreeCompilerBinary,
-        PipelineCreationFeedback*    pPipelineFeedback);
+        PipelineCreationFeedback*    pPipelineFeedback,
+        PrefetchedPipelineBinary*    pPrefetched);
 
     void CachePipelineBinary(
         const Util::MetroHash::Hash* pCacheId,
@@ -0,0 +1,249 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2023 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  queue_submit_thread.h
+* @brief Implementation of class QueueSubmitThread
+***********************************************************************************************************************
+*/
+#ifndef __QUEUE_SUBMIT_THREAD_H__
+#define __QUEUE_SUBMIT_THREAD_H__
+
+#pragma once
+
+#include "include/khronos/vulkan.h"
+#include "include/vk_alloccb.h"
+#include "palThread.h"
+#include "palMutex.h"
+#include "palConditionVariable.h"
+#include "palDequeImpl.h"
+
+#include <atomic>
+
+namespace vk
+{
+
+class PalAllocator;
+
+// =====================================================================================================================
+// Worker thread which performs the queue submissions recorded by one vk::Queue.
+//
+// Tasks are executed strictly in the order they were pushed, so the submission order seen by PAL matches the order
+// of the API calls. The API call which queued a failing task has already returned, so the failure is reported by the
+// next Sync() or GetStatus() instead. A later task may wait on semaphores the failed one was to signal, so the tasks
+// queued before the failure is reported are discarded. Other errors are reported once, after which the thread executes
+// tasks again; VK_ERROR_DEVICE_LOST is reported from then on.
+class QueueSubmitThread final : public Util::Thread
+{
+public:
+    // Executes one task; pOwner is the owner given at construction and pPayload the pointer given to PushTask(). When
+    // discard is set the task must not be executed, only its payload released.
+    typedef VkResult (*ExecuteFunc)(void* pOwner, void* pPayload, bool discard);
+
+    QueueSubmitThread(
+        void*         pOwner,
+        ExecuteFunc   pfnExecute,
+        PalAllocator* pAllocator)
+        :
+        m_pOwner(pOwner),
+        m_pfnExecute(pfnExecute),
+        m_tasks(pAllocator),
+        m_pendingTasks(0),
+        m_lost(false),
+        m_errorPending(false),
+        m_error(VK_SUCCESS),
+        m_discardTasks(0),
+        m_stop(false)
+    {
+    }
+
+    // Stops the worker after it has executed every queued task.
+    ~QueueSubmitThread()
+    {
+        if (IsCreated())
+        {
+            {
+                Util::MutexAuto mutexAuto(&m_lock);
+                m_stop = true;
+                m_workAvailable.WakeAll();
+            }
+
+            Join();
+        }
+    }
+
+    // Starts a new thread which starts by running function TaskThreadFunc.
+    bool Begin()
+    {
+        return (Util::Thread::Begin(ThreadFunc, this) == Util::Result::Success);
+    }
+
+    // Adds a task to the back of the queue. Returns false if out of memory; the caller still owns the payload then.
+    bool PushTask(void* pPayload)
+    {
+        Util::MutexAuto mutexAuto(&m_lock);
+
+        const bool queued = (m_tasks.PushBack(pPayload) == Util::Result::Success);
+
+        if (queued)
+        {
+            m_pendingTasks.fetch_add(1, std::memory_order_relaxed);
+            m_workAvailable.WakeOne();
+        }
+
+        return queued;
+    }
+
+    // Blocks until every task queued so far has been executed, then reports any failure as GetStatus() does.
+    VkResult Sync()
+    {
+        Wait();
+
+        return GetStatus();
+    }
+
+    // Blocks until every task queued so far has been executed, without reporting failures. Called from a task, it
+    // returns at once, as every task queued before that one has been executed already.
+    void Wait()
+    {
+        // Nothing is ever queued without the setting, so keep the common case off the lock. The acquire pairs with the
+        // release of the worker, so the effects of the tasks it finished are visible to the caller.
+        if ((m_pendingTasks.load(std::memory_order_acquire) > 0) && IsNotCurrentThread())
+        {
+            Util::MutexAuto mutexAuto(&m_lock);
+
+            while (m_pendingTasks.load(std::memory_order_relaxed) > 0)
+            {
+                m_allTasksDone.Wait(&m_lock, UINT32_MAX);
+            }
+        }
+    }
+
+    // Returns the error of a task executed so far which has not been reported yet, without waiting for the others.
+    // The tasks still queued at that point are discarded. VK_ERROR_DEVICE_LOST is returned on every call once a task
+    // has reported it.
+    VkResult GetStatus()
+    {
+        VkResult result = IsLost() ? VK_ERROR_DEVICE_LOST : VK_SUCCESS;
+
+        if ((result == VK_SUCCESS) && m_errorPending.load(std::memory_order_acquire))
+        {
+            Util::MutexAuto mutexAuto(&m_lock);
+
+            if (m_error != VK_SUCCESS)
+            {
+                result         = m_error;
+                m_error        = VK_SUCCESS;
+                m_discardTasks = static_cast<uint32_t>(m_tasks.NumElements());
+                m_errorPending.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        return result;
+    }
+
+    // Returns true once a task has failed with VK_ERROR_DEVICE_LOST.
+    bool IsLost() const
+    {
+        return m_lost.load(std::memory_order_acquire);
+    }
+
+protected:
+    // Async thread function
+    static void ThreadFunc(
+        void* pParam)
+    {
+        auto pThis = reinterpret_cast<QueueSubmitThread*>(pParam);
+        pThis->TaskThreadFunc();
+    }
+
+    // The implementation of async thread function
+    void TaskThreadFunc()
+    {
+        Util::MutexAuto mutexAuto(&m_lock);
+
+        while ((m_tasks.NumElements() > 0) || (m_stop == false))
+        {
+            void* pPayload = nullptr;
+
+            if (m_tasks.PopFront(&pPayload) == Util::Result::Success)
+            {
+                const bool discard = m_lost.load(std::memory_order_relaxed) ||
+                                     (m_error != VK_SUCCESS)                 ||
+                                     (m_discardTasks > 0);
+
+                if (m_discardTasks > 0)
+                {
+                    m_discardTasks--;
+                }
+
+                // Execute outside of the lock so that the API thread can keep queueing work.
+                m_lock.Unlock();
+                const VkResult result = m_pfnExecute(m_pOwner, pPayload, discard);
+                m_lock.Lock();
+
+                if ((discard == false) && (result == VK_ERROR_DEVICE_LOST))
+                {
+                    m_lost.store(true, std::memory_order_release);
+                }
+                else if ((discard == false) && (result != VK_SUCCESS))
+                {
+                    m_error = result;
+                    m_errorPending.store(true, std::memory_order_release);
+                }
+
+                if (m_pendingTasks.fetch_sub(1, std::memory_order_release) == 1)
+                {
+                    m_allTasksDone.WakeAll();
+                }
+            }
+            else
+            {
+                m_workAvailable.Wait(&m_lock, UINT32_MAX);
+            }
+        }
+    }
+
+    void* const                            m_pOwner;        // Object passed to m_pfnExecute
+    const ExecuteFunc                      m_pfnExecute;    // Function executing one task
+    Util::Deque<void*, vk::PalAllocator>   m_tasks;         // Tasks waiting to be executed, oldest first
+    std::atomic<uint32_t>                  m_pendingTasks;  // Tasks queued or being executed
+    std::atomic<bool>                      m_lost;          // Set once a task has failed with device loss
+    std::atomic<bool>                      m_errorPending;  // Set while m_error holds an unreported error
+    VkResult                               m_error;         // Unreported error of a failed task
+    uint32_t                               m_discardTasks;  // Queued tasks to discard after an error is reported
+    bool                                   m_stop;          // Set when the worker should exit
+
+    Util::Mutex                            m_lock;          // Lock for the task queue, the counters and m_error
+    Util::ConditionVariable                m_workAvailable; // Signaled when a task is queued or on stop
+    Util::ConditionVariable                m_allTasksDone;  // Signaled when no task is pending
+
+private:
+    PAL_DISALLOW_COPY_AND_ASSIGN(QueueSubmitThread);
+};
+
+} // namespace vk
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2023 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+***********************************************************************************************************************
+* @file  slab_allocator.h
+* @brief Size-class slab allocator with per-thread caches, used by the default allocation callbacks.
+***********************************************************************************************************************
+*/
+#ifndef __SLAB_ALLOCATOR_H__
+#define __SLAB_ALLOCATOR_H__
+
+#pragma once
+
+#include "palMutex.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace vk
+{
+
+namespace allocator
+{
+
+// Number of size classes served from slabs. Bigger or over-aligned allocations go to the system allocator.
+constexpr uint32_t SlabSizeClassCount = 24;
+
+// Statistics of one size class of the slab allocator.
+struct SlabClassStats
+{
+    size_t   blockSize;       // Size of the blocks of this class, including the block header
+    uint64_t carvedBlocks;    // Blocks carved out of the slabs this class currently holds
+    uint64_t freeBlocks;      // Carved blocks free in those slabs; the others are allocated or cached by a thread
+    uint64_t allocCount;      // Allocations served, as of the last exchange of each thread with the shared lists
+};
+
+// Statistics of the slab allocator.
+struct SlabAllocatorStats
+{
+    SlabClassStats classes[SlabSizeClassCount];
+    uint64_t       slabCount;         // Slabs currently allocated from the system
+    uint64_t       largeAllocCount;   // Live allocations passed to the system allocator
+};
+
+// =====================================================================================================================
+// Allocator for the many small, short-lived system memory allocations of the driver (API objects, PAL objects and Util
+// container nodes) when the application does not provide its own allocation callbacks.
+//
+// Allocations are rounded up to one of a fixed set of size classes, tuned to the sizes of the driver's objects, and
+// carved out of large slabs. Each thread keeps a small cache of free blocks per class, so most allocations and frees
+// take no lock; the caches exchange blocks with the shared per-class slab lists in batches. Every allocation is
+// preceded by a small header naming its class, which lets Free() work without the allocation size, as the Vulkan free
+// callback requires. A slab goes back to the system once none of its blocks is allocated or cached by a thread; each
+// class keeps one such empty slab in reserve so that a workload hovering at a slab boundary doesn't thrash.
+//
+// The per-thread caches are thread_local objects with a destructor, which the C++ runtime registers per thread. While
+// any thread that used the allocator is alive (the main thread included), that registration keeps the ICD loaded:
+// dlclose() on it returns without unmapping it. This is deliberate: the allocator is never destroyed, so unloading the
+// ICD would leak its slabs, including the blocks those threads still cache.
+//
+// The allocator sits below the allocation callbacks, so PalAllocator's memory tracker (PAL_MEMTRACK) still sees and
+// checks every allocation.
+class SlabAllocator
+{
+public:
+    static SlabAllocator* Get();
+
+    void* Alloc(size_t size, size_t alignment);
+    void  Free(void* pMem);
+
+    void  GetStats(SlabAllocatorStats* pStats);
+
+private:
+    friend struct SlabThreadCache;
+
+    SlabAllocator();
+    ~SlabAllocator() = delete;
+
+    static uint32_t BatchCount(uint32_t classIdx);
+
+    struct Slab;
+    struct SizeClass;
+
+    uint32_t FetchBlocks(uint32_t classIdx, uint32_t count, uint32_t allocCount, void** ppHead);
+    void     ReturnBlocks(uint32_t classIdx, void* pHead, uint32_t count, uint32_t allocCount);
+
+    Slab*    CreateSlab(uint32_t classIdx);
+    void     DestroySlab(SizeClass* pClass, Slab* pSlab);
+
+    static void LinkSlab(SizeClass* pClass, Slab* pSlab);
+    static void UnlinkSlab(SizeClass* pClass, Slab* pSlab);
+
+    void*    AllocLarge(size_t size, size_t alignment);
+
+    // Shared state of one size class.
+    struct SizeClass
+    {
+        Util::Mutex lock;          // Protects the members below and the slabs of this class
+        Slab*       pPartial;      // Slabs with blocks to hand out, most recently linked first
+        Slab*       pSpare;        // One empty slab kept in reserve
+        uint64_t    carvedBlocks;
+        uint64_t    freeBlocks;
+        uint64_t    allocCount;
+    };
+
+    // Size class of each allocation size, indexed by the block size needed in units of the block header size
+    static constexpr uint32_t ClassLookupSize = 257;
+
+    SizeClass         m_classes[SlabSizeClassCount];
+    uint8_t           m_classLookup[ClassLookupSize];
+    volatile uint64_t m_slabCount;
+    volatile uint64_t m_largeAllocCount;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(SlabAllocator);
+};
+
+} // namespace allocator
+
+} // namespace vk
+
+#endif /* __SLAB_ALLOCATOR_H__ */
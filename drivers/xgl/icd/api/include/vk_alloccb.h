@@ -66,6 +66,11 @@ void PAL_STDCALL PalFreeFuncDelegator(
     void* pClientData,
     void* pMem);
 
+#if ICD_SLAB_ALLOCATOR
+void LogSlabAllocatorStats(
+    uint64_t logTagIdMask);
+#endif
+
 } // namespace allocator
 
 // =====================================================================================================================
@@ -51,6 +51,7 @@ namespace vk
 class CmdBuffer;
 class Device;
 class PipelineCache;
+struct PrefetchedPipelineBinary;
 
 // =====================================================================================================================
 // Vulkan implementation of compute pipelines created by vkCreateComputePipeline
@@ -63,8 +64,15 @@ public:
         const VkComputePipelineCreateInfo*     pCreateInfo,
         PipelineCreateFlags                    flags,
         const VkAllocationCallbacks*           pAllocator,
+        PrefetchedPipelineBinary*              pPrefetched,
         VkPipeline*                            pPipeline);
 
+    static bool GetPrefetchCacheId(
+        const Device*                          pDevice,
+        const VkComputePipelineCreateInfo*     pCreateInfo,
+        PipelineCreateFlags                    flags,
+        Util::MetroHash::Hash*                 pCacheId);
+
     VkResult Destroy(
         Device*                         pDevice,
         const VkAllocationCallbacks*    pAllocator) override;
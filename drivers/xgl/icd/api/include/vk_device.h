@@ -218,6 +218,12 @@ public:
 
     VkResult WaitIdle(void);
 
+    VkResult SyncDeferredQueueSubmits(
+        uint64_t                                    queueMask = UINT64_MAX);
+
+    void WaitDeferredQueueSubmits(
+        uint64_t                                    queueMask = UINT64_MAX);
+
     VkResult AllocMemory(
         const VkMemoryAllocateInfo*                 pAllocInfo,
         const VkAllocationCallbacks*                pAllocator,
@@ -373,6 +373,7 @@ public:
         EXT_GLOBAL_PRIORITY_QUERY,
         EXT_GRAPHICS_PIPELINE_LIBRARY,
         EXT_HDR_METADATA,
+        EXT_HOST_IMAGE_COPY,
         EXT_HOST_QUERY_RESET,
         EXT_IMAGE_2D_VIEW_OF_3D,
         EXT_IMAGE_DRM_FORMAT_MODIFIER,
@@ -38,6 +38,8 @@
 #include "include/vk_dispatch.h"
 #include "include/vk_defines.h"
 
+#include <atomic>
+
 namespace Pal
 {
 
@@ -87,6 +89,16 @@ public:
     void SetActiveDevice(uint32_t deviceIdx)
         { m_activeDeviceMask |= (1 << deviceIdx); }
 
+    // Records that the queues in queueMask (see Queue::GetQueueMask()) have queued a signal of this fence on their
+    // submission thread. The mask is never cleared, as syncing a submission thread with no pending work is cheap.
+    void AddDeferredSignalQueues(uint64_t queueMask)
+        { m_deferredSignalQueues.fetch_or(queueMask, std::memory_order_relaxed); }
+
+    // Returns the queues whose submission threads must be synced before waiting on any of the fences.
+    static uint64_t GetDeferredSignalQueues(
+        uint32_t       fenceCount,
+        const VkFence* pFences);
+
     VK_FORCEINLINE Pal::IFence* PalFence(int32_t idx) const
     {
         VK_ASSERT((idx >= 0) && (idx < static_cast<int32_t>(MaxPalDevices)));
@@ -103,7 +115,8 @@ private:
     :
     m_activeDeviceMask(0),
     m_groupedFenceCount(numGroupedFences),
-    m_pPalTemporaryFences(nullptr)
+    m_pPalTemporaryFences(nullptr),
+    m_deferredSignalQueues(0)
     {
         memcpy(m_pPalFences, pPalFences, sizeof(pPalFences[0]) * numGroupedFences);
         m_flags.value          = 0;
@@ -116,6 +129,8 @@ private:
     Pal::IFence* m_pPalFences[MaxPalDevices];
     Pal::IFence* m_pPalTemporaryFences;
 
+    std::atomic<uint64_t> m_deferredSignalQueues; // Queues which have queued a signal on their submission thread
+
     union
     {
         struct
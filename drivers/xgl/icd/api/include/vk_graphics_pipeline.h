@@ -167,8 +167,15 @@ public:
         const VkGraphicsPipelineCreateInfo*     pCreateInfo,
         PipelineCreateFlags                     flags,
         const VkAllocationCallbacks*            pAllocator,
+        PrefetchedPipelineBinary*               pPrefetched,
         VkPipeline*                             pPipeline);
 
+    static bool GetPrefetchCacheId(
+        const Device*                           pDevice,
+        const VkGraphicsPipelineCreateInfo*     pCreateInfo,
+        PipelineCreateFlags                     flags,
+        Util::MetroHash::Hash*                  pCacheId);
+
     VkResult Destroy(
         Device*                         pDevice,
         const VkAllocationCallbacks*    pAllocator) override;
@@ -245,7 +252,8 @@ protected:
         Util::MetroHash::Hash*                         pCacheIds,
         size_t*                                        pPipelineBinarySizes,
         const void**                                   ppPipelineBinaries,
-        PipelineMetadata*                              pBinaryMetadata);
+        PipelineMetadata*                              pBinaryMetadata,
+        PrefetchedPipelineBinary*                      pPrefetched);
 
     static VkResult CreatePipelineObjects(
         Device*                             pDevice,
@@ -135,6 +135,23 @@ public:
         const VkImageSubresource*               pSubresource,
         VkSubresourceLayout*                    pLayout) const;
 
+    void GetSubresourceLayout2(
+        const Device*                           pDevice,
+        const VkImageSubresource2KHR*           pSubresource,
+        VkSubresourceLayout2KHR*                pLayout) const;
+
+    VkResult CopyMemoryToImage(
+        const Device*                           pDevice,
+        const VkCopyMemoryToImageInfoEXT*       pCopyInfo);
+
+    VkResult CopyImageToMemory(
+        const Device*                           pDevice,
+        const VkCopyImageToMemoryInfoEXT*       pCopyInfo) const;
+
+    static VkResult CopyImageToImage(
+        const Device*                           pDevice,
+        const VkCopyImageToImageInfoEXT*        pCopyInfo);
+
     void GetSparseMemoryRequirements(
         Device*                                             pDevice,
         uint32_t*                                           pNumRequirements,
@@ -523,6 +540,29 @@ VKAPI_ATTR void VKAPI_CALL vkGetImageSparseMemoryRequirements2(
     uint32_t*                                   pSparseMemoryRequirementCount,
     VkSparseImageMemoryRequirements2*           pSparseMemoryRequirements);
 
+VKAPI_ATTR VkResult VKAPI_CALL vkCopyMemoryToImageEXT(
+    VkDevice                                    device,
+    const VkCopyMemoryToImageInfoEXT*           pCopyMemoryToImageInfo);
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCopyImageToMemoryEXT(
+    VkDevice                                    device,
+    const VkCopyImageToMemoryInfoEXT*           pCopyImageToMemoryInfo);
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCopyImageToImageEXT(
+    VkDevice                                    device,
+    const VkCopyImageToImageInfoEXT*            pCopyImageToImageInfo);
+
+VKAPI_ATTR VkResult VKAPI_CALL vkTransitionImageLayoutEXT(
+    VkDevice                                    device,
+    uint32_t                                    transitionCount,
+    const VkHostImageLayoutTransitionInfoEXT*   pTransitions);
+
+VKAPI_ATTR void VKAPI_CALL vkGetImageSubresourceLayout2EXT(
+    VkDevice                                    device,
+    VkImage                                     image,
+    const VkImageSubresource2KHR*               pSubresource,
+    VkSubresourceLayout2KHR*                    pLayout);
+
 #if defined(__unix__)
 VKAPI_ATTR VkResult VKAPI_CALL vkGetImageDrmFormatModifierPropertiesEXT(
     VkDevice                                    device,
@@ -283,6 +283,8 @@ public:
         VkFormat                format,
         VkFormatProperties3KHR* pFormatProperties) const;
 
+    bool FormatSupportsHostImageCopy(VkFormat format) const;
+
     bool FormatSupportsMsaa(VkFormat format) const
     {
         uint32_t formatIndex = Formats::GetIndex(format);
@@ -40,6 +40,7 @@
 #include "include/vk_instance.h"
 #include "include/vk_utils.h"
 #include "include/virtual_stack_mgr.h"
+#include "include/queue_submit_thread.h"
 
 #include "palQueue.h"
 
@@ -166,6 +167,35 @@ public:
         VkFence               fence);
 
     VkResult WaitIdle(void);
+
+    // Waits until the submission thread, if any, has passed every submission queued so far to PAL. Returns the error
+    // of a deferred submission which has failed since the last report (see QueueSubmitThread::GetStatus()).
+    VkResult SyncDeferredSubmits()
+    {
+        return (m_pSubmitThread != nullptr) ? m_pSubmitThread->Sync() : VK_SUCCESS;
+    }
+
+    // Waits as SyncDeferredSubmits() does, for callers which cannot report an error; it stays pending then.
+    void WaitDeferredSubmits()
+    {
+        if (m_pSubmitThread != nullptr)
+        {
+            m_pSubmitThread->Wait();
+        }
+    }
+
+    // Returns true if a deferred submission has failed with VK_ERROR_DEVICE_LOST.
+    bool IsDeferredSubmitLost() const
+    {
+        return (m_pSubmitThread != nullptr) && m_pSubmitThread->IsLost();
+    }
+
+    // Returns the bit identifying this queue in the queue masks of Device::SyncDeferredQueueSubmits().
+    uint64_t GetQueueMask() const
+    {
+        return 1ull << ((m_queueFamilyIndex * MaxQueuesPerFamily) + m_queueIndex);
+    }
+
     VkResult PalSignalSemaphores(
         uint32_t            semaphoreCount,
         const VkSemaphore*  pSemaphores,
@@ -203,6 +233,8 @@ public:
         MaxSubQueuesInGroup = MaxQueueFamilies * MaxQueuesPerFamily  // Maximum number of queues per group
     };
 
+    static_assert(MaxSubQueuesInGroup <= 64, "Every queue of a device needs a bit in a 64-bit queue mask.");
+
     VK_FORCEINLINE Pal::IQueue* PalQueue(int32_t idx) const
     {
         VK_ASSERT((idx >= 0) && (idx < static_cast<int32_t>(MaxPalDevices)));
@@ -284,6 +316,55 @@ protected:
         uint32_t u32All;
     };
 
+    // Kinds of tasks executed by the submission thread. Every task payload starts with its type.
+    enum class DeferredTaskType : uint32_t
+    {
+        Submit,
+        Present
+    };
+
+    // A vkQueueSubmit() or vkQueueSubmit2() call deferred to the submission thread. The submit infos and everything
+    // they point to are stored right after this header, in the same allocation.
+    struct DeferredSubmit
+    {
+        DeferredTaskType type;
+        VkFence          fence;
+        uint32_t         submitCount;
+        bool             isSynchronization2;
+        void*            pSubmits;
+    };
+
+    // A vkQueuePresentKHR() call executed by the submission thread, after the submissions queued before it. It lives on
+    // the stack of the API call, which waits for it.
+    struct DeferredPresent
+    {
+        DeferredTaskType        type;
+        const VkPresentInfoKHR* pPresentInfo;
+        VkResult                result;
+    };
+
+    VkResult PresentImpl(
+        const VkPresentInfoKHR* pPresentInfo);
+
+    template<typename SubmitInfoType>
+    VkResult PalSubmit(
+        uint32_t              submitCount,
+        const SubmitInfoType* pSubmits,
+        VkFence               fence);
+
+    template<typename SubmitInfoType>
+    bool DeferSubmit(
+        uint32_t              submitCount,
+        const SubmitInfoType* pSubmits,
+        VkFence               fence);
+
+    static VkResult ExecuteDeferredTask(
+        void* pOwner,
+        void* pPayload,
+        bool  discard);
+
+    void InitSubmitThread();
+
     VkResult BindSparseEntry(
         const VkBindSparseInfo& bindInfo,
         uint32_t                resourceDeviceIndex,
@@ -367,6 +448,7 @@ protected:
     Pal::ICmdBuffer*                   m_pDummyCmdBuffer[MaxPalDevices];
     SqttQueueState*                    m_pSqttState; // Per-queue state for handling SQ thread-tracing annotations
     CmdBufferRing*                     m_pCmdBufferRing;
+    QueueSubmitThread*                 m_pSubmitThread; // Performs the PAL submissions when threaded submit is on
 
     const bool                         m_isDeviceIndependent;
 
@@ -34,6 +34,8 @@
 
 #include "palQueueSemaphore.h"
 
+#include <atomic>
+
 namespace Pal
 {
 
@@ -132,6 +134,18 @@ public:
         return m_palCreateInfo.flags.timeline;
     }
 
+    // Records that the queues in queueMask (see Queue::GetQueueMask()) have queued a signal of this semaphore on their
+    // submission thread. The mask is never cleared, as syncing a submission thread with no pending work is cheap.
+    void AddDeferredSignalQueues(uint64_t queueMask)
+    {
+        m_deferredSignalQueues.fetch_or(queueMask, std::memory_order_relaxed);
+    }
+
+    // Returns the queues whose submission threads must be synced before waiting on any of the semaphores.
+    static uint64_t GetDeferredSignalQueues(
+        uint32_t           semaphoreCount,
+        const VkSemaphore* pSemaphores);
+
 private:
     PAL_DISALLOW_COPY_AND_ASSIGN(Semaphore);
 
@@ -144,7 +158,8 @@ private:
         m_palCreateInfo(palCreateInfo),
         m_useTempSemaphore(false),
         m_sharedSemaphoreHandle(sharedSemaphorehandle),
-        m_sharedSemaphoreTempHandle(0)
+        m_sharedSemaphoreTempHandle(0),
+        m_deferredSignalQueues(0)
     {
         for (uint32_t i = 0; i < semaphoreCount; i++)
         {
@@ -173,6 +188,8 @@ private:
     Pal::OsExternalHandle           m_sharedSemaphoreHandle;
     Pal::OsExternalHandle           m_sharedSemaphoreTempHandle;
 
+    // Queues which have queued a signal of this semaphore on their submission thread.
+    std::atomic<uint64_t>           m_deferredSignalQueues;
 };
 
 namespace entry
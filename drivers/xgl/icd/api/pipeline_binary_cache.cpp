@@ -33,6 +33,9 @@
 
 #include "palArchiveFile.h"
 #include "palAutoBuffer.h"
+#include "palEvent.h"
+#include "palHashProvider.h"
+#include "palHashSetImpl.h"
 #include "palPlatformKey.h"
 #include "palSysMemory.h"
 #include "palVectorImpl.h"
@@ -44,6 +47,7 @@
 #include "devmode/devmode_mgr.h"
 #endif
 #include <string.h>
+#include <algorithm>
 
 namespace vk
 {
@@ -56,6 +60,21 @@ static constexpr size_t ArchiveTypeStringLen = sizeof(ArchiveTypeString);
 static constexpr char   ElfTypeString[]      = "VK_PIPELINE_ELF";
 static constexpr size_t ElfTypeStringLen     = sizeof(ElfTypeString);
 
+// Upper bound on the number of concurrently merged partitions of a memory layer
+static constexpr uint32_t MaxMergePartitions = 16;
+
+// One partition of a memory layer merge, executed by a deferred compile worker or the merging thread
+struct MemoryLayerMergeTask
+{
+    Util::ICacheLayer*        pDstLayer;
+    Util::ICacheLayer* const* ppSrcLayers;
+    uint32_t                  srcLayerCount;
+    uint32_t                  partIndex;
+    uint32_t                  partCount;
+    Util::Result              result;
+    Util::Event               event;
+};
+
 const uint32_t PipelineBinaryCache::ArchiveType = Util::HashString(ArchiveTypeString, ArchiveTypeStringLen);
 const uint32_t PipelineBinaryCache::ElfType     = Util::HashString(ElfTypeString, ElfTypeStringLen);
 
@@ -185,22 +204,24 @@ PipelineBinaryCache::PipelineBinaryCache(
     const Vkgc::GfxIpVersion& gfxIp,
     uint32_t                  expectedEntries)
     :
-    m_pAllocationCallbacks { pAllocationCallbacks },
-    m_palAllocator         { pAllocationCallbacks },
-    m_pPlatformKey         { nullptr },
-    m_pTopLayer            { nullptr },
+    m_pAllocationCallbacks   { pAllocationCallbacks },
+    m_palAllocator           { pAllocationCallbacks },
+    m_pPlatformKey           { nullptr },
+    m_pTopLayer              { nullptr },
 #if ICD_GPUOPEN_DEVMODE_BUILD
-    m_pDevModeMgr          { nullptr },
-    m_pReinjectionLayer    { nullptr },
-    m_hashMapping          { 32, &m_palAllocator },
+    m_pDevModeMgr            { nullptr },
+    m_pReinjectionLayer      { nullptr },
+    m_hashMapping            { 32, &m_palAllocator },
 #endif
-    m_pMemoryLayer         { nullptr },
-    m_pCompressingLayer    { nullptr },
-    m_expectedEntries      { expectedEntries },
-    m_pArchiveLayer        { nullptr },
-    m_openFiles            { &m_palAllocator },
-    m_archiveLayers        { &m_palAllocator },
-    m_pCacheAdapter        { nullptr }
+    m_pMemoryLayer           { nullptr },
+    m_pCompressingLayer      { nullptr },
+    m_memoryLayerCompressed  { false },
+    m_expectedEntries        { expectedEntries },
+    m_pArchiveLayer          { nullptr },
+    m_openFiles              { &m_palAllocator },
+    m_archiveLayers          { &m_palAllocator },
+    m_pCacheAdapter          { nullptr },
+    m_pIncrementalSerializer { nullptr }
 {
     // Without copy constructor, a class type variable can't be initialized in initialization list with gcc 4.8.5.
     // Initialize m_gfxIp here instead to make gcc 4.8.5 work.
@@ -250,6 +271,13 @@ PipelineBinaryCache::~PipelineBinaryCache()
         m_pReinjectionLayer->Destroy();
     }
 #endif
+
+    // The memory layer reports to the serializer until it is destroyed
+    if (m_pIncrementalSerializer != nullptr)
+    {
+        Util::Destructor(m_pIncrementalSerializer);
+        FreeMem(m_pIncrementalSerializer);
+    }
 }
 
 // =====================================================================================================================
@@ -341,6 +369,121 @@ Util::Result PipelineBinaryCache::LoadPipelineBinary(
     return result;
 }
 
+// =====================================================================================================================
+// Query a batch of pipeline binaries.  The layers synchronize their own lookups and promotions, so plain queries run
+// without the entries mutex and never hold up other threads for the length of the batch.  Only queries which reserve
+// or reference entries take the mutex, per id, to stay atomic with respect to QueryPipelineBinary().
+void PipelineBinaryCache::QueryPipelineBinaries(
+    uint32_t           count,
+    const CacheId*     pCacheIds,
+    uint32_t           flags,
+    Util::QueryResult* pQueries,
+    Util::Result*      pResults)
+{
+    VK_ASSERT(m_pTopLayer != nullptr);
+    VK_ASSERT((count == 0) || ((pCacheIds != nullptr) && (pQueries != nullptr) && (pResults != nullptr)));
+
+    const uint32_t policy    = Util::ICacheLayer::LinkPolicy::LoadOnQuery;
+    const bool     needsLock = Util::TestAnyFlagSet(flags, Util::ICacheLayer::QueryFlags::ReserveEntryOnMiss |
+                                                           Util::ICacheLayer::QueryFlags::AcquireEntryRef);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (needsLock)
+        {
+            m_entriesMutex.Lock();
+        }
+
+        pResults[i] = m_pTopLayer->Query(&pCacheIds[i], policy, flags, &pQueries[i]);
+
+        if (needsLock)
+        {
+            m_entriesMutex.Unlock();
+        }
+    }
+}
+
+// =====================================================================================================================
+// Load a batch of pipeline binaries.  All ids are resolved first, then the hits are loaded grouped by the layer that
+// holds them and, within a layer, in entry order.  For archive file layers the entry id is the ordinal of the entry in
+// the append-only archive, so this reads the file front to back instead of seeking around it once per pipeline.
+//
+// Each successfully loaded binary is allocated with AllocMem() and must be released by the caller with FreeMem(), just
+// like LoadPipelineBinary().  Ids which miss or fail to load leave their size/binary outputs untouched.
+void PipelineBinaryCache::LoadPipelineBinaries(
+    uint32_t        count,
+    const CacheId*  pCacheIds,
+    size_t*         pPipelineBinarySizes,
+    const void**    ppPipelineBinaries,
+    Util::Result*   pResults)
+{
+    VK_ASSERT(m_pTopLayer != nullptr);
+    VK_ASSERT((count == 0) ||
+              ((pCacheIds != nullptr) && (pPipelineBinarySizes != nullptr) &&
+               (ppPipelineBinaries != nullptr) && (pResults != nullptr)));
+
+    Util::AutoBuffer<Util::QueryResult, 8, PalAllocator> queries(count, &m_palAllocator);
+    Util::AutoBuffer<uint32_t, 8, PalAllocator>          order(count, &m_palAllocator);
+
+    if ((queries.Capacity() < count) || (order.Capacity() < count))
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            pResults[i] = Util::Result::ErrorOutOfMemory;
+        }
+    }
+    else
+    {
+        uint32_t numHits = 0;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            queries[i]  = {};
+            pResults[i] = m_pTopLayer->Query(&pCacheIds[i], 0, 0, &queries[i]);
+
+            if (pResults[i] == Util::Result::Success)
+            {
+                order[numHits++] = i;
+            }
+        }
+
+        std::sort(order.Data(), order.Data() + numHits, [&queries](uint32_t lhs, uint32_t rhs)
+        {
+            const Util::QueryResult& left  = queries[lhs];
+            const Util::QueryResult& right = queries[rhs];
+
+            return (left.pLayer != right.pLayer) ? (left.pLayer < right.pLayer)
+                                                 : (left.context.entryId < right.context.entryId);
+        });
+
+        for (uint32_t hit = 0; hit < numHits; hit++)
+        {
+            const uint32_t           i          = order[hit];
+            const Util::QueryResult& query      = queries[i];
+            void*                    pOutputMem = AllocMem(query.dataSize);
+
+            if (pOutputMem != nullptr)
+            {
+                pResults[i] = m_pTopLayer->Load(&query, pOutputMem);
+
+                if (pResults[i] == Util::Result::Success)
+                {
+                    pPipelineBinarySizes[i] = query.dataSize;
+                    ppPipelineBinaries[i]   = pOutputMem;
+                }
+                else
+                {
+                    FreeMem(pOutputMem);
+                }
+            }
+            else
+            {
+                pResults[i] = Util::Result::ErrorOutOfMemory;
+            }
+        }
+    }
+}
+
 // =====================================================================================================================
 // Attempt to store a binary into a cache chain
 Util::Result PipelineBinaryCache::StorePipelineBinary(
@@ -558,6 +701,11 @@ VkResult PipelineBinaryCache::Initialize(
         result = VK_ERROR_INITIALIZATION_FAILED;
     }
 
+    if ((result == VK_SUCCESS) && settings.pipelineCacheIncrementalSerialize)
+    {
+        result = InitIncrementalSerializer();
+    }
+
     if (result == VK_SUCCESS)
     {
         result = InitLayers(pDefaultCacheFilePath, createArchiveLayers, settings);
@@ -823,6 +971,12 @@ VkResult PipelineBinaryCache::InitMemoryCacheLayer(
     createInfo.evictOnFull         = true;
     createInfo.evictDuplicates     = true;
 
+    if (m_pIncrementalSerializer != nullptr)
+    {
+        createInfo.pfnNotify         = IncrementalCacheSerializer::NotifyMemoryCacheEvent;
+        createInfo.pNotifyClientData = m_pIncrementalSerializer;
+    }
+
     size_t layerSize = Util::GetMemoryCacheLayerSize(&createInfo);
     void* pMem = AllocMem(layerSize);
 
@@ -846,6 +1000,40 @@ VkResult PipelineBinaryCache::InitMemoryCacheLayer(
     return result;
 }
 
+// =====================================================================================================================
+// Create the object that keeps the serialized cache between Serialize() calls. It has to exist before the memory layer,
+// which reports every change of its contents to it.
+VkResult PipelineBinaryCache::InitIncrementalSerializer()
+{
+    VK_ASSERT(m_pIncrementalSerializer == nullptr);
+
+    VkResult result = VK_SUCCESS;
+
+    void* pMem = AllocMem(sizeof(IncrementalCacheSerializer));
+
+    if (pMem == nullptr)
+    {
+        result = VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    else
+    {
+        m_pIncrementalSerializer = VK_PLACEMENT_NEW(pMem) IncrementalCacheSerializer(
+            Util::IndirectAllocator(&m_palAllocator),
+            m_pPlatformKey);
+
+        result = PalToVkResult(m_pIncrementalSerializer->Init());
+
+        if (result != VK_SUCCESS)
+        {
+            Util::Destructor(m_pIncrementalSerializer);
+            FreeMem(pMem);
+            m_pIncrementalSerializer = nullptr;
+        }
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 // Initialize compression layer
 VkResult PipelineBinaryCache::InitCompressingLayer(
@@ -882,9 +1070,10 @@ VkResult PipelineBinaryCache::InitCompressingLayer(
 // =====================================================================================================================
 // Open an archive file from disk for read
 Util::IArchiveFile* PipelineBinaryCache::OpenReadOnlyArchive(
-    const char* pFilePath,
-    const char* pFileName,
-    size_t      bufferSize)
+    const char*            pFilePath,
+    const char*            pFileName,
+    size_t                 bufferSize,
+    const RuntimeSettings& settings)
 {
     VK_ASSERT(pFilePath != nullptr);
     VK_ASSERT(pFileName != nullptr);
@@ -908,6 +1097,8 @@ Util::IArchiveFile* PipelineBinaryCache::OpenReadOnlyArchive(
     info.allowCreateFile         = false;
     info.allowAsyncFileIo        = true;
     info.useBufferedReadMemory   = (bufferSize > 0);
+    info.useMemoryMappedRead     = settings.pipelineCacheUseMemoryMappedRead;
+    info.prefetchRecentEntries   = settings.pipelineCachePrefetchRecentEntries;
     info.maxReadBufferMem        = bufferSize;
 
     size_t memSize = Util::GetArchiveFileObjectSize(&info);
@@ -937,9 +1128,10 @@ Util::IArchiveFile* PipelineBinaryCache::OpenReadOnlyArchive(
 // =====================================================================================================================
 // Open an archive file from disk for read + write
 Util::IArchiveFile* PipelineBinaryCache::OpenWritableArchive(
-    const char* pFilePath,
-    const char* pFileName,
-    size_t      bufferSize)
+    const char*            pFilePath,
+    const char*            pFileName,
+    size_t                 bufferSize,
+    const RuntimeSettings& settings)
 {
     VK_ASSERT(pFilePath != nullptr);
     VK_ASSERT(pFileName != nullptr);
@@ -963,6 +1155,8 @@ Util::IArchiveFile* PipelineBinaryCache::OpenWritableArchive(
     info.allowCreateFile         = true;
     info.allowAsyncFileIo        = true;
     info.useBufferedReadMemory   = (bufferSize > 0);
+    info.useMemoryMappedRead     = settings.pipelineCacheUseMemoryMappedRead;
+    info.prefetchRecentEntries   = settings.pipelineCachePrefetchRecentEntries;
     info.maxReadBufferMem        = bufferSize;
 
     size_t memSize = Util::GetArchiveFileObjectSize(&info);
@@ -1095,7 +1289,10 @@ VkResult PipelineBinaryCache::InitArchiveLayers(
 
         if (pThirdPartyFileName != nullptr)
         {
-            Util::IArchiveFile* pFile = OpenReadOnlyArchive(pCachePath, pThirdPartyFileName, PrimaryLayerBufferSize);
+            Util::IArchiveFile* pFile = OpenReadOnlyArchive(pCachePath,
+                                                            pThirdPartyFileName,
+                                                            PrimaryLayerBufferSize,
+                                                            settings);
 
             if (pFile != nullptr)
             {
@@ -1173,13 +1370,13 @@ VkResult PipelineBinaryCache::InitArchiveLayers(
 
             if (pWriteLayer == nullptr)
             {
-                pFile = OpenWritableArchive(pCachePath, nameBuffer, bufferSize);
+                pFile = OpenWritableArchive(pCachePath, nameBuffer, bufferSize, settings);
             }
 
             // Attempt to open the file as a read only instead if we failed
             if (pFile == nullptr)
             {
-                pFile    = OpenReadOnlyArchive(pCachePath, nameBuffer, bufferSize);
+                pFile    = OpenReadOnlyArchive(pCachePath, nameBuffer, bufferSize, settings);
                 readOnly = true;
             }
 
@@ -1325,6 +1522,7 @@ VkResult PipelineBinaryCache::OrderLayers(
         (settings.pipelineCacheCompression == PipelineCacheCompressInMemory))
     {
         result = AddLayerToChain(m_pCompressingLayer, &pBottomLayer);
+        m_memoryLayerCompressed = (result == VK_SUCCESS);
     }
 
     if (result == VK_SUCCESS)
@@ -1356,7 +1554,11 @@ VkResult PipelineBinaryCache::OrderLayers(
 // =====================================================================================================================
 // Copies the pipeline cache data to the memory blob provided by the calling function.
 //
-// NOTE: It is expected that the calling function has not used this pipeline cache since querying the size
+// With PipelineCacheIncrementalSerialize the serialized blob is kept between calls, so each call only loads and hashes
+// the entries added since the previous one. If the provided buffer is then too small, as many whole entries as fit are
+// written and VK_INCOMPLETE is returned.
+//
+// NOTE: Otherwise it is expected that the calling function has not used this pipeline cache since querying the size
 VkResult PipelineBinaryCache::Serialize(
     void*   pBlob,    // [out] System memory pointer where the serialized data should be placed
     size_t* pSize)    // [in,out] Size of the memory pointed to by pBlob. If the value stored in pSize is zero then no
@@ -1364,7 +1566,27 @@ VkResult PipelineBinaryCache::Serialize(
 {
     VkResult result = VK_ERROR_INITIALIZATION_FAILED;
 
-    if (m_pMemoryLayer != nullptr)
+    if ((m_pMemoryLayer != nullptr) && (m_pIncrementalSerializer != nullptr))
+    {
+        Util::MutexAuto lock(&m_serializeMutex);
+
+        Util::Result palResult = m_pIncrementalSerializer->Update(m_pMemoryLayer, m_pTopLayer);
+
+        if (palResult == Util::Result::Success)
+        {
+            if (*pSize == 0)
+            {
+                *pSize = m_pIncrementalSerializer->GetBlobSize();
+            }
+            else
+            {
+                palResult = m_pIncrementalSerializer->Write(pBlob, pSize);
+            }
+        }
+
+        result = (palResult == Util::Result::ErrorIncompleteResults) ? VK_INCOMPLETE : PalToVkResult(palResult);
+    }
+    else if (m_pMemoryLayer != nullptr)
     {
         if (*pSize == 0)
         {
@@ -1420,11 +1642,26 @@ VkResult PipelineBinaryCache::Serialize(
 //
 VkResult PipelineBinaryCache::Merge(
     uint32_t                    srcCacheCount,
-    const PipelineBinaryCache** ppSrcCaches)
+    const PipelineBinaryCache** ppSrcCaches,
+    PipelineCompiler*           pCompiler)
 {
     Pal::Result result = Pal::Result::ErrorInitializationFailed;
 
-    if (m_pMemoryLayer != nullptr)
+    // Stored entries can be copied between memory layers as is when nothing below our memory layer needs to see the
+    // data and we can decode whatever the sources stored.
+    bool copyStoredEntries = (m_pMemoryLayer != nullptr) && (m_pArchiveLayer == nullptr);
+
+    for (uint32_t i = 0; (i < srcCacheCount) && copyStoredEntries; i++)
+    {
+        copyStoredEntries = (ppSrcCaches[i]->m_pMemoryLayer != nullptr) &&
+                            (m_memoryLayerCompressed || (ppSrcCaches[i]->m_memoryLayerCompressed == false));
+    }
+
+    if (copyStoredEntries)
+    {
+        result = MergeMemoryLayers(srcCacheCount, ppSrcCaches, pCompiler);
+    }
+    else if (m_pMemoryLayer != nullptr)
     {
         for (uint32_t i = 0; i < srcCacheCount; i++)
         {
@@ -1468,4 +1705,101 @@ VkResult PipelineBinaryCache::Merge(
             VK_SUCCESS : PalToVkResult(result));
 }
 
+// =====================================================================================================================
+static void ExecuteMemoryLayerMerge(
+    void* pPayload)
+{
+    auto pTask = static_cast<MemoryLayerMergeTask*>(pPayload);
+
+    pTask->result = Util::MergeMemoryCacheLayers(pTask->pDstLayer,
+                                                 pTask->ppSrcLayers,
+                                                 pTask->srcLayerCount,
+                                                 pTask->partIndex,
+                                                 pTask->partCount);
+}
+
+// =====================================================================================================================
+// Copies the stored entries of the source memory layers into ours without loading, decompressing or recompressing
+// them. Our memory layer shards are split into partitions which are merged on the deferred compile workers while the
+// calling thread merges the first one.
+Util::Result PipelineBinaryCache::MergeMemoryLayers(
+    uint32_t                    srcCacheCount,
+    const PipelineBinaryCache** ppSrcCaches,
+    PipelineCompiler*           pCompiler)
+{
+    Util::Result result = Util::Result::Success;
+
+    const uint32_t workerCount = (pCompiler != nullptr) ? pCompiler->GetDeferCompileStats().workerCount : 0;
+    const uint32_t partCount   = Util::Min(workerCount + 1, MaxMergePartitions);
+
+    Util::AutoBuffer<Util::ICacheLayer*, 16, PalAllocator>                  srcLayers(srcCacheCount, &m_palAllocator);
+    Util::AutoBuffer<MemoryLayerMergeTask, MaxMergePartitions, PalAllocator> tasks(partCount, &m_palAllocator);
+
+    if (srcLayers.Capacity() < srcCacheCount)
+    {
+        result = Util::Result::ErrorOutOfMemory;
+    }
+
+    for (uint32_t i = 0; (i < srcCacheCount) && (result == Util::Result::Success); i++)
+    {
+        srcLayers[i] = ppSrcCaches[i]->m_pMemoryLayer;
+    }
+
+    if ((result == Util::Result::Success) && (srcCacheCount > 0))
+    {
+        bool queued[MaxMergePartitions] = {};
+
+        for (uint32_t part = 0; part < partCount; part++)
+        {
+            MemoryLayerMergeTask* pTask = &tasks[part];
+
+            pTask->pDstLayer     = m_pMemoryLayer;
+            pTask->ppSrcLayers   = &srcLayers[0];
+            pTask->srcLayerCount = srcCacheCount;
+            pTask->partIndex     = part;
+            pTask->partCount     = partCount;
+            pTask->result        = Util::Result::Success;
+
+            Util::EventCreateFlags flags = {};
+
+            if ((part > 0) && (pTask->event.Init(flags) == Util::Result::Success))
+            {
+                DeferredCompileWorkload workload = {};
+                workload.pPayloads = pTask;
+                workload.Execute   = ExecuteMemoryLayerMerge;
+                workload.pEvent    = &pTask->event;
+
+                pCompiler->ExecuteDeferCompile(&workload);
+                queued[part] = true;
+            }
+        }
+
+        // Merge the partitions that were not handed to a worker on this thread
+        for (uint32_t part = 0; part < partCount; part++)
+        {
+            if (queued[part] == false)
+            {
+                ExecuteMemoryLayerMerge(&tasks[part]);
+            }
+        }
+
+        for (uint32_t part = 0; part < partCount; part++)
+        {
+            if (queued[part])
+            {
+                while (tasks[part].event.Wait(1.0f) == Util::Result::Timeout)
+                {
+                }
+            }
+
+            if (result == Util::Result::Success)
+            {
+                result = tasks[part].result;
+            }
+        }
+    }
+
+    return result;
+}
+
 } // namespace vk
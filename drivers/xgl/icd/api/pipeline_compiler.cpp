@@ -974,12 +974,25 @@ Util::Result PipelineCompiler::GetCachedPipelineBinary(
     bool*                        pIsUserCacheHit,
     bool*                        pIsInternalCacheHit,
     FreeCompilerBinary*          pFreeCompilerBinary,
-    PipelineCreationFeedback*    pPipelineFeedback)
+    PipelineCreationFeedback*    pPipelineFeedback,
+    PrefetchedPipelineBinary*    pPrefetched)
 {
     Util::Result cacheResult = Util::Result::NotFound;
     int64_t      startTime   = Util::GetPerfCpuTime();
 
-    if (pPipelineBinaryCache != nullptr)
+    if ((pPrefetched != nullptr) &&
+        (pPrefetched->pBinary != nullptr) &&
+        (memcmp(&pPrefetched->cacheId, pCacheId, sizeof(*pCacheId)) == 0))
+    {
+        // Already loaded from the application cache by the batch in Device::Create*Pipelines.
+        *pPipelineBinarySize = pPrefetched->binarySize;
+        *ppPipelineBinary    = pPrefetched->pBinary;
+        pPrefetched->pBinary = nullptr;
+
+        *pIsUserCacheHit = true;
+        pPipelineFeedback->hitApplicationCache = true;
+    }
+    else if (pPipelineBinaryCache != nullptr)
     {
         cacheResult = pPipelineBinaryCache->LoadPipelineBinary(pCacheId, pPipelineBinarySize, ppPipelineBinary);
         if (cacheResult == Util::Result::Success)
@@ -4489,12 +4502,8 @@ void PipelineCompiler::BuildPipelineInternalBufferData(
 void PipelineCompiler::ExecuteDeferCompile(
     DeferredCompileWorkload* pWorkload)
 {
-    auto pThread = m_deferCompileMgr.GetCompileThread();
-    if (pThread != nullptr)
-    {
-        pThread->AddTask(pWorkload);
-    }
-    else
+    // Falls back to compiling on the calling thread if there is no worker thread to hand the task to.
+    if (m_deferCompileMgr.AddTask(*pWorkload) == false)
     {
         pWorkload->Execute(pWorkload->pPayloads);
         if (pWorkload->pEvent != nullptr)
@@ -4582,7 +4591,7 @@ bool PipelineCompiler::IsDefaultPipelineMetadata(
 }
 
 // =====================================================================================================================
-// Parses a given ELF binary and injects the provided metadata chunk
+// Parses a given ELF binary and injects the provided metadata chunk, and the pre-digested PAL metadata if enabled
 VkResult PipelineCompiler::WriteBinaryMetadata(
     const Device*                     pDevice,
     PipelineCompilerType              compilerType,
@@ -4593,7 +4602,10 @@ VkResult PipelineCompiler::WriteBinaryMetadata(
 {
     Pal::Result palResult = Pal::Result::Success;
 
-    if (IsDefaultPipelineMetadata(pMetadata) == false)
+    const bool writeMetadata = (IsDefaultPipelineMetadata(pMetadata) == false);
+    const bool writeDigest   = pDevice->GetRuntimeSettings().enablePipelineMetadataDigest;
+
+    if (writeMetadata || writeDigest)
     {
         void*  pSection        = pMetadata;
         size_t sectionSize     = sizeof(PipelineMetadata);
@@ -4603,7 +4615,7 @@ VkResult PipelineCompiler::WriteBinaryMetadata(
         Util::Abi::PipelineAbiProcessor<PalAllocator> abiProcessor(pDevice->VkInstance()->Allocator());
         palResult = abiProcessor.LoadFromBuffer(*ppElfBinary, *pBinarySize);
 
-        if (palResult == Pal::Result::Success)
+        if ((palResult == Pal::Result::Success) && writeMetadata)
         {
             if (pMetadata->internalBufferInfo.dataSize > 0)
             {
@@ -4624,11 +4636,17 @@ VkResult PipelineCompiler::WriteBinaryMetadata(
                     palResult = Pal::Result::ErrorOutOfMemory;
                 }
             }
+
+            if (palResult == Pal::Result::Success)
+            {
+                palResult = abiProcessor.SetGenericSection(".pipelinemetadata", pSection, sectionSize);
+            }
         }
 
-        if (palResult == Pal::Result::Success)
+        if ((palResult == Pal::Result::Success) && writeDigest)
         {
-            palResult = abiProcessor.SetGenericSection(".pipelinemetadata", pSection, sectionSize);
+            // Lets PAL skip decoding the MessagePack metadata whenever this binary is loaded from a cache.
+            palResult = abiProcessor.AddMetadataDigest();
         }
 
         if (palResult == Pal::Result::Success)
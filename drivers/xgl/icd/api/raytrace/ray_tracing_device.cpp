@@ -928,6 +928,13 @@ Pal::Result RayTracingDevice::ClientAcquireCmdContext(
         result = pCmdContext->pDevice->ResetFences(1, &pCmdContext->pFence);
     }
 
+    if (result == Pal::Result::Success)
+    {
+        // The context is flushed on the PAL queue of one of the device's queues, which must not be in use by that
+        // queue's submission thread at the same time.
+        pDevice->WaitDeferredQueueSubmits();
+    }
+
     if (result == Pal::Result::Success)
     {
         *ppCmdBuffer = pCmdContext->pCmdBuffer;
@@ -734,7 +734,8 @@ VkResult RayTracingPipeline::CreateImpl(
                     &isUserCacheHit,
                     &isInternalCacheHit,
                     &binaryCreateInfo.freeCompilerBinary,
-                    &binaryCreateInfo.pipelineFeedback);
+                    &binaryCreateInfo.pipelineFeedback,
+                    nullptr);
 
                 // Found the pipeline; Add it to any cache layers where it's missing.
                 if (cacheResult == Util::Result::Success)
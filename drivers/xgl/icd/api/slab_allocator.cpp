@@ -0,0 +1,538 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2023 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  slab_allocator.cpp
+ * @brief Contains the implementation of the slab allocator used by the default allocation callbacks.
+ ***********************************************************************************************************************
+ */
+
+#include "include/slab_allocator.h"
+
+#include "palAssert.h"
+#include "palInlineFuncs.h"
+
+#include <new>
+#include <stdlib.h>
+
+namespace vk
+{
+
+namespace allocator
+{
+
+// Block sizes of the size classes, including the block header. The classes are densest around the sizes of the API
+// objects created at high rates (samplers, image and buffer views, descriptor set layouts) and of Util container
+// nodes; pipelines and command buffers fall into the biggest classes.
+static constexpr uint32_t SizeClassBlockSizes[SlabSizeClassCount] =
+{
+      32,   48,   64,   80,   96,  112,  128,  160,
+     192,  224,  256,  320,  384,  448,  512,  640,
+     768,  896, 1024, 1280, 1536, 2048, 3072, 4096
+};
+
+constexpr size_t   BlockHeaderSize = 16;          // Size of the header before each allocation, also the block alignment
+constexpr size_t   SlabSize        = 64 * 1024;   // Size and alignment of the slabs the blocks are carved out of
+constexpr uint32_t LargeClass      = SlabSizeClassCount; // Class of the allocations passed to the system allocator
+constexpr size_t   MaxSlabAllocSize = SizeClassBlockSizes[SlabSizeClassCount - 1] - BlockHeaderSize;
+
+// Header stored right before each allocation.
+struct BlockHeader
+{
+    uint32_t sizeClass;  // Size class of the block, or LargeClass
+    void*    pBase;      // Start of the system allocation, for LargeClass only
+};
+
+static_assert(sizeof(BlockHeader) <= BlockHeaderSize, "Block header does not fit");
+
+// =====================================================================================================================
+// Header at the start of each slab. Slabs are aligned to their size, so a block finds its slab by masking its address.
+struct SlabAllocator::Slab
+{
+    Slab*    pPrev;        // Links in the partial list of the size class
+    Slab*    pNext;
+    void*    pFreeList;    // Free blocks of this slab, linked through their first pointer
+    uint8_t* pCarve;       // Next block to carve out of this slab
+    uint8_t* pCarveEnd;    // End of the carvable part of this slab
+    uint32_t usedBlocks;   // Blocks allocated or cached by a thread
+    uint32_t carvedBlocks; // Blocks carved out so far
+
+    // Returns true if the slab has no block left to hand out, in which case it is not in the partial list.
+    bool IsFull() const { return (pFreeList == nullptr) && (pCarve == pCarveEnd); }
+};
+
+// =====================================================================================================================
+// Per-thread cache of free blocks of each size class.
+struct SlabThreadCache
+{
+    struct Bin
+    {
+        void*    pHead;       // Cached free blocks, linked through their first pointer
+        uint32_t count;       // Number of cached blocks
+        uint32_t allocCount;  // Allocations since the last exchange with the shared lists
+    };
+
+    Bin bins[SlabSizeClassCount];
+
+    // Gives the cached blocks back when the thread exits, as other threads may need them. Having a destructor makes the
+    // runtime keep the ICD loaded while this thread lives, see SlabAllocator.
+    ~SlabThreadCache()
+    {
+        for (uint32_t classIdx = 0; classIdx < SlabSizeClassCount; ++classIdx)
+        {
+            if ((bins[classIdx].count > 0) || (bins[classIdx].allocCount > 0))
+            {
+                SlabAllocator::Get()->ReturnBlocks(classIdx,
+                                                   bins[classIdx].pHead,
+                                                   bins[classIdx].count,
+                                                   bins[classIdx].allocCount);
+            }
+
+            // Later thread-exit code may still allocate; such blocks are simply not returned.
+            bins[classIdx] = {};
+        }
+    }
+};
+
+static thread_local SlabThreadCache t_threadCache;
+
+// =====================================================================================================================
+// Returns the next block of a free list.
+static inline void*& NextBlock(
+    void* pBlock)
+{
+    return *static_cast<void**>(pBlock);
+}
+
+// =====================================================================================================================
+// Returns the process-wide slab allocator. It is never destroyed, as threads may still free blocks during process
+// teardown.
+SlabAllocator* SlabAllocator::Get()
+{
+    alignas(SlabAllocator) static uint8_t s_storage[sizeof(SlabAllocator)];
+    static SlabAllocator* s_pAllocator = new (s_storage) SlabAllocator();
+
+    return s_pAllocator;
+}
+
+// =====================================================================================================================
+SlabAllocator::SlabAllocator()
+    :
+    m_slabCount(0),
+    m_largeAllocCount(0)
+{
+    uint32_t classIdx = 0;
+
+    for (uint32_t units = 0; units < ClassLookupSize; ++units)
+    {
+        while ((classIdx < (SlabSizeClassCount - 1)) && (SizeClassBlockSizes[classIdx] < (units * BlockHeaderSize)))
+        {
+            classIdx++;
+        }
+
+        m_classLookup[units] = static_cast<uint8_t>(classIdx);
+    }
+
+    for (uint32_t i = 0; i < SlabSizeClassCount; ++i)
+    {
+        m_classes[i].pPartial     = nullptr;
+        m_classes[i].pSpare       = nullptr;
+        m_classes[i].carvedBlocks = 0;
+        m_classes[i].freeBlocks   = 0;
+        m_classes[i].allocCount   = 0;
+    }
+}
+
+// =====================================================================================================================
+// Number of blocks a thread cache fetches from or returns to the shared lists at once. The cache holds up to twice as
+// many blocks, which bounds the memory cached per class and thread to about 16 KiB.
+uint32_t SlabAllocator::BatchCount(
+    uint32_t classIdx)
+{
+    return Util::Clamp(4096u / SizeClassBlockSizes[classIdx], 2u, 32u);
+}
+
+// =====================================================================================================================
+// Allocates a block of at least the given size and alignment.
+void* SlabAllocator::Alloc(
+    size_t size,
+    size_t alignment)
+{
+    void* pMem = nullptr;
+
+    if ((size <= MaxSlabAllocSize) && (alignment <= BlockHeaderSize))
+    {
+        const uint32_t classIdx = m_classLookup[(size + (2 * BlockHeaderSize) - 1) / BlockHeaderSize];
+
+        SlabThreadCache::Bin* pBin = &t_threadCache.bins[classIdx];
+
+        if (pBin->count == 0)
+        {
+            pBin->count      = FetchBlocks(classIdx, BatchCount(classIdx), pBin->allocCount, &pBin->pHead);
+            pBin->allocCount = 0;
+        }
+
+        if (pBin->count > 0)
+        {
+            void* pBlock = pBin->pHead;
+
+            pBin->pHead = NextBlock(pBlock);
+            pBin->count--;
+            pBin->allocCount++;
+
+            static_cast<BlockHeader*>(pBlock)->sizeClass = classIdx;
+
+            pMem = Util::VoidPtrInc(pBlock, BlockHeaderSize);
+        }
+    }
+    else
+    {
+        pMem = AllocLarge(size, alignment);
+    }
+
+    return pMem;
+}
+
+// =====================================================================================================================
+// Frees an allocation made by Alloc().
+void SlabAllocator::Free(
+    void* pMem)
+{
+    if (pMem != nullptr)
+    {
+        BlockHeader* pHeader = static_cast<BlockHeader*>(Util::VoidPtrDec(pMem, BlockHeaderSize));
+
+        if (pHeader->sizeClass == LargeClass)
+        {
+            Util::AtomicDecrement64(&m_largeAllocCount);
+
+            free(pHeader->pBase);
+        }
+        else
+        {
+            const uint32_t classIdx = pHeader->sizeClass;
+
+            PAL_ASSERT(classIdx < SlabSizeClassCount);
+
+            SlabThreadCache::Bin* pBin = &t_threadCache.bins[classIdx];
+
+            NextBlock(pHeader) = pBin->pHead;
+            pBin->pHead        = pHeader;
+            pBin->count++;
+
+            const uint32_t batchCount = BatchCount(classIdx);
+
+            if (pBin->count >= (2 * batchCount))
+            {
+                // Keep the most recently freed blocks, which are the most likely to still be in the CPU caches, and
+                // return the others.
+                void* pLastKept = pBin->pHead;
+
+                for (uint32_t i = 1; i < batchCount; ++i)
+                {
+                    pLastKept = NextBlock(pLastKept);
+                }
+
+                ReturnBlocks(classIdx, NextBlock(pLastKept), pBin->count - batchCount, pBin->allocCount);
+
+                NextBlock(pLastKept) = nullptr;
+                pBin->count          = batchCount;
+                pBin->allocCount     = 0;
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Takes up to count blocks of a size class from its slabs, starting a new slab when none has blocks left, and links
+// them into a list. Also accounts for the allocations the calling thread made since its last exchange. Returns the
+// number of blocks taken; zero if out of memory.
+uint32_t SlabAllocator::FetchBlocks(
+    uint32_t classIdx,
+    uint32_t count,
+    uint32_t allocCount,
+    void**   ppHead)
+{
+    SizeClass*     pClass    = &m_classes[classIdx];
+    const uint32_t blockSize = SizeClassBlockSizes[classIdx];
+
+    void*    pHead   = nullptr;
+    uint32_t fetched = 0;
+
+    Util::MutexAuto lock(&pClass->lock);
+
+    pClass->allocCount += allocCount;
+
+    while (fetched < count)
+    {
+        Slab* pSlab = pClass->pPartial;
+
+        if (pSlab == nullptr)
+        {
+            if (pClass->pSpare != nullptr)
+            {
+                pSlab          = pClass->pSpare;
+                pClass->pSpare = nullptr;
+            }
+            else
+            {
+                pSlab = CreateSlab(classIdx);
+            }
+
+            if (pSlab == nullptr)
+            {
+                break;
+            }
+
+            LinkSlab(pClass, pSlab);
+        }
+
+        while ((fetched < count) && (pSlab->pFreeList != nullptr))
+        {
+            void* pBlock = pSlab->pFreeList;
+
+            pSlab->pFreeList  = NextBlock(pBlock);
+            NextBlock(pBlock) = pHead;
+            pHead             = pBlock;
+            pSlab->usedBlocks++;
+            pClass->freeBlocks--;
+            fetched++;
+        }
+
+        while ((fetched < count) && (pSlab->pCarve != pSlab->pCarveEnd))
+        {
+            void* pBlock = pSlab->pCarve;
+
+            pSlab->pCarve    += blockSize;
+            NextBlock(pBlock) = pHead;
+            pHead             = pBlock;
+            pSlab->usedBlocks++;
+            pSlab->carvedBlocks++;
+            pClass->carvedBlocks++;
+            fetched++;
+        }
+
+        if (pSlab->IsFull())
+        {
+            UnlinkSlab(pClass, pSlab);
+        }
+    }
+
+    *ppHead = pHead;
+
+    return fetched;
+}
+
+// =====================================================================================================================
+// Puts a list of count blocks back into the slabs they came from. A slab left with no used block becomes the spare of
+// its class, or goes back to the system if the class already has one. Also accounts for the allocations the calling
+// thread made since its last exchange.
+void SlabAllocator::ReturnBlocks(
+    uint32_t classIdx,
+    void*    pHead,
+    uint32_t count,
+    uint32_t allocCount)
+{
+    SizeClass* pClass = &m_classes[classIdx];
+
+    Util::MutexAuto lock(&pClass->lock);
+
+    pClass->allocCount += allocCount;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        void*       pBlock = pHead;
+        Slab* const pSlab  = static_cast<Slab*>(
+            reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(pBlock) & ~static_cast<uintptr_t>(SlabSize - 1)));
+
+        pHead = NextBlock(pBlock);
+
+        PAL_ASSERT(pSlab->usedBlocks > 0);
+
+        if (pSlab->IsFull())
+        {
+            LinkSlab(pClass, pSlab);
+        }
+
+        NextBlock(pBlock) = pSlab->pFreeList;
+        pSlab->pFreeList  = pBlock;
+        pSlab->usedBlocks--;
+        pClass->freeBlocks++;
+
+        if (pSlab->usedBlocks == 0)
+        {
+            UnlinkSlab(pClass, pSlab);
+
+            if (pClass->pSpare == nullptr)
+            {
+                pClass->pSpare = pSlab;
+            }
+            else
+            {
+                DestroySlab(pClass, pSlab);
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Allocates a new, empty slab for a size class from the system. Returns null if out of memory.
+SlabAllocator::Slab* SlabAllocator::CreateSlab(
+    uint32_t classIdx)
+{
+    constexpr size_t SlabHeaderSize = Util::Pow2Align(sizeof(Slab), BlockHeaderSize);
+
+    const uint32_t blockSize = SizeClassBlockSizes[classIdx];
+
+    void* pMem  = nullptr;
+    Slab* pSlab = nullptr;
+
+    if (posix_memalign(&pMem, SlabSize, SlabSize) == 0)
+    {
+        pSlab = static_cast<Slab*>(pMem);
+
+        pSlab->pPrev        = nullptr;
+        pSlab->pNext        = nullptr;
+        pSlab->pFreeList    = nullptr;
+        pSlab->pCarve       = static_cast<uint8_t*>(pMem) + SlabHeaderSize;
+        pSlab->pCarveEnd    = pSlab->pCarve + (((SlabSize - SlabHeaderSize) / blockSize) * blockSize);
+        pSlab->usedBlocks   = 0;
+        pSlab->carvedBlocks = 0;
+
+        Util::AtomicIncrement64(&m_slabCount);
+    }
+
+    return pSlab;
+}
+
+// =====================================================================================================================
+// Returns an empty slab, which must not be linked into the partial list, to the system.
+void SlabAllocator::DestroySlab(
+    SizeClass* pClass,
+    Slab*      pSlab)
+{
+    PAL_ASSERT(pSlab->usedBlocks == 0);
+
+    // All of the slab's carved blocks are in its free list.
+    pClass->carvedBlocks -= pSlab->carvedBlocks;
+    pClass->freeBlocks   -= pSlab->carvedBlocks;
+
+    Util::AtomicDecrement64(&m_slabCount);
+
+    free(pSlab);
+}
+
+// =====================================================================================================================
+// Links a slab into the partial list of its size class.
+void SlabAllocator::LinkSlab(
+    SizeClass* pClass,
+    Slab*      pSlab)
+{
+    pSlab->pPrev = nullptr;
+    pSlab->pNext = pClass->pPartial;
+
+    if (pClass->pPartial != nullptr)
+    {
+        pClass->pPartial->pPrev = pSlab;
+    }
+
+    pClass->pPartial = pSlab;
+}
+
+// =====================================================================================================================
+// Unlinks a slab from the partial list of its size class.
+void SlabAllocator::UnlinkSlab(
+    SizeClass* pClass,
+    Slab*      pSlab)
+{
+    if (pSlab->pPrev != nullptr)
+    {
+        pSlab->pPrev->pNext = pSlab->pNext;
+    }
+    else
+    {
+        pClass->pPartial = pSlab->pNext;
+    }
+
+    if (pSlab->pNext != nullptr)
+    {
+        pSlab->pNext->pPrev = pSlab->pPrev;
+    }
+
+    pSlab->pPrev = nullptr;
+    pSlab->pNext = nullptr;
+}
+
+// =====================================================================================================================
+// Passes an allocation which is too big or too strictly aligned for the slabs to the system allocator, leaving room for
+// the block header in front of it.
+void* SlabAllocator::AllocLarge(
+    size_t size,
+    size_t alignment)
+{
+    const size_t offset = Util::Max(alignment, BlockHeaderSize);
+
+    void* pBase = nullptr;
+    void* pMem  = nullptr;
+
+    if ((size <= (SIZE_MAX - offset)) && (posix_memalign(&pBase, offset, size + offset) == 0))
+    {
+        pMem = Util::VoidPtrInc(pBase, offset);
+
+        BlockHeader* pHeader = static_cast<BlockHeader*>(Util::VoidPtrDec(pMem, BlockHeaderSize));
+
+        pHeader->sizeClass = LargeClass;
+        pHeader->pBase     = pBase;
+
+        Util::AtomicIncrement64(&m_largeAllocCount);
+    }
+
+    return pMem;
+}
+
+// =====================================================================================================================
+// Returns a snapshot of the allocator statistics.
+void SlabAllocator::GetStats(
+    SlabAllocatorStats* pStats)
+{
+    for (uint32_t classIdx = 0; classIdx < SlabSizeClassCount; ++classIdx)
+    {
+        SizeClass* pClass = &m_classes[classIdx];
+
+        Util::MutexAuto lock(&pClass->lock);
+
+        pStats->classes[classIdx].blockSize    = SizeClassBlockSizes[classIdx];
+        pStats->classes[classIdx].carvedBlocks = pClass->carvedBlocks;
+        pStats->classes[classIdx].freeBlocks   = pClass->freeBlocks;
+        pStats->classes[classIdx].allocCount   = pClass->allocCount;
+    }
+
+    pStats->slabCount       = m_slabCount;
+    pStats->largeAllocCount = m_largeAllocCount;
+}
+
+} // namespace allocator
+
+} // namespace vk
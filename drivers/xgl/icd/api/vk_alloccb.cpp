@@ -29,6 +29,8 @@
  ***********************************************************************************************************************
  */
 
+#include "include/log.h"
+#include "include/slab_allocator.h"
 #include "include/vk_alloccb.h"
 #include "include/vk_utils.h"
 
@@ -48,7 +50,8 @@ namespace allocator
 
 // ===============================================================================================
 // Default memory allocation callback used when application does not supply a callback function
-// of its own. Currently just punts to stock new []. Alignment and alloc types are ignored.
+// of its own. Small allocations come from the slab allocator if it is built in, the others go to
+// posix_memalign. Alloc types are ignored.
 void* VKAPI_PTR
     DefaultAllocFunc(
     void*                                   pUserData,
@@ -57,7 +60,9 @@ void* VKAPI_PTR
     VkSystemAllocationScope                 allocType)
 {
     void* pMemory;
-#if _POSIX_VERSION >= 200112L
+#if ICD_SLAB_ALLOCATOR
+    pMemory = SlabAllocator::Get()->Alloc(size, alignment);
+#elif _POSIX_VERSION >= 200112L
     // posix_memalign is unilaterally preferred over aligned_alloc for several reasons
     //  - Older versions of glibc have it (eg, for RHEL6)
     //  - Several shipping games override the global allocator, but use an old enough lib that aligned_alloc's aren't
@@ -93,13 +98,14 @@ static void* VKAPI_PTR
 }
 
 // =====================================================================================================================
-// Default memory free callback used when application does not supply a callback function of its own. Currently just
-// punts to stock delete [].
+// Default memory free callback used when application does not supply a callback function of its own.
 void VKAPI_PTR DefaultFreeFunc(
     void*                                   pUserData,
     void*                                   pMem)
 {
-#if __STDC_VERSION__ >= 201112L
+#if ICD_SLAB_ALLOCATOR
+    SlabAllocator::Get()->Free(pMem);
+#elif __STDC_VERSION__ >= 201112L
     free(pMem);
 #elif _POSIX_VERSION >= 200112L
     free(pMem);
@@ -183,6 +189,38 @@ void PAL_STDCALL PalFreeFuncDelegator(
     pVkCallbacks->pfnFree(pVkCallbacks->pUserData, pMem);
 }
 
+#if ICD_SLAB_ALLOCATOR
+// =====================================================================================================================
+// Writes the statistics of the slab allocator behind the default callbacks to the log.
+void LogSlabAllocatorStats(
+    uint64_t logTagIdMask)
+{
+    if ((logTagIdMask & (1ull << GeneralPrint)) != 0)
+    {
+        SlabAllocatorStats stats = {};
+        SlabAllocator::Get()->GetStats(&stats);
+
+        AmdvlkLog(logTagIdMask, GeneralPrint, "Slab allocator: %llu slabs, %llu live system allocations",
+                  static_cast<unsigned long long>(stats.slabCount),
+                  static_cast<unsigned long long>(stats.largeAllocCount));
+
+        for (uint32_t classIdx = 0; classIdx < SlabSizeClassCount; ++classIdx)
+        {
+            const SlabClassStats& classStats = stats.classes[classIdx];
+
+            if (classStats.carvedBlocks > 0)
+            {
+                AmdvlkLog(logTagIdMask, GeneralPrint, "  %4zu byte blocks: %llu carved, %llu free, %llu allocations",
+                          classStats.blockSize,
+                          static_cast<unsigned long long>(classStats.carvedBlocks),
+                          static_cast<unsigned long long>(classStats.freeBlocks),
+                          static_cast<unsigned long long>(classStats.allocCount));
+            }
+        }
+    }
+}
+#endif
+
 } // namespace allocator
 
 // =====================================================================================================================
@@ -184,13 +184,75 @@ VkResult ComputePipeline::Destroy(
 }
 
 // =====================================================================================================================
-// Create a compute pipeline object.
+// Computes the default device's cache id of a compute pipeline ahead of Create(), so the binary can be loaded as part of
+// a batch.  Returns false if the id can't be computed cheaply, i.e. when the shader module is not an existing object.
+bool ComputePipeline::GetPrefetchCacheId(
+    const Device*                           pDevice,
+    const VkComputePipelineCreateInfo*      pCreateInfo,
+    PipelineCreateFlags                     flags,
+    Util::MetroHash::Hash*                  pCacheId)
+{
+    bool canPrefetch = (pCreateInfo->stage.module != VK_NULL_HANDLE);
+
+    ComputePipelineShaderStageInfo shaderInfo = {};
+
+    if (canPrefetch)
+    {
+        canPrefetch = (BuildShaderStageInfo(pDevice,
+                                            1,
+                                            &pCreateInfo->stage,
+                                            false,
+                                            [](const uint32_t inputIdx, const uint32_t stageIdx)
+                                            {
+                                                return 0u;
+                                            },
+                                            &shaderInfo.stage,
+                                            nullptr,
+                                            nullptr,
+                                            nullptr) == VK_SUCCESS);
+    }
+
+    if (canPrefetch)
+    {
+        Util::MetroHash::Hash elfHash              = {};
+        uint64_t              apiPsoHash           = {};
+        PipelineOptimizerKey  pipelineOptimizerKey = {};
+        ShaderOptimizerKey    shaderOptimizerKey   = {};
+
+        BuildApiHash(pCreateInfo, flags, shaderInfo, &elfHash, &apiPsoHash);
+
+        pipelineOptimizerKey.shaderCount = 1;
+        pipelineOptimizerKey.pShaders    = &shaderOptimizerKey;
+
+        pDevice->GetShaderOptimizer()->CreateShaderOptimizerKey(
+            ShaderModule::GetFirstValidShaderData(shaderInfo.stage.pModuleHandle),
+            shaderInfo.stage.codeHash,
+            Vkgc::ShaderStage::ShaderStageCompute,
+            shaderInfo.stage.codeSize,
+            &shaderOptimizerKey);
+
+        ElfHashToCacheId(
+            pDevice,
+            DefaultDeviceIndex,
+            elfHash,
+            pDevice->VkPhysicalDevice(DefaultDeviceIndex)->GetSettingsLoader()->GetSettingsHash(),
+            pipelineOptimizerKey,
+            pCacheId);
+    }
+
+    return canPrefetch;
+}
+
+// =====================================================================================================================
+// Create a compute pipeline object.  pPrefetched, if not null, holds this pipeline's binary if it was loaded from the
+// application cache ahead of time.
 VkResult ComputePipeline::Create(
     Device*                                 pDevice,
     PipelineCache*                          pPipelineCache,
     const VkComputePipelineCreateInfo*      pCreateInfo,
     PipelineCreateFlags                     flags,
     const VkAllocationCallbacks*            pAllocator,
+    PrefetchedPipelineBinary*               pPrefetched,
     VkPipeline*                             pPipeline)
 {
     uint64 startTimeTicks = Util::GetPerfCpuTime();
@@ -279,7 +341,8 @@ VkResult ComputePipeline::Create(
                     &isUserCacheHit,
                     &isInternalCacheHit,
                     &binaryCreateInfo.freeCompilerBinary,
-                    &binaryCreateInfo.pipelineFeedback);
+                    &binaryCreateInfo.pipelineFeedback,
+                    pPrefetched);
             }
 
             // Compile if unable to retrieve from cache
@@ -376,6 +376,39 @@ void DescriptorUpdate::WriteBufferDescriptors(
     }
 }
 
+// Maximum number of buffer views whose SRDs are built by a single PAL call when writing bufferInfo descriptors
+static constexpr uint32_t BufferSrdBatchSize = 32;
+
+// =====================================================================================================================
+// Builds the SRDs for a run of consecutive buffer descriptors with one PAL call.  They are written straight into the
+// set when the descriptors are tightly packed and copied out of a scratch array otherwise.
+template <size_t bufferDescSize>
+static void CreateBufferSrdBatch(
+    Pal::IDevice*              pPalDevice,
+    const Pal::BufferViewInfo* pInfos,
+    uint32_t                   count,
+    uint32_t*                  pDestAddr,
+    uint32_t                   dwStride)
+{
+    VK_ASSERT((count > 0) && (count <= BufferSrdBatchSize));
+
+    if ((dwStride * sizeof(uint32_t)) == bufferDescSize)
+    {
+        pPalDevice->CreateUntypedBufferViewSrds(count, pInfos, pDestAddr);
+    }
+    else
+    {
+        uint32_t srds[BufferSrdBatchSize][bufferDescSize / sizeof(uint32_t)];
+
+        pPalDevice->CreateUntypedBufferViewSrds(count, pInfos, srds);
+
+        for (uint32_t i = 0; i < count; ++i, pDestAddr += dwStride)
+        {
+            memcpy(pDestAddr, srds[i], bufferDescSize);
+        }
+    }
+}
+
 // =====================================================================================================================
 // Write buffer descriptors using bufferInfo field used with uniform and storage buffers
 template <size_t bufferDescSize, VkDescriptorType type>
@@ -391,68 +424,97 @@ void DescriptorUpdate::WriteBufferInfoDescriptors(
     const VkDescriptorBufferInfo* pBufferInfo      = pDescriptors;
     const size_t                  bufferInfoStride = (descriptorStrideInBytes != 0) ? descriptorStrideInBytes
                                                                                     : sizeof(VkDescriptorBufferInfo);
-    Pal::BufferViewInfo info = {};
 
     VK_ASSERT((type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)         ||
               (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) ||
               (type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)         ||
               (type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC));
 
-    // Setup and create SRD for storage buffer case
-    info.swizzledFormat = Pal::UndefinedSwizzledFormat;
-    info.stride         = 0; // Raw buffers have a zero byte stride
+    const bool compactDynamic = pDevice->UseCompactDynamicDescriptors() &&
+                                ((type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC) ||
+                                 (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC));
 
     Pal::IDevice* pPalDevice = pDevice->PalDevice(deviceIdx);
 
+    // Consecutive non-null descriptors are gathered here and their SRDs built together.
+    Pal::BufferViewInfo infos[BufferSrdBatchSize];
+    uint32_t            batchCount = 0;
+    uint32_t*           pBatchDest = pDestAddr;
+
     // Build the SRD
     for (uint32_t arrayElem = 0; arrayElem < count; ++arrayElem, pDestAddr += dwStride)
     {
         if (pBufferInfo->buffer == VK_NULL_HANDLE)
         {
-            if (pDevice->UseCompactDynamicDescriptors() &&
-                ((type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC) ||
-                 (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)))
+            if (compactDynamic)
             {
                 pDestAddr[0] = 0;
                 pDestAddr[1] = 0;
             }
             else
             {
+                // A null descriptor breaks the run of SRDs being gathered.
+                if (batchCount > 0)
+                {
+                    CreateBufferSrdBatch<bufferDescSize>(pPalDevice, infos, batchCount, pBatchDest, dwStride);
+                    batchCount = 0;
+                }
+
                 memset(pDestAddr, 0, bufferDescSize);
             }
         }
         else
         {
-            info.gpuAddr = Buffer::ObjectFromHandle(pBufferInfo->buffer)->GpuVirtAddr(deviceIdx) + pBufferInfo->offset;
+            const Pal::gpusize gpuAddr =
+                Buffer::ObjectFromHandle(pBufferInfo->buffer)->GpuVirtAddr(deviceIdx) + pBufferInfo->offset;
 
-            if (pDevice->UseCompactDynamicDescriptors() &&
-                ((type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC) ||
-                 (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)))
+            if (compactDynamic)
             {
-                pDestAddr[0] = Util::LowPart(info.gpuAddr);
-                pDestAddr[1] = Util::HighPart(info.gpuAddr);
+                pDestAddr[0] = Util::LowPart(gpuAddr);
+                pDestAddr[1] = Util::HighPart(gpuAddr);
             }
             else
             {
+                if (batchCount == 0)
+                {
+                    pBatchDest = pDestAddr;
+                }
+
+                Pal::BufferViewInfo* pInfo = &infos[batchCount++];
+
+                *pInfo = {};
+                pInfo->gpuAddr        = gpuAddr;
+                pInfo->swizzledFormat = Pal::UndefinedSwizzledFormat;
+                pInfo->stride         = 0; // Raw buffers have a zero byte stride
+
                 if (pBufferInfo->range == VK_WHOLE_SIZE)
                 {
-                    info.range = reinterpret_cast<Buffer*>(pBufferInfo->buffer)->GetSize() - pBufferInfo->offset;
+                    pInfo->range = reinterpret_cast<Buffer*>(pBufferInfo->buffer)->GetSize() - pBufferInfo->offset;
                 }
                 else
                 {
-                    info.range = pBufferInfo->range;
+                    pInfo->range = pBufferInfo->range;
                 }
 
                 // Align the buffer range in srd to dword. This should be safe since the buffer memory size will be
                 // dword-aligned - we have an at least 4-byte alignment requirement in vkGetBufferMemoryRequirements.
-                info.range = Util::RoundUpToMultiple(info.range, static_cast<Pal::gpusize>(sizeof(uint32_t)));
+                pInfo->range = Util::RoundUpToMultiple(pInfo->range, static_cast<Pal::gpusize>(sizeof(uint32_t)));
 
-                pPalDevice->CreateUntypedBufferViewSrds(1, &info, pDestAddr);
+                if (batchCount == BufferSrdBatchSize)
+                {
+                    CreateBufferSrdBatch<bufferDescSize>(pPalDevice, infos, batchCount, pBatchDest, dwStride);
+                    batchCount = 0;
+                }
             }
         }
 
         pBufferInfo = static_cast<const VkDescriptorBufferInfo*>(Util::VoidPtrInc(pBufferInfo, bufferInfoStride));
     }
+
+    if (batchCount > 0)
+    {
+        CreateBufferSrdBatch<bufferDescSize>(pPalDevice, infos, batchCount, pBatchDest, dwStride);
+    }
 }
 
 #if VKI_RAY_TRACING
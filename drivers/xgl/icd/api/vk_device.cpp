@@ -66,6 +66,8 @@
 #include "include/vk_conv.h"
 #include "include/cmd_buffer_ring.h"
 #include "include/graphics_pipeline_common.h"
+#include "include/pipeline_binary_cache.h"
+#include "include/vk_graphics_pipeline.h"
 #include "include/internal_layer_hooks.h"
 
 #if VKI_RAY_TRACING
@@ -1917,7 +1919,8 @@ VkResult Device::CreateInternalComputePipeline(
                 &isUserCacheHit,
                 &isInternalCacheHit,
                 &pipelineBuildInfo.freeCompilerBinary,
-                &pipelineBuildInfo.pipelineFeedback);
+                &pipelineBuildInfo.pipelineFeedback,
+                nullptr);
         }
 
         if (cacheResult != Util::Result::Success)
@@ -2142,6 +2145,66 @@ VkResult Device::WaitIdle(void)
     return result;
 }
 
+// =====================================================================================================================
+// Waits until the submission threads of the queues in queueMask (see Queue::GetQueueMask()) have passed every
+// submission queued so far to PAL. Must be called before any host operation which observes the effects of those
+// submissions. Returns the unreported error of a failed deferred submission of the synced queues, or
+// VK_ERROR_DEVICE_LOST once a deferred submission of any queue, synced or not, has reported device loss.
+VkResult Device::SyncDeferredQueueSubmits(
+    uint64_t queueMask)
+{
+    VkResult result = VK_SUCCESS;
+
+    if (GetRuntimeSettings().enableThreadedQueueSubmit)
+    {
+        for (uint32_t i = 0; i < Queue::MaxQueueFamilies; ++i)
+        {
+            for (uint32_t j = 0; (j < Queue::MaxQueuesPerFamily) && (m_pQueues[i][j] != nullptr); ++j)
+            {
+                Queue* pQueue = static_cast<Queue*>(*m_pQueues[i][j]);
+
+                VkResult queueResult = VK_SUCCESS;
+
+                if ((pQueue->GetQueueMask() & queueMask) != 0)
+                {
+                    queueResult = pQueue->SyncDeferredSubmits();
+                }
+                else if (pQueue->IsDeferredSubmitLost())
+                {
+                    queueResult = VK_ERROR_DEVICE_LOST;
+                }
+
+                result = (result == VK_SUCCESS) ? queueResult : result;
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Waits as SyncDeferredQueueSubmits() does, for callers which cannot report an error. Any error stays pending on its
+// queue until a sync which reports it.
+void Device::WaitDeferredQueueSubmits(
+    uint64_t queueMask)
+{
+    if (GetRuntimeSettings().enableThreadedQueueSubmit)
+    {
+        for (uint32_t i = 0; i < Queue::MaxQueueFamilies; ++i)
+        {
+            for (uint32_t j = 0; (j < Queue::MaxQueuesPerFamily) && (m_pQueues[i][j] != nullptr); ++j)
+            {
+                Queue* pQueue = static_cast<Queue*>(*m_pQueues[i][j]);
+
+                if ((pQueue->GetQueueMask() & queueMask) != 0)
+                {
+                    pQueue->WaitDeferredSubmits();
+                }
+            }
+        }
+    }
+}
+
 // =====================================================================================================================
 // Creates a new GPU memory object
 VkResult Device::AllocMemory(
@@ -2287,7 +2350,15 @@ VkResult Device::WaitForFences(
 
     Pal::IFence** ppPalFences = static_cast<Pal::IFence**>(VK_ALLOC_A(sizeof(Pal::IFence*) * fenceCount));
 
-    if (IsMultiGpu() == false)
+    // Submissions still queued on a submission thread must reach PAL before their fences can be waited on. Skip the
+    // wait if one of them failed, as its fence may never be signaled.
+    const VkResult syncResult = SyncDeferredQueueSubmits(Fence::GetDeferredSignalQueues(fenceCount, pFences));
+
+    if (syncResult != VK_SUCCESS)
+    {
+        palResult = Pal::Result::ErrorUnknown;
+    }
+    else if (IsMultiGpu() == false)
     {
         for (uint32_t i = 0; i < fenceCount; ++i)
         {
@@ -2328,7 +2399,7 @@ VkResult Device::WaitForFences(
             }
         }
     }
-    return PalToVkResult(palResult);
+    return (syncResult != VK_SUCCESS) ? syncResult : PalToVkResult(palResult);
 }
 
 // =====================================================================================================================
@@ -2515,6 +2586,94 @@ VkResult Device::CreateImageView(
     return ImageView::Create(this, pCreateInfo, pAllocator, pView);
 }
 
+// =====================================================================================================================
+// Loads the application cache binaries of a vkCreate*Pipelines batch before any of the pipelines are created, so that
+// PipelineBinaryCache::LoadPipelineBinaries() can resolve them together and read the archive in entry order rather than
+// seeking once per pipeline.  pPrefetched[i] receives the binary of pCreateInfos[i], or a null binary if the id could
+// not be computed up front or missed.  Binaries not consumed by pipeline creation are freed by FreePrefetchedBinaries().
+template <typename PipelineType, typename CreateInfoType>
+static void PrefetchPipelineBinaries(
+    const Device*             pDevice,
+    PipelineCache*            pPipelineCache,
+    uint32_t                  count,
+    const CreateInfoType*     pCreateInfos,
+    PrefetchedPipelineBinary* pPrefetched)
+{
+    PipelineBinaryCache* pBinaryCache = pPipelineCache->GetPipelineCache();
+    PalAllocator*        pAllocator   = pDevice->VkInstance()->Allocator();
+
+    Util::AutoBuffer<PipelineBinaryCache::CacheId, 8, PalAllocator> cacheIds(count, pAllocator);
+    Util::AutoBuffer<size_t, 8, PalAllocator>                       binarySizes(count, pAllocator);
+    Util::AutoBuffer<const void*, 8, PalAllocator>                  binaries(count, pAllocator);
+    Util::AutoBuffer<Util::Result, 8, PalAllocator>                 results(count, pAllocator);
+    Util::AutoBuffer<uint32_t, 8, PalAllocator>                     slots(count, pAllocator);
+
+    if ((cacheIds.Capacity() >= count) &&
+        (binarySizes.Capacity() >= count) &&
+        (binaries.Capacity() >= count) &&
+        (results.Capacity() >= count) &&
+        (slots.Capacity() >= count))
+    {
+        uint32_t numIds = 0;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const PipelineCreateFlags flags = Device::GetPipelineCreateFlags(&pCreateInfos[i]);
+
+            if (PipelineType::GetPrefetchCacheId(pDevice, &pCreateInfos[i], flags, &pPrefetched[i].cacheId))
+            {
+                cacheIds[numIds] = pPrefetched[i].cacheId;
+                slots[numIds]    = i;
+                numIds++;
+            }
+        }
+
+        if (numIds > 1)
+        {
+            pBinaryCache->LoadPipelineBinaries(numIds, &cacheIds[0], &binarySizes[0], &binaries[0], &results[0]);
+
+            for (uint32_t id = 0; id < numIds; ++id)
+            {
+                if (results[id] == Util::Result::Success)
+                {
+                    pPrefetched[slots[id]].binarySize = binarySizes[id];
+                    pPrefetched[slots[id]].pBinary    = binaries[id];
+                }
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Frees the prefetched binaries that pipeline creation did not take ownership of.
+static void FreePrefetchedBinaries(
+    PipelineCache*            pPipelineCache,
+    uint32_t                  count,
+    PrefetchedPipelineBinary* pPrefetched)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (pPrefetched[i].pBinary != nullptr)
+        {
+            pPipelineCache->GetPipelineCache()->FreePipelineBinary(pPrefetched[i].pBinary);
+            pPrefetched[i].pBinary = nullptr;
+        }
+    }
+}
+
+// =====================================================================================================================
+// Whether the binaries of a vkCreate*Pipelines batch should be loaded from the application cache as one batch.
+static bool ShouldPrefetchPipelineBinaries(
+    const Device*  pDevice,
+    PipelineCache* pPipelineCache,
+    uint32_t       count)
+{
+    return (count > 1)                                       &&
+           (pPipelineCache != nullptr)                       &&
+           (pPipelineCache->GetPipelineCache() != nullptr)   &&
+           (pDevice->GetRuntimeSettings().enablePipelineDump == false);
+}
+
 // =====================================================================================================================
 VkResult Device::CreateGraphicsPipelines(
     VkPipelineCache                             pipelineCache,
@@ -2535,6 +2694,18 @@ VkResult Device::CreateGraphicsPipelines(
         pPipelines[i] = VK_NULL_HANDLE;
     }
 
+    Util::AutoBuffer<PrefetchedPipelineBinary, 8, PalAllocator> prefetched(count, VkInstance()->Allocator());
+
+    const bool usePrefetch = ShouldPrefetchPipelineBinaries(this, pPipelineCache, count) &&
+                             (prefetched.Capacity() >= count);
+
+    if (usePrefetch)
+    {
+        memset(&prefetched[0], 0, sizeof(PrefetchedPipelineBinary) * count);
+
+        PrefetchPipelineBinaries<GraphicsPipeline>(this, pPipelineCache, count, pCreateInfos, &prefetched[0]);
+    }
+
     for (uint32_t i = 0; i < count; ++i)
     {
         const VkGraphicsPipelineCreateInfo* pCreateInfo = &pCreateInfos[i];
@@ -2546,6 +2717,7 @@ VkResult Device::CreateGraphicsPipelines(
             pCreateInfo,
             flags,
             pAllocator,
+            usePrefetch ? &prefetched[i] : nullptr,
             &pPipelines[i]);
 
         if (result != VK_SUCCESS)
@@ -2563,6 +2735,11 @@ VkResult Device::CreateGraphicsPipelines(
         }
     }
 
+    if (usePrefetch)
+    {
+        FreePrefetchedBinaries(pPipelineCache, count, &prefetched[0]);
+    }
+
     return finalResult;
 }
 
@@ -2586,6 +2763,18 @@ VkResult Device::CreateComputePipelines(
         pPipelines[i] = VK_NULL_HANDLE;
     }
 
+    Util::AutoBuffer<PrefetchedPipelineBinary, 8, PalAllocator> prefetched(count, VkInstance()->Allocator());
+
+    const bool usePrefetch = ShouldPrefetchPipelineBinaries(this, pPipelineCache, count) &&
+                             (prefetched.Capacity() >= count);
+
+    if (usePrefetch)
+    {
+        memset(&prefetched[0], 0, sizeof(PrefetchedPipelineBinary) * count);
+
+        PrefetchPipelineBinaries<ComputePipeline>(this, pPipelineCache, count, pCreateInfos, &prefetched[0]);
+    }
+
     for (uint32_t i = 0; i < count; ++i)
     {
         const VkComputePipelineCreateInfo* pCreateInfo = &pCreateInfos[i];
@@ -2598,6 +2787,7 @@ VkResult Device::CreateComputePipelines(
                 pCreateInfo,
                 flags,
                 pAllocator,
+                usePrefetch ? &prefetched[i] : nullptr,
                 &pPipelines[i]);
 
         if (result != VK_SUCCESS)
@@ -2615,6 +2805,11 @@ VkResult Device::CreateComputePipelines(
         }
     }
 
+    if (usePrefetch)
+    {
+        FreePrefetchedBinaries(pPipelineCache, count, &prefetched[0]);
+    }
+
     return finalResult;
 }
 
@@ -3001,7 +3196,15 @@ VkResult Device::GetSemaphoreCounterValue(
 {
     Semaphore* pSemaphore = Semaphore::ObjectFromHandle(semaphore);
 
-    return pSemaphore->GetSemaphoreCounterValue(this, pSemaphore, pValue);
+    // Deferred submissions signaling the semaphore must reach PAL before its value is meaningful.
+    VkResult result = SyncDeferredQueueSubmits(Semaphore::GetDeferredSignalQueues(1, &semaphore));
+
+    if (result == VK_SUCCESS)
+    {
+        result = pSemaphore->GetSemaphoreCounterValue(this, pSemaphore, pValue);
+    }
+
+    return result;
 }
 
 // =====================================================================================================================
@@ -3026,10 +3229,18 @@ VkResult Device::WaitSemaphores(
     {
         flags |= Pal::HostWaitFlags::HostWaitAny;
     }
-    palResult = PalDevice(DefaultDeviceIndex)->WaitForSemaphores(pWaitInfo->semaphoreCount, ppPalSemaphores,
-            pWaitInfo->pValues, flags, timeout);
 
-    return PalToVkResult(palResult);
+    // Submissions still queued on a submission thread must reach PAL before their signals can be waited on.
+    const VkResult syncResult = SyncDeferredQueueSubmits(
+        Semaphore::GetDeferredSignalQueues(pWaitInfo->semaphoreCount, pWaitInfo->pSemaphores));
+
+    if (syncResult == VK_SUCCESS)
+    {
+        palResult = PalDevice(DefaultDeviceIndex)->WaitForSemaphores(pWaitInfo->semaphoreCount, ppPalSemaphores,
+                pWaitInfo->pValues, flags, timeout);
+    }
+
+    return (syncResult != VK_SUCCESS) ? syncResult : PalToVkResult(palResult);
 }
 
 // =====================================================================================================================
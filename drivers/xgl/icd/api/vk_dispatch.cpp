@@ -621,6 +621,11 @@ void DispatchTable::Init()
     INIT_DISPATCH_ENTRY(vkResetQueryPool                                );
     INIT_DISPATCH_ALIAS(vkResetQueryPoolEXT                             ,
                         vkResetQueryPool                                );
+    INIT_DISPATCH_ENTRY(vkCopyMemoryToImageEXT                          );
+    INIT_DISPATCH_ENTRY(vkCopyImageToMemoryEXT                          );
+    INIT_DISPATCH_ENTRY(vkCopyImageToImageEXT                           );
+    INIT_DISPATCH_ENTRY(vkTransitionImageLayoutEXT                      );
+    INIT_DISPATCH_ENTRY(vkGetImageSubresourceLayout2EXT                 );
     INIT_DISPATCH_ENTRY(vkCmdSetLineStippleEXT                          );
 
     INIT_DISPATCH_ENTRY(vkSetDeviceMemoryPriorityEXT                    );
@@ -146,6 +146,21 @@ VkResult Fence::Destroy(
     return VK_SUCCESS;
 }
 
+// =====================================================================================================================
+uint64_t Fence::GetDeferredSignalQueues(
+    uint32_t       fenceCount,
+    const VkFence* pFences)
+{
+    uint64_t queueMask = 0;
+
+    for (uint32_t i = 0; i < fenceCount; ++i)
+    {
+        queueMask |= Fence::ObjectFromHandle(pFences[i])->m_deferredSignalQueues.load(std::memory_order_relaxed);
+    }
+
+    return queueMask;
+}
+
 // =====================================================================================================================
 // Retrieve the status of a fence object
 VkResult Fence::GetStatus(void)
@@ -280,6 +295,10 @@ VkResult Fence::GetFenceFd(
     VK_ASSERT((pGetFdInfo->handleType == VK_EXTERNAL_FENCE_HANDLE_TYPE_OPAQUE_FD_BIT_KHR) ||
               (pGetFdInfo->handleType == VK_EXTERNAL_FENCE_HANDLE_TYPE_SYNC_FD_BIT_KHR));
 
+    // A sync fd captures the payload at export time, which must include the submissions still queued on a submission
+    // thread.
+    pDevice->WaitDeferredQueueSubmits(m_deferredSignalQueues.load(std::memory_order_relaxed));
+
     Pal::FenceExportInfo exportInfo = {};
     exportInfo.flags.isReference   = (pGetFdInfo->handleType == VK_EXTERNAL_FENCE_HANDLE_TYPE_OPAQUE_FD_BIT_KHR);
     exportInfo.flags.implicitReset = (pGetFdInfo->handleType == VK_EXTERNAL_FENCE_HANDLE_TYPE_SYNC_FD_BIT_KHR);
@@ -319,7 +338,16 @@ VKAPI_ATTR VkResult VKAPI_CALL vkGetFenceStatus(
     VkDevice                                    device,
     VkFence                                     fence)
 {
-    return Fence::ObjectFromHandle(fence)->GetStatus();
+    // Submissions still queued on a submission thread must reach PAL before the fence status is meaningful.
+    VkResult result = ApiDevice::ObjectFromHandle(device)->SyncDeferredQueueSubmits(
+        Fence::GetDeferredSignalQueues(1, &fence));
+
+    if (result == VK_SUCCESS)
+    {
+        result = Fence::ObjectFromHandle(fence)->GetStatus();
+    }
+
+    return result;
 }
 
 VKAPI_ATTR void VKAPI_CALL vkDestroyFence(
@@ -68,7 +68,8 @@ VkResult GraphicsPipeline::CreatePipelineBinaries(
     Util::MetroHash::Hash*                         pCacheIds,
     size_t*                                        pPipelineBinarySizes,
     const void**                                   ppPipelineBinaries,
-    PipelineMetadata*                              pBinaryMetadata)
+    PipelineMetadata*                              pBinaryMetadata,
+    PrefetchedPipelineBinary*                      pPrefetched)
 {
     VkResult          result           = VK_SUCCESS;
     const uint32_t    numPalDevices    = pDevice->NumPalDevices();
@@ -109,7 +110,8 @@ VkResult GraphicsPipeline::CreatePipelineBinaries(
                     &isUserCacheHit,
                     &isInternalCacheHit,
                     &pBinaryCreateInfo->freeCompilerBinary,
-                    &pBinaryCreateInfo->pipelineFeedback);
+                    &pBinaryCreateInfo->pipelineFeedback,
+                    pPrefetched);
 
                 // Compile if not found in cache
                 shouldCompile = (cacheResult != Util::Result::Success);
@@ -532,13 +534,80 @@ VkResult GraphicsPipeline::CreatePipelineObjects(
 }
 
 // =====================================================================================================================
-// Create a graphics pipeline object.
+// Computes the default device's cache id of a graphics pipeline ahead of Create(), so the binary can be loaded as part of
+// a batch.  Returns false if the id can't be computed cheaply: pipelines linked from libraries, or stages which are not
+// existing shader module objects.
+bool GraphicsPipeline::GetPrefetchCacheId(
+    const Device*                           pDevice,
+    const VkGraphicsPipelineCreateInfo*     pCreateInfo,
+    PipelineCreateFlags                     flags,
+    Util::MetroHash::Hash*                  pCacheId)
+{
+    GraphicsPipelineLibraryInfo libInfo;
+    ExtractLibraryInfo(pCreateInfo, flags, &libInfo);
+
+    bool canPrefetch = (libInfo.flags.isLibrary == 0)                 &&
+                       (libInfo.pVertexInputInterfaceLib == nullptr)   &&
+                       (libInfo.pPreRasterizationShaderLib == nullptr) &&
+                       (libInfo.pFragmentShaderLib == nullptr);
+
+    for (uint32_t i = 0; canPrefetch && (i < pCreateInfo->stageCount); ++i)
+    {
+        canPrefetch = (pCreateInfo->pStages[i].module != VK_NULL_HANDLE);
+    }
+
+    GraphicsPipelineShaderStageInfo shaderStageInfo = {};
+
+    if (canPrefetch)
+    {
+        canPrefetch = (BuildShaderStageInfo(pDevice,
+                                            pCreateInfo->stageCount,
+                                            pCreateInfo->pStages,
+                                            false,
+                                            [](const uint32_t inputIdx, const uint32_t stageIdx)
+                                            {
+                                                return stageIdx;
+                                            },
+                                            shaderStageInfo.stages,
+                                            nullptr,
+                                            nullptr,
+                                            nullptr) == VK_SUCCESS);
+    }
+
+    if (canPrefetch)
+    {
+        PipelineOptimizerKey  pipelineOptimizerKey                                  = {};
+        ShaderOptimizerKey    shaderOptimizerKeys[ShaderStage::ShaderStageGfxCount] = {};
+        uint64_t              apiPsoHash                                            = {};
+        Util::MetroHash::Hash elfHash                                               = {};
+
+        GeneratePipelineOptimizerKey(
+            pDevice, pCreateInfo, flags, &shaderStageInfo, shaderOptimizerKeys, &pipelineOptimizerKey);
+
+        BuildApiHash(pCreateInfo, flags, &apiPsoHash, &elfHash);
+
+        ElfHashToCacheId(
+            pDevice,
+            DefaultDeviceIndex,
+            elfHash,
+            pDevice->VkPhysicalDevice(DefaultDeviceIndex)->GetSettingsLoader()->GetSettingsHash(),
+            pipelineOptimizerKey,
+            pCacheId);
+    }
+
+    return canPrefetch;
+}
+
+// =====================================================================================================================
+// Create a graphics pipeline object.  pPrefetched, if not null, holds this pipeline's binary if it was loaded from the
+// application cache ahead of time.
 VkResult GraphicsPipeline::Create(
     Device*                                 pDevice,
     PipelineCache*                          pPipelineCache,
     const VkGraphicsPipelineCreateInfo*     pCreateInfo,
     PipelineCreateFlags                     flags,
     const VkAllocationCallbacks*            pAllocator,
+    PrefetchedPipelineBinary*               pPrefetched,
     VkPipeline*                             pPipeline)
 {
     uint64 startTimeTicks = Util::GetPerfCpuTime();
@@ -610,7 +679,8 @@ VkResult GraphicsPipeline::Create(
             cacheId,
             pipelineBinarySizes,
             pPipelineBinaries,
-            &binaryMetadata);
+            &binaryMetadata,
+            pPrefetched);
     }
 
     GraphicsPipelineObjectCreateInfo objectCreateInfo = {};
@@ -1058,7 +1128,8 @@ VkResult GraphicsPipeline::DeferCreateOptimizedPipeline(
                                         cacheId,
                                         pipelineBinarySizes,
                                         pPipelineBinaries,
-                                        pBinaryCreateInfo->pBinaryMetadata);
+                                        pBinaryCreateInfo->pBinaryMetadata,
+                                        nullptr);
     }
 
     if (result == VK_SUCCESS)
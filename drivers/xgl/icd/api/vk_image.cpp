@@ -529,6 +529,13 @@ void Image::ConvertImageCreateInfo(
         pPalCreateInfo->metadataMode = Pal::MetadataMode::Disabled;
     }
 
+    // Host image copies address the image with its swizzle equations on the CPU, which can't see through compression.
+    if ((pCreateInfo->usage & VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT) != 0)
+    {
+        pPalCreateInfo->metadataMode         = Pal::MetadataMode::Disabled;
+        pPalCreateInfo->flags.needSwizzleEqs = 1;
+    }
+
     // Apply per application (or run-time) options
     pDevice->GetResourceOptimizer()->OverrideImageCreateInfo(resourceKey, pPalCreateInfo);
 
@@ -1645,6 +1652,259 @@ VkResult Image::GetSubresourceLayout(
     return VK_SUCCESS;
 }
 
+// Host image copies run on the calling application thread.  PAL may spread a large copy over a few more threads, but we
+// keep the count small so that it doesn't starve the application's own worker threads.
+constexpr uint32_t MaxHostImageCopyThreads = 4;
+
+// =====================================================================================================================
+// Returns the number of bytes the packed layout used by VK_HOST_IMAGE_COPY_MEMCPY_EXT takes up for one layer of a
+// subresource: every row and depth slice of the subresource back to back, with no padding.
+static Pal::gpusize HostMemcpyLayerSize(
+    const Pal::IImage*       pPalImage,
+    const Pal::SubresId&     subres,
+    const Pal::SubresLayout& palLayout)
+{
+    const Pal::ImageCreateInfo& createInfo = pPalImage->GetImageCreateInfo();
+    const Pal::ChNumFormat      format     = palLayout.planeFormat.format;
+    const Pal::Extent3d         blockDim   = Pal::Formats::IsBlockCompressed(format) ?
+                                             Pal::Formats::CompressedBlockDim(format) : Pal::Extent3d{ 1, 1, 1 };
+
+    const uint32_t width  = Util::Max(createInfo.extent.width  >> subres.mipLevel, 1u);
+    const uint32_t height = Util::Max(createInfo.extent.height >> subres.mipLevel, 1u);
+    const uint32_t depth  = Util::Max(createInfo.extent.depth  >> subres.mipLevel, 1u);
+
+    return Pal::gpusize(Util::RoundUpQuotient(width, blockDim.width))   *
+           Pal::gpusize(Util::RoundUpQuotient(height, blockDim.height)) *
+           depth * palLayout.elementBytes;
+}
+
+// =====================================================================================================================
+// Converts a VkMemoryToImageCopyEXT or VkImageToMemoryCopyEXT into a PAL host image copy region.
+template <typename HostImageCopy_T>
+static Pal::HostImageCopyRegion VkToPalHostImageCopyRegion(
+    const Device*           pDevice,
+    const Image&            image,
+    VkHostImageCopyFlagsEXT flags,
+    const HostImageCopy_T&  copy)
+{
+    const Pal::IImage*const     pPalImage  = image.PalImage(DefaultDeviceIndex);
+    const Pal::ImageCreateInfo& createInfo = pPalImage->GetImageCreateInfo();
+
+    Pal::HostImageCopyRegion region = {};
+
+    region.imageSubres.plane      = VkToPalImagePlaneSingle(image.GetFormat(),
+                                                            copy.imageSubresource.aspectMask,
+                                                            pDevice->GetRuntimeSettings());
+    region.imageSubres.mipLevel   = copy.imageSubresource.mipLevel;
+    region.imageSubres.arraySlice = copy.imageSubresource.baseArrayLayer;
+    region.numSlices              = (copy.imageSubresource.layerCount == VK_REMAINING_ARRAY_LAYERS) ?
+        (createInfo.arraySize - copy.imageSubresource.baseArrayLayer) : copy.imageSubresource.layerCount;
+    region.imageOffset            = VkToPalOffset3d(copy.imageOffset);
+    region.imageExtent            = VkToPalExtent3d(copy.imageExtent);
+    region.pHostMemory            = const_cast<void*>(static_cast<const void*>(copy.pHostPointer));
+
+    Pal::SubresLayout palLayout = {};
+    Pal::Result       palResult = pPalImage->GetSubresourceLayout(region.imageSubres, &palLayout);
+    VK_ASSERT(palResult == Pal::Result::Success);
+
+    const Pal::ChNumFormat format   = palLayout.planeFormat.format;
+    const Pal::Extent3d    blockDim = Pal::Formats::IsBlockCompressed(format) ?
+                                      Pal::Formats::CompressedBlockDim(format) : Pal::Extent3d{ 1, 1, 1 };
+
+    // Memcpy copies always cover whole subresources, and the layout we report for them through
+    // VkSubresourceHostMemcpySizeEXT is simply the tightly packed texel data.
+    const bool     isMemcpy    = ((flags & VK_HOST_IMAGE_COPY_MEMCPY_EXT) != 0);
+    const uint32_t rowLength   = (isMemcpy || (copy.memoryRowLength == 0)) ? copy.imageExtent.width
+                                                                           : copy.memoryRowLength;
+    const uint32_t imageHeight = (isMemcpy || (copy.memoryImageHeight == 0)) ? copy.imageExtent.height
+                                                                             : copy.memoryImageHeight;
+
+    region.hostRowPitch   = Pal::gpusize(Util::RoundUpQuotient(rowLength, blockDim.width)) * palLayout.elementBytes;
+    region.hostDepthPitch = Util::RoundUpQuotient(imageHeight, blockDim.height) * region.hostRowPitch;
+
+    return region;
+}
+
+// =====================================================================================================================
+// Implementation of vkGetImageSubresourceLayout2EXT
+void Image::GetSubresourceLayout2(
+    const Device*                 pDevice,
+    const VkImageSubresource2KHR* pSubresource,
+    VkSubresourceLayout2KHR*      pLayout
+    ) const
+{
+    GetSubresourceLayout(pDevice, &pSubresource->imageSubresource, &pLayout->subresourceLayout);
+
+    for (VkStructHeaderNonConst* pHeader = static_cast<VkStructHeaderNonConst*>(pLayout->pNext);
+         pHeader != nullptr;
+         pHeader = pHeader->pNext)
+    {
+        if (static_cast<uint32_t>(pHeader->sType) == VK_STRUCTURE_TYPE_SUBRESOURCE_HOST_MEMCPY_SIZE_EXT)
+        {
+            auto* pMemcpySize = reinterpret_cast<VkSubresourceHostMemcpySizeEXT*>(pHeader);
+
+            Pal::SubresId palSubResId = {};
+            palSubResId.plane      = VkToPalImagePlaneSingle(m_format,
+                                                             pSubresource->imageSubresource.aspectMask,
+                                                             pDevice->GetRuntimeSettings());
+            palSubResId.mipLevel   = pSubresource->imageSubresource.mipLevel;
+            palSubResId.arraySlice = pSubresource->imageSubresource.arrayLayer;
+
+            Pal::SubresLayout palLayout = {};
+            Pal::Result       palResult = PalImage(DefaultDeviceIndex)->GetSubresourceLayout(palSubResId, &palLayout);
+            VK_ASSERT(palResult == Pal::Result::Success);
+
+            pMemcpySize->size = HostMemcpyLayerSize(PalImage(DefaultDeviceIndex), palSubResId, palLayout);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Implementation of vkCopyMemoryToImageEXT
+VkResult Image::CopyMemoryToImage(
+    const Device*                     pDevice,
+    const VkCopyMemoryToImageInfoEXT* pCopyInfo)
+{
+    Util::AutoBuffer<Pal::HostImageCopyRegion, 8, PalAllocator> palRegions(pCopyInfo->regionCount,
+                                                                           pDevice->VkInstance()->Allocator());
+
+    VkResult result = (palRegions.Capacity() >= pCopyInfo->regionCount) ? VK_SUCCESS : VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    if (result == VK_SUCCESS)
+    {
+        for (uint32_t regionIdx = 0; regionIdx < pCopyInfo->regionCount; ++regionIdx)
+        {
+            palRegions[regionIdx] =
+                VkToPalHostImageCopyRegion(pDevice, *this, pCopyInfo->flags, pCopyInfo->pRegions[regionIdx]);
+        }
+
+        // Each device has its own copy of the image, so all of them need the new contents.
+        for (uint32_t deviceIdx = 0; (deviceIdx < pDevice->NumPalDevices()) && (result == VK_SUCCESS); deviceIdx++)
+        {
+            result = PalToVkResult(PalImage(deviceIdx)->CopyMemoryToImage(pCopyInfo->regionCount,
+                                                                          palRegions.Data(),
+                                                                          MaxHostImageCopyThreads));
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Implementation of vkCopyImageToMemoryEXT
+VkResult Image::CopyImageToMemory(
+    const Device*                     pDevice,
+    const VkCopyImageToMemoryInfoEXT* pCopyInfo
+    ) const
+{
+    Util::AutoBuffer<Pal::HostImageCopyRegion, 8, PalAllocator> palRegions(pCopyInfo->regionCount,
+                                                                           pDevice->VkInstance()->Allocator());
+
+    VkResult result = (palRegions.Capacity() >= pCopyInfo->regionCount) ? VK_SUCCESS : VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    if (result == VK_SUCCESS)
+    {
+        for (uint32_t regionIdx = 0; regionIdx < pCopyInfo->regionCount; ++regionIdx)
+        {
+            palRegions[regionIdx] =
+                VkToPalHostImageCopyRegion(pDevice, *this, pCopyInfo->flags, pCopyInfo->pRegions[regionIdx]);
+        }
+
+        result = PalToVkResult(PalImage(DefaultDeviceIndex)->CopyImageToMemory(pCopyInfo->regionCount,
+                                                                               palRegions.Data(),
+                                                                               MaxHostImageCopyThreads));
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Implementation of vkCopyImageToImageEXT.  Each region is read out into a temporary, tightly packed host buffer and then
+// written into the destination image.
+VkResult Image::CopyImageToImage(
+    const Device*                    pDevice,
+    const VkCopyImageToImageInfoEXT* pCopyInfo)
+{
+    const Image* pSrcImage = Image::ObjectFromHandle(pCopyInfo->srcImage);
+    const Image* pDstImage = Image::ObjectFromHandle(pCopyInfo->dstImage);
+
+    VkResult result = VK_SUCCESS;
+
+    for (uint32_t regionIdx = 0; (regionIdx < pCopyInfo->regionCount) && (result == VK_SUCCESS); ++regionIdx)
+    {
+        const VkImageCopy2& imageCopy = pCopyInfo->pRegions[regionIdx];
+
+        VkImageToMemoryCopyEXT srcCopy = {};
+        srcCopy.imageSubresource = imageCopy.srcSubresource;
+        srcCopy.imageOffset      = imageCopy.srcOffset;
+        srcCopy.imageExtent      = imageCopy.extent;
+
+        VkMemoryToImageCopyEXT dstCopy = {};
+        dstCopy.imageSubresource = imageCopy.dstSubresource;
+        dstCopy.imageOffset      = imageCopy.dstOffset;
+        dstCopy.imageExtent      = imageCopy.extent;
+
+        Pal::HostImageCopyRegion srcRegion =
+            VkToPalHostImageCopyRegion(pDevice, *pSrcImage, pCopyInfo->flags, srcCopy);
+        Pal::HostImageCopyRegion dstRegion =
+            VkToPalHostImageCopyRegion(pDevice, *pDstImage, pCopyInfo->flags, dstCopy);
+
+        // The extent is given in source texels.  Size-compatible copies between compressed and uncompressed formats
+        // cover the same number of elements on both sides, so rescale it into destination texels.
+        const Pal::ChNumFormat srcFormat = VkToPalFormat(pSrcImage->GetFormat(), pDevice->GetRuntimeSettings()).format;
+        const Pal::ChNumFormat dstFormat = VkToPalFormat(pDstImage->GetFormat(), pDevice->GetRuntimeSettings()).format;
+
+        if (Pal::Formats::IsBlockCompressed(srcFormat) != Pal::Formats::IsBlockCompressed(dstFormat))
+        {
+            const Pal::Extent3d srcBlockDim = Pal::Formats::IsBlockCompressed(srcFormat) ?
+                Pal::Formats::CompressedBlockDim(srcFormat) : Pal::Extent3d{ 1, 1, 1 };
+            const Pal::Extent3d dstBlockDim = Pal::Formats::IsBlockCompressed(dstFormat) ?
+                Pal::Formats::CompressedBlockDim(dstFormat) : Pal::Extent3d{ 1, 1, 1 };
+
+            dstRegion.imageExtent.width  =
+                Util::RoundUpQuotient(srcRegion.imageExtent.width,  srcBlockDim.width)  * dstBlockDim.width;
+            dstRegion.imageExtent.height =
+                Util::RoundUpQuotient(srcRegion.imageExtent.height, srcBlockDim.height) * dstBlockDim.height;
+        }
+
+        // Both sides share the source's packing of the temporary buffer.
+        dstRegion.hostRowPitch   = srcRegion.hostRowPitch;
+        dstRegion.hostDepthPitch = srcRegion.hostDepthPitch;
+
+        const uint32_t numLayers =
+            (pSrcImage->PalImage(DefaultDeviceIndex)->GetImageCreateInfo().imageType == Pal::ImageType::Tex3d) ?
+            Util::Max(srcRegion.imageExtent.depth, 1u) : srcRegion.numSlices;
+
+        void* pBuffer = pDevice->VkInstance()->AllocMem(static_cast<size_t>(srcRegion.hostDepthPitch * numLayers),
+                                                        VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+
+        if (pBuffer != nullptr)
+        {
+            srcRegion.pHostMemory = pBuffer;
+            dstRegion.pHostMemory = pBuffer;
+
+            result = PalToVkResult(pSrcImage->PalImage(DefaultDeviceIndex)->CopyImageToMemory(
+                1, &srcRegion, MaxHostImageCopyThreads));
+
+            for (uint32_t deviceIdx = 0;
+                 (deviceIdx < pDevice->NumPalDevices()) && (result == VK_SUCCESS);
+                 deviceIdx++)
+            {
+                result = PalToVkResult(pDstImage->PalImage(deviceIdx)->CopyMemoryToImage(
+                    1, &dstRegion, MaxHostImageCopyThreads));
+            }
+
+            pDevice->VkInstance()->FreeMem(pBuffer);
+        }
+        else
+        {
+            result = VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 // Implementation of vkGetImageSparseMemoryRequirements
 void Image::GetSparseMemoryRequirements(
@@ -1928,6 +2188,14 @@ void Image::CalculateMemoryRequirementsInternal(
     // Images are not using memoryType for DescriptorBuffers
     pMemoryRequirements->memoryTypeBits &= ~pDevice->GetMemoryTypeMaskForDescriptorBuffers();
 
+    // Host image copies go through a CPU mapping of the image's memory.
+    if ((pCreateInfo->usage & VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT) != 0)
+    {
+        pMemoryRequirements->memoryTypeBits &= pDevice->GetMemoryTypeMaskMatching(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+        VK_ASSERT(pMemoryRequirements->memoryTypeBits != 0);
+    }
+
     // Add an extra memory padding. This can be enabled while capturing GFXR traces and disabled later. Capturing with
     // this setting enabled helps in replaying GFXR traces. When this setting is not used while capture, GFXR might
     // return a fatal error while replaying with different DCC threshold values. This is caused because gfxreconstruct
@@ -2542,6 +2810,66 @@ VKAPI_ATTR void VKAPI_CALL vkGetImageSparseMemoryRequirements2(
     pImage->GetSparseMemoryRequirements(pDevice, pSparseMemoryRequirementCount, memReqsView);
 }
 
+// =====================================================================================================================
+VKAPI_ATTR VkResult VKAPI_CALL vkCopyMemoryToImageEXT(
+    VkDevice                                    device,
+    const VkCopyMemoryToImageInfoEXT*           pCopyMemoryToImageInfo)
+{
+    const Device* pDevice = ApiDevice::ObjectFromHandle(device);
+
+    return Image::ObjectFromHandle(pCopyMemoryToImageInfo->dstImage)->CopyMemoryToImage(
+        pDevice,
+        pCopyMemoryToImageInfo);
+}
+
+// =====================================================================================================================
+VKAPI_ATTR VkResult VKAPI_CALL vkCopyImageToMemoryEXT(
+    VkDevice                                    device,
+    const VkCopyImageToMemoryInfoEXT*           pCopyImageToMemoryInfo)
+{
+    const Device* pDevice = ApiDevice::ObjectFromHandle(device);
+
+    return Image::ObjectFromHandle(pCopyImageToMemoryInfo->srcImage)->CopyImageToMemory(
+        pDevice,
+        pCopyImageToMemoryInfo);
+}
+
+// =====================================================================================================================
+VKAPI_ATTR VkResult VKAPI_CALL vkCopyImageToImageEXT(
+    VkDevice                                    device,
+    const VkCopyImageToImageInfoEXT*            pCopyImageToImageInfo)
+{
+    const Device* pDevice = ApiDevice::ObjectFromHandle(device);
+
+    return Image::CopyImageToImage(pDevice, pCopyImageToImageInfo);
+}
+
+// =====================================================================================================================
+VKAPI_ATTR VkResult VKAPI_CALL vkTransitionImageLayoutEXT(
+    VkDevice                                    device,
+    uint32_t                                    transitionCount,
+    const VkHostImageLayoutTransitionInfoEXT*   pTransitions)
+{
+    // Images with host transfer usage have no metadata, so all of their layouts share the same memory contents and
+    // there is nothing to do.
+    return VK_SUCCESS;
+}
+
+// =====================================================================================================================
+VKAPI_ATTR void VKAPI_CALL vkGetImageSubresourceLayout2EXT(
+    VkDevice                                    device,
+    VkImage                                     image,
+    const VkImageSubresource2KHR*               pSubresource,
+    VkSubresourceLayout2KHR*                    pLayout)
+{
+    const Device* pDevice = ApiDevice::ObjectFromHandle(device);
+
+    Image::ObjectFromHandle(image)->GetSubresourceLayout2(
+        pDevice,
+        pSubresource,
+        pLayout);
+}
+
 #if defined(__unix__)
 // =====================================================================================================================
 VKAPI_ATTR VkResult VKAPI_CALL vkGetImageDrmFormatModifierPropertiesEXT(
@@ -670,6 +670,13 @@ VkResult Instance::Destroy(void)
 {
     AmdvlkLog(m_logTagIdMask, GeneralPrint, "%s End ********\n", GetApplicationName());
 
+#if ICD_SLAB_ALLOCATOR
+    if (m_allocCallbacks.pfnAllocation == allocator::DefaultAllocFunc)
+    {
+        allocator::LogSlabAllocatorStats(m_logTagIdMask);
+    }
+#endif
+
 #if ICD_GPUOPEN_DEVMODE_BUILD
     // Pipeline binary cache is required to be freed before destroying DevModeMgr
     // because DevModeMgr manages the state of pipeline binary cache.
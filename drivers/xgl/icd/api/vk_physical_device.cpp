@@ -1720,9 +1720,32 @@ VkResult PhysicalDevice::GetExtendedFormatProperties(
         }
     }
 
+    if (FormatSupportsHostImageCopy(format))
+    {
+        pFormatProperties->linearTilingFeatures  |= VK_FORMAT_FEATURE_2_HOST_IMAGE_TRANSFER_BIT_EXT;
+        pFormatProperties->optimalTilingFeatures |= VK_FORMAT_FEATURE_2_HOST_IMAGE_TRANSFER_BIT_EXT;
+    }
+
     return VK_SUCCESS;
 }
 
+// =====================================================================================================================
+// Returns true if images of the given format can be copied to and from host memory with the CPU.  PAL addresses each
+// element with the image's swizzle equation, so elements must be a power of two bytes and map one to one onto texels
+// (or onto compressed blocks).
+bool PhysicalDevice::FormatSupportsHostImageCopy(
+    VkFormat format
+    ) const
+{
+    const Pal::SwizzledFormat palFormat = VkToPalFormat(format, GetRuntimeSettings());
+
+    return IsExtensionSupported(DeviceExtensions::EXT_HOST_IMAGE_COPY)                     &&
+           (palFormat.format != Pal::ChNumFormat::Undefined)                              &&
+           (Formats::IsYuvFormat(format) == false)                                        &&
+           Util::IsPowerOfTwo(Pal::Formats::BytesPerPixel(palFormat.format))              &&
+           (Pal::Formats::IsMacroPixelPacked(palFormat.format) == false);
+}
+
 #if defined(__unix__)
 // =====================================================================================================================
 template <typename FormatProperties_T, typename FormatFeatureFlags_T>
@@ -1943,6 +1966,17 @@ VkResult PhysicalDevice::GetImageFormatProperties(
         return VK_ERROR_FORMAT_NOT_SUPPORTED;
     }
 
+    // Host image copies only understand plain swizzled data, which sparse images can't guarantee, and a DRM format
+    // modifier may pick a layout PAL didn't. The copies also always use the image's own format, so unlike other usages
+    // an unsupported format can't be excused by extended usage.
+    if (((usage & VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT) != 0) &&
+        (((flags & Image::SparseEnablingFlags) != 0)         ||
+         (tiling == VK_IMAGE_TILING_DRM_FORMAT_MODIFIER_EXT) ||
+         (FormatSupportsHostImageCopy(format) == false)))
+    {
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+
     // Currently we just disable the support of linear 3d surfaces, since they aren't required by spec.
     if (type == VK_IMAGE_TYPE_3D && tiling == VK_IMAGE_TILING_LINEAR)
     {
@@ -2131,10 +2165,12 @@ VkResult PhysicalDevice::GetImageFormatProperties(
     //    4- Image formats that do not support any of the following uses:
     //         a- color attachment.
     //         b- depth/stencil attachment.
+    // We also only support host image copies on single-sampled images.
     if ((FormatSupportsMsaa(format) == false)                                           ||
         (type != VK_IMAGE_TYPE_2D)                                                      ||
         (tiling == VK_IMAGE_TILING_LINEAR)                                              ||
         ((flags & VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT) != 0)                            ||
+        ((usage & VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT) != 0)                           ||
         ((supportedFeatures & (VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT |
                                VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT)) == 0))
     {
@@ -4211,6 +4247,15 @@ DeviceExtensions::Supported PhysicalDevice::GetAvailableExtensions(
 
     availableExtensions.AddExtension(VK_DEVICE_EXTENSION(EXT_HOST_QUERY_RESET));
 
+    // Host image copies address swizzled images on the CPU. PAL reports whether it can do that for every swizzle mode,
+    // which is only the case for the GFX10+ ones.
+    if ((pPhysicalDevice == nullptr) ||
+        (pPhysicalDevice->GetRuntimeSettings().supportHostImageCopy &&
+         (pPhysicalDevice->PalProperties().imageProperties.flags.supportsHostImageCopy != 0)))
+    {
+        availableExtensions.AddExtension(VK_DEVICE_EXTENSION(EXT_HOST_IMAGE_COPY));
+    }
+
     availableExtensions.AddExtension(VK_DEVICE_EXTENSION(KHR_UNIFORM_BUFFER_STANDARD_LAYOUT));
 
     availableExtensions.AddExtension(VK_DEVICE_EXTENSION(EXT_LINE_RASTERIZATION));
@@ -7104,6 +7149,18 @@ size_t PhysicalDevice::GetFeatures2(
                 break;
             }
 
+            case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT:
+            {
+                auto* pExtInfo = reinterpret_cast<VkPhysicalDeviceHostImageCopyFeaturesEXT*>(pHeader);
+                if (updateFeatures)
+                {
+                    pExtInfo->hostImageCopy = IsExtensionSupported(DeviceExtensions::EXT_HOST_IMAGE_COPY);
+                }
+
+                structSize = sizeof(*pExtInfo);
+                break;
+            }
+
             default:
             {
                 // skip any unsupported extension structures
@@ -7138,6 +7195,7 @@ VkResult PhysicalDevice::GetImageFormatProperties2(
     VkExternalImageFormatProperties*                        pExternalImageProperties                     = nullptr;
     VkTextureLODGatherFormatPropertiesAMD*                  pTextureLODGatherFormatProperties            = nullptr;
     VkSamplerYcbcrConversionImageFormatProperties*          pSamplerYcbcrConversionImageFormatProperties = nullptr;
+    VkHostImageCopyDevicePerformanceQueryEXT*               pHostImageCopyPerfQuery                      = nullptr;
 
     for (pHeader = reinterpret_cast<const VkStructHeader*>(pImageFormatInfo->pNext);
          pHeader != nullptr;
@@ -7196,6 +7254,11 @@ VkResult PhysicalDevice::GetImageFormatProperties2(
                 Formats::GetYuvPlaneCounts(createInfoFormat);
             break;
         }
+        case VK_STRUCTURE_TYPE_HOST_IMAGE_COPY_DEVICE_PERFORMANCE_QUERY_EXT:
+        {
+            pHostImageCopyPerfQuery = reinterpret_cast<VkHostImageCopyDevicePerformanceQueryEXT*>(pHeader2);
+            break;
+        }
         default:
             break;
         }
@@ -7249,6 +7312,15 @@ VkResult PhysicalDevice::GetImageFormatProperties2(
         }
     }
 
+    // handle VK_STRUCTURE_TYPE_HOST_IMAGE_COPY_DEVICE_PERFORMANCE_QUERY_EXT
+    if (pHostImageCopyPerfQuery != nullptr)
+    {
+        // Host-transfer images are created without metadata, which costs device access performance and changes the
+        // layout compared to the same image without host-transfer usage.
+        pHostImageCopyPerfQuery->optimalDeviceAccess   = VK_FALSE;
+        pHostImageCopyPerfQuery->identicalMemoryLayout = VK_FALSE;
+    }
+
     return result;
 }
 
@@ -7962,6 +8034,61 @@ void PhysicalDevice::GetDeviceProperties2(
             break;
         }
 
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_PROPERTIES_EXT:
+        {
+            auto* pProps = static_cast<VkPhysicalDeviceHostImageCopyPropertiesEXT*>(pNext);
+
+            // Host-transfer images never have metadata, so every layout has the same memory contents.
+            static constexpr VkImageLayout HostCopyLayouts[] =
+            {
+                VK_IMAGE_LAYOUT_GENERAL,
+                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_IMAGE_LAYOUT_PREINITIALIZED,
+                VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_STENCIL_ATTACHMENT_OPTIMAL,
+                VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_STENCIL_READ_ONLY_OPTIMAL,
+                VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL,
+                VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL,
+                VK_IMAGE_LAYOUT_STENCIL_ATTACHMENT_OPTIMAL,
+                VK_IMAGE_LAYOUT_STENCIL_READ_ONLY_OPTIMAL,
+                VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL,
+                VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL,
+            };
+            constexpr uint32_t NumHostCopyLayouts = static_cast<uint32_t>(VK_ARRAY_SIZE(HostCopyLayouts));
+
+            if (pProps->pCopySrcLayouts != nullptr)
+            {
+                pProps->copySrcLayoutCount = Util::Min(pProps->copySrcLayoutCount, NumHostCopyLayouts);
+                memcpy(pProps->pCopySrcLayouts, HostCopyLayouts, pProps->copySrcLayoutCount * sizeof(VkImageLayout));
+            }
+            else
+            {
+                pProps->copySrcLayoutCount = NumHostCopyLayouts;
+            }
+
+            if (pProps->pCopyDstLayouts != nullptr)
+            {
+                pProps->copyDstLayoutCount = Util::Min(pProps->copyDstLayoutCount, NumHostCopyLayouts);
+                memcpy(pProps->pCopyDstLayouts, HostCopyLayouts, pProps->copyDstLayoutCount * sizeof(VkImageLayout));
+            }
+            else
+            {
+                pProps->copyDstLayoutCount = NumHostCopyLayouts;
+            }
+
+            // The swizzled layout depends on the GPU and on the address library built into this driver, both of which
+            // the pipeline cache UUID already identifies.
+            memcpy(pProps->optimalTilingLayoutUUID, m_pipelineCacheUUID.raw, VK_UUID_SIZE);
+
+            // Host-transfer images are restricted to CPU-visible memory types.
+            pProps->identicalMemoryTypeRequirements = VK_FALSE;
+            break;
+        }
+
         case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_PROPERTIES_EXT:
         {
             auto* pProps = static_cast<VkPhysicalDeviceMeshShaderPropertiesEXT*>(pNext);
@@ -204,7 +204,7 @@ VkResult PipelineCache::Merge(
             binaryCaches[cacheIdx] = ppSrcCaches[cacheIdx]->GetPipelineCache();
         }
 
-        result = m_pBinaryCache->Merge(srcCacheCount, &binaryCaches[0]);
+        result = m_pBinaryCache->Merge(srcCacheCount, &binaryCaches[0], m_pDevice->GetCompiler(DefaultDeviceIndex));
     }
 
     return result;
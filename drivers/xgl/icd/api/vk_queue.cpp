@@ -82,6 +82,7 @@ Queue::Queue(
     m_pDevModeMgr(pDevice->VkInstance()->GetDevModeMgr()),
     m_pStackAllocator(pStackAllocator),
     m_pCmdBufferRing(pCmdBufferRing),
+    m_pSubmitThread(nullptr),
     m_isDeviceIndependent(isDeviceIndependent)
 {
     if (ppPalQueues != nullptr)
@@ -314,11 +315,41 @@ VkResult Queue::Create(
     else
     {
         *pQueue = reinterpret_cast<VkQueue>(pSysMem);
+
+        if (pDevice->GetRuntimeSettings().enableThreadedQueueSubmit)
+        {
+            ApiQueue::ObjectFromHandle(*pQueue)->InitSubmitThread();
+        }
     }
 
     return result;
 }
 
+// =====================================================================================================================
+// Starts the thread which performs this queue's submissions. Submissions stay synchronous if it cannot be started.
+void Queue::InitSubmitThread()
+{
+    VK_ASSERT(m_pSubmitThread == nullptr);
+
+    Instance* pInstance = m_pDevice->VkInstance();
+    void*     pMemory   = pInstance->AllocMem(sizeof(QueueSubmitThread), VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+
+    if (pMemory != nullptr)
+    {
+        m_pSubmitThread = VK_PLACEMENT_NEW(pMemory) QueueSubmitThread(this,
+                                                                      &ExecuteDeferredTask,
+                                                                      pInstance->Allocator());
+
+        if (m_pSubmitThread->Begin() == false)
+        {
+            Util::Destructor(m_pSubmitThread);
+            pInstance->FreeMem(pMemory);
+
+            m_pSubmitThread = nullptr;
+        }
+    }
+}
+
 // =====================================================================================================================
 void Queue::ConstructQueueCreateInfo(
     const PhysicalDevice&          physicalDevice,
@@ -822,6 +853,13 @@ Pal::Result Queue::CreatePalQueues(
 // =====================================================================================================================
 Queue::~Queue()
 {
+    if (m_pSubmitThread != nullptr)
+    {
+        // The thread executes every submission still queued before it exits.
+        Util::Destructor(m_pSubmitThread);
+        m_pDevice->VkInstance()->FreeMem(m_pSubmitThread);
+    }
+
     for (uint32_t deviceIdx = 0; deviceIdx < m_pDevice->NumPalDevices(); ++deviceIdx)
     {
         if (m_pDummyCmdBuffer[deviceIdx] != nullptr)
@@ -1047,12 +1085,406 @@ VkResult Queue::NotifyFlipMetadataAfterPresent(
 }
 
 // =====================================================================================================================
-// Submit an array of command buffers to a queue
+// Linear allocator over the storage of a deferred submission. Only measures the storage needed while pBase is null.
+struct DeferredSubmitWriter
+{
+    void*  pBase;
+    size_t offset;
+
+    template<typename T>
+    T* Copy(
+        const T* pSrc,
+        uint32_t count)
+    {
+        T* pDst = nullptr;
+
+        if ((pSrc != nullptr) && (count > 0))
+        {
+            offset = Util::Pow2Align(offset, alignof(T));
+
+            if (pBase != nullptr)
+            {
+                pDst = static_cast<T*>(Util::VoidPtrInc(pBase, offset));
+                memcpy(pDst, pSrc, sizeof(T) * count);
+            }
+
+            offset += sizeof(T) * count;
+        }
+
+        return pDst;
+    }
+};
+
+// =====================================================================================================================
+// Copies the submit infos of a vkQueueSubmit() call along with the arrays and extension structures they reference.
+static VkSubmitInfo* CopySubmitInfos(
+    DeferredSubmitWriter* pWriter,
+    uint32_t              submitCount,
+    const VkSubmitInfo*   pSubmits)
+{
+    VkSubmitInfo* pDst = pWriter->Copy(pSubmits, submitCount);
+
+    for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+    {
+        const VkSubmitInfo& submitInfo = pSubmits[submitIdx];
+        const void*         pNextCopy  = nullptr;
+
+        // Only the extension structures consumed by Queue::PalSubmit() are kept; the chain is rebuilt from them.
+        for (const VkStructHeader* pHeader = static_cast<const VkStructHeader*>(submitInfo.pNext);
+             pHeader != nullptr;
+             pHeader = pHeader->pNext)
+        {
+            switch (static_cast<int32_t>(pHeader->sType))
+            {
+            case VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO:
+            {
+                const VkDeviceGroupSubmitInfo* pInfo = reinterpret_cast<const VkDeviceGroupSubmitInfo*>(pHeader);
+
+                VkDeviceGroupSubmitInfo* pCopy    = pWriter->Copy(pInfo, 1);
+                const uint32_t*          pWaits   = pWriter->Copy(pInfo->pWaitSemaphoreDeviceIndices,
+                                                                  pInfo->waitSemaphoreCount);
+                const uint32_t*          pMasks   = pWriter->Copy(pInfo->pCommandBufferDeviceMasks,
+                                                                  pInfo->commandBufferCount);
+                const uint32_t*          pSignals = pWriter->Copy(pInfo->pSignalSemaphoreDeviceIndices,
+                                                                  pInfo->signalSemaphoreCount);
+
+                if (pCopy != nullptr)
+                {
+                    pCopy->pNext                         = pNextCopy;
+                    pCopy->pWaitSemaphoreDeviceIndices   = pWaits;
+                    pCopy->pCommandBufferDeviceMasks     = pMasks;
+                    pCopy->pSignalSemaphoreDeviceIndices = pSignals;
+                    pNextCopy                            = pCopy;
+                }
+                break;
+            }
+            case VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO:
+            {
+                const VkTimelineSemaphoreSubmitInfo* pInfo =
+                    reinterpret_cast<const VkTimelineSemaphoreSubmitInfo*>(pHeader);
+
+                VkTimelineSemaphoreSubmitInfo* pCopy    = pWriter->Copy(pInfo, 1);
+                const uint64_t*                pWaits   = pWriter->Copy(pInfo->pWaitSemaphoreValues,
+                                                                        pInfo->waitSemaphoreValueCount);
+                const uint64_t*                pSignals = pWriter->Copy(pInfo->pSignalSemaphoreValues,
+                                                                        pInfo->signalSemaphoreValueCount);
+
+                if (pCopy != nullptr)
+                {
+                    pCopy->pNext                  = pNextCopy;
+                    pCopy->pWaitSemaphoreValues   = pWaits;
+                    pCopy->pSignalSemaphoreValues = pSignals;
+                    pNextCopy                     = pCopy;
+                }
+                break;
+            }
+            case VK_STRUCTURE_TYPE_PROTECTED_SUBMIT_INFO:
+            {
+                VkProtectedSubmitInfo* pCopy =
+                    pWriter->Copy(reinterpret_cast<const VkProtectedSubmitInfo*>(pHeader), 1);
+
+                if (pCopy != nullptr)
+                {
+                    pCopy->pNext = pNextCopy;
+                    pNextCopy    = pCopy;
+                }
+                break;
+            }
+            default:
+                // Skip any unknown extension structures
+                break;
+            }
+        }
+
+        const VkSemaphore*          pWaits   = pWriter->Copy(submitInfo.pWaitSemaphores,
+                                                             submitInfo.waitSemaphoreCount);
+        const VkPipelineStageFlags* pStages  = pWriter->Copy(submitInfo.pWaitDstStageMask,
+                                                             submitInfo.waitSemaphoreCount);
+        const VkCommandBuffer*      pCmdBufs = pWriter->Copy(submitInfo.pCommandBuffers,
+                                                             submitInfo.commandBufferCount);
+        const VkSemaphore*          pSignals = pWriter->Copy(submitInfo.pSignalSemaphores,
+                                                             submitInfo.signalSemaphoreCount);
+
+        if (pDst != nullptr)
+        {
+            pDst[submitIdx].pNext             = pNextCopy;
+            pDst[submitIdx].pWaitSemaphores   = pWaits;
+            pDst[submitIdx].pWaitDstStageMask = pStages;
+            pDst[submitIdx].pCommandBuffers   = pCmdBufs;
+            pDst[submitIdx].pSignalSemaphores = pSignals;
+        }
+    }
+
+    return pDst;
+}
+
+// =====================================================================================================================
+// Copies the submit infos of a vkQueueSubmit2() call along with the arrays they reference.
+static VkSubmitInfo2KHR* CopySubmitInfos(
+    DeferredSubmitWriter*   pWriter,
+    uint32_t                submitCount,
+    const VkSubmitInfo2KHR* pSubmits)
+{
+    VkSubmitInfo2KHR* pDst = pWriter->Copy(pSubmits, submitCount);
+
+    for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+    {
+        const VkSubmitInfo2KHR& submitInfo = pSubmits[submitIdx];
+
+        const VkSemaphoreSubmitInfo*     pWaits   = pWriter->Copy(submitInfo.pWaitSemaphoreInfos,
+                                                                  submitInfo.waitSemaphoreInfoCount);
+        const VkCommandBufferSubmitInfo* pCmdBufs = pWriter->Copy(submitInfo.pCommandBufferInfos,
+                                                                  submitInfo.commandBufferInfoCount);
+        const VkSemaphoreSubmitInfo*     pSignals = pWriter->Copy(submitInfo.pSignalSemaphoreInfos,
+                                                                  submitInfo.signalSemaphoreInfoCount);
+
+        if (pDst != nullptr)
+        {
+            // None of the extension structures of VkSubmitInfo2 are consumed by Queue::PalSubmit().
+            pDst[submitIdx].pNext                 = nullptr;
+            pDst[submitIdx].pWaitSemaphoreInfos   = pWaits;
+            pDst[submitIdx].pCommandBufferInfos   = pCmdBufs;
+            pDst[submitIdx].pSignalSemaphoreInfos = pSignals;
+        }
+    }
+
+    return pDst;
+}
+
+// =====================================================================================================================
+// Returns the queues with deferred submissions which signal one of the semaphores waited on by a vkQueueSubmit() call.
+static uint64_t GetWaitSemaphoreSignalQueues(
+    uint32_t            submitCount,
+    const VkSubmitInfo* pSubmits)
+{
+    uint64_t queueMask = 0;
+
+    for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+    {
+        queueMask |= Semaphore::GetDeferredSignalQueues(pSubmits[submitIdx].waitSemaphoreCount,
+                                                        pSubmits[submitIdx].pWaitSemaphores);
+    }
+
+    return queueMask;
+}
+
+// =====================================================================================================================
+// Returns the queues with deferred submissions which signal one of the semaphores waited on by a vkQueueSubmit2() call.
+static uint64_t GetWaitSemaphoreSignalQueues(
+    uint32_t                submitCount,
+    const VkSubmitInfo2KHR* pSubmits)
+{
+    uint64_t queueMask = 0;
+
+    for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+    {
+        const VkSubmitInfo2KHR& submitInfo = pSubmits[submitIdx];
+
+        for (uint32_t i = 0; i < submitInfo.waitSemaphoreInfoCount; ++i)
+        {
+            queueMask |= Semaphore::GetDeferredSignalQueues(1, &submitInfo.pWaitSemaphoreInfos[i].semaphore);
+        }
+    }
+
+    return queueMask;
+}
+
+// =====================================================================================================================
+// Records that the semaphores signaled by a deferred vkQueueSubmit() call are signaled by the queue in queueMask.
+static void AddDeferredSignalQueues(
+    uint64_t            queueMask,
+    uint32_t            submitCount,
+    const VkSubmitInfo* pSubmits)
+{
+    for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+    {
+        const VkSubmitInfo& submitInfo = pSubmits[submitIdx];
+
+        for (uint32_t i = 0; i < submitInfo.signalSemaphoreCount; ++i)
+        {
+            Semaphore::ObjectFromHandle(submitInfo.pSignalSemaphores[i])->AddDeferredSignalQueues(queueMask);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Records that the semaphores signaled by a deferred vkQueueSubmit2() call are signaled by the queue in queueMask.
+static void AddDeferredSignalQueues(
+    uint64_t                queueMask,
+    uint32_t                submitCount,
+    const VkSubmitInfo2KHR* pSubmits)
+{
+    for (uint32_t submitIdx = 0; submitIdx < submitCount; ++submitIdx)
+    {
+        const VkSubmitInfo2KHR& submitInfo = pSubmits[submitIdx];
+
+        for (uint32_t i = 0; i < submitInfo.signalSemaphoreInfoCount; ++i)
+        {
+            Semaphore::ObjectFromHandle(submitInfo.pSignalSemaphoreInfos[i].semaphore)->AddDeferredSignalQueues(
+                queueMask);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Submit an array of command buffers to a queue. With threaded submit on, the submission is recorded and handed to the
+// queue's submission thread, which performs it through PalSubmit() in the order of the API calls.
 template<typename SubmitInfoType>
 VkResult Queue::Submit(
     uint32_t              submitCount,
     const SubmitInfoType* pSubmits,
     VkFence               fence)
+{
+    VkResult result = VK_SUCCESS;
+
+    if (m_pSubmitThread == nullptr)
+    {
+        result = PalSubmit(submitCount, pSubmits, fence);
+    }
+    else
+    {
+        // The call which queued a failing submission has already returned, so report its error here instead.
+        result = m_pSubmitThread->GetStatus();
+
+        if (result == VK_SUCCESS)
+        {
+            // The semaphores may be signaled by submissions the application made on other queues before this call,
+            // which must reach PAL before the wait does. Those made on this queue are already ahead of this one.
+            const uint64_t signalQueues = GetWaitSemaphoreSignalQueues(submitCount, pSubmits) & ~GetQueueMask();
+
+            if (signalQueues != 0)
+            {
+                result = m_pDevice->SyncDeferredQueueSubmits(signalQueues);
+            }
+        }
+
+#if ICD_GPUOPEN_DEVMODE_BUILD
+        DevModeMgr* pDevModeMgr = m_pDevice->VkInstance()->GetDevModeMgr();
+
+        const bool timedQueueEvents = ((pDevModeMgr != nullptr) && pDevModeMgr->IsQueueTimingActive(m_pDevice));
+#else
+        const bool timedQueueEvents = false;
+#endif
+
+        // Timed submissions are not deferred, as the developer mode manager tracks them on the calling thread.
+        if ((result == VK_SUCCESS) &&
+            ((timedQueueEvents == true) || (DeferSubmit(submitCount, pSubmits, fence) == false)))
+        {
+            result = m_pSubmitThread->Sync();
+
+            if (result == VK_SUCCESS)
+            {
+                result = PalSubmit(submitCount, pSubmits, fence);
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Records a submission and queues it on the submission thread. Returns false if it could not be queued, in which case
+// the caller should perform it itself.
+template<typename SubmitInfoType>
+bool Queue::DeferSubmit(
+    uint32_t              submitCount,
+    const SubmitInfoType* pSubmits,
+    VkFence               fence)
+{
+    bool queued = false;
+
+    DeferredSubmitWriter writer = { nullptr, sizeof(DeferredSubmit) };
+    CopySubmitInfos(&writer, submitCount, pSubmits);
+
+    void* pMemory = m_pDevice->VkInstance()->AllocMem(writer.offset, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+
+    if (pMemory != nullptr)
+    {
+        DeferredSubmit* pDeferredSubmit = static_cast<DeferredSubmit*>(pMemory);
+
+        writer.pBase  = pMemory;
+        writer.offset = sizeof(DeferredSubmit);
+
+        pDeferredSubmit->type               = DeferredTaskType::Submit;
+        pDeferredSubmit->fence              = fence;
+        pDeferredSubmit->submitCount        = submitCount;
+        pDeferredSubmit->isSynchronization2 = std::is_same<SubmitInfoType, VkSubmitInfo2KHR>::value;
+        pDeferredSubmit->pSubmits           = CopySubmitInfos(&writer, submitCount, pSubmits);
+
+        // Marked before queueing, so that a wait issued as soon as the task is queued knows to sync this queue.
+        AddDeferredSignalQueues(GetQueueMask(), submitCount, pSubmits);
+
+        if (fence != VK_NULL_HANDLE)
+        {
+            Fence::ObjectFromHandle(fence)->AddDeferredSignalQueues(GetQueueMask());
+        }
+
+        queued = m_pSubmitThread->PushTask(pDeferredSubmit);
+
+        if (queued == false)
+        {
+            m_pDevice->VkInstance()->FreeMem(pMemory);
+        }
+    }
+
+    return queued;
+}
+
+// =====================================================================================================================
+// Performs a submission recorded by DeferSubmit() or a present queued by Present(). Called on the submission thread.
+VkResult Queue::ExecuteDeferredTask(
+    void* pOwner,
+    void* pPayload,
+    bool  discard)
+{
+    Queue* pQueue = static_cast<Queue*>(pOwner);
+
+    VkResult result = VK_SUCCESS;
+
+    if (*static_cast<const DeferredTaskType*>(pPayload) == DeferredTaskType::Present)
+    {
+        DeferredPresent* pDeferredPresent = static_cast<DeferredPresent*>(pPayload);
+
+        // Present() reports the error which made the thread discard the present itself.
+        if (discard == false)
+        {
+            pDeferredPresent->result = pQueue->PresentImpl(pDeferredPresent->pPresentInfo);
+        }
+    }
+    else
+    {
+        DeferredSubmit* pDeferredSubmit = static_cast<DeferredSubmit*>(pPayload);
+
+        if (discard)
+        {
+            // A submission after a failed one may wait on semaphores the failed one was to signal.
+        }
+        else if (pDeferredSubmit->isSynchronization2)
+        {
+            result = pQueue->PalSubmit(pDeferredSubmit->submitCount,
+                                       static_cast<const VkSubmitInfo2KHR*>(pDeferredSubmit->pSubmits),
+                                       pDeferredSubmit->fence);
+        }
+        else
+        {
+            result = pQueue->PalSubmit(pDeferredSubmit->submitCount,
+                                       static_cast<const VkSubmitInfo*>(pDeferredSubmit->pSubmits),
+                                       pDeferredSubmit->fence);
+        }
+
+        pQueue->m_pDevice->VkInstance()->FreeMem(pDeferredSubmit);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Submit an array of command buffers to PAL
+template<typename SubmitInfoType>
+VkResult Queue::PalSubmit(
+    uint32_t              submitCount,
+    const SubmitInfoType* pSubmits,
+    VkFence               fence)
 {
 #if ICD_GPUOPEN_DEVMODE_BUILD
     DevModeMgr* pDevModeMgr = m_pDevice->VkInstance()->GetDevModeMgr();
@@ -1560,6 +1992,9 @@ VkResult Queue::Submit(
 // Wait for a queue to go idle
 VkResult Queue::WaitIdle(void)
 {
+    // Submissions still queued on the submission thread are part of the work to wait for.
+    const VkResult syncResult = SyncDeferredSubmits();
+
     Pal::Result palResult = Pal::Result::Success;
 
     for (uint32_t deviceIdx = 0;
@@ -1569,7 +2004,7 @@ VkResult Queue::WaitIdle(void)
         palResult = PalQueue(deviceIdx)->WaitIdle();
     }
 
-    return PalToVkResult(palResult);
+    return (syncResult != VK_SUCCESS) ? syncResult : PalToVkResult(palResult);
 }
 
 // =====================================================================================================================
@@ -1764,9 +2199,55 @@ bool Queue::NeedPacePresent(
 }
 
 // =====================================================================================================================
-// Present a swap chain image
+// Present a swap chain image. With threaded submit on, the present is executed by the queue's submission thread after
+// the submissions queued before it, and waited for so that its result can be returned.
 VkResult Queue::Present(
     const VkPresentInfoKHR* pPresentInfo)
+{
+    VkResult result = VK_SUCCESS;
+
+    if (pPresentInfo != nullptr)
+    {
+        // The wait semaphores may be signaled by submissions still queued on other queues' submission threads. Those
+        // queued on this queue's own are ahead of the present.
+        const uint64_t signalQueues = Semaphore::GetDeferredSignalQueues(pPresentInfo->waitSemaphoreCount,
+                                                                         pPresentInfo->pWaitSemaphores) &
+                                      ~GetQueueMask();
+
+        result = m_pDevice->SyncDeferredQueueSubmits(signalQueues);
+    }
+
+    if (result == VK_SUCCESS)
+    {
+        DeferredPresent deferredPresent = { DeferredTaskType::Present, pPresentInfo, VK_SUCCESS };
+
+        if ((m_pSubmitThread != nullptr) && (pPresentInfo != nullptr) && m_pSubmitThread->PushTask(&deferredPresent))
+        {
+            result = m_pSubmitThread->Sync();
+
+            if (result == VK_SUCCESS)
+            {
+                result = deferredPresent.result;
+            }
+        }
+        else
+        {
+            result = SyncDeferredSubmits();
+
+            if (result == VK_SUCCESS)
+            {
+                result = PresentImpl(pPresentInfo);
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Performs a present on this queue's PAL queue.
+VkResult Queue::PresentImpl(
+    const VkPresentInfoKHR* pPresentInfo)
 {
     uint32_t presentationDeviceIdx = 0;
     bool     needSemaphoreFlush    = false;
@@ -2363,7 +2844,17 @@ VkResult Queue::BindSparse(
     const VkBindSparseInfo* pBindInfo,
     VkFence                 fence)
 {
-    VkResult result = VK_SUCCESS;
+    // Sparse binds may wait on semaphores signaled by submissions still queued on other queues' submission threads, and
+    // they are performed on this queue's PAL queue after the submissions queued on its own.
+    uint64_t signalQueues = GetQueueMask();
+
+    for (uint32_t i = 0; i < bindInfoCount; ++i)
+    {
+        signalQueues |= Semaphore::GetDeferredSignalQueues(pBindInfo[i].waitSemaphoreCount,
+                                                           pBindInfo[i].pWaitSemaphores);
+    }
+
+    VkResult result = m_pDevice->SyncDeferredQueueSubmits(signalQueues);
 
     VirtualStackFrame virtStackFrame(m_pStackAllocator);
 
@@ -2573,6 +3064,8 @@ VkResult Queue::SubmitInternalCmdBuf(
 {
     CmdBufferRing* pRing = (pCmdBufferRing != nullptr) ? pCmdBufferRing : m_pCmdBufferRing;
 
+    WaitDeferredSubmits();
+
     return pRing->SubmitCmdBuffer(m_pDevice, deviceIdx, m_pPalQueues[deviceIdx], cmdBufInfo, pCmdBufState);
 }
 
@@ -2584,6 +3077,8 @@ VkResult Queue::SynchronizeBackBuffer(
 {
     VkResult result = VK_SUCCESS;
 
+    WaitDeferredSubmits();
+
     if (m_pDummyCmdBuffer[deviceIdx] == nullptr)
     {
         result = CreateDummyCmdBuffer();
@@ -2627,6 +3122,9 @@ void Queue::InsertDebugUtilsLabel(
 {
     const RuntimeSettings& settings = m_pDevice->GetRuntimeSettings();
 
+    // Frame delimiters must be ordered with the submissions still queued on the submission thread.
+    WaitDeferredSubmits();
+
     if (strcmp(pLabelInfo->pLabelName, settings.devModeEndFrameDebugUtilsLabel) == 0)
     {
 #if ICD_GPUOPEN_DEVMODE_BUILD
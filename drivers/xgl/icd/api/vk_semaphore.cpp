@@ -238,6 +238,22 @@ VkResult Semaphore::Create(
     return vkResult;
 }
 
+// =====================================================================================================================
+uint64_t Semaphore::GetDeferredSignalQueues(
+    uint32_t           semaphoreCount,
+    const VkSemaphore* pSemaphores)
+{
+    uint64_t queueMask = 0;
+
+    for (uint32_t i = 0; i < semaphoreCount; ++i)
+    {
+        queueMask |= Semaphore::ObjectFromHandle(pSemaphores[i])->m_deferredSignalQueues.load(
+            std::memory_order_relaxed);
+    }
+
+    return queueMask;
+}
+
 // =====================================================================================================================
 // Get external handle from the semaphore object.
 VkResult Semaphore::GetShareHandle(
@@ -249,6 +265,10 @@ VkResult Semaphore::GetShareHandle(
     PAL_ASSERT((handleType == VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT) ||
                (handleType == VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_SYNC_FD_BIT));
 
+    // A sync fd captures the payload at export time, which must include the submissions still queued on a submission
+    // thread.
+    device->WaitDeferredQueueSubmits(m_deferredSignalQueues.load(std::memory_order_relaxed));
+
     Pal::QueueSemaphoreExportInfo palExportInfo = {};
     palExportInfo.flags.isReference = (handleType == VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT);
     *pHandle = m_pPalSemaphores[0]->ExportExternalHandle(palExportInfo);
@@ -0,0 +1,538 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2024 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+#include "cache_creator.h"
+#include "include/binary_cache_serialization.h"
+#include "palCacheLayer.h"
+#include "palPlatformKey.h"
+#include "palSysMemory.h"
+#include "gmock/gmock.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Util::Hash128;
+using Util::ICacheLayer;
+using Util::QueryResult;
+using Util::Result;
+
+using Blob = std::vector<uint8_t>;
+using EntryMap = std::map<std::vector<uint8_t>, Blob>;
+
+constexpr size_t PrivateHeaderSize = sizeof(vk::PipelineBinaryCachePrivateHeader);
+constexpr size_t EntryHeaderSize = sizeof(vk::BinaryCacheEntry);
+
+Hash128 makeId(uint32_t index) {
+  Hash128 id = {};
+  id.dwords[0] = index;
+  id.dwords[1] = index * 0x9E3779B9u;
+  id.dwords[2] = ~index;
+  id.dwords[3] = 0xC0FFEEu;
+  return id;
+}
+
+std::vector<uint8_t> idBytes(const Hash128 &id) {
+  return std::vector<uint8_t>(id.bytes, id.bytes + sizeof(id.bytes));
+}
+
+// Deterministic contents of the entry with the given index, sized so that entry headers end up unaligned.
+Blob makeData(uint32_t index) {
+  Blob data(37 + (index % 11) * 53);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(index * 31 + i);
+  return data;
+}
+
+// Forwards to another cache layer and counts the entries loaded through it, so tests can tell an incremental update
+// from a rebuild.
+class CountingLayer final : public ICacheLayer {
+public:
+  explicit CountingLayer(ICacheLayer *next) : m_next(next) {}
+
+  Result Query(const Hash128 *hashId, uint32_t policy, uint32_t flags, QueryResult *query) override {
+    return m_next->Query(hashId, policy, flags, query);
+  }
+  Result Store(Util::StoreFlags storeFlags, const Hash128 *hashId, const void *data, size_t dataSize,
+               size_t storeSize) override {
+    return m_next->Store(storeFlags, hashId, data, dataSize, storeSize);
+  }
+  Result AcquireCacheRef(const QueryResult *query) override { return m_next->AcquireCacheRef(query); }
+  Result ReleaseCacheRef(const QueryResult *query) override { return m_next->ReleaseCacheRef(query); }
+  Result GetCacheData(const QueryResult *query, const void **data) override {
+    return m_next->GetCacheData(query, data);
+  }
+  Result WaitForEntry(const Hash128 *hashId) override { return m_next->WaitForEntry(hashId); }
+  Result Evict(const Hash128 *hashId) override { return m_next->Evict(hashId); }
+  Result MarkEntryBad(const Hash128 *hashId) override { return m_next->MarkEntryBad(hashId); }
+  Result Load(const QueryResult *query, void *buffer) override {
+    ++m_loads;
+    return m_next->Load(query, buffer);
+  }
+  Result Link(ICacheLayer *nextLayer) override { return Result::Unsupported; }
+  Result SetLoadPolicy(uint32_t loadPolicy) override { return Result::Unsupported; }
+  Result SetStorePolicy(uint32_t storePolicy) override { return Result::Unsupported; }
+  ICacheLayer *GetNextLayer() const override { return m_next; }
+  uint32_t GetLoadPolicy() const override { return 0; }
+  uint32_t GetStorePolicy() const override { return 0; }
+  void Destroy() override {}
+
+  size_t loads() const { return m_loads; }
+
+private:
+  ICacheLayer *m_next;
+  size_t m_loads = 0;
+};
+
+// Destroys a cache layer created in memory owned by the unique_ptr.
+struct LayerDeleter {
+  void operator()(ICacheLayer *layer) const {
+    if (layer) {
+      layer->Destroy();
+      free(layer);
+    }
+  }
+};
+using LayerPtr = std::unique_ptr<ICacheLayer, LayerDeleter>;
+
+struct KeyDeleter {
+  void operator()(Util::IPlatformKey *key) const {
+    if (key) {
+      key->Destroy();
+      free(key);
+    }
+  }
+};
+
+class IncrementalCacheSerializerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    void *keyMem = malloc(Util::GetPlatformKeySize(Util::HashAlgorithm::Sha1));
+    ASSERT_NE(keyMem, nullptr);
+    uint8_t fingerprint[] = {'t', 'e', 's', 't'};
+    Util::IPlatformKey *key = nullptr;
+    if (Util::CreatePlatformKey(Util::HashAlgorithm::Sha1, fingerprint, sizeof(fingerprint), keyMem, &key) !=
+        Result::Success)
+      free(keyMem);
+    ASSERT_NE(key, nullptr);
+    m_key.reset(key);
+
+    m_serializer = std::make_unique<vk::IncrementalCacheSerializer>(Util::IndirectAllocator(&m_allocator), key);
+    ASSERT_EQ(m_serializer->Init(), Result::Success);
+  }
+
+  void TearDown() override {
+    // The memory layer reports to the serializer until it is destroyed.
+    m_counter.reset();
+    m_memoryLayer.reset();
+    m_serializer.reset();
+  }
+
+  // Creates the memory layer that is serialized. The serializer must be told about every change to it.
+  void createMemoryLayer(size_t maxMemorySize = SIZE_MAX, uint32_t numShards = 0) {
+    m_memoryLayer = createLayer(maxMemorySize, numShards, true);
+    ASSERT_TRUE(m_memoryLayer);
+    m_counter = std::make_unique<CountingLayer>(m_memoryLayer.get());
+  }
+
+  static LayerPtr createLayer(size_t maxMemorySize, uint32_t numShards, vk::IncrementalCacheSerializer *serializer) {
+    Util::MemoryCacheCreateInfo createInfo = {};
+    createInfo.maxObjectCount = SIZE_MAX;
+    createInfo.maxMemorySize = maxMemorySize;
+    createInfo.expectedEntries = 64;
+    createInfo.numShards = numShards;
+    createInfo.evictOnFull = true;
+    createInfo.evictDuplicates = true;
+    if (serializer) {
+      createInfo.pfnNotify = vk::IncrementalCacheSerializer::NotifyMemoryCacheEvent;
+      createInfo.pNotifyClientData = serializer;
+    }
+
+    void *layerMem = malloc(Util::GetMemoryCacheLayerSize(&createInfo));
+    ICacheLayer *layer = nullptr;
+    if (layerMem && Util::CreateMemoryCacheLayer(&createInfo, layerMem, &layer) != Result::Success) {
+      free(layerMem);
+      layer = nullptr;
+    }
+    return LayerPtr(layer);
+  }
+
+  LayerPtr createLayer(size_t maxMemorySize, uint32_t numShards, bool notify) {
+    return createLayer(maxMemorySize, numShards, notify ? m_serializer.get() : nullptr);
+  }
+
+  static Result store(ICacheLayer *layer, uint32_t index) {
+    const Hash128 id = makeId(index);
+    const Blob data = makeData(index);
+    return layer->Store({}, &id, data.data(), data.size());
+  }
+
+  // Brings the serializer up to date and writes out the whole blob.
+  Blob serialize() {
+    EXPECT_EQ(m_serializer->Update(m_memoryLayer.get(), m_counter.get()), Result::Success);
+    Blob blob(m_serializer->GetBlobSize());
+    size_t size = blob.size();
+    EXPECT_EQ(m_serializer->Write(blob.data(), &size), Result::Success);
+    EXPECT_EQ(size, blob.size());
+    return blob;
+  }
+
+  // Serializes the memory layer the way PipelineBinaryCache does without the incremental serializer.
+  Blob serializeFully() {
+    size_t count = 0;
+    size_t dataSize = 0;
+    EXPECT_EQ(Util::GetMemoryCacheLayerCurSize(m_memoryLayer.get(), &count, &dataSize), Result::Success);
+    std::vector<Hash128> ids(count);
+    if (count > 0)
+      EXPECT_EQ(Util::GetMemoryCacheLayerHashIds(m_memoryLayer.get(), count, ids.data()), Result::Success);
+
+    Blob blob(vk::PipelineBinaryCacheSerializer::CalculateAnticipatedCacheBlobSize(count, dataSize));
+    vk::PipelineBinaryCacheSerializer serializer;
+    EXPECT_EQ(serializer.Initialize(blob.size(), blob.data()), Result::Success);
+    for (const Hash128 &id : ids) {
+      const Blob data = load(id);
+      vk::BinaryCacheEntry entry = {id, data.size()};
+      EXPECT_EQ(serializer.AddPipelineBinary(&entry, data.data()), Result::Success);
+    }
+    size_t bytesWritten = 0;
+    EXPECT_EQ(serializer.Finalize(&cc::getDefaultAllocCallbacks(), m_key.get(), nullptr, &bytesWritten),
+              Result::Success);
+    blob.resize(bytesWritten);
+    return blob;
+  }
+
+  Blob load(const Hash128 &id) {
+    QueryResult query = {};
+    EXPECT_EQ(m_memoryLayer->Query(&id, 0, 0, &query), Result::Success);
+    Blob data(query.dataSize);
+    EXPECT_EQ(m_memoryLayer->Load(&query, data.data()), Result::Success);
+    return data;
+  }
+
+  // Returns the entries of a blob, after checking that its hash matches its contents.
+  EntryMap parse(const Blob &blob) {
+    EntryMap entries;
+    EXPECT_GE(blob.size(), PrivateHeaderSize);
+    if (blob.size() < PrivateHeaderSize)
+      return entries;
+
+    vk::PipelineBinaryCachePrivateHeader expected = {};
+    EXPECT_EQ(vk::CalculatePipelineBinaryCacheHashId(&cc::getDefaultAllocCallbacks(), m_key.get(),
+                                                     blob.data() + PrivateHeaderSize, blob.size() - PrivateHeaderSize,
+                                                     expected.hashId),
+              Result::Success);
+    EXPECT_EQ(memcmp(blob.data(), expected.hashId, sizeof(expected.hashId)), 0) << "blob hash does not match its data";
+
+    size_t offset = PrivateHeaderSize;
+    while (offset + EntryHeaderSize <= blob.size()) {
+      vk::BinaryCacheEntry entry;
+      memcpy(&entry, blob.data() + offset, EntryHeaderSize);
+      offset += EntryHeaderSize;
+      EXPECT_LE(offset + entry.dataSize, blob.size());
+      if (offset + entry.dataSize > blob.size())
+        break;
+      const bool inserted = entries
+                                .emplace(idBytes(entry.hashId),
+                                         Blob(blob.begin() + offset, blob.begin() + offset + entry.dataSize))
+                                .second;
+      EXPECT_TRUE(inserted) << "entry serialized twice";
+      offset += entry.dataSize;
+    }
+    EXPECT_EQ(offset, blob.size());
+    return entries;
+  }
+
+  // The entries currently in the memory layer.
+  EntryMap cached() {
+    size_t count = 0;
+    size_t dataSize = 0;
+    EXPECT_EQ(Util::GetMemoryCacheLayerCurSize(m_memoryLayer.get(), &count, &dataSize), Result::Success);
+    std::vector<Hash128> ids(count);
+    if (count > 0)
+      EXPECT_EQ(Util::GetMemoryCacheLayerHashIds(m_memoryLayer.get(), count, ids.data()), Result::Success);
+
+    EntryMap entries;
+    for (const Hash128 &id : ids)
+      entries.emplace(idBytes(id), load(id));
+    return entries;
+  }
+
+  // Serializes incrementally and checks the result against the contents of the memory layer and against what the full
+  // serializer writes for it.
+  void expectUpToDate() {
+    const EntryMap entries = parse(serialize());
+    EXPECT_EQ(entries, cached());
+    EXPECT_EQ(entries, parse(serializeFully()));
+  }
+
+  Util::GenericAllocator m_allocator;
+  std::unique_ptr<Util::IPlatformKey, KeyDeleter> m_key;
+  std::unique_ptr<vk::IncrementalCacheSerializer> m_serializer;
+  LayerPtr m_memoryLayer;
+  std::unique_ptr<CountingLayer> m_counter;
+};
+
+TEST_F(IncrementalCacheSerializerTest, EmptyCache) {
+  createMemoryLayer();
+  const Blob blob = serialize();
+  EXPECT_EQ(blob.size(), PrivateHeaderSize);
+  EXPECT_TRUE(parse(blob).empty());
+  EXPECT_EQ(blob, serializeFully());
+}
+
+TEST_F(IncrementalCacheSerializerTest, FirstSerializeMatchesFullSerializer) {
+  createMemoryLayer();
+  for (uint32_t i = 0; i < 40; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+
+  // Built from scratch the blob lists the entries in the same order as the full serializer, so they are identical.
+  EXPECT_EQ(serialize(), serializeFully());
+  EXPECT_EQ(m_counter->loads(), 40u);
+}
+
+TEST_F(IncrementalCacheSerializerTest, LoadsOnlyNewEntries) {
+  createMemoryLayer();
+  for (uint32_t i = 0; i < 10; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  expectUpToDate();
+  EXPECT_EQ(m_counter->loads(), 10u);
+
+  for (uint32_t i = 10; i < 15; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  expectUpToDate();
+  EXPECT_EQ(m_counter->loads(), 15u);
+
+  // Nothing changed, so nothing is loaded and the blob stays the same.
+  const Blob before = serialize();
+  EXPECT_EQ(serialize(), before);
+  EXPECT_EQ(m_counter->loads(), 15u);
+}
+
+TEST_F(IncrementalCacheSerializerTest, DuplicateStoreRebuilds) {
+  createMemoryLayer();
+  for (uint32_t i = 0; i < 10; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  expectUpToDate();
+
+  // With evictDuplicates the old entry is evicted and the new one added in its place.
+  EXPECT_EQ(store(m_memoryLayer.get(), 3), Result::Success);
+  expectUpToDate();
+  EXPECT_EQ(m_counter->loads(), 10u + 10u);
+}
+
+TEST_F(IncrementalCacheSerializerTest, EvictionRebuilds) {
+  createMemoryLayer();
+  for (uint32_t i = 0; i < 10; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  expectUpToDate();
+
+  const Hash128 id = makeId(4);
+  ASSERT_EQ(m_memoryLayer->Evict(&id), Result::Success);
+  expectUpToDate();
+  EXPECT_EQ(m_counter->loads(), 10u + 9u);
+  EXPECT_EQ(parse(serialize()).count(idBytes(id)), 0u);
+}
+
+TEST_F(IncrementalCacheSerializerTest, BadEntryIsKeptLikeFullSerializer) {
+  createMemoryLayer();
+  for (uint32_t i = 0; i < 10; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  expectUpToDate();
+
+  // A bad entry stays in the memory layer until it is evicted, so both serializers still write it.
+  const Hash128 id = makeId(7);
+  ASSERT_EQ(m_memoryLayer->MarkEntryBad(&id), Result::Success);
+  expectUpToDate();
+  EXPECT_EQ(m_counter->loads(), 10u);
+
+  ASSERT_EQ(m_memoryLayer->Evict(&id), Result::Success);
+  expectUpToDate();
+  EXPECT_EQ(parse(serialize()).count(idBytes(id)), 0u);
+}
+
+TEST_F(IncrementalCacheSerializerTest, CapacityEviction) {
+  // Room for about 20 entries, evicted least recently used first from a single shard.
+  createMemoryLayer(20 * 300, 1);
+  for (uint32_t round = 0; round < 8; ++round) {
+    for (uint32_t i = 0; i < 7; ++i)
+      ASSERT_EQ(store(m_memoryLayer.get(), round * 7 + i), Result::Success);
+    expectUpToDate();
+  }
+}
+
+TEST_F(IncrementalCacheSerializerTest, ReservedEntryIsAddedOnceStored) {
+  createMemoryLayer();
+  ASSERT_EQ(store(m_memoryLayer.get(), 0), Result::Success);
+
+  const Hash128 id = makeId(1);
+  QueryResult query = {};
+  ASSERT_EQ(m_memoryLayer->Query(&id, 0, ICacheLayer::QueryFlags::ReserveEntryOnMiss, &query), Result::Reserved);
+  EXPECT_EQ(parse(serialize()).size(), 1u);
+
+  ASSERT_EQ(store(m_memoryLayer.get(), 1), Result::Success);
+  expectUpToDate();
+  EXPECT_EQ(parse(serialize()).count(idBytes(id)), 1u);
+  EXPECT_EQ(m_counter->loads(), 2u);
+}
+
+TEST_F(IncrementalCacheSerializerTest, ReplacedEntryKeepsItsPlace) {
+  createMemoryLayer();
+  for (uint32_t i = 0; i < 5; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  const Blob before = serialize();
+
+  // Replacements carry another encoding of the same contents, which the blob already holds.
+  Util::StoreFlags flags = {};
+  flags.replaceExisting = 1;
+  const Hash128 id = makeId(2);
+  const Blob data = makeData(2);
+  ASSERT_EQ(m_memoryLayer->Store(flags, &id, data.data(), data.size()), Result::Success);
+
+  EXPECT_EQ(serialize(), before);
+  EXPECT_EQ(m_counter->loads(), 5u);
+}
+
+TEST_F(IncrementalCacheSerializerTest, PromotedEntriesAreAppended) {
+  // Stands in for an archive layer below the memory layer.
+  LayerPtr backing = createLayer(SIZE_MAX, 0, false);
+  ASSERT_TRUE(backing);
+  for (uint32_t i = 100; i < 110; ++i)
+    ASSERT_EQ(store(backing.get(), i), Result::Success);
+
+  createMemoryLayer();
+  ASSERT_EQ(m_memoryLayer->Link(backing.get()), Result::Success);
+  for (uint32_t i = 0; i < 3; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  expectUpToDate();
+
+  // Queries that hit the backing layer copy the entry into the memory layer.
+  for (uint32_t i = 100; i < 104; ++i) {
+    const Hash128 id = makeId(i);
+    QueryResult query = {};
+    ASSERT_EQ(m_memoryLayer->Query(&id, ICacheLayer::LinkPolicy::LoadOnQuery, 0, &query), Result::Success);
+  }
+  expectUpToDate();
+  EXPECT_EQ(parse(serialize()).size(), 7u);
+  EXPECT_EQ(m_counter->loads(), 3u + 4u);
+
+  m_memoryLayer->Link(nullptr);
+}
+
+TEST_F(IncrementalCacheSerializerTest, MergedEntriesAreAppended) {
+  createMemoryLayer();
+  for (uint32_t i = 0; i < 5; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  expectUpToDate();
+
+  // The source overlaps the destination; only the new entries are merged.
+  LayerPtr source = createLayer(SIZE_MAX, 0, false);
+  ASSERT_TRUE(source);
+  for (uint32_t i = 3; i < 12; ++i)
+    ASSERT_EQ(store(source.get(), i), Result::Success);
+
+  ICacheLayer *sources[] = {source.get()};
+  ASSERT_EQ(Util::MergeMemoryCacheLayers(m_memoryLayer.get(), sources, 1, 0, 1), Result::Success);
+  expectUpToDate();
+  EXPECT_EQ(parse(serialize()).size(), 12u);
+  EXPECT_EQ(m_counter->loads(), 5u + 7u);
+}
+
+TEST_F(IncrementalCacheSerializerTest, PartialWrite) {
+  createMemoryLayer();
+  for (uint32_t i = 0; i < 10; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  ASSERT_EQ(m_serializer->Update(m_memoryLayer.get(), m_counter.get()), Result::Success);
+  const EntryMap all = cached();
+
+  // Too small for even the header.
+  Blob blob(m_serializer->GetBlobSize());
+  size_t size = PrivateHeaderSize - 1;
+  EXPECT_EQ(m_serializer->Write(blob.data(), &size), Result::ErrorIncompleteResults);
+  EXPECT_EQ(size, 0u);
+
+  // Every size in between yields a valid blob of whole entries.
+  for (size_t capacity = PrivateHeaderSize; capacity < blob.size(); capacity += 97) {
+    size = capacity;
+    EXPECT_EQ(m_serializer->Write(blob.data(), &size), Result::ErrorIncompleteResults);
+    EXPECT_LE(size, capacity);
+    const EntryMap entries = parse(Blob(blob.begin(), blob.begin() + size));
+    for (const auto &entry : entries) {
+      auto it = all.find(entry.first);
+      ASSERT_NE(it, all.end());
+      EXPECT_EQ(entry.second, it->second);
+    }
+  }
+}
+
+TEST_F(IncrementalCacheSerializerTest, ResetRebuilds) {
+  createMemoryLayer();
+  for (uint32_t i = 0; i < 6; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  expectUpToDate();
+
+  m_serializer->Reset();
+  for (uint32_t i = 6; i < 8; ++i)
+    ASSERT_EQ(store(m_memoryLayer.get(), i), Result::Success);
+  expectUpToDate();
+  EXPECT_EQ(m_counter->loads(), 6u + 8u);
+}
+
+TEST_F(IncrementalCacheSerializerTest, ConcurrentChanges) {
+  createMemoryLayer(200 * 300);
+
+  // Serializations race with stores and evictions from other threads; each blob must still be self-consistent, and
+  // once the writers are done the next one must match the cache exactly.
+  std::vector<std::thread> writers;
+  for (uint32_t t = 0; t < 4; ++t) {
+    writers.emplace_back([this, t] {
+      for (uint32_t i = 0; i < 500; ++i) {
+        const uint32_t index = t * 1000 + i;
+        store(m_memoryLayer.get(), index);
+        if (i % 7 == 0) {
+          const Hash128 id = makeId(index - 3);
+          m_memoryLayer->Evict(&id);
+        }
+      }
+    });
+  }
+  for (uint32_t i = 0; i < 50; ++i) {
+    const Blob blob = serialize();
+    for (const auto &entry : parse(blob)) {
+      uint32_t index = 0;
+      memcpy(&index, entry.first.data(), sizeof(index));
+      EXPECT_EQ(entry.second, makeData(index));
+    }
+  }
+  for (std::thread &writer : writers)
+    writer.join();
+
+  expectUpToDate();
+}
+
+} // namespace
@@ -0,0 +1,221 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2023 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  defer_compile_bench.cpp
+ * @brief CPU-only benchmark of the deferred compile thread pool and check of its statistics.
+ *
+ * A burst of tasks is queued on the pool the way deferred optimized pipeline compiles and cache merges are: most of
+ * them short, with a few long ones mixed in, so that the tasks queued behind a long one on its worker have to be
+ * stolen by the others.  Each task spins for its cost in CPU time rather than compiling anything.  The burst is run inline on the
+ * calling thread and on the pool, and the wall-clock times are reported together with DeferCompileStats, which is
+ * checked against the burst: every task executed, none left queued, and no more stolen or queued at once than there
+ * were tasks.  The exit code is non-zero if a check fails.
+ *
+ * Usage: defer-compile-bench [--tasks <count>] [--threads <count, 0 for cores / 2 as the driver default>]
+ ***********************************************************************************************************************
+ */
+
+#include "include/defer_compile_thread.h"
+
+#include "palSysUtil.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+
+using namespace vk;
+
+namespace
+{
+
+constexpr uint32_t DefaultTasks     = 256;
+constexpr uint32_t ShortTaskUs      = 200;   // Most deferred compiles
+constexpr uint32_t LongTaskUs       = 5000;  // Every LongTaskPeriod-th task
+constexpr uint32_t LongTaskPeriod   = 16;
+
+// Payload of one task.
+struct SpinTask
+{
+    uint32_t costUs;
+    bool     executed;
+};
+
+// =====================================================================================================================
+// Returns the CPU time used by the calling thread in us.
+int64_t GetThreadCpuTimeUs()
+{
+    timespec time = {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+
+    return (static_cast<int64_t>(time.tv_sec) * 1000000) + (time.tv_nsec / 1000);
+}
+
+// =====================================================================================================================
+// Busy-waits until the calling thread has used the task's cost in CPU time, as a compile would. Waiting on the wall
+// clock instead would let preempted tasks overlap and show a speedup on fewer cores than workers.
+void ExecuteSpinTask(
+    void* pPayload)
+{
+    SpinTask*const pTask = static_cast<SpinTask*>(pPayload);
+
+    const int64_t end = GetThreadCpuTimeUs() + pTask->costUs;
+
+    while (GetThreadCpuTimeUs() < end)
+    {
+    }
+
+    pTask->executed = true;
+}
+
+// =====================================================================================================================
+double TicksToMs(
+    int64_t ticks)
+{
+    return (static_cast<double>(ticks) * 1000.0) / static_cast<double>(Util::GetPerfFrequency());
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    uint32_t taskCount   = DefaultTasks;
+    uint32_t threadCount = 0;
+    bool     validArgs   = true;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "--tasks") == 0) && (i + 1 < argc))
+        {
+            taskCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        }
+        else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc))
+        {
+            threadCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        }
+        else
+        {
+            validArgs = false;
+        }
+    }
+
+    if ((validArgs == false) || (taskCount == 0))
+    {
+        fprintf(stderr, "Usage: %s [--tasks <count>] [--threads <count>]\n", argv[0]);
+        return 1;
+    }
+
+    VkAllocationCallbacks callbacks = allocator::g_DefaultAllocCallback;
+    PalAllocator          palAllocator(&callbacks);
+    palAllocator.Init();
+
+    SpinTask*const pTasks = static_cast<SpinTask*>(calloc(taskCount, sizeof(SpinTask)));
+
+    if (pTasks == nullptr)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < taskCount; ++i)
+    {
+        pTasks[i].costUs = ((i % LongTaskPeriod) == 0) ? LongTaskUs : ShortTaskUs;
+    }
+
+    // Inline reference, as ExecuteDeferCompile() does without a worker.
+    const int64_t inlineStart = Util::GetPerfCpuTime();
+
+    for (uint32_t i = 0; i < taskCount; ++i)
+    {
+        ExecuteSpinTask(&pTasks[i]);
+        pTasks[i].executed = false;
+    }
+
+    const int64_t inlineTicks = Util::GetPerfCpuTime() - inlineStart;
+
+    DeferCompileStats stats       = {};
+    uint32_t          inlineTasks = 0;
+    int64_t           poolTicks   = 0;
+
+    {
+        DeferCompileManager manager;
+        manager.Init((threadCount == 0) ? UINT32_MAX : threadCount, &palAllocator);
+
+        const int64_t poolStart = Util::GetPerfCpuTime();
+
+        for (uint32_t i = 0; i < taskCount; ++i)
+        {
+            DeferredCompileWorkload workload = {};
+            workload.pPayloads = &pTasks[i];
+            workload.Execute   = ExecuteSpinTask;
+
+            if (manager.AddTask(workload) == false)
+            {
+                ExecuteSpinTask(&pTasks[i]);
+                inlineTasks++;
+            }
+        }
+
+        manager.SyncAll();
+
+        poolTicks = Util::GetPerfCpuTime() - poolStart;
+        stats     = manager.GetStats();
+    }
+
+    uint32_t executedTasks = 0;
+
+    for (uint32_t i = 0; i < taskCount; ++i)
+    {
+        executedTasks += pTasks[i].executed ? 1 : 0;
+    }
+
+    free(pTasks);
+
+    printf("%u tasks (%u us, every %uth %u us)\n", taskCount, ShortTaskUs, LongTaskPeriod, LongTaskUs);
+    printf("  %-24s %10.1f ms\n", "Inline", TicksToMs(inlineTicks));
+    printf("  %-24s %10.1f ms (%u workers, %.2fx)\n",
+           "Pool", TicksToMs(poolTicks), stats.workerCount, TicksToMs(inlineTicks) / TicksToMs(poolTicks));
+    printf("\nDeferCompileStats\n");
+    printf("  %-24s %10u\n",   "queueDepth",     stats.queueDepth);
+    printf("  %-24s %10u\n",   "peakQueueDepth", stats.peakQueueDepth);
+    printf("  %-24s %10llu\n", "tasksExecuted",  static_cast<unsigned long long>(stats.tasksExecuted));
+    printf("  %-24s %10llu\n", "tasksStolen",    static_cast<unsigned long long>(stats.tasksStolen));
+    printf("  %-24s %10u\n",   "inline fallbacks", inlineTasks);
+
+    const bool statsValid = (executedTasks == taskCount)                       &&
+                            ((stats.tasksExecuted + inlineTasks) == taskCount) &&
+                            (stats.queueDepth == 0)                            &&
+                            (stats.peakQueueDepth <= taskCount)                &&
+                            (stats.tasksStolen <= stats.tasksExecuted)         &&
+                            ((stats.workerCount > 0) || (inlineTasks == taskCount));
+
+    printf("\nStatistics %s\n", statsValid ? "consistent" : "INCONSISTENT");
+
+    return statsValid ? 0 : 1;
+}
@@ -0,0 +1,389 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2023 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  slab_alloc_bench.cpp
+ * @brief CPU-only benchmark of the slab allocator used by the default allocation callbacks.
+ *
+ * Each thread keeps a fixed number of live allocations and repeatedly replaces a random one with a new allocation,
+ * which is the create/destroy churn of API objects an application produces while streaming.  The allocation sizes are
+ * drawn from a mix resembling the driver's objects: Util container nodes, samplers, buffer and image views, descriptor
+ * set layouts, images, command buffers and the occasional pipeline-sized allocation that the slab allocator passes on
+ * to the system.  The same churn is run against the system allocator (posix_memalign/free, as the default callbacks do
+ * without the slab allocator) and against the slab allocator, on 1, 2, 4, ... threads, and the average time per
+ * allocation plus free is reported.
+ *
+ * Usage: slab-alloc-bench [--iterations <count per thread>] [--live <allocations per thread>] [--threads <count>]
+ ***********************************************************************************************************************
+ */
+
+#include "include/slab_allocator.h"
+
+#include "palSysUtil.h"
+#include "palThread.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace vk::allocator;
+
+namespace
+{
+
+constexpr uint32_t DefaultIterations = 2000000;
+constexpr uint32_t DefaultLiveCount  = 4096;
+constexpr uint32_t DefaultThreads    = 8;
+constexpr uint32_t MaxThreads        = 64;
+
+// Allocation sizes of the churn and their relative frequency.
+struct SizeMixEntry
+{
+    size_t   size;
+    uint32_t weight;
+};
+
+constexpr SizeMixEntry SizeMix[] =
+{
+    {   40, 20 },   // Util hash map and list nodes
+    {   88, 12 },   // Samplers
+    {  104, 16 },   // Buffer views
+    {  168, 16 },   // Image views
+    {  296,  8 },   // Small descriptor set layouts
+    {  600,  8 },   // Images
+    { 1200,  6 },   // Descriptor pools, bigger layouts
+    { 3000,  4 },   // Command buffers
+    { 9000,  1 },   // Pipelines (served by the system allocator)
+};
+
+// Allocator being measured.
+enum class AllocatorKind : uint32_t
+{
+    System,
+    Slab,
+};
+
+// State of one benchmark thread.
+struct ChurnThread
+{
+    Util::Thread             thread;
+    AllocatorKind            kind;
+    uint32_t                 threadIdx;
+    uint32_t                 iterations;
+    uint32_t                 liveCount;
+    const size_t*            pSizeTable;     // Sizes with SizeMix frequencies, 256 entries
+    const std::atomic<bool>* pGo;
+    std::atomic<uint32_t>*   pReady;
+    int64_t                  startTime;
+    int64_t                  endTime;
+    bool                     failed;
+};
+
+// =====================================================================================================================
+void* Alloc(
+    AllocatorKind kind,
+    size_t        size)
+{
+    void* pMem = nullptr;
+
+    if (kind == AllocatorKind::Slab)
+    {
+        pMem = SlabAllocator::Get()->Alloc(size, 16);
+    }
+    else if (posix_memalign(&pMem, 16, size) != 0)
+    {
+        pMem = nullptr;
+    }
+
+    return pMem;
+}
+
+// =====================================================================================================================
+void Free(
+    AllocatorKind kind,
+    void*         pMem)
+{
+    if (kind == AllocatorKind::Slab)
+    {
+        SlabAllocator::Get()->Free(pMem);
+    }
+    else
+    {
+        free(pMem);
+    }
+}
+
+// =====================================================================================================================
+// Small xorshift generator, so that the random numbers cost next to nothing compared to the allocations.
+uint32_t NextRandom(
+    uint32_t* pState)
+{
+    uint32_t x = *pState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *pState = x;
+
+    return x;
+}
+
+// =====================================================================================================================
+// Thread entry point: fills the live set, waits for the other threads, then replaces random live allocations.
+void ChurnThreadMain(
+    void* pParameter)
+{
+    ChurnThread*const pState = static_cast<ChurnThread*>(pParameter);
+    void**const       ppLive = static_cast<void**>(calloc(pState->liveCount, sizeof(void*)));
+    uint32_t          random = 0x9E3779B9u * (pState->threadIdx + 1);
+
+    pState->failed = (ppLive == nullptr);
+
+    for (uint32_t i = 0; (pState->failed == false) && (i < pState->liveCount); ++i)
+    {
+        ppLive[i] = Alloc(pState->kind, pState->pSizeTable[NextRandom(&random) & 0xFF]);
+        pState->failed = (ppLive[i] == nullptr);
+    }
+
+    pState->pReady->fetch_add(1);
+
+    while (pState->pGo->load() == false)
+    {
+    }
+
+    pState->startTime = Util::GetPerfCpuTime();
+
+    for (uint32_t i = 0; (pState->failed == false) && (i < pState->iterations); ++i)
+    {
+        const uint32_t value = NextRandom(&random);
+        const uint32_t slot  = (value >> 8) % pState->liveCount;
+        const size_t   size  = pState->pSizeTable[value & 0xFF];
+
+        Free(pState->kind, ppLive[slot]);
+        ppLive[slot] = Alloc(pState->kind, size);
+
+        if (ppLive[slot] != nullptr)
+        {
+            // Touch the allocation like a constructor would.
+            memset(ppLive[slot], 0, (size < 64) ? size : 64);
+        }
+        else
+        {
+            pState->failed = true;
+        }
+    }
+
+    pState->endTime = Util::GetPerfCpuTime();
+
+    if (ppLive != nullptr)
+    {
+        for (uint32_t i = 0; i < pState->liveCount; ++i)
+        {
+            if (ppLive[i] != nullptr)
+            {
+                Free(pState->kind, ppLive[i]);
+            }
+        }
+
+        free(ppLive);
+    }
+}
+
+// =====================================================================================================================
+// Runs the churn on the given number of threads and returns the wall-clock time per allocation and free in ns, or a
+// negative value on failure.
+double RunChurn(
+    AllocatorKind kind,
+    uint32_t      threadCount,
+    uint32_t      iterations,
+    uint32_t      liveCount,
+    const size_t* pSizeTable)
+{
+    static ChurnThread threads[MaxThreads];
+
+    std::atomic<bool>     go(false);
+    std::atomic<uint32_t> ready(0);
+    uint32_t              started = 0;
+    bool                  failed  = false;
+
+    for (; started < threadCount; ++started)
+    {
+        ChurnThread*const pState = &threads[started];
+
+        pState->kind       = kind;
+        pState->threadIdx  = started;
+        pState->iterations = iterations;
+        pState->liveCount  = liveCount;
+        pState->pSizeTable = pSizeTable;
+        pState->pGo        = &go;
+        pState->pReady     = &ready;
+        pState->failed     = false;
+
+        if (pState->thread.Begin(&ChurnThreadMain, pState) != Util::Result::Success)
+        {
+            failed = true;
+            break;
+        }
+    }
+
+    // Threads which did start must be released even if a later one failed to, so that they can be joined.
+    while (ready.load() < started)
+    {
+    }
+
+    go.store(true);
+
+    int64_t startTime = INT64_MAX;
+    int64_t endTime   = 0;
+
+    for (uint32_t i = 0; i < started; ++i)
+    {
+        threads[i].thread.Join();
+
+        failed    |= threads[i].failed;
+        startTime  = (threads[i].startTime < startTime) ? threads[i].startTime : startTime;
+        endTime    = (threads[i].endTime   > endTime)   ? threads[i].endTime   : endTime;
+    }
+
+    const double nsPerTick = 1.0e9 / static_cast<double>(Util::GetPerfFrequency());
+
+    return failed ? -1.0
+                  : (static_cast<double>(endTime - startTime) * nsPerTick) /
+                    (static_cast<double>(iterations) * threadCount);
+}
+
+// =====================================================================================================================
+void PrintSlabStats()
+{
+    SlabAllocatorStats stats = {};
+    SlabAllocator::Get()->GetStats(&stats);
+
+    printf("\nSlab allocator: %llu slabs, %llu live system allocations\n",
+           static_cast<unsigned long long>(stats.slabCount),
+           static_cast<unsigned long long>(stats.largeAllocCount));
+    printf("  %10s %12s %12s %14s\n", "Block size", "Carved", "Free", "Allocations");
+
+    for (uint32_t classIdx = 0; classIdx < SlabSizeClassCount; ++classIdx)
+    {
+        const SlabClassStats& classStats = stats.classes[classIdx];
+
+        if (classStats.carvedBlocks > 0)
+        {
+            printf("  %10zu %12llu %12llu %14llu\n",
+                   classStats.blockSize,
+                   static_cast<unsigned long long>(classStats.carvedBlocks),
+                   static_cast<unsigned long long>(classStats.freeBlocks),
+                   static_cast<unsigned long long>(classStats.allocCount));
+        }
+    }
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    uint32_t iterations  = DefaultIterations;
+    uint32_t liveCount   = DefaultLiveCount;
+    uint32_t maxThreads  = DefaultThreads;
+    bool     validArgs   = true;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "--iterations") == 0) && (i + 1 < argc))
+        {
+            iterations = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        }
+        else if ((strcmp(argv[i], "--live") == 0) && (i + 1 < argc))
+        {
+            liveCount = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        }
+        else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc))
+        {
+            maxThreads = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        }
+        else
+        {
+            validArgs = false;
+        }
+    }
+
+    if ((validArgs == false) || (iterations == 0) || (liveCount == 0) || (maxThreads == 0) ||
+        (maxThreads > MaxThreads))
+    {
+        fprintf(stderr, "Usage: %s [--iterations <count>] [--live <count>] [--threads <1-%u>]\n", argv[0], MaxThreads);
+        return 1;
+    }
+
+    // Expand the size mix into a table indexed by 8 random bits.
+    size_t   sizeTable[256] = {};
+    uint32_t totalWeight    = 0;
+
+    for (const SizeMixEntry& entry : SizeMix)
+    {
+        totalWeight += entry.weight;
+    }
+
+    for (uint32_t i = 0, entryIdx = 0, weightSum = SizeMix[0].weight; i < 256; ++i)
+    {
+        while ((i * totalWeight) >= (weightSum * 256))
+        {
+            weightSum += SizeMix[++entryIdx].weight;
+        }
+
+        sizeTable[i] = SizeMix[entryIdx].size;
+    }
+
+    printf("Object churn, %u live allocations and %u replacements per thread\n", liveCount, iterations);
+    printf("  %8s %16s %16s %10s\n", "Threads", "System ns/op", "Slab ns/op", "Speedup");
+
+    int exitCode = 0;
+
+    for (uint32_t threadCount = 1; threadCount != 0; )
+    {
+        const double systemNs = RunChurn(AllocatorKind::System, threadCount, iterations, liveCount, sizeTable);
+        const double slabNs   = RunChurn(AllocatorKind::Slab,   threadCount, iterations, liveCount, sizeTable);
+
+        if ((systemNs < 0.0) || (slabNs < 0.0))
+        {
+            printf("  %8u failed (out of memory or thread creation failed)\n", threadCount);
+            exitCode = 1;
+        }
+        else
+        {
+            printf("  %8u %16.1f %16.1f %9.2fx\n", threadCount, systemNs, slabNs, systemNs / slabNs);
+        }
+
+        // Powers of two, then the requested count.
+        threadCount = (threadCount == maxThreads)     ? 0          :
+                      ((threadCount * 2) > maxThreads) ? maxThreads : (threadCount * 2);
+    }
+
+    PrintSlabStats();
+
+    return exitCode;
+}